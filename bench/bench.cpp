@@ -0,0 +1,255 @@
+#include "bench.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#if defined(__i386__) || defined(__x86_64__)
+#include <x86intrin.h>
+#define BENCH_RDTSC
+#elif defined(_M_IX86) || defined(_M_X64)
+#include <intrin.h>
+#define BENCH_RDTSC
+#endif
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+struct VBenchResult
+{
+	const char		*mName;
+	VSimdTier		mTier;
+	VUINT			mIters;
+	double			mNs;		/**< per op, median of the repetitions */
+	double			mCycles;	/**< per op, time stamp counter ticks */
+};
+
+static const char	*sJson = NULL;
+static const char	*sFilter = NULL;
+static int			sTier = -1;
+static unsigned int	sSeed = 1;
+static double		sMinNs = 50e6;
+static int			sReps = 5;
+
+#if !defined(__GNUC__)
+static volatile const void	*sEscape;
+
+void BenchEscape(const void *pValue)
+{
+	sEscape = pValue;
+}
+#endif
+
+static double NowTicks()
+{
+#if defined(BENCH_RDTSC)
+	return (double)__rdtsc();
+#else
+	return NowNs();
+#endif
+}
+
+/*
+ * Times one pass of nIters operations.
+ */
+static void Time(VBenchFunc pFunc, VUINT nIters, double *pNs, double *pTicks)
+{
+	double	vNs, vTicks;
+
+	ClobberMemory();
+	vNs = NowNs();
+	vTicks = NowTicks();
+	pFunc(nIters);
+	ClobberMemory();
+	*pTicks = NowTicks() - vTicks;
+	*pNs = NowNs() - vNs;
+}
+
+/*
+ * Warms up, picks an iteration count that runs for about sMinNs, then
+ * takes the median of sReps passes.
+ */
+static VBenchResult Run(const VBenchEntry &entry, VSimdTier eTier)
+{
+	VBenchResult		vResult;
+	std::vector<double>	vNs, vTicks;
+	double				vPassNs, vPassTicks;
+	double				vIters = BENCH_POOL;
+
+	entry.mFunc(BENCH_POOL * 4);
+
+	for (;;)
+	{
+		Time(entry.mFunc, (VUINT)vIters, &vPassNs, &vPassTicks);
+		if (vPassNs >= sMinNs / 10.0 || vIters >= 1e9)
+			break;
+		vIters *= 4.0;
+	}
+	vIters *= sMinNs / (vPassNs > 1.0 ? vPassNs : 1.0);
+	if (vIters < 1.0)
+		vIters = 1.0;
+	if (vIters > 4e9)
+		vIters = 4e9;
+
+	for (int r = 0; r < sReps; r++)
+	{
+		Time(entry.mFunc, (VUINT)vIters, &vPassNs, &vPassTicks);
+		vNs.push_back(vPassNs / (VUINT)vIters);
+		vTicks.push_back(vPassTicks / (VUINT)vIters);
+	}
+	std::sort(vNs.begin(), vNs.end());
+	std::sort(vTicks.begin(), vTicks.end());
+
+	vResult.mName = entry.mName;
+	vResult.mTier = eTier;
+	vResult.mIters = (VUINT)vIters;
+	vResult.mNs = vNs[vNs.size() / 2];
+	vResult.mCycles = vTicks[vTicks.size() / 2];
+	return vResult;
+}
+
+/*
+ * One result per line, in run order, so two files diff cleanly.
+ */
+static bool WriteJson(const char *pFile, const std::vector<VBenchResult> &vResults)
+{
+	FILE	*vOut = strcmp(pFile, "-") == 0 ? stdout : fopen(pFile, "w");
+
+	if (vOut == NULL)
+		return false;
+
+	fprintf(vOut, "{\n");
+	fprintf(vOut, "  \"seed\": %u,\n", sSeed);
+	fprintf(vOut, "  \"detected_tier\": \"%s\",\n", VCPU::GetTierName(VCPU::GetDetectedTier()));
+	fprintf(vOut, "  \"min_time_ms\": %.0f,\n", sMinNs / 1e6);
+	fprintf(vOut, "  \"repetitions\": %d,\n", sReps);
+	fprintf(vOut, "  \"results\": [\n");
+	for (size_t i = 0; i < vResults.size(); i++)
+	{
+		const VBenchResult &r = vResults[i];
+		fprintf(vOut, "    {\"name\": \"%s\", \"tier\": \"%s\", \"iterations\": %u, "
+				"\"ns_per_op\": %.4f, \"cycles_per_op\": %.3f, \"ops_per_sec\": %.0f}%s\n",
+				r.mName, VCPU::GetTierName(r.mTier), r.mIters, r.mNs, r.mCycles,
+				r.mNs > 0.0 ? 1e9 / r.mNs : 0.0, i + 1 < vResults.size() ? "," : "");
+	}
+	fprintf(vOut, "  ]\n}\n");
+
+	if (vOut != stdout)
+		fclose(vOut);
+	return true;
+}
+
+static void Usage(const char *pName)
+{
+	cerr << "usage: " << pName << " [options]" << endl
+		<< "  --json FILE     write results as JSON (- for stdout)" << endl
+		<< "  --filter TEXT   only run benchmarks whose name contains TEXT" << endl
+		<< "  --tier NAME     only run one tier (scalar, sse2, sse41, avx2, fma)" << endl
+		<< "  --seed N        seed for the random inputs (default 1)" << endl
+		<< "  --min-time MS   time each repetition runs for (default 50)" << endl
+		<< "  --reps N        repetitions to take the median of (default 5)" << endl
+		<< "  --list          print the benchmark names and exit" << endl;
+}
+
+int main(int argc, char *argv[])
+{
+	std::vector<VBenchResult>	vResults;
+	const VBenchEntry			*vBench;
+	int							vCount;
+	bool						vList = false;
+	char						vLine[160];
+
+	for (int i = 1; i < argc; i++)
+	{
+		bool vHasArg = i + 1 < argc;
+
+		if (strcmp(argv[i], "--json") == 0 && vHasArg)
+			sJson = argv[++i];
+		else if (strcmp(argv[i], "--filter") == 0 && vHasArg)
+			sFilter = argv[++i];
+		else if (strcmp(argv[i], "--tier") == 0 && vHasArg)
+		{
+			const char *vName = argv[++i];
+			for (int t = 0; t < SIMD_TIER_COUNT; t++)
+				if (strcmp(vName, VCPU::GetTierName((VSimdTier)t)) == 0)
+					sTier = t;
+			if (sTier < 0)
+			{
+				cerr << "unknown tier " << vName << endl;
+				return 1;
+			}
+		}
+		else if (strcmp(argv[i], "--seed") == 0 && vHasArg)
+			sSeed = (unsigned int)strtoul(argv[++i], NULL, 10);
+		else if (strcmp(argv[i], "--min-time") == 0 && vHasArg)
+			sMinNs = atof(argv[++i]) * 1e6;
+		else if (strcmp(argv[i], "--reps") == 0 && vHasArg)
+			sReps = atoi(argv[++i]) > 0 ? atoi(argv[i]) : 1;
+		else if (strcmp(argv[i], "--list") == 0)
+			vList = true;
+		else
+		{
+			Usage(argv[0]);
+			return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+		}
+	}
+
+	VCPU::Init();
+	vBench = GetMathBenchmarks(&vCount);
+
+	/* keep stdout clean when the JSON goes there */
+	std::ostream &vLog = (sJson != NULL && strcmp(sJson, "-") == 0) ? cerr : cout;
+
+	if (vList)
+	{
+		for (int b = 0; b < vCount; b++)
+			cout << vBench[b].mName << endl;
+		return 0;
+	}
+
+	if (sTier > VCPU::GetDetectedTier())
+	{
+		cerr << "tier " << VCPU::GetTierName((VSimdTier)sTier)
+			<< " is not supported here" << endl;
+		return 1;
+	}
+
+	vLog << "Detected tier: " << VCPU::GetTierName(VCPU::GetDetectedTier())
+		<< "  seed: " << sSeed << endl;
+	sprintf(vLine, "%-40s %-6s %12s %10s %14s", "benchmark", "tier", "ns/op",
+			"cycles/op", "ops/s");
+	vLog << vLine << endl;
+
+	for (int t = SIMD_SCALAR; t <= VCPU::GetDetectedTier(); t++)
+	{
+		if (sTier >= 0 && t != sTier)
+			continue;
+
+		/* same seed for every tier, so they all see the same numbers */
+		VCPU::SetTier((VSimdTier)t);
+		SetupMathInputs(sSeed);
+
+		for (int b = 0; b < vCount; b++)
+		{
+			if (sFilter != NULL && strstr(vBench[b].mName, sFilter) == NULL)
+				continue;
+
+			VBenchResult r = Run(vBench[b], (VSimdTier)t);
+			vResults.push_back(r);
+
+			sprintf(vLine, "%-40s %-6s %12.3f %10.2f %14.0f", r.mName,
+					VCPU::GetTierName(r.mTier), r.mNs, r.mCycles,
+					r.mNs > 0.0 ? 1e9 / r.mNs : 0.0);
+			vLog << vLine << endl;
+		}
+	}
+	VCPU::SetTier(VCPU::GetDetectedTier());
+
+	if (sJson != NULL && !WriteJson(sJson, vResults))
+	{
+		cerr << "could not write " << sJson << endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,76 @@
+#if !defined(__BENCH_H_INCLUDED__)
+#define __BENCH_H_INCLUDED__
+
+#include <cstdlib>
+#include <viper3d/Math.h>
+#include <viper3d/util/CPU.h>
+#include <viper3d/util/Clock.h>
+
+using namespace UDP;
+
+/* inputs per benchmark; a power of two so the index is a mask */
+#define BENCH_POOL		1024
+
+/*
+ * Keeps the compiler from discarding a result or assuming it knows what
+ * is in memory, without costing more than a store.
+ */
+#if defined(__GNUC__)
+template <class T>
+inline void DoNotOptimize(const T &value)
+{
+	__asm__ __volatile__("" : : "r"(&value) : "memory");
+}
+
+inline void ClobberMemory()
+{
+	__asm__ __volatile__("" : : : "memory");
+}
+#else
+void BenchEscape(const void *pValue);
+
+template <class T>
+inline void DoNotOptimize(const T &value)
+{
+	BenchEscape(&value);
+}
+
+inline void ClobberMemory()
+{
+	BenchEscape(NULL);
+}
+#endif
+
+/*
+ * Uniform random number between fMin and fMax.
+ */
+inline float Rand(float fMin, float fMax)
+{
+	return fMin + (fMax - fMin) * (rand() / (float)RAND_MAX);
+}
+
+/*
+ * Monotonic wall time in nanoseconds.
+ */
+inline double NowNs()
+{
+	return (double)VClock::GetNanos();
+}
+
+/*
+ * A benchmark runs nIters operations, each on the inputs at
+ * (i & (BENCH_POOL - 1)), so there is nothing loop-invariant to hoist.
+ */
+typedef void (*VBenchFunc)(VUINT nIters);
+
+struct VBenchEntry
+{
+	const char		*mName;
+	VBenchFunc		mFunc;
+};
+
+/* mathbench.cpp */
+void SetupMathInputs(unsigned int nSeed);
+const VBenchEntry* GetMathBenchmarks(int *pCount);
+
+#endif // __BENCH_H_INCLUDED__
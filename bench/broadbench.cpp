@@ -0,0 +1,192 @@
+#include "bench.h"
+#include <viper3d/math/Broadphase.h>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+/* the brute force loop is only timed up to this many boxes */
+#define BROAD_BRUTE_MAX		5000
+
+static const VUINT	sSizes[] = { 1000, 2000, 5000, 10000, 20000, 50000, 100000 };
+static unsigned int	sSeed = 1;
+static int			sFrames = 0;		/* 0: enough for about 2M box moves */
+static VUINT		sMax = 100000;
+
+/*
+ * Boxes of about a unit in a cube sized so each has a few neighbours
+ * whatever the count, drifting a little every frame.
+ */
+struct VScene
+{
+	std::vector<VVector>	mCenter;
+	std::vector<VVector>	mExtent;
+	std::vector<VVector>	mVel;
+	float					mHalf;
+
+	void Setup(VUINT nCount)
+	{
+		mHalf = 1.2f * powf((float)nCount, 1.0f / 3.0f);
+		mCenter.resize(nCount);
+		mExtent.resize(nCount);
+		mVel.resize(nCount);
+		for (VUINT i = 0; i < nCount; i++)
+		{
+			mCenter[i] = VVector(Rand(-mHalf, mHalf), Rand(-mHalf, mHalf), Rand(-mHalf, mHalf));
+			mExtent[i] = VVector(Rand(0.25f, 0.75f), Rand(0.25f, 0.75f), Rand(0.25f, 0.75f));
+			mVel[i] = VVector(Rand(-0.05f, 0.05f), Rand(-0.05f, 0.05f), Rand(-0.05f, 0.05f));
+		}
+	}
+
+	void Step()
+	{
+		for (VUINT i = 0; i < (VUINT)mCenter.size(); i++)
+		{
+			VVector &c = mCenter[i];
+			c = c + mVel[i];
+			if (c.x < -mHalf || c.x > mHalf) mVel[i].x = -mVel[i].x;
+			if (c.y < -mHalf || c.y > mHalf) mVel[i].y = -mVel[i].y;
+			if (c.z < -mHalf || c.z > mHalf) mVel[i].z = -mVel[i].z;
+		}
+	}
+
+	VAabb Box(VUINT i) const
+	{
+		return VAabb(mCenter[i] - mExtent[i], mCenter[i] + mExtent[i]);
+	}
+};
+
+/*
+ * Average time of moving every box and updating, after the first frame
+ * has put them all in.
+ */
+static double RunBroadphase(VBroadphase &broad, VScene &scene, int nFrames,
+							VUINT *pPairs)
+{
+	double	vStart;
+	VUINT	vCount = (VUINT)scene.mCenter.size();
+
+	for (VUINT i = 0; i < vCount; i++)
+		broad.AddProxy(scene.Box(i));
+	broad.Update();
+
+	vStart = NowNs();
+	for (int f = 0; f < nFrames; f++)
+	{
+		scene.Step();
+		for (VUINT i = 0; i < vCount; i++)
+			broad.MoveProxy(i, scene.Box(i));
+		broad.Update();
+	}
+	*pPairs = broad.PairCount();
+	return (NowNs() - vStart) / nFrames;
+}
+
+static double RunBrute(VScene &scene, int nFrames, VUINT *pPairs)
+{
+	std::vector<VAabb>	vBoxes(scene.mCenter.size());
+	double				vStart;
+	VUINT				vPairs = 0;
+
+	vStart = NowNs();
+	for (int f = 0; f < nFrames; f++)
+	{
+		scene.Step();
+		for (VUINT i = 0; i < (VUINT)vBoxes.size(); i++)
+			vBoxes[i] = scene.Box(i);
+		vPairs = 0;
+		for (VUINT i = 0; i < (VUINT)vBoxes.size(); i++)
+			for (VUINT j = i + 1; j < (VUINT)vBoxes.size(); j++)
+				if (vBoxes[i].Intersects(vBoxes[j]))
+					vPairs++;
+	}
+	*pPairs = vPairs;
+	return (NowNs() - vStart) / nFrames;
+}
+
+static void Usage(const char *pName)
+{
+	cerr << "usage: " << pName << " [options]" << endl
+		<< "  --frames N      frames to time at every size" << endl
+		<< "  --max N         largest box count to run (default 100000)" << endl
+		<< "  --seed N        seed for the scene (default 1)" << endl;
+}
+
+int main(int argc, char *argv[])
+{
+	char	vLine[160];
+	VUINT	vPairs;
+	double	vNs;
+	int		vFrames;
+
+	for (int i = 1; i < argc; i++)
+	{
+		bool vHasArg = i + 1 < argc;
+
+		if (strcmp(argv[i], "--frames") == 0 && vHasArg)
+			sFrames = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--max") == 0 && vHasArg)
+			sMax = (VUINT)strtoul(argv[++i], NULL, 10);
+		else if (strcmp(argv[i], "--seed") == 0 && vHasArg)
+			sSeed = (unsigned int)strtoul(argv[++i], NULL, 10);
+		else
+		{
+			Usage(argv[0]);
+			return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+		}
+	}
+
+	VCPU::Init();
+
+	sprintf(vLine, "%-8s %-12s %12s %12s %10s", "boxes", "method", "ms/frame",
+			"ns/box", "pairs");
+	cout << vLine << endl;
+
+	for (size_t s = 0; s < sizeof(sSizes) / sizeof(sSizes[0]); s++)
+	{
+		VUINT vCount = sSizes[s];
+		if (vCount > sMax)
+			break;
+		vFrames = sFrames > 0 ? sFrames : (int)(2000000 / vCount);
+
+		for (int m = 0; m < 3; m++)
+		{
+			VScene		vScene;
+			VSweepPrune	vSap;
+			VHashGrid	vGrid(1.5f);
+			const char	*vName;
+
+			if (m == 2 && vCount > BROAD_BRUTE_MAX)
+				continue;
+
+			/* the same scene for every method */
+			srand(sSeed);
+			vScene.Setup(vCount);
+			if (m == 0)
+			{
+				vName = "VSweepPrune";
+				vNs = RunBroadphase(vSap, vScene, vFrames, &vPairs);
+			}
+			else if (m == 1)
+			{
+				vName = "VHashGrid";
+				vNs = RunBroadphase(vGrid, vScene, vFrames, &vPairs);
+			}
+			else
+			{
+				vName = "brute";
+				vNs = RunBrute(vScene, vFrames < 10 ? vFrames : 10, &vPairs);
+			}
+
+			sprintf(vLine, "%-8u %-12s %12.3f %12.1f %10u", vCount, vName,
+					vNs / 1e6, vNs / vCount, vPairs);
+			cout << vLine << endl;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,240 @@
+#include "bench.h"
+#include <viper3d/RenderQueue.h>
+#include <viper3d/Profiler.h>
+#include <viper3d/render/opengl/OGLRenderSystem.h>
+#include <viper3d/render/opengl/OGLOffscreenWindow.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+#if defined(HAVE_LIBEGL)
+
+/* cubes drawn every frame */
+#define GL_CUBES	256
+
+struct VSize
+{
+	VUINT	mWidth;
+	VUINT	mHeight;
+};
+
+static const VSize	sSizes[] = { { 320, 240 }, { 640, 480 }, { 1280, 720 }, { 1920, 1080 } };
+static int			sFrames = 100;
+static VUINT		sMax = 1920;
+
+/* position and colour, VERTEX_POSITION | VERTEX_COLOR */
+struct VCubeVertex
+{
+	float	mPos[3];
+	VBYTE	mColor[4];
+};
+
+/*
+ * Unit cube as 36 unindexed vertices, one colour per face.
+ */
+static VMeshHandle MakeCube(VRenderSystem &render)
+{
+	static const int	sFaces[6][4] = { { 0, 1, 3, 2 }, { 4, 6, 7, 5 }, { 0, 4, 5, 1 },
+										 { 2, 3, 7, 6 }, { 0, 2, 6, 4 }, { 1, 5, 7, 3 } };
+	static const int	sTris[6] = { 0, 1, 2, 0, 2, 3 };
+	VCubeVertex			vVerts[36];
+	VMeshDesc			vDesc;
+
+	for (int f = 0; f < 6; f++)
+	{
+		for (int t = 0; t < 6; t++)
+		{
+			VCubeVertex &vV = vVerts[f * 6 + t];
+			int nCorner = sFaces[f][sTris[t]];
+
+			vV.mPos[0] = nCorner & 4 ? 1.0f : -1.0f;
+			vV.mPos[1] = nCorner & 2 ? 1.0f : -1.0f;
+			vV.mPos[2] = nCorner & 1 ? 1.0f : -1.0f;
+			vV.mColor[0] = (VBYTE)(40 * f + 40);
+			vV.mColor[1] = (VBYTE)(255 - 40 * f);
+			vV.mColor[2] = (VBYTE)(f & 1 ? 200 : 60);
+			vV.mColor[3] = 255;
+		}
+	}
+	vDesc.mFormat = VERTEX_POSITION | VERTEX_COLOR;
+	vDesc.mNumVerts = 36;
+	return render.CreateMesh(vDesc, vVerts, NULL);
+}
+
+/*
+ * A grid of cubes in front of the camera, queued the way a game frame
+ * would be.
+ */
+static void FillQueue(VRenderQueue &queue, VMeshHandle hCube, std::vector<VMatrix> &worlds)
+{
+	worlds.resize(GL_CUBES);
+	queue.Clear();
+	for (VUINT i = 0; i < GL_CUBES; i++)
+	{
+		VVector vPos(-60.0f + 8.0f * (i % 16), -45.0f + 6.0f * (i / 16), -120.0f - (i % 7) * 5.0f);
+
+		worlds[i] = VMatrix::MATRIX_IDENTITY;
+		worlds[i].SetTranslation(vPos);
+		queue.Push(queue.MakeKey(0, i % 4, 0, hCube, queue.GetDepth(vPos)), i % 4, 0, hCube,
+					&worlds[i]);
+	}
+}
+
+/*
+ * Frames per second at one size.  Mode 0 draws only, mode 1 reads each
+ * frame back with glReadPixels() and mode 2 captures through the pixel
+ * buffer objects.
+ */
+static double RunFrames(VOGLRenderSystem &render, VOGLOffscreenWindow *pWin, VCamera &camera,
+						VRenderQueue &queue, int nMode, std::vector<VBYTE> &pixels)
+{
+	VUINT64 vStart;
+
+	pWin->SetCapture(nMode == 2);
+	render.Render(pWin, &camera, &queue);
+	pWin->Finish();
+	glFinish();
+	vStart = VProfiler::GetTicks();
+	for (int f = 0; f < sFrames; f++)
+	{
+		render.Render(pWin, &camera, &queue);
+		if (nMode == 1)
+			pWin->ReadPixels(&pixels[0]);
+	}
+	pWin->Finish();
+	glFinish();
+	return sFrames * VProfiler::GetTickRate() / (double)(VProfiler::GetTicks() - vStart);
+}
+
+/*
+ * The last captured frame against a direct read of the same frame.
+ */
+static VUINT CheckCapture(VOGLRenderSystem &render, VOGLOffscreenWindow *pWin, VCamera &camera,
+						  VRenderQueue &queue, std::vector<VBYTE> &pixels)
+{
+	const VBYTE	*vFrame;
+	VUINT		vFrameNum, vErrors = 0;
+
+	pWin->SetCapture(true);
+	render.Render(pWin, &camera, &queue);
+	render.Render(pWin, &camera, &queue);
+	pWin->Finish();
+	vFrame = pWin->GetFrame(&vFrameNum);
+	if (vFrame == NULL || vFrameNum != pWin->GetSwaps() || !pWin->ReadPixels(&pixels[0]) ||
+		memcmp(vFrame, &pixels[0], pixels.size()) != 0)
+		vErrors++;
+	pWin->SetCapture(false);
+	return vErrors;
+}
+
+static void Usage(const char *pName)
+{
+	cerr << "usage: " << pName << " [options]" << endl
+		<< "  --frames N      frames to time at every size (default 100)" << endl
+		<< "  --max N         widest window to run (default 1920)" << endl;
+}
+
+int main(int argc, char *argv[])
+{
+	static const char	*sModes[] = { "draw", "sync", "async" };
+	VOGLRenderSystem	vRender;
+	VOGLOffscreenWindow	*vWin;
+	VRenderQueue		vQueue;
+	VCamera				vCamera;
+	VWindowOpts			vOpts;
+	VMeshHandle			vCube;
+	std::vector<VMatrix>	vWorlds;
+	std::vector<VBYTE>	vPixels;
+	char				vLine[160];
+	VUINT				vErrors = 0;
+	double				vFps;
+
+	for (int i = 1; i < argc; i++)
+	{
+		bool vHasArg = i + 1 < argc;
+
+		if (strcmp(argv[i], "--frames") == 0 && vHasArg)
+			sFrames = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--max") == 0 && vHasArg)
+			sMax = (VUINT)strtoul(argv[++i], NULL, 10);
+		else
+		{
+			Usage(argv[0]);
+			return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+		}
+	}
+
+	VCPU::Init();
+
+	vOpts.mWidth = sSizes[0].mWidth;
+	vOpts.mHeight = sSizes[0].mHeight;
+	vOpts.mOffscreen = true;
+	if (!vRender.Init() ||
+		(vWin = static_cast<VOGLOffscreenWindow*>(vRender.CreateWin(&vOpts))) == NULL)
+	{
+		cerr << "Unable to create an offscreen OpenGL window." << endl;
+		return 1;
+	}
+	if ((vCube = MakeCube(vRender)) == 0)
+	{
+		cerr << "Buffer objects not supported." << endl;
+		vRender.DestroyWin(vWin);
+		return 1;
+	}
+	vCamera.SetPosition(VVector(0, 0, 0, 1));
+	vCamera.SetDirection(-VVector::VECTOR_UNIT_Z);
+	vQueue.SetEye(VVector(0.0f, 0.0f, 0.0f), 1000.0f);
+
+	cout << "renderer: " << glGetString(GL_RENDERER) << ", readback "
+		<< (vWin->IsAsync() ? "through pixel buffer objects" : "synchronous only") << endl;
+	sprintf(vLine, "%-10s %-6s %10s %10s %10s", "size", "mode", "fps", "ms/frame", "MB/s");
+	cout << vLine << endl;
+
+	for (size_t s = 0; s < sizeof(sSizes) / sizeof(sSizes[0]); s++)
+	{
+		char vSize[16];
+
+		if (sSizes[s].mWidth > sMax)
+			break;
+		vOpts.mWidth = sSizes[s].mWidth;
+		vOpts.mHeight = sSizes[s].mHeight;
+		if (!vWin->Resize(&vOpts))
+		{
+			cerr << "Unable to resize to " << vOpts.mWidth << "x" << vOpts.mHeight << endl;
+			break;
+		}
+		vPixels.resize(vOpts.mWidth * vOpts.mHeight * 4);
+		sprintf(vSize, "%ux%u", vOpts.mWidth, vOpts.mHeight);
+
+		for (int m = 0; m < 3; m++)
+		{
+			FillQueue(vQueue, vCube, vWorlds);
+			vFps = RunFrames(vRender, vWin, vCamera, vQueue, m, vPixels);
+			sprintf(vLine, "%-10s %-6s %10.1f %10.3f %10.1f", vSize, sModes[m], vFps,
+					1000.0 / vFps, m == 0 ? 0.0 : vFps * vPixels.size() / (1024.0 * 1024.0));
+			cout << vLine << endl;
+		}
+		FillQueue(vQueue, vCube, vWorlds);
+		vErrors += CheckCapture(vRender, vWin, vCamera, vQueue, vPixels);
+	}
+	cout << "readback errors: " << vErrors << endl;
+
+	vRender.DestroyMesh(vCube);
+	vRender.DestroyWin(vWin);
+	return vErrors == 0 ? 0 : 1;
+}
+
+#else
+
+int main(int argc, char *argv[])
+{
+	cerr << "Built without EGL, no offscreen windows to time." << endl;
+	return 1;
+}
+
+#endif // HAVE_LIBEGL
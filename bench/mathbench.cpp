@@ -0,0 +1,504 @@
+#include "bench.h"
+#include <viper3d/math/AabbBatch.h>
+#include <viper3d/math/ObbBatch.h>
+#include <viper3d/math/TriangleBvh.h>
+#include <cstdlib>
+
+/* elements per call for the array versions of the VMath functions */
+#define BENCH_ARRAY		16
+#define BENCH_BOXES		64		/* boxes in gBoxes and gObbs0/1 */
+
+/*
+ * Random inputs, regenerated for every tier from the same seed.  Each
+ * benchmark walks these, so consecutive operations never see the same
+ * values and no part of the body is loop-invariant.
+ */
+static float		gF[BENCH_POOL];		/* [-1, 1] */
+static float		gFPos[BENCH_POOL];	/* (0, 100] */
+static VVector		gV0[BENCH_POOL];
+static VVector		gV1[BENCH_POOL];
+static VVector		gN[BENCH_POOL];		/* unit length */
+static VMatrix		gM0[BENCH_POOL];
+static VMatrix		gM1[BENCH_POOL];
+static VAffine		gXf0[BENCH_POOL];
+static VAffine		gXf1[BENCH_POOL];
+static VQuaternion	gQ0[BENCH_POOL];
+static VQuaternion	gQ1[BENCH_POOL];
+static VPlane		gPlane[BENCH_POOL];
+static VRay			gRay[BENCH_POOL];
+static VSlabRay		gSlab[BENCH_POOL];	/* the same rays */
+static VAabb		gAabb0[BENCH_POOL];
+static VAabb		gAabb1[BENCH_POOL];
+static VObb			gObb0[BENCH_POOL];
+static VObb			gObb1[BENCH_POOL];
+static VPolygon		gPoly[BENCH_POOL];
+static VPlane		gFrustum[6];
+static VTriangleBvh	gTris;				/* the triangles of every gPoly */
+static VAabbBatch	gBoxes;				/* the first BENCH_BOXES of gAabb0 */
+static VObbBatch	gObbs0;				/* the first BENCH_BOXES of gObb0 */
+static VObbBatch	gObbs1;				/* ... and of gObb1 */
+static VVectorBatch	gCorners[3];		/* the first BENCH_BOXES of gV0, gV1, gN */
+static VUINT		gIndices[BENCH_BOXES];
+static VUINT		gHits[(BENCH_BOXES + 31) / 32];
+static float		gEnter[BENCH_BOXES];
+static float		gOut0[BENCH_ARRAY];
+static float		gOut1[BENCH_ARRAY];
+
+static VVector RandVec(float fRange)
+{
+	return VVector(Rand(-fRange, fRange), Rand(-fRange, fRange), Rand(-fRange, fRange));
+}
+
+static VVector RandUnit()
+{
+	VVector	vN;
+
+	do
+	{
+		vN = RandVec(1.0f);
+	} while (vN.SquaredLength() < 0.01f);
+	vN.Normalize();
+	return vN;
+}
+
+static VMatrix RandTransform()
+{
+	VMatrix	vM = VMatrix::MATRIX_IDENTITY;
+
+	vM.RotaArbi(RandUnit(), Rand(-3.14f, 3.14f));
+	vM.SetTranslation(RandVec(10.0f));
+	return vM;
+}
+
+static VObb RandObb()
+{
+	VObb	vObb;
+	VMatrix	vRot = VMatrix::MATRIX_IDENTITY;
+
+	vRot.RotaArbi(RandUnit(), Rand(-3.14f, 3.14f));
+	vObb.vA0 = VVector(vRot[0][0], vRot[1][0], vRot[2][0]);
+	vObb.vA1 = VVector(vRot[0][1], vRot[1][1], vRot[2][1]);
+	vObb.vA2 = VVector(vRot[0][2], vRot[1][2], vRot[2][2]);
+	vObb.fA0 = Rand(0.5f, 3.0f);
+	vObb.fA1 = Rand(0.5f, 3.0f);
+	vObb.fA2 = Rand(0.5f, 3.0f);
+	vObb.vCenter = RandVec(5.0f);
+	return vObb;
+}
+
+static VAabb RandAabb()
+{
+	VVector	vCenter = RandVec(5.0f);
+	VVector	vExtent(Rand(0.5f, 3.0f), Rand(0.5f, 3.0f), Rand(0.5f, 3.0f));
+
+	return VAabb(vCenter - vExtent, vCenter + vExtent);
+}
+
+void SetupMathInputs(unsigned int nSeed)
+{
+	static const VUINT	vQuad[6] = { 0, 1, 2, 0, 2, 3 };
+	VVector				vPoints[4], vU, vV;
+
+	srand(nSeed);
+	for (VUINT n = 0; n < BENCH_POOL; n++)
+	{
+		gF[n] = Rand(-1.0f, 1.0f);
+		gFPos[n] = Rand(0.001f, 100.0f);
+		gV0[n] = RandVec(10.0f);
+		gV1[n] = RandVec(10.0f);
+		gN[n] = RandUnit();
+		gM0[n] = RandTransform();
+		gM1[n] = RandTransform();
+		gXf0[n].FromMatrix(gM0[n]);
+		gXf1[n].FromMatrix(gM1[n]);
+		gQ0[n].FromAngleAxis(Rand(-3.14f, 3.14f), RandUnit());
+		gQ1[n].FromAngleAxis(Rand(-3.14f, 3.14f), RandUnit());
+		gPlane[n].Set(RandUnit(), RandVec(5.0f));
+		/* aimed roughly at the middle, so about half of them hit */
+		gRay[n].SetValues(RandVec(10.0f) * 2.0f, RandUnit());
+		gRay[n].SetDirection(((RandVec(3.0f) - gRay[n].GetOrigin()).UnitVector()));
+		gSlab[n].Set(gRay[n]);
+		gAabb0[n] = RandAabb();
+		gAabb1[n] = RandAabb();
+		gObb0[n] = RandObb();
+		gObb1[n] = RandObb();
+
+		/* a quad, two triangles, in a random plane */
+		vU = RandUnit();
+		vV = vU.CrossProduct(RandUnit()).UnitVector();
+		vPoints[0] = RandVec(4.0f);
+		vPoints[1] = vPoints[0] + vU * Rand(1.0f, 4.0f);
+		vPoints[2] = vPoints[1] + vV * Rand(1.0f, 4.0f);
+		vPoints[3] = vPoints[0] + vV * Rand(1.0f, 4.0f);
+		gPoly[n].Set(vPoints, 4, vQuad, 6);
+	}
+	for (int p = 0; p < 6; p++)
+		gFrustum[p].Set(RandUnit(), VVector(), -8.0f);
+	gTris.Build(gPoly, BENCH_POOL);
+	gBoxes.FromAabbs(gAabb0, BENCH_BOXES);
+	gObbs0.FromObbs(gObb0, BENCH_BOXES);
+	gObbs1.FromObbs(gObb1, BENCH_BOXES);
+	gCorners[0].FromVectors(gV0, BENCH_BOXES);
+	gCorners[1].FromVectors(gV1, BENCH_BOXES);
+	gCorners[2].FromVectors(gN, BENCH_BOXES);
+}
+
+/*
+ * One benchmark: body runs once per iteration with n indexing the
+ * inputs, if it needs them.  Declare one variable per statement; a bare
+ * comma in the body splits the macro argument.
+ */
+#define BENCH(func, body) \
+static void func(VUINT nIters) \
+{ \
+	for (VUINT i = 0; i < nIters; i++) \
+	{ \
+		VUINT n = i & (BENCH_POOL - 1); \
+		(void)n; \
+		body \
+	} \
+}
+
+/* loop, index and sink alone, to compare everything else against */
+BENCH(BenchBaseline,		DoNotOptimize(gV0[n]);)
+
+/* VMath */
+BENCH(BenchMathAbs,			DoNotOptimize(VMath::Abs(gF[n]));)
+BENCH(BenchMathACos,		DoNotOptimize(VMath::ACos(gF[n]));)
+BENCH(BenchMathASin,		DoNotOptimize(VMath::ASin(gF[n]));)
+BENCH(BenchMathATan,		DoNotOptimize(VMath::ATan(gFPos[n]));)
+BENCH(BenchMathCos,			DoNotOptimize(VMath::Cos(gFPos[n]));)
+BENCH(BenchMathSin,			DoNotOptimize(VMath::Sin(gFPos[n]));)
+BENCH(BenchMathTan,			DoNotOptimize(VMath::Tan(gF[n]));)
+BENCH(BenchMathSqrt,		DoNotOptimize(VMath::Sqrt(gFPos[n]));)
+BENCH(BenchMathDegToRad,	DoNotOptimize(VMath::DegToRad(gFPos[n]));)
+BENCH(BenchMathRadToDeg,	DoNotOptimize(VMath::RadToDeg(gF[n]));)
+BENCH(BenchMathModulus,		DoNotOptimize(VMath::Modulus(gFPos[n], 7));)
+
+/* VMath accuracy tiers, one call at a time */
+BENCH(BenchMathSinCosExact,	float s; float c; VMath::SinCos(gFPos[n], &s, &c, MATH_EXACT); DoNotOptimize(s); DoNotOptimize(c);)
+BENCH(BenchMathSinCosPrecise,	float s; float c; VMath::SinCos(gFPos[n], &s, &c, MATH_PRECISE); DoNotOptimize(s); DoNotOptimize(c);)
+BENCH(BenchMathSinCosFast,	float s; float c; VMath::SinCos(gFPos[n], &s, &c, MATH_FAST); DoNotOptimize(s); DoNotOptimize(c);)
+BENCH(BenchMathATan2Exact,	DoNotOptimize(VMath::ATan2(gF[n], gF[(n + 1) & (BENCH_POOL - 1)], MATH_EXACT));)
+BENCH(BenchMathATan2Precise,	DoNotOptimize(VMath::ATan2(gF[n], gF[(n + 1) & (BENCH_POOL - 1)], MATH_PRECISE));)
+BENCH(BenchMathATan2Fast,	DoNotOptimize(VMath::ATan2(gF[n], gF[(n + 1) & (BENCH_POOL - 1)], MATH_FAST));)
+BENCH(BenchMathACosExact,	DoNotOptimize(VMath::ACos(gF[n], MATH_EXACT));)
+BENCH(BenchMathACosPrecise,	DoNotOptimize(VMath::ACos(gF[n], MATH_PRECISE));)
+BENCH(BenchMathACosFast,	DoNotOptimize(VMath::ACos(gF[n], MATH_FAST));)
+BENCH(BenchMathRSqrtExact,	DoNotOptimize(VMath::RSqrt(gFPos[n], MATH_EXACT));)
+BENCH(BenchMathRSqrtPrecise,	DoNotOptimize(VMath::RSqrt(gFPos[n], MATH_PRECISE));)
+BENCH(BenchMathRSqrtFast,	DoNotOptimize(VMath::RSqrt(gFPos[n], MATH_FAST));)
+
+/*
+ * The array versions, BENCH_ARRAY elements a call.  They follow
+ * SetAccuracy(), so each one sets it and puts back the default.
+ */
+BENCH(BenchMathSinCosArrayExact,	VMath::SetAccuracy(MATH_EXACT); VMath::SinCos(&gFPos[n & ~(BENCH_ARRAY - 1)], gOut0, gOut1, BENCH_ARRAY); VMath::SetAccuracy(MATH_EXACT); DoNotOptimize(gOut0[0]);)
+BENCH(BenchMathSinCosArrayFast,	VMath::SetAccuracy(MATH_FAST); VMath::SinCos(&gFPos[n & ~(BENCH_ARRAY - 1)], gOut0, gOut1, BENCH_ARRAY); VMath::SetAccuracy(MATH_EXACT); DoNotOptimize(gOut0[0]);)
+BENCH(BenchMathATan2ArrayExact,	VMath::SetAccuracy(MATH_EXACT); VMath::ATan2(&gF[n & ~(BENCH_ARRAY - 1)], &gFPos[n & ~(BENCH_ARRAY - 1)], gOut0, BENCH_ARRAY); VMath::SetAccuracy(MATH_EXACT); DoNotOptimize(gOut0[0]);)
+BENCH(BenchMathATan2ArrayFast,	VMath::SetAccuracy(MATH_FAST); VMath::ATan2(&gF[n & ~(BENCH_ARRAY - 1)], &gFPos[n & ~(BENCH_ARRAY - 1)], gOut0, BENCH_ARRAY); VMath::SetAccuracy(MATH_EXACT); DoNotOptimize(gOut0[0]);)
+BENCH(BenchMathACosArrayExact,	VMath::SetAccuracy(MATH_EXACT); VMath::ACos(&gF[n & ~(BENCH_ARRAY - 1)], gOut0, BENCH_ARRAY); VMath::SetAccuracy(MATH_EXACT); DoNotOptimize(gOut0[0]);)
+BENCH(BenchMathACosArrayFast,	VMath::SetAccuracy(MATH_FAST); VMath::ACos(&gF[n & ~(BENCH_ARRAY - 1)], gOut0, BENCH_ARRAY); VMath::SetAccuracy(MATH_EXACT); DoNotOptimize(gOut0[0]);)
+BENCH(BenchMathRSqrtArrayExact,	VMath::SetAccuracy(MATH_EXACT); VMath::RSqrt(&gFPos[n & ~(BENCH_ARRAY - 1)], gOut0, BENCH_ARRAY); VMath::SetAccuracy(MATH_EXACT); DoNotOptimize(gOut0[0]);)
+BENCH(BenchMathRSqrtArrayFast,	VMath::SetAccuracy(MATH_FAST); VMath::RSqrt(&gFPos[n & ~(BENCH_ARRAY - 1)], gOut0, BENCH_ARRAY); VMath::SetAccuracy(MATH_EXACT); DoNotOptimize(gOut0[0]);)
+
+/* VVector */
+BENCH(BenchVecLength,		DoNotOptimize(gV0[n].Length());)
+BENCH(BenchVecSquaredLength,	DoNotOptimize(gV0[n].SquaredLength());)
+BENCH(BenchVecUnitVector,	DoNotOptimize(gV0[n].UnitVector());)
+BENCH(BenchVecNormalize,	VVector v = gV0[n]; v.Normalize(); DoNotOptimize(v);)
+BENCH(BenchVecNegate,		VVector v = gV0[n]; v.Negate(); DoNotOptimize(v);)
+BENCH(BenchVecAngleWith,	DoNotOptimize(gN[n].AngleWith(gN[(n + 1) & (BENCH_POOL - 1)]));)
+BENCH(BenchVecRotateWith,	VVector v = gV0[n]; v.RotateWith(gM0[n]); DoNotOptimize(v);)
+BENCH(BenchVecInvRotateWith,	VVector v = gV0[n]; v.InvRotateWith(gM0[n]); DoNotOptimize(v);)
+BENCH(BenchVecDifference,	VVector v; v.Difference(gV0[n], gV1[n]); DoNotOptimize(v);)
+BENCH(BenchVecCrossProduct,	DoNotOptimize(gV0[n].CrossProduct(gV1[n]));)
+BENCH(BenchVecCross,		VVector v; v.Cross(gV0[n], gV1[n]); DoNotOptimize(v);)
+BENCH(BenchVecDotProduct,	DoNotOptimize(gV0[n].DotProduct(gV1[n]));)
+BENCH(BenchVecGetRotationTo,	DoNotOptimize(gN[n].GetRotationTo(gN[(n + 1) & (BENCH_POOL - 1)]));)
+BENCH(BenchVecEquals,		DoNotOptimize(gV0[n] == gV1[n]);)
+BENCH(BenchVecAddAssign,	VVector v = gV0[n]; v += gV1[n]; DoNotOptimize(v);)
+BENCH(BenchVecSubAssign,	VVector v = gV0[n]; v -= gV1[n]; DoNotOptimize(v);)
+BENCH(BenchVecMulAssign,	VVector v = gV0[n]; v *= gF[n]; DoNotOptimize(v);)
+BENCH(BenchVecDivAssign,	VVector v = gV0[n]; v /= gFPos[n]; DoNotOptimize(v);)
+BENCH(BenchVecDot,			DoNotOptimize(gV0[n] * gV1[n]);)
+BENCH(BenchVecScale,		DoNotOptimize(gV0[n] * gF[n]);)
+BENCH(BenchVecDivide,		DoNotOptimize(gV0[n] / gFPos[n]);)
+BENCH(BenchVecAdd,			DoNotOptimize(gV0[n] + gV1[n]);)
+BENCH(BenchVecSub,			DoNotOptimize(gV0[n] - gV1[n]);)
+BENCH(BenchVecMinus,		DoNotOptimize(-gV0[n]);)
+BENCH(BenchVecMulQuat,		DoNotOptimize(gV0[n] * gQ0[n]);)
+BENCH(BenchVecMulMatrix,	DoNotOptimize(gV0[n] * gM0[n]);)
+
+/* VMatrix */
+BENCH(BenchMatRotaX,		VMatrix m; m.RotaX(gF[n]); DoNotOptimize(m);)
+BENCH(BenchMatRota,			VMatrix m; m.Rota(gV0[n]); DoNotOptimize(m);)
+BENCH(BenchMatRotaArbi,		VMatrix m; m.RotaArbi(gN[n], gF[n]); DoNotOptimize(m);)
+BENCH(BenchMatApplyInverseRota,	VVector v = gV0[n]; gM0[n].ApplyInverseRota(&v); DoNotOptimize(v);)
+BENCH(BenchMatTranslate,	VMatrix m; m.Translate(gV0[n].x, gV0[n].y, gV0[n].z); DoNotOptimize(m);)
+BENCH(BenchMatSetTranslation,	VMatrix m = gM0[n]; m.SetTranslation(gV1[n]); DoNotOptimize(m);)
+BENCH(BenchMatGetTranslation,	DoNotOptimize(gM0[n].GetTranslation());)
+BENCH(BenchMatBillboard,	VMatrix m; m.Billboard(gV0[n], gN[n]); DoNotOptimize(m);)
+BENCH(BenchMatLookAt,		VMatrix m; m.LookAt(gV0[n], gV1[n]); DoNotOptimize(m);)
+BENCH(BenchMatTransposeOf,	VMatrix m; m.TransposeOf(gM0[n]); DoNotOptimize(m);)
+BENCH(BenchMatInverseOf,	VMatrix m; m.InverseOf(gM0[n]); DoNotOptimize(m);)
+BENCH(BenchMatAffineInverseOf,	VMatrix m; m.AffineInverseOf(gM0[n]); DoNotOptimize(m);)
+BENCH(BenchMatTranspose,	DoNotOptimize(gM0[n].Transpose());)
+BENCH(BenchMatMultiply,		DoNotOptimize(gM0[n] * gM1[n]);)
+BENCH(BenchMatMulVector,	DoNotOptimize(gM0[n] * gV0[n]);)
+BENCH(BenchMatTransformPoints,	VVector v; gM0[n].TransformPoints(&v, &gV0[n], 1); DoNotOptimize(v);)
+BENCH(BenchMatTransformDirections,	VVector v; gM0[n].TransformDirections(&v, &gV0[n], 1); DoNotOptimize(v);)
+BENCH(BenchMatAssign,		VMatrix m; m = gM0[n]; DoNotOptimize(m);)
+BENCH(BenchMatNegate,		DoNotOptimize(-gM0[n]);)
+BENCH(BenchMatMakeGLMatrix,	float f[16]; gM0[n].MakeGLMatrix(f); DoNotOptimize(f);)
+
+/* VAffine */
+BENCH(BenchXfSet,			VAffine x(gQ0[n], gV0[n]); DoNotOptimize(x);)
+BENCH(BenchXfMultiply,		DoNotOptimize(gXf0[n] * gXf1[n]);)
+BENCH(BenchXfInverseOf,		VAffine x; x.InverseOf(gXf0[n]); DoNotOptimize(x);)
+BENCH(BenchXfOrthoInverseOf,	VAffine x; x.OrthoInverseOf(gXf0[n]); DoNotOptimize(x);)
+BENCH(BenchXfTransformPoint,	DoNotOptimize(gXf0[n].TransformPoint(gV0[n]));)
+BENCH(BenchXfToMatrix,		VMatrix m; gXf0[n].ToMatrix(m); DoNotOptimize(m);)
+
+/* VQuaternion */
+BENCH(BenchQuatGetMagnitude,	DoNotOptimize(gQ0[n].GetMagnitude());)
+BENCH(BenchQuatGetAngle,	DoNotOptimize(gQ0[n].GetAngle());)
+BENCH(BenchQuatToAxes,		VVector v[3]; gQ0[n].ToAxes(v); DoNotOptimize(v);)
+BENCH(BenchQuatToRotationMatrix,	VMatrix m; gQ0[n].ToRotationMatrix(m); DoNotOptimize(m);)
+BENCH(BenchQuatCreateMatrix,	float f[16]; gQ0[n].CreateMatrix(f); DoNotOptimize(f);)
+BENCH(BenchQuatFromAngleAxis,	VQuaternion q; q.FromAngleAxis(gF[n], gN[n]); DoNotOptimize(q);)
+BENCH(BenchQuatNormalize,	VQuaternion q = gQ0[n]; q.Normalize(); DoNotOptimize(q);)
+BENCH(BenchQuatToAxisAngle,	VVector v; float a; gQ0[n].ToAxisAngle(v, a); DoNotOptimize(v); DoNotOptimize(a);)
+BENCH(BenchQuatConjugate,	VQuaternion q; q.Conjugate(gQ0[n]); DoNotOptimize(q);)
+BENCH(BenchQuatRotateQuat,	VQuaternion q; q.Rotate(gQ0[n], gQ1[n]); DoNotOptimize(q);)
+BENCH(BenchQuatRotateVector,	DoNotOptimize(gQ0[n].Rotate(gV0[n]));)
+BENCH(BenchQuatNlerp,		VQuaternion q; q.Nlerp(gQ0[n], gQ1[n], gFPos[n] * 0.01f); DoNotOptimize(q);)
+BENCH(BenchQuatSlerp,		VQuaternion q; q.Slerp(gQ0[n], gQ1[n], gFPos[n] * 0.01f); DoNotOptimize(q);)
+BENCH(BenchQuatScale,		DoNotOptimize(gQ0[n] * gF[n]);)
+BENCH(BenchQuatDivide,		DoNotOptimize(gQ0[n] / gFPos[n]);)
+BENCH(BenchQuatMulVector,	DoNotOptimize(gQ0[n] * gV0[n]);)
+BENCH(BenchQuatAdd,			DoNotOptimize(gQ0[n] + gQ1[n]);)
+BENCH(BenchQuatSub,			DoNotOptimize(gQ0[n] - gQ1[n]);)
+BENCH(BenchQuatMultiply,	DoNotOptimize(gQ0[n] * gQ1[n]);)
+BENCH(BenchQuatInverse,		DoNotOptimize(~gQ0[n]);)
+
+/* VPlane */
+BENCH(BenchPlaneSet,		VPlane p; p.Set(gV0[n], gV1[n], gV0[(n + 1) & (BENCH_POOL - 1)]); DoNotOptimize(p);)
+BENCH(BenchPlaneDistance,	DoNotOptimize(gPlane[n].Distance(gV0[n]));)
+BENCH(BenchPlaneClassifyPoint,	DoNotOptimize(gPlane[n].Classify(gV0[n]));)
+BENCH(BenchPlaneClassifyPolygon,	DoNotOptimize(gPlane[n].Classify(gPoly[n]));)
+BENCH(BenchPlaneClipRay,	VRay f; VRay b; DoNotOptimize(gPlane[n].Clip(&gRay[n], 100.0f, &f, &b));)
+BENCH(BenchPlaneTriangle,	DoNotOptimize(gPlane[n].Intersects(gV0[n], gV1[n], gN[n]));)
+BENCH(BenchPlanePlane,		VRay r; DoNotOptimize(gPlane[n].Intersects(gPlane[(n + 1) & (BENCH_POOL - 1)], &r));)
+BENCH(BenchPlaneAabb,		DoNotOptimize(gPlane[n].Intersects(gAabb0[n]));)
+BENCH(BenchPlaneObb,		DoNotOptimize(gPlane[n].Intersects(gObb0[n]));)
+
+/* VRay */
+BENCH(BenchRayDeTransform,	VRay r = gRay[n]; r.DeTransform(gM0[n]); DoNotOptimize(r);)
+BENCH(BenchRayTriangle,		float t; DoNotOptimize(gRay[n].Intersects(gV0[n], gV1[n], gN[n], false, &t));)
+BENCH(BenchRayTriangleLength,	float t; DoNotOptimize(gRay[n].Intersects(gV0[n], gV1[n], gN[n], false, 50.0f, &t));)
+BENCH(BenchRayPlane,		float t; VVector v; DoNotOptimize(gRay[n].Intersects(gPlane[n], false, &t, &v));)
+BENCH(BenchRayAabb,			float t; DoNotOptimize(gRay[n].Intersects(gAabb0[n], &t));)
+BENCH(BenchRayAabbLength,	float t; DoNotOptimize(gRay[n].Intersects(gAabb0[n], 50.0f, &t));)
+BENCH(BenchSlabRayAabb,		float t; DoNotOptimize(gSlab[n].Intersects(gAabb0[n], &t));)
+BENCH(BenchSlabRayEnters,	float t; DoNotOptimize(gSlab[n].Enters(gAabb0[n], 50.0f, &t));)
+BENCH(BenchAabbBatchRay,	gBoxes.RayMask(gSlab[n], 50.0f, gHits, gEnter); DoNotOptimize(gHits[0]);)
+BENCH(BenchRayObb,			float t; DoNotOptimize(gRay[n].Intersects(gObb0[n], &t));)
+BENCH(BenchRayObbLength,	float t; DoNotOptimize(gRay[n].Intersects(gObb0[n], 50.0f, &t));)
+
+/* VAabb */
+BENCH(BenchAabbGetPlanes,	VPlane p[6]; gAabb0[n].GetPlanes(p); DoNotOptimize(p);)
+BENCH(BenchAabbConstruct,	VAabb b; b.Construct(&gObb0[n]); DoNotOptimize(b);)
+BENCH(BenchAabbCull,		DoNotOptimize(gAabb0[n].Cull(gFrustum, 6));)
+BENCH(BenchAabbContains,	DoNotOptimize(gAabb0[n].Contains(gRay[n], 50.0f));)
+BENCH(BenchAabbRay,			float t; DoNotOptimize(gAabb0[n].Intersects(gRay[n], &t));)
+BENCH(BenchAabbAabb,		DoNotOptimize(gAabb0[n].Intersects(gAabb1[n]));)
+BENCH(BenchAabbPoint,		DoNotOptimize(gAabb0[n].Intersects(gV0[n]));)
+BENCH(BenchAabbSetCenter,	VAabb b = gAabb0[n]; b.SetCenter(gV0[n]); DoNotOptimize(b);)
+
+/* VObb */
+BENCH(BenchObbDeTransform,	VObb o; o.DeTransform(gObb0[n], gM0[n]); DoNotOptimize(o);)
+BENCH(BenchObbRay,			float t; DoNotOptimize(gObb0[n].Intersects(gRay[n], &t));)
+BENCH(BenchObbObb,			DoNotOptimize(gObb0[n].Intersects(gObb1[n]));)
+BENCH(BenchObbTriangle,		DoNotOptimize(gObb0[n].Intersects(gV0[n], gV1[n], gN[n]));)
+BENCH(BenchObbBatch,		DoNotOptimize(gObbs0.Intersects(gObbs1, gIndices));)
+BENCH(BenchObbBatchTri,		DoNotOptimize(gObbs0.Intersects(gCorners[0], gCorners[1], gCorners[2], gIndices));)
+BENCH(BenchObbCull,			DoNotOptimize(gObb0[n].Cull(gFrustum, 6));)
+
+/* VPolygon */
+BENCH(BenchPolyCopy,		VPolygon p; p = gPoly[n]; DoNotOptimize(p);)
+BENCH(BenchPolyClipPlane,	VPolygon f; VPolygon b; gPoly[n].Clip(gPlane[n], &f, &b); DoNotOptimize(f); DoNotOptimize(b);)
+BENCH(BenchPolyClipAabb,	VPolygon p; p = gPoly[n]; p.Clip(gAabb0[n]); DoNotOptimize(p);)
+BENCH(BenchPolyCull,		DoNotOptimize(gPoly[n].Cull(gAabb0[n]));)
+BENCH(BenchPolySwapFaces,	gPoly[n].SwapFaces(); DoNotOptimize(gPoly[n]);)
+BENCH(BenchPolyRay,			float t; DoNotOptimize(gPoly[n].Intersects(gRay[n], false, &t));)
+BENCH(BenchPolyRayLength,	float t; DoNotOptimize(gPoly[n].Intersects(gRay[n], false, 50.0f, &t));)
+
+/* VTriangleBvh, over 2048 triangles; the [8] versions trace VSIMD_PACKET rays a call */
+BENCH(BenchTriBvhPick,		VUINT tri; float t; DoNotOptimize(gTris.Pick(gRay[n], false, &tri, &t));)
+BENCH(BenchTriBvhOccluded,	DoNotOptimize(gTris.Occluded(gRay[n], 50.0f));)
+BENCH(BenchTriBvhPickPacket,	VRayPacket p; for (VUINT r = 0; r < VSIMD_PACKET; r++) p.Add(gRay[(n & ~(VSIMD_PACKET - 1)) + r]); gTris.Pick(p); DoNotOptimize(p.GetT(0));)
+BENCH(BenchTriBvhOccludedPacket,	VRayPacket p; for (VUINT r = 0; r < VSIMD_PACKET; r++) p.Add(gRay[(n & ~(VSIMD_PACKET - 1)) + r], 50.0f); DoNotOptimize(gTris.Occluded(p));)
+
+/* one node's frame: turn, move along the new heading, compose with the parent */
+BENCH(BenchSceneUpdate,		VQuaternion q = gQ1[n] * gQ0[n]; VVector p = gV0[n] + q * gN[n] * gF[n]; VAffine l(q, p); DoNotOptimize(gXf0[n] * l);)
+
+static const VBenchEntry sBenchmarks[] = {
+	{ "Baseline",							BenchBaseline },
+	{ "VMath::Abs",							BenchMathAbs },
+	{ "VMath::ACos",						BenchMathACos },
+	{ "VMath::ASin",						BenchMathASin },
+	{ "VMath::ATan",						BenchMathATan },
+	{ "VMath::Cos",							BenchMathCos },
+	{ "VMath::Sin",							BenchMathSin },
+	{ "VMath::Tan",							BenchMathTan },
+	{ "VMath::Sqrt",						BenchMathSqrt },
+	{ "VMath::DegToRad",					BenchMathDegToRad },
+	{ "VMath::RadToDeg",					BenchMathRadToDeg },
+	{ "VMath::Modulus",						BenchMathModulus },
+	{ "VMath::SinCos (exact)",				BenchMathSinCosExact },
+	{ "VMath::SinCos (precise)",			BenchMathSinCosPrecise },
+	{ "VMath::SinCos (fast)",				BenchMathSinCosFast },
+	{ "VMath::ATan2 (exact)",				BenchMathATan2Exact },
+	{ "VMath::ATan2 (precise)",				BenchMathATan2Precise },
+	{ "VMath::ATan2 (fast)",				BenchMathATan2Fast },
+	{ "VMath::ACos (exact)",				BenchMathACosExact },
+	{ "VMath::ACos (precise)",				BenchMathACosPrecise },
+	{ "VMath::ACos (fast)",					BenchMathACosFast },
+	{ "VMath::RSqrt (exact)",				BenchMathRSqrtExact },
+	{ "VMath::RSqrt (precise)",				BenchMathRSqrtPrecise },
+	{ "VMath::RSqrt (fast)",				BenchMathRSqrtFast },
+	{ "VMath::SinCos[16] (exact)",			BenchMathSinCosArrayExact },
+	{ "VMath::SinCos[16] (fast)",			BenchMathSinCosArrayFast },
+	{ "VMath::ATan2[16] (exact)",			BenchMathATan2ArrayExact },
+	{ "VMath::ATan2[16] (fast)",			BenchMathATan2ArrayFast },
+	{ "VMath::ACos[16] (exact)",			BenchMathACosArrayExact },
+	{ "VMath::ACos[16] (fast)",				BenchMathACosArrayFast },
+	{ "VMath::RSqrt[16] (exact)",			BenchMathRSqrtArrayExact },
+	{ "VMath::RSqrt[16] (fast)",			BenchMathRSqrtArrayFast },
+	{ "VVector::Length",					BenchVecLength },
+	{ "VVector::SquaredLength",				BenchVecSquaredLength },
+	{ "VVector::UnitVector",				BenchVecUnitVector },
+	{ "VVector::Normalize",					BenchVecNormalize },
+	{ "VVector::Negate",					BenchVecNegate },
+	{ "VVector::AngleWith",					BenchVecAngleWith },
+	{ "VVector::RotateWith",				BenchVecRotateWith },
+	{ "VVector::InvRotateWith",				BenchVecInvRotateWith },
+	{ "VVector::Difference",				BenchVecDifference },
+	{ "VVector::CrossProduct",				BenchVecCrossProduct },
+	{ "VVector::Cross",						BenchVecCross },
+	{ "VVector::DotProduct",				BenchVecDotProduct },
+	{ "VVector::GetRotationTo",				BenchVecGetRotationTo },
+	{ "VVector::operator==",				BenchVecEquals },
+	{ "VVector::operator+=",				BenchVecAddAssign },
+	{ "VVector::operator-=",				BenchVecSubAssign },
+	{ "VVector::operator*=(float)",			BenchVecMulAssign },
+	{ "VVector::operator/=(float)",			BenchVecDivAssign },
+	{ "VVector::operator*(VVector)",		BenchVecDot },
+	{ "VVector::operator*(float)",			BenchVecScale },
+	{ "VVector::operator/(float)",			BenchVecDivide },
+	{ "VVector::operator+",					BenchVecAdd },
+	{ "VVector::operator-",					BenchVecSub },
+	{ "VVector::operator-()",				BenchVecMinus },
+	{ "VVector::operator*(VQuaternion)",	BenchVecMulQuat },
+	{ "VVector::operator*(VMatrix)",		BenchVecMulMatrix },
+	{ "VMatrix::RotaX",						BenchMatRotaX },
+	{ "VMatrix::Rota",						BenchMatRota },
+	{ "VMatrix::RotaArbi",					BenchMatRotaArbi },
+	{ "VMatrix::ApplyInverseRota",			BenchMatApplyInverseRota },
+	{ "VMatrix::Translate",					BenchMatTranslate },
+	{ "VMatrix::SetTranslation",			BenchMatSetTranslation },
+	{ "VMatrix::GetTranslation",			BenchMatGetTranslation },
+	{ "VMatrix::Billboard",					BenchMatBillboard },
+	{ "VMatrix::LookAt",					BenchMatLookAt },
+	{ "VMatrix::TransposeOf",				BenchMatTransposeOf },
+	{ "VMatrix::InverseOf",					BenchMatInverseOf },
+	{ "VMatrix::AffineInverseOf",			BenchMatAffineInverseOf },
+	{ "VMatrix::Transpose",					BenchMatTranspose },
+	{ "VMatrix::operator*(VMatrix)",		BenchMatMultiply },
+	{ "VMatrix::operator*(VVector)",		BenchMatMulVector },
+	{ "VMatrix::TransformPoints",			BenchMatTransformPoints },
+	{ "VMatrix::TransformDirections",		BenchMatTransformDirections },
+	{ "VMatrix::operator=",					BenchMatAssign },
+	{ "VMatrix::operator-()",				BenchMatNegate },
+	{ "VMatrix::MakeGLMatrix",				BenchMatMakeGLMatrix },
+	{ "VAffine::Set",						BenchXfSet },
+	{ "VAffine::operator*(VAffine)",		BenchXfMultiply },
+	{ "VAffine::InverseOf",					BenchXfInverseOf },
+	{ "VAffine::OrthoInverseOf",			BenchXfOrthoInverseOf },
+	{ "VAffine::TransformPoint",			BenchXfTransformPoint },
+	{ "VAffine::ToMatrix",					BenchXfToMatrix },
+	{ "VQuaternion::GetMagnitude",			BenchQuatGetMagnitude },
+	{ "VQuaternion::GetAngle",				BenchQuatGetAngle },
+	{ "VQuaternion::ToAxes",				BenchQuatToAxes },
+	{ "VQuaternion::ToRotationMatrix",		BenchQuatToRotationMatrix },
+	{ "VQuaternion::CreateMatrix",			BenchQuatCreateMatrix },
+	{ "VQuaternion::FromAngleAxis",			BenchQuatFromAngleAxis },
+	{ "VQuaternion::Normalize",				BenchQuatNormalize },
+	{ "VQuaternion::ToAxisAngle",			BenchQuatToAxisAngle },
+	{ "VQuaternion::Conjugate",				BenchQuatConjugate },
+	{ "VQuaternion::Rotate(VQuaternion)",	BenchQuatRotateQuat },
+	{ "VQuaternion::Rotate(VVector)",		BenchQuatRotateVector },
+	{ "VQuaternion::Nlerp",					BenchQuatNlerp },
+	{ "VQuaternion::Slerp",					BenchQuatSlerp },
+	{ "VQuaternion::operator*(float)",		BenchQuatScale },
+	{ "VQuaternion::operator/(float)",		BenchQuatDivide },
+	{ "VQuaternion::operator*(VVector)",	BenchQuatMulVector },
+	{ "VQuaternion::operator+",				BenchQuatAdd },
+	{ "VQuaternion::operator-",				BenchQuatSub },
+	{ "VQuaternion::operator*(VQuaternion)",	BenchQuatMultiply },
+	{ "VQuaternion::operator~",				BenchQuatInverse },
+	{ "VPlane::Set(3 points)",				BenchPlaneSet },
+	{ "VPlane::Distance",					BenchPlaneDistance },
+	{ "VPlane::Classify(VVector)",			BenchPlaneClassifyPoint },
+	{ "VPlane::Classify(VPolygon)",			BenchPlaneClassifyPolygon },
+	{ "VPlane::Clip(VRay)",					BenchPlaneClipRay },
+	{ "VPlane::Intersects(triangle)",		BenchPlaneTriangle },
+	{ "VPlane::Intersects(VPlane)",			BenchPlanePlane },
+	{ "VPlane::Intersects(VAabb)",			BenchPlaneAabb },
+	{ "VPlane::Intersects(VObb)",			BenchPlaneObb },
+	{ "VRay::DeTransform",					BenchRayDeTransform },
+	{ "VRay::Intersects(triangle)",			BenchRayTriangle },
+	{ "VRay::Intersects(triangle, length)",	BenchRayTriangleLength },
+	{ "VRay::Intersects(VPlane)",			BenchRayPlane },
+	{ "VRay::Intersects(VAabb)",			BenchRayAabb },
+	{ "VRay::Intersects(VAabb, length)",	BenchRayAabbLength },
+	{ "VSlabRay::Intersects(VAabb)",		BenchSlabRayAabb },
+	{ "VSlabRay::Enters(VAabb, length)",	BenchSlabRayEnters },
+	{ "VAabbBatch::RayMask[64]",			BenchAabbBatchRay },
+	{ "VRay::Intersects(VObb)",				BenchRayObb },
+	{ "VRay::Intersects(VObb, length)",		BenchRayObbLength },
+	{ "VAabb::GetPlanes",					BenchAabbGetPlanes },
+	{ "VAabb::Construct",					BenchAabbConstruct },
+	{ "VAabb::Cull",						BenchAabbCull },
+	{ "VAabb::Contains",					BenchAabbContains },
+	{ "VAabb::Intersects(VRay)",			BenchAabbRay },
+	{ "VAabb::Intersects(VAabb)",			BenchAabbAabb },
+	{ "VAabb::Intersects(VVector)",			BenchAabbPoint },
+	{ "VAabb::SetCenter",					BenchAabbSetCenter },
+	{ "VObb::DeTransform",					BenchObbDeTransform },
+	{ "VObb::Intersects(VRay)",				BenchObbRay },
+	{ "VObb::Intersects(VObb)",				BenchObbObb },
+	{ "VObb::Intersects(triangle)",			BenchObbTriangle },
+	{ "VObbBatch::Intersects(VObbBatch)[64]",	BenchObbBatch },
+	{ "VObbBatch::Intersects(triangle)[64]",	BenchObbBatchTri },
+	{ "VObb::Cull",							BenchObbCull },
+	{ "VPolygon::operator=",				BenchPolyCopy },
+	{ "VPolygon::Clip(VPlane)",				BenchPolyClipPlane },
+	{ "VPolygon::Clip(VAabb) + copy",		BenchPolyClipAabb },
+	{ "VPolygon::Cull",						BenchPolyCull },
+	{ "VPolygon::SwapFaces",				BenchPolySwapFaces },
+	{ "VPolygon::Intersects(VRay)",			BenchPolyRay },
+	{ "VPolygon::Intersects(VRay, length)",	BenchPolyRayLength },
+	{ "VTriangleBvh::Pick",					BenchTriBvhPick },
+	{ "VTriangleBvh::Occluded",				BenchTriBvhOccluded },
+	{ "VTriangleBvh::Pick[8]",				BenchTriBvhPickPacket },
+	{ "VTriangleBvh::Occluded[8]",			BenchTriBvhOccludedPacket },
+	{ "Scene update (one node)",			BenchSceneUpdate },
+};
+
+const VBenchEntry* GetMathBenchmarks(int *pCount)
+{
+	*pCount = (int)(sizeof(sBenchmarks) / sizeof(sBenchmarks[0]));
+	return sBenchmarks;
+}
@@ -0,0 +1,244 @@
+#include "bench.h"
+#include <viper3d/RenderQueue.h>
+#include <viper3d/Profiler.h>
+#include <viper3d/render/null/NullRenderSystem.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+/* meshes the items draw from, and materials and textures they use */
+#define RENDER_MESHES		64
+#define RENDER_MATERIALS	32
+#define RENDER_TEXTURES		16
+
+static const VUINT	sSizes[] = { 100, 1000, 10000, 100000 };
+static unsigned int	sSeed = 1;
+static int			sFrames = 0;		/* 0: enough for about 2M items */
+static VUINT		sMax = 100000;
+static bool			sRecord = false;
+
+/*
+ * Draws of a frame: which mesh, with what state and where.  Half are
+ * level geometry already in world space, which the queue can merge.
+ */
+struct VItems
+{
+	std::vector<VMeshHandle>	mMesh;
+	std::vector<VUINT>			mMaterial;
+	std::vector<VUINT>			mTexture;
+	std::vector<VMatrix>		mWorld;
+	std::vector<bool>			mStatic;
+
+	void Setup(VUINT nCount, const VMeshHandle *pMeshes)
+	{
+		mMesh.resize(nCount);
+		mMaterial.resize(nCount);
+		mTexture.resize(nCount);
+		mWorld.resize(nCount);
+		mStatic.resize(nCount);
+		for (VUINT i = 0; i < nCount; i++)
+		{
+			mMesh[i] = pMeshes[rand() % RENDER_MESHES];
+			mMaterial[i] = rand() % RENDER_MATERIALS;
+			mTexture[i] = rand() % RENDER_TEXTURES;
+			mStatic[i] = (i & 1) == 0;
+			mWorld[i] = VMatrix::MATRIX_IDENTITY;
+			if (!mStatic[i])
+				mWorld[i].SetTranslation(VVector(Rand(-500.0f, 500.0f), Rand(-500.0f, 500.0f),
+											Rand(-500.0f, 500.0f)));
+		}
+	}
+};
+
+/*
+ * Average CPU time of submitting a frame, and the draws it made.
+ */
+static double RunQueued(VNullRenderSystem &render, VWindow *pWin, VCamera &camera,
+						const VItems &items, int nFrames, VUINT *pDraws)
+{
+	VRenderQueue	vQueue;
+	VUINT64			vStart;
+
+	vQueue.SetEye(VVector(0.0f, 0.0f, 0.0f), 1000.0f);
+	render.ClearRecord();
+	vStart = VProfiler::GetTicks();
+	for (int f = 0; f < nFrames; f++)
+	{
+		vQueue.Clear();
+		for (VUINT i = 0; i < (VUINT)items.mMesh.size(); i++)
+		{
+			const VMatrix &vW = items.mWorld[i];
+			float fDepth = vQueue.GetDepth(VVector(vW[0][3], vW[1][3], vW[2][3]));
+
+			vQueue.Push(vQueue.MakeKey(0, items.mMaterial[i], items.mTexture[i],
+										items.mMesh[i], fDepth),
+						items.mMaterial[i], items.mTexture[i], items.mMesh[i],
+						items.mStatic[i] ? NULL : &items.mWorld[i]);
+		}
+		render.Render(pWin, &camera, &vQueue);
+	}
+	*pDraws = render.GetFrames().back().mDraws;
+	return (VProfiler::GetTicks() - vStart) * 1e9 / VProfiler::GetTickRate() / nFrames;
+}
+
+static double RunDirect(VNullRenderSystem &render, VWindow *pWin, VCamera &camera,
+						const VItems &items, int nFrames, VUINT *pDraws)
+{
+	VUINT64 vStart;
+
+	render.ClearRecord();
+	vStart = VProfiler::GetTicks();
+	for (int f = 0; f < nFrames; f++)
+	{
+		for (VUINT i = 0; i < (VUINT)items.mMesh.size(); i++)
+		{
+			render.SetState(items.mMaterial[i], items.mTexture[i]);
+			render.SetWorldMatrix(items.mWorld[i]);
+			render.DrawMesh(items.mMesh[i]);
+		}
+		render.Render(pWin, &camera);
+	}
+	*pDraws = render.GetFrames().back().mDraws;
+	return (VProfiler::GetTicks() - vStart) * 1e9 / VProfiler::GetTickRate() / nFrames;
+}
+
+/*
+ * A stream mesh refilled with nCount vertices every frame.
+ */
+static double RunStream(VNullRenderSystem &render, VWindow *pWin, VCamera &camera,
+						VUINT nCount, int nFrames, VUINT *pDraws)
+{
+	std::vector<float>	vVerts(nCount * 3, 1.0f);
+	VMeshDesc			vDesc;
+	VMeshHandle			vMesh;
+	VUINT64				vStart;
+
+	vDesc.mUsage = BUFFER_STREAM;
+	vMesh = render.CreateMesh(vDesc, NULL, NULL);
+	render.ClearRecord();
+	vStart = VProfiler::GetTicks();
+	for (int f = 0; f < nFrames; f++)
+	{
+		vVerts[f % vVerts.size()] = (float)f;
+		render.UpdateMesh(vMesh, &vVerts[0], nCount);
+		render.DrawMesh(vMesh);
+		render.Render(pWin, &camera);
+	}
+	*pDraws = render.GetFrames().back().mDraws;
+	render.DestroyMesh(vMesh);
+	return (VProfiler::GetTicks() - vStart) * 1e9 / VProfiler::GetTickRate() / nFrames;
+}
+
+static void Usage(const char *pName)
+{
+	cerr << "usage: " << pName << " [options]" << endl
+		<< "  --frames N      frames to time at every size" << endl
+		<< "  --max N         largest item count to run (default 100000)" << endl
+		<< "  --seed N        seed for the scene (default 1)" << endl
+		<< "  --record        keep the command stream while timing" << endl;
+}
+
+int main(int argc, char *argv[])
+{
+	VNullRenderSystem	vRender;
+	VCamera				vCamera;
+	VWindowOpts			vOpts;
+	VWindow				*vWin;
+	VMeshHandle			vMeshes[RENDER_MESHES];
+	VMeshDesc			vDesc;
+	std::vector<float>	vVerts(3 * 36, 0.0f);
+	std::vector<VUINT>	vIndis(36, 0);
+	char				vLine[160];
+	VUINT				vDraws;
+	double				vNs;
+	int					vFrames;
+
+	for (int i = 1; i < argc; i++)
+	{
+		bool vHasArg = i + 1 < argc;
+
+		if (strcmp(argv[i], "--frames") == 0 && vHasArg)
+			sFrames = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--max") == 0 && vHasArg)
+			sMax = (VUINT)strtoul(argv[++i], NULL, 10);
+		else if (strcmp(argv[i], "--seed") == 0 && vHasArg)
+			sSeed = (unsigned int)strtoul(argv[++i], NULL, 10);
+		else if (strcmp(argv[i], "--record") == 0)
+			sRecord = true;
+		else
+		{
+			Usage(argv[0]);
+			return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+		}
+	}
+
+	VCPU::Init();
+
+	vOpts.mWidth = 1280;
+	vOpts.mHeight = 720;
+	vOpts.mFullScreen = false;
+	if (!vRender.Init() || (vWin = vRender.CreateWin(&vOpts)) == NULL)
+	{
+		cerr << "Unable to create the NULL renderer." << endl;
+		return 1;
+	}
+	vRender.SetRecording(sRecord);
+
+	/* cube sized meshes, half of them indexed */
+	for (int m = 0; m < RENDER_MESHES; m++)
+	{
+		vDesc.mNumVerts = m & 1 ? 24 : 36;
+		vDesc.mNumIndis = m & 1 ? 36 : 0;
+		vMeshes[m] = vRender.CreateMesh(vDesc, &vVerts[0], vDesc.mNumIndis ? &vIndis[0] : NULL);
+	}
+
+	sprintf(vLine, "%-8s %-8s %12s %12s %10s", "items", "method", "us/frame",
+			"ns/item", "draws");
+	cout << vLine << endl;
+
+	for (size_t s = 0; s < sizeof(sSizes) / sizeof(sSizes[0]); s++)
+	{
+		VUINT vCount = sSizes[s];
+		if (vCount > sMax)
+			break;
+		vFrames = sFrames > 0 ? sFrames : (int)(2000000 / vCount);
+
+		for (int m = 0; m < 3; m++)
+		{
+			VItems		vItems;
+			const char	*vName;
+
+			/* the same draws for every method */
+			srand(sSeed);
+			vItems.Setup(vCount, vMeshes);
+			if (m == 0)
+			{
+				vName = "queued";
+				vNs = RunQueued(vRender, vWin, vCamera, vItems, vFrames, &vDraws);
+			}
+			else if (m == 1)
+			{
+				vName = "direct";
+				vNs = RunDirect(vRender, vWin, vCamera, vItems, vFrames, &vDraws);
+			}
+			else
+			{
+				/* items here are vertices refilled each frame */
+				vName = "stream";
+				vNs = RunStream(vRender, vWin, vCamera, vCount, vFrames, &vDraws);
+			}
+
+			sprintf(vLine, "%-8u %-8s %12.3f %12.1f %10u", vCount, vName,
+					vNs / 1e3, vNs / vCount, vDraws);
+			cout << vLine << endl;
+		}
+	}
+
+	vRender.DestroyWin(vWin);
+	return 0;
+}
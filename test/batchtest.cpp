@@ -0,0 +1,139 @@
+#include "engtest2.h"
+#include <viper3d/math/VectorBatch.h>
+#include <viper3d/math/SIMD.h>
+#include <cstdlib>
+
+static unsigned int nCount = 10000;
+static unsigned int nIters = 100;
+
+static bool Close(float f1, float f2)
+{
+	return VMath::Abs(f1 - f2) <= 1e-4f * (1.0f + VMath::Abs(f2));
+}
+
+static bool Close(const VVector& v1, const VVector& v2)
+{
+	return Close(v1.x, v2.x) && Close(v1.y, v2.y) && Close(v1.z, v2.z);
+}
+
+static VVector TransformPoint(const VVector& v, const VMatrix& m)
+{
+	return VVector(v.x*m[0][0] + v.y*m[1][0] + v.z*m[2][0] + m[3][0],
+				v.x*m[0][1] + v.y*m[1][1] + v.z*m[2][1] + m[3][1],
+				v.x*m[0][2] + v.y*m[1][2] + v.z*m[2][2] + m[3][2]);
+}
+
+static unsigned int CheckBatch(VVector *pVecs, VVector *pOut, float *pLengths,
+								const VMatrix& mat)
+{
+	unsigned int vErrors = 0;
+	VVector vTmp;
+
+	VVectorBatch vBatch(pVecs, nCount);
+	VVectorBatch vOther(vBatch);
+	vOther.TransformDirections(mat);
+	vOther.Scale(2.0f);
+	vBatch.Cross(vBatch, vOther);
+	vBatch.ToVectors(pOut);
+	for (unsigned int i = 0; i < nCount; i++)
+	{
+		vTmp = TransformPoint(pVecs[i], mat) - TransformPoint(VVector(), mat);
+		if (!Close(pOut[i], pVecs[i].CrossProduct(vTmp * 2.0f)))
+			vErrors++;
+	}
+
+	vBatch.FromVectors(pVecs, nCount);
+	vBatch.Length(pLengths);
+	for (unsigned int i = 0; i < nCount; i++)
+		if (!Close(pLengths[i], VMath::Sqrt(pVecs[i].SquaredLength())) ||
+			!Close(pLengths[i], VVector(pVecs[i]).Length()))
+			vErrors++;
+
+	vBatch.Normalize();
+	vBatch.ToVectors(pOut);
+	for (unsigned int i = 0; i < nCount; i++)
+	{
+		vTmp = pVecs[i];
+		vTmp.Normalize();
+		if (!Close(pOut[i], vTmp) || !Close(vTmp.Length(), 1.0f))
+			vErrors++;
+	}
+
+	vBatch.FromVectors(pVecs, nCount);
+	vBatch.TransformPoints(mat);
+	vBatch.ToVectors(pOut);
+	for (unsigned int i = 0; i < nCount; i++)
+		if (!Close(pOut[i], TransformPoint(pVecs[i], mat)))
+			vErrors++;
+
+	/* a shorter batch adds to the front and leaves the tail alone */
+	vBatch.FromVectors(pVecs, nCount);
+	vOther.FromVectors(pOut, nCount / 2);
+	vBatch.Add(vOther);
+	if (vBatch.Count() != nCount)
+		vErrors++;
+	vBatch.ToVectors(pOut);
+	for (unsigned int i = 0; i < nCount; i++)
+		if (!Close(pOut[i], i < nCount / 2 ? pVecs[i] + vOther.Get(i) : pVecs[i]))
+			vErrors++;
+
+	/* matrix multiply against the scalar kernel */
+	VMatrix vProd = mat * mat;
+	float vRef[16];
+	VSimd::GetKernels(SIMD_SCALAR)->MatrixMultiply(vRef, mat[0], mat[0]);
+	for (unsigned int i = 0; i < 16; i++)
+		if (!Close(vProd[i / 4][i % 4], vRef[i]))
+			vErrors++;
+
+	return vErrors;
+}
+
+void TestVectorBatch()
+{
+	VUINT64			vStart;
+	VVector			*vVecs = new VVector[nCount];
+	VVector			*vOut = new VVector[nCount];
+	float			*vLengths = new float[nCount];
+	unsigned int	vErrors = 0;
+	VMatrix			vMat;
+	VVectorBatch	vBatch;
+
+	cout << "===========================================" << endl;
+	cout << "= Vector batch testing						" << endl;
+	cout << "= Count: " << nCount << "  Iterations: " << nIters << endl;
+
+	srand(1);
+	for (unsigned int i = 0; i < nCount; i++)
+		vVecs[i].SetValues(rand() / (float)RAND_MAX - 0.5f,
+						rand() / (float)RAND_MAX - 0.5f,
+						rand() / (float)RAND_MAX - 0.5f, 1.0f);
+	vMat.RotaArbi(VVector(1.0f, 2.0f, 3.0f), 0.7f);
+	vMat.Translate(1.0f, -2.0f, 3.0f);
+
+	/* correctness against the VVector operations, for every tier */
+	for (int vTier = SIMD_SCALAR; vTier <= VCPU::GetDetectedTier(); vTier++)
+	{
+		VCPU::SetTier((VSimdTier)vTier);
+		vErrors = CheckBatch(vVecs, vOut, vLengths, vMat);
+		cout << "  " << VCPU::GetTierName((VSimdTier)vTier) << " errors: "
+			<< vErrors << endl;
+	}
+	VCPU::SetTier(VCPU::GetDetectedTier());
+
+	/* timing, one vector at a time versus the batch */
+	vStart = VClock::GetNanos();
+	for (unsigned int n = 0; n < nIters; n++)
+		for (unsigned int i = 0; i < nCount; i++)
+			vOut[i] = TransformPoint(vVecs[i], vMat);
+	cout << "  per VVector:     " << VClock::ElapsedMs(vStart) << "ms" << endl;
+
+	vBatch.FromVectors(vVecs, nCount);
+	vStart = VClock::GetNanos();
+	for (unsigned int n = 0; n < nIters; n++)
+		vBatch.TransformPoints(vMat);
+	cout << "  TransformPoints: " << VClock::ElapsedMs(vStart) << "ms" << endl << endl;
+
+	delete[] vVecs;
+	delete[] vOut;
+	delete[] vLengths;
+}
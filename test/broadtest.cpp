@@ -0,0 +1,162 @@
+#include "engtest2.h"
+#include <viper3d/math/Broadphase.h>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+static unsigned int nCount = 3000;
+static unsigned int nFrames = 30;
+
+/*
+ * A box of the scene; every eighth one sits on a half unit lattice so
+ * plenty of boxes exactly touch.
+ */
+static VAabb RandomBox(unsigned int i, const VVector& vCenter)
+{
+	VVector vE(Rand(0.2f, 1.5f), Rand(0.2f, 1.5f), Rand(0.2f, 1.5f));
+	VVector vMin = vCenter - vE;
+	VVector vMax = vCenter + vE;
+
+	if (i % 8 == 0)
+	{
+		vMin = VVector(floorf(vMin.x * 2.0f), floorf(vMin.y * 2.0f), floorf(vMin.z * 2.0f)) * 0.5f;
+		vMax = VVector(floorf(vMax.x * 2.0f), floorf(vMax.y * 2.0f), floorf(vMax.z * 2.0f)) * 0.5f;
+		vMax = vMax + VVector(0.5f, 0.5f, 0.5f);
+	}
+	return VAabb(vMin, vMax);
+}
+
+static void SortedPairs(const VBroadphase& broad, std::vector<VUINT64>& vPairs)
+{
+	const VBroadPair *vPair = broad.GetPairs();
+
+	vPairs.resize(broad.PairCount());
+	for (VUINT i = 0; i < broad.PairCount(); i++)
+		vPairs[i] = ((VUINT64)vPair[i].mA << 32) | vPair[i].mB;
+	std::sort(vPairs.begin(), vPairs.end());
+}
+
+/*
+ * Every live pair tested with VAabb::Intersects().
+ */
+static void BrutePairs(const VBroadphase& broad, const std::vector<VUINT>& vLive,
+						std::vector<VUINT64>& vPairs)
+{
+	std::vector<VAabb>	vBoxes(vLive.size());
+	VUINT				a, b;
+
+	vPairs.clear();
+	for (VUINT i = 0; i < vLive.size(); i++)
+		vBoxes[i] = broad.GetBox(vLive[i]);
+	for (VUINT i = 0; i < vLive.size(); i++)
+		for (VUINT j = i + 1; j < vLive.size(); j++)
+			if (vBoxes[i].Intersects(vBoxes[j]))
+			{
+				a = vLive[i] < vLive[j] ? vLive[i] : vLive[j];
+				b = vLive[i] < vLive[j] ? vLive[j] : vLive[i];
+				vPairs.push_back(((VUINT64)a << 32) | b);
+			}
+	std::sort(vPairs.begin(), vPairs.end());
+}
+
+static unsigned int Compare(const std::vector<VUINT64>& vGot,
+							const std::vector<VUINT64>& vWant)
+{
+	if (vGot.size() != vWant.size())
+		return 1 + (unsigned int)(vGot.size() > vWant.size() ?
+								vGot.size() - vWant.size() : vWant.size() - vGot.size());
+	return std::equal(vGot.begin(), vGot.end(), vWant.begin()) ? 0 : 1;
+}
+
+void TestBroadphase()
+{
+	VUINT64					vStart;
+	VSweepPrune				vSap;
+	VHashGrid				vGrid(2.0f);
+	VBroadphase				*vBroad[2] = { &vSap, &vGrid };
+	const char				*vNames[2] = { "VSweepPrune", "VHashGrid" };
+	std::vector<VUINT>		vLive;
+	std::vector<VVector>	vCenter, vVel;
+	std::vector<VUINT64>	vGot, vWant;
+	unsigned int			vErrors[2] = { 0, 0 };
+	double					vMs[2] = { 0.0, 0.0 };
+	VUINT					vProxy;
+
+	cout << "===========================================" << endl;
+	cout << "= Broadphase pairs						" << endl;
+	cout << "= Boxes: " << nCount << "  Frames: " << nFrames << endl;
+
+	srand(20);
+	for (unsigned int f = 0; f <= nFrames; f++)
+	{
+		/* a burst of new boxes at the start and in frame 10, a few otherwise */
+		unsigned int vAdds = f == 0 ? nCount : (f == 10 ? 200 : 5);
+		unsigned int vRemoves = f == 0 ? 0 : (f == 20 ? 300 : 5);
+
+		for (unsigned int r = 0; r < vRemoves && !vLive.empty(); r++)
+		{
+			unsigned int k = rand() % vLive.size();
+			for (int b = 0; b < 2; b++)
+				vBroad[b]->RemoveProxy(vLive[k]);
+			vLive[k] = vLive.back();
+			vLive.pop_back();
+		}
+
+		for (unsigned int k = 0; k < vLive.size(); k++)
+		{
+			VVector &c = vCenter[vLive[k]];
+			c = c + vVel[vLive[k]];
+			if (c.x < -30.0f || c.x > 30.0f) vVel[vLive[k]].x = -vVel[vLive[k]].x;
+			if (c.y < -30.0f || c.y > 30.0f) vVel[vLive[k]].y = -vVel[vLive[k]].y;
+			if (c.z < -30.0f || c.z > 30.0f) vVel[vLive[k]].z = -vVel[vLive[k]].z;
+			VAabb vBox = RandomBox(vLive[k], c);
+			for (int b = 0; b < 2; b++)
+				vBroad[b]->MoveProxy(vLive[k], vBox);
+		}
+
+		for (unsigned int n = 0; n < vAdds; n++)
+		{
+			VVector vC(Rand(-30.0f, 30.0f), Rand(-30.0f, 30.0f), Rand(-30.0f, 30.0f));
+			VAabb vBox = RandomBox(vCenter.size() + n, vC);
+
+			vProxy = vBroad[0]->AddProxy(vBox);
+			if (vBroad[1]->AddProxy(vBox) != vProxy)
+				vErrors[1]++;
+			if (vProxy >= vCenter.size())
+			{
+				vCenter.resize(vProxy + 1);
+				vVel.resize(vProxy + 1);
+			}
+			vCenter[vProxy] = vC;
+			vVel[vProxy] = VVector(Rand(-0.3f, 0.3f), Rand(-0.3f, 0.3f), Rand(-0.3f, 0.3f));
+			vLive.push_back(vProxy);
+		}
+
+		for (int b = 0; b < 2; b++)
+		{
+			vStart = VClock::GetNanos();
+			vBroad[b]->Update();
+			vMs[b] += VClock::ElapsedMs(vStart);
+		}
+
+		BrutePairs(vSap, vLive, vWant);
+		for (int b = 0; b < 2; b++)
+		{
+			if (vBroad[b]->ProxyCount() != vLive.size())
+				vErrors[b]++;
+			SortedPairs(*vBroad[b], vGot);
+			vErrors[b] += Compare(vGot, vWant);
+		}
+	}
+
+	for (int b = 0; b < 2; b++)
+		cout << "  " << vNames[b] << " errors: " << vErrors[b] << "  "
+			<< vMs[b] << "ms (" << vBroad[b]->PairCount() << " pairs)" << endl;
+
+	vSap.Clear();
+	vGrid.Clear();
+	vSap.Update();
+	vGrid.Update();
+	cout << "  cleared: " << vSap.PairCount() + vGrid.PairCount() << " pairs"
+		<< endl << endl;
+}
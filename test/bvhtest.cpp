@@ -0,0 +1,254 @@
+#include "engtest2.h"
+#include <viper3d/math/Bvh.h>
+#include <viper3d/SceneBvh.h>
+#include <viper3d/Movable.h>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+static unsigned int nCount = 20000;
+static unsigned int nQueries = 200;
+
+static VAabb RandomBox(float fRange)
+{
+	VVector vC(Rand(-fRange, fRange), Rand(-fRange, fRange), Rand(-fRange, fRange));
+	VVector vE(Rand(0.1f, 2.0f), Rand(0.1f, 2.0f), Rand(0.1f, 2.0f));
+
+	return VAabb(vC - vE, vC + vE);
+}
+
+static VRay RandomRay()
+{
+	VVector vDir(Rand(-1.0f, 1.0f), Rand(-1.0f, 1.0f), Rand(-1.0f, 1.0f));
+	vDir.Normalize();
+	return VRay(VVector(Rand(-150.0f, 150.0f), Rand(-150.0f, 150.0f),
+						Rand(-150.0f, 150.0f)), vDir);
+}
+
+static void BuildFrustum(VPlane *pPlanes, const VVector& vCenter)
+{
+	VVector vNormals[6] = {
+		VVector( 1.0f, 0.3f, 0.0f), VVector(-1.0f, 0.3f, 0.0f),
+		VVector( 0.0f, 1.0f, 0.2f), VVector( 0.2f,-1.0f, 0.0f),
+		VVector( 0.0f, 0.0f, 1.0f), VVector(-0.1f, 0.0f,-1.0f)
+	};
+
+	for (int i = 0; i < 6; i++)
+	{
+		vNormals[i].Normalize();
+		pPlanes[i].Set(vNormals[i], vCenter, -(vNormals[i] * vCenter) - 30.0f);
+	}
+}
+
+/*
+ * Every query against a straight loop over the boxes.
+ */
+static unsigned int CheckBvh(const VBvh& bvh, std::vector<VAabb>& vBoxes)
+{
+	unsigned int		vErrors = 0;
+	std::vector<VUINT>	vGot, vWant;
+	VPlane				vPlanes[6];
+	VUINT				vItem, vBestItem;
+	float				t, fBest, fHit;
+	bool				bHit;
+
+	for (unsigned int q = 0; q < nQueries; q++)
+	{
+		/* frustum */
+		BuildFrustum(vPlanes, VVector(Rand(-80.0f, 80.0f), Rand(-80.0f, 80.0f),
+									Rand(-80.0f, 80.0f)));
+		vGot.clear();
+		vWant.clear();
+		bvh.Cull(vPlanes, 6, vGot);
+		for (VUINT i = 0; i < vBoxes.size(); i++)
+			if (vBoxes[i].Cull(vPlanes, 6) != VCULLED)
+				vWant.push_back(i);
+		std::sort(vGot.begin(), vGot.end());
+		if (vGot != vWant)
+			vErrors++;
+
+		/* overlap */
+		VAabb vQuery = RandomBox(100.0f);
+		vQuery = VAabb(vQuery.GetMin() - VVector(5.0f, 5.0f, 5.0f),
+						vQuery.GetMax() + VVector(5.0f, 5.0f, 5.0f));
+		vGot.clear();
+		vWant.clear();
+		bvh.Overlap(vQuery, vGot);
+		for (VUINT i = 0; i < vBoxes.size(); i++)
+			if (vQuery.Intersects(vBoxes[i]))
+				vWant.push_back(i);
+		std::sort(vGot.begin(), vGot.end());
+		if (vGot != vWant)
+			vErrors++;
+
+		/* ray pick */
+		VRay vRay = RandomRay();
+		bHit = bvh.Pick(vRay, &vItem, &t);
+		fBest = 1e30f;
+		vBestItem = VBVH_INVALID;
+		vWant.clear();
+		for (VUINT i = 0; i < vBoxes.size(); i++)
+		{
+			if (!vRay.Intersects(vBoxes[i], &fHit))
+				continue;
+			vWant.push_back(i);
+			if (fHit < fBest)
+			{
+				fBest = fHit;
+				vBestItem = i;
+			}
+		}
+		if (bHit != (vBestItem != VBVH_INVALID) || (bHit && t != fBest))
+			vErrors++;
+
+		vGot.clear();
+		bvh.Intersects(vRay, vGot);
+		std::sort(vGot.begin(), vGot.end());
+		if (vGot != vWant)
+			vErrors++;
+	}
+	return vErrors;
+}
+
+static unsigned int CheckScene()
+{
+	unsigned int		vErrors = 0;
+	VMovable			*vRoot = new VMovable();
+	std::vector<VMovable*> vMovers;
+	std::vector<VNode*>	vHits;
+	VSceneBvh			vScene;
+	VPlane				vPlanes[6];
+	VMovable			*vMover;
+	float				t;
+
+	/* the root and a grouping level have no size, so no bounds */
+	for (int g = 0; g < 10; g++)
+	{
+		VMovable *vGroup = new VMovable();
+		vRoot->Attach(vGroup);
+		for (int i = 0; i < 100; i++)
+		{
+			vMover = new VMovable();
+			vMover->SetSize(2.0f);
+			vMover->SetPosition(VVector(Rand(-50.0f, 50.0f),
+							Rand(-50.0f, 50.0f), Rand(-50.0f, 50.0f)));
+			vGroup->Attach(vMover);
+			vMovers.push_back(vMover);
+		}
+	}
+	if (vRoot->CountNodes() != 1 + 10 + 1000)
+		vErrors++;
+
+	vScene.Build(vRoot);
+	if (vScene.GetBvh().Count() != vMovers.size())
+		vErrors++;
+
+	/* moving a node refits it in place */
+	vMover = vMovers[123];
+	vMover->SetPosition(VVector(0.0f, 0.0f, 500.0f));
+	if (vScene.Pick(VRay(VVector(0.0f, 0.0f, 1000.0f),
+						VVector(0.0f, 0.0f, -1.0f)), &t) != vMover ||
+		VMath::Abs(t - 499.0f) > 1e-3f)
+		vErrors++;
+
+	BuildFrustum(vPlanes, VVector(0.0f, 0.0f, 500.0f));
+	vScene.Cull(vPlanes, 6, vHits);
+	if (std::find(vHits.begin(), vHits.end(), vMover) == vHits.end())
+		vErrors++;
+
+	/* deleted nodes drop out of queries */
+	delete vMover;
+	vMovers[123] = NULL;
+	if (vScene.Pick(VRay(VVector(0.0f, 0.0f, 1000.0f),
+						VVector(0.0f, 0.0f, -1.0f))) == vMover)
+		vErrors++;
+
+	/* scatter everything; the refitted tree degrades and is rebuilt */
+	for (VUINT i = 0; i < vMovers.size(); i++)
+		if (vMovers[i])
+			vMovers[i]->SetPosition(VVector(Rand(-50.0f, 50.0f),
+							Rand(-50.0f, 50.0f), Rand(-50.0f, 50.0f)));
+	if (!vScene.Update())
+		vErrors++;
+
+	vHits.clear();
+	vScene.Overlap(VAabb(VVector(-60.0f, -60.0f, -60.0f),
+						VVector(60.0f, 60.0f, 60.0f)), vHits);
+	if (vHits.size() != vMovers.size() - 1)
+		vErrors++;
+
+	delete vRoot;
+	return vErrors;
+}
+
+void TestBvh()
+{
+	VUINT64				vStart;
+	std::vector<VAabb>	vBoxes(nCount);
+	std::vector<VUINT>	vItems;
+	unsigned int		vErrors = 0;
+	VPlane				vPlanes[6];
+	VBvh				vBvh;
+
+	cout << "===========================================" << endl;
+	cout << "= Bounding volume hierarchy				" << endl;
+	cout << "= Count: " << nCount << "  Queries: " << nQueries << endl;
+
+	srand(4);
+	for (unsigned int i = 0; i < nCount; i++)
+		vBoxes[i] = RandomBox(100.0f);
+
+	vStart = VClock::GetNanos();
+	vBvh.Build(&vBoxes[0], nCount);
+	cout << "  build:   " << VClock::ElapsedMs(vStart) << "ms, " << vBvh.NodeCount()
+		<< " nodes, cost " << vBvh.Cost() << endl;
+	vErrors += CheckBvh(vBvh, vBoxes);
+	cout << "  built errors:    " << vErrors << endl;
+
+	/* small moves refit incrementally and stay close to built quality */
+	for (unsigned int i = 0; i < nCount; i += 7)
+	{
+		VVector vD(Rand(-1.0f, 1.0f), Rand(-1.0f, 1.0f), Rand(-1.0f, 1.0f));
+		vBoxes[i] = VAabb(vBoxes[i].GetMin() + vD, vBoxes[i].GetMax() + vD);
+		vBvh.Update(i, vBoxes[i]);
+	}
+	vErrors = CheckBvh(vBvh, vBoxes);
+	cout << "  refit errors:    " << vErrors << "  cost " << vBvh.Cost()
+		<< (vBvh.IsDegraded() ? " (degraded)" : "") << endl;
+
+	/* scattering degrades it until rebuilt */
+	for (unsigned int i = 0; i < nCount; i++)
+	{
+		vBoxes[i] = RandomBox(100.0f);
+		vBvh.Update(i, vBoxes[i]);
+	}
+	vErrors = CheckBvh(vBvh, vBoxes);
+	if (!vBvh.IsDegraded())
+		vErrors++;
+	vBvh.Rebuild();
+	vErrors += CheckBvh(vBvh, vBoxes);
+	cout << "  rebuilt errors:  " << vErrors << "  cost " << vBvh.Cost() << endl;
+
+	vErrors = CheckScene();
+	cout << "  scene errors:    " << vErrors << endl;
+
+	/* timing, brute force versus the hierarchy */
+	BuildFrustum(vPlanes, VVector());
+	vStart = VClock::GetNanos();
+	for (unsigned int q = 0; q < nQueries; q++)
+	{
+		vItems.clear();
+		for (VUINT i = 0; i < nCount; i++)
+			if (vBoxes[i].Cull(vPlanes, 6) != VCULLED)
+				vItems.push_back(i);
+	}
+	cout << "  cull per VAabb: " << VClock::ElapsedMs(vStart) << "ms" << endl;
+
+	vStart = VClock::GetNanos();
+	for (unsigned int q = 0; q < nQueries; q++)
+	{
+		vItems.clear();
+		vBvh.Cull(vPlanes, 6, vItems);
+	}
+	cout << "  cull VBvh:      " << VClock::ElapsedMs(vStart) << "ms" << endl << endl;
+}
@@ -0,0 +1,410 @@
+#include "engtest2.h"
+#include <viper3d/math/AabbBatch.h>
+#include <viper3d/Camera.h>
+#include <cstdlib>
+
+static unsigned int nCount = 50000;
+static unsigned int nIters = 20;
+
+/*
+ * Six planes of a box-shaped frustum, normals pointing out.
+ */
+static void BuildFrustum(VPlane *pPlanes)
+{
+	VVector vNormals[6] = {
+		VVector( 1.0f, 0.2f, 0.0f), VVector(-1.0f, 0.2f, 0.0f),
+		VVector( 0.0f, 1.0f, 0.3f), VVector( 0.1f,-1.0f, 0.0f),
+		VVector( 0.0f, 0.0f, 1.0f), VVector(-0.2f, 0.0f,-1.0f)
+	};
+
+	for (int i = 0; i < 6; i++)
+	{
+		vNormals[i].Normalize();
+		pPlanes[i].Set(vNormals[i], VVector(), -40.0f);
+	}
+}
+
+static unsigned int CheckCull(VAabb *pBoxes, const VAabbBatch& batch,
+								const VPlane *pPlanes, int nNumPlanes,
+								VBYTE *pResults, VUINT *pIndices)
+{
+	unsigned int vErrors = 0;
+	VUINT vNum, vExpected = 0;
+
+	batch.Classify(pPlanes, nNumPlanes, pResults);
+	for (unsigned int i = 0; i < nCount; i++)
+	{
+		if (pResults[i] != pBoxes[i].Cull(pPlanes, nNumPlanes))
+			vErrors++;
+		if (pResults[i] != VCULLED)
+			vExpected++;
+	}
+
+	vNum = batch.Cull(pPlanes, nNumPlanes, pIndices);
+	if (vNum != vExpected)
+		vErrors++;
+	for (VUINT i = 0; i < vNum; i++)
+		if (pResults[pIndices[i]] == VCULLED ||
+			(i > 0 && pIndices[i] <= pIndices[i - 1]))
+			vErrors++;
+
+	return vErrors;
+}
+
+void TestCulling()
+{
+	VUINT64			vStart;
+	VAabb			*vBoxes = new VAabb[nCount];
+	VBYTE			*vResults = new VBYTE[nCount];
+	VUINT			*vIndices = new VUINT[nCount];
+	VPlane			vPlanes[6];
+	VPlane			vMany[VSIMD_MAX_PLANES + 8];
+	VVector			vCenter, vExtent;
+	unsigned int	vErrors = 0;
+	VUINT			vNum = 0;
+
+	cout << "===========================================" << endl;
+	cout << "= AABB frustum culling						" << endl;
+	cout << "= Count: " << nCount << "  Iterations: " << nIters << endl;
+
+	srand(2);
+	for (unsigned int i = 0; i < nCount; i++)
+	{
+		vCenter.SetValues(Rand(-100.0f, 100.0f), Rand(-100.0f, 100.0f),
+						Rand(-100.0f, 100.0f), 1.0f);
+		vExtent.SetValues(Rand(0.0f, 5.0f), Rand(0.0f, 5.0f),
+						Rand(0.0f, 5.0f), 0.0f);
+		vBoxes[i] = VAabb(vCenter - vExtent, vCenter + vExtent);
+	}
+	BuildFrustum(vPlanes);
+
+	VAabbBatch vBatch(vBoxes, nCount);
+
+	/* correctness against VAabb::Cull, for every tier */
+	for (int vTier = SIMD_SCALAR; vTier <= VCPU::GetDetectedTier(); vTier++)
+	{
+		VCPU::SetTier((VSimdTier)vTier);
+		vErrors = CheckCull(vBoxes, vBatch, vPlanes, 6, vResults, vIndices);
+		cout << "  " << VCPU::GetTierName((VSimdTier)vTier) << " errors: "
+			<< vErrors << endl;
+	}
+	VCPU::SetTier(VCPU::GetDetectedTier());
+
+	/* more planes than one kernel pass takes; the last ones still count */
+	for (int i = 0; i < VSIMD_MAX_PLANES + 8; i++)
+	{
+		VVector vN(Rand(-1.0f, 1.0f), Rand(-1.0f, 1.0f), Rand(-1.0f, 1.0f));
+
+		vN.Normalize();
+		vMany[i].Set(vN, VVector(), i < VSIMD_MAX_PLANES ? -95.0f : -30.0f);
+	}
+	vErrors = CheckCull(vBoxes, vBatch, vMany, VSIMD_MAX_PLANES + 8, vResults, vIndices);
+	cout << "  " << VSIMD_MAX_PLANES + 8 << " plane errors: " << vErrors << endl;
+
+	/* timing, one box at a time versus the batch */
+	vStart = VClock::GetNanos();
+	for (unsigned int n = 0; n < nIters; n++)
+	{
+		vNum = 0;
+		for (unsigned int i = 0; i < nCount; i++)
+			if (vBoxes[i].Cull(vPlanes, 6) != VCULLED)
+				vIndices[vNum++] = i;
+	}
+	cout << "  per VAabb:  " << VClock::ElapsedMs(vStart) << "ms (" << vNum
+		<< " visible)" << endl;
+
+	vStart = VClock::GetNanos();
+	for (unsigned int n = 0; n < nIters; n++)
+		vNum = vBatch.Cull(vPlanes, 6, vIndices);
+	cout << "  VAabbBatch: " << VClock::ElapsedMs(vStart) << "ms (" << vNum
+		<< " visible)" << endl << endl;
+
+	delete[] vBoxes;
+	delete[] vResults;
+	delete[] vIndices;
+}
+
+/*
+ * Where a ray enters and leaves a box, in double precision with a
+ * division per slab.  bEdge is set when the answer is too close to call
+ * in floats.
+ */
+static void SlabReference(const VRay& ray, const VAabb& box, double *pNear,
+							double *pFar, bool *pEdge)
+{
+	const float *vO = &ray.GetOrigin().x;
+	const float *vD = &ray.GetDirection().x;
+	const float *vMin = &box.GetMin().x;
+	const float *vMax = &box.GetMax().x;
+	double t0, t1, tmp;
+
+	*pNear = -1e300;
+	*pFar = 1e300;
+	*pEdge = false;
+	for (int a = 0; a < 3; a++)
+	{
+		if (vD[a] == 0.0f)
+		{
+			if (vO[a] < vMin[a] || vO[a] > vMax[a])
+				*pNear = 1e300;
+			continue;
+		}
+		t0 = (vMin[a] - (double)vO[a]) / vD[a];
+		t1 = (vMax[a] - (double)vO[a]) / vD[a];
+		if (t0 > t1)
+		{
+			tmp = t0;
+			t0 = t1;
+			t1 = tmp;
+		}
+		if (t0 > *pNear) *pNear = t0;
+		if (t1 < *pFar) *pFar = t1;
+	}
+	if (VMath::Abs((float)(*pNear - *pFar)) < 1e-3f ||
+		VMath::Abs((float)*pNear) < 1e-3f || VMath::Abs((float)*pFar) < 1e-3f)
+		*pEdge = true;
+}
+
+static unsigned int CheckRayBoxes(VAabb *pBoxes, const VAabbBatch& batch,
+									const VRay& ray, float fL, VUINT *pHits,
+									float *pEnter, VUINT *pIndices, float *pT)
+{
+	VSlabRay		vRay(ray);
+	unsigned int	vErrors = 0;
+	VUINT			vNum, vExpected = 0;
+	double			fNear, fFar;
+	float			fEnter, t;
+	bool			bEdge, bWant, bHit;
+
+	batch.RayMask(vRay, fL, pHits, pEnter);
+	for (unsigned int i = 0; i < nCount; i++)
+	{
+		/* the batch agrees exactly with one box at a time */
+		bHit = vRay.Enters(pBoxes[i], fL, &fEnter);
+		if (((pHits[i >> 5] >> (i & 31)) & 1) != (VUINT)bHit ||
+			(bHit && pEnter[i] != fEnter))
+			vErrors++;
+		if (bHit)
+			vExpected++;
+
+		SlabReference(ray, pBoxes[i], &fNear, &fFar, &bEdge);
+		if (bEdge || VMath::Abs((float)(fNear - fL)) < 1e-3f)
+			continue;
+
+		/* and with the reference, entering in [0, fL] */
+		bWant = fNear <= fFar && fFar >= 0.0 && fNear <= fL;
+		if (bHit != bWant)
+			vErrors++;
+		else if (bHit && VMath::Abs(fEnter - (float)(fNear > 0.0 ? fNear : 0.0)) > 1e-3f)
+			vErrors++;
+
+		/* entry point, or exit point from inside, as VRay reports it */
+		bWant = fNear <= fFar && fFar >= 0.0;
+		if (ray.GetDirection().x != 0.0f || ray.GetDirection().y != 0.0f ||
+			ray.GetDirection().z != 0.0f)
+		{
+			if (vRay.Intersects(pBoxes[i], &t) != bWant)
+				vErrors++;
+			else if (bWant && VMath::Abs(t - (float)(fNear > 0.0 ? fNear : fFar)) > 1e-2f)
+				vErrors++;
+		}
+	}
+
+	vNum = batch.Intersects(vRay, fL, pIndices, pT);
+	if (vNum != vExpected)
+		vErrors++;
+	for (VUINT i = 0; i < vNum; i++)
+		if (((pHits[pIndices[i] >> 5] >> (pIndices[i] & 31)) & 1) == 0 ||
+			pT[i] != pEnter[pIndices[i]] ||
+			(i > 0 && pIndices[i] <= pIndices[i - 1]))
+			vErrors++;
+
+	return vErrors;
+}
+
+void TestRayBoxes()
+{
+	VUINT64			vStart;
+	const unsigned int vNumRays = 40;
+	VAabb			*vBoxes = new VAabb[nCount];
+	VUINT			*vHits = new VUINT[VAabbBatch::MaskWords(nCount)];
+	VUINT			*vIndices = new VUINT[nCount];
+	float			*vEnter = new float[nCount];
+	float			*vT = new float[nCount];
+	VRay			vRays[vNumRays];
+	VVector			vCenter, vExtent, vDir;
+	unsigned int	vErrors = 0;
+	VUINT			vNum = 0;
+	float			t;
+
+	cout << "===========================================" << endl;
+	cout << "= Ray against AABB batch					" << endl;
+	cout << "= Count: " << nCount << "  Iterations: " << nIters << endl;
+
+	srand(7);
+	for (unsigned int i = 0; i < nCount; i++)
+	{
+		vCenter.SetValues(Rand(-100.0f, 100.0f), Rand(-100.0f, 100.0f),
+						Rand(-100.0f, 100.0f), 1.0f);
+		vExtent.SetValues(Rand(0.0f, 5.0f), Rand(0.0f, 5.0f),
+						Rand(0.0f, 5.0f), 0.0f);
+		vBoxes[i] = VAabb(vCenter - vExtent, vCenter + vExtent);
+	}
+
+	/* random rays, some of them along an axis or in an axis plane */
+	for (unsigned int r = 0; r < vNumRays; r++)
+	{
+		vDir.SetValues(Rand(-1.0f, 1.0f), Rand(-1.0f, 1.0f), Rand(-1.0f, 1.0f), 0.0f);
+		if (r % 4 == 1)
+			vDir.x = 0.0f;
+		if (r % 8 == 3)
+			vDir.y = vDir.z = 0.0f;
+		if (r == 5)
+			vDir.x = -0.0f;
+		vDir.Normalize();
+		vRays[r] = VRay(VVector(Rand(-120.0f, 120.0f), Rand(-120.0f, 120.0f),
+								Rand(-120.0f, 120.0f)), vDir);
+	}
+
+	VAabbBatch vBatch(vBoxes, nCount);
+
+	for (int vTier = SIMD_SCALAR; vTier <= VCPU::GetDetectedTier(); vTier++)
+	{
+		VCPU::SetTier((VSimdTier)vTier);
+		vErrors = 0;
+		for (unsigned int r = 0; r < vNumRays; r++)
+			vErrors += CheckRayBoxes(vBoxes, vBatch, vRays[r], (r & 1) ? 80.0f : 1e30f,
+									vHits, vEnter, vIndices, vT);
+		cout << "  " << VCPU::GetTierName((VSimdTier)vTier) << " errors: "
+			<< vErrors << endl;
+	}
+	VCPU::SetTier(VCPU::GetDetectedTier());
+
+	/* timing, one ray against every box */
+	vStart = VClock::GetNanos();
+	for (unsigned int n = 0; n < nIters; n++)
+	{
+		vNum = 0;
+		for (unsigned int i = 0; i < nCount; i++)
+			if (vRays[n].Intersects(vBoxes[i], &t))
+				vIndices[vNum++] = i;
+	}
+	cout << "  per VRay:     " << VClock::ElapsedMs(vStart) << "ms" << endl;
+
+	vStart = VClock::GetNanos();
+	for (unsigned int n = 0; n < nIters; n++)
+	{
+		VSlabRay vRay(vRays[n]);
+		vNum = 0;
+		for (unsigned int i = 0; i < nCount; i++)
+			if (vRay.Intersects(vBoxes[i], &t))
+				vIndices[vNum++] = i;
+	}
+	cout << "  per VSlabRay: " << VClock::ElapsedMs(vStart) << "ms" << endl;
+
+	vStart = VClock::GetNanos();
+	for (unsigned int n = 0; n < nIters; n++)
+		vNum = vBatch.Intersects(VSlabRay(vRays[n]), 1e30f, vIndices, vT);
+	cout << "  VAabbBatch:   " << VClock::ElapsedMs(vStart) << "ms (" << vNum
+		<< " hit)" << endl << endl;
+
+	delete[] vBoxes;
+	delete[] vHits;
+	delete[] vIndices;
+	delete[] vEnter;
+	delete[] vT;
+}
+
+/*
+ * A point is inside the planes exactly when it is inside clip space.
+ * Points too close to a plane to call either way are skipped.
+ */
+static unsigned int CheckFrustum(VCamera& camera)
+{
+	unsigned int vErrors = 0;
+	const VPlane *vPlanes = camera.GetFrustumPlanes();
+	const VMatrix& vM = camera.GetViewProjection();
+	float vClip[4], fDist;
+	bool bPlanes, bClip, bEdge;
+	VVector vP;
+
+	for (int i = 0; i < VFRUSTUM_PLANES; i++)
+		if (VMath::Abs(vPlanes[i].m_vN * vPlanes[i].m_vN - 1.0f) > 1e-4f)
+			vErrors++;
+
+	for (unsigned int n = 0; n < 10000; n++)
+	{
+		vP.SetValues(Rand(-60.0f, 60.0f), Rand(-60.0f, 60.0f),
+					Rand(-120.0f, 20.0f), 1.0f);
+
+		bPlanes = true;
+		bEdge = false;
+		for (int i = 0; i < VFRUSTUM_PLANES; i++)
+		{
+			fDist = vPlanes[i].m_vN * vP + vPlanes[i].m_fD;
+			if (fDist > 0.0f)
+				bPlanes = false;
+			if (VMath::Abs(fDist) < 1e-2f)
+				bEdge = true;
+		}
+		if (bEdge)
+			continue;
+
+		for (int r = 0; r < 4; r++)
+			vClip[r] = vM[r][0]*vP.x + vM[r][1]*vP.y + vM[r][2]*vP.z + vM[r][3];
+		bClip = vClip[3] > 0.0f &&
+			VMath::Abs(vClip[0]) <= vClip[3] &&
+			VMath::Abs(vClip[1]) <= vClip[3] &&
+			VMath::Abs(vClip[2]) <= vClip[3];
+
+		if (bPlanes != bClip)
+			vErrors++;
+	}
+	return vErrors;
+}
+
+void TestFrustum()
+{
+	VCamera			vCamera;
+	unsigned int	vErrors = 0;
+	VAabb			vBox;
+	VMatrix			vOld;
+	const VPlane	*vPlanes;
+
+	cout << "===========================================" << endl;
+	cout << "= Camera frustum planes					" << endl;
+
+	srand(3);
+	vCamera.mFar = 100.0f;
+	vCamera.SetPosition(VVector(0.0f, 0.0f, 10.0f, 1.0f));
+	vErrors += CheckFrustum(vCamera);
+
+	/* straight ahead, behind, and beyond the far plane */
+	vPlanes = vCamera.GetFrustumPlanes();
+	vBox = VAabb(VVector(-1.0f, -1.0f, -1.0f), VVector(1.0f, 1.0f, 1.0f));
+	if (vBox.Cull(vPlanes, VFRUSTUM_PLANES) != VVISIBLE)
+		vErrors++;
+	vBox = VAabb(VVector(-1.0f, -1.0f, 11.0f), VVector(1.0f, 1.0f, 12.0f));
+	if (vBox.Cull(vPlanes, VFRUSTUM_PLANES) != VCULLED)
+		vErrors++;
+	vBox = VAabb(VVector(-1.0f, -1.0f, -95.0f), VVector(1.0f, 1.0f, -85.0f));
+	if (vBox.Cull(vPlanes, VFRUSTUM_PLANES) != VCLIPPED)
+		vErrors++;
+
+	/* moving, rotating or zooming the camera invalidates the cache */
+	vOld = vCamera.GetViewProjection();
+	vCamera.SetPosition(VVector(5.0f, -3.0f, 20.0f, 1.0f));
+	vCamera.RotateYaw(25.0f);
+	vCamera.RotatePitch(-10.0f);
+	if (vCamera.GetViewProjection()[3][3] == vOld[3][3])
+		vErrors++;
+	vErrors += CheckFrustum(vCamera);
+
+	vOld = vCamera.GetViewProjection();
+	vCamera.SetFOV(60.0f);
+	if (vCamera.GetViewProjection()[0][0] == vOld[0][0])
+		vErrors++;
+	vErrors += CheckFrustum(vCamera);
+
+	cout << "  errors: " << vErrors << endl << endl;
+}
@@ -1,4 +1,5 @@
 #include <cstdio>
+#include <cstring>
 #include <unistd.h>
 #include "engtest2.h"
 #include <viper3d/util/Log.h>
@@ -18,17 +19,48 @@ using std::endl;
 int main(int argc, char *argv[])
 {
 	Viper3D	vEngine;
+	bool	vMeshes = false;
+	bool	vNull = false;
+	bool	vOffscreen = false;
+
+	/* the NULL renderer and offscreen windows have no input to drive the interactive loop */
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--meshes") == 0)
+			vMeshes = true;
+		else if (strcmp(argv[i], "--null") == 0)
+			vMeshes = vNull = true;
+		else if (strcmp(argv[i], "--offscreen") == 0)
+			vMeshes = vOffscreen = true;
+	}
 	VLog::SetName("Viper3D.log");
 	VLog::SetFlush();
 	VCPU::Init();
 
-	//VCPU::mOSSSE = false;
+	//VCPU::SetTier(SIMD_SCALAR);
 	/*
 	TestVectors();
 	TestMatrices();
+	TestMatrixKernels();
+	TestMathApprox();
+	TestVectorBatch();
+	TestQuaternionBatch();
+	TestCulling();
+	TestRayBoxes();
+	TestFrustum();
+	TestObbBatch();
+	TestBvh();
+	TestBroadphase();
+	TestTriangleBvh();
+	TestPolygonClip();
+	TestRenderQueue();
+	TestNullRender();
+	TestSceneGraph();
+	TestJobs();
+	TestProfiler();
 	*/
 
-	VRenderSystem* vRenderer = vEngine.CreateRenderer("GL");
+	VRenderSystem* vRenderer = vEngine.CreateRenderer(vNull ? "NULL" : "GL");
 
 	if (vRenderer == NULL)
 	{
@@ -47,16 +79,25 @@ int main(int argc, char *argv[])
 	pOpts.mWidth = 800;
 	pOpts.mHeight = 600;
 	pOpts.mFullScreen = false;
+	pOpts.mOffscreen = vOffscreen;
 	VWindow *vWin = vRenderer->CreateWin(&pOpts);
-	vWin->SetCaption("OpenGL test");
 	float vRotScale = 0.5f;
 	float vMoveScale = 5.0f;
 	if (vWin == NULL)
 	{
 		cout << "Unable to create window." << endl;
 	}
+	else if (vMeshes)
+	{
+		VCamera vCamera;
+		vCamera.SetPosition(VVector(0, 0, 0, 1));
+		vCamera.SetDirection(-VVector::VECTOR_UNIT_Z);
+		TestMeshes(vRenderer, vWin, &vCamera);
+		vRenderer->DestroyWin(vWin);
+	}
 	else
 	{
+		vWin->SetCaption("OpenGL test");
 		VCamera vCamera;
 		vCamera.SetPosition(VVector(0, 0, 0, 1));
 		vCamera.SetDirection(-VVector::VECTOR_UNIT_Z);
@@ -1,5 +1,7 @@
 #include <viper3d/Math.h>
 #include <viper3d/util/CPU.h>
+#include <viper3d/util/Clock.h>
+#include <cstdlib>
 #include <iostream>
 #include <sys/timeb.h>
 
@@ -9,9 +11,72 @@ using std::endl;
 
 using namespace UDP;
 
+/*
+ * Uniform random number between fMin and fMax.
+ */
+inline float Rand(float fMin, float fMax)
+{
+	return fMin + (fMax - fMin) * (rand() / (float)RAND_MAX);
+}
+
+namespace UDP
+{
+class VRenderSystem;
+class VWindow;
+class VCamera;
+}
+
 
 /* vectest.cpp */
 void TestVectors();
 
+/* mathtest.cpp */
+void TestMathApprox();
+
 /* matrixtext.cpp */
 void TestMatrices();
+void TestMatrixKernels();
+
+/* batchtest.cpp */
+void TestVectorBatch();
+
+/* broadtest.cpp */
+void TestBroadphase();
+
+/* bvhtest.cpp */
+void TestBvh();
+
+/* culltest.cpp */
+void TestCulling();
+void TestRayBoxes();
+void TestFrustum();
+
+/* nulltest.cpp */
+void TestNullRender();
+
+/* obbtest.cpp */
+void TestObbBatch();
+
+/* jobtest.cpp */
+void TestJobs();
+
+/* queuetest.cpp */
+void TestRenderQueue();
+
+/* quattest.cpp */
+void TestQuaternionBatch();
+
+/* polytest.cpp */
+void TestPolygonClip();
+
+/* proftest.cpp */
+void TestProfiler();
+
+/* rendertest.cpp */
+void TestMeshes(VRenderSystem *pRender, VWindow *pWin, VCamera *pCamera);
+
+/* scenetest.cpp */
+void TestSceneGraph();
+
+/* tritest.cpp */
+void TestTriangleBvh();
@@ -0,0 +1,221 @@
+#include "engtest2.h"
+#include <viper3d/util/JobSystem.h>
+#include <viper3d/math/AabbBatch.h>
+#include <viper3d/Movable.h>
+#include <cstdlib>
+#include <vector>
+
+static unsigned int nBoxes = 500000;
+static unsigned int nNodes = 50000;
+static unsigned int nIters = 20;
+
+/*
+ * Leaf of the dependency test: marks its slot.
+ */
+static void MarkJob(VJob *pJob)
+{
+	((int*)pJob->mData)[pJob->mFirst] += 1;
+}
+
+/*
+ * Root of the dependency test: spawns one child per slot.
+ */
+static void SpawnJob(VJob *pJob)
+{
+	for (VUINT i = 0; i < pJob->mCount; i++)
+		pJob->mSystem->Run(pJob->mSystem->Create(MarkJob, pJob->mData, i, 1, pJob));
+}
+
+/*
+ * ParallelFor body: writes each index's square.
+ */
+static void SquareJob(VJob *pJob)
+{
+	VUINT *vOut = (VUINT*)pJob->mData;
+
+	for (VUINT i = pJob->mFirst; i < pJob->mFirst + pJob->mCount; i++)
+		vOut[i] += i * i;
+}
+
+static bool Close(const VAffine& m1, const VAffine& m2)
+{
+	for (int r = 0; r < 3; r++)
+		for (int c = 0; c < 4; c++)
+			if (VMath::Abs(m1[r][c] - m2[r][c]) > 1e-3f * (1.0f + VMath::Abs(m2[r][c])))
+				return false;
+	return true;
+}
+
+static VAffine WorldOf(VNode *pNode)
+{
+	VAffine vLocal;
+
+	pNode->GetLocalTransform(vLocal);
+	if (pNode->GetParent() == NULL)
+		return vLocal;
+	return WorldOf(pNode->GetParent()) * vLocal;
+}
+
+void TestJobs()
+{
+	VUINT64					vStart;
+	VJobSystem				vJobs;
+	unsigned int			vErrors = 0;
+	std::vector<int>		vSlots(1000, 0);
+	std::vector<VUINT>		vSquares(100003, 0);
+	std::vector<VUINT>		vSerial(nBoxes), vParallel(nBoxes);
+	std::vector<VUINT>		vMask1(VAabbBatch::MaskWords(nBoxes)), vMask2(vMask1.size());
+	std::vector<VUINT>		vClip1(vMask1.size()), vClip2(vMask1.size());
+	std::vector<VMovable*>	vNodes;
+	VAabb					*vBoxes = new VAabb[nBoxes];
+	VVector					vCenter, vExtent;
+	VPlane					vPlanes[6];
+	VMovable				*vMover;
+	VUINT					vNum1, vNum2;
+	int						vMaxThreads = VJobSystem::GetNumCores();
+
+	cout << "===========================================" << endl;
+	cout << "= Job system								" << endl;
+	cout << "= Boxes: " << nBoxes << "  Nodes: " << nNodes << "  Iterations: "
+		<< nIters << "  Cores: " << vMaxThreads << endl;
+
+	/* more threads than cores still has to give the right answers */
+	if (!vJobs.Init(vMaxThreads < 4 ? 4 : vMaxThreads))
+		vErrors++;
+
+	/* a parent is not done until all its children are */
+	VJob *vRoot = vJobs.Create(SpawnJob, &vSlots[0], 0, (VUINT)vSlots.size());
+	vJobs.Run(vRoot);
+	vJobs.Wait(vRoot);
+	for (VUINT i = 0; i < vSlots.size(); i++)
+		if (vSlots[i] != 1)
+			vErrors++;
+
+	/* every index visited exactly once */
+	vJobs.ParallelFor(SquareJob, &vSquares[0], (VUINT)vSquares.size(), 1000);
+	for (VUINT i = 0; i < vSquares.size(); i++)
+		if (vSquares[i] != i * i)
+			vErrors++;
+
+	/* more pieces than a thread has jobs, on several threads and on one */
+	for (int t = 0; t < 2; t++)
+	{
+		std::vector<int> vPieces(3 * VJOB_POOL_SIZE + 7, 0);
+
+		if (t == 1)
+			vJobs.Init(1);
+		vJobs.ParallelFor(MarkJob, &vPieces[0], (VUINT)vPieces.size(), 1);
+		for (VUINT i = 0; i < vPieces.size(); i++)
+			if (vPieces[i] != 1)
+				vErrors++;
+	}
+
+	/* a full pool hands out nothing until its jobs have finished */
+	std::vector<VJob*> vHeld(VJOB_POOL_SIZE);
+	for (VUINT i = 0; i < vHeld.size(); i++)
+		if ((vHeld[i] = vJobs.Create(MarkJob, &vSlots[0], i % vSlots.size(), 1)) == NULL)
+			vErrors++;
+	if (vJobs.Create(MarkJob, &vSlots[0]) != NULL)
+		vErrors++;
+	for (VUINT i = 0; i < vHeld.size() && vHeld[i] != NULL; i++)
+	{
+		vJobs.Run(vHeld[i]);
+		vJobs.Wait(vHeld[i]);
+	}
+	if (vJobs.Create(MarkJob, &vSlots[0]) == NULL)
+		vErrors++;
+	vJobs.Init(vMaxThreads < 4 ? 4 : vMaxThreads);
+	cout << "  job errors:       " << vErrors << endl;
+
+	/* parallel culling matches serial culling exactly */
+	srand(7);
+	for (unsigned int i = 0; i < nBoxes; i++)
+	{
+		vCenter.SetValues(Rand(-100.0f, 100.0f), Rand(-100.0f, 100.0f),
+						Rand(-100.0f, 100.0f), 1.0f);
+		vExtent.SetValues(Rand(0.0f, 5.0f), Rand(0.0f, 5.0f),
+						Rand(0.0f, 5.0f), 0.0f);
+		vBoxes[i] = VAabb(vCenter - vExtent, vCenter + vExtent);
+	}
+	for (int i = 0; i < 6; i++)
+	{
+		VVector vN(i == 0 ? 1.0f : (i == 1 ? -1.0f : 0.1f),
+				   i == 2 ? 1.0f : (i == 3 ? -1.0f : 0.0f),
+				   i == 4 ? 1.0f : (i == 5 ? -1.0f : 0.2f));
+		vN.Normalize();
+		vPlanes[i].Set(vN, VVector(), -40.0f);
+	}
+	VAabbBatch vBatch(vBoxes, nBoxes);
+
+	vErrors = 0;
+	vNum1 = vBatch.Cull(vPlanes, 6, &vSerial[0]);
+	vNum2 = vBatch.Cull(vPlanes, 6, &vParallel[0], vJobs);
+	if (vNum1 != vNum2)
+		vErrors++;
+	for (VUINT i = 0; i < vNum1 && i < vNum2; i++)
+		if (vSerial[i] != vParallel[i])
+			vErrors++;
+	vBatch.CullMask(vPlanes, 6, &vMask1[0], &vClip1[0]);
+	vBatch.CullMask(vPlanes, 6, &vMask2[0], &vClip2[0], vJobs);
+	for (VUINT i = 0; i < vMask1.size(); i++)
+		if (vMask1[i] != vMask2[i] || vClip1[i] != vClip2[i])
+			vErrors++;
+	cout << "  cull errors:      " << vErrors << " (" << vNum1 << " visible)" << endl;
+
+	/* parallel transforms match the recursive reference */
+	vNodes.push_back(new VMovable());
+	for (unsigned int i = 1; i < nNodes; i++)
+	{
+		vMover = new VMovable();
+		vMover->SetPosition(VVector(Rand(-1.0f, 1.0f), Rand(-1.0f, 1.0f),
+									Rand(-1.0f, 1.0f)));
+		vMover->RotateYaw(Rand(-30.0f, 30.0f));
+		/* shallow, bushy tree; keeps the recursive reference cheap */
+		vNodes[rand() % (1 + vNodes.size() / 8)]->Attach(vMover);
+		vNodes.push_back(vMover);
+	}
+
+	vErrors = 0;
+	vNodes[0]->UpdateTransforms(vJobs);
+	for (unsigned int i = 0; i < 200; i++)
+		vNodes[1 + rand() % (nNodes - 1)]->RotatePitch(Rand(-30.0f, 30.0f));
+	vNodes[0]->UpdateTransforms(vJobs);
+	const VNodeList *vList = vNodes[0]->GetNodeList();
+	if (vList->mNumMoved != 0)
+		vErrors++;
+	for (unsigned int i = 0; i < nNodes; i += 7)
+		if (!Close(vList->mWorld[i], WorldOf(vList->mNodes[i])))
+			vErrors++;
+	cout << "  transform errors: " << vErrors << endl;
+
+	/* scaling, 1 to N threads */
+	cout << "  threads    cull    transforms" << endl;
+	for (int vThreads = 1; vThreads <= vMaxThreads; )
+	{
+		vJobs.Init(vThreads);
+
+		vStart = VClock::GetNanos();
+		for (unsigned int n = 0; n < nIters; n++)
+			vNum2 = vBatch.Cull(vPlanes, 6, &vParallel[0], vJobs);
+		cout << "  " << vThreads << "\t\t" << VClock::ElapsedMs(vStart) << "ms";
+
+		vStart = VClock::GetNanos();
+		for (unsigned int n = 0; n < nIters; n++)
+		{
+			vNodes[0]->RotateYaw(1.0f);
+			vNodes[0]->UpdateTransforms(vJobs);
+		}
+		cout << "\t" << VClock::ElapsedMs(vStart) << "ms" << endl;
+
+		/* doubling, but always finishing on the full core count */
+		if (vThreads < vMaxThreads && vThreads * 2 > vMaxThreads)
+			vThreads = vMaxThreads;
+		else
+			vThreads *= 2;
+	}
+	cout << endl;
+
+	vJobs.Shutdown();
+	delete vNodes[0];
+	delete[] vBoxes;
+}
@@ -0,0 +1,178 @@
+#include "engtest2.h"
+#include <cmath>
+#include <cstdlib>
+
+static unsigned int nCount = 10003;		/* not a multiple of 8, so the tails run */
+static unsigned int nIters = 100;
+
+static float Random()
+{
+	return rand() / (float)RAND_MAX * 2.0f - 1.0f;
+}
+
+/*
+ * Largest absolute errors of one accuracy tier, against double precision.
+ * RSqrt is relative.
+ */
+struct ApproxErrors
+{
+	double	fSin;
+	double	fCos;
+	double	fATan2;
+	double	fACos;
+	double	fRSqrt;
+};
+
+static const ApproxErrors sBounds[3] = {
+	{ 1e-6, 1e-6, 1e-6, 1e-6, 1e-6 },	/* MATH_EXACT */
+	{ 2e-7, 2e-7, 5e-7, 1e-6, 1e-6 },	/* MATH_PRECISE */
+	{ 2e-4, 2e-4, 1e-3, 1e-4, 1e-3 }	/* MATH_FAST */
+};
+
+static void Track(double& fWorst, double fErr)
+{
+	if (!(fErr <= fWorst))		/* catches NaN too */
+		fWorst = fErr;
+}
+
+static unsigned int CheckAccuracy(VMathAccuracy eAccuracy, const float *pAngles,
+								const float *pY, const float *pX, const float *pUnit,
+								const float *pPos, float *pOut1, float *pOut2)
+{
+	ApproxErrors		vErr = { 0.0, 0.0, 0.0, 0.0, 0.0 };
+	const ApproxErrors&	vMax = sBounds[eAccuracy];
+	unsigned int		vErrors = 0;
+	float				fSin, fCos;
+
+	VMath::SetAccuracy(eAccuracy);
+
+	/* scalar versions, and the ones following SetAccuracy() */
+	for (unsigned int i = 0; i < nCount; i++)
+	{
+		VMath::SinCos(pAngles[i], &fSin, &fCos, eAccuracy);
+		Track(vErr.fSin, fabs(fSin - sin((double)pAngles[i])));
+		Track(vErr.fCos, fabs(fCos - cos((double)pAngles[i])));
+		if (fSin != VMath::Sin(pAngles[i]) || fCos != VMath::Cos(pAngles[i]))
+			vErrors++;
+		VMath::SinCos(pAngles[i], &fSin, &fCos);
+		if (fSin != VMath::Sin(pAngles[i]) || fCos != VMath::Cos(pAngles[i]))
+			vErrors++;
+
+		fSin = VMath::ATan2(pY[i], pX[i], eAccuracy);
+		Track(vErr.fATan2, fabs(fSin - atan2((double)pY[i], (double)pX[i])));
+		if (fSin != VMath::ATan2(pY[i], pX[i]))
+			vErrors++;
+
+		fSin = VMath::ACos(pUnit[i], eAccuracy);
+		Track(vErr.fACos, fabs(fSin - acos((double)pUnit[i])));
+		if (fSin != VMath::ACos(pUnit[i]))
+			vErrors++;
+
+		fSin = VMath::RSqrt(pPos[i], eAccuracy);
+		Track(vErr.fRSqrt, fabs(fSin * sqrt((double)pPos[i]) - 1.0));
+		if (fSin != VMath::RSqrt(pPos[i]))
+			vErrors++;
+	}
+
+	/* array versions, on every tier; they may round differently */
+	for (int vTier = SIMD_SCALAR; vTier <= VCPU::GetDetectedTier(); vTier++)
+	{
+		VCPU::SetTier((VSimdTier)vTier);
+
+		VMath::SinCos(pAngles, pOut1, pOut2, nCount);
+		for (unsigned int i = 0; i < nCount; i++)
+		{
+			Track(vErr.fSin, fabs(pOut1[i] - sin((double)pAngles[i])));
+			Track(vErr.fCos, fabs(pOut2[i] - cos((double)pAngles[i])));
+		}
+		VMath::ATan2(pY, pX, pOut1, nCount);
+		for (unsigned int i = 0; i < nCount; i++)
+			Track(vErr.fATan2, fabs(pOut1[i] - atan2((double)pY[i], (double)pX[i])));
+		VMath::ACos(pUnit, pOut1, nCount);
+		for (unsigned int i = 0; i < nCount; i++)
+			Track(vErr.fACos, fabs(pOut1[i] - acos((double)pUnit[i])));
+		VMath::RSqrt(pPos, pOut1, nCount);
+		for (unsigned int i = 0; i < nCount; i++)
+			Track(vErr.fRSqrt, fabs(pOut1[i] * sqrt((double)pPos[i]) - 1.0));
+	}
+	VCPU::SetTier(VCPU::GetDetectedTier());
+	VMath::SetAccuracy(MATH_EXACT);
+
+	cout << "  sin " << vErr.fSin << "  cos " << vErr.fCos << "  atan2 " << vErr.fATan2
+		<< "  acos " << vErr.fACos << "  rsqrt " << vErr.fRSqrt << endl;
+	if (vErr.fSin > vMax.fSin)
+		vErrors++;
+	if (vErr.fCos > vMax.fCos)
+		vErrors++;
+	if (vErr.fATan2 > vMax.fATan2)
+		vErrors++;
+	if (vErr.fACos > vMax.fACos)
+		vErrors++;
+	if (vErr.fRSqrt > vMax.fRSqrt)
+		vErrors++;
+	return vErrors;
+}
+
+void TestMathApprox()
+{
+	VUINT64				vStart;
+	float				*vAngles = new float[nCount];
+	float				*vY = new float[nCount];
+	float				*vX = new float[nCount];
+	float				*vUnit = new float[nCount];
+	float				*vPos = new float[nCount];
+	float				*vOut1 = new float[nCount];
+	float				*vOut2 = new float[nCount];
+	static const char	*vNames[3] = { "exact", "precise", "fast" };
+	unsigned int		vErrors = 0;
+
+	cout << "===========================================" << endl;
+	cout << "= Approximate math testing					" << endl;
+	cout << "= Count: " << nCount << "  Iterations: " << nIters << endl;
+
+	srand(5);
+	for (unsigned int i = 0; i < nCount; i++)
+	{
+		vAngles[i] = Random() * 100.0f;
+		vY[i] = Random() * 10.0f;
+		vX[i] = Random() * 10.0f;
+		vUnit[i] = Random();
+		vPos[i] = powf(10.0f, Random() * 3.0f);
+	}
+	/* the edges: axes, the ends of acos and multiples of pi/2 */
+	vY[0] = 0.0f;	vX[0] = -1.0f;
+	vY[1] = 1.0f;	vX[1] = 0.0f;
+	vY[2] = 0.0f;	vX[2] = 1.0f;
+	vUnit[0] = -1.0f;
+	vUnit[1] = 1.0f;
+	vUnit[2] = 0.0f;
+	for (unsigned int i = 0; i < 8; i++)
+		vAngles[i] = VMath::HALF_PI * (float)i;
+
+	for (int eAccuracy = MATH_EXACT; eAccuracy <= MATH_FAST; eAccuracy++)
+	{
+		vErrors = CheckAccuracy((VMathAccuracy)eAccuracy, vAngles, vY, vX, vUnit, vPos,
+								vOut1, vOut2);
+		cout << "  " << vNames[eAccuracy] << " errors: " << vErrors << endl;
+	}
+
+	/* timing, the C library versus the fast polynomials */
+	for (int eAccuracy = MATH_EXACT; eAccuracy <= MATH_FAST; eAccuracy += MATH_FAST)
+	{
+		VMath::SetAccuracy((VMathAccuracy)eAccuracy);
+		vStart = VClock::GetNanos();
+		for (unsigned int n = 0; n < nIters; n++)
+			VMath::SinCos(vAngles, vOut1, vOut2, nCount);
+		cout << "  SinCos (" << vNames[eAccuracy] << "): " << VClock::ElapsedMs(vStart) << "ms" << endl;
+	}
+	VMath::SetAccuracy(MATH_EXACT);
+	cout << endl;
+
+	delete[] vAngles;
+	delete[] vY;
+	delete[] vX;
+	delete[] vUnit;
+	delete[] vPos;
+	delete[] vOut1;
+	delete[] vOut2;
+}
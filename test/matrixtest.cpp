@@ -1,7 +1,12 @@
 #include "engtest2.h"
+#include <viper3d/math/SIMD.h>
+#include <cmath>
 #include <cstdio>
+#include <cstdlib>
 
 static unsigned int nIters = 1000000;
+static unsigned int nMatrices = 1000;
+static unsigned int nPoints = 1001;		/* odd, so the 2-wide kernels hit their tail */
 //static unsigned int nIters = 2;
 
 void TestMult(VMatrix& m1, VMatrix &m2, unsigned int nIters);
@@ -29,7 +34,7 @@ void TestMult(VMatrix &m1, VMatrix &m2, unsigned int nIters)
 	cout << "                  Mult()" << endl;
 	cout << "===========================================" << endl;
 	/* first, test without SSE */
-	VCPU::mOSSSE = false;
+	VCPU::SetTier(SIMD_SCALAR);
 	ftime(&tp_start);
 	for (unsigned int i = 0; i < nIters; i++)
 	{
@@ -42,7 +47,7 @@ void TestMult(VMatrix &m1, VMatrix &m2, unsigned int nIters)
 	cout << "      result: " << vResult[0][0] << endl;
 
 	/* now, try with SSE */
-	VCPU::mOSSSE = true;
+	VCPU::SetTier(VCPU::GetDetectedTier());
 	ftime(&tp_start);
 	for (unsigned int i = 0; i < nIters; i++)
 	{
@@ -54,3 +59,304 @@ void TestMult(VMatrix &m1, VMatrix &m2, unsigned int nIters)
 	cout << "    WITH SSE: " << tm_diff_sec << "secs " << tm_diff_ms << "ms" << endl;
 	cout << "      result: " << vResult[0][0] << endl << endl;
 }
+
+/*
+ * Reference implementations, in double precision.
+ */
+static void RefMultiply(double pOut[16], const VMatrix& a, const VMatrix& b)
+{
+	for (int i = 0; i < 4; i++)
+		for (int j = 0; j < 4; j++)
+		{
+			pOut[i * 4 + j] = 0.0;
+			for (int k = 0; k < 4; k++)
+				pOut[i * 4 + j] += (double)a[i][k] * b[k][j];
+		}
+}
+
+/*
+ * Gauss-Jordan with partial pivoting; false when singular.
+ */
+static bool RefInverse(double pOut[16], const VMatrix& mat)
+{
+	double	vA[4][8];
+	int		i, j, k, vPivot;
+
+	for (i = 0; i < 4; i++)
+		for (j = 0; j < 4; j++)
+		{
+			vA[i][j] = mat[i][j];
+			vA[i][j + 4] = (i == j) ? 1.0 : 0.0;
+		}
+
+	for (k = 0; k < 4; k++)
+	{
+		vPivot = k;
+		for (i = k + 1; i < 4; i++)
+			if (fabs(vA[i][k]) > fabs(vA[vPivot][k]))
+				vPivot = i;
+		if (vA[vPivot][k] == 0.0)
+			return false;
+		for (j = 0; j < 8; j++)
+		{
+			double vTmp = vA[k][j];
+			vA[k][j] = vA[vPivot][j];
+			vA[vPivot][j] = vTmp;
+		}
+		for (j = 7; j >= k; j--)
+			vA[k][j] /= vA[k][k];
+		for (i = 0; i < 4; i++)
+		{
+			if (i == k)
+				continue;
+			for (j = 7; j >= k; j--)
+				vA[i][j] -= vA[i][k] * vA[k][j];
+		}
+	}
+
+	for (i = 0; i < 4; i++)
+		for (j = 0; j < 4; j++)
+			pOut[i * 4 + j] = vA[i][j + 4];
+	return true;
+}
+
+static bool Near(float f, double d, double fTol)
+{
+	return fabs(f - d) <= fTol * (1.0 + fabs(d));
+}
+
+static unsigned int Compare(const VMatrix& mat, const double pRef[16], double fTol)
+{
+	unsigned int vErrors = 0;
+
+	for (int i = 0; i < 16; i++)
+		if (!Near(mat[i / 4][i % 4], pRef[i], fTol))
+			vErrors++;
+	return vErrors ? 1 : 0;
+}
+
+static float Random()
+{
+	return rand() / (float)RAND_MAX * 2.0f - 1.0f;
+}
+
+/*
+ * Rotation, non-uniform scale and translation, in either the row 3
+ * (row vector) or column 3 (column vector) slot.
+ */
+static VMatrix RandomAffine(bool bColumn)
+{
+	VMatrix vRot, vScale;
+	VVector vAxis(Random(), Random(), Random() + 2.0f);
+
+	vAxis.Normalize();
+	vRot.RotaArbi(vAxis, Random() * 3.0f);
+	vScale[0][0] = 0.5f + VMath::Abs(Random()) * 2.0f;
+	vScale[1][1] = 0.5f + VMath::Abs(Random()) * 2.0f;
+	vScale[2][2] = 0.5f + VMath::Abs(Random()) * 2.0f;
+	vRot = vRot * vScale;
+	for (int i = 0; i < 3; i++)
+	{
+		vRot[3][i] = bColumn ? 0.0f : Random() * 10.0f;
+		vRot[i][3] = bColumn ? Random() * 10.0f : 0.0f;
+	}
+	vRot[3][3] = 1.0f;
+	return vRot;
+}
+
+static bool Near(const VVector& v1, const VVector& v2)
+{
+	return Near(v1.x, v2.x, 1e-5) && Near(v1.y, v2.y, 1e-5) &&
+		Near(v1.z, v2.z, 1e-5) && v1.w == v2.w;
+}
+
+static unsigned int Compare(const VAffine& xf, const double pRef[16], double fTol)
+{
+	VMatrix vMat;
+
+	xf.ToMatrix(vMat);
+	return Compare(vMat, pRef, fTol);
+}
+
+/*
+ * VAffine against the same work done with 4x4s in double precision.
+ */
+static unsigned int CheckAffine(const VVector *pPoints, VVector *pOut)
+{
+	unsigned int	vErrors = 0;
+	double			vRef[16];
+	VMatrix			vMatA, vMatB;
+
+	for (unsigned int n = 0; n < nMatrices; n++)
+	{
+		VVector vAxis(Random(), Random(), Random() + 2.0f);
+		VQuaternion vRot;
+
+		vAxis.Normalize();
+		vRot.FromAngleAxis(Random() * 3.0f, vAxis);
+		VAffine vA(vRot, VVector(Random(), Random(), Random()) * 10.0f,
+					0.5f + VMath::Abs(Random()));
+		VAffine vB(RandomAffine(true));
+
+		vA.ToMatrix(vMatA);
+		vB.ToMatrix(vMatB);
+		RefMultiply(vRef, vMatA, vMatB);
+		vErrors += Compare(vA * vB, vRef, 1e-5);
+		vErrors += Compare(vMatA * vB, vRef, 1e-5);
+
+		/* both inverses of a uniform scale, the general one of a shear */
+		VAffine vInv = vA;
+		RefInverse(vRef, vMatA);
+		if (!vInv.OrthoInverseOf(vInv))
+			vErrors++;
+		vErrors += Compare(vInv, vRef, 1e-4);
+		if (!vInv.InverseOf(vA))
+			vErrors++;
+		vErrors += Compare(vInv, vRef, 1e-4);
+		RefInverse(vRef, vMatB);
+		if (!vInv.InverseOf(vB))
+			vErrors++;
+		vErrors += Compare(vInv, vRef, 1e-4);
+
+		if (n == 0)
+		{
+			vA.TransformPoints(pOut, pPoints, nPoints);
+			for (unsigned int i = 0; i < nPoints; i++)
+			{
+				VVector vRefPt = vMatA * pPoints[i] + vA.GetTranslation();
+				vRefPt.w = 1.0f;
+				if (!Near(pOut[i], vRefPt) || !Near(vA.TransformPoint(pPoints[i]), pOut[i]))
+					vErrors++;
+			}
+			vA.TransformDirections(pOut, pPoints, nPoints);
+			for (unsigned int i = 0; i < nPoints; i++)
+				if (!Near(vA.TransformDirection(pPoints[i]), pOut[i]) || pOut[i].w != 0.0f)
+					vErrors++;
+		}
+	}
+
+	VAffine vZero;
+	vZero[0][0] = vZero[1][1] = vZero[2][2] = 0.0f;
+	VAffine vKeep = VAffine::AFFINE_IDENTITY;
+	if (vKeep.InverseOf(vZero) || vKeep.OrthoInverseOf(vZero) || vKeep[0][0] != 1.0f)
+		vErrors++;
+
+	return vErrors;
+}
+
+static unsigned int CheckMatrixKernels(const VMatrix *pMats, const VVector *pPoints,
+										VVector *pOut)
+{
+	unsigned int	vErrors = 0;
+	double			vRef[16];
+	VMatrix			vResult;
+
+	for (unsigned int n = 0; n + 1 < nMatrices; n++)
+	{
+		const VMatrix &a = pMats[n];
+		const VMatrix &b = pMats[n + 1];
+
+		RefMultiply(vRef, a, b);
+		vErrors += Compare(a * b, vRef, 1e-5);
+
+		vResult.TransposeOf(a);
+		for (int i = 0; i < 16; i++)
+			vRef[i] = a[i % 4][i / 4];
+		vErrors += Compare(vResult, vRef, 0.0);
+		vErrors += Compare(a.Transpose(), vRef, 0.0);
+
+		/* aliased in place */
+		vResult = a;
+		vResult.InverseOf(vResult);
+		if (!RefInverse(vRef, a))
+			continue;
+		vErrors += Compare(vResult, vRef, 1e-3);
+
+		VMatrix vAffine = RandomAffine((n & 1) != 0);
+		vResult = vAffine;
+		if (!vResult.AffineInverseOf(vResult) || !RefInverse(vRef, vAffine))
+			vErrors++;
+		else
+			vErrors += Compare(vResult, vRef, 1e-4);
+	}
+
+	/* singular matrices are reported, and leave the result alone */
+	vResult = VMatrix::MATRIX_IDENTITY;
+	if (vResult.InverseOf(VMatrix::MATRIX_ZERO) || vResult.AffineInverseOf(VMatrix::MATRIX_ZERO))
+		vErrors++;
+	if (vResult[0][0] != 1.0f || vResult[3][2] != 0.0f)
+		vErrors++;
+
+	/* transforms, as whole arrays and one at a time in place */
+	const VMatrix &vMat = pMats[0];
+	vMat.TransformPoints(pOut, pPoints, nPoints);
+	for (unsigned int i = 0; i < nPoints; i++)
+	{
+		const VVector &v = pPoints[i];
+		VVector vDir = v;
+
+		vMat.TransformDirections(&vDir, &vDir, 1);
+		for (int j = 0; j < 4; j++)
+		{
+			double d = (double)v.x * vMat[0][j] + (double)v.y * vMat[1][j] +
+						(double)v.z * vMat[2][j];
+			if (!Near((&pOut[i].x)[j], d + vMat[3][j], 1e-5) ||
+				!Near((&vDir.x)[j], d, 1e-5))
+				vErrors++;
+		}
+	}
+	vMat.TransformDirections(pOut, pPoints, nPoints);
+	for (unsigned int i = 0; i < nPoints; i++)
+	{
+		VVector vDir = pPoints[i];
+		vMat.TransformDirections(&vDir, &vDir, 1);
+		if (!Near(pOut[i].x, vDir.x, 1e-6) || !Near(pOut[i].w, vDir.w, 1e-6))
+			vErrors++;
+	}
+
+	return vErrors;
+}
+
+void TestMatrixKernels()
+{
+	VUINT64			vStart;
+	VMatrix			*vMats = new VMatrix[nMatrices];
+	VVector			*vPoints = new VVector[nPoints];
+	VVector			*vOut = new VVector[nPoints];
+	VMatrix			vResult;
+
+	cout << "===========================================" << endl;
+	cout << "= Matrix kernel testing					" << endl;
+	cout << "= Matrices: " << nMatrices << "  Points: " << nPoints << endl;
+
+	srand(1);
+	for (unsigned int n = 0; n < nMatrices; n++)
+		for (int i = 0; i < 16; i++)
+			vMats[n][i / 4][i % 4] = Random() * 4.0f;
+	for (unsigned int i = 0; i < nPoints; i++)
+		vPoints[i].SetValues(Random() * 100.0f, Random() * 100.0f, Random() * 100.0f, 1.0f);
+
+	/* correctness against double precision, for every tier */
+	for (int vTier = SIMD_SCALAR; vTier <= VCPU::GetDetectedTier(); vTier++)
+	{
+		VCPU::SetTier((VSimdTier)vTier);
+		cout << "  " << VCPU::GetTierName((VSimdTier)vTier) << " errors: "
+			<< CheckMatrixKernels(vMats, vPoints, vOut) << "  affine errors: "
+			<< CheckAffine(vPoints, vOut) << endl;
+	}
+	VCPU::SetTier(VCPU::GetDetectedTier());
+
+	vStart = VClock::GetNanos();
+	for (unsigned int i = 0; i < nIters; i++)
+		vResult.InverseOf(vMats[i % nMatrices]);
+	cout << "  InverseOf:       " << VClock::ElapsedMs(vStart) << "ms  " << vResult[0][0] << endl;
+
+	vStart = VClock::GetNanos();
+	for (unsigned int i = 0; i < nIters / nPoints; i++)
+		vMats[i % nMatrices].TransformPoints(vOut, vPoints, nPoints);
+	cout << "  TransformPoints: " << VClock::ElapsedMs(vStart) << "ms  " << vOut[0].x << endl << endl;
+
+	delete[] vMats;
+	delete[] vPoints;
+	delete[] vOut;
+}
@@ -0,0 +1,202 @@
+#include "engtest2.h"
+#include <viper3d/RenderQueue.h>
+#include <viper3d/Profiler.h>
+#include <viper3d/render/null/NullRenderSystem.h>
+#include <viper3d/render/null/NullWindow.h>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+static unsigned int nItems = 5000;
+static unsigned int nFrames = 100;
+
+/*
+ * Checks that a frame's command stream agrees with its totals and that
+ * the time stamps never go backwards.
+ */
+static unsigned int CheckStream(const std::vector<VNullCommand>& vCommands,
+								const VNullFrame& frame, VUINT nFrom)
+{
+	unsigned int	vErrors = 0;
+	VUINT			vDraws = 0, vRanges = 0, vElements = 0, vStates = 0, vWorlds = 0;
+
+	if (vCommands.size() - nFrom != frame.mCommands)
+		vErrors++;
+	for (VUINT i = nFrom; i < vCommands.size(); i++)
+	{
+		const VNullCommand &vC = vCommands[i];
+
+		if (i > 0 && vC.mTicks < vCommands[i - 1].mTicks)
+			vErrors++;
+		if (vC.mOp == NULLOP_DRAW)
+		{
+			vDraws++;
+			vRanges += vC.mArg0;
+			vElements += vC.mArg1;
+		}
+		else if (vC.mOp == NULLOP_SET_STATE)
+			vStates++;
+		else if (vC.mOp == NULLOP_SET_WORLD)
+			vWorlds++;
+	}
+	if (vDraws != frame.mDraws || vRanges != frame.mRanges || vElements != frame.mElements ||
+		vStates != frame.mStateChanges || vWorlds != frame.mWorlds)
+		vErrors++;
+	return vErrors;
+}
+
+void TestNullRender()
+{
+	VNullRenderSystem	vRender;
+	VRenderQueue		vQueue;
+	VCamera				vCamera;
+	VWindowOpts			vOpts;
+	VWindow				*vWin;
+	VMeshDesc			vDesc;
+	VMeshHandle			vMeshes[16], vHandle;
+	std::vector<float>	vVerts;
+	std::vector<VUINT>	vIndis;
+	VMatrix				vWorld;
+	VUINT				vFrom, vQueuedDraws;
+	unsigned int		vErrors = 0;
+	double				vRate = VProfiler::GetTickRate();
+	double				vRecordNs, vQuietNs, vDirectNs;
+	VUINT64				vStart;
+
+	cout << "===========================================" << endl;
+	cout << "= NULL render system						" << endl;
+	cout << "= Items: " << nItems << "  Frames: " << nFrames << endl;
+
+	vOpts.mWidth = 640;
+	vOpts.mHeight = 480;
+	vOpts.mFullScreen = false;
+	if (!vRender.Init() || (vWin = vRender.CreateWin(&vOpts)) == NULL)
+	{
+		cout << "  unable to create the NULL renderer" << endl << endl;
+		return;
+	}
+	vWin->SetCaption("NULL test");
+
+	/* meshes keep what was uploaded, and every upload is recorded */
+	srand(24);
+	vDesc.mFormat = VERTEX_POSITION;
+	for (int m = 0; m < 16; m++)
+	{
+		vDesc.mNumVerts = 3 * (m + 1);
+		vDesc.mNumIndis = m & 1 ? vDesc.mNumVerts : 0;
+		vVerts.resize(vDesc.mNumVerts * 3);
+		vIndis.resize(vDesc.mNumVerts);
+		for (VUINT i = 0; i < vVerts.size(); i++)
+			vVerts[i] = (float)rand();
+		for (VUINT i = 0; i < vIndis.size(); i++)
+			vIndis[i] = vDesc.mNumVerts - 1 - i;
+		vMeshes[m] = vRender.CreateMesh(vDesc, &vVerts[0], vDesc.mNumIndis ? &vIndis[0] : NULL);
+		if (memcmp(vRender.GetMeshVerts(vMeshes[m]), &vVerts[0], vVerts.size() * sizeof(float)) != 0)
+			vErrors++;
+		if (vDesc.mNumIndis > 0 &&
+			memcmp(vRender.GetMeshIndis(vMeshes[m]), &vIndis[0], vIndis.size() * sizeof(VUINT)) != 0)
+			vErrors++;
+	}
+	vVerts.resize(300);
+	if (!vRender.UpdateMesh(vMeshes[0], &vVerts[0], 100) ||
+		!vRender.GetMeshDesc(vMeshes[0], &vDesc) || vDesc.mNumVerts != 100)
+		vErrors++;
+	if (vRender.GetCommands().size() != 17 || vRender.GetCommands()[16].mOp != NULLOP_UPDATE_MESH ||
+		vRender.GetCommands()[16].mArg0 != 1200 || vRender.GetCurrentFrame().mUploads != 17)
+		vErrors++;
+
+	/* destroyed handles are refused, then reused */
+	vRender.DestroyMesh(vMeshes[5]);
+	if (vRender.DrawMesh(vMeshes[5]) || vRender.UpdateMesh(vMeshes[5], &vVerts[0], 3))
+		vErrors++;
+	vDesc.mNumVerts = 18;
+	vDesc.mNumIndis = 0;
+	vHandle = vRender.CreateMesh(vDesc, NULL, NULL);
+	if (vHandle != vMeshes[5] || vRender.GetMeshVerts(vHandle) == NULL)
+		vErrors++;
+	cout << "  mesh errors: " << vErrors << endl;
+
+	/* a frame from a queue records what DrawQueue() asked for */
+	vErrors = 0;
+	vRender.ClearRecord();
+	vQueue.SetEye(VVector(0.0f, 0.0f, 0.0f), 1000.0f);
+	for (VUINT i = 0; i < nItems; i++)
+	{
+		VVector vPos((float)(rand() % 1000) - 500.0f, (float)(rand() % 1000) - 500.0f, -10.0f);
+		VMeshHandle vMesh = vMeshes[rand() % 16];
+		VUINT vMaterial = rand() % 8, vTexture = rand() % 4;
+
+		vWorld = VMatrix::MATRIX_IDENTITY;
+		vWorld.SetTranslation(vPos);
+		vQueue.Push(vQueue.MakeKey(rand() % 2, vMaterial, vTexture, vMesh, vQueue.GetDepth(vPos)),
+					vMaterial, vTexture, vMesh, i % 4 ? NULL : &vWorld);
+	}
+	vRender.Render(vWin, &vCamera, &vQueue);
+	{
+		const VNullFrame &vFrame = vRender.GetFrames().back();
+
+		if (vRender.GetFrames().size() != 1 || vFrame.mRanges != nItems ||
+			vFrame.mDraws != vQueue.GetStats().mDraws ||
+			vFrame.mStateChanges != vQueue.GetStats().mStateChanges ||
+			vRender.GetCommands().back().mOp != NULLOP_PRESENT)
+			vErrors++;
+		vErrors += CheckStream(vRender.GetCommands(), vFrame, 0);
+		vQueuedDraws = vFrame.mDraws;
+	}
+
+	/* a direct draw counts the whole mesh */
+	vFrom = (VUINT)vRender.GetCommands().size();
+	vRender.SetState(1, 0);
+	vRender.DrawMesh(vMeshes[1]);
+	vRender.Render(vWin, &vCamera);
+	if (vRender.GetFrames().back().mElements != 6 || vRender.GetFrames().back().mDraws != 1)
+		vErrors++;
+	vErrors += CheckStream(vRender.GetCommands(), vRender.GetFrames().back(), vFrom);
+	if (static_cast<VNullWindow*>(vWin)->GetSwaps() != 2)
+		vErrors++;
+
+	/* a transform is concatenated with the camera's, as the GL backend does */
+	vRender.SetWorldMatrix(vWorld);
+	vWorld = vCamera.GetViewProjection() * vWorld;
+	if (memcmp(&vRender.GetWorldView(), &vWorld, sizeof(VMatrix)) != 0)
+		vErrors++;
+	cout << "  stream errors: " << vErrors << endl;
+
+	/* CPU cost of submitting the same frame, with and without the stream */
+	vRender.ClearRecord();
+	vStart = VProfiler::GetTicks();
+	for (VUINT f = 0; f < nFrames; f++)
+		vRender.Render(vWin, &vCamera, &vQueue);
+	vRecordNs = (VProfiler::GetTicks() - vStart) * 1e9 / vRate / nFrames;
+	vRender.SetRecording(false);
+	vRender.ClearRecord();
+	vStart = VProfiler::GetTicks();
+	for (VUINT f = 0; f < nFrames; f++)
+		vRender.Render(vWin, &vCamera, &vQueue);
+	vQuietNs = (VProfiler::GetTicks() - vStart) * 1e9 / vRate / nFrames;
+
+	/* the same draws made one call each, with nothing merged */
+	vRender.ClearRecord();
+	vStart = VProfiler::GetTicks();
+	for (VUINT f = 0; f < nFrames; f++)
+	{
+		for (VUINT i = 0; i < nItems; i++)
+		{
+			const VRenderItem &vItem = vQueue.GetItem(i);
+
+			vRender.SetState(vItem.mMaterial, vItem.mTexture);
+			vRender.SetWorldMatrix(vQueue.GetWorld(vItem.mWorld));
+			vRender.DrawMesh(vItem.mMesh);
+		}
+		vRender.Render(vWin, &vCamera);
+	}
+	vDirectNs = (VProfiler::GetTicks() - vStart) * 1e9 / vRate / nFrames;
+	vRender.SetRecording(true);
+
+	cout << "  per frame: queued " << vRecordNs / 1000.0 << "us recording, "
+		<< vQuietNs / 1000.0 << "us not; direct " << vDirectNs / 1000.0 << "us ("
+		<< vRender.GetFrames().back().mDraws << " draws vs "
+		<< vQueuedDraws << ")" << endl << endl;
+
+	vRender.DestroyWin(vWin);
+}
@@ -0,0 +1,311 @@
+#include "engtest2.h"
+#include <viper3d/math/ObbBatch.h>
+#include <cstdlib>
+
+static unsigned int nCount = 20000;		/* pairs */
+static unsigned int nIters = 20;
+
+static VVector RandUnit()
+{
+	VVector vV(Rand(-1.0f, 1.0f), Rand(-1.0f, 1.0f), Rand(-1.0f, 1.0f));
+	vV.Normalize();
+	return vV;
+}
+
+/*
+ * A random box; every fourth one keeps the world axes, so plenty of
+ * pairs have parallel edges.
+ */
+static VObb RandObb(unsigned int i)
+{
+	VObb	vObb;
+	VMatrix	vRot = VMatrix::MATRIX_IDENTITY;
+
+	if (i % 4 != 0)
+		vRot.RotaArbi(RandUnit(), Rand(-3.14f, 3.14f));
+	vObb.vA0 = VVector(vRot[0][0], vRot[1][0], vRot[2][0]);
+	vObb.vA1 = VVector(vRot[0][1], vRot[1][1], vRot[2][1]);
+	vObb.vA2 = VVector(vRot[0][2], vRot[1][2], vRot[2][2]);
+	vObb.fA0 = Rand(0.2f, 3.0f);
+	vObb.fA1 = Rand(0.2f, 3.0f);
+	vObb.fA2 = Rand(0.2f, 3.0f);
+	vObb.vCenter = VVector(Rand(-5.0f, 5.0f), Rand(-5.0f, 5.0f), Rand(-5.0f, 5.0f));
+	return vObb;
+}
+
+/*
+ * Independent separating axis test in double precision: every corner is
+ * projected onto every candidate axis.  Returns the largest gap found
+ * along any axis, positive when the shapes are apart.
+ */
+static void Corners(const VObb& obb, double *pOut)
+{
+	for (int c = 0; c < 8; c++)
+	{
+		double sx = (c & 1) ? obb.fA0 : -obb.fA0;
+		double sy = (c & 2) ? obb.fA1 : -obb.fA1;
+		double sz = (c & 4) ? obb.fA2 : -obb.fA2;
+		pOut[c * 3 + 0] = obb.vCenter.x + sx * obb.vA0.x + sy * obb.vA1.x + sz * obb.vA2.x;
+		pOut[c * 3 + 1] = obb.vCenter.y + sx * obb.vA0.y + sy * obb.vA1.y + sz * obb.vA2.y;
+		pOut[c * 3 + 2] = obb.vCenter.z + sx * obb.vA0.z + sy * obb.vA1.z + sz * obb.vA2.z;
+	}
+}
+
+static double Gap(const double *pA, int nA, const double *pB, int nB,
+					const double *pAxes, int nAxes)
+{
+	double fGap = -1e300;
+
+	for (int k = 0; k < nAxes; k++)
+	{
+		const double *vV = pAxes + k * 3;
+		double fLen = sqrt(vV[0] * vV[0] + vV[1] * vV[1] + vV[2] * vV[2]);
+		double fMinA = 1e300, fMaxA = -1e300, fMinB = 1e300, fMaxB = -1e300, p;
+
+		if (fLen < 1e-3)
+			continue;
+		for (int i = 0; i < nA; i++)
+		{
+			p = (pA[i * 3] * vV[0] + pA[i * 3 + 1] * vV[1] + pA[i * 3 + 2] * vV[2]) / fLen;
+			fMinA = p < fMinA ? p : fMinA;
+			fMaxA = p > fMaxA ? p : fMaxA;
+		}
+		for (int i = 0; i < nB; i++)
+		{
+			p = (pB[i * 3] * vV[0] + pB[i * 3 + 1] * vV[1] + pB[i * 3 + 2] * vV[2]) / fLen;
+			fMinB = p < fMinB ? p : fMinB;
+			fMaxB = p > fMaxB ? p : fMaxB;
+		}
+		p = fMinB - fMaxA > fMinA - fMaxB ? fMinB - fMaxA : fMinA - fMaxB;
+		fGap = p > fGap ? p : fGap;
+	}
+	return fGap;
+}
+
+static void Cross(double *pOut, const double *pA, const double *pB)
+{
+	pOut[0] = pA[1] * pB[2] - pA[2] * pB[1];
+	pOut[1] = pA[2] * pB[0] - pA[0] * pB[2];
+	pOut[2] = pA[0] * pB[1] - pA[1] * pB[0];
+}
+
+static void Axes(const VObb& obb, double *pOut)
+{
+	const VVector *vA[3] = { &obb.vA0, &obb.vA1, &obb.vA2 };
+
+	for (int k = 0; k < 3; k++)
+	{
+		pOut[k * 3 + 0] = vA[k]->x;
+		pOut[k * 3 + 1] = vA[k]->y;
+		pOut[k * 3 + 2] = vA[k]->z;
+	}
+}
+
+static double ObbGap(const VObb& a, const VObb& b)
+{
+	double vA[24], vB[24], vAxes[15 * 3];
+
+	Corners(a, vA);
+	Corners(b, vB);
+	Axes(a, vAxes);
+	Axes(b, vAxes + 9);
+	for (int i = 0; i < 3; i++)
+		for (int j = 0; j < 3; j++)
+			Cross(vAxes + 18 + (i * 3 + j) * 3, vAxes + i * 3, vAxes + 9 + j * 3);
+	return Gap(vA, 8, vB, 8, vAxes, 15);
+}
+
+static double TriangleGap(const VObb& a, const VVector *pTri)
+{
+	double vA[24], vT[9], vE[9], vAxes[13 * 3];
+
+	Corners(a, vA);
+	for (int i = 0; i < 3; i++)
+	{
+		vT[i * 3 + 0] = pTri[i].x;
+		vT[i * 3 + 1] = pTri[i].y;
+		vT[i * 3 + 2] = pTri[i].z;
+	}
+	for (int i = 0; i < 3; i++)
+		for (int k = 0; k < 3; k++)
+			vE[i * 3 + k] = vT[((i + 1) % 3) * 3 + k] - vT[i * 3 + k];
+	Axes(a, vAxes);
+	Cross(vAxes + 9, vE, vE + 3);
+	for (int i = 0; i < 3; i++)
+		for (int j = 0; j < 3; j++)
+			Cross(vAxes + 12 + (i * 3 + j) * 3, vE + i * 3, vAxes + j * 3);
+	return Gap(vA, 8, vT, 3, vAxes, 13);
+}
+
+/*
+ * The scalar tests against the reference, leaving out pairs too close
+ * to touching to call.
+ */
+static unsigned int CheckScalar(VObb *pA, VObb *pB, VVector *pTris)
+{
+	unsigned int	vErrors = 0;
+	double			fGap;
+
+	for (unsigned int i = 0; i < nCount; i++)
+	{
+		fGap = ObbGap(pA[i], pB[i]);
+		if (fGap > 1e-3 && pA[i].Intersects(pB[i]))
+			vErrors++;
+		if (fGap < -1e-3 && !pA[i].Intersects(pB[i]))
+			vErrors++;
+
+		fGap = TriangleGap(pA[i], pTris + i * 3);
+		if (fGap > 1e-3 && pA[i].Intersects(pTris[i * 3], pTris[i * 3 + 1], pTris[i * 3 + 2]))
+			vErrors++;
+		if (fGap < -1e-3 && !pA[i].Intersects(pTris[i * 3], pTris[i * 3 + 1], pTris[i * 3 + 2]))
+			vErrors++;
+	}
+	return vErrors;
+}
+
+/*
+ * The batches against the scalar tests, which they must match exactly.
+ */
+static unsigned int CheckBatch(VObb *pA, VObb *pB, VVector *pTris,
+								const VObbBatch& batchA, const VObbBatch& batchB,
+								const VVectorBatch *pCorners, VUINT *pHits,
+								VUINT *pIndices)
+{
+	unsigned int	vErrors = 0;
+	VUINT			vNum, vExpected = 0;
+	bool			bHit;
+
+	batchA.IntersectMask(batchB, pHits);
+	for (unsigned int i = 0; i < nCount; i++)
+	{
+		bHit = pA[i].Intersects(pB[i]);
+		if (((pHits[i >> 5] >> (i & 31)) & 1) != (VUINT)bHit)
+			vErrors++;
+		if (bHit)
+			vExpected++;
+	}
+	vNum = batchA.Intersects(batchB, pIndices);
+	if (vNum != vExpected)
+		vErrors++;
+	for (VUINT i = 0; i < vNum; i++)
+		if (((pHits[pIndices[i] >> 5] >> (pIndices[i] & 31)) & 1) == 0 ||
+			(i > 0 && pIndices[i] <= pIndices[i - 1]))
+			vErrors++;
+
+	vExpected = 0;
+	batchA.IntersectMask(pCorners[0], pCorners[1], pCorners[2], pHits);
+	for (unsigned int i = 0; i < nCount; i++)
+	{
+		bHit = pA[i].Intersects(pTris[i * 3], pTris[i * 3 + 1], pTris[i * 3 + 2]);
+		if (((pHits[i >> 5] >> (i & 31)) & 1) != (VUINT)bHit)
+			vErrors++;
+		if (bHit)
+			vExpected++;
+	}
+	vNum = batchA.Intersects(pCorners[0], pCorners[1], pCorners[2], pIndices);
+	if (vNum != vExpected)
+		vErrors++;
+
+	return vErrors;
+}
+
+void TestObbBatch()
+{
+	VUINT64			vStart;
+	VObb			*vA = new VObb[nCount];
+	VObb			*vB = new VObb[nCount];
+	VVector			*vTris = new VVector[nCount * 3];
+	VUINT			*vHits = new VUINT[VObbBatch::MaskWords(nCount)];
+	VUINT			*vIndices = new VUINT[nCount];
+	VVectorBatch	vCorners[3];
+	unsigned int	vErrors = 0;
+	VUINT			vNum = 0;
+
+	cout << "===========================================" << endl;
+	cout << "= OBB separating axis tests				" << endl;
+	cout << "= Count: " << nCount << "  Iterations: " << nIters << endl;
+
+	srand(8);
+	for (unsigned int i = 0; i < nCount; i++)
+	{
+		vA[i] = RandObb(i);
+		vB[i] = RandObb(i + 1);
+		/* every other pair shares A's axes exactly */
+		if (i % 2 == 0)
+		{
+			vB[i].vA0 = vA[i].vA0;
+			vB[i].vA1 = vA[i].vA1;
+			vB[i].vA2 = vA[i].vA2;
+		}
+
+		VVector vC(Rand(-5.0f, 5.0f), Rand(-5.0f, 5.0f), Rand(-5.0f, 5.0f));
+		for (int c = 0; c < 3; c++)
+			vTris[i * 3 + c] = vC + VVector(Rand(-3.0f, 3.0f), Rand(-3.0f, 3.0f),
+											Rand(-3.0f, 3.0f));
+		/* some triangles with an edge along a box axis */
+		if (i % 5 == 0)
+			vTris[i * 3 + 1] = vTris[i * 3] + vA[i].vA1 * 2.0f;
+	}
+
+	VObbBatch vBatchA(vA, nCount);
+	VObbBatch vBatchB(vB, nCount);
+	for (int c = 0; c < 3; c++)
+	{
+		vCorners[c].Resize(nCount);
+		for (unsigned int i = 0; i < nCount; i++)
+			vCorners[c].Set(i, vTris[i * 3 + c]);
+	}
+
+	vErrors = CheckScalar(vA, vB, vTris);
+	cout << "  VObb errors: " << vErrors << endl;
+
+	for (int vTier = SIMD_SCALAR; vTier <= VCPU::GetDetectedTier(); vTier++)
+	{
+		VCPU::SetTier((VSimdTier)vTier);
+		vErrors = CheckBatch(vA, vB, vTris, vBatchA, vBatchB, vCorners, vHits, vIndices);
+		cout << "  " << VCPU::GetTierName((VSimdTier)vTier) << " errors: "
+			<< vErrors << endl;
+	}
+	VCPU::SetTier(VCPU::GetDetectedTier());
+
+	/* timing, one pair at a time versus the batch */
+	vStart = VClock::GetNanos();
+	for (unsigned int n = 0; n < nIters; n++)
+	{
+		vNum = 0;
+		for (unsigned int i = 0; i < nCount; i++)
+			if (vA[i].Intersects(vB[i]))
+				vIndices[vNum++] = i;
+	}
+	cout << "  per VObb:     " << VClock::ElapsedMs(vStart) << "ms (" << vNum
+		<< " overlap)" << endl;
+
+	vStart = VClock::GetNanos();
+	for (unsigned int n = 0; n < nIters; n++)
+		vNum = vBatchA.Intersects(vBatchB, vIndices);
+	cout << "  VObbBatch:    " << VClock::ElapsedMs(vStart) << "ms (" << vNum
+		<< " overlap)" << endl;
+
+	vStart = VClock::GetNanos();
+	for (unsigned int n = 0; n < nIters; n++)
+	{
+		vNum = 0;
+		for (unsigned int i = 0; i < nCount; i++)
+			if (vA[i].Intersects(vTris[i * 3], vTris[i * 3 + 1], vTris[i * 3 + 2]))
+				vIndices[vNum++] = i;
+	}
+	cout << "  per triangle: " << VClock::ElapsedMs(vStart) << "ms (" << vNum
+		<< " overlap)" << endl;
+
+	vStart = VClock::GetNanos();
+	for (unsigned int n = 0; n < nIters; n++)
+		vNum = vBatchA.Intersects(vCorners[0], vCorners[1], vCorners[2], vIndices);
+	cout << "  triangles:    " << VClock::ElapsedMs(vStart) << "ms (" << vNum
+		<< " overlap)" << endl << endl;
+
+	delete[] vA;
+	delete[] vB;
+	delete[] vTris;
+	delete[] vHits;
+	delete[] vIndices;
+}
@@ -0,0 +1,244 @@
+#include "engtest2.h"
+#include <viper3d/util/Arena.h>
+#include <cstdlib>
+
+static unsigned int nCount = 20000;
+
+/*
+ * Heap allocations made so far by a set of polygons.
+ */
+static VUINT HeapAllocs(const VPolygon *pPolys, int nNum)
+{
+	VUINT vAllocs = 0;
+
+	for (int i = 0; i < nNum; i++)
+		vAllocs += pPolys[i].GetHeapAllocs();
+	return vAllocs;
+}
+
+static VVector RandUnit()
+{
+	VVector vV(Rand(-1.0f, 1.0f), Rand(-1.0f, 1.0f), Rand(-1.0f, 1.0f));
+	vV.Normalize();
+	return vV;
+}
+
+/*
+ * A convex, planar polygon: nNumP points on an ellipse.
+ */
+static void RandomPoly(VPolygon *pPoly, int nNumP)
+{
+	VVector	vPoints[64];
+	VUINT	vIndis[(64 - 2) * 3];
+	VVector	vN = RandUnit();
+	VVector	vU, vV;
+	VVector	vC(Rand(-5.0f, 5.0f), Rand(-5.0f, 5.0f), Rand(-5.0f, 5.0f));
+	float	fA = Rand(1.0f, 4.0f), fB = Rand(1.0f, 4.0f);
+
+	vU.Cross(vN, VMath::Abs(vN.x) < 0.9f ? VVector(1.0f, 0.0f, 0.0f) : VVector(0.0f, 1.0f, 0.0f));
+	vU.Normalize();
+	vV.Cross(vN, vU);
+	for (int i = 0; i < nNumP; i++)
+	{
+		float fT = 6.2831853f * i / nNumP;
+		vPoints[i] = vC + vU * (fA * cosf(fT)) + vV * (fB * sinf(fT));
+	}
+	for (int i = 0; i < nNumP - 2; i++)
+	{
+		vIndis[i * 3 + 0] = 0;
+		vIndis[i * 3 + 1] = i + 1;
+		vIndis[i * 3 + 2] = i + 2;
+	}
+	pPoly->Set(vPoints, nNumP, vIndis, (nNumP - 2) * 3);
+}
+
+static float Area(const VPolygon& poly)
+{
+	const VVector	*vP = poly.GetPoints();
+	const VUINT		*vI = poly.GetIndices();
+	VVector			vCross;
+	float			fArea = 0.0f;
+
+	for (int i = 0; i < poly.GetNumIndis(); i += 3)
+	{
+		vCross.Cross(vP[vI[i + 1]] - vP[vI[i]], vP[vI[i + 2]] - vP[vI[i]]);
+		fArea += 0.5f * vCross.Length();
+	}
+	return fArea;
+}
+
+/*
+ * The halves of a plane clip cover the polygon, lie on their own sides
+ * and face the same way.
+ */
+static unsigned int CheckClip(VPolygon& poly, const VPlane& plane,
+								VPolygon& front, VPolygon& back)
+{
+	unsigned int	vErrors = 0;
+	float			fSum = 0.0f;
+	float			fD;
+
+	front.Set(NULL, 0, NULL, 0);
+	back.Set(NULL, 0, NULL, 0);
+	poly.Clip(plane, &front, &back);
+
+	for (int i = 0; i < front.GetNumPoints(); i++)
+	{
+		fD = plane.m_vN * front.GetPoints()[i] + plane.m_fD;
+		if (fD < -1e-3f)
+			vErrors++;
+	}
+	for (int i = 0; i < back.GetNumPoints(); i++)
+	{
+		fD = plane.m_vN * back.GetPoints()[i] + plane.m_fD;
+		if (fD > 1e-3f)
+			vErrors++;
+	}
+	if (front.GetNumPoints() > 0)
+	{
+		fSum += Area(front);
+		if (front.GetPlane().m_vN * poly.GetPlane().m_vN < 0.99f)
+			vErrors++;
+	}
+	if (back.GetNumPoints() > 0)
+	{
+		fSum += Area(back);
+		if (back.GetPlane().m_vN * poly.GetPlane().m_vN < 0.99f)
+			vErrors++;
+	}
+	if (VMath::Abs(fSum - Area(poly)) > 1e-3f * (1.0f + Area(poly)))
+		vErrors++;
+	return vErrors;
+}
+
+/*
+ * Clip(VAabb) only cuts along the box planes the polygon straddles, so
+ * what is left of a polygon that misses the box can lie wholly outside
+ * one of them; the points are only checked when that is not so.
+ */
+static unsigned int CheckBoxClip(const VPolygon& poly, const VAabb& box)
+{
+	VPolygon		vClipped(poly);
+	unsigned int	vErrors = 0;
+	VAabb			vBox = box;
+	VPlane			vPlanes[6];
+
+	vBox.GetPlanes(vPlanes);
+	vClipped.Clip(box);
+	for (int p = 0; p < 6; p++)
+		if (vPlanes[p].Classify(vClipped) == VFRONT)
+			return 0;
+
+	for (int i = 0; i < vClipped.GetNumPoints(); i++)
+	{
+		const VVector &vP = vClipped.GetPoints()[i];
+		if (vP.x < vBox.GetMin().x - 1e-3f || vP.x > vBox.GetMax().x + 1e-3f ||
+			vP.y < vBox.GetMin().y - 1e-3f || vP.y > vBox.GetMax().y + 1e-3f ||
+			vP.z < vBox.GetMin().z - 1e-3f || vP.z > vBox.GetMax().z + 1e-3f)
+			vErrors++;
+	}
+	if (vClipped.GetNumPoints() > 0 &&
+		vClipped.GetPlane().m_vN * poly.GetPlane().m_vN < 0.99f)
+		vErrors++;
+	return vErrors;
+}
+
+void TestPolygonClip()
+{
+	VUINT64			vStart;
+	VPolygon		*vPolys = new VPolygon[64];
+	VPlane			*vPlanes = new VPlane[64];
+	VAabb			*vBoxes = new VAabb[64];
+	VPolygon		vFront, vBack, vWork;
+	VArena			vArena(4096);
+	unsigned int	vErrors = 0;
+	unsigned int	vClips = 0;
+	VUINT			vAllocs;
+	double			vTime;
+	int				vResult = 0;
+
+	cout << "===========================================" << endl;
+	cout << "= Polygon clipping						" << endl;
+	cout << "= Clips: " << nCount << endl;
+
+	srand(21);
+	for (int i = 0; i < 64; i++)
+	{
+		RandomPoly(&vPolys[i], 3 + i % 6);
+		vPlanes[i].Set(RandUnit(), vPolys[i].GetPoints()[i % 3]);
+		vPlanes[i].m_fD += Rand(-1.0f, 1.0f);
+		VVector vC(Rand(-5.0f, 5.0f), Rand(-5.0f, 5.0f), Rand(-5.0f, 5.0f));
+		VVector vE(Rand(1.0f, 4.0f), Rand(1.0f, 4.0f), Rand(1.0f, 4.0f));
+		vBoxes[i] = VAabb(vC - vE, vC + vE);
+	}
+
+	/* correctness, and the copy constructor */
+	for (int i = 0; i < 64; i++)
+	{
+		VPolygon vCopy(vPolys[i]);
+
+		if (vCopy.GetNumPoints() != vPolys[i].GetNumPoints() ||
+			vCopy.GetNumIndis() != vPolys[i].GetNumIndis())
+			vErrors++;
+		vErrors += CheckClip(vPolys[i], vPlanes[i], vFront, vBack);
+		vErrors += CheckBoxClip(vPolys[i], vBoxes[i]);
+	}
+	cout << "  errors: " << vErrors << endl;
+
+	/* heap traffic of the hot operations once the outputs exist */
+	vAllocs = HeapAllocs(vPolys, 64) + vFront.GetHeapAllocs() +
+				vBack.GetHeapAllocs() + vWork.GetHeapAllocs();
+	vStart = VClock::GetNanos();
+	for (unsigned int n = 0; n < nCount; n++)
+	{
+		VPolygon &vPoly = vPolys[n & 63];
+
+		vPoly.Clip(vPlanes[n & 63], &vFront, &vBack);
+		vWork = vPoly;
+		vWork.Clip(vBoxes[(n + 7) & 63]);
+		vWork.SwapFaces();
+		vResult += vWork.Cull(vBoxes[n & 63]);
+		vClips += 2;
+	}
+	vTime = VClock::ElapsedMs(vStart);
+	vAllocs = HeapAllocs(vPolys, 64) + vFront.GetHeapAllocs() +
+				vBack.GetHeapAllocs() + vWork.GetHeapAllocs() - vAllocs;
+	cout << "  heap allocations per clip: " << (double)vAllocs / vClips << "  "
+		<< vTime << "ms" << endl;
+
+	/* polygons too big to keep inline spill into the arena */
+	VPolygon vBig(&vArena), vBigFront(&vArena), vBigBack(&vArena);
+	RandomPoly(&vBig, 40);
+	vErrors = CheckClip(vBig, vPlanes[0], vBigFront, vBigBack);
+	vBig.Clip(vBoxes[0]);
+	vAllocs = vBig.GetHeapAllocs() + vBigFront.GetHeapAllocs() +
+				vBigBack.GetHeapAllocs();
+	for (int r = 0; r < 100; r++)
+	{
+		/* storage from before a reset must be dropped first */
+		vArena.Reset();
+		vBig.SetArena(&vArena);
+		vBigFront.SetArena(&vArena);
+		vBigBack.SetArena(&vArena);
+		RandomPoly(&vBig, 40);
+		vBig.Clip(VPlane(RandUnit(), (vBig.GetPoints()[0] + vBig.GetPoints()[20]) * 0.5f),
+					&vBigFront, &vBigBack);
+		vErrors += vBigFront.GetNumPoints() + vBigBack.GetNumPoints() < 40 ? 1 : 0;
+	}
+	vAllocs = vBig.GetHeapAllocs() + vBigFront.GetHeapAllocs() +
+				vBigBack.GetHeapAllocs() - vAllocs;
+
+	/* without an arena they go to the heap, and are counted */
+	VPolygon vHeap;
+	RandomPoly(&vHeap, 40);
+	if (vHeap.GetHeapAllocs() == 0)
+		vErrors++;
+	cout << "  40 point polygons: errors: " << vErrors << "  heap allocations: "
+		<< vAllocs << " (arena blocks: " << vArena.GetHeapAllocs() << ")" << endl << endl;
+
+	if (vResult < 0)
+		cout << vResult;
+	delete[] vPolys;
+	delete[] vPlanes;
+	delete[] vBoxes;
+}
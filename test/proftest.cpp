@@ -0,0 +1,197 @@
+#include "engtest2.h"
+#include <viper3d/Profiler.h>
+#include <viper3d/util/JobSystem.h>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static unsigned int nScopes = 1000000;
+static unsigned int nJobs = 64;
+
+static volatile float fSink = 0.0f;
+
+static void Leaf()
+{
+	PROFILE("leaf");
+	fSink = fSink + 1.0f;
+}
+
+static void Inner()
+{
+	PROFILE("inner");
+	Leaf();
+	Leaf();
+}
+
+static void Outer()
+{
+	PROFILE("outer");
+	Inner();
+	Leaf();
+}
+
+/*
+ * Runs on whichever worker picks it up; each gets its own tree.
+ */
+static void ProfiledJob(VJob *pJob)
+{
+	for (VUINT i = pJob->mFirst; i < pJob->mFirst + pJob->mCount; i++)
+	{
+		PROFILE("job");
+		Leaf();
+	}
+}
+
+/*
+ * Node of a tree with the given name under the given parent, or -1.
+ */
+static int Find(const std::vector<VProfileNode> &vNodes, int nParent, const char *pName)
+{
+	for (int n = vNodes[nParent].mChild; n >= 0; n = vNodes[n].mNext)
+		if (strcmp(VProfiler::GetName(vNodes[n].mId), pName) == 0)
+			return n;
+	return -1;
+}
+
+/*
+ * Times a substring turns up in a string.
+ */
+static VUINT Occurrences(const std::string &str, const char *pWhat)
+{
+	VUINT	vCount = 0;
+
+	for (size_t i = str.find(pWhat); i != std::string::npos; i = str.find(pWhat, i + 1))
+		vCount++;
+	return vCount;
+}
+
+/*
+ * Calls to a named sample on every thread, wherever it sits in the tree.
+ */
+static VUINT CountCalls(const char *pName)
+{
+	VUINT vCalls = 0;
+
+	for (VUINT t = 0; t < VProfiler::GetNumThreads(); t++)
+	{
+		const std::vector<VProfileNode> &vNodes = VProfiler::GetTree(t);
+		for (size_t n = 1; n < vNodes.size(); n++)
+			if (strcmp(VProfiler::GetName(vNodes[n].mId), pName) == 0)
+				vCalls += vNodes[n].mCalls;
+	}
+	return vCalls;
+}
+
+void TestProfiler()
+{
+	VUINT64				vStart;
+	VJobSystem			vJobs;
+	unsigned int		vErrors = 0;
+	int					vOuter, vInner, vLeaf;
+	double				vOn, vOff;
+
+	cout << "===========================================" << endl;
+	cout << "= Profiler								" << endl;
+	cout << "= Scopes: " << nScopes << "  Jobs: " << nJobs << endl;
+
+	/* nesting builds the same tree every frame */
+	VProfiler::EndFrame();
+	for (int f = 0; f < 3; f++)
+	{
+		Outer();
+		Outer();
+		Leaf();
+		VProfiler::EndFrame();
+	}
+	const std::vector<VProfileNode> &vTree = VProfiler::GetTree(0);
+	vOuter = Find(vTree, 0, "outer");
+	vInner = vOuter < 0 ? -1 : Find(vTree, vOuter, "inner");
+	vLeaf = vInner < 0 ? -1 : Find(vTree, vInner, "leaf");
+	if (vOuter < 0 || vInner < 0 || vLeaf < 0)
+		vErrors++;
+	else
+	{
+		if (vTree[vOuter].mCalls != 2 || vTree[vInner].mCalls != 2 ||
+				vTree[vLeaf].mCalls != 4)
+			vErrors++;
+		if (vTree[vLeaf].mDepth != 3 || vTree[vOuter].mFrames != 3)
+			vErrors++;
+		if (vTree[vOuter].mChildTicks > vTree[vOuter].mTicks)
+			vErrors++;
+		if (Find(vTree, vOuter, "leaf") < 0 || Find(vTree, 0, "leaf") < 0)
+			vErrors++;
+	}
+	cout << "  tree errors:      " << vErrors << endl;
+
+	/* every worker's scopes are counted, none lost */
+	vErrors = 0;
+	vJobs.Init(4);
+	vJobs.ParallelFor(ProfiledJob, NULL, nJobs * 16, 16);
+	VProfiler::EndFrame();
+	if (CountCalls("job") != nJobs * 16)
+		vErrors++;
+	for (VUINT t = 0; t < VProfiler::GetNumThreads(); t++)
+		vErrors += VProfiler::GetDropped(t);
+	vJobs.Shutdown();
+	cout << "  thread errors:    " << vErrors << " (" << VProfiler::GetNumThreads()
+		<< " threads)" << endl;
+
+	/* a capture holds exactly the frames asked for, every scope paired */
+	vErrors = 0;
+	std::ostringstream	vTrace;
+	if (VProfiler::WriteTrace(vTrace))
+		vErrors++;
+	VProfiler::StartCapture(2);
+	Outer();						/* before the capture starts */
+	VProfiler::EndFrame();
+	for (int f = 0; f < 3; f++)
+	{
+		Outer();
+		VProfiler::EndFrame();
+	}
+	if (VProfiler::IsCapturing() || !VProfiler::WriteTrace(vTrace))
+		vErrors++;
+	std::string vJson = vTrace.str();
+	if (Occurrences(vJson, "\"ph\":\"B\"") != 2 * 5 ||
+			Occurrences(vJson, "\"ph\":\"E\"") != 2 * 5)
+		vErrors++;
+	if (Occurrences(vJson, "\"name\":\"outer\",\"ph\":\"B\"") != 2)
+		vErrors++;
+	if (Occurrences(vJson, "\"ph\":\"X\"") != 2)
+		vErrors++;
+	if (vJson.find("{\"displayTimeUnit\"") != 0 || vJson.find("]") == std::string::npos)
+		vErrors++;
+	cout << "  trace errors:     " << vErrors << " (" << vJson.size() << " bytes)" << endl;
+
+	/* the cost of one scope, drained every 4096 so nothing is dropped */
+	vStart = VClock::GetNanos();
+	for (unsigned int i = 0; i < nScopes; i++)
+	{
+		Leaf();
+		if ((i & 4095) == 4095)
+			VProfiler::EndFrame();
+	}
+	vOn = VClock::ElapsedMs(vStart);
+
+	VProfiler::SetEnabled(false);
+	vStart = VClock::GetNanos();
+	for (unsigned int i = 0; i < nScopes; i++)
+	{
+		Leaf();
+		if ((i & 4095) == 4095)
+			VProfiler::EndFrame();
+	}
+	vOff = VClock::ElapsedMs(vStart);
+	VProfiler::SetEnabled(true);
+	Outer();
+	VProfiler::EndFrame();
+
+	cout << "  enabled:          " << vOn << "ms (" << (vOn * 1000000.0 / nScopes)
+		<< " ns/scope)" << endl;
+	cout << "  disabled:         " << vOff << "ms (" << (vOff * 1000000.0 / nScopes)
+		<< " ns/scope)" << endl;
+
+	VProfiler::Output();
+	cout << endl;
+}
@@ -0,0 +1,228 @@
+#include "engtest2.h"
+#include <viper3d/math/QuaternionBatch.h>
+#include <cstdlib>
+
+static unsigned int nCount = 10003;		/* not a multiple of 8, so the tails run */
+static unsigned int nIters = 100;
+
+static float Random()
+{
+	return rand() / (float)RAND_MAX * 2.0f - 1.0f;
+}
+
+static bool Close(float f1, float f2, float fTol)
+{
+	return VMath::Abs(f1 - f2) <= fTol;
+}
+
+static bool Close(const VQuaternion& q1, const VQuaternion& q2, float fTol)
+{
+	return Close(q1.x, q2.x, fTol) && Close(q1.y, q2.y, fTol) &&
+		Close(q1.z, q2.z, fTol) && Close(q1.w, q2.w, fTol);
+}
+
+static bool Close(const VVector& v1, const VVector& v2, float fTol)
+{
+	return Close(v1.x, v2.x, fTol) && Close(v1.y, v2.y, fTol) && Close(v1.z, v2.z, fTol);
+}
+
+/*
+ * Angle between the rotations two unit quaternions stand for.
+ */
+static float Angle(const VQuaternion& q1, const VQuaternion& q2)
+{
+	float fDot = VMath::Abs(q1.x*q2.x + q1.y*q2.y + q1.z*q2.z + q1.w*q2.w);
+
+	return 2.0f * VMath::ACos(fDot > 1.0f ? 1.0f : fDot);
+}
+
+/*
+ * The rotation part of a transform against ToRotationMatrix(), and the
+ * translation against vPos.
+ */
+static bool Matches(const VAffine& xf, const VQuaternion& q, const VVector& vPos)
+{
+	VMatrix vRot;
+
+	q.ToRotationMatrix(vRot);
+	for (int r = 0; r < 3; r++)
+		for (int c = 0; c < 3; c++)
+			if (!Close(xf[r][c], vRot[r][c], 1e-5f))
+				return false;
+	return Close(xf.GetTranslation(), vPos, 0.0f);
+}
+
+static unsigned int CheckQuaternionBatch(const VQuaternion *pQ0, const VQuaternion *pQ1,
+										const VVector *pVecs, VQuaternion *pOut,
+										VVector *pVecOut, VAffine *pXfs)
+{
+	unsigned int		vErrors = 0;
+	VQuaternion			vRef;
+	VMatrix				vRot;
+	VQuaternionBatch	vA(pQ0, nCount), vB(pQ1, nCount), vC;
+	VVectorBatch		vVecs(pVecs, nCount);
+	static const float	vTs[3] = { 0.0f, 0.3f, 0.75f };
+
+	/* multiply against operator*, and composing against the matrices */
+	vC.Multiply(vA, vB);
+	vC.ToQuaternions(pOut);
+	vC.ToAffines(pXfs);
+	for (unsigned int i = 0; i < nCount; i++)
+	{
+		if (!Close(pOut[i], pQ0[i] * pQ1[i], 1e-5f))
+			vErrors++;
+		VMatrix vR0, vR1;
+		pQ0[i].ToRotationMatrix(vR0);
+		pQ1[i].ToRotationMatrix(vR1);
+		vRot = vR0 * vR1;
+		for (int r = 0; r < 3; r++)
+			for (int c = 0; c < 3; c++)
+				if (!Close(pXfs[i][r][c], vRot[r][c], 1e-5f))
+					vErrors++;
+	}
+	vC = vA;
+	vC.Multiply(vB);
+	for (unsigned int i = 0; i < nCount; i++)
+		if (!Close(vC.Get(i), pOut[i], 0.0f))
+			vErrors++;
+
+	/* rotate against the rotation matrix on column vectors */
+	vA.Rotate(vVecs);
+	vVecs.ToVectors(pVecOut);
+	for (unsigned int i = 0; i < nCount; i++)
+	{
+		pQ0[i].ToRotationMatrix(vRot);
+		if (!Close(pVecOut[i], vRot * pVecs[i], 1e-4f) ||
+				!Close(pVecOut[i], pQ0[i] * pVecs[i], 1e-4f))
+			vErrors++;
+	}
+
+	/* to transforms, with and without positions */
+	vVecs.FromVectors(pVecs, nCount);
+	vA.ToAffines(pXfs, vVecs);
+	for (unsigned int i = 0; i < nCount; i++)
+		if (!Matches(pXfs[i], pQ0[i], pVecs[i]))
+			vErrors++;
+	vA.ToAffines(pXfs);
+	for (unsigned int i = 0; i < nCount; i++)
+		if (!Matches(pXfs[i], pQ0[i], VVector()))
+			vErrors++;
+
+	/* normalize, on scaled copies */
+	for (unsigned int i = 0; i < nCount; i++)
+		vC.Set(i, pQ0[i] * (0.5f + (i % 7)));
+	vC.Set(0, VQuaternion(0.0f, 0.0f, 0.0f, 0.0f));
+	vC.Normalize();
+	for (unsigned int i = 1; i < nCount; i++)
+		if (!Close(vC.Get(i), pQ0[i], 1e-5f))
+			vErrors++;
+	if (!Close(vC.Get(0), VQuaternion(0.0f, 0.0f, 0.0f, 0.0f), 0.0f))
+		vErrors++;
+
+	/* blends against the scalar ones */
+	for (int t = 0; t < 3; t++)
+	{
+		vC.Nlerp(vA, vB, vTs[t]);
+		for (unsigned int i = 0; i < nCount; i++)
+		{
+			vRef.Nlerp(pQ0[i], pQ1[i], vTs[t]);
+			if (!Close(vC.Get(i), vRef, 1e-5f))
+				vErrors++;
+		}
+
+		vC.Slerp(vA, vB, vTs[t]);
+		for (unsigned int i = 0; i < nCount; i++)
+		{
+			vRef.Slerp(pQ0[i], pQ1[i], vTs[t]);
+			if (!Close(vC.Get(i), vRef, 1e-5f))
+				vErrors++;
+		}
+
+		vC.Slerp(vA, vB, vTs[t], true);
+		for (unsigned int i = 0; i < nCount; i++)
+		{
+			vRef.Slerp(pQ0[i], pQ1[i], vTs[t]);
+			if (Angle(vC.Get(i), vRef) > 3e-3f)
+				vErrors++;
+		}
+	}
+
+	/* in place, with the output as an operand */
+	vC = vA;
+	vC.Slerp(vC, vB, 1.0f);
+	for (unsigned int i = 0; i < nCount; i++)
+		if (Angle(vC.Get(i), pQ1[i]) > 1e-3f)
+			vErrors++;
+
+	return vErrors;
+}
+
+void TestQuaternionBatch()
+{
+	VUINT64				vStart;
+	VQuaternion			*vQ0 = new VQuaternion[nCount];
+	VQuaternion			*vQ1 = new VQuaternion[nCount];
+	VQuaternion			*vOut = new VQuaternion[nCount];
+	VVector				*vVecs = new VVector[nCount];
+	VVector				*vVecOut = new VVector[nCount];
+	VAffine				*vXfs = new VAffine[nCount];
+	unsigned int		vErrors = 0;
+
+	cout << "===========================================" << endl;
+	cout << "= Quaternion batch testing					" << endl;
+	cout << "= Count: " << nCount << "  Iterations: " << nIters << endl;
+
+	srand(3);
+	for (unsigned int i = 0; i < nCount; i++)
+	{
+		VVector vAxis(Random(), Random(), Random());
+		vAxis.Normalize();
+		vQ0[i].FromAngleAxis(Random() * VMath::PI, vAxis);
+		vAxis.SetValues(Random(), Random(), Random(), 0.0f);
+		vAxis.Normalize();
+		vQ1[i].FromAngleAxis(Random() * VMath::PI, vAxis);
+		vVecs[i].SetValues(Random() * 10.0f, Random() * 10.0f, Random() * 10.0f, 1.0f);
+	}
+	/* nearly equal pairs, and pairs on opposite hemispheres */
+	for (unsigned int i = 0; i < nCount; i += 5)
+		vQ1[i] = vQ0[i] + VQuaternion(0.0f, 1e-4f, 0.0f, 0.0f);
+	for (unsigned int i = 1; i < nCount; i += 5)
+		vQ1[i] = vQ0[i] * -1.0f;
+	for (unsigned int i = 0; i < nCount; i++)
+		vQ1[i].Normalize();
+
+	for (int vTier = SIMD_SCALAR; vTier <= VCPU::GetDetectedTier(); vTier++)
+	{
+		VCPU::SetTier((VSimdTier)vTier);
+		vErrors = CheckQuaternionBatch(vQ0, vQ1, vVecs, vOut, vVecOut, vXfs);
+		cout << "  " << VCPU::GetTierName((VSimdTier)vTier) << " errors: "
+			<< vErrors << endl;
+	}
+	VCPU::SetTier(VCPU::GetDetectedTier());
+
+	/* timing, one quaternion at a time versus the batch */
+	VQuaternionBatch vA(vQ0, nCount), vB(vQ1, nCount), vC(nCount);
+
+	vStart = VClock::GetNanos();
+	for (unsigned int n = 0; n < nIters; n++)
+		for (unsigned int i = 0; i < nCount; i++)
+			vOut[i].Slerp(vQ0[i], vQ1[i], 0.3f);
+	cout << "  per VQuaternion: " << VClock::ElapsedMs(vStart) << "ms" << endl;
+
+	vStart = VClock::GetNanos();
+	for (unsigned int n = 0; n < nIters; n++)
+		vC.Slerp(vA, vB, 0.3f);
+	cout << "  Slerp:           " << VClock::ElapsedMs(vStart) << "ms" << endl;
+
+	vStart = VClock::GetNanos();
+	for (unsigned int n = 0; n < nIters; n++)
+		vC.Slerp(vA, vB, 0.3f, true);
+	cout << "  Slerp (fast):    " << VClock::ElapsedMs(vStart) << "ms" << endl << endl;
+
+	delete[] vQ0;
+	delete[] vQ1;
+	delete[] vOut;
+	delete[] vVecs;
+	delete[] vVecOut;
+	delete[] vXfs;
+}
@@ -0,0 +1,246 @@
+#include "engtest2.h"
+#include <viper3d/RenderQueue.h>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+static unsigned int nCount = 100000;
+static unsigned int nDraws = 4000;
+
+/*
+ * Render system that only records what DrawQueue() asks of it.
+ */
+class VRecordRender : public VRenderSystem
+{
+public:
+	VRecordRender() : mStates(0), mDraws(0), mRanges(0), mWorlds(0) {}
+
+	bool		Init() { return true; }
+	void		Shutdown() {}
+	VWindow*	CreateWin(VWindowOpts * /*pOpts*/) { return NULL; }
+	void		DestroyWin(VWindow * /*pWin*/) {}
+	bool		Render(VWindow * /*pWin*/, VCamera * /*pCamera*/,
+						VRenderQueue * /*pQueue*/) { return true; }
+	VMeshHandle	CreateMesh(const VMeshDesc& /*desc*/, const void * /*pVerts*/,
+						const VUINT * /*pIndis*/) { return 0; }
+	bool		UpdateMesh(VMeshHandle /*hMesh*/, const void * /*pVerts*/,
+						VUINT /*nNumVerts*/, const VUINT * /*pIndis*/,
+						VUINT /*nNumIndis*/) { return false; }
+	void		DestroyMesh(VMeshHandle /*hMesh*/) {}
+	void		SetWorldMatrix(const VMatrix& /*mat*/) { mWorlds++; }
+	bool		DrawMesh(VMeshHandle /*hMesh*/) { mDraws++; return true; }
+	bool		DrawMeshRanges(VMeshHandle hMesh, const VUINT *pFirsts,
+						const VUINT * /*pCounts*/, VUINT nRanges)
+	{
+		mDraws++;
+		for (VUINT r = 0; r < nRanges; r++)
+		{
+			mRanges++;
+			mDrawn.push_back(((VUINT64)hMesh << 32) | pFirsts[r]);
+		}
+		return true;
+	}
+	void		SetState(VUINT /*nMaterial*/, VUINT nTexture)
+	{
+		mStates++;
+		mTextures.push_back(nTexture);
+	}
+
+	VUINT					mStates;
+	VUINT					mDraws;
+	VUINT					mRanges;
+	VUINT					mWorlds;
+	std::vector<VUINT64>	mDrawn;		/**< mesh and first of every range */
+	std::vector<VUINT>		mTextures;	/**< texture of every SetState() */
+};
+
+static VUINT64 RandKey()
+{
+	/* few distinct high bytes, so some radix passes get skipped */
+	return ((VUINT64)(rand() & 3) << 60) | ((VUINT64)rand() << 20) | (rand() & 0xFFFFF);
+}
+
+/*
+ * State changes and draws a queue needs in a given order: a change for
+ * every new material or texture, a draw for every new mesh or
+ * transform as well.
+ */
+static void CountRuns(const VRenderQueue& /*queue*/, const std::vector<VRenderItem>& vItems,
+						VUINT *pStates, VUINT *pDraws)
+{
+	*pStates = *pDraws = 0;
+	for (VUINT i = 0; i < vItems.size(); i++)
+	{
+		const VRenderItem &vA = vItems[i];
+		bool bState = i == 0 || vA.mMaterial != vItems[i - 1].mMaterial ||
+			vA.mTexture != vItems[i - 1].mTexture;
+
+		if (bState)
+			(*pStates)++;
+		if (bState || vA.mMesh != vItems[i - 1].mMesh || vA.mWorld != vItems[i - 1].mWorld)
+			(*pDraws)++;
+	}
+}
+
+void TestRenderQueue()
+{
+	VUINT64						vStart;
+	VRenderQueue				vQueue, vWide;
+	VRecordRender				vRender;
+	std::vector<VUINT64>		vKeys;
+	std::vector<VRenderItem>	vPushed, vSorted;
+	std::vector<VUINT64>		vWant, vDrawn;
+	VMatrix						vWorld;
+	unsigned int				vErrors = 0;
+	VUINT						vStates, vDrawCount;
+	double						vRadixMs, vStdMs;
+
+	cout << "===========================================" << endl;
+	cout << "= Render queue							" << endl;
+	cout << "= Keys: " << nCount << "  Draws: " << nDraws << endl;
+
+	/* keys give back what went in, in both layouts */
+	srand(23);
+	vQueue.SetBackToFront(3, true);
+	for (int i = 0; i < 1000; i++)
+	{
+		VUINT vLayer = rand() % VQUEUE_LAYERS;
+		VUINT vMaterial = rand() % (1 << VQUEUE_MATERIAL_BITS);
+		VUINT vTexture = rand() % (1 << VQUEUE_TEXTURE_BITS);
+		float fNear = Rand(0.0f, 0.5f), fFar = fNear + Rand(0.01f, 0.5f);
+		VUINT64 vKey = vQueue.MakeKey(vLayer, vMaterial, vTexture, rand(), fNear);
+		VUINT64 vFarKey = vQueue.MakeKey(vLayer, vMaterial, vTexture, rand(), fFar);
+
+		if (vQueue.GetLayer(vKey) != vLayer || vQueue.GetMaterial(vKey) != vMaterial ||
+			vQueue.GetTexture(vKey) != vTexture)
+			vErrors++;
+		/* near to far, except in the back to front layer */
+		if (vLayer == 3 && (vFarKey >> 36) >= (vKey >> 36))
+			vErrors++;
+	}
+	vQueue.SetBackToFront(3, false);
+	cout << "  key errors: " << vErrors << endl;
+
+	/* the sort is stable and agrees with std::sort */
+	vErrors = 0;
+	vKeys.resize(nCount);
+	for (VUINT i = 0; i < nCount; i++)
+	{
+		vKeys[i] = RandKey();
+		vWant.push_back((vKeys[i] & ~0xFFFFFULL) | i);
+	}
+	for (VUINT i = 0; i < nCount; i++)
+		vQueue.Push(vKeys[i] & ~0xFFFFFULL, 0, 0, i);
+	vStart = VClock::GetNanos();
+	vQueue.Sort();
+	vRadixMs = VClock::ElapsedMs(vStart);
+	vStart = VClock::GetNanos();
+	std::sort(vWant.begin(), vWant.end());
+	vStdMs = VClock::ElapsedMs(vStart);
+	for (VUINT i = 0; i < nCount; i++)
+	{
+		const VRenderItem &vItem = vQueue.GetItem(i);
+		if (((vItem.mKey & ~0xFFFFFULL) | vItem.mMesh) != vWant[i])
+			vErrors++;
+	}
+	cout << "  sort errors: " << vErrors << "  radix " << vRadixMs << "ms, std::sort "
+		<< vStdMs << "ms" << endl;
+
+	/*
+	 * A frame: a static level in one mesh cut into chunks, props that
+	 * share a few meshes, and a transparent layer on top.
+	 */
+	vErrors = 0;
+	vQueue.Clear();
+	vQueue.SetBackToFront(2, true);
+	vQueue.SetEye(VVector(0.0f, 0.0f, 0.0f), 1000.0f);
+	for (VUINT i = 0; i < nDraws; i++)
+	{
+		VVector vPos(Rand(-500.0f, 500.0f), Rand(-500.0f, 500.0f), Rand(-500.0f, 500.0f));
+		float fDepth = vQueue.GetDepth(vPos);
+		VRenderItem vItem;
+
+		/* every prop has its own transform, so only chunks can merge */
+		vItem.mFirst = 0;
+		vItem.mCount = 0;
+		vItem.mWorld = i + 1;
+		vItem.mMaterial = rand() % 8;
+		vItem.mTexture = rand() % 4;
+		switch (rand() % 3)
+		{
+		case 0:
+			vItem.mMesh = 1;
+			vItem.mKey = vQueue.MakeKey(0, vItem.mMaterial, vItem.mTexture, 1, 0.0f);
+			vItem.mFirst = (rand() % 1000) * 96;
+			vItem.mCount = 96;
+			vItem.mWorld = 0;
+			break;
+		case 1:
+			vItem.mMesh = 2 + i % 20;
+			vItem.mKey = vQueue.MakeKey(1, vItem.mMaterial, vItem.mTexture, vItem.mMesh, fDepth);
+			break;
+		default:
+			vItem.mMesh = 30;
+			vItem.mTexture = 0;
+			vItem.mKey = vQueue.MakeKey(2, vItem.mMaterial, 0, vItem.mMesh, fDepth);
+			break;
+		}
+		vWorld = VMatrix::MATRIX_IDENTITY;
+		vWorld.SetTranslation(vPos);
+		vQueue.Push(vItem.mKey, vItem.mMaterial, vItem.mTexture, vItem.mMesh,
+					vItem.mWorld ? &vWorld : NULL, vItem.mFirst, vItem.mCount);
+		vPushed.push_back(vItem);
+	}
+
+	vStart = VClock::GetNanos();
+	vRender.DrawQueue(&vQueue);
+
+	for (VUINT i = 0; i < vQueue.GetCount(); i++)
+		vSorted.push_back(vQueue.GetItem(i));
+	CountRuns(vQueue, vSorted, &vStates, &vDrawCount);
+	if (vQueue.GetStats().mItems != nDraws || vRender.mRanges != nDraws ||
+		vQueue.GetStats().mStateChanges != vStates || vRender.mStates != vStates ||
+		vQueue.GetStats().mDraws != vDrawCount || vRender.mDraws != vDrawCount ||
+		vQueue.GetStats().mMerged != nDraws - vDrawCount)
+		vErrors++;
+
+	/* every item drawn once, and the transparent layer far to near */
+	for (VUINT i = 0; i < nDraws; i++)
+		vDrawn.push_back(((VUINT64)vSorted[i].mMesh << 32) | vSorted[i].mFirst);
+	if (vRender.mDrawn != vDrawn)
+		vErrors++;
+	for (VUINT i = 1; i < nDraws; i++)
+	{
+		if (vQueue.GetLayer(vSorted[i].mKey) != 2 || vQueue.GetLayer(vSorted[i - 1].mKey) != 2)
+			continue;
+		const VMatrix &vA = vQueue.GetWorld(vSorted[i - 1].mWorld);
+		const VMatrix &vB = vQueue.GetWorld(vSorted[i].mWorld);
+		if (vQueue.GetDepth(VVector(vB[0][3], vB[1][3], vB[2][3])) >
+			vQueue.GetDepth(VVector(vA[0][3], vA[1][3], vA[2][3])) + 1e-6f)
+			vErrors++;
+	}
+
+	/* ids too wide for the key still reach SetState() whole, and apart */
+	vRender.mStates = vRender.mDraws = 0;
+	vRender.mTextures.clear();
+	for (VUINT t = 1; t < 3; t++)
+	{
+		VUINT vTexture = 1 + (t << VQUEUE_TEXTURE_BITS);
+
+		vWide.Push(vWide.MakeKey(0, 0, vTexture, 1, 0.0f), 0, vTexture, 1);
+	}
+	vRender.DrawQueue(&vWide);
+	if (vRender.mStates != 2 || vRender.mDraws != 2 || vRender.mTextures.size() != 2 ||
+		vRender.mTextures[0] == vRender.mTextures[1] ||
+		(vRender.mTextures[0] >> VQUEUE_TEXTURE_BITS) + (vRender.mTextures[1] >> VQUEUE_TEXTURE_BITS) != 3)
+		vErrors++;
+
+	CountRuns(vQueue, vPushed, &vStates, &vDrawCount);
+	cout << "  draw errors: " << vErrors << "  "
+		<< VClock::ElapsedMs(vStart)
+		<< "ms" << endl;
+	cout << "  unsorted: " << vStates << " state changes, " << vDrawCount << " draws" << endl;
+	cout << "  sorted:   " << vQueue.GetStats().mStateChanges << " state changes, "
+		<< vQueue.GetStats().mDraws << " draws (" << vQueue.GetStats().mMerged
+		<< " merged)" << endl << endl;
+}
@@ -0,0 +1,120 @@
+#include "engtest2.h"
+#include <viper3d/RenderSystem.h>
+#include <viper3d/Camera.h>
+#include <cmath>
+#include <vector>
+
+static unsigned int nFrames = 300;
+
+/* position and colour, VERTEX_POSITION | VERTEX_COLOR */
+struct TestVertex
+{
+	float	mPos[3];
+	VBYTE	mColor[4];
+};
+
+/*
+ * A ring of nCount triangles around the origin, turned by fAngle, so a
+ * stream mesh has new contents every frame.
+ */
+static void MakeRing(std::vector<TestVertex>& vVerts, VUINT nCount, float fAngle)
+{
+	vVerts.resize(nCount * 3);
+	for (VUINT i = 0; i < nCount; i++)
+	{
+		float fA = fAngle + 6.2831853f * i / nCount;
+		float fB = fA + 3.1415926f / nCount;
+
+		for (int c = 0; c < 3; c++)
+		{
+			TestVertex &vV = vVerts[i * 3 + c];
+			float fR = c == 0 ? 0.0f : 50.0f;
+			float fT = c == 2 ? fB : fA;
+
+			vV.mPos[0] = fR * cosf(fT);
+			vV.mPos[1] = fR * sinf(fT);
+			vV.mPos[2] = -100.0f;
+			vV.mColor[0] = (VBYTE)(i * 37);
+			vV.mColor[1] = (VBYTE)(c * 100);
+			vV.mColor[2] = 200;
+			vV.mColor[3] = 255;
+		}
+	}
+}
+
+/*
+ * Runs the mesh API against a live render system: handles, updates
+ * that grow and shrink a stream mesh, and a few hundred frames of
+ * drawing.  Where there is no display, run engtest2 --offscreen, or
+ * engtest2 --meshes under Xvfb with Mesa.
+ */
+void TestMeshes(VRenderSystem *pRender, VWindow *pWin, VCamera *pCamera)
+{
+	VUINT64					vStart;
+	std::vector<TestVertex>	vVerts;
+	VUINT					vQuad[6] = { 0, 1, 2, 0, 2, 3 };
+	VMeshDesc				vDesc;
+	VMeshHandle				vStream, vQuadMesh, vHandle;
+	unsigned int			vErrors = 0;
+
+	cout << "===========================================" << endl;
+	cout << "= Meshes								" << endl;
+	cout << "= Frames: " << nFrames << endl;
+
+	if (pRender->GetVertexSize(VERTEX_POSITION | VERTEX_COLOR) != sizeof(TestVertex) ||
+		pRender->GetVertexSize(VERTEX_POSITION | VERTEX_NORMAL | VERTEX_COLOR |
+								VERTEX_TEXCOORD) != 36)
+		vErrors++;
+
+	/* a stream mesh created empty, and an indexed static one */
+	vDesc.mFormat = VERTEX_POSITION | VERTEX_COLOR;
+	vDesc.mUsage = BUFFER_STREAM;
+	vDesc.mNumVerts = 64 * 3;
+	vStream = pRender->CreateMesh(vDesc, NULL, NULL);
+
+	MakeRing(vVerts, 2, 0.0f);
+	vVerts[3] = vVerts[1];
+	vDesc.mUsage = BUFFER_STATIC;
+	vDesc.mNumVerts = 4;
+	vDesc.mNumIndis = 6;
+	vQuadMesh = pRender->CreateMesh(vDesc, &vVerts[0], vQuad);
+	if (vStream == 0 || vQuadMesh == 0 || vStream == vQuadMesh)
+		vErrors++;
+
+	/* destroyed handles stop working and are handed out again */
+	vHandle = pRender->CreateMesh(vDesc, &vVerts[0], vQuad);
+	pRender->DestroyMesh(vHandle);
+	if (pRender->DrawMesh(vHandle) || pRender->UpdateMesh(vHandle, &vVerts[0], 4))
+		vErrors++;
+	if (pRender->CreateMesh(vDesc, &vVerts[0], vQuad) != vHandle)
+		vErrors++;
+	pRender->DestroyMesh(vHandle);
+	if (pRender->DrawMesh(0))
+		vErrors++;
+
+	vStart = VClock::GetNanos();
+	for (unsigned int f = 0; f < nFrames; f++)
+	{
+		/* between 1 and 256 triangles, past what the mesh was created with */
+		MakeRing(vVerts, 1 + (f * 7) % 256, f * 0.02f);
+		if (!pRender->UpdateMesh(vStream, &vVerts[0], (VUINT)vVerts.size()))
+			vErrors++;
+		pRender->Render(pWin, pCamera);
+
+		/* these land after the swap, so are drawn but never shown */
+		VMatrix vWorld = VMatrix::MATRIX_IDENTITY;
+		pRender->SetWorldMatrix(vWorld);
+		if (!pRender->DrawMesh(vStream))
+			vErrors++;
+		vWorld.SetTranslation(VVector(0.0f, 0.0f, 10.0f));
+		pRender->SetWorldMatrix(vWorld);
+		if (!pRender->DrawMesh(vQuadMesh))
+			vErrors++;
+	}
+	cout << "  errors: " << vErrors << "  "
+		<< VClock::ElapsedMs(vStart)
+		<< "ms" << endl << endl;
+
+	pRender->DestroyMesh(vStream);
+	pRender->DestroyMesh(vQuadMesh);
+}
@@ -0,0 +1,165 @@
+#include "engtest2.h"
+#include <viper3d/Movable.h>
+#include <cstdlib>
+#include <vector>
+
+static unsigned int nCount = 20000;
+static unsigned int nIters = 20;
+
+static bool Close(const VAffine& m1, const VAffine& m2)
+{
+	for (int r = 0; r < 3; r++)
+		for (int c = 0; c < 4; c++)
+			if (VMath::Abs(m1[r][c] - m2[r][c]) > 1e-3f * (1.0f + VMath::Abs(m2[r][c])))
+				return false;
+	return true;
+}
+
+/*
+ * World transform the slow way, by walking up the parents.
+ */
+static VAffine WorldOf(VNode *pNode)
+{
+	VAffine vLocal;
+
+	pNode->GetLocalTransform(vLocal);
+	if (pNode->GetParent() == NULL)
+		return vLocal;
+	return WorldOf(pNode->GetParent()) * vLocal;
+}
+
+static unsigned int CheckList(VNode *pRoot, VNode **pExpect, const int *pParents,
+								const VUINT *pEnds, VUINT nNum)
+{
+	unsigned int vErrors = 0;
+	const VNodeList *vList = pRoot->GetNodeList();
+
+	if (vList->mNodes.size() != nNum)
+		return 1;
+	for (VUINT i = 0; i < nNum; i++)
+		if (vList->mNodes[i] != pExpect[i] || vList->mParent[i] != pParents[i] ||
+			vList->mEnd[i] != pEnds[i])
+			vErrors++;
+	return vErrors;
+}
+
+void TestSceneGraph()
+{
+	VUINT64					vStart;
+	unsigned int			vErrors = 0;
+	std::vector<VMovable*>	vNodes;
+	VMovable				*vMover;
+
+	cout << "===========================================" << endl;
+	cout << "= Scene graph								" << endl;
+	cout << "= Count: " << nCount << "  Iterations: " << nIters << endl;
+
+	/* list layout follows attach/detach */
+	{
+		VMovable *vRoot = new VMovable();
+		VMovable *vA = new VMovable();
+		VMovable *vB = new VMovable();
+		VMovable *vC = new VMovable();
+		VMovable *vD = new VMovable();
+
+		vRoot->Attach(vA);
+		vA->Attach(vB);
+		vA->Attach(vC);
+		vRoot->Attach(vD);
+
+		VNode *vOrder1[] = { vRoot, vA, vB, vC, vD };
+		int vParents1[] = { -1, 0, 1, 1, 0 };
+		VUINT vEnds1[] = { 5, 4, 3, 4, 5 };
+		vErrors += CheckList(vRoot, vOrder1, vParents1, vEnds1, 5);
+		if (vRoot->CountNodes() != 5 || vB->GetNodeList() != vRoot->GetNodeList())
+			vErrors++;
+
+		vA->Detach();
+		VNode *vOrder2[] = { vRoot, vD };
+		int vParents2[] = { -1, 0 };
+		VUINT vEnds2[] = { 2, 2 };
+		vErrors += CheckList(vRoot, vOrder2, vParents2, vEnds2, 2);
+		VNode *vOrder3[] = { vA, vB, vC };
+		int vParents3[] = { -1, 0, 0 };
+		VUINT vEnds3[] = { 3, 2, 3 };
+		vErrors += CheckList(vA, vOrder3, vParents3, vEnds3, 3);
+
+		vD->Attach(vA);
+		VNode *vOrder4[] = { vRoot, vD, vA, vB, vC };
+		int vParents4[] = { -1, 0, 1, 2, 2 };
+		VUINT vEnds4[] = { 5, 5, 5, 4, 5 };
+		vErrors += CheckList(vRoot, vOrder4, vParents4, vEnds4, 5);
+
+		/* children inherit their parents' transforms */
+		vD->SetPosition(VVector(1.0f, 0.0f, 0.0f));
+		vD->RotateYaw(90.0f);
+		vB->SetPosition(VVector(0.0f, 0.0f, -2.0f));
+		vRoot->UpdateTransforms();
+		if (!Close(vRoot->GetNodeList()->mWorld[3], WorldOf(vB)))
+			vErrors++;
+
+		delete vRoot;
+	}
+	cout << "  layout errors:    " << vErrors << endl;
+
+	/* random tree against the recursive reference */
+	srand(5);
+	vNodes.push_back(new VMovable());
+	for (unsigned int i = 1; i < nCount; i++)
+	{
+		vMover = new VMovable();
+		vMover->SetPosition(VVector(Rand(-1.0f, 1.0f), Rand(-1.0f, 1.0f),
+									Rand(-1.0f, 1.0f)));
+		vMover->RotateYaw(Rand(-30.0f, 30.0f));
+		vNodes[rand() % vNodes.size()]->Attach(vMover);
+		vNodes.push_back(vMover);
+	}
+
+	vErrors = 0;
+	vNodes[0]->UpdateTransforms();
+	const VNodeList *vList = vNodes[0]->GetNodeList();
+	for (unsigned int i = 0; i < nCount; i += 97)
+		if (!Close(vList->mWorld[i], WorldOf(vList->mNodes[i])))
+			vErrors++;
+	cout << "  transform errors: " << vErrors << endl;
+
+	vStart = VClock::GetNanos();
+	for (unsigned int n = 0; n < nIters; n++)
+		for (unsigned int i = 0; i < nCount; i++)
+			WorldOf(vNodes[i]);
+	cout << "  per node, recursive:  " << VClock::ElapsedMs(vStart) << "ms" << endl;
+
+	/* only moved subtrees are recomputed, but all of them are */
+	vErrors = 0;
+	for (unsigned int i = 0; i < 50; i++)
+	{
+		vMover = vNodes[1 + rand() % (nCount - 1)];
+		vMover->Move(VVector(Rand(-1.0f, 1.0f), 0.0f, Rand(-1.0f, 1.0f)));
+		vMover->RotatePitch(Rand(-30.0f, 30.0f));
+	}
+	if (!Close(vMover->GetWorldTransform(), WorldOf(vMover)))
+		vErrors++;
+	for (unsigned int i = 0; i < nCount; i += 13)
+		if (!Close(vList->mWorld[i], WorldOf(vList->mNodes[i])))
+			vErrors++;
+	cout << "  dirty errors:     " << vErrors << endl;
+
+	vStart = VClock::GetNanos();
+	for (unsigned int n = 0; n < nIters; n++)
+	{
+		vNodes[0]->RotateYaw(1.0f);
+		vNodes[0]->UpdateTransforms();
+	}
+	cout << "  node list, all moved: " << VClock::ElapsedMs(vStart) << "ms" << endl;
+
+	vStart = VClock::GetNanos();
+	for (unsigned int n = 0; n < nIters; n++)
+	{
+		for (unsigned int i = 0; i < 100; i++)
+			vNodes[1 + rand() % (nCount - 1)]->RotateYaw(1.0f);
+		vNodes[0]->UpdateTransforms();
+	}
+	cout << "  node list, 100 moved: " << VClock::ElapsedMs(vStart) << "ms" << endl << endl;
+
+	delete vNodes[0];
+}
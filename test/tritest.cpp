@@ -0,0 +1,285 @@
+#include "engtest2.h"
+#include <viper3d/math/TriangleBvh.h>
+#include <cstdlib>
+#include <vector>
+
+static unsigned int nCount = 20000;		/* triangles */
+static unsigned int nRays = 2003;		/* not a multiple of 8, so one packet is short */
+static unsigned int nIters = 20;
+
+static VRay RandomRay()
+{
+	VVector vDir(Rand(-1.0f, 1.0f), Rand(-1.0f, 1.0f), Rand(-1.0f, 1.0f));
+	vDir.Normalize();
+	return VRay(VVector(Rand(-120.0f, 120.0f), Rand(-120.0f, 120.0f),
+						Rand(-120.0f, 120.0f)), vDir);
+}
+
+/*
+ * The nearest hit of one ray, one triangle at a time through
+ * VRay::Intersects(), which only takes the front face.
+ */
+static bool BruteForce(const VTriangleBvh& tris, const VRay& ray, bool bCull,
+						float fL, VUINT *pTri, float *t)
+{
+	VRay	vRay(ray);
+	VVector	v0, v1, v2;
+	float	fHit;
+	bool	bHit = false;
+
+	*t = fL;
+	for (VUINT i = 0; i < tris.Count(); i++)
+	{
+		tris.GetTriangle(i, &v0, &v1, &v2);
+		if ((vRay.Intersects(v0, v1, v2, true, &fHit) ||
+			(!bCull && vRay.Intersects(v2, v1, v0, true, &fHit))) &&
+			fHit >= 0.0f && fHit < *t)
+		{
+			*t = fHit;
+			*pTri = i;
+			bHit = true;
+		}
+	}
+	return bHit;
+}
+
+static bool Close(float f1, float f2)
+{
+	return VMath::Abs(f1 - f2) <= 1e-3f * (1.0f + VMath::Abs(f2));
+}
+
+/*
+ * Packets, single rays and occlusion queries against the brute force
+ * nearest hits.
+ */
+static unsigned int CheckTriangleBvh(const VTriangleBvh& tris, const std::vector<VRay>& vRays,
+									const std::vector<float>& vNear, const std::vector<VUINT>& vTri,
+									bool bCull)
+{
+	unsigned int	vErrors = 0;
+	VRayPacket		vPacket;
+	VUINT			vHitTri, vOccluded;
+	float			vLimit[VSIMD_PACKET];
+	float			t;
+
+	for (unsigned int i = 0; i < nRays; i += VSIMD_PACKET)
+	{
+		VUINT vNum = nRays - i < VSIMD_PACKET ? nRays - i : VSIMD_PACKET;
+
+		vPacket.Clear();
+		for (VUINT r = 0; r < vNum; r++)
+			vPacket.Add(vRays[i + r]);
+		tris.Pick(vPacket, bCull);
+
+		for (VUINT r = 0; r < vNum; r++)
+		{
+			bool bWant = vTri[i + r] != VRAY_NO_HIT;
+
+			if (vPacket.IsHit(r) != bWant)
+				vErrors++;
+			else if (bWant && !Close(vPacket.GetT(r), vNear[i + r]))
+				vErrors++;
+
+			/* the hit point is on the triangle reported */
+			if (vPacket.IsHit(r))
+			{
+				VVector v0, v1, v2;
+				tris.GetTriangle(vPacket.GetTriangle(r), &v0, &v1, &v2);
+				VVector vWant = vRays[i + r].GetOrigin() +
+								vRays[i + r].GetDirection() * vPacket.GetT(r);
+				VVector vGot = v0 + (v1 - v0) * vPacket.GetU(r) + (v2 - v0) * vPacket.GetV(r);
+				if ((vGot - vWant).Length() > 1e-2f)
+					vErrors++;
+			}
+
+			/* one ray at a time */
+			if (tris.Pick(vRays[i + r], bCull, &vHitTri, &t) != bWant ||
+				(bWant && (vHitTri != vPacket.GetTriangle(r) || t != vPacket.GetT(r))))
+				vErrors++;
+		}
+
+		/* blocked well past the nearest hit, clear well before it */
+		vPacket.Clear();
+		for (VUINT r = 0; r < vNum; r++)
+		{
+			vLimit[r] = VRAY_FAR;
+			if (vTri[i + r] != VRAY_NO_HIT)
+				vLimit[r] = vNear[i + r] * ((r & 1) ? 1.5f : 0.5f);
+			vPacket.Add(vRays[i + r], vLimit[r]);
+		}
+		vOccluded = tris.Occluded(vPacket, bCull);
+		for (VUINT r = 0; r < vNum; r++)
+		{
+			bool bWant = vTri[i + r] != VRAY_NO_HIT && (r & 1);
+
+			if (((vOccluded >> r) & 1) != (VUINT)bWant)
+				vErrors++;
+			if (tris.Occluded(vRays[i + r], vLimit[r], bCull) != bWant)
+				vErrors++;
+		}
+	}
+	return vErrors;
+}
+
+/*
+ * Quads as polygons; hits must map back to the polygon they are on.
+ */
+static unsigned int CheckPolygons()
+{
+	const unsigned int	vNumPolys = 500;
+	static const VUINT	vIndis[6] = { 0, 1, 2, 0, 2, 3 };
+	VPolygon			*vPolys = new VPolygon[vNumPolys];
+	VTriangleBvh		vTris;
+	VVector				vPoints[4];
+	unsigned int		vErrors = 0;
+	VUINT				vTri;
+	float				t;
+
+	for (unsigned int p = 0; p < vNumPolys; p++)
+	{
+		VVector vC(Rand(-50.0f, 50.0f), Rand(-50.0f, 50.0f), (float)p);
+		vPoints[0] = vC + VVector(-1.0f, -1.0f, 0.0f);
+		vPoints[1] = vC + VVector( 1.0f, -1.0f, 0.0f);
+		vPoints[2] = vC + VVector( 1.0f,  1.0f, 0.0f);
+		vPoints[3] = vC + VVector(-1.0f,  1.0f, 0.0f);
+		vPolys[p].Set(vPoints, 4, vIndis, 6);
+	}
+	vTris.Build(vPolys, vNumPolys);
+	if (vTris.Count() != vNumPolys * 2)
+		vErrors++;
+
+	/* straight down onto each quad's centre finds that quad first */
+	for (unsigned int p = 0; p < vNumPolys; p++)
+	{
+		VVector vC = (vPolys[p].GetPoints()[0] + vPolys[p].GetPoints()[2]) * 0.5f;
+		VRay vRay(vC + VVector(0.3f, 0.1f, 0.5f), VVector(0.0f, 0.0f, -1.0f));
+
+		if (!vTris.Pick(vRay, false, &vTri, &t) || vTris.GetPolygon(vTri) != p ||
+				!Close(t, 0.5f))
+			vErrors++;
+	}
+
+	delete[] vPolys;
+	return vErrors;
+}
+
+void TestTriangleBvh()
+{
+	VUINT64				vStart;
+	std::vector<VVector> vPoints(nCount * 3);
+	std::vector<VUINT>	vIndis(nCount * 3);
+	std::vector<VRay>	vRays(nRays);
+	std::vector<float>	vNear[2];
+	std::vector<VUINT>	vTri[2];
+	VTriangleBvh		vTris;
+	unsigned int		vErrors = 0;
+	VRayPacket			vPacket;
+	VUINT				vHit = 0;
+	float				t;
+
+	cout << "===========================================" << endl;
+	cout << "= Triangle BVH and ray packets				" << endl;
+	cout << "= Count: " << nCount << "  Rays: " << nRays << endl;
+
+	/* a soup of small triangles, some sharing corners */
+	srand(6);
+	for (unsigned int i = 0; i < nCount; i++)
+	{
+		VVector vC(Rand(-100.0f, 100.0f), Rand(-100.0f, 100.0f), Rand(-100.0f, 100.0f));
+		for (int c = 0; c < 3; c++)
+		{
+			vPoints[i * 3 + c] = vC + VVector(Rand(-3.0f, 3.0f), Rand(-3.0f, 3.0f),
+											Rand(-3.0f, 3.0f));
+			vIndis[i * 3 + c] = i * 3 + c;
+		}
+		if (i > 0 && (i % 5) == 0)
+			vIndis[i * 3] = (i - 1) * 3 + 2;
+	}
+	for (unsigned int i = 0; i < nRays; i++)
+		vRays[i] = RandomRay();
+
+	vStart = VClock::GetNanos();
+	vTris.Build(&vPoints[0], &vIndis[0], nCount * 3);
+	cout << "  build:   " << VClock::ElapsedMs(vStart) << "ms, " << vTris.GetBvh().NodeCount()
+		<< " nodes" << endl;
+
+	for (int c = 0; c < 2; c++)
+	{
+		vNear[c].resize(nRays);
+		vTri[c].assign(nRays, VRAY_NO_HIT);
+		for (unsigned int i = 0; i < nRays; i++)
+			BruteForce(vTris, vRays[i], c == 1, VRAY_FAR, &vTri[c][i], &vNear[c][i]);
+	}
+
+	for (int vTier = SIMD_SCALAR; vTier <= VCPU::GetDetectedTier(); vTier++)
+	{
+		VCPU::SetTier((VSimdTier)vTier);
+		vErrors = CheckTriangleBvh(vTris, vRays, vNear[0], vTri[0], false);
+		vErrors += CheckTriangleBvh(vTris, vRays, vNear[1], vTri[1], true);
+		cout << "  " << VCPU::GetTierName((VSimdTier)vTier) << " errors: "
+			<< vErrors << endl;
+	}
+	VCPU::SetTier(VCPU::GetDetectedTier());
+
+	vErrors = CheckPolygons();
+	cout << "  polygon errors: " << vErrors << endl;
+
+	/*
+	 * timing, rays per second; a pinhole camera looking into the soup,
+	 * eight neighbouring pixels to a packet
+	 */
+	const unsigned int vSide = 128;
+	std::vector<VRay> vCamera(vSide * vSide);
+	for (unsigned int y = 0; y < vSide; y++)
+	{
+		for (unsigned int x = 0; x < vSide; x++)
+		{
+			VVector vDir((x / (float)vSide) - 0.5f, (y / (float)vSide) - 0.5f, 1.0f);
+			vDir.Normalize();
+			vCamera[y * vSide + x] = VRay(VVector(0.0f, 0.0f, -150.0f), vDir);
+		}
+	}
+
+	vStart = VClock::GetNanos();
+	for (unsigned int i = 0; i < 64; i++)
+		BruteForce(vTris, vCamera[i * 97], false, VRAY_FAR, &vHit, &t);
+	cout << "  per triangle:  " << 64 * 1000.0 / (VClock::ElapsedMs(vStart) + 1) << " rays/s" << endl;
+
+	vStart = VClock::GetNanos();
+	for (unsigned int n = 0; n < nIters; n++)
+		for (unsigned int i = 0; i < vCamera.size(); i++)
+			vTris.Pick(vCamera[i], false, &vHit, &t);
+	cout << "  single rays:   " << nIters * vCamera.size() * 1000.0 /
+		(VClock::ElapsedMs(vStart) + 1)
+		<< " rays/s" << endl;
+
+	vStart = VClock::GetNanos();
+	for (unsigned int n = 0; n < nIters; n++)
+	{
+		for (unsigned int i = 0; i < vCamera.size(); i += VSIMD_PACKET)
+		{
+			vPacket.Clear();
+			for (unsigned int r = 0; r < VSIMD_PACKET; r++)
+				vPacket.Add(vCamera[i + r]);
+			vTris.Pick(vPacket);
+		}
+	}
+	cout << "  packets:       " << nIters * vCamera.size() * 1000.0 /
+		(VClock::ElapsedMs(vStart) + 1)
+		<< " rays/s" << endl;
+
+	vStart = VClock::GetNanos();
+	for (unsigned int n = 0; n < nIters; n++)
+	{
+		for (unsigned int i = 0; i < vCamera.size(); i += VSIMD_PACKET)
+		{
+			vPacket.Clear();
+			for (unsigned int r = 0; r < VSIMD_PACKET; r++)
+				vPacket.Add(vCamera[i + r]);
+			vTris.Occluded(vPacket);
+		}
+	}
+	cout << "  occlusion:     " << nIters * vCamera.size() * 1000.0 /
+		(VClock::ElapsedMs(vStart) + 1)
+		<< " rays/s" << endl << endl;
+}
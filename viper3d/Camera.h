@@ -20,6 +20,9 @@
 #include <viper3d/Movable.h>
 #include <viper3d/Math.h>
 
+/* Defines */
+#define VFRUSTUM_PLANES		6
+
 namespace UDP
 {
 
@@ -68,6 +71,27 @@ public:
 	/*==================================*
 	 *			  ATTRIBUTES			*
 	 *==================================*/
+	/**
+	 *	@brief		Returns the combined projection * view matrix.
+	 *	@date		17-Oct-2026
+	 *
+	 *	@remarks	Rebuilt only when the view or frustum has changed.
+	 *
+	 *	@returns	(const VMatrix&) Cached view-projection matrix
+	 */
+	const VMatrix&	GetViewProjection();
+	/**
+	 *	@brief		Returns the six planes bounding the view volume.
+	 *	@date		17-Oct-2026
+	 *
+	 *	@remarks	Normals are unit length and point out of the volume,
+	 *				in the order left, right, bottom, top, near, far, so
+	 *				the result can be handed straight to VAabb::Cull(),
+	 *				VObb::Cull() or VAabbBatch::Cull() with VFRUSTUM_PLANES.
+	 *
+	 *	@returns	(const VPlane*) Array of VFRUSTUM_PLANES planes
+	 */
+	const VPlane*	GetFrustumPlanes();
 
 	/*==================================*
 	 *			  OPERATIONS			*
@@ -84,6 +108,7 @@ public:
 	void			SetFOV(scalar_t pFov)
 	{
 		mFOV = pFov;
+		mUpdateFrustum = true;
 	}
 	void			UpdateView();
 	/**
@@ -140,6 +165,7 @@ private:
 	/*==================================*
 	 *             INTERNALS            *
 	 *==================================*/
+	void			UpdatePlanes();
 
 public:
 	/*==================================*
@@ -155,7 +181,12 @@ public:
 	scalar_t	mFrustrumH;
 	bool		mUpdateFrustum;
 	bool		mUpdateView;
-	VMatrix		mViewMatrix;
+	bool		mUpdatePlanes;
+	VAffine		mView;
+	VMatrix		mViewMatrix;	/**< mView as a 4x4, for GL */
+	VMatrix		mProjMatrix;
+	VMatrix		mViewProjMatrix;
+	VPlane		mFrustumPlanes[VFRUSTUM_PLANES];
 };
 
 inline
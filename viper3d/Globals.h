@@ -37,6 +37,21 @@
 #define _ViperExport
 #endif
 
+#if defined(_MSC_VER)
+#define VTHREAD_LOCAL __declspec( thread )
+#define VALIGN16 __declspec( align(16) )
+#else
+#define VTHREAD_LOCAL __thread
+#define VALIGN16 __attribute__(( aligned(16) ))
+#endif
+
+/* constexpr where the compiler has it, so math constants fold at compile time */
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+#define VCONSTEXPR constexpr
+#else
+#define VCONSTEXPR inline
+#endif
+
 #endif
 
 #endif // __GLOBALS_H_INCLUDED__
@@ -39,6 +39,7 @@ using std::ostream;
 #define VCLIPPED	3
 #define VCULLED		4
 #define VVISIBLE	5
+#define VPOLY_INLINE_POINTS	12	/* points a VPolygon holds without allocating */
 
 namespace UDP
 {
@@ -46,12 +47,14 @@ namespace UDP
 /* forward class declarations */
 class VVector;
 class VMatrix;
+class VAffine;
 class VQuaternion;
 class VRay;
 class VPlane;
 class VObb;
 class VAabb;
 class VPolygon;
+class VArena;
 
 /**
  *	@class		VMath
@@ -62,7 +65,8 @@ class VPolygon;
  *	@date		11-Sep-2003
  *	@remarks	Most of these are just wrappers around the standard C calls.
  *				I collected them here in case we find more effecient ways to
- *				handle trigonometry.
+ *				handle trigonometry.  Sin, Cos, SinCos, ACos, ATan2 and
+ *				RSqrt can trade accuracy for speed; see SetAccuracy().
  */
 class VMath
 {
@@ -84,16 +88,35 @@ public:
 	 *==================================*/
 	static float	Abs(float fValue);
 	static float	ACos(float fValue);
+	static float	ACos(float fValue, VMathAccuracy eAccuracy);
 	static float	ASin(float fValue);
 	static float	ATan(float fValue);
+	static float	ATan2(float fY, float fX);
+	static float	ATan2(float fY, float fX, VMathAccuracy eAccuracy);
 	static float	Cos(float fValue);
 	static float	Sin(float fValue);
+	static void		SinCos(float fValue, float *pSin, float *pCos);
+	static void		SinCos(float fValue, float *pSin, float *pCos,
+							VMathAccuracy eAccuracy);
 	static float	Tan(float fValue);
 	static float	Sqrt(float fValue);
+	static float	RSqrt(float fValue);
+	static float	RSqrt(float fValue, VMathAccuracy eAccuracy);
 	static float	DegToRad(float degrees);
 	static float	RadToDeg(float radians);
 	static float	Modulus(float dividend, int divisor);
 
+	/* whole arrays, at the current accuracy */
+	static void		ACos(const float *pIn, float *pOut, VUINT nCount);
+	static void		ATan2(const float *pY, const float *pX, float *pOut,
+							VUINT nCount);
+	static void		SinCos(const float *pIn, float *pSin, float *pCos,
+							VUINT nCount);
+	static void		RSqrt(const float *pIn, float *pOut, VUINT nCount);
+
+	static VMathAccuracy	GetAccuracy();
+	static void		SetAccuracy(VMathAccuracy eAccuracy);
+
 protected:
 	/*==================================*
 	 *             CALLBACKS			*
@@ -108,6 +131,9 @@ private:
 	/*==================================*
 	 *             VARIABLES            *
 	 *==================================*/
+private:
+	static VMathAccuracy	mAccuracy;
+
 public:
 	static const float PI;
 	static const float TWO_PI;
@@ -126,21 +152,19 @@ public:
  *	@version	0.1.0
  *	@date		10-Sep-2004
  */
-class VVector
+class VALIGN16 VVector
 {
 public:
 	/*==================================*
 	 *	   CONSTRUCTION/DESTRUCTION		*
 	 *==================================*/
-	VVector(float _x = 0, float _y = 0, float _z = 0, float _w = 0);
-	VVector(const VVector &vec);
-	~VVector();
+	VCONSTEXPR VVector(float _x = 0, float _y = 0, float _z = 0, float _w = 0);
 
 	/*==================================*
 	 *			  ATTRIBUTES			*
 	 *==================================*/
  	float			Length();
-	float			SquaredLength() const;
+	VCONSTEXPR float		SquaredLength() const;
 	VVector			UnitVector();
 	
 	/*==================================*
@@ -156,31 +180,30 @@ public:
 	void			Difference(const VVector& v1, const VVector& v2);
 	VVector			CrossProduct(const VVector &vec) const;
 	void			Cross(const VVector& v1, const VVector& v2);
-	float			DotProduct(const VVector &vec) const;
+	VCONSTEXPR float		DotProduct(const VVector &vec) const;
 	VQuaternion		GetRotationTo(const VVector& dest) const;
 
 	/*==================================*
 	 *			   OPERATORS			*
 	 *==================================*/
-	const VVector&	operator=(const VVector &vec);
-	bool			operator==(const VVector &vec) const;
-	bool			operator!=(const VVector &vec) const;
+	VCONSTEXPR bool			operator==(const VVector &vec) const;
+	VCONSTEXPR bool			operator!=(const VVector &vec) const;
 	const VVector&	operator+=(const VVector &vec);
 	const VVector&	operator-=(const VVector &vec);
 	const VVector&	operator*=(const float &s);
 	const VVector&	operator/=(const float &s);
 	const VVector&	operator+=(const float &s);
 	const VVector&	operator-=(const float &s);
-	float			operator*(const VVector& v) const;
-	VVector			operator*(const float& s) const;
-	VVector			operator/(const float& s) const;
-	VVector			operator+(const float& s) const;
-	VVector			operator-(const float& s) const;
-	VQuaternion		operator*(const VQuaternion& q) const;
+	VCONSTEXPR float		operator*(const VVector& v) const;
+	VCONSTEXPR VVector		operator*(const float& s) const;
+	VCONSTEXPR VVector		operator/(const float& s) const;
+	VCONSTEXPR VVector		operator+(const float& s) const;
+	VCONSTEXPR VVector		operator-(const float& s) const;
+	VCONSTEXPR VQuaternion	operator*(const VQuaternion& q) const;
 	VVector			operator*(const VMatrix& m) const;
-	VVector			operator+(const VVector &vec) const;
-	VVector			operator-(const VVector &vec) const;
-	VVector			operator-() const;
+	VCONSTEXPR VVector		operator+(const VVector &vec) const;
+	VCONSTEXPR VVector		operator-(const VVector &vec) const;
+	VCONSTEXPR VVector		operator-() const;
 	friend ostream&	operator<<(ostream& os, const VVector& vec);
 
 public:
@@ -198,7 +221,7 @@ public:
 	static const VVector VECTOR_UNIT_SCALE;
 };
 
-inline
+VCONSTEXPR
 VVector VVector::operator-() const
 {
 	return VVector(-x, -y, -z);
@@ -220,8 +243,10 @@ ostream& operator<<(ostream& os, const VVector& vec)
  *	@author		Josh Williams
  *	@version	0.1.0
  *	@date		11-Sep-2004
+ *	@remarks	Row-major, 16 byte aligned so each row loads straight into
+ *				an SSE register.
  */
-class VMatrix
+class VALIGN16 VMatrix
 {
 public:
 	/*==================================*
@@ -232,7 +257,6 @@ public:
 			float m10, float m11, float m12, float m13,
 			float m20, float m21, float m22, float m23,
 			float m30, float m31, float m32, float m33);
-	~VMatrix() {}
 
 	/*==================================*
 	 *			  ATTRIBUTES			*
@@ -259,15 +283,19 @@ public:
 	void			LookAt(const VVector& vPos, const VVector& vLookAt,
 								VVector vWorldUp = VVector::VECTOR_UNIT_Y);
 	void			TransposeOf(const VMatrix& mat);
-	void			InverseOf(const VMatrix& mat);
+	bool			InverseOf(const VMatrix& mat);
+	bool			AffineInverseOf(const VMatrix& mat);
 	VMatrix			Transpose() const;
+	void			TransformPoints(VVector *pOut, const VVector *pIn,
+								VUINT nCount) const;
+	void			TransformDirections(VVector *pOut, const VVector *pIn,
+								VUINT nCount) const;
 
 	/*==================================*
 	 *			   OPERATORS			*
 	 *==================================*/
 	VMatrix			operator*(const VMatrix& mat) const;
 	VVector			operator*(const VVector& vec) const;
-	void			operator=(const VMatrix &mat);
 	VMatrix			operator-() const;
 	void			MakeGLMatrix(float gl_matrix[16]);
 	friend ostream&	operator<<(ostream& os, const VMatrix& pMat);
@@ -319,6 +347,83 @@ ostream& operator<<(ostream& os, const VMatrix& pMat)
 
 /*============================================================================*/
 
+/**
+ *	@class		VAffine
+ *
+ *	@brief		Rotation, scale and translation, as the top three rows of
+ *				a VMatrix.
+ *	@version	0.1.0
+ *	@date		17-Oct-2026
+ *	@remarks	Column vectors, like the scene graph: the translation is
+ *				m[0..2][3] and the bottom row is always (0, 0, 0, 1), so
+ *				it is not stored.  Composing two costs 36 multiplies to
+ *				VMatrix's 64, and transforms with no shear or non-uniform
+ *				scale invert with a transpose (OrthoInverseOf()).
+ */
+class VALIGN16 VAffine
+{
+public:
+	/*==================================*
+	 *	   CONSTRUCTION/DESTRUCTION		*
+	 *==================================*/
+	VAffine();
+	VAffine(const VQuaternion& qRot, const VVector& vPos, float fScale = 1.0f);
+	explicit VAffine(const VMatrix& mat);
+
+	/*==================================*
+	 *			  ATTRIBUTES			*
+	 *==================================*/
+	float*			operator[](unsigned nRow) { return m[nRow]; }
+	const float*	operator[](unsigned nRow) const { return m[nRow]; }
+	VVector			GetTranslation() const;
+	void			ToMatrix(VMatrix& mat) const;
+
+	/*==================================*
+	 *			  OPERATIONS			*
+	 *==================================*/
+	void			Set(const VQuaternion& qRot, const VVector& vPos,
+								float fScale = 1.0f);
+	void			SetTranslation(const VVector& vPos);
+	void			FromMatrix(const VMatrix& mat);
+	bool			InverseOf(const VAffine& xf);
+	bool			OrthoInverseOf(const VAffine& xf);
+	VVector			TransformPoint(const VVector& vec) const;
+	VVector			TransformDirection(const VVector& vec) const;
+	void			TransformPoints(VVector *pOut, const VVector *pIn,
+								VUINT nCount) const;
+	void			TransformDirections(VVector *pOut, const VVector *pIn,
+								VUINT nCount) const;
+
+	/*==================================*
+	 *			   OPERATORS			*
+	 *==================================*/
+	VAffine			operator*(const VAffine& xf) const;
+	friend VMatrix	operator*(const VMatrix& mat, const VAffine& xf);
+	friend ostream&	operator<<(ostream& os, const VAffine& xf);
+
+public:
+	/*==================================*
+	 *             VARIABLES            *
+	 *==================================*/
+	float	m[3][4];
+	static const VAffine AFFINE_IDENTITY;
+};
+
+inline
+ostream& operator<<(ostream& os, const VAffine& xf)
+{
+	for (int i = 0; i < 3; i++)
+	{
+		os << "[" << xf.m[i][0] << ", " << xf.m[i][1] << ", " << xf.m[i][2]
+			<< ", " << xf.m[i][3] << "]";
+		if (i < 2)
+			os << std::endl;
+	}
+	return os;
+}
+
+/*============================================================================*/
+
 /**
  *	@class		VQuaternion
  *
@@ -334,18 +439,16 @@ public:
 	/*==================================*
 	 *	   CONSTRUCTION/DESTRUCTION		*
 	 *==================================*/
-	VQuaternion(float _x = 0.0f, float _y = 0.0f, float _z = 0.0f,
-						float _w = 0.0f);
-	VQuaternion(const VQuaternion& q);
-	VQuaternion(const VVector& v, const float &r);
-	virtual ~VQuaternion() {};
+	VCONSTEXPR VQuaternion(float _w = 0.0f, float _x = 0.0f, float _y = 0.0f,
+						float _z = 0.0f);
+	VCONSTEXPR VQuaternion(const VVector& v, const float &r);
 
 	/*==================================*
 	 *			  ATTRIBUTES			*
 	 *==================================*/
 	float 			GetMagnitude() const;
-	VVector			GetVector() const;
-	float			GetScalar() const;
+	VCONSTEXPR VVector		GetVector() const;
+	VCONSTEXPR float		GetScalar() const;
 	float			GetAngle();
 
 	/*==================================*
@@ -364,28 +467,30 @@ public:
 								float *fYaw) const;
 	void			Rotate(const VQuaternion& q1, const VQuaternion& q2);
 	VVector			Rotate(const VVector& vec);
+	void			Nlerp(const VQuaternion& q1, const VQuaternion& q2,
+								float fT);
+	void			Slerp(const VQuaternion& q1, const VQuaternion& q2,
+								float fT);
 	
 
 	/*==================================*
 	 *			   OPERATORS			*
 	 *==================================*/
-	VQuaternion& 	operator=(const VQuaternion& q);
-
 	VQuaternion&	operator*=(const float& s);
-	VQuaternion		operator*(const float& s) const;
+	VCONSTEXPR VQuaternion	operator*(const float& s) const;
 	VQuaternion&	operator/=(const float& s);
-	VQuaternion		operator/(const float& s) const;
+	VCONSTEXPR VQuaternion	operator/(const float& s) const;
 
 	//VQuaternion		operator*(const VVector& vec) const;
 	VVector			operator*(const VVector& pVec) const;
 
 	VQuaternion&	operator+=(const VQuaternion& q);
-	VQuaternion		operator+(const VQuaternion& q) const;
+	VCONSTEXPR VQuaternion	operator+(const VQuaternion& q) const;
 	VQuaternion&	operator-=(const VQuaternion& q);
-	VQuaternion		operator-(const VQuaternion& q) const;
+	VCONSTEXPR VQuaternion	operator-(const VQuaternion& q) const;
 	VQuaternion&	operator*=(const VQuaternion& q);
-	VQuaternion		operator*(const VQuaternion& q) const;
-	VQuaternion		operator~() const;
+	VCONSTEXPR VQuaternion	operator*(const VQuaternion& q) const;
+	VCONSTEXPR VQuaternion	operator~() const;
 	friend ostream&	operator<<(ostream& os, const VMatrix& pMat);
 
 protected:
@@ -754,7 +859,14 @@ void VAabb::SetCenter(const VVector& vCenter)
  *	@author		Josh Williams
  *	@version	0.1.0
  *	@date		12-Sep-2003
- *	@remarks	Used mainly for collision detection.
+ *	@remarks	Used mainly for collision detection.  Polygons of up to
+ *				VPOLY_INLINE_POINTS points keep their points and indices
+ *				inside the object, and Set() reuses whatever room a
+ *				polygon already has, so clipping small polygons never
+ *				touches the heap.  Bigger ones allocate from the arena
+ *				given to the constructor or SetArena(), or from the heap
+ *				if there is none; a polygon must then not be used after
+ *				its arena is reset.
  */
 class VPolygon
 {
@@ -763,6 +875,7 @@ public:
 	 *	   CONSTRUCTION/DESTRUCTION		*
 	 *==================================*/
 	VPolygon();
+	VPolygon(VArena *pArena);
 	VPolygon(const VPolygon& poly);
 	virtual ~VPolygon();
 
@@ -776,6 +889,9 @@ public:
 	const VPlane&	GetPlane() const;
 	const VAabb&	GetAabb() const;
 	const VUINT		GetFlag() const;
+	VArena*			GetArena() const;
+	void			SetArena(VArena *pArena);
+	VUINT			GetHeapAllocs() const;
 
 	/*==================================*
 	 *			  OPERATIONS			*
@@ -805,6 +921,11 @@ private:
 	/*==================================*
 	 *             INTERNALS            *
 	 *==================================*/
+	void			Init(VArena *pArena);
+	void			Reserve(VUINT nNumP, VUINT nNumI);
+	void			Free();
+	void			SetFan(const VVector *pPoints, VUINT nNumP);
+	void			CalcPlane(void);
 	void			CalcBoundingBox(void);
 
 private:
@@ -818,6 +939,14 @@ private:
 	VUINT			m_nFlag;	/**< user defined flag */
 	VVector			*m_pPoints;	/**< list of points */
 	VUINT			*m_pIndis;	/**< index list */
+	VUINT			m_nCapP;	/**< room for points at m_pPoints */
+	VUINT			m_nCapI;	/**< room for indices at m_pIndis */
+	bool			m_bHeapP;	/**< m_pPoints came from new[] */
+	bool			m_bHeapI;	/**< m_pIndis came from new[] */
+	VUINT			m_nHeapAllocs;	/**< new[] calls made for this polygon */
+	VArena			*m_pArena;	/**< where big polygons allocate */
+	VVector			m_vInlineP[VPOLY_INLINE_POINTS];
+	VUINT			m_nInlineI[(VPOLY_INLINE_POINTS - 2) * 3];
 };
 
 inline
@@ -862,6 +991,23 @@ const VUINT VPolygon::GetFlag() const
 	return m_nFlag;
 }
 
+inline
+VArena* VPolygon::GetArena() const
+{
+	return m_pArena;
+}
+
+/**
+ *	Number of times this polygon, or clipping it, went to the heap over
+ *	the polygon's life.  The count stays with the object and is not
+ *	copied along with the points.
+ */
+inline
+VUINT VPolygon::GetHeapAllocs() const
+{
+	return m_nHeapAllocs;
+}
+
 inline
 void VPolygon::SetFlag(VUINT nFlag)
 {
@@ -870,4 +1016,6 @@ void VPolygon::SetFlag(VUINT nFlag)
 
 } // End Namespace
 
+#include <viper3d/math/Math.inl>
+
 #endif // __MATH_H_INCLUDED__
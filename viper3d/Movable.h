@@ -47,6 +47,8 @@ public:
 	const VVector&	GetPosition() const;
 	VVector			GetDirection() const;
 	const VQuaternion&	GetOrientation() const { return mOrientation; }
+	bool			GetBounds(VAabb &box);
+	void			GetLocalTransform(VAffine &xf);
 
 	/*==================================*
 	 *			  OPERATIONS			*
@@ -14,11 +14,58 @@
 #define __NODE_H_INCLUDED__
 
 #include <stdlib.h>
+#include <vector>
 #include <viper3d/Globals.h>
 #include <viper3d/Renderable.h>
+#include <viper3d/util/JobSystem.h>
+
+#define VNODE_JOB_GRAIN		256		/* fewest nodes updated by one job */
 
 namespace UDP
 {
+
+class VNode;
+class VSceneBvh;
+class VRenderSystem;
+class VRenderQueue;
+
+/**
+ *	@brief		Depth-first snapshot of a node tree.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	Kept by the root node and rebuilt only after an Attach()
+ *				or Detach() somewhere in the tree.  The subtree of node i
+ *				is the range [i, mEnd[i]), so a whole tree can be walked,
+ *				transformed or skipped with plain loops.  A node whose
+ *				local transform changes only flags its entry in mMoved;
+ *				the next UpdateTransforms() recomputes just the flagged
+ *				subtrees.
+ */
+struct VNodeList
+{
+	std::vector<VNode*>		mNodes;		/**< Nodes in depth-first order */
+	std::vector<int>		mParent;	/**< Index of each node's parent, or -1 */
+	std::vector<VUINT>		mEnd;		/**< One past each node's last descendant */
+	std::vector<VAffine>	mWorld;		/**< World transform of each node */
+	std::vector<VBYTE>		mMoved;		/**< Local transform changed since the last update */
+	VUINT					mNumMoved;	/**< Entries set in mMoved */
+	bool					mDirty;		/**< Tree changed since the last build */
+};
+
+/**
+ *	@brief		Stretch of a VNodeList updated by one job.
+ *	@date		17-Oct-2026
+ */
+struct VTransformRange
+{
+	VNodeList				*mList;
+	VUINT					mFirst;
+	VUINT					mEnd;
+	VUINT					mDirtyEnd;	/**< End of a moved ancestor's subtree, or 0 */
+	VUINT					mCleared;	/**< Moved flags the job cleared */
+	std::vector<VNode*>		mBounds;	/**< Indexed nodes whose bounds moved */
+};
+
 /**
  *	@class		VNode
  *
@@ -125,6 +172,43 @@ public:
 	 *	@returns	(VNode*) Our previous sibling, or NULL.
 	 */
 	inline VNode*	GetPrev() { return mPrevNode; }	
+	/**
+	 *	@brief		Returns the world-space bounds of this node.
+	 *	@date		17-Oct-2026
+	 *
+	 *	@remarks	Nodes that return false are grouping nodes only and are
+	 *				left out of any VSceneBvh built over the tree.
+	 *
+	 *	@param		box		Receives the bounds
+	 *
+	 *	@returns	(bool) True if the node has bounds
+	 */
+	virtual bool	GetBounds(VAabb & /*box*/) { return false; }
+	/**
+	 *	@brief		Returns this node's transform relative to its parent.
+	 *	@date		17-Oct-2026
+	 *
+	 *	@param		xf		Receives the transform
+	 *
+	 *	@returns	void
+	 */
+	virtual void	GetLocalTransform(VAffine &xf) { xf = VAffine::AFFINE_IDENTITY; }
+	/**
+	 *	@brief		Returns the flattened form of the tree this node is in,
+	 *				rebuilding it first if the tree has changed.
+	 *	@date		17-Oct-2026
+	 *
+	 *	@returns	(const VNodeList*) List kept by the root node
+	 */
+	const VNodeList*	GetNodeList();
+	/**
+	 *	@brief		Returns this node's transform relative to the world,
+	 *				bringing the tree's transforms up to date first.
+	 *	@date		17-Oct-2026
+	 *
+	 *	@returns	(const VAffine&) World transform, kept in the node list
+	 */
+	const VAffine&	GetWorldTransform();
 
 public:
 	/*==================================*
@@ -140,6 +224,61 @@ public:
 	 *	@returns	void
 	 */
 	void			Render();
+	/**
+	 *	@brief		Renders the tree through a render system instead of
+	 *				the GL matrix stack.
+	 *	@date		17-Oct-2026
+	 *
+	 *	@remarks	Hands each node's world transform to SetWorldMatrix()
+	 *				before its OnRender(), which can then draw its meshes
+	 *				with VRenderSystem::DrawMesh().
+	 *
+	 *	@param		pRender	Render system the nodes draw with
+	 */
+	void			Render(VRenderSystem *pRender);
+	/**
+	 *	@brief		Has nodes push their draws onto a render queue.
+	 *	@date		17-Oct-2026
+	 *
+	 *	@remarks	Calls OnQueue() with the world transform of this node
+	 *				and, unless bChildren is false, every node below it.
+	 *				After a VSceneBvh::Cull(), call it on each visible
+	 *				node with bChildren false.
+	 *
+	 *	@param		pQueue		Queue to fill
+	 *	@param		bChildren	Queue the whole subtree
+	 */
+	void			Queue(VRenderQueue *pQueue, bool bChildren = true);
+	/**
+	 *	@brief		Recomputes the world transforms of every node in this
+	 *				node's tree that has moved, or whose parent has.
+	 *	@date		17-Oct-2026
+	 *
+	 *	@remarks	One pass over the node list, parents always coming
+	 *				before their children.  Nodes that have not moved
+	 *				keep the matrix from the last update.  Call once per
+	 *				frame; does nothing if nothing has moved.
+	 *
+	 *	@returns	void
+	 */
+	void			UpdateTransforms();
+	/**
+	 *	@brief		UpdateTransforms(), with the tree split between the
+	 *				threads of a job system.
+	 *	@date		17-Oct-2026
+	 *
+	 *	@remarks	Subtrees of a few hundred nodes or more each go to a
+	 *				job; the nodes above them are updated first, on the
+	 *				calling thread.  GetLocalTransform() must therefore be
+	 *				safe to call from any thread.  The results, and the
+	 *				order bounds changes reach a VSceneBvh in, do not
+	 *				depend on the number of threads.
+	 *
+	 *	@param		jobs	Threads to update on
+	 *
+	 *	@returns	void
+	 */
+	void			UpdateTransforms(VJobSystem &jobs);
 	/**
 	 *	@brief		Attaches this node to another.
 	 *	@author		Josh Williams
@@ -250,16 +389,59 @@ protected:
 	/*==================================*
 	 *			  CALLBACKS				*
 	 *==================================*/
+	/**
+	 *	@brief		Must be called by derived classes whenever the value
+	 *				returned by GetBounds() changes.
+	 *	@date		17-Oct-2026
+	 *
+	 *	@returns	void
+	 */
+	void			BoundsChanged();
+	/**
+	 *	@brief		Must be called by derived classes whenever the value
+	 *				returned by GetLocalTransform() changes.
+	 *	@date		17-Oct-2026
+	 *
+	 *	@remarks	Only flags the node; its world transform, and those of
+	 *				its children, are recomputed by the next
+	 *				UpdateTransforms().
+	 *
+	 *	@returns	void
+	 */
+	void			TransformChanged();
+	/**
+	 *	@brief		Pushes this node's draws, if it has any.
+	 *	@date		17-Oct-2026
+	 *
+	 *	@param		pQueue	Queue to push onto
+	 *	@param		world	The node's world transform, for
+	 *						VRenderQueue::Push()
+	 *
+	 *	@returns	void
+	 */
+	virtual void	OnQueue(VRenderQueue * /*pQueue*/, const VMatrix& /*world*/) {}
 
 private:
 	/*==================================*
 	 *			  INTERNALS				*
 	 *==================================*/
+	friend class VSceneBvh;
+	void			InvalidateList();
+	void			BuildList();
+	static VUINT	UpdateRange(VNodeList *pList, VUINT nFirst, VUINT nEnd,
+							VUINT nDirtyEnd, VUINT nMoved,
+							std::vector<VNode*> *pBounds);
+	static void		UpdateNode(VNodeList *pList, VUINT nIndex);
+	static void		UpdateJob(VJob *pJob);
 
 private:
 	/*==================================*
 	 *			  VARIABLES				*
 	 *==================================*/
+	VNodeList	*mList;			/**< Flattened tree, kept by the root only */
+	VUINT		mListIndex;		/**< Our position in the root's mList */
+	VSceneBvh	*mSceneBvh;		/**< Hierarchy we are indexed in, or null */
+	VUINT		mSceneItem;		/**< Our item number in mSceneBvh */
 	VNode	*mParentNode;	/**< Owner of this node, or null if we are a top-level */
 	VNode	*mChildNode;	/**< Pointer to our first child node, or null */
 	VNode	*mPrevNode;		/**< Pointer to our previous sibling, or ourselves if we're 
@@ -1,85 +1,297 @@
-/*============================================================================*
- *                                                                            *
- * 	This file is part of the Viper3D Game Engine.							  *
- *                                                                            *
- *	Copyright (C) 2004 UDP Games   All Rights Reserved.						  *
- *                                                                            *
- *============================================================================*
- *                                  CHANGELOG                                 *
- *    Date      Description                                     Author        *
- * -----------  ----------------------------------------------	------------- *
- *                                                                            *
- *============================================================================*/
-#if !defined(__PROFILER_H_INCLUDED__)
-#define __PROFILER_H_INCLUDED__
-
-#ifdef PROFILER
-#include <string>
-#include <sys/time.h>
-#define MAX_PROFILER_SAMPLES 50
-#include <iostream>
-
-
-class VProfileSample;
-
-class VProfileSample
-{
-public:
-	VProfileSample(std::string pSampleName);
-	~VProfileSample();
-
-	static void Output();
-
-	static void ResetSample(std::string pName);
-	static void ResetAll();
-
-	static bool mProfilerIsRunning;
-
-protected:
-	//index into the array of samples
-	int			mSampleIndex;
-	int			mParentIndex;
-
-	double		GetTime();
-
-	static struct VSample
-	{
-		VSample()
-		{
-			mIsValid=false; 
-			mDataCount=0;
-			mAveragePc = mMinPc = mMaxPc = -1;
-		}
-
-		bool		mIsValid;		//whether or not this sample is valid (for use with fixed-size arrays)
-		bool		mIsOpen;		//is this sample currently being profiled?
-		unsigned int mCallCount;	//number of times this sample has been profiled this frame
-		std::string	mName;	//name of the sample
-		
-		double mStartTime;	//starting time on the clock, in seconds
-		double mTotalTime;	//total time recorded across all profiles of this sample
-		double mChildTime;	//total time taken by children of this sample
-
-		int mParentCount;	//number of parents this sample has (useful for indenting)
-
-		float mAveragePc;	//average percentage of game loop time taken up
-		float mMinPc;		//minimum percentage of game loop time taken up
-		float mMaxPc;		//maximum percentage of game loop time taken up
-		unsigned long mDataCount;//number of percentage values that have been stored
-	} mSamples[MAX_PROFILER_SAMPLES];
-
-	static int mLastOpenedSample;
-	static int mOpenSampleCount;
-	static double mRootBegin, mRootEnd;
-	static struct timeval mStartTime;
-	static bool mTimeSet;
-};
-
-#define PROFILE(name) VProfileSample _profile_sample(name);
-#define PROFILE_OUTPUT() VProfileSample::Output()
-#else
-#define PROFILE(name)
-#define PROFILE_OUTPUT()
-#endif
-
-#endif // __PROFILER_H_INCLUDED__
+/*============================================================================*
+ *                                                                            *
+ * 	This file is part of the Viper3D Game Engine.							  *
+ *                                                                            *
+ *	Copyright (C) 2004 UDP Games   All Rights Reserved.						  *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------	------------- *
+ *	17-Oct-2026	Replaced VProfileSample with VProfiler			              *
+ *	17-Oct-2026	Added trace capture								              *
+ *                                                                            *
+ *============================================================================*/
+#if !defined(__PROFILER_H_INCLUDED__)
+#define __PROFILER_H_INCLUDED__
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+/* System Headers */
+#include <iostream>
+#include <vector>
+#if defined(__i386__) || defined(__x86_64__)
+#include <x86intrin.h>
+#define VPROFILE_RDTSC
+#elif defined(_M_IX86) || defined(_M_X64)
+#include <intrin.h>
+#define VPROFILE_RDTSC
+#else
+#include <time.h>
+#endif
+
+/* Local Headers */
+#include <viper3d/Globals.h>
+
+/* Defines */
+#define VPROFILE_EVENTS		16384	/* events a thread can buffer between frames */
+#define VPROFILE_DEPTH		64		/* deepest nesting of samples tracked */
+#define VPROFILE_END		0x80000000u	/* event type bit; clear for begin */
+#define VPROFILE_CAPTURE	1048576	/* events a thread can capture for a trace */
+
+/*
+ * Keeps the compiler from moving event stores past the publishing store
+ * of the write index.  x86 does not reorder stores with other stores.
+ */
+#if defined(VPROFILE_RDTSC) && defined(_MSC_VER)
+#define VPROFILE_BARRIER()	_ReadWriteBarrier()
+#elif defined(VPROFILE_RDTSC)
+#define VPROFILE_BARRIER()	__asm__ __volatile__("" ::: "memory")
+#else
+#define VPROFILE_BARRIER()	__sync_synchronize()
+#endif
+
+namespace UDP
+{
+
+/**
+ *	One PROFILE() call site.  Statically initialized, so the first pass
+ *	through the site only has to look its name up once.
+ */
+struct VProfileSite
+{
+	const char		*mName;
+	volatile VUINT	mId;		/**< interned sample id, 0 until registered */
+};
+
+/**
+ *	A begin or end of a sample, as written by the hot path.
+ */
+struct VProfileEvent
+{
+	VUINT64			mTicks;
+	VUINT			mId;		/**< sample id, VPROFILE_END set for an end */
+	VUINT			mPad;
+};
+
+/**
+ *	One entry in a thread's call tree.  The same sample reached through
+ *	different parents gets a node under each.
+ */
+struct VProfileNode
+{
+	VUINT			mId;		/**< sample id */
+	int				mParent;	/**< index of the parent node, -1 for the root */
+	int				mChild;		/**< index of the first child, or -1 */
+	int				mNext;		/**< index of the next sibling, or -1 */
+	int				mDepth;		/**< 0 for the root */
+	VUINT			mCalls;		/**< calls completed in the last frame */
+	VUINT64			mTicks;		/**< total ticks in the last frame */
+	VUINT64			mChildTicks;	/**< part of mTicks spent in children */
+	float			mMinPc;		/**< least self time, percent of a frame */
+	float			mAvgPc;
+	float			mMaxPc;
+	VULONG			mFrames;	/**< frames averaged into mAvgPc */
+	VUINT			mFrameCalls;	/**< running totals for the current frame */
+	VUINT64			mFrameTicks;
+	VUINT64			mFrameChildTicks;
+};
+
+/**
+ *	Events recorded by one thread, and the call tree built from them.
+ *	Only the owning thread writes events, only EndFrame() reads them.
+ */
+struct VProfileThread
+{
+	VProfileEvent			mEvents[VPROFILE_EVENTS];
+	volatile VUINT			mHead;		/**< next event to write */
+	volatile VUINT			mTail;		/**< next event to read */
+	VUINT					mDropped;	/**< events lost to a full buffer */
+	VUINT					mIndex;		/**< registration order */
+	std::vector<VProfileNode>	mNodes;	/**< call tree, node 0 is the root */
+	int						mStack[VPROFILE_DEPTH];		/**< open nodes */
+	VUINT64					mStart[VPROFILE_DEPTH];		/**< and when they opened */
+	int						mDepth;
+	std::vector<VProfileEvent>	mCapture;	/**< events kept for WriteTrace() */
+};
+
+/**
+ *	@class		VProfiler
+ *
+ *	@brief		Hierarchical, per-thread sampling profiler.
+ *	@version	0.1.0
+ *	@date		17-Oct-2026
+ *	@remarks	PROFILE() interns its name once per call site, then each
+ *				pass through the scope costs two time stamp reads and two
+ *				stores into a buffer owned by the calling thread; no locks
+ *				and no string work.  EndFrame(), called once per frame by
+ *				one thread, drains every thread's buffer into that
+ *				thread's call tree and updates the per-sample statistics.
+ *				Output() prints the trees.
+ *
+ *				StartCapture() also keeps every drained event for a run of
+ *				frames, so WriteTrace() can save them as a Chrome trace
+ *				(chrome://tracing, ui.perfetto.dev) and single frames can
+ *				be looked at on a timeline instead of averaged away.
+ */
+class VProfiler
+{
+public:
+	/*==================================*
+	 *			  ATTRIBUTES			*
+	 *==================================*/
+	static VUINT64		GetTicks();
+	static double		GetTickRate();
+	static bool			IsEnabled();
+	static const char*	GetName(VUINT nId);
+	static VUINT		GetNumThreads();
+	static const std::vector<VProfileNode>&	GetTree(VUINT nThread);
+	static VUINT		GetDropped(VUINT nThread);
+	static bool			IsCapturing();
+
+	/*==================================*
+	 *			  OPERATIONS			*
+	 *==================================*/
+	static void			SetEnabled(bool bEnabled);
+	static VUINT		Register(VProfileSite *pSite);
+	static void			Begin(VUINT nId);
+	static void			End(VUINT nId);
+	static void			EndFrame();
+	static void			Output(std::ostream &out = std::cout);
+	static void			ResetAll();
+	static void			StartCapture(VUINT nFrames = 0);
+	static void			StopCapture();
+	static bool			WriteTrace(std::ostream &out);
+	static bool			WriteTrace(const char *pFile);
+
+private:
+	/*==================================*
+	 *             INTERNALS            *
+	 *==================================*/
+	static VProfileThread*	AddThread();
+	static void			Record(VUINT nId);
+	static void			Drain(VProfileThread *pThread);
+	static int			FindChild(VProfileThread *pThread, int nParent, VUINT nId);
+	static void			Accumulate(VProfileThread *pThread, VUINT64 nFrameTicks);
+
+private:
+	/*==================================*
+	 *             VARIABLES            *
+	 *==================================*/
+	static VTHREAD_LOCAL VProfileThread	*mThread;	/**< calling thread's buffer */
+	static bool			mEnabled;
+	static VUINT64		mFrameStart;
+};
+
+/**
+ *	@class		VProfileScope
+ *
+ *	@brief		Times the enclosing scope; created by PROFILE().
+ *	@version	0.1.0
+ *	@date		17-Oct-2026
+ */
+class VProfileScope
+{
+public:
+	VProfileScope(VProfileSite &site);
+	~VProfileScope();
+
+private:
+	VUINT			mId;
+};
+
+/********************************************************************
+ *																	*
+ *							I N L I N E S							*
+ *																	*
+ ********************************************************************/
+inline
+VUINT64 VProfiler::GetTicks()
+{
+#if defined(VPROFILE_RDTSC)
+	return (VUINT64)__rdtsc();
+#else
+	struct timespec vNow;
+	clock_gettime(CLOCK_MONOTONIC_RAW, &vNow);
+	return (VUINT64)vNow.tv_sec * 1000000000ull + (VUINT64)vNow.tv_nsec;
+#endif
+}
+
+inline
+bool VProfiler::IsEnabled()
+{
+	return mEnabled;
+}
+
+inline
+void VProfiler::Record(VUINT nId)
+{
+	VProfileThread	*vThread = mThread;
+	VUINT			vHead;
+
+	if (vThread == NULL)
+		vThread = AddThread();
+
+	vHead = vThread->mHead;
+	if (vHead - vThread->mTail >= VPROFILE_EVENTS)
+	{
+		vThread->mDropped++;
+		return;
+	}
+
+	VProfileEvent &vEvent = vThread->mEvents[vHead & (VPROFILE_EVENTS - 1)];
+	vEvent.mTicks = GetTicks();
+	vEvent.mId = nId;
+	VPROFILE_BARRIER();
+	vThread->mHead = vHead + 1;
+}
+
+inline
+void VProfiler::Begin(VUINT nId)
+{
+	if (mEnabled)
+		Record(nId);
+}
+
+inline
+void VProfiler::End(VUINT nId)
+{
+	if (mEnabled)
+		Record(nId | VPROFILE_END);
+}
+
+inline
+VProfileScope::VProfileScope(VProfileSite &site)
+{
+	mId = site.mId;
+	if (mId == 0)
+		mId = VProfiler::Register(&site);
+	VProfiler::Begin(mId);
+}
+
+inline
+VProfileScope::~VProfileScope()
+{
+	VProfiler::End(mId);
+}
+
+} // End Namespace
+
+#if !defined(PROFILER_DISABLE)
+#define PROFILE(name)		static UDP::VProfileSite _profile_site = { name, 0 }; \
+							UDP::VProfileScope _profile_scope(_profile_site);
+#define PROFILE_FRAME()		UDP::VProfiler::EndFrame()
+#define PROFILE_OUTPUT()	UDP::VProfiler::Output()
+#define PROFILE_CAPTURE(frames)	UDP::VProfiler::StartCapture(frames)
+#define PROFILE_TRACE(file)	UDP::VProfiler::WriteTrace(file)
+#else
+#define PROFILE(name)
+#define PROFILE_FRAME()
+#define PROFILE_OUTPUT()
+#define PROFILE_CAPTURE(frames)
+#define PROFILE_TRACE(file)
+#endif
+
+#endif // __PROFILER_H_INCLUDED__
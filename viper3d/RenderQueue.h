@@ -0,0 +1,192 @@
+/*============================================================================*
+ *                                                                            *
+ *  This file is part of the Viper3D Game Engine.                             *
+ *                                                                            *
+ *  Copyright (C) 2004 UDP Games   All Rights Reserved.                       *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------  ------------- *
+ *                                                                            *
+ *============================================================================*/
+#if !defined(__RENDERQUEUE_H_INCLUDED__)
+#define __RENDERQUEUE_H_INCLUDED__
+
+/* System Headers */
+#include <vector>
+
+/* Local Headers */
+#include <viper3d/Globals.h>
+#include <viper3d/RenderSystem.h>
+
+/* Defines */
+#define VQUEUE_LAYER_BITS		4
+#define VQUEUE_MATERIAL_BITS	12
+#define VQUEUE_TEXTURE_BITS		12
+#define VQUEUE_MESH_BITS		12
+#define VQUEUE_DEPTH_BITS		24
+#define VQUEUE_LAYERS			(1 << VQUEUE_LAYER_BITS)
+
+namespace UDP
+{
+
+/**
+ *	One draw waiting in a VRenderQueue.
+ */
+struct VRenderItem
+{
+	VUINT64		mKey;
+	VUINT		mMaterial;	/**< full ids; the key only holds their low bits */
+	VUINT		mTexture;
+	VMeshHandle	mMesh;
+	VUINT		mWorld;		/**< index for VRenderQueue::GetWorld() */
+	VUINT		mFirst;		/**< first index (or vertex) drawn */
+	VUINT		mCount;		/**< 0 for the whole mesh */
+};
+
+/**
+ *	What drawing a queue cost; reset by VRenderQueue::Clear().
+ */
+struct VRenderStats
+{
+	VUINT		mItems;			/**< items sorted */
+	VUINT		mDraws;			/**< draw calls made */
+	VUINT		mStateChanges;	/**< material or texture switches */
+	VUINT		mMerged;		/**< items folded into another's draw */
+};
+
+/**
+ *	@class		VRenderQueue
+ *
+ *	@brief		A frame's draws, sorted to keep state changes down.
+ *	@version	0.1.0
+ *	@date		17-Oct-2026
+ *	@remarks	The cull pass pushes one item per draw, with a 64 bit key
+ *				from MakeKey().  From the top, a key holds the layer, the
+ *				material, the texture, the mesh and the depth, so sorting
+ *				the keys draws each layer in turn, changes material and
+ *				texture as rarely as possible and draws front to back
+ *				within a state.  Layers set with SetBackToFront(), for
+ *				transparent things, put the depth (reversed) straight
+ *				under the layer instead.  Sort() is an LSD radix sort
+ *				and VRenderSystem::DrawQueue() submits the result,
+ *				merging consecutive items of the same state, mesh and
+ *				transform into one multi-draw.  The key only decides the
+ *				order; state is set from the ids each item was pushed
+ *				with.  Storage is kept between
+ *				frames, so a queue of steady size does not allocate.
+ */
+class VRenderQueue
+{
+	friend class VRenderSystem;
+public:
+	/*==================================*
+	 *	   CONSTRUCTION/DESTRUCTION		*
+	 *==================================*/
+	VRenderQueue();
+	virtual ~VRenderQueue();
+
+	/*==================================*
+	 *			  ATTRIBUTES			*
+	 *==================================*/
+	VUINT				GetCount() const;
+	const VRenderItem&	GetItem(VUINT nIndex) const;
+	const VMatrix&		GetWorld(VUINT nWorld) const;
+	const VRenderStats&	GetStats() const;
+	void				SetBackToFront(VUINT nLayer, bool bBackToFront);
+	bool				IsBackToFront(VUINT nLayer) const;
+	void				SetEye(const VVector& vEye, float fFar);
+	float				GetDepth(const VVector& vPos) const;
+	VUINT64				MakeKey(VUINT nLayer, VUINT nMaterial, VUINT nTexture,
+								VMeshHandle hMesh, float fDepth) const;
+	static VUINT		GetLayer(VUINT64 nKey);
+	VUINT				GetMaterial(VUINT64 nKey) const;
+	VUINT				GetTexture(VUINT64 nKey) const;
+
+	/*==================================*
+	 *			  OPERATIONS			*
+	 *==================================*/
+	void				Push(VUINT64 nKey, VUINT nMaterial, VUINT nTexture,
+								VMeshHandle hMesh, const VMatrix *pWorld = NULL,
+								VUINT nFirst = 0, VUINT nCount = 0);
+	void				Sort();
+	void				Clear();
+
+protected:
+	/*==================================*
+	 *             CALLBACKS			*
+	 *==================================*/
+
+private:
+	/*==================================*
+	 *             INTERNALS            *
+	 *==================================*/
+	struct VSortEntry
+	{
+		VUINT64	mKey;
+		VUINT	mItem;
+	};
+
+	VRenderQueue(const VRenderQueue&);
+	const VRenderQueue&	operator=(const VRenderQueue&);
+
+private:
+	/*==================================*
+	 *             VARIABLES            *
+	 *==================================*/
+	std::vector<VRenderItem>	mItems;		/**< in the order pushed */
+	std::vector<VSortEntry>		mOrder;		/**< sorted keys, once sorted */
+	std::vector<VSortEntry>		mScratch;	/**< other half of the sort */
+	std::vector<VMatrix>		mWorlds;	/**< 0 is the identity */
+	std::vector<VUINT>			mFirsts;	/**< ranges of a merged draw */
+	std::vector<VUINT>			mCounts;
+	bool						mSorted;
+	VUINT						mBackToFront;	/**< one bit per layer */
+	VVector						mEye;
+	float						mInvFar;
+	VRenderStats				mStats;
+};
+
+inline
+VUINT VRenderQueue::GetCount() const
+{
+	return (VUINT)mItems.size();
+}
+
+/**
+ *	Item nIndex in sorted order; only valid after Sort().
+ */
+inline
+const VRenderItem& VRenderQueue::GetItem(VUINT nIndex) const
+{
+	return mItems[mOrder[nIndex].mItem];
+}
+
+inline
+const VMatrix& VRenderQueue::GetWorld(VUINT nWorld) const
+{
+	return mWorlds[nWorld];
+}
+
+inline
+const VRenderStats& VRenderQueue::GetStats() const
+{
+	return mStats;
+}
+
+inline
+bool VRenderQueue::IsBackToFront(VUINT nLayer) const
+{
+	return (mBackToFront & (1 << nLayer)) != 0;
+}
+
+inline
+VUINT VRenderQueue::GetLayer(VUINT64 nKey)
+{
+	return (VUINT)(nKey >> (64 - VQUEUE_LAYER_BITS));
+}
+
+} // End Namespace
+
+#endif // __RENDERQUEUE_H_INCLUDED__
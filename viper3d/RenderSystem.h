@@ -31,6 +31,58 @@
 namespace UDP
 {
 
+class VRenderQueue;
+
+/**
+ *	Identifies a mesh owned by a VRenderSystem.  Zero is never a valid
+ *	mesh.
+ */
+typedef VUINT VMeshHandle;
+
+/**
+ *	Components of a mesh vertex.  The ones present are packed in this
+ *	order with no padding, so a vertex is GetVertexSize() bytes.
+ */
+enum VVertexFormat
+{
+	VERTEX_POSITION	= 0x01,		/**< 3 floats, always present */
+	VERTEX_NORMAL	= 0x02,		/**< 3 floats */
+	VERTEX_COLOR	= 0x04,		/**< 4 bytes, RGBA */
+	VERTEX_TEXCOORD	= 0x08		/**< 2 floats */
+};
+
+enum VPrimitive
+{
+	PRIM_POINTS,
+	PRIM_LINES,
+	PRIM_TRIANGLES
+};
+
+/**
+ *	How often a mesh's contents are expected to change.
+ */
+enum VBufferUsage
+{
+	BUFFER_STATIC,				/**< set once, drawn many times */
+	BUFFER_DYNAMIC,				/**< changed every few frames */
+	BUFFER_STREAM				/**< replaced every frame */
+};
+
+/**
+ *	Everything about a mesh except its contents.
+ */
+struct VMeshDesc
+{
+	VMeshDesc() : mFormat(VERTEX_POSITION), mPrimitive(PRIM_TRIANGLES),
+					mUsage(BUFFER_STATIC), mNumVerts(0), mNumIndis(0) {}
+
+	VUINT			mFormat;	/**< VVertexFormat flags */
+	VPrimitive		mPrimitive;
+	VBufferUsage	mUsage;
+	VUINT			mNumVerts;
+	VUINT			mNumIndis;	/**< 0 to draw the vertices in order */
+};
+
 /**
  *	@class		VRenderSystem
  *
@@ -64,13 +116,105 @@ public:
 	/*==================================*
 	 *			  ATTRIBUTES			*
 	 *==================================*/
+	static VUINT			GetVertexSize(VUINT nFormat);
 
 	/*==================================*
 	 *			  OPERATIONS			*
 	 *==================================*/
 	virtual VWindow *		CreateWin(VWindowOpts *pOpts) = 0;
 	virtual void			DestroyWin(VWindow *pWin) = 0;
-	virtual bool			Render(VWindow *pWin, VCamera *pCamera) = 0;
+	/**
+	 *	@brief		Draws a frame and presents it.
+	 *	@author		Josh Williams
+	 *	@date		2004-Aug-31
+	 *
+	 *	@param		pWin	Window to draw into
+	 *	@param		pCamera	Camera to draw from
+	 *	@param		pQueue	Optional; drawn with DrawQueue() before the
+	 *						frame is presented
+	 *
+	 *	@returns	(bool) false if the frame could not be drawn
+	 */
+	virtual bool			Render(VWindow *pWin, VCamera *pCamera,
+									VRenderQueue *pQueue = NULL) = 0;
+	/**
+	 *	@brief		Creates a mesh in memory the device can draw from.
+	 *	@date		17-Oct-2026
+	 *
+	 *	@remarks	desc.mNumVerts and desc.mNumIndis give the size the
+	 *				mesh starts at; UpdateMesh() can grow it.  A window
+	 *				must have been created first.
+	 *
+	 *	@param		desc	Layout, primitive, usage and size
+	 *	@param		pVerts	desc.mNumVerts packed vertices, or NULL to
+	 *						leave them undefined until UpdateMesh()
+	 *	@param		pIndis	desc.mNumIndis indices, or NULL
+	 *
+	 *	@returns	(VMeshHandle) The new mesh, or 0 on failure
+	 */
+	virtual VMeshHandle		CreateMesh(const VMeshDesc& desc, const void *pVerts,
+									const VUINT *pIndis) = 0;
+	/**
+	 *	@brief		Replaces the contents of a mesh.
+	 *	@date		17-Oct-2026
+	 *
+	 *	@remarks	The new contents may be smaller or larger than the
+	 *				old ones.  Draws already submitted still see the old
+	 *				contents, so a stream mesh can be refilled every
+	 *				frame without waiting on the device.
+	 *
+	 *	@param		hMesh		Mesh to update
+	 *	@param		pVerts		nNumVerts packed vertices
+	 *	@param		nNumVerts	Vertex count
+	 *	@param		pIndis		nNumIndis indices, or NULL to keep the
+	 *							current ones
+	 *	@param		nNumIndis	Index count
+	 *
+	 *	@returns	(bool) false if hMesh is not a mesh
+	 */
+	virtual bool			UpdateMesh(VMeshHandle hMesh, const void *pVerts,
+									VUINT nNumVerts, const VUINT *pIndis = NULL,
+									VUINT nNumIndis = 0) = 0;
+	virtual void			DestroyMesh(VMeshHandle hMesh) = 0;
+	/**
+	 *	@brief		Sets the transform from object to world space used
+	 *				by the following DrawMesh() calls.
+	 *	@date		17-Oct-2026
+	 *
+	 *	@remarks	Render() resets it to the identity after the camera.
+	 */
+	virtual void			SetWorldMatrix(const VMatrix& mat) = 0;
+	/**
+	 *	@brief		Draws the whole of a mesh.
+	 *	@date		17-Oct-2026
+	 *
+	 *	@returns	(bool) false if hMesh is not a mesh
+	 */
+	virtual bool			DrawMesh(VMeshHandle hMesh) = 0;
+	/**
+	 *	@brief		Draws several ranges of one mesh in a single call.
+	 *	@date		17-Oct-2026
+	 *
+	 *	@param		hMesh		Mesh to draw
+	 *	@param		pFirsts		First index (or vertex, for a mesh with no
+	 *							indices) of each range
+	 *	@param		pCounts		Length of each range, 0 for the whole mesh
+	 *	@param		nRanges		Number of ranges
+	 *
+	 *	@returns	(bool) false if hMesh is not a mesh
+	 */
+	virtual bool			DrawMeshRanges(VMeshHandle hMesh, const VUINT *pFirsts,
+									const VUINT *pCounts, VUINT nRanges) = 0;
+	/**
+	 *	@brief		Sets the material and texture the following draws
+	 *				use.
+	 *	@date		17-Oct-2026
+	 *
+	 *	@remarks	Ids are the ones packed into VRenderQueue keys; what
+	 *				they name is up to the render system.  0 is none.
+	 */
+	virtual void			SetState(VUINT nMaterial, VUINT nTexture) = 0;
+	void					DrawQueue(VRenderQueue *pQueue);
 
 protected:
 	/*==================================*
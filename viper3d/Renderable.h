@@ -49,7 +49,7 @@ protected:
 	 *	@remarks	Constructor is protected to prevent instances of this class
 	 *				from being created directly.  Derived classes should be used.
 	 */
-	VRenderable() { }
+	VRenderable() : mSize(0.0f), mRenderMethod(RENDER_SOLID), mDelete(false) { }
 	virtual ~VRenderable() {};		
 
 public:
@@ -0,0 +1,160 @@
+/*============================================================================*
+ *                                                                            *
+ *  This file is part of the Viper3D Game Engine.                             *
+ *                                                                            *
+ *  Copyright (C) 2004 UDP Games   All Rights Reserved.                       *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------  ------------- *
+ *                                                                            *
+ *============================================================================*/
+#if !defined(__SCENEBVH_H_INCLUDED__)
+#define __SCENEBVH_H_INCLUDED__
+
+/* System Headers */
+#include <vector>
+
+/* Local Headers */
+#include <viper3d/Globals.h>
+#include <viper3d/Node.h>
+#include <viper3d/math/Bvh.h>
+
+namespace UDP
+{
+
+/**
+ *	@class		VSceneBvh
+ *
+ *	@brief		Bounding volume hierarchy over the nodes of a scene.
+ *	@version	0.1.0
+ *	@date		17-Oct-2026
+ *	@remarks	Indexes every node under a root that reports bounds through
+ *				VNode::GetBounds().  Nodes that move flag themselves, and
+ *				the next query or Update() refits just their paths; Update()
+ *				also rebuilds the tree once refitting has degraded it.
+ *				Nodes attached or detached after Build() are only picked up
+ *				by the next Build().
+ */
+class VSceneBvh
+{
+public:
+	/*==================================*
+	 *	   CONSTRUCTION/DESTRUCTION		*
+	 *==================================*/
+	VSceneBvh();
+	virtual ~VSceneBvh();
+
+	/*==================================*
+	 *			  ATTRIBUTES			*
+	 *==================================*/
+	/**
+	 *	@brief		Returns the root the hierarchy was built from.
+	 *	@date		17-Oct-2026
+	 *
+	 *	@returns	(VNode*) Scene root, or NULL
+	 */
+	VNode*			GetRoot() { return mRoot; }
+	/**
+	 *	@brief		Returns the underlying box hierarchy.
+	 *	@date		17-Oct-2026
+	 *
+	 *	@returns	(const VBvh&) Hierarchy, items numbered as nodes
+	 */
+	const VBvh&		GetBvh() const { return mBvh; }
+
+	/*==================================*
+	 *			  OPERATIONS			*
+	 *==================================*/
+	/**
+	 *	@brief		Indexes every bounded node under (and including)
+	 *				pRoot.
+	 *	@date		17-Oct-2026
+	 *
+	 *	@param		pRoot	Top of the scene
+	 *
+	 *	@returns	void
+	 */
+	void			Build(VNode *pRoot);
+	/**
+	 *	@brief		Forgets every node.
+	 *	@date		17-Oct-2026
+	 *
+	 *	@returns	void
+	 */
+	void			Clear();
+	/**
+	 *	@brief		Refits moved nodes, and rebuilds if the tree has
+	 *				degraded.  Call once per frame.
+	 *	@date		17-Oct-2026
+	 *
+	 *	@param		fRatio	Allowed growth of the tree cost before a
+	 *						rebuild
+	 *
+	 *	@returns	(bool) True if the tree was rebuilt
+	 */
+	bool			Update(float fRatio = 1.5f);
+	/**
+	 *	@brief		Collects the nodes not culled by a set of planes.
+	 *	@date		17-Oct-2026
+	 *
+	 *	@param		pPlanes		Planes, normals pointing out of the volume
+	 *	@param		nNumPlanes	Number of planes
+	 *	@param		vNodes		Receives the visible nodes
+	 *
+	 *	@returns	void
+	 */
+	void			Cull(const VPlane *pPlanes, int nNumPlanes,
+							std::vector<VNode*> &vNodes);
+	/**
+	 *	@brief		Finds the nearest node whose bounds a ray hits.
+	 *	@date		17-Oct-2026
+	 *
+	 *	@param		ray		Pick ray
+	 *	@param		t		Optional; receives the distance along the ray
+	 *
+	 *	@returns	(VNode*) Nearest node hit, or NULL
+	 */
+	VNode*			Pick(const VRay &ray, float *t = NULL);
+	/**
+	 *	@brief		Collects the nodes whose bounds overlap a box.
+	 *	@date		17-Oct-2026
+	 *
+	 *	@param		box		Box to test
+	 *	@param		vNodes	Receives the overlapping nodes
+	 *
+	 *	@returns	void
+	 */
+	void			Overlap(const VAabb &box, std::vector<VNode*> &vNodes);
+
+protected:
+	/*==================================*
+	 *             CALLBACKS			*
+	 *==================================*/
+
+private:
+	/*==================================*
+	 *             INTERNALS            *
+	 *==================================*/
+	friend class VNode;
+	void			Invalidate(VNode *pNode);
+	void			Remove(VNode *pNode);
+	void			Refit();
+	void			Gather(std::vector<VNode*> &vNodes);
+
+private:
+	/*==================================*
+	 *             VARIABLES            *
+	 *==================================*/
+	VBvh				mBvh;
+	VNode				*mRoot;
+	std::vector<VNode*>	mNodes;		/**< node for each item, NULL if deleted */
+	std::vector<char>	mDirty;		/**< item has moved since the last refit */
+	std::vector<VUINT>	mMoved;		/**< items flagged in mDirty */
+	std::vector<VUINT>	mItems;		/**< query scratch */
+};
+
+} // End Namespace
+
+#endif // __SCENEBVH_H_INCLUDED__
@@ -21,6 +21,11 @@ typedef unsigned short			VUSHORT;
 typedef unsigned int			VUINT;
 typedef unsigned long			VULONG;
 typedef unsigned char			VBYTE;
+#if defined(_MSC_VER)
+typedef unsigned __int64		VUINT64;
+#else
+typedef unsigned long long		VUINT64;
+#endif
 typedef float					scalar_t;
 
 namespace UDP
@@ -153,6 +158,17 @@ public:
 	VKeyCode	mCode;
 };
 
+/*
+ *	Accuracy of the VMath transcendental functions.  See MathApprox.inl
+ *	for the methods and VMath for the measured errors.
+ */
+enum VMathAccuracy
+{
+	MATH_EXACT = 0,		/* the C library */
+	MATH_PRECISE,		/* polynomials, within about 1e-6 */
+	MATH_FAST			/* polynomials, within about 1e-3 */
+};
+
 } // End Namespace
 
 #endif // __TYPES_H_INCLUDED__
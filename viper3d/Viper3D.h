@@ -51,7 +51,7 @@ public:
 	/*==================================*
 	 *			  OPERATIONS			*
 	 *==================================*/
-	VRenderSystem*		CreateRenderer(char *pAPI);
+	VRenderSystem*		CreateRenderer(const char *pAPI);
 	void				DestroyRenderer();
 	 /*
 	bool				Create(int pWidth = 800, int pHeight = 600, bool pFullScreen = false);
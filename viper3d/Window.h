@@ -31,9 +31,13 @@ namespace UDP
 class VWindowOpts
 {
 public:
+	VWindowOpts() : mWidth(800), mHeight(600), mFullScreen(false),
+					mOffscreen(false) {}
+
 	int			mWidth;
 	int			mHeight;
 	bool		mFullScreen;
+	bool		mOffscreen;		/**< render to memory, with no display */
 };
 
 class VRenderSystem;
@@ -59,6 +63,7 @@ public:
 	 *			  ATTRIBUTES			*
 	 *==================================*/
 	bool				IsFullScreen(void) const;
+	bool				IsOffscreen(void) const;
 
 	/*==================================*
 	 *			  OPERATIONS			*
@@ -103,6 +108,12 @@ bool VWindow::IsFullScreen(void) const
 	return mOpts.mFullScreen;
 }
 
+inline
+bool VWindow::IsOffscreen(void) const
+{
+	return mOpts.mOffscreen;
+}
+
 } // End Namespace
 
 #endif // __WINDOW_H_INCLUDED__
@@ -0,0 +1,127 @@
+/*============================================================================*
+ *                                                                            *
+ * 	This file is part of the Viper3D Game Engine.							  *
+ *                                                                            *
+ *	Copyright (C) 2004 UDP Games   All Rights Reserved.						  *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------	------------- *
+ *                                                                            *
+ *============================================================================*/
+#if !defined(__VAABBBATCH_H_INCLUDED__)
+#define __VAABBBATCH_H_INCLUDED__
+
+/* System Headers */
+#include <vector>
+
+/* Local Headers */
+#include <viper3d/math/VectorBatch.h>
+#include <viper3d/math/SlabRay.h>
+#include <viper3d/util/JobSystem.h>
+
+/* Defines */
+#define VAABB_CULL_GRAIN	4096	/* boxes per culling job, a multiple of 32 */
+
+namespace UDP
+{
+
+/**
+ *	@class		VAabbBatch
+ *
+ *	@brief		Structure-of-arrays collection of axis-aligned boxes.
+ *	@version	0.1.0
+ *	@date		17-Oct-2026
+ *	@remarks	Stores the min and max corners as two VVectorBatch, so a
+ *				whole set of boxes can be culled against a frustum with
+ *				one SIMD pass.  The classification matches VAabb::Cull()
+ *				exactly.  The VJobSystem overloads split the pass over
+ *				every thread and give the same results as the serial
+ *				versions.  RayMask() and Intersects() test one VSlabRay
+ *				against every box the same way, for the leaves and
+ *				nodes of a hierarchy built over the boxes.  Nothing is
+ *				kept between calls, so several threads may cull one
+ *				batch at once.
+ */
+class VAabbBatch
+{
+public:
+	/*==================================*
+	 *	   CONSTRUCTION/DESTRUCTION		*
+	 *==================================*/
+	VAabbBatch(VUINT nCount = 0);
+	VAabbBatch(const VAabb *pBoxes, VUINT nCount);
+	~VAabbBatch();
+
+	/*==================================*
+	 *			  ATTRIBUTES			*
+	 *==================================*/
+	VUINT				Count() const;
+	VVectorBatch&		Min();
+	VVectorBatch&		Max();
+	const VVectorBatch&	Min() const;
+	const VVectorBatch&	Max() const;
+	VAabb				Get(VUINT nIndex) const;
+	void				Set(VUINT nIndex, const VAabb &aabb);
+	static VUINT		MaskWords(VUINT nCount);
+
+	/*==================================*
+	 *			  OPERATIONS			*
+	 *==================================*/
+	void				Resize(VUINT nCount);
+	void				FromAabbs(const VAabb *pBoxes, VUINT nCount);
+	void				CullMask(const VPlane *pPlanes, int nNumPlanes,
+								VUINT *pVisible, VUINT *pClipped = NULL) const;
+	VUINT				Cull(const VPlane *pPlanes, int nNumPlanes,
+								VUINT *pIndices) const;
+	void				CullMask(const VPlane *pPlanes, int nNumPlanes,
+								VUINT *pVisible, VUINT *pClipped,
+								VJobSystem &jobs) const;
+	VUINT				Cull(const VPlane *pPlanes, int nNumPlanes,
+								VUINT *pIndices, VJobSystem &jobs) const;
+	void				Classify(const VPlane *pPlanes, int nNumPlanes,
+								VBYTE *pResults) const;
+	void				RayMask(const VSlabRay &ray, float fL, VUINT *pHits,
+								float *pEnter = NULL) const;
+	VUINT				Intersects(const VSlabRay &ray, float fL,
+								VUINT *pIndices, float *pT = NULL) const;
+
+protected:
+	/*==================================*
+	 *             CALLBACKS			*
+	 *==================================*/
+
+private:
+	/*==================================*
+	 *             INTERNALS            *
+	 *==================================*/
+
+private:
+	/*==================================*
+	 *             VARIABLES            *
+	 *==================================*/
+	VVectorBatch				mMin;
+	VVectorBatch				mMax;
+};
+
+inline
+VUINT VAabbBatch::Count() const
+{
+	return mMin.Count();
+}
+
+inline VVectorBatch& VAabbBatch::Min() { return mMin; }
+inline VVectorBatch& VAabbBatch::Max() { return mMax; }
+inline const VVectorBatch& VAabbBatch::Min() const { return mMin; }
+inline const VVectorBatch& VAabbBatch::Max() const { return mMax; }
+
+inline
+VUINT VAabbBatch::MaskWords(VUINT nCount)
+{
+	return (nCount + 31) >> 5;
+}
+
+} // End Namespace
+
+#endif // __VAABBBATCH_H_INCLUDED__
@@ -0,0 +1,276 @@
+/*============================================================================*
+ *                                                                            *
+ * 	This file is part of the Viper3D Game Engine.							  *
+ *                                                                            *
+ *	Copyright (C) 2004 UDP Games   All Rights Reserved.						  *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------	------------- *
+ *                                                                            *
+ *============================================================================*/
+#if !defined(__VBROADPHASE_H_INCLUDED__)
+#define __VBROADPHASE_H_INCLUDED__
+
+/* System Headers */
+#include <vector>
+
+/* Local Headers */
+#include <viper3d/Math.h>
+
+/* Defines */
+#define VBROAD_INVALID		0xFFFFFFFFu
+
+namespace UDP
+{
+
+/**
+ *	Two proxies whose boxes overlap, with mA < mB.
+ */
+struct VBroadPair
+{
+	VUINT	mA;
+	VUINT	mB;
+};
+
+/**
+ *	Bounds of one proxy, kept as plain floats so the broad phases can
+ *	index them by axis.
+ */
+struct VBroadBox
+{
+	float	mMin[3];
+	float	mMax[3];
+};
+
+/**
+ *	@class		VBroadphase
+ *
+ *	@brief		Finds the pairs of overlapping boxes in a changing set.
+ *	@version	0.1.0
+ *	@date		17-Oct-2026
+ *	@remarks	Boxes are added as proxies, then moved or removed by the
+ *				handle AddProxy() returns.  Update() brings the pair list
+ *				up to date with every change since the last call; the
+ *				pairs are those VAabb::Intersects() would report, so
+ *				touching boxes count.  Handles of removed proxies are
+ *				only handed out again after the next Update().
+ */
+class VBroadphase
+{
+public:
+	/*==================================*
+	 *	   CONSTRUCTION/DESTRUCTION		*
+	 *==================================*/
+	VBroadphase();
+	virtual ~VBroadphase();
+
+	/*==================================*
+	 *			  ATTRIBUTES			*
+	 *==================================*/
+	VUINT				ProxyCount() const;
+	bool				IsValid(VUINT nProxy) const;
+	VAabb				GetBox(VUINT nProxy) const;
+	VUINT				PairCount() const;
+	const VBroadPair*	GetPairs() const;
+
+	/*==================================*
+	 *			  OPERATIONS			*
+	 *==================================*/
+	VUINT				AddProxy(const VAabb &box);
+	void				MoveProxy(VUINT nProxy, const VAabb &box);
+	void				RemoveProxy(VUINT nProxy);
+	void				Update();
+	void				Clear();
+
+protected:
+	/*==================================*
+	 *             CALLBACKS			*
+	 *==================================*/
+	virtual void		UpdatePairs() = 0;
+	virtual void		OnClear() = 0;
+
+	/*==================================*
+	 *             INTERNALS            *
+	 *==================================*/
+	bool				Overlaps(VUINT nA, VUINT nB) const;
+
+protected:
+	/*==================================*
+	 *             VARIABLES            *
+	 *==================================*/
+	std::vector<VBroadBox>		mBoxes;		/**< by proxy */
+	std::vector<unsigned char>	mLive;		/**< 1 for proxies in use */
+	std::vector<VUINT>			mAdded;		/**< since the last Update() */
+	std::vector<VUINT>			mRemoved;	/**< since the last Update() */
+	std::vector<VUINT>			mFree;		/**< handles to reuse */
+	std::vector<VBroadPair>		mPairs;
+	VUINT						mCount;		/**< live proxies */
+};
+
+/**
+ *	@class		VSweepPrune
+ *
+ *	@brief		Incremental sweep and prune on all three axes.
+ *	@version	0.1.0
+ *	@date		17-Oct-2026
+ *	@remarks	Keeps the box ends sorted along x, y and z.  Boxes move a
+ *				little from one frame to the next, so Update() re-sorts
+ *				with an insertion sort that does close to linear work,
+ *				and each swap of a start past an end is exactly a pair
+ *				that may have begun or stopped overlapping.  Pairs
+ *				therefore persist between frames and only the changes
+ *				cost anything.  When many proxies arrive at once the
+ *				axes are sorted from scratch instead.
+ */
+class VSweepPrune : public VBroadphase
+{
+public:
+	/*==================================*
+	 *	   CONSTRUCTION/DESTRUCTION		*
+	 *==================================*/
+	VSweepPrune();
+	virtual ~VSweepPrune();
+
+protected:
+	/*==================================*
+	 *             CALLBACKS			*
+	 *==================================*/
+	virtual void		UpdatePairs();
+	virtual void		OnClear();
+
+private:
+	/*==================================*
+	 *             INTERNALS            *
+	 *==================================*/
+	struct VEnd
+	{
+		float	mValue;
+		VUINT	mData;		/**< proxy << 1, low bit set for a max */
+	};
+
+	static bool			Less(const VEnd &a, const VEnd &b);
+	void				Rebuild();
+	void				Refresh(int nAxis);
+	void				Sort(int nAxis);
+	void				AddPair(VUINT nA, VUINT nB);
+	void				RemovePair(VUINT nA, VUINT nB);
+	VUINT				FindSlot(VUINT nA, VUINT nB) const;
+	void				GrowTable();
+
+private:
+	/*==================================*
+	 *             VARIABLES            *
+	 *==================================*/
+	std::vector<VEnd>	mEnds[3];	/**< sorted ends along each axis */
+	std::vector<VUINT>	mTable;		/**< open addressed index into mPairs */
+	std::vector<VUINT>	mActive;	/**< sweep list while rebuilding */
+	std::vector<VUINT>	mSlot;		/**< position of a proxy in mActive */
+};
+
+/**
+ *	@class		VHashGrid
+ *
+ *	@brief		Uniform grid of cubic cells, hashed into buckets.
+ *	@version	0.1.0
+ *	@date		17-Oct-2026
+ *	@remarks	Update() drops every box into the cells it touches and
+ *				tests the boxes sharing a cell.  A pair is reported only
+ *				by the cell holding the low corner of the two boxes'
+ *				overlap, so nothing is reported twice.  Nothing carries
+ *				over from frame to frame, which makes it the better
+ *				choice when boxes jump around, but it needs a cell size
+ *				near that of a typical box: big boxes cover many cells.
+ */
+class VHashGrid : public VBroadphase
+{
+public:
+	/*==================================*
+	 *	   CONSTRUCTION/DESTRUCTION		*
+	 *==================================*/
+	VHashGrid(float fCellSize = 1.0f);
+	virtual ~VHashGrid();
+
+	/*==================================*
+	 *			  ATTRIBUTES			*
+	 *==================================*/
+	float				GetCellSize() const;
+	void				SetCellSize(float fCellSize);
+
+protected:
+	/*==================================*
+	 *             CALLBACKS			*
+	 *==================================*/
+	virtual void		UpdatePairs();
+	virtual void		OnClear();
+
+private:
+	/*==================================*
+	 *             INTERNALS            *
+	 *==================================*/
+	struct VEntry
+	{
+		int		mCell[3];
+		VUINT	mProxy;
+	};
+
+	int					CellOf(float fValue) const;
+	VUINT				Bucket(const int *pCell) const;
+
+private:
+	/*==================================*
+	 *             VARIABLES            *
+	 *==================================*/
+	float				mCellSize;
+	float				mInvCellSize;
+	VUINT				mMask;		/**< bucket count less one */
+	std::vector<VEntry>	mEntries;	/**< one per cell a box touches */
+	std::vector<VEntry>	mSorted;	/**< the same, by bucket */
+	std::vector<VUINT>	mStart;		/**< first of each bucket in mSorted */
+};
+
+inline
+VUINT VBroadphase::ProxyCount() const
+{
+	return mCount;
+}
+
+inline
+bool VBroadphase::IsValid(VUINT nProxy) const
+{
+	return nProxy < mLive.size() && mLive[nProxy] != 0;
+}
+
+inline
+VUINT VBroadphase::PairCount() const
+{
+	return (VUINT)mPairs.size();
+}
+
+inline
+const VBroadPair* VBroadphase::GetPairs() const
+{
+	return mPairs.empty() ? NULL : &mPairs[0];
+}
+
+inline
+bool VBroadphase::Overlaps(VUINT nA, VUINT nB) const
+{
+	const VBroadBox &a = mBoxes[nA];
+	const VBroadBox &b = mBoxes[nB];
+
+	return a.mMin[0] <= b.mMax[0] && b.mMin[0] <= a.mMax[0] &&
+		a.mMin[1] <= b.mMax[1] && b.mMin[1] <= a.mMax[1] &&
+		a.mMin[2] <= b.mMax[2] && b.mMin[2] <= a.mMax[2];
+}
+
+inline
+float VHashGrid::GetCellSize() const
+{
+	return mCellSize;
+}
+
+} // End Namespace
+
+#endif // __VBROADPHASE_H_INCLUDED__
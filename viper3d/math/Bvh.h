@@ -0,0 +1,153 @@
+/*============================================================================*
+ *                                                                            *
+ * 	This file is part of the Viper3D Game Engine.							  *
+ *                                                                            *
+ *	Copyright (C) 2004 UDP Games   All Rights Reserved.						  *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------	------------- *
+ *                                                                            *
+ *============================================================================*/
+#if !defined(__VBVH_H_INCLUDED__)
+#define __VBVH_H_INCLUDED__
+
+/* System Headers */
+#include <vector>
+
+/* Local Headers */
+#include <viper3d/Math.h>
+
+/* Defines */
+#define VBVH_BINS			12		/* SAH buckets per split axis */
+#define VBVH_LEAF_SIZE		4		/* most items kept in one leaf */
+#define VBVH_INVALID		0xFFFFFFFFu
+
+namespace UDP
+{
+
+/**
+ *	One node of a VBvh.  Children of an interior node are stored next to
+ *	each other, so only the first needs to be recorded.
+ */
+struct VBvhNode
+{
+	float	mMin[3];
+	VUINT	mFirst;		/**< first item of a leaf, or left child */
+	float	mMax[3];
+	VUINT	mCount;		/**< items in a leaf, 0 for interior nodes */
+};
+
+/**
+ *	@class		VBvh
+ *
+ *	@brief		Bounding volume hierarchy over a set of axis-aligned boxes.
+ *	@version	0.1.0
+ *	@date		17-Oct-2026
+ *	@remarks	Built top-down with a binned surface area heuristic.  Items
+ *				are referred to by their index in the array passed to
+ *				Build().  When boxes move, Update() refits just the path
+ *				from the item's leaf to the root; once the tree has drifted
+ *				far enough from its built quality, Rebuild() starts over.
+ */
+class VBvh
+{
+public:
+	/*==================================*
+	 *	   CONSTRUCTION/DESTRUCTION		*
+	 *==================================*/
+	VBvh();
+	~VBvh();
+
+	/*==================================*
+	 *			  ATTRIBUTES			*
+	 *==================================*/
+	VUINT			Count() const;
+	VUINT			NodeCount() const;
+	const VAabb&	GetBox(VUINT nItem) const;
+	const VBvhNode*	GetNodes() const;
+	const VUINT*	GetItems() const;
+	float			Cost() const;
+	bool			IsDegraded(float fRatio = 1.5f) const;
+
+	/*==================================*
+	 *			  OPERATIONS			*
+	 *==================================*/
+	void			Build(const VAabb *pBoxes, VUINT nCount);
+	void			Rebuild();
+	void			Update(VUINT nItem, const VAabb &box);
+	void			Refit();
+	void			Cull(const VPlane *pPlanes, int nNumPlanes,
+							std::vector<VUINT> &vItems) const;
+	void			Intersects(const VRay &ray,
+							std::vector<VUINT> &vItems) const;
+	bool			Pick(const VRay &ray, VUINT *pItem, float *t) const;
+	void			Overlap(const VAabb &box, std::vector<VUINT> &vItems) const;
+
+protected:
+	/*==================================*
+	 *             CALLBACKS			*
+	 *==================================*/
+
+private:
+	/*==================================*
+	 *             INTERNALS            *
+	 *==================================*/
+	void			Split(VUINT nNode, VUINT nFirst, VUINT nCount, int nDepth);
+	void			FitLeaf(VUINT nNode);
+	void			FitInterior(VUINT nNode);
+	void			AddSubtree(VUINT nNode, std::vector<VUINT> &vItems) const;
+	void			SumCost();
+
+private:
+	/*==================================*
+	 *             VARIABLES            *
+	 *==================================*/
+	std::vector<VAabb>		mBoxes;		/**< item bounds, by item */
+	std::vector<float>		mCenters;	/**< build-time centroids, 3 per item */
+	std::vector<VUINT>		mItems;		/**< item indices in leaf order */
+	std::vector<VUINT>		mLeaf;		/**< leaf holding each item */
+	std::vector<VUINT>		mParent;	/**< parent of each node */
+	std::vector<VBvhNode>	mNodes;
+	float					mBuildCost;	/**< Cost() right after building */
+	double					mCost;		/**< Cost() before scaling by the root */
+};
+
+inline
+VUINT VBvh::Count() const
+{
+	return (VUINT)mBoxes.size();
+}
+
+inline
+VUINT VBvh::NodeCount() const
+{
+	return (VUINT)mNodes.size();
+}
+
+inline
+const VAabb& VBvh::GetBox(VUINT nItem) const
+{
+	return mBoxes[nItem];
+}
+
+inline
+const VBvhNode* VBvh::GetNodes() const
+{
+	return mNodes.empty() ? NULL : &mNodes[0];
+}
+
+/**
+ *	Item indices in leaf order; a leaf holds items mFirst up to
+ *	mFirst + mCount of this array.
+ */
+inline
+const VUINT* VBvh::GetItems() const
+{
+	return mItems.empty() ? NULL : &mItems[0];
+}
+
+} // End Namespace
+
+#endif // __VBVH_H_INCLUDED__
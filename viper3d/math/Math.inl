@@ -0,0 +1,433 @@
+/*============================================================================*
+ *                                                                            *
+ * 	This file is part of the Viper3D Game Engine.							  *
+ *                                                                            *
+ *	Copyright (C) 2004 UDP Games   All Rights Reserved.						  *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------	------------- *
+ *                                                                            *
+ *============================================================================*/
+/*
+ * The small VMath, VVector, VQuaternion, VMatrix and VAffine operations,
+ * inline so callers outside libviper3dmath can keep values in registers
+ * instead of calling through the PLT for every add.  Only included by
+ * Math.h, after all of the classes are declared.
+ *
+ * None of these classes declare a copy constructor, assignment operator
+ * or destructor, so they are trivially copyable.  Built as C++11 or later,
+ * VCONSTEXPR makes the constructors and the operators that return by value
+ * constexpr, so constants such as VVector::VECTOR_UNIT_Z are laid out at
+ * compile time; a C++98 build still fills them in at startup, but with
+ * plain stores rather than calls.  Anything that loops, dispatches through
+ * VSimd or calls the C library for more than one instruction stays in the
+ * .cpp files.
+ */
+
+/* System Headers */
+#include <cmath>
+
+namespace UDP
+{
+
+/********************************************************************
+ *                             V M A T H                            *
+ ********************************************************************/
+inline
+float VMath::Abs(float fValue)
+{
+	return fabsf(fValue);
+}
+
+inline
+float VMath::Sqrt(float fValue)
+{
+	return sqrtf(fValue);
+}
+
+inline
+float VMath::DegToRad(float degrees)
+{
+	return degrees * (3.14159265358979324f / 180.0f);
+}
+
+inline
+float VMath::RadToDeg(float radians)
+{
+	return (radians * 180.0f) / 3.14159265358979324f;
+}
+
+/********************************************************************
+ *                           V V E C T O R                          *
+ ********************************************************************/
+VCONSTEXPR
+VVector::VVector(float _x /*=0*/, float _y /*=0*/, float _z /*=0*/, float _w /*=0*/)
+: x(_x), y(_y), z(_z), w(_w)
+{
+}
+
+VCONSTEXPR
+float VVector::SquaredLength() const
+{
+	return x*x + y*y + z*z;
+}
+
+inline
+void VVector::SetValues(float _x, float _y, float _z, float _w /*=0*/)
+{
+	x = _x;
+	y = _y;
+	z = _z;
+	w = _w;
+}
+
+inline
+void VVector::Negate()
+{
+	x = -x;
+	y = -y;
+	z = -z;
+}
+
+inline
+void VVector::Difference(const VVector& v1, const VVector& v2)
+{
+	x = v2.x - v1.x;
+	y = v2.y - v1.y;
+	z = v2.z - v1.z;
+	w = 1.0f;
+}
+
+VCONSTEXPR
+float VVector::DotProduct(const VVector& vec) const
+{
+	return x*vec.x + y*vec.y + z*vec.z;
+}
+
+VCONSTEXPR
+bool VVector::operator==(const VVector& vec) const
+{
+	return ((x == vec.x) && (y == vec.z) && (z == vec.z));
+}
+
+VCONSTEXPR
+bool VVector::operator!=(const VVector& vec) const
+{
+	return !(*this == vec);
+}
+
+inline
+const VVector& VVector::operator+=(const VVector& vec)
+{
+	x += vec.x;
+	y += vec.y;
+	z += vec.z;
+	return *this;
+}
+
+inline
+const VVector& VVector::operator-=(const VVector& vec)
+{
+	x -= vec.x;
+	y -= vec.y;
+	z -= vec.z;
+	return *this;
+}
+
+inline
+const VVector& VVector::operator*=(const float& s)
+{
+	x *= s;
+	y *= s;
+	z *= s;
+	return *this;
+}
+
+inline
+const VVector& VVector::operator/=(const float& s)
+{
+	x /= s;
+	y /= s;
+	z /= s;
+	return *this;
+}
+
+inline
+const VVector& VVector::operator+=(const float& s)
+{
+	x += s;
+	y += s;
+	z += s;
+	return *this;
+}
+
+inline
+const VVector& VVector::operator-=(const float& s)
+{
+	x -= s;
+	y -= s;
+	z -= s;
+	return *this;
+}
+
+VCONSTEXPR
+float VVector::operator*(const VVector& v) const
+{
+	return (v.x*x + v.y*y + v.z*z);
+}
+
+VCONSTEXPR
+VVector VVector::operator*(const float& s) const
+{
+	return VVector(x*s, y*s, z*s);
+}
+
+VCONSTEXPR
+VVector VVector::operator/(const float& s) const
+{
+	return VVector(x/s, y/s, z/s);
+}
+
+VCONSTEXPR
+VVector VVector::operator+(const float& s) const
+{
+	return VVector(x+s, y+s, z+s);
+}
+
+VCONSTEXPR
+VVector VVector::operator-(const float& s) const
+{
+	return VVector(x-s, y-s, z-s);
+}
+
+VCONSTEXPR
+VQuaternion VVector::operator*(const VQuaternion& q) const
+{
+	return VQuaternion(q.w*x + q.z*y - q.y*z,
+						q.w*y + q.x*z - q.z*x,
+						q.w*z + q.y*x - q.x*y,
+						-(q.x*x + q.y*y + q.z*z));
+}
+
+VCONSTEXPR
+VVector VVector::operator+(const VVector& vec) const
+{
+	return VVector(x + vec.x, y + vec.y, z + vec.z, 1.0f);
+}
+
+VCONSTEXPR
+VVector VVector::operator-(const VVector& vec) const
+{
+	return VVector(x - vec.x, y - vec.y, z - vec.z);
+}
+
+/********************************************************************
+ *                       V Q U A T E R N I O N                      *
+ ********************************************************************/
+VCONSTEXPR
+VQuaternion::VQuaternion(float _w /*=0*/, float _x /*=0*/, float _y /*=0*/, float _z /*=0*/)
+: x(_x), y(_y), z(_z), w(_w)
+{
+}
+
+VCONSTEXPR
+VQuaternion::VQuaternion(const VVector& v, const float& r)
+: x(v.x), y(v.y), z(v.z), w(r)
+{
+}
+
+VCONSTEXPR
+VVector VQuaternion::GetVector() const
+{
+	return VVector(x, y, z);
+}
+
+VCONSTEXPR
+float VQuaternion::GetScalar() const
+{
+	return w;
+}
+
+inline
+void VQuaternion::Conjugate(const VQuaternion& q)
+{
+	x = -q.x;
+	y = -q.y;
+	z = -q.z;
+	w = q.w;
+}
+
+inline
+VQuaternion& VQuaternion::operator*=(const float& s)
+{
+	w *= s;
+	x *= s;
+	y *= s;
+	z *= s;
+	return *this;
+}
+
+VCONSTEXPR
+VQuaternion VQuaternion::operator*(const float& s) const
+{
+	return VQuaternion(w*s, x*s, y*s, z*s);
+}
+
+inline
+VQuaternion& VQuaternion::operator/=(const float& s)
+{
+	w /= s;
+	x /= s;
+	y /= s;
+	z /= s;
+	return *this;
+}
+
+VCONSTEXPR
+VQuaternion VQuaternion::operator/(const float& s) const
+{
+	return VQuaternion(w/s, x/s, y/s, z/s);
+}
+
+/*
+ * Rotates pVec, v + 2w(u x v) + 2u x (u x v) with u the vector part.
+ */
+inline
+VVector VQuaternion::operator*(const VVector& pVec) const
+{
+	float fTx = 2.0f * (y * pVec.z - z * pVec.y);
+	float fTy = 2.0f * (z * pVec.x - x * pVec.z);
+	float fTz = 2.0f * (x * pVec.y - y * pVec.x);
+
+	return VVector(pVec.x + w * fTx + y * fTz - z * fTy,
+				   pVec.y + w * fTy + z * fTx - x * fTz,
+				   pVec.z + w * fTz + x * fTy - y * fTx,
+				   1.0f);
+}
+
+inline
+VQuaternion& VQuaternion::operator+=(const VQuaternion& q)
+{
+	w	+= q.w;
+	x	+= q.x;
+	y	+= q.y;
+	z	+= q.z;
+	return *this;
+}
+
+VCONSTEXPR
+VQuaternion VQuaternion::operator+(const VQuaternion& q) const
+{
+	return VQuaternion(w + q.w,
+						x + q.x,
+						y + q.y,
+						z + q.z);
+}
+
+inline
+VQuaternion& VQuaternion::operator-=(const VQuaternion& q)
+{
+	w -= q.w;
+	x -= q.x;
+	y -= q.y;
+	z -= q.z;
+	return *this;
+}
+
+VCONSTEXPR
+VQuaternion VQuaternion::operator-(const VQuaternion& q) const
+{
+	return VQuaternion(w - q.w,
+						x - q.x,
+						y - q.y,
+						z - q.z);
+}
+
+inline
+VQuaternion& VQuaternion::operator*=(const VQuaternion& q)
+{
+	w = q.w*w - q.x*x - q.y*y - q.z*z;
+	x = q.w*x + q.x*w + q.y*z - q.z*y;
+	y = q.w*y - q.x*z + q.y*w + q.z*x;
+	z = q.w*z + q.x*y - q.y*x + q.z*w;
+	return *this;
+}
+
+VCONSTEXPR
+VQuaternion VQuaternion::operator*(const VQuaternion& q) const
+{
+	return VQuaternion(
+		w*q.w - x*q.x - y*q.y - z*q.z,
+		w*q.x + x*q.w + y*q.z - z*q.y,
+		w*q.y + y*q.w + z*q.x - x*q.z,
+		w*q.z + z*q.w + x*q.y - y*q.x);
+}
+
+VCONSTEXPR
+VQuaternion VQuaternion::operator~() const
+{
+	return VQuaternion(w, -x, -y, -z);
+}
+
+/********************************************************************
+ *                           V M A T R I X                          *
+ ********************************************************************/
+inline
+VMatrix::VMatrix()
+{
+	for (int i = 0; i < 16; i++)
+		_m[i] = 0.0f;
+}
+
+inline
+VMatrix::VMatrix(float m00, float m01, float m02, float m03,
+				float m10, float m11, float m12, float m13,
+				float m20, float m21, float m22, float m23,
+				float m30, float m31, float m32, float m33)
+{
+	m[0][0] = m00;
+	m[0][1] = m01;
+	m[0][2] = m02;
+	m[0][3] = m03;
+	m[1][0] = m10;
+	m[1][1] = m11;
+	m[1][2] = m12;
+	m[1][3] = m13;
+	m[2][0] = m20;
+	m[2][1] = m21;
+	m[2][2] = m22;
+	m[2][3] = m23;
+	m[3][0] = m30;
+	m[3][1] = m31;
+	m[3][2] = m32;
+	m[3][3] = m33;
+}
+
+inline
+float* VMatrix::operator[](unsigned nRow)
+{
+	return m[nRow];
+}
+
+inline
+const float* const VMatrix::operator[](unsigned nRow) const
+{
+	return m[nRow];
+}
+
+/********************************************************************
+ *                           V A F F I N E                          *
+ ********************************************************************/
+inline
+VAffine::VAffine()
+{
+	for (int i = 0; i < 3; i++)
+	{
+		for (int j = 0; j < 4; j++)
+			m[i][j] = (i == j) ? 1.0f : 0.0f;
+	}
+}
+
+} // End Namespace
@@ -0,0 +1,114 @@
+/*============================================================================*
+ *                                                                            *
+ * 	This file is part of the Viper3D Game Engine.							  *
+ *                                                                            *
+ *	Copyright (C) 2004 UDP Games   All Rights Reserved.						  *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------	------------- *
+ *                                                                            *
+ *============================================================================*/
+#if !defined(__VOBBBATCH_H_INCLUDED__)
+#define __VOBBBATCH_H_INCLUDED__
+
+/* System Headers */
+#include <vector>
+
+/* Local Headers */
+#include <viper3d/math/VectorBatch.h>
+
+namespace UDP
+{
+
+/**
+ *	@class		VObbBatch
+ *
+ *	@brief		Structure-of-arrays collection of oriented boxes.
+ *	@version	0.1.0
+ *	@date		17-Oct-2026
+ *	@remarks	Keeps centres, axes and half lengths as VVectorBatch, so
+ *				the separating axis tests can run on a whole list of
+ *				pairs at once, one pair per SIMD lane: box i of this
+ *				batch against box i of another batch, or against
+ *				triangle i of three corner batches.  This is the
+ *				narrow phase after a broad phase has found the pairs;
+ *				gather each pair's boxes into the same index of two
+ *				batches.  The results match VObb::Intersects() exactly.
+ *				Nothing is kept between calls, so several threads may
+ *				test one batch at once.
+ */
+class VObbBatch
+{
+public:
+	/*==================================*
+	 *	   CONSTRUCTION/DESTRUCTION		*
+	 *==================================*/
+	VObbBatch(VUINT nCount = 0);
+	VObbBatch(const VObb *pBoxes, VUINT nCount);
+	~VObbBatch();
+
+	/*==================================*
+	 *			  ATTRIBUTES			*
+	 *==================================*/
+	VUINT				Count() const;
+	VObb				Get(VUINT nIndex) const;
+	void				Set(VUINT nIndex, const VObb &obb);
+	VSoAObb				SoA() const;
+	static VUINT		MaskWords(VUINT nCount);
+
+	/*==================================*
+	 *			  OPERATIONS			*
+	 *==================================*/
+	void				Resize(VUINT nCount);
+	void				FromObbs(const VObb *pBoxes, VUINT nCount);
+	void				IntersectMask(const VObbBatch &batch,
+								VUINT *pHits) const;
+	VUINT				Intersects(const VObbBatch &batch,
+								VUINT *pIndices) const;
+	void				IntersectMask(const VVectorBatch &v0,
+								const VVectorBatch &v1,
+								const VVectorBatch &v2,
+								VUINT *pHits) const;
+	VUINT				Intersects(const VVectorBatch &v0,
+								const VVectorBatch &v1,
+								const VVectorBatch &v2,
+								VUINT *pIndices) const;
+
+protected:
+	/*==================================*
+	 *             CALLBACKS			*
+	 *==================================*/
+
+private:
+	/*==================================*
+	 *             INTERNALS            *
+	 *==================================*/
+
+private:
+	/*==================================*
+	 *             VARIABLES            *
+	 *==================================*/
+	VVectorBatch				mCenter;
+	VVectorBatch				mA0;
+	VVectorBatch				mA1;
+	VVectorBatch				mA2;
+	VVectorBatch				mExtent;	/**< fA0, fA1, fA2 */
+};
+
+inline
+VUINT VObbBatch::Count() const
+{
+	return mCenter.Count();
+}
+
+inline
+VUINT VObbBatch::MaskWords(VUINT nCount)
+{
+	return (nCount + 31) >> 5;
+}
+
+} // End Namespace
+
+#endif // __VOBBBATCH_H_INCLUDED__
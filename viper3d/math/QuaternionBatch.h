@@ -0,0 +1,161 @@
+/*============================================================================*
+ *                                                                            *
+ * 	This file is part of the Viper3D Game Engine.							  *
+ *                                                                            *
+ *	Copyright (C) 2004 UDP Games   All Rights Reserved.						  *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------	------------- *
+ *                                                                            *
+ *============================================================================*/
+#if !defined(__VQUATERNIONBATCH_H_INCLUDED__)
+#define __VQUATERNIONBATCH_H_INCLUDED__
+
+/* System Headers */
+
+/* Local Headers */
+#include <viper3d/math/VectorBatch.h>
+
+namespace UDP
+{
+
+/**
+ *	@class		VQuaternionBatch
+ *
+ *	@brief		Structure-of-arrays collection of quaternions.
+ *	@version	0.1.0
+ *	@date		17-Oct-2026
+ *	@remarks	Laid out like VVectorBatch, with a fourth array for the
+ *				scalar part.  Meant for animating many orientations at
+ *				once: blend the keys with Nlerp() or Slerp(), combine with
+ *				the parent rotations through Multiply(), then hand the
+ *				results to the scene graph with ToAffines().
+ */
+class VQuaternionBatch
+{
+public:
+	/*==================================*
+	 *	   CONSTRUCTION/DESTRUCTION		*
+	 *==================================*/
+	VQuaternionBatch(VUINT nCount = 0);
+	VQuaternionBatch(const VQuaternion *pQuats, VUINT nCount);
+	VQuaternionBatch(const VQuaternionBatch &batch);
+	~VQuaternionBatch();
+
+	/*==================================*
+	 *			  ATTRIBUTES			*
+	 *==================================*/
+	VUINT			Count() const;
+	VUINT			Capacity() const;
+	float*			X();
+	float*			Y();
+	float*			Z();
+	float*			W();
+	const float*	X() const;
+	const float*	Y() const;
+	const float*	Z() const;
+	const float*	W() const;
+	VSoAQuat		SoA() const;
+	VQuaternion		Get(VUINT nIndex) const;
+	void			Set(VUINT nIndex, const VQuaternion &q);
+
+	/*==================================*
+	 *			  OPERATIONS			*
+	 *==================================*/
+	void			Resize(VUINT nCount);
+	void			FromQuaternions(const VQuaternion *pQuats, VUINT nCount);
+	void			ToQuaternions(VQuaternion *pQuats) const;
+	void			Multiply(const VQuaternionBatch &batch);
+	void			Multiply(const VQuaternionBatch &b1, const VQuaternionBatch &b2);
+	void			Rotate(VVectorBatch &vecs) const;
+	void			Normalize();
+	void			Nlerp(const VQuaternionBatch &b1, const VQuaternionBatch &b2,
+							float fT);
+	void			Slerp(const VQuaternionBatch &b1, const VQuaternionBatch &b2,
+							float fT, bool bFast = false);
+	void			ToAffines(VAffine *pOut) const;
+	void			ToAffines(VAffine *pOut, const VVectorBatch &pos) const;
+
+	/*==================================*
+	 *			   OPERATORS			*
+	 *==================================*/
+	const VQuaternionBatch&	operator=(const VQuaternionBatch &batch);
+
+protected:
+	/*==================================*
+	 *             CALLBACKS			*
+	 *==================================*/
+
+private:
+	/*==================================*
+	 *             INTERNALS            *
+	 *==================================*/
+	void			Reserve(VUINT nCount);
+	void			Match(const VQuaternionBatch &b1, const VQuaternionBatch &b2);
+
+private:
+	/*==================================*
+	 *             VARIABLES            *
+	 *==================================*/
+	char			*mBlock;	/* raw (unaligned) allocation */
+	float			*mX;
+	float			*mY;
+	float			*mZ;
+	float			*mW;
+	VUINT			mCount;
+	VUINT			mCapacity;
+};
+
+inline
+VUINT VQuaternionBatch::Count() const
+{
+	return mCount;
+}
+
+inline
+VUINT VQuaternionBatch::Capacity() const
+{
+	return mCapacity;
+}
+
+inline float* VQuaternionBatch::X() { return mX; }
+inline float* VQuaternionBatch::Y() { return mY; }
+inline float* VQuaternionBatch::Z() { return mZ; }
+inline float* VQuaternionBatch::W() { return mW; }
+inline const float* VQuaternionBatch::X() const { return mX; }
+inline const float* VQuaternionBatch::Y() const { return mY; }
+inline const float* VQuaternionBatch::Z() const { return mZ; }
+inline const float* VQuaternionBatch::W() const { return mW; }
+
+inline
+VSoAQuat VQuaternionBatch::SoA() const
+{
+	VSoAQuat vSoA;
+
+	vSoA.x = mX;
+	vSoA.y = mY;
+	vSoA.z = mZ;
+	vSoA.w = mW;
+	return vSoA;
+}
+
+inline
+VQuaternion VQuaternionBatch::Get(VUINT nIndex) const
+{
+	return VQuaternion(mW[nIndex], mX[nIndex], mY[nIndex], mZ[nIndex]);
+}
+
+inline
+void VQuaternionBatch::Set(VUINT nIndex, const VQuaternion &q)
+{
+	mX[nIndex] = q.x;
+	mY[nIndex] = q.y;
+	mZ[nIndex] = q.z;
+	mW[nIndex] = q.w;
+}
+
+} // End Namespace
+
+#endif // __VQUATERNIONBATCH_H_INCLUDED__
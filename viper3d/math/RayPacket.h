@@ -0,0 +1,145 @@
+/*============================================================================*
+ *                                                                            *
+ * 	This file is part of the Viper3D Game Engine.							  *
+ *                                                                            *
+ *	Copyright (C) 2004 UDP Games   All Rights Reserved.						  *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------	------------- *
+ *                                                                            *
+ *============================================================================*/
+#if !defined(__VRAYPACKET_H_INCLUDED__)
+#define __VRAYPACKET_H_INCLUDED__
+
+/* System Headers */
+
+/* Local Headers */
+#include <viper3d/Math.h>
+#include <viper3d/math/SIMD.h>
+
+/* Defines */
+#define VRAY_FAR			1e30f		/* distance limit of an unbounded ray */
+#define VRAY_NO_HIT			0xFFFFFFFFu
+
+namespace UDP
+{
+
+/**
+ *	@class		VRayPacket
+ *
+ *	@brief		Up to VSIMD_PACKET rays, traced together.
+ *	@version	0.1.0
+ *	@date		17-Oct-2026
+ *	@remarks	Keeps the rays in structure-of-arrays form so the packet
+ *				kernels test all of them against a box or a triangle at
+ *				once.  Each ray carries its own distance limit and, once
+ *				traced, the nearest hit found: the triangle, the distance
+ *				and the barycentric coordinates.  Rays that start close
+ *				together and point the same way (a screen tile, a burst of
+ *				line of sight checks from one unit) share most of their
+ *				traversal, which is where packets pay off.
+ */
+class VALIGN16 VRayPacket
+{
+	friend class VTriangleBvh;
+
+public:
+	/*==================================*
+	 *	   CONSTRUCTION/DESTRUCTION		*
+	 *==================================*/
+	VRayPacket();
+	~VRayPacket();
+
+	/*==================================*
+	 *			  ATTRIBUTES			*
+	 *==================================*/
+	VUINT			Count() const;
+	VUINT			Mask() const;
+	VRay			GetRay(VUINT nRay) const;
+	bool			IsHit(VUINT nRay) const;
+	VUINT			GetTriangle(VUINT nRay) const;
+	float			GetT(VUINT nRay) const;
+	float			GetU(VUINT nRay) const;
+	float			GetV(VUINT nRay) const;
+	VSoARays		SoA();
+
+	/*==================================*
+	 *			  OPERATIONS			*
+	 *==================================*/
+	void			Clear();
+	VUINT			Add(const VRay &ray, float fL = VRAY_FAR);
+	void			Set(VUINT nRay, const VRay &ray, float fL = VRAY_FAR);
+	void			Reset();
+
+protected:
+	/*==================================*
+	 *             CALLBACKS			*
+	 *==================================*/
+
+private:
+	/*==================================*
+	 *             INTERNALS            *
+	 *==================================*/
+
+private:
+	/*==================================*
+	 *             VARIABLES            *
+	 *==================================*/
+	float			mOrig[3][VSIMD_PACKET];
+	float			mDir[3][VSIMD_PACKET];
+	float			mInv[3][VSIMD_PACKET];	/**< 1/direction */
+	float			mFar[VSIMD_PACKET];		/**< distance limit as set */
+	float			mT[VSIMD_PACKET];		/**< nearest hit so far */
+	float			mU[VSIMD_PACKET];
+	float			mV[VSIMD_PACKET];
+	VUINT			mHit[VSIMD_PACKET];
+	VUINT			mCount;
+};
+
+inline
+VUINT VRayPacket::Count() const
+{
+	return mCount;
+}
+
+inline
+VUINT VRayPacket::Mask() const
+{
+	return (1u << mCount) - 1;
+}
+
+inline
+bool VRayPacket::IsHit(VUINT nRay) const
+{
+	return mHit[nRay] != VRAY_NO_HIT;
+}
+
+inline
+VUINT VRayPacket::GetTriangle(VUINT nRay) const
+{
+	return mHit[nRay];
+}
+
+inline
+float VRayPacket::GetT(VUINT nRay) const
+{
+	return mT[nRay];
+}
+
+inline
+float VRayPacket::GetU(VUINT nRay) const
+{
+	return mU[nRay];
+}
+
+inline
+float VRayPacket::GetV(VUINT nRay) const
+{
+	return mV[nRay];
+}
+
+} // End Namespace
+
+#endif // __VRAYPACKET_H_INCLUDED__
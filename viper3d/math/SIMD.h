@@ -0,0 +1,234 @@
+/*============================================================================*
+ *                                                                            *
+ * 	This file is part of the Viper3D Game Engine.							  *
+ *                                                                            *
+ *	Copyright (C) 2004 UDP Games   All Rights Reserved.						  *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------	------------- *
+ *                                                                            *
+ *============================================================================*/
+#if !defined(__VSIMD_H_INCLUDED__)
+#define __VSIMD_H_INCLUDED__
+
+/* System Headers */
+
+/* Local Headers */
+#include <viper3d/Types.h>
+#include <viper3d/util/CPU.h>
+
+/*
+ * NOTE: this header is included by the per-ISA kernel files, which are
+ * compiled with -mavx2 and friends.  It must not pull in anything that
+ * defines inline functions (Math.h, iostream, ...), or the linker may
+ * keep an AVX2 copy of them for use on machines without AVX2.
+ */
+
+/* Defines */
+#define VSIMD_MAX_PLANES	32	/* most planes BatchCullAabb accepts */
+#define VSIMD_PACKET		8	/* rays in one VSoARays packet */
+#define VSIMD_SAT_EPSILON	1e-6f	/* padding of separating axis tests */
+
+namespace UDP
+{
+
+/**
+ *	Component pointers of a structure-of-arrays vector batch.
+ */
+struct VSoA
+{
+	float	*x;
+	float	*y;
+	float	*z;
+};
+
+/**
+ *	Component pointers of a structure-of-arrays quaternion batch.
+ */
+struct VSoAQuat
+{
+	float	*x;
+	float	*y;
+	float	*z;
+	float	*w;
+};
+
+/**
+ *	Component pointers of a structure-of-arrays batch of oriented boxes:
+ *	centres, the three unit axes, and the half lengths along each axis
+ *	as x, y and z of e.
+ */
+struct VSoAObb
+{
+	VSoA	c;
+	VSoA	a0;
+	VSoA	a1;
+	VSoA	a2;
+	VSoA	e;
+};
+
+/**
+ *	Component pointers of a packet of VSIMD_PACKET rays.  The inverse
+ *	directions have zero components replaced by a large value of the
+ *	same sign.  t holds the farthest distance each ray accepts and is
+ *	pulled in as hits are found; u and v receive the barycentric
+ *	coordinates of the hit along the triangle's two edges.
+ */
+struct VSoARays
+{
+	const float	*ox;
+	const float	*oy;
+	const float	*oz;
+	const float	*dx;
+	const float	*dy;
+	const float	*dz;
+	const float	*ix;
+	const float	*iy;
+	const float	*iz;
+	float		*t;
+	float		*u;
+	float		*v;
+	VUINT		*hit;
+};
+
+/**
+ *	One set of math kernels, all compiled for the same instruction set.
+ *	Vectors are passed as 4 floats (x, y, z, w) and matrices as 16 floats
+ *	in row-major order, matching the VVector and VMatrix layouts; both
+ *	types are 16 byte aligned, but the single vector/matrix kernels also
+ *	take unaligned pointers.  Vector arrays are packed 4 floats apart.
+ *	Batch kernels expect VBATCH_ALIGN aligned component arrays.  Planes are 4
+ *	floats (nx, ny, nz, d), a ray against boxes is its origin and
+ *	1/direction, and bit masks hold 32 elements per VUINT.
+ *	Quaternion batches use the same layout as VQuaternion (w is the
+ *	scalar part), and write affine transforms 12 floats apart.  Ray
+ *	packets take any alignment, one bit of nActive per ray, and
+ *	triangles as 9 floats: the first corner and the edges leaving it
+ *	towards the second and the third.
+ */
+struct VSimdKernels
+{
+	const char	*mName;
+
+	/* single vector/matrix */
+	float		(*Length)(const float *pV);
+	void		(*Normalize)(float *pV);
+	void		(*Cross)(float *pOut, const float *pA, const float *pB);
+	void		(*MatrixMultiply)(float *pOut, const float *pA, const float *pB);
+	bool		(*MatrixInverse)(float *pOut, const float *pM);
+	bool		(*MatrixAffineInverse)(float *pOut, const float *pM);
+	void		(*MatrixTranspose)(float *pOut, const float *pM);
+	void		(*TransformPoints)(float *pOut, const float *pIn, const float *pM,
+								VUINT nCount);
+	void		(*TransformDirections)(float *pOut, const float *pIn, const float *pM,
+								VUINT nCount);
+
+	/* 3x4 affine transforms, the top three rows of a 4x4 */
+	void		(*AffineMultiply)(float *pOut, const float *pA, const float *pB);
+	bool		(*AffineInverse)(float *pOut, const float *pM);
+	bool		(*AffineOrthoInverse)(float *pOut, const float *pM);
+
+	/* structure-of-arrays batches */
+	void		(*BatchAdd)(VSoA vOut, VSoA vA, VSoA vB, VUINT nCount);
+	void		(*BatchScale)(VSoA vOut, float fScale, VUINT nCount);
+	void		(*BatchCross)(VSoA vOut, VSoA vA, VSoA vB, VUINT nCount);
+	void		(*BatchDot)(float *pOut, VSoA vA, VSoA vB, VUINT nCount);
+	void		(*BatchLength)(float *pOut, VSoA vA, VUINT nCount);
+	void		(*BatchNormalize)(VSoA vOut, VUINT nCount);
+	void		(*BatchTransformPoints)(VSoA vOut, const float *pM, VUINT nCount);
+	void		(*BatchTransformDirections)(VSoA vOut, const float *pM, VUINT nCount);
+	void		(*BatchCullAabb)(VSoA vMin, VSoA vMax, const float *pPlanes,
+								int nNumPlanes, VUINT nCount, VUINT *pVisible,
+								VUINT *pClipped);
+	void		(*BatchRayAabb)(const float *pOrig, const float *pInv, VSoA vMin,
+								VSoA vMax, float fL, VUINT nCount, VUINT *pHits,
+								float *pEnter);
+	void		(*BatchObbObb)(VSoAObb vA, VSoAObb vB, VUINT nCount,
+								VUINT *pHits);
+	void		(*BatchObbTriangle)(VSoAObb vA, VSoA v0, VSoA v1, VSoA v2,
+								VUINT nCount, VUINT *pHits);
+
+	/* structure-of-arrays quaternion batches */
+	void		(*BatchQuatMultiply)(VSoAQuat vOut, VSoAQuat vA, VSoAQuat vB,
+								VUINT nCount);
+	void		(*BatchQuatRotate)(VSoA vOut, VSoAQuat vQ, VSoA vIn, VUINT nCount);
+	void		(*BatchQuatNormalize)(VSoAQuat vOut, VUINT nCount);
+	void		(*BatchQuatNlerp)(VSoAQuat vOut, VSoAQuat vA, VSoAQuat vB,
+								float fT, VUINT nCount);
+	void		(*BatchQuatSlerp)(VSoAQuat vOut, VSoAQuat vA, VSoAQuat vB,
+								float fT, bool bFast, VUINT nCount);
+	void		(*BatchQuatToAffine)(float *pOut, VSoAQuat vQ, VSoA vPos,
+								VUINT nCount);
+
+	/* transcendentals over float arrays, any alignment */
+	void		(*BatchSinCos)(float *pSin, float *pCos, const float *pIn,
+								VUINT nCount, VMathAccuracy eAccuracy);
+	void		(*BatchRSqrt)(float *pOut, const float *pIn, VUINT nCount,
+								VMathAccuracy eAccuracy);
+	void		(*BatchATan2)(float *pOut, const float *pY, const float *pX,
+								VUINT nCount, VMathAccuracy eAccuracy);
+	void		(*BatchACos)(float *pOut, const float *pIn, VUINT nCount,
+								VMathAccuracy eAccuracy);
+
+	/* ray packets */
+	VUINT		(*RayPacketBox)(VSoARays vRays, const float *pMin, const float *pMax,
+								VUINT nActive);
+	VUINT		(*RayPacketTriangles)(VSoARays vRays, const float *pTris,
+								VUINT nFirst, VUINT nCount, VUINT nActive,
+								bool bCull, bool bAny);
+};
+
+/**
+ *	@class		VSimd
+ *
+ *	@brief		Runtime-selected math kernels.
+ *	@version	0.1.0
+ *	@date		17-Oct-2026
+ *	@remarks	mKernels starts out holding the scalar kernels and is
+ *				refilled by VCPU::Init() (and VCPU::SetTier()) with the
+ *				best set compiled into the library that the CPU can run.
+ *				Call through it as VSimd::mKernels.Length(&vec.x).
+ */
+class VSimd
+{
+private:
+	/*==================================*
+	 *	   CONSTRUCTION/DESTRUCTION		*
+	 *==================================*/
+	VSimd() {}
+	~VSimd() {}
+
+public:
+	/*==================================*
+	 *			  ATTRIBUTES			*
+	 *==================================*/
+	static VSimdTier			GetTier();
+	static const VSimdKernels*	GetKernels(VSimdTier eTier);
+
+	/*==================================*
+	 *			  OPERATIONS			*
+	 *==================================*/
+	static void					Select(VSimdTier eTier);
+
+public:
+	/*==================================*
+	 *             VARIABLES            *
+	 *==================================*/
+	static VSimdKernels			mKernels;
+
+private:
+	static VSimdTier			mTier;
+};
+
+/* per-ISA kernel sets; NULL when the ISA was not compiled in */
+const VSimdKernels* SimdKernelsScalar();
+const VSimdKernels* SimdKernelsSSE2();
+const VSimdKernels* SimdKernelsSSE41();
+const VSimdKernels* SimdKernelsAVX2();
+const VSimdKernels* SimdKernelsFMA();
+
+} // End Namespace
+
+#endif // __VSIMD_H_INCLUDED__
@@ -0,0 +1,152 @@
+/*============================================================================*
+ *                                                                            *
+ * 	This file is part of the Viper3D Game Engine.							  *
+ *                                                                            *
+ *	Copyright (C) 2004 UDP Games   All Rights Reserved.						  *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------	------------- *
+ *                                                                            *
+ *============================================================================*/
+#if !defined(__VSLABRAY_H_INCLUDED__)
+#define __VSLABRAY_H_INCLUDED__
+
+/* System Headers */
+
+/* Local Headers */
+#include <viper3d/Math.h>
+
+/* Defines */
+#define VSLAB_HUGE			1e30f	/* stands in for 1/0 */
+
+namespace UDP
+{
+
+/**
+ *	@class		VSlabRay
+ *
+ *	@brief		A ray set up for testing against many boxes.
+ *	@version	0.1.0
+ *	@date		17-Oct-2026
+ *	@remarks	Keeps 1/direction and the sign of each direction
+ *				component, worked out once, so a box test is six
+ *				subtract-multiplies and a few min/max with no division
+ *				and no branch on the ray's direction.  Zero direction
+ *				components get a large inverse of the right sign, so
+ *				axis-aligned rays need no special case either.  Build
+ *				one per query and test it against every box the query
+ *				visits; VAabbBatch::RayMask() tests it against a whole
+ *				batch at once.
+ */
+class VALIGN16 VSlabRay
+{
+public:
+	/*==================================*
+	 *	   CONSTRUCTION/DESTRUCTION		*
+	 *==================================*/
+	VSlabRay();
+	VSlabRay(const VRay &ray);
+	~VSlabRay();
+
+	/*==================================*
+	 *			  ATTRIBUTES			*
+	 *==================================*/
+	const float*	GetOrigin() const;
+	const float*	GetInverse() const;
+
+	/*==================================*
+	 *			  OPERATIONS			*
+	 *==================================*/
+	void			Set(const VRay &ray);
+	void			Slab(const float *pMin, const float *pMax, float *pNear,
+								float *pFar) const;
+	bool			Enters(const float *pMin, const float *pMax, float fL,
+								float *pEnter) const;
+	bool			Enters(const VAabb &aabb, float fL, float *pEnter) const;
+	bool			Intersects(const VAabb &aabb, float *t) const;
+	bool			Intersects(const VAabb &aabb, float fL, float *t) const;
+
+protected:
+	/*==================================*
+	 *             CALLBACKS			*
+	 *==================================*/
+
+private:
+	/*==================================*
+	 *             INTERNALS            *
+	 *==================================*/
+
+private:
+	/*==================================*
+	 *             VARIABLES            *
+	 *==================================*/
+	float			mOrig[4];
+	float			mInv[4];	/**< 1/direction */
+	int				mSign[3];	/**< 1 where the direction is negative */
+};
+
+inline
+const float* VSlabRay::GetOrigin() const
+{
+	return mOrig;
+}
+
+inline
+const float* VSlabRay::GetInverse() const
+{
+	return mInv;
+}
+
+/*
+ * Distances at which the ray enters and leaves the slabs of a box; it
+ * hits the box where near <= far.  The sign picks which corner each
+ * slab is entered through, so no min/max per axis is needed.
+ */
+inline
+void VSlabRay::Slab(const float *pMin, const float *pMax, float *pNear,
+					float *pFar) const
+{
+	const float	*vB[2] = { pMin, pMax };
+	float		fNear, fFar, t0, t1;
+
+	fNear = (vB[mSign[0]][0] - mOrig[0]) * mInv[0];
+	fFar = (vB[1 - mSign[0]][0] - mOrig[0]) * mInv[0];
+	t0 = (vB[mSign[1]][1] - mOrig[1]) * mInv[1];
+	t1 = (vB[1 - mSign[1]][1] - mOrig[1]) * mInv[1];
+	fNear = t0 > fNear ? t0 : fNear;
+	fFar = t1 < fFar ? t1 : fFar;
+	t0 = (vB[mSign[2]][2] - mOrig[2]) * mInv[2];
+	t1 = (vB[1 - mSign[2]][2] - mOrig[2]) * mInv[2];
+	*pNear = t0 > fNear ? t0 : fNear;
+	*pFar = t1 < fFar ? t1 : fFar;
+}
+
+/*
+ * Whether the ray enters the box somewhere in [0, fL], and where; a ray
+ * starting inside enters at 0.  This is the test for traversing a
+ * hierarchy of boxes.
+ */
+inline
+bool VSlabRay::Enters(const float *pMin, const float *pMax, float fL,
+						float *pEnter) const
+{
+	float fNear, fFar;
+
+	Slab(pMin, pMax, &fNear, &fFar);
+	fNear = fNear > 0.0f ? fNear : 0.0f;
+	fFar = fFar < fL ? fFar : fL;
+	*pEnter = fNear;
+	return fNear <= fFar;
+}
+
+inline
+bool VSlabRay::Enters(const VAabb &aabb, float fL, float *pEnter) const
+{
+	return Enters(&aabb.GetMin().x, &aabb.GetMax().x, fL, pEnter);
+}
+
+} // End Namespace
+
+#endif // __VSLABRAY_H_INCLUDED__
@@ -0,0 +1,115 @@
+/*============================================================================*
+ *                                                                            *
+ * 	This file is part of the Viper3D Game Engine.							  *
+ *                                                                            *
+ *	Copyright (C) 2004 UDP Games   All Rights Reserved.						  *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------	------------- *
+ *                                                                            *
+ *============================================================================*/
+#if !defined(__VTRIANGLEBVH_H_INCLUDED__)
+#define __VTRIANGLEBVH_H_INCLUDED__
+
+/* System Headers */
+#include <vector>
+
+/* Local Headers */
+#include <viper3d/math/Bvh.h>
+#include <viper3d/math/RayPacket.h>
+
+namespace UDP
+{
+
+/**
+ *	@class		VTriangleBvh
+ *
+ *	@brief		Ray queries against a triangle soup.
+ *	@version	0.1.0
+ *	@date		17-Oct-2026
+ *	@remarks	Builds a VBvh over the triangles' bounds and keeps the
+ *				triangles themselves in leaf order, so a leaf's triangles
+ *				sit next to each other in memory.  Rays are traced a
+ *				VRayPacket at a time: a node is entered while any ray of
+ *				the packet still hits it, and each leaf tests every such
+ *				ray against its triangles in one SIMD pass.  Pick() finds
+ *				the nearest hit of each ray, Occluded() only whether there
+ *				is one, and stops as soon as every ray has been blocked.
+ *
+ *				Triangles are numbered in the order they were given;
+ *				built from polygons, GetPolygon() maps a triangle back to
+ *				the polygon it came from.
+ */
+class VTriangleBvh
+{
+public:
+	/*==================================*
+	 *	   CONSTRUCTION/DESTRUCTION		*
+	 *==================================*/
+	VTriangleBvh();
+	~VTriangleBvh();
+
+	/*==================================*
+	 *			  ATTRIBUTES			*
+	 *==================================*/
+	VUINT			Count() const;
+	const VBvh&		GetBvh() const;
+	void			GetTriangle(VUINT nTri, VVector *pV0, VVector *pV1,
+								VVector *pV2) const;
+	VUINT			GetPolygon(VUINT nTri) const;
+
+	/*==================================*
+	 *			  OPERATIONS			*
+	 *==================================*/
+	void			Build(const VVector *pPoints, const VUINT *pIndis,
+								VUINT nNumI);
+	void			Build(const VPolygon *pPolys, VUINT nNumPolys);
+	void			Pick(VRayPacket &packet, bool bCull = false) const;
+	bool			Pick(const VRay &ray, bool bCull, VUINT *pTri, float *t,
+								float fL = VRAY_FAR) const;
+	VUINT			Occluded(VRayPacket &packet, bool bCull = false) const;
+	bool			Occluded(const VRay &ray, float fL,
+								bool bCull = false) const;
+
+protected:
+	/*==================================*
+	 *             CALLBACKS			*
+	 *==================================*/
+
+private:
+	/*==================================*
+	 *             INTERNALS            *
+	 *==================================*/
+	void			AddTriangle(const VVector &v0, const VVector &v1,
+								const VVector &v2);
+	void			Finish();
+	VUINT			Trace(VRayPacket &packet, bool bCull, bool bAny) const;
+
+private:
+	/*==================================*
+	 *             VARIABLES            *
+	 *==================================*/
+	VBvh				mBvh;
+	std::vector<float>	mCorners;	/**< 9 floats per triangle, by number */
+	std::vector<float>	mTris;		/**< corner and edges, in leaf order */
+	std::vector<VUINT>	mIds;		/**< triangle number, in leaf order */
+	std::vector<VUINT>	mPolyFirst;	/**< first triangle of each polygon */
+};
+
+inline
+VUINT VTriangleBvh::Count() const
+{
+	return (VUINT)(mCorners.size() / 9);
+}
+
+inline
+const VBvh& VTriangleBvh::GetBvh() const
+{
+	return mBvh;
+}
+
+} // End Namespace
+
+#endif // __VTRIANGLEBVH_H_INCLUDED__
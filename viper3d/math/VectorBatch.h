@@ -0,0 +1,158 @@
+/*============================================================================*
+ *                                                                            *
+ * 	This file is part of the Viper3D Game Engine.							  *
+ *                                                                            *
+ *	Copyright (C) 2004 UDP Games   All Rights Reserved.						  *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------	------------- *
+ *                                                                            *
+ *============================================================================*/
+#if !defined(__VVECTORBATCH_H_INCLUDED__)
+#define __VVECTORBATCH_H_INCLUDED__
+
+/* System Headers */
+
+/* Local Headers */
+#include <viper3d/Math.h>
+#include <viper3d/math/SIMD.h>
+
+/* Defines */
+#define VBATCH_ALIGN		32	/* byte alignment of each component array */
+#define VBATCH_WIDTH		8	/* floats per widest SIMD register (AVX) */
+
+namespace UDP
+{
+
+/**
+ *	@class		VVectorBatch
+ *
+ *	@brief		Structure-of-arrays collection of 3D vectors.
+ *	@version	0.1.0
+ *	@date		17-Oct-2026
+ *	@remarks	The x, y and z components are kept in three separate arrays,
+ *				each aligned to VBATCH_ALIGN bytes and padded to a multiple
+ *				of VBATCH_WIDTH elements, so the bulk operations below can
+ *				process 4 (SSE) or 8 (AVX) vectors per instruction without
+ *				any shuffling.  Use this instead of looping over VVector
+ *				when the same operation is applied to many vectors.
+ */
+class VVectorBatch
+{
+public:
+	/*==================================*
+	 *	   CONSTRUCTION/DESTRUCTION		*
+	 *==================================*/
+	VVectorBatch(VUINT nCount = 0);
+	VVectorBatch(const VVector *pVecs, VUINT nCount);
+	VVectorBatch(const VVectorBatch &batch);
+	~VVectorBatch();
+
+	/*==================================*
+	 *			  ATTRIBUTES			*
+	 *==================================*/
+	VUINT			Count() const;
+	VUINT			Capacity() const;
+	float*			X();
+	float*			Y();
+	float*			Z();
+	const float*	X() const;
+	const float*	Y() const;
+	const float*	Z() const;
+	VSoA			SoA() const;
+	VVector			Get(VUINT nIndex) const;
+	void			Set(VUINT nIndex, const VVector &vec);
+
+	/*==================================*
+	 *			  OPERATIONS			*
+	 *==================================*/
+	void			Resize(VUINT nCount);
+	void			FromVectors(const VVector *pVecs, VUINT nCount);
+	void			ToVectors(VVector *pVecs) const;
+	void			Add(const VVectorBatch &batch);
+	void			Add(const VVectorBatch &b1, const VVectorBatch &b2);
+	void			Scale(float fScale);
+	void			Cross(const VVectorBatch &b1, const VVectorBatch &b2);
+	void			Dot(const VVectorBatch &batch, float *pOut) const;
+	void			Length(float *pOut) const;
+	void			Normalize();
+	void			TransformPoints(const VMatrix &mat);
+	void			TransformDirections(const VMatrix &mat);
+
+	/*==================================*
+	 *			   OPERATORS			*
+	 *==================================*/
+	const VVectorBatch&	operator=(const VVectorBatch &batch);
+
+protected:
+	/*==================================*
+	 *             CALLBACKS			*
+	 *==================================*/
+
+private:
+	/*==================================*
+	 *             INTERNALS            *
+	 *==================================*/
+	void			Reserve(VUINT nCount);
+
+private:
+	/*==================================*
+	 *             VARIABLES            *
+	 *==================================*/
+	char			*mBlock;	/* raw (unaligned) allocation */
+	float			*mX;
+	float			*mY;
+	float			*mZ;
+	VUINT			mCount;
+	VUINT			mCapacity;
+};
+
+inline
+VUINT VVectorBatch::Count() const
+{
+	return mCount;
+}
+
+inline
+VUINT VVectorBatch::Capacity() const
+{
+	return mCapacity;
+}
+
+inline float* VVectorBatch::X() { return mX; }
+inline float* VVectorBatch::Y() { return mY; }
+inline float* VVectorBatch::Z() { return mZ; }
+inline const float* VVectorBatch::X() const { return mX; }
+inline const float* VVectorBatch::Y() const { return mY; }
+inline const float* VVectorBatch::Z() const { return mZ; }
+
+inline
+VSoA VVectorBatch::SoA() const
+{
+	VSoA vSoA;
+
+	vSoA.x = mX;
+	vSoA.y = mY;
+	vSoA.z = mZ;
+	return vSoA;
+}
+
+inline
+VVector VVectorBatch::Get(VUINT nIndex) const
+{
+	return VVector(mX[nIndex], mY[nIndex], mZ[nIndex]);
+}
+
+inline
+void VVectorBatch::Set(VUINT nIndex, const VVector &vec)
+{
+	mX[nIndex] = vec.x;
+	mY[nIndex] = vec.y;
+	mZ[nIndex] = vec.z;
+}
+
+} // End Namespace
+
+#endif // __VVECTORBATCH_H_INCLUDED__
@@ -0,0 +1,555 @@
+/*============================================================================*
+ *                                                                            *
+ * 	This file is part of the Viper3D Game Engine.							  *
+ *                                                                            *
+ *	Copyright (C) 2004 UDP Games   All Rights Reserved.						  *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------	------------- *
+ *                                                                            *
+ *============================================================================*/
+#include <viper3d/math/AabbBatch.h>
+
+/* System Headers */
+
+/* Local Headers */
+
+/* Defines */
+#define VAABB_CHUNK		2048	/* boxes a serial pass masks on the stack at once */
+
+namespace UDP
+{
+
+/*
+ * Index of the lowest set bit of a non-zero word.
+ */
+static inline VUINT LowestBit(VUINT nWord)
+{
+#if defined(__GNUC__)
+	return (VUINT)__builtin_ctz(nWord);
+#else
+	VUINT vBit = 0;
+	while ((nWord & 1) == 0)
+	{
+		nWord >>= 1;
+		vBit++;
+	}
+	return vBit;
+#endif
+}
+
+/*
+ * Number of set bits in a word.
+ */
+static inline VUINT CountBits(VUINT nWord)
+{
+#if defined(__GNUC__)
+	return (VUINT)__builtin_popcount(nWord);
+#else
+	VUINT vBits = 0;
+	for (; nWord; nWord &= nWord - 1)
+		vBits++;
+	return vBits;
+#endif
+}
+
+/*
+ * Packs up to VSIMD_MAX_PLANES planes as (nx, ny, nz, d) for the SIMD
+ * kernels, returning how many it took.
+ */
+static int PackPlanes(const VPlane *pPlanes, int nNumPlanes, float *pOut)
+{
+	if (nNumPlanes > VSIMD_MAX_PLANES)
+		nNumPlanes = VSIMD_MAX_PLANES;
+
+	for (int i = 0; i < nNumPlanes; i++)
+	{
+		pOut[i * 4 + 0] = pPlanes[i].m_vN.x;
+		pOut[i * 4 + 1] = pPlanes[i].m_vN.y;
+		pOut[i * 4 + 2] = pPlanes[i].m_vN.z;
+		pOut[i * 4 + 3] = pPlanes[i].m_fD;
+	}
+	return nNumPlanes;
+}
+
+/*
+ * Component pointers of a batch, nFirst boxes in.
+ */
+static inline VSoA Offset(VSoA soa, VUINT nFirst)
+{
+	soa.x += nFirst;
+	soa.y += nFirst;
+	soa.z += nFirst;
+	return soa;
+}
+
+/*
+ * Writes the index of every set bit of a mask over nCount boxes,
+ * starting from box nFirst.
+ */
+static VUINT CompactMask(const VUINT *pMask, VUINT nCount, VUINT nFirst,
+						VUINT *pIndices)
+{
+	VUINT vNum = 0;
+	VUINT vWord;
+
+	for (VUINT w = 0; w < VAabbBatch::MaskWords(nCount); w++)
+	{
+		vWord = pMask[w];
+		while (vWord)
+		{
+			pIndices[vNum++] = nFirst + (w << 5) + LowestBit(vWord);
+			vWord &= vWord - 1;
+		}
+	}
+	return vNum;
+}
+
+/*
+ * Culls nCount boxes from nFirst, a multiple of 32, into the masks for
+ * that range.  The kernel takes VSIMD_MAX_PLANES planes at a time, so
+ * any more are culled in further passes and folded in: a box is culled
+ * if any pass culls it, and clipped if it survives and any pass clips
+ * it, as in VAabb::Cull().
+ */
+static void CullRange(const VAabbBatch &batch, const VPlane *pPlanes, int nNumPlanes,
+						VUINT nFirst, VUINT nCount, VUINT *pVisible, VUINT *pClipped)
+{
+	float	vPlanes[VSIMD_MAX_PLANES * 4];
+	VUINT	vVisible[VAABB_CHUNK >> 5];
+	VUINT	vClipped[VAABB_CHUNK >> 5];
+	VSoA	vMin = Offset(batch.Min().SoA(), nFirst);
+	VSoA	vMax = Offset(batch.Max().SoA(), nFirst);
+	VUINT	vNum, vBase;
+	int		vPass;
+
+	vPass = PackPlanes(pPlanes, nNumPlanes, vPlanes);
+	VSimd::mKernels.BatchCullAabb(vMin, vMax, vPlanes, vPass, nCount, pVisible, pClipped);
+
+	for (int p = vPass; p < nNumPlanes; p += vPass)
+	{
+		vPass = PackPlanes(pPlanes + p, nNumPlanes - p, vPlanes);
+		for (VUINT c = 0; c < nCount; c += VAABB_CHUNK)
+		{
+			vNum = (nCount - c < VAABB_CHUNK ? nCount - c : VAABB_CHUNK);
+			vBase = c >> 5;
+			VSimd::mKernels.BatchCullAabb(Offset(vMin, c), Offset(vMax, c), vPlanes,
+					vPass, vNum, vVisible, pClipped ? vClipped : NULL);
+			for (VUINT w = 0; w < VAabbBatch::MaskWords(vNum); w++)
+			{
+				pVisible[vBase + w] &= vVisible[w];
+				if (pClipped)
+					pClipped[vBase + w] = (pClipped[vBase + w] | vClipped[w]) &
+											pVisible[vBase + w];
+			}
+		}
+	}
+}
+
+/*
+ * State shared by the jobs of one parallel cull.
+ */
+struct VCullTask
+{
+	const VAabbBatch	*mBatch;
+	const VPlane		*mPlanes;
+	int					mNumPlanes;
+	VUINT				*mVisible;
+	VUINT				*mClipped;
+	VUINT				*mCounts;	/**< visible boxes in, then offset of, each job's range */
+	VUINT				*mIndices;
+};
+
+/*
+ * Culls one range of boxes.  Ranges start on a multiple of 32, so each
+ * job writes its own mask words.
+ */
+static void CullJob(VJob *pJob)
+{
+	VCullTask	*vTask = (VCullTask*)pJob->mData;
+	VUINT		vFirst = pJob->mFirst;
+
+	CullRange(*vTask->mBatch, vTask->mPlanes, vTask->mNumPlanes, vFirst, pJob->mCount,
+			vTask->mVisible + (vFirst >> 5),
+			vTask->mClipped ? vTask->mClipped + (vFirst >> 5) : NULL);
+}
+
+/*
+ * Culls one range, then counts what survived it.
+ */
+static void CullCountJob(VJob *pJob)
+{
+	VCullTask	*vTask = (VCullTask*)pJob->mData;
+	VUINT		vEnd = VAabbBatch::MaskWords(pJob->mFirst + pJob->mCount);
+	VUINT		vNum = 0;
+
+	CullJob(pJob);
+	for (VUINT w = pJob->mFirst >> 5; w < vEnd; w++)
+		vNum += CountBits(vTask->mVisible[w]);
+	vTask->mCounts[pJob->mFirst / VAABB_CULL_GRAIN] = vNum;
+}
+
+/*
+ * Writes one range's survivors from its offset in the index list.
+ */
+static void CompactJob(VJob *pJob)
+{
+	VCullTask	*vTask = (VCullTask*)pJob->mData;
+	VUINT		vFirst = pJob->mFirst;
+
+	CompactMask(vTask->mVisible + (vFirst >> 5), pJob->mCount, vFirst,
+			vTask->mIndices + vTask->mCounts[vFirst / VAABB_CULL_GRAIN]);
+}
+
+/********************************************************************
+ *          C O N S T R U C T I O N / D E S T R U C T I O N         *
+ ********************************************************************/
+VAabbBatch::VAabbBatch(VUINT nCount /*=0*/)
+: mMin(nCount), mMax(nCount)
+{
+
+}
+
+VAabbBatch::VAabbBatch(const VAabb *pBoxes, VUINT nCount)
+{
+	FromAabbs(pBoxes, nCount);
+}
+
+VAabbBatch::~VAabbBatch()
+{
+
+}
+
+/********************************************************************
+ *                        A T T R I B U T E S                       *
+ ********************************************************************/
+VAabb VAabbBatch::Get(VUINT nIndex) const
+{
+	return VAabb(mMin.Get(nIndex), mMax.Get(nIndex));
+}
+
+void VAabbBatch::Set(VUINT nIndex, const VAabb &aabb)
+{
+	mMin.Set(nIndex, aabb.GetMin());
+	mMax.Set(nIndex, aabb.GetMax());
+}
+
+/********************************************************************
+ *                        O P E R A T I O N S                       *
+ ********************************************************************/
+void VAabbBatch::Resize(VUINT nCount)
+{
+	mMin.Resize(nCount);
+	mMax.Resize(nCount);
+}
+
+void VAabbBatch::FromAabbs(const VAabb *pBoxes, VUINT nCount)
+{
+	Resize(nCount);
+	for (VUINT i = 0; i < Count(); i++)
+		Set(i, pBoxes[i]);
+}
+
+/*------------------------------------------------------------------*
+ *							   CullMask()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Culls every box against a set of planes, producing bit
+ *				masks.
+ *	@date		17-Oct-2026
+ *
+ *	@param		pPlanes		Planes, normals pointing out of the volume
+ *	@param		nNumPlanes	Number of planes
+ *	@param		pVisible	Receives a set bit for each box that is not
+ *							culled.  Must hold MaskWords(Count()) words.
+ *	@param		pClipped	Optional; receives a set bit for each visible
+ *							box that crosses a plane.
+ *
+ *	@remarks	Box i is bit (i & 31) of word (i >> 5).
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VAabbBatch::CullMask(const VPlane *pPlanes, int nNumPlanes,
+						VUINT *pVisible, VUINT *pClipped /*=NULL*/) const
+{
+	CullRange(*this, pPlanes, nNumPlanes, 0, Count(), pVisible, pClipped);
+}
+
+/*------------------------------------------------------------------*
+ *								 Cull()								*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Culls every box against a set of planes, producing a
+ *				compacted list of the boxes that survive.
+ *	@date		17-Oct-2026
+ *
+ *	@param		pPlanes		Planes, normals pointing out of the volume
+ *	@param		nNumPlanes	Number of planes
+ *	@param		pIndices	Receives the indices of visible and clipped
+ *							boxes in ascending order.  Must hold Count()
+ *							entries.
+ *
+ *	@returns	(VUINT) Number of indices written
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+VUINT VAabbBatch::Cull(const VPlane *pPlanes, int nNumPlanes,
+						VUINT *pIndices) const
+{
+	VUINT vVisible[VAABB_CHUNK >> 5];
+	VUINT vNum = 0;
+	VUINT vCount;
+
+	for (VUINT c = 0; c < Count(); c += VAABB_CHUNK)
+	{
+		vCount = (Count() - c < VAABB_CHUNK ? Count() - c : VAABB_CHUNK);
+		CullRange(*this, pPlanes, nNumPlanes, c, vCount, vVisible, NULL);
+		vNum += CompactMask(vVisible, vCount, c, pIndices + vNum);
+	}
+	return vNum;
+}
+
+/*------------------------------------------------------------------*
+ *							   CullMask()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		CullMask(), with the boxes split between the threads of a
+ *				job system.
+ *	@date		17-Oct-2026
+ *
+ *	@param		pPlanes		Planes, normals pointing out of the volume
+ *	@param		nNumPlanes	Number of planes
+ *	@param		pVisible	Receives a set bit for each box that is not
+ *							culled.  Must hold MaskWords(Count()) words.
+ *	@param		pClipped	Receives a set bit for each visible box that
+ *							crosses a plane, or NULL.
+ *	@param		jobs		Threads to cull on
+ *
+ *	@remarks	Each job covers VAABB_CULL_GRAIN boxes and writes only its
+ *				own mask words, so the masks are identical to the serial
+ *				version's.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VAabbBatch::CullMask(const VPlane *pPlanes, int nNumPlanes,
+						VUINT *pVisible, VUINT *pClipped, VJobSystem &jobs) const
+{
+	VCullTask vTask;
+
+	if (jobs.GetNumThreads() <= 1 || Count() <= VAABB_CULL_GRAIN)
+	{
+		CullMask(pPlanes, nNumPlanes, pVisible, pClipped);
+		return;
+	}
+
+	vTask.mBatch = this;
+	vTask.mPlanes = pPlanes;
+	vTask.mNumPlanes = nNumPlanes;
+	vTask.mVisible = pVisible;
+	vTask.mClipped = pClipped;
+	jobs.ParallelFor(CullJob, &vTask, Count(), VAABB_CULL_GRAIN);
+}
+
+/*------------------------------------------------------------------*
+ *								 Cull()								*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Each job culls its range and counts the survivors			*
+ *		Turn the counts into offsets, in range order				*
+ *		Each job writes its survivors from its offset				*
+ *		The result is the serial Cull()'s, whatever the thread		*
+ *		count or timing												*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Cull(), with the boxes split between the threads of a
+ *				job system.
+ *	@date		17-Oct-2026
+ *
+ *	@param		pPlanes		Planes, normals pointing out of the volume
+ *	@param		nNumPlanes	Number of planes
+ *	@param		pIndices	Receives the indices of visible and clipped
+ *							boxes in ascending order.  Must hold Count()
+ *							entries.
+ *	@param		jobs		Threads to cull on
+ *
+ *	@returns	(VUINT) Number of indices written
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+VUINT VAabbBatch::Cull(const VPlane *pPlanes, int nNumPlanes,
+						VUINT *pIndices, VJobSystem &jobs) const
+{
+	std::vector<VUINT>	vCounts, vVisible;
+	VCullTask			vTask;
+	VUINT				vNum = 0;
+	VUINT				vRanges, vRangeNum;
+
+	if (jobs.GetNumThreads() <= 1 || Count() <= VAABB_CULL_GRAIN)
+		return Cull(pPlanes, nNumPlanes, pIndices);
+
+	vRanges = (Count() + VAABB_CULL_GRAIN - 1) / VAABB_CULL_GRAIN;
+	vCounts.resize(vRanges);
+	vVisible.resize(MaskWords(Count()));
+
+	vTask.mBatch = this;
+	vTask.mPlanes = pPlanes;
+	vTask.mNumPlanes = nNumPlanes;
+	vTask.mVisible = &vVisible[0];
+	vTask.mClipped = NULL;
+	vTask.mCounts = &vCounts[0];
+	vTask.mIndices = pIndices;
+	jobs.ParallelFor(CullCountJob, &vTask, Count(), VAABB_CULL_GRAIN);
+
+	for (VUINT i = 0; i < vRanges; i++)
+	{
+		vRangeNum = vCounts[i];
+		vCounts[i] = vNum;
+		vNum += vRangeNum;
+	}
+
+	jobs.ParallelFor(CompactJob, &vTask, Count(), VAABB_CULL_GRAIN);
+	return vNum;
+}
+
+/*------------------------------------------------------------------*
+ *							   Classify()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Culls every box against a set of planes, producing the
+ *				same result codes as VAabb::Cull().
+ *	@date		17-Oct-2026
+ *
+ *	@param		pPlanes		Planes, normals pointing out of the volume
+ *	@param		nNumPlanes	Number of planes
+ *	@param		pResults	Receives VCULLED, VCLIPPED or VVISIBLE for
+ *							each box.  Must hold Count() entries.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VAabbBatch::Classify(const VPlane *pPlanes, int nNumPlanes,
+							VBYTE *pResults) const
+{
+	VUINT vVisible[VAABB_CHUNK >> 5];
+	VUINT vClipped[VAABB_CHUNK >> 5];
+	VUINT vCount, vBit;
+
+	for (VUINT c = 0; c < Count(); c += VAABB_CHUNK)
+	{
+		vCount = (Count() - c < VAABB_CHUNK ? Count() - c : VAABB_CHUNK);
+		CullRange(*this, pPlanes, nNumPlanes, c, vCount, vVisible, vClipped);
+		for (VUINT i = 0; i < vCount; i++)
+		{
+			vBit = 1u << (i & 31);
+			if ((vVisible[i >> 5] & vBit) == 0)
+				pResults[c + i] = VCULLED;
+			else if (vClipped[i >> 5] & vBit)
+				pResults[c + i] = VCLIPPED;
+			else
+				pResults[c + i] = VVISIBLE;
+		}
+	}
+}
+
+/*------------------------------------------------------------------*
+ *							   RayMask()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Tests one ray against every box, producing a bit mask.
+ *	@date		17-Oct-2026
+ *
+ *	@param		ray		Ray to test
+ *	@param		fL		Farthest distance along the ray that counts
+ *	@param		pHits	Receives a set bit for each box the ray enters
+ *						between 0 and fL.  Must hold MaskWords(Count())
+ *						words.
+ *	@param		pEnter	Optional; receives, for every box, the distance
+ *						at which the ray enters it (0 if it starts
+ *						inside).  Only meaningful for boxes that are hit.
+ *						Must hold Count() entries.
+ *
+ *	@remarks	Matches VSlabRay::Enters() exactly.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VAabbBatch::RayMask(const VSlabRay &ray, float fL, VUINT *pHits,
+						float *pEnter /*=NULL*/) const
+{
+	VSimd::mKernels.BatchRayAabb(ray.GetOrigin(), ray.GetInverse(),
+			mMin.SoA(), mMax.SoA(), fL, Count(), pHits, pEnter);
+}
+
+/*------------------------------------------------------------------*
+ *							  Intersects()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Tests one ray against every box, producing a compacted
+ *				list of the boxes it enters.
+ *	@date		17-Oct-2026
+ *
+ *	@param		ray			Ray to test
+ *	@param		fL			Farthest distance along the ray that counts
+ *	@param		pIndices	Receives the indices of the boxes hit in
+ *							ascending order.  Must hold Count() entries.
+ *	@param		pT			Optional; receives the entry distance of
+ *							each box in pIndices.
+ *
+ *	@returns	(VUINT) Number of indices written
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+VUINT VAabbBatch::Intersects(const VSlabRay &ray, float fL, VUINT *pIndices,
+							float *pT /*=NULL*/) const
+{
+	VUINT	vHits[VAABB_CHUNK >> 5];
+	float	vEnter[VAABB_CHUNK];
+	VUINT	vNum = 0;
+	VUINT	vCount, vFound;
+
+	for (VUINT c = 0; c < Count(); c += VAABB_CHUNK)
+	{
+		vCount = (Count() - c < VAABB_CHUNK ? Count() - c : VAABB_CHUNK);
+		VSimd::mKernels.BatchRayAabb(ray.GetOrigin(), ray.GetInverse(),
+				Offset(mMin.SoA(), c), Offset(mMax.SoA(), c), fL, vCount, vHits,
+				pT ? vEnter : NULL);
+		vFound = CompactMask(vHits, vCount, c, pIndices + vNum);
+		if (pT)
+		{
+			for (VUINT i = vNum; i < vNum + vFound; i++)
+				pT[i] = vEnter[pIndices[i] - c];
+		}
+		vNum += vFound;
+	}
+	return vNum;
+}
+
+} // End Namespace
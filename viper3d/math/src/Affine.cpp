@@ -0,0 +1,323 @@
+/*============================================================================*
+ *                                                                            *
+ * 	This file is part of the Viper3D Game Engine.							  *
+ *                                                                            *
+ *	Copyright (C) 2004 UDP Games   All Rights Reserved.						  *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------	------------- *
+ *                                                                            *
+ *============================================================================*/
+#include <viper3d/Math.h>
+
+/* System Headers */
+
+/* Local Headers */
+#include <viper3d/math/SIMD.h>
+
+namespace UDP
+{
+
+const VAffine VAffine::AFFINE_IDENTITY;
+
+/********************************************************************
+ *          C O N S T R U C T I O N / D E S T R U C T I O N         *
+ ********************************************************************/
+VAffine::VAffine(const VQuaternion& qRot, const VVector& vPos, float fScale /*=1.0f*/)
+{
+	Set(qRot, vPos, fScale);
+}
+
+VAffine::VAffine(const VMatrix& mat)
+{
+	FromMatrix(mat);
+}
+
+/********************************************************************
+ *                        A T T R I B U T E S                       *
+ ********************************************************************/
+
+VVector VAffine::GetTranslation() const
+{
+	return VVector(m[0][3], m[1][3], m[2][3]);
+}
+
+/*------------------------------------------------------------------*
+ *							 ToMatrix()								*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Expands this transform to a full 4x4.
+ *	@date		17-Oct-2026
+ *
+ *	@param		mat		Receives the top three rows, and (0, 0, 0, 1)
+ *						as the fourth.
+ *
+ *	@returns	void
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VAffine::ToMatrix(VMatrix& mat) const
+{
+	for (int i = 0; i < 3; i++)
+	{
+		for (int j = 0; j < 4; j++)
+			mat[i][j] = m[i][j];
+	}
+	mat[3][0] = mat[3][1] = mat[3][2] = 0.0f;
+	mat[3][3] = 1.0f;
+}
+
+/********************************************************************
+ *                        O P E R A T I O N S                       *
+ ********************************************************************/
+
+/*------------------------------------------------------------------*
+ *								 Set()								*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Builds the transform from a rotation, position and
+ *				uniform scale.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	Same rotation as VQuaternion::ToRotationMatrix(), scaled,
+ *				with the position as the translation; points are scaled,
+ *				then rotated, then moved.
+ *
+ *	@param		qRot	Unit quaternion
+ *	@param		vPos	Translation
+ *	@param		fScale	Scale applied along every axis
+ *
+ *	@returns	void
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VAffine::Set(const VQuaternion& qRot, const VVector& vPos, float fScale /*=1.0f*/)
+{
+	float fTx	= 2.0f * qRot.x;
+	float fTy	= 2.0f * qRot.y;
+	float fTz	= 2.0f * qRot.z;
+	float fTwx	= fTx * qRot.w;
+	float fTwy	= fTy * qRot.w;
+	float fTwz	= fTz * qRot.w;
+	float fTxx	= fTx * qRot.x;
+	float fTxy	= fTy * qRot.x;
+	float fTxz	= fTz * qRot.x;
+	float fTyy	= fTy * qRot.y;
+	float fTyz	= fTz * qRot.y;
+	float fTzz	= fTz * qRot.z;
+
+	m[0][0] = (1.0f - fTyy - fTzz) * fScale;
+	m[0][1] = (fTxy - fTwz) * fScale;
+	m[0][2] = (fTxz + fTwy) * fScale;
+	m[0][3] = vPos.x;
+	m[1][0] = (fTxy + fTwz) * fScale;
+	m[1][1] = (1.0f - fTxx - fTzz) * fScale;
+	m[1][2] = (fTyz - fTwx) * fScale;
+	m[1][3] = vPos.y;
+	m[2][0] = (fTxz - fTwy) * fScale;
+	m[2][1] = (fTyz + fTwx) * fScale;
+	m[2][2] = (1.0f - fTxx - fTyy) * fScale;
+	m[2][3] = vPos.z;
+}
+
+void VAffine::SetTranslation(const VVector& vPos)
+{
+	m[0][3] = vPos.x;
+	m[1][3] = vPos.y;
+	m[2][3] = vPos.z;
+}
+
+/*------------------------------------------------------------------*
+ *							FromMatrix()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Takes the top three rows of a 4x4.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	The bottom row is assumed to be (0, 0, 0, 1); a
+ *				projection loses its perspective terms.
+ *
+ *	@param		mat		Column vector transform, translation in
+ *						column 3
+ *
+ *	@returns	void
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VAffine::FromMatrix(const VMatrix& mat)
+{
+	for (int i = 0; i < 3; i++)
+	{
+		for (int j = 0; j < 4; j++)
+			m[i][j] = mat[i][j];
+	}
+}
+
+/*------------------------------------------------------------------*
+ *							 InverseOf()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Sets this transform to the inverse of another.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	Handles any scale or shear.  Use OrthoInverseOf() when
+ *				the scale is known to be uniform.
+ *
+ *	@param		xf		Transform to invert.  May be this one.
+ *
+ *	@returns	(bool)	false if xf is singular, in which case this
+ *						transform is left unchanged.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+bool VAffine::InverseOf(const VAffine& xf)
+{
+	return VSimd::mKernels.AffineInverse(m[0], xf.m[0]);
+}
+
+/*------------------------------------------------------------------*
+ *						   OrthoInverseOf()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Sets this transform to the inverse of one built from a
+ *				rotation, a uniform scale and a translation.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	A transpose, a scale and one rotated translation; no
+ *				determinant.  The result is wrong for anything with
+ *				shear or non-uniform scale.
+ *
+ *	@param		xf		Transform to invert.  May be this one.
+ *
+ *	@returns	(bool)	false if xf has zero scale, in which case this
+ *						transform is left unchanged.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+bool VAffine::OrthoInverseOf(const VAffine& xf)
+{
+	return VSimd::mKernels.AffineOrthoInverse(m[0], xf.m[0]);
+}
+
+VVector VAffine::TransformPoint(const VVector& vec) const
+{
+	return VVector(m[0][0] * vec.x + m[0][1] * vec.y + m[0][2] * vec.z + m[0][3],
+				   m[1][0] * vec.x + m[1][1] * vec.y + m[1][2] * vec.z + m[1][3],
+				   m[2][0] * vec.x + m[2][1] * vec.y + m[2][2] * vec.z + m[2][3],
+				   1.0f);
+}
+
+VVector VAffine::TransformDirection(const VVector& vec) const
+{
+	return VVector(m[0][0] * vec.x + m[0][1] * vec.y + m[0][2] * vec.z,
+				   m[1][0] * vec.x + m[1][1] * vec.y + m[1][2] * vec.z,
+				   m[2][0] * vec.x + m[2][1] * vec.y + m[2][2] * vec.z,
+				   0.0f);
+}
+
+/*------------------------------------------------------------------*
+ *						  TransformPoints()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Transforms an array of points by this transform.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	The transposed 4x4 is exactly the row vector matrix
+ *				VMatrix::TransformPoints() takes, so this shares its
+ *				kernel.  Every result has w = 1.
+ *
+ *	@param		pOut	Receives nCount points.  May be pIn.
+ *	@param		pIn		Points to transform.
+ *	@param		nCount	Number of points.
+ *
+ *	@returns	void
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VAffine::TransformPoints(VVector *pOut, const VVector *pIn, VUINT nCount) const
+{
+	VMatrix vMat;
+
+	ToMatrix(vMat);
+	vMat.TransposeOf(vMat);
+	vMat.TransformPoints(pOut, pIn, nCount);
+}
+
+/*------------------------------------------------------------------*
+ *						TransformDirections()						*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Transforms an array of directions by this transform.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	The translation is ignored, and every result has w = 0.
+ *
+ *	@param		pOut	Receives nCount directions.  May be pIn.
+ *	@param		pIn		Directions to transform.
+ *	@param		nCount	Number of directions.
+ *
+ *	@returns	void
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VAffine::TransformDirections(VVector *pOut, const VVector *pIn, VUINT nCount) const
+{
+	VMatrix vMat;
+
+	ToMatrix(vMat);
+	vMat.TransposeOf(vMat);
+	vMat.TransformDirections(pOut, pIn, nCount);
+}
+
+/********************************************************************
+ *                          O P E R A T O R S                       *
+ ********************************************************************/
+
+VAffine VAffine::operator*(const VAffine& xf) const
+{
+	VAffine vResult;
+
+	VSimd::mKernels.AffineMultiply(vResult.m[0], m[0], xf.m[0]);
+	return vResult;
+}
+
+VMatrix operator*(const VMatrix& mat, const VAffine& xf)
+{
+	VMatrix vResult;
+
+	xf.ToMatrix(vResult);
+	VSimd::mKernels.MatrixMultiply(vResult[0], mat[0], vResult[0]);
+	return vResult;
+}
+
+} // End Namespace
@@ -0,0 +1,198 @@
+/*============================================================================*
+ *                                                                            *
+ * 	This file is part of the Viper3D Game Engine.							  *
+ *                                                                            *
+ *	Copyright (C) 2004 UDP Games   All Rights Reserved.						  *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------	------------- *
+ *                                                                            *
+ *============================================================================*/
+#include <viper3d/math/Broadphase.h>
+
+/* System Headers */
+
+/* Local Headers */
+
+namespace UDP
+{
+
+/********************************************************************
+ *          C O N S T R U C T I O N / D E S T R U C T I O N         *
+ ********************************************************************/
+VBroadphase::VBroadphase()
+: mCount(0)
+{
+
+}
+
+VBroadphase::~VBroadphase()
+{
+
+}
+
+/********************************************************************
+ *                        A T T R I B U T E S                       *
+ ********************************************************************/
+VAabb VBroadphase::GetBox(VUINT nProxy) const
+{
+	const VBroadBox &b = mBoxes[nProxy];
+
+	return VAabb(VVector(b.mMin[0], b.mMin[1], b.mMin[2]),
+				VVector(b.mMax[0], b.mMax[1], b.mMax[2]));
+}
+
+/********************************************************************
+ *                        O P E R A T I O N S                       *
+ ********************************************************************/
+
+/*------------------------------------------------------------------*
+ *							  AddProxy()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Adds a box to the set.
+ *	@date		17-Oct-2026
+ *
+ *	@param		box		Bounds of the new proxy
+ *
+ *	@returns	(VUINT) Handle of the proxy.  Its pairs show up after the
+ *				next Update().
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+VUINT VBroadphase::AddProxy(const VAabb &box)
+{
+	VUINT vProxy;
+
+	if (!mFree.empty())
+	{
+		vProxy = mFree.back();
+		mFree.pop_back();
+	}
+	else
+	{
+		vProxy = (VUINT)mBoxes.size();
+		mBoxes.resize(vProxy + 1);
+		mLive.push_back(0);
+	}
+
+	mLive[vProxy] = 1;
+	mAdded.push_back(vProxy);
+	mCount++;
+	MoveProxy(vProxy, box);
+	return vProxy;
+}
+
+/*------------------------------------------------------------------*
+ *							  MoveProxy()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Changes the bounds of a proxy.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	Only the bounds are stored; the work happens in Update(),
+ *				so moving a proxy several times in one frame is cheap.
+ *
+ *	@param		nProxy	Handle from AddProxy()
+ *	@param		box		New bounds
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VBroadphase::MoveProxy(VUINT nProxy, const VAabb &box)
+{
+	if (!IsValid(nProxy))
+		return;
+
+	VBroadBox &b = mBoxes[nProxy];
+	b.mMin[0] = box.GetMin().x;
+	b.mMin[1] = box.GetMin().y;
+	b.mMin[2] = box.GetMin().z;
+	b.mMax[0] = box.GetMax().x;
+	b.mMax[1] = box.GetMax().y;
+	b.mMax[2] = box.GetMax().z;
+}
+
+/*------------------------------------------------------------------*
+ *							 RemoveProxy()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Takes a box out of the set.
+ *	@date		17-Oct-2026
+ *
+ *	@param		nProxy	Handle from AddProxy().  Its pairs go away on
+ *						the next Update().
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VBroadphase::RemoveProxy(VUINT nProxy)
+{
+	if (!IsValid(nProxy))
+		return;
+
+	mLive[nProxy] = 0;
+	mRemoved.push_back(nProxy);
+	mCount--;
+}
+
+/*------------------------------------------------------------------*
+ *								Update()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Brings the pair list up to date.
+ *	@date		17-Oct-2026
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VBroadphase::Update()
+{
+	UpdatePairs();
+
+	mFree.insert(mFree.end(), mRemoved.begin(), mRemoved.end());
+	mAdded.clear();
+	mRemoved.clear();
+}
+
+/*------------------------------------------------------------------*
+ *								Clear()								*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Removes every proxy and pair.
+ *	@date		17-Oct-2026
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VBroadphase::Clear()
+{
+	mBoxes.clear();
+	mLive.clear();
+	mAdded.clear();
+	mRemoved.clear();
+	mFree.clear();
+	mPairs.clear();
+	mCount = 0;
+	OnClear();
+}
+
+} // End Namespace
@@ -0,0 +1,831 @@
+/*============================================================================*
+ *                                                                            *
+ * 	This file is part of the Viper3D Game Engine.							  *
+ *                                                                            *
+ *	Copyright (C) 2004 UDP Games   All Rights Reserved.						  *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------	------------- *
+ *                                                                            *
+ *============================================================================*/
+#include <viper3d/math/Bvh.h>
+
+/* System Headers */
+
+/* Local Headers */
+#include <viper3d/math/SlabRay.h>
+
+namespace UDP
+{
+
+#define VBVH_HUGE			1e30f
+#define VBVH_STACK			128		/* traversal stack entries */
+#define VBVH_MAX_SAH_DEPTH	64		/* below this, split at the median */
+
+/*
+ * Half the surface area of a box given by its corners.
+ */
+static inline float HalfArea(const float *pMin, const float *pMax)
+{
+	float fX = pMax[0] - pMin[0];
+	float fY = pMax[1] - pMin[1];
+	float fZ = pMax[2] - pMin[2];
+
+	if (fX < 0.0f || fY < 0.0f || fZ < 0.0f)
+		return 0.0f;
+	return fX * fY + fY * fZ + fZ * fX;
+}
+
+/*
+ * A node's share of VBvh::Cost(), before scaling by the root's area.
+ */
+static inline double NodeCost(const VBvhNode &node)
+{
+	double fArea = HalfArea(node.mMin, node.mMax);
+
+	return node.mCount > 0 ? fArea * node.mCount : fArea;
+}
+
+static inline void ClearBounds(float *pMin, float *pMax)
+{
+	pMin[0] = pMin[1] = pMin[2] = VBVH_HUGE;
+	pMax[0] = pMax[1] = pMax[2] = -VBVH_HUGE;
+}
+
+static inline void GrowBounds(float *pMin, float *pMax, const float *pBMin,
+								const float *pBMax)
+{
+	for (int i = 0; i < 3; i++)
+	{
+		if (pBMin[i] < pMin[i]) pMin[i] = pBMin[i];
+		if (pBMax[i] > pMax[i]) pMax[i] = pBMax[i];
+	}
+}
+
+static inline void GrowBounds(float *pMin, float *pMax, const VAabb &box)
+{
+	const float vMin[3] = { box.GetMin().x, box.GetMin().y, box.GetMin().z };
+	const float vMax[3] = { box.GetMax().x, box.GetMax().y, box.GetMax().z };
+
+	GrowBounds(pMin, pMax, vMin, vMax);
+}
+
+/*
+ * Plane distance of a box's near or far corner, evaluated in the same
+ * order as VAabb::Cull() so both agree on every box.
+ */
+static inline float NearDist(const VPlane &plane, const float *pMin,
+								const float *pMax)
+{
+	const VVector &vN = plane.m_vN;
+	float fX = vN.x >= 0.0f ? pMin[0] : pMax[0];
+	float fY = vN.y >= 0.0f ? pMin[1] : pMax[1];
+	float fZ = vN.z >= 0.0f ? pMin[2] : pMax[2];
+
+	return (vN.x * fX + vN.y * fY + vN.z * fZ) + plane.m_fD;
+}
+
+static inline float FarDist(const VPlane &plane, const float *pMin,
+								const float *pMax)
+{
+	const VVector &vN = plane.m_vN;
+	float fX = vN.x >= 0.0f ? pMax[0] : pMin[0];
+	float fY = vN.y >= 0.0f ? pMax[1] : pMin[1];
+	float fZ = vN.z >= 0.0f ? pMax[2] : pMin[2];
+
+	return (vN.x * fX + vN.y * fY + vN.z * fZ) + plane.m_fD;
+}
+
+/********************************************************************
+ *          C O N S T R U C T I O N / D E S T R U C T I O N         *
+ ********************************************************************/
+VBvh::VBvh()
+{
+	mBuildCost = 0.0f;
+	mCost = 0.0;
+}
+
+VBvh::~VBvh()
+{
+
+}
+
+/********************************************************************
+ *                        A T T R I B U T E S                       *
+ ********************************************************************/
+
+/*------------------------------------------------------------------*
+ *								Cost()								*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Surface area heuristic cost of the current tree.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	Expected number of node visits plus item tests for a
+ *				random ray, relative to the root's area.  Refitting moved
+ *				boxes makes this grow; compare against the value measured
+ *				right after Build() to decide when to rebuild.  The sum
+ *				is kept up to date as nodes are refitted, so this is
+ *				cheap enough to check every frame.
+ *
+ *	@returns	(float) Tree cost, 0 for an empty tree
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+float VBvh::Cost() const
+{
+	float fRoot;
+
+	if (mNodes.empty())
+		return 0.0f;
+
+	fRoot = HalfArea(mNodes[0].mMin, mNodes[0].mMax);
+	if (fRoot <= 0.0f)
+		return 0.0f;
+
+	return (float)(mCost / fRoot);
+}
+
+/*------------------------------------------------------------------*
+ *							  IsDegraded()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Checks whether refitting has worn the tree down enough
+ *				to be worth a Rebuild().
+ *	@date		17-Oct-2026
+ *
+ *	@param		fRatio	Allowed growth of Cost() over the built cost
+ *
+ *	@returns	(bool) True if the tree should be rebuilt
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+bool VBvh::IsDegraded(float fRatio /*=1.5f*/) const
+{
+	if (mNodes.empty())
+		return false;
+
+	return Cost() > mBuildCost * fRatio;
+}
+
+/********************************************************************
+ *                        O P E R A T I O N S                       *
+ ********************************************************************/
+
+/*------------------------------------------------------------------*
+ *								Build()								*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Builds the hierarchy over a set of boxes.
+ *	@date		17-Oct-2026
+ *
+ *	@param		pBoxes	Item bounds; item i is pBoxes[i]
+ *	@param		nCount	Number of items
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VBvh::Build(const VAabb *pBoxes, VUINT nCount)
+{
+	mBoxes.assign(pBoxes, pBoxes + nCount);
+	Rebuild();
+}
+
+/*------------------------------------------------------------------*
+ *							   Rebuild()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Builds the hierarchy again from the current item boxes.
+ *	@date		17-Oct-2026
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VBvh::Rebuild()
+{
+	VUINT vCount = Count();
+
+	mNodes.clear();
+	mParent.clear();
+	mItems.resize(vCount);
+	mLeaf.assign(vCount, VBVH_INVALID);
+	mCenters.resize(vCount * 3);
+	mBuildCost = 0.0f;
+	mCost = 0.0;
+
+	if (vCount == 0)
+		return;
+
+	for (VUINT i = 0; i < vCount; i++)
+	{
+		mItems[i] = i;
+		mCenters[i * 3 + 0] = (mBoxes[i].GetMin().x + mBoxes[i].GetMax().x) * 0.5f;
+		mCenters[i * 3 + 1] = (mBoxes[i].GetMin().y + mBoxes[i].GetMax().y) * 0.5f;
+		mCenters[i * 3 + 2] = (mBoxes[i].GetMin().z + mBoxes[i].GetMax().z) * 0.5f;
+	}
+
+	mNodes.reserve(vCount * 2);
+	mParent.reserve(vCount * 2);
+	mNodes.resize(1);
+	mParent.push_back(VBVH_INVALID);
+	Split(0, 0, vCount, 0);
+
+	SumCost();
+	mBuildCost = Cost();
+}
+
+/*------------------------------------------------------------------*
+ *								Update()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Moves one item and refits the nodes above it.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	Walks from the item's leaf towards the root and stops as
+ *				soon as a node's bounds come out unchanged.  The tree
+ *				shape is kept, so check IsDegraded() now and then.
+ *
+ *	@param		nItem	Index of the item that moved
+ *	@param		box		New bounds of the item
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VBvh::Update(VUINT nItem, const VAabb &box)
+{
+	VBvhNode	vOld;
+	VUINT		vNode;
+
+	mBoxes[nItem] = box;
+
+	vNode = mLeaf[nItem];
+	while (vNode != VBVH_INVALID)
+	{
+		vOld = mNodes[vNode];
+		if (mNodes[vNode].mCount > 0)
+			FitLeaf(vNode);
+		else
+			FitInterior(vNode);
+
+		const VBvhNode &vNew = mNodes[vNode];
+		mCost += NodeCost(vNew) - NodeCost(vOld);
+		if (vOld.mMin[0] == vNew.mMin[0] && vOld.mMin[1] == vNew.mMin[1] &&
+			vOld.mMin[2] == vNew.mMin[2] && vOld.mMax[0] == vNew.mMax[0] &&
+			vOld.mMax[1] == vNew.mMax[1] && vOld.mMax[2] == vNew.mMax[2])
+			break;
+
+		vNode = mParent[vNode];
+	}
+}
+
+/*------------------------------------------------------------------*
+ *								Refit()								*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Recomputes every node's bounds from the item boxes.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	Children are always stored after their parent, so one
+ *				backwards pass is enough.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VBvh::Refit()
+{
+	for (VUINT i = (VUINT)mNodes.size(); i-- > 0; )
+	{
+		if (mNodes[i].mCount > 0)
+			FitLeaf(i);
+		else
+			FitInterior(i);
+	}
+	SumCost();
+}
+
+/*------------------------------------------------------------------*
+ *								Cull()								*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Collects the items whose boxes are not culled by a set
+ *				of planes.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	Planes a node lies completely inside of are not tested
+ *				again below it, and a node inside all of them adds its
+ *				whole subtree without further tests.  An item is kept
+ *				exactly when VAabb::Cull() would not return VCULLED.
+ *
+ *	@param		pPlanes		Planes, normals pointing out of the volume
+ *	@param		nNumPlanes	Number of planes (at most 32)
+ *	@param		vItems		Receives the surviving item indices
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VBvh::Cull(const VPlane *pPlanes, int nNumPlanes,
+				std::vector<VUINT> &vItems) const
+{
+	VUINT	vStack[VBVH_STACK][2];
+	int		vTop = 0;
+	VUINT	vNodeIdx, vMask;
+	bool	bCulled;
+
+	if (mNodes.empty())
+		return;
+	if (nNumPlanes > 32)
+		nNumPlanes = 32;
+
+	vStack[0][0] = 0;
+	vStack[0][1] = nNumPlanes == 32 ? 0xFFFFFFFFu : (1u << nNumPlanes) - 1;
+	vTop = 1;
+
+	while (vTop > 0)
+	{
+		vTop--;
+		vNodeIdx = vStack[vTop][0];
+		vMask = vStack[vTop][1];
+
+		const VBvhNode &vNode = mNodes[vNodeIdx];
+
+		bCulled = false;
+		for (int p = 0; p < nNumPlanes; p++)
+		{
+			if ((vMask & (1u << p)) == 0)
+				continue;
+			if (NearDist(pPlanes[p], vNode.mMin, vNode.mMax) > 0.0f)
+			{
+				bCulled = true;
+				break;
+			}
+			if (FarDist(pPlanes[p], vNode.mMin, vNode.mMax) < 0.0f)
+				vMask &= ~(1u << p);
+		}
+		if (bCulled)
+			continue;
+
+		if (vMask == 0)
+		{
+			AddSubtree(vNodeIdx, vItems);
+			continue;
+		}
+
+		if (vNode.mCount == 0)
+		{
+			vStack[vTop][0] = vNode.mFirst;
+			vStack[vTop][1] = vMask;
+			vStack[vTop + 1][0] = vNode.mFirst + 1;
+			vStack[vTop + 1][1] = vMask;
+			vTop += 2;
+			continue;
+		}
+
+		for (VUINT i = 0; i < vNode.mCount; i++)
+		{
+			VUINT vItem = mItems[vNode.mFirst + i];
+			const VAabb &vBox = mBoxes[vItem];
+			const float vMin[3] = { vBox.GetMin().x, vBox.GetMin().y,
+									vBox.GetMin().z };
+			const float vMax[3] = { vBox.GetMax().x, vBox.GetMax().y,
+									vBox.GetMax().z };
+
+			bCulled = false;
+			for (int p = 0; p < nNumPlanes && !bCulled; p++)
+				if ((vMask & (1u << p)) &&
+					NearDist(pPlanes[p], vMin, vMax) > 0.0f)
+					bCulled = true;
+			if (!bCulled)
+				vItems.push_back(vItem);
+		}
+	}
+}
+
+/*------------------------------------------------------------------*
+ *							  Intersects()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Collects every item whose box is hit by a ray.
+ *	@date		17-Oct-2026
+ *
+ *	@param		ray		Ray to test
+ *	@param		vItems	Receives the indices of items hit, in no
+ *						particular order
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VBvh::Intersects(const VRay &ray, std::vector<VUINT> &vItems) const
+{
+	VSlabRay	vRay(ray);
+	float		fEnter;
+	VUINT		vStack[VBVH_STACK];
+	int			vTop;
+
+	if (mNodes.empty())
+		return;
+
+	vStack[0] = 0;
+	vTop = 1;
+
+	while (vTop > 0)
+	{
+		const VBvhNode &vNode = mNodes[vStack[--vTop]];
+
+		if (!vRay.Enters(vNode.mMin, vNode.mMax, VBVH_HUGE, &fEnter))
+			continue;
+
+		if (vNode.mCount == 0)
+		{
+			vStack[vTop++] = vNode.mFirst;
+			vStack[vTop++] = vNode.mFirst + 1;
+			continue;
+		}
+
+		for (VUINT i = 0; i < vNode.mCount; i++)
+		{
+			VUINT vItem = mItems[vNode.mFirst + i];
+			if (vRay.Intersects(mBoxes[vItem], (float*)NULL))
+				vItems.push_back(vItem);
+		}
+	}
+}
+
+/*------------------------------------------------------------------*
+ *								Pick()								*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Finds the nearest item whose box is hit by a ray.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	Children are visited nearest first and anything starting
+ *				beyond the best hit so far is skipped.  Distances are the
+ *				ones reported by VRay::Intersects(const VAabb&).
+ *
+ *	@param		ray		Ray to test
+ *	@param		pItem	Receives the index of the nearest item hit
+ *	@param		t		Optional; receives the distance along the ray
+ *
+ *	@returns	(bool) True if anything was hit
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+bool VBvh::Pick(const VRay &ray, VUINT *pItem, float *t) const
+{
+	VSlabRay	vRay(ray);
+	float		fEnter, fEnter2, fHit;
+	float		fBest = VBVH_HUGE;
+	VUINT		vBest = VBVH_INVALID;
+	VUINT		vStack[VBVH_STACK];
+	int			vTop;
+
+	if (mNodes.empty())
+		return false;
+
+	vStack[0] = 0;
+	vTop = 1;
+
+	while (vTop > 0)
+	{
+		const VBvhNode &vNode = mNodes[vStack[--vTop]];
+
+		if (!vRay.Enters(vNode.mMin, vNode.mMax, fBest, &fEnter))
+			continue;
+
+		if (vNode.mCount == 0)
+		{
+			VUINT vLeft = vNode.mFirst;
+			VUINT vRight = vNode.mFirst + 1;
+			bool bLeft = vRay.Enters(mNodes[vLeft].mMin, mNodes[vLeft].mMax,
+									fBest, &fEnter);
+			bool bRight = vRay.Enters(mNodes[vRight].mMin, mNodes[vRight].mMax,
+									fBest, &fEnter2);
+
+			/* push the far child first so the near one is popped next */
+			if (bLeft && bRight)
+			{
+				if (fEnter <= fEnter2)
+				{
+					vStack[vTop++] = vRight;
+					vStack[vTop++] = vLeft;
+				}
+				else
+				{
+					vStack[vTop++] = vLeft;
+					vStack[vTop++] = vRight;
+				}
+			}
+			else if (bLeft)
+				vStack[vTop++] = vLeft;
+			else if (bRight)
+				vStack[vTop++] = vRight;
+			continue;
+		}
+
+		for (VUINT i = 0; i < vNode.mCount; i++)
+		{
+			VUINT vItem = mItems[vNode.mFirst + i];
+			if (vRay.Intersects(mBoxes[vItem], &fHit) && fHit < fBest)
+			{
+				fBest = fHit;
+				vBest = vItem;
+			}
+		}
+	}
+
+	if (vBest == VBVH_INVALID)
+		return false;
+
+	if (pItem)
+		*pItem = vBest;
+	if (t)
+		*t = fBest;
+	return true;
+}
+
+/*------------------------------------------------------------------*
+ *								Overlap()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Collects every item whose box overlaps another box.
+ *	@date		17-Oct-2026
+ *
+ *	@param		box		Box to test
+ *	@param		vItems	Receives the indices of overlapping items
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VBvh::Overlap(const VAabb &box, std::vector<VUINT> &vItems) const
+{
+	const float vMin[3] = { box.GetMin().x, box.GetMin().y, box.GetMin().z };
+	const float vMax[3] = { box.GetMax().x, box.GetMax().y, box.GetMax().z };
+	VUINT	vStack[VBVH_STACK];
+	int		vTop;
+
+	if (mNodes.empty())
+		return;
+
+	vStack[0] = 0;
+	vTop = 1;
+
+	while (vTop > 0)
+	{
+		const VBvhNode &vNode = mNodes[vStack[--vTop]];
+
+		if (vNode.mMin[0] > vMax[0] || vMin[0] > vNode.mMax[0] ||
+			vNode.mMin[1] > vMax[1] || vMin[1] > vNode.mMax[1] ||
+			vNode.mMin[2] > vMax[2] || vMin[2] > vNode.mMax[2])
+			continue;
+
+		if (vNode.mCount == 0)
+		{
+			vStack[vTop++] = vNode.mFirst;
+			vStack[vTop++] = vNode.mFirst + 1;
+			continue;
+		}
+
+		for (VUINT i = 0; i < vNode.mCount; i++)
+		{
+			VUINT vItem = mItems[vNode.mFirst + i];
+			const VAabb &vBox = mBoxes[vItem];
+
+			if (vBox.GetMin().x > vMax[0] || vMin[0] > vBox.GetMax().x ||
+				vBox.GetMin().y > vMax[1] || vMin[1] > vBox.GetMax().y ||
+				vBox.GetMin().z > vMax[2] || vMin[2] > vBox.GetMax().z)
+				continue;
+			vItems.push_back(vItem);
+		}
+	}
+}
+
+/********************************************************************
+ *                         I N T E R N A L S                        *
+ ********************************************************************/
+
+/*------------------------------------------------------------------*
+ *								Split()								*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Bound the items and their centroids							*
+ *		If few enough items, make a leaf							*
+ *		For each axis, drop the centroids into VBVH_BINS buckets	*
+ *			and sweep the bucket boundaries for the lowest			*
+ *			left area * left count + right area * right count		*
+ *		Partition the items on the best boundary (or in half if		*
+ *			every centroid is the same or the tree is already		*
+ *			VBVH_MAX_SAH_DEPTH deep) and recurse on both sides		*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VBvh::Split(VUINT nNode, VUINT nFirst, VUINT nCount, int nDepth)
+{
+	float	vCMin[3], vCMax[3];
+	float	vBinMin[VBVH_BINS][3], vBinMax[VBVH_BINS][3];
+	VUINT	vBinCount[VBVH_BINS];
+	float	vRightArea[VBVH_BINS];
+	VUINT	vRightCount[VBVH_BINS];
+	float	vMin[3], vMax[3];
+	float	fBestCost = VBVH_HUGE;
+	int		vBestAxis = -1, vBestBin = 0;
+	VUINT	vLeftCount, vCount;
+	float	fScale, fCost;
+	int		vBin;
+
+	/* node bounds and centroid bounds */
+	ClearBounds(mNodes[nNode].mMin, mNodes[nNode].mMax);
+	ClearBounds(vCMin, vCMax);
+	for (VUINT i = nFirst; i < nFirst + nCount; i++)
+	{
+		const float *vC = &mCenters[mItems[i] * 3];
+
+		GrowBounds(mNodes[nNode].mMin, mNodes[nNode].mMax, mBoxes[mItems[i]]);
+		GrowBounds(vCMin, vCMax, vC, vC);
+	}
+
+	if (nCount <= VBVH_LEAF_SIZE)
+	{
+		mNodes[nNode].mFirst = nFirst;
+		mNodes[nNode].mCount = nCount;
+		for (VUINT i = nFirst; i < nFirst + nCount; i++)
+			mLeaf[mItems[i]] = nNode;
+		return;
+	}
+
+	for (int a = 0; a < 3 && nDepth < VBVH_MAX_SAH_DEPTH; a++)
+	{
+		if (vCMax[a] <= vCMin[a])
+			continue;
+
+		fScale = VBVH_BINS / (vCMax[a] - vCMin[a]);
+		for (int b = 0; b < VBVH_BINS; b++)
+		{
+			vBinCount[b] = 0;
+			ClearBounds(vBinMin[b], vBinMax[b]);
+		}
+		for (VUINT i = nFirst; i < nFirst + nCount; i++)
+		{
+			vBin = (int)((mCenters[mItems[i] * 3 + a] - vCMin[a]) * fScale);
+			if (vBin >= VBVH_BINS)
+				vBin = VBVH_BINS - 1;
+			vBinCount[vBin]++;
+			GrowBounds(vBinMin[vBin], vBinMax[vBin], mBoxes[mItems[i]]);
+		}
+
+		/* right-hand sweep */
+		ClearBounds(vMin, vMax);
+		vCount = 0;
+		for (int b = VBVH_BINS - 1; b > 0; b--)
+		{
+			GrowBounds(vMin, vMax, vBinMin[b], vBinMax[b]);
+			vCount += vBinCount[b];
+			vRightArea[b] = HalfArea(vMin, vMax);
+			vRightCount[b] = vCount;
+		}
+
+		/* left-hand sweep, splitting after bin b */
+		ClearBounds(vMin, vMax);
+		vCount = 0;
+		for (int b = 0; b < VBVH_BINS - 1; b++)
+		{
+			GrowBounds(vMin, vMax, vBinMin[b], vBinMax[b]);
+			vCount += vBinCount[b];
+			if (vCount == 0 || vRightCount[b + 1] == 0)
+				continue;
+			fCost = HalfArea(vMin, vMax) * vCount +
+					vRightArea[b + 1] * vRightCount[b + 1];
+			if (fCost < fBestCost)
+			{
+				fBestCost = fCost;
+				vBestAxis = a;
+				vBestBin = b;
+			}
+		}
+	}
+
+	if (vBestAxis < 0)
+	{
+		/*
+		 * every centroid in the same spot, or the tree is getting too
+		 * deep for the traversal stacks; split the list in half
+		 */
+		vLeftCount = nCount / 2;
+	}
+	else
+	{
+		VUINT vLo = nFirst;
+		VUINT vHi = nFirst + nCount;
+		VUINT vTmp;
+
+		fScale = VBVH_BINS / (vCMax[vBestAxis] - vCMin[vBestAxis]);
+		while (vLo < vHi)
+		{
+			vBin = (int)((mCenters[mItems[vLo] * 3 + vBestAxis] -
+						vCMin[vBestAxis]) * fScale);
+			if (vBin >= VBVH_BINS)
+				vBin = VBVH_BINS - 1;
+			if (vBin <= vBestBin)
+				vLo++;
+			else
+			{
+				vTmp = mItems[vLo];
+				mItems[vLo] = mItems[--vHi];
+				mItems[vHi] = vTmp;
+			}
+		}
+		vLeftCount = vLo - nFirst;
+	}
+
+	VUINT vLeft = (VUINT)mNodes.size();
+	mNodes.resize(vLeft + 2);
+	mParent.push_back(nNode);
+	mParent.push_back(nNode);
+	mNodes[nNode].mFirst = vLeft;
+	mNodes[nNode].mCount = 0;
+
+	Split(vLeft, nFirst, vLeftCount, nDepth + 1);
+	Split(vLeft + 1, nFirst + vLeftCount, nCount - vLeftCount, nDepth + 1);
+}
+
+void VBvh::FitLeaf(VUINT nNode)
+{
+	VBvhNode &vNode = mNodes[nNode];
+
+	ClearBounds(vNode.mMin, vNode.mMax);
+	for (VUINT i = vNode.mFirst; i < vNode.mFirst + vNode.mCount; i++)
+		GrowBounds(vNode.mMin, vNode.mMax, mBoxes[mItems[i]]);
+}
+
+void VBvh::FitInterior(VUINT nNode)
+{
+	VBvhNode &vNode = mNodes[nNode];
+	const VBvhNode &vLeft = mNodes[vNode.mFirst];
+	const VBvhNode &vRight = mNodes[vNode.mFirst + 1];
+
+	for (int i = 0; i < 3; i++)
+	{
+		vNode.mMin[i] = vLeft.mMin[i] < vRight.mMin[i] ? vLeft.mMin[i] : vRight.mMin[i];
+		vNode.mMax[i] = vLeft.mMax[i] > vRight.mMax[i] ? vLeft.mMax[i] : vRight.mMax[i];
+	}
+}
+
+void VBvh::SumCost()
+{
+	mCost = 0.0;
+	for (VUINT i = 0; i < mNodes.size(); i++)
+		mCost += NodeCost(mNodes[i]);
+}
+
+void VBvh::AddSubtree(VUINT nNode, std::vector<VUINT> &vItems) const
+{
+	const VBvhNode &vNode = mNodes[nNode];
+
+	if (vNode.mCount > 0)
+	{
+		for (VUINT i = 0; i < vNode.mCount; i++)
+			vItems.push_back(mItems[vNode.mFirst + i]);
+		return;
+	}
+
+	AddSubtree(vNode.mFirst, vItems);
+	AddSubtree(vNode.mFirst + 1, vItems);
+}
+
+} // End Namespace
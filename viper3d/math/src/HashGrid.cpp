@@ -0,0 +1,200 @@
+/*============================================================================*
+ *                                                                            *
+ * 	This file is part of the Viper3D Game Engine.							  *
+ *                                                                            *
+ *	Copyright (C) 2004 UDP Games   All Rights Reserved.						  *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------	------------- *
+ *                                                                            *
+ *============================================================================*/
+#include <viper3d/math/Broadphase.h>
+
+/* System Headers */
+#include <cmath>
+
+/* Local Headers */
+
+namespace UDP
+{
+
+#define VGRID_MIN_BUCKETS	64
+
+/********************************************************************
+ *          C O N S T R U C T I O N / D E S T R U C T I O N         *
+ ********************************************************************/
+VHashGrid::VHashGrid(float fCellSize /*=1.0f*/)
+: mMask(0)
+{
+	SetCellSize(fCellSize);
+}
+
+VHashGrid::~VHashGrid()
+{
+
+}
+
+/********************************************************************
+ *                        A T T R I B U T E S                       *
+ ********************************************************************/
+
+/*------------------------------------------------------------------*
+ *							 SetCellSize()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Sets the edge length of a grid cell.
+ *	@date		17-Oct-2026
+ *
+ *	@param		fCellSize	Edge length; about the size of a typical box
+ *							works best.  Takes effect on the next
+ *							Update().
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VHashGrid::SetCellSize(float fCellSize)
+{
+	mCellSize = fCellSize;
+	mInvCellSize = 1.0f / fCellSize;
+}
+
+/********************************************************************
+ *                         C A L L B A C K S                        *
+ ********************************************************************/
+
+/*------------------------------------------------------------------*
+ *							 UpdatePairs()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Bins every box and tests the boxes sharing a cell.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	Entries are counting-sorted by bucket, so the boxes of a
+ *				bucket sit next to each other.  Different cells can hash
+ *				to the same bucket, so entries are compared by cell too.
+ *				The low corner of the overlap of two boxes lies in both,
+ *				which makes its cell the one place to report the pair.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VHashGrid::UpdatePairs()
+{
+	VEntry		vEntry;
+	VBroadPair	vPair;
+	int			vLo[3], vHi[3];
+	VUINT		vBuckets, vSum, vBucket;
+
+	mPairs.clear();
+	mEntries.clear();
+
+	for (VUINT p = 0; p < (VUINT)mBoxes.size(); p++)
+	{
+		if (mLive[p] == 0)
+			continue;
+		for (int a = 0; a < 3; a++)
+		{
+			vLo[a] = CellOf(mBoxes[p].mMin[a]);
+			vHi[a] = CellOf(mBoxes[p].mMax[a]);
+		}
+		vEntry.mProxy = p;
+		for (int z = vLo[2]; z <= vHi[2]; z++)
+			for (int y = vLo[1]; y <= vHi[1]; y++)
+				for (int x = vLo[0]; x <= vHi[0]; x++)
+				{
+					vEntry.mCell[0] = x;
+					vEntry.mCell[1] = y;
+					vEntry.mCell[2] = z;
+					mEntries.push_back(vEntry);
+				}
+	}
+
+	vBuckets = VGRID_MIN_BUCKETS;
+	while (vBuckets < mEntries.size() * 2)
+		vBuckets <<= 1;
+	mMask = vBuckets - 1;
+
+	/* mStart ends up holding the first entry of each bucket */
+	mStart.assign(vBuckets + 1, 0);
+	for (VUINT i = 0; i < (VUINT)mEntries.size(); i++)
+		mStart[Bucket(mEntries[i].mCell)]++;
+	vSum = 0;
+	for (VUINT b = 0; b <= vBuckets; b++)
+	{
+		vSum += mStart[b];
+		mStart[b] = vSum;
+	}
+	mSorted.resize(mEntries.size());
+	for (VUINT i = (VUINT)mEntries.size(); i-- > 0; )
+	{
+		vBucket = Bucket(mEntries[i].mCell);
+		mSorted[--mStart[vBucket]] = mEntries[i];
+	}
+
+	for (VUINT b = 0; b < vBuckets; b++)
+	{
+		for (VUINT i = mStart[b]; i < mStart[b + 1]; i++)
+		{
+			const VEntry &vA = mSorted[i];
+
+			for (VUINT j = i + 1; j < mStart[b + 1]; j++)
+			{
+				const VEntry &vB = mSorted[j];
+
+				if (vA.mCell[0] != vB.mCell[0] || vA.mCell[1] != vB.mCell[1] ||
+					vA.mCell[2] != vB.mCell[2])
+					continue;
+				if (!Overlaps(vA.mProxy, vB.mProxy))
+					continue;
+
+				const VBroadBox &vBoxA = mBoxes[vA.mProxy];
+				const VBroadBox &vBoxB = mBoxes[vB.mProxy];
+				bool vHere = true;
+				for (int a = 0; a < 3 && vHere; a++)
+				{
+					float vLow = vBoxA.mMin[a] > vBoxB.mMin[a] ? vBoxA.mMin[a] :
+								vBoxB.mMin[a];
+					vHere = CellOf(vLow) == vA.mCell[a];
+				}
+				if (!vHere)
+					continue;
+
+				vPair.mA = vA.mProxy < vB.mProxy ? vA.mProxy : vB.mProxy;
+				vPair.mB = vA.mProxy < vB.mProxy ? vB.mProxy : vA.mProxy;
+				mPairs.push_back(vPair);
+			}
+		}
+	}
+}
+
+void VHashGrid::OnClear()
+{
+	mEntries.clear();
+	mSorted.clear();
+	mStart.clear();
+}
+
+/********************************************************************
+ *                         I N T E R N A L S                        *
+ ********************************************************************/
+int VHashGrid::CellOf(float fValue) const
+{
+	return (int)floorf(fValue * mInvCellSize);
+}
+
+VUINT VHashGrid::Bucket(const int *pCell) const
+{
+	VUINT vHash = (VUINT)pCell[0] * 73856093u ^ (VUINT)pCell[1] * 19349663u ^
+				(VUINT)pCell[2] * 83492791u;
+	return (vHash ^ (vHash >> 13)) & mMask;
+}
+
+} // End Namespace
@@ -0,0 +1,194 @@
+/*============================================================================*
+ *                                                                            *
+ * 	This file is part of the Viper3D Game Engine.							  *
+ *                                                                            *
+ *	Copyright (C) 2004 UDP Games   All Rights Reserved.						  *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------	------------- *
+ *                                                                            *
+ *============================================================================*/
+/*
+ * Polynomial approximations behind the VMathAccuracy tiers, shared by
+ * VMath and the SIMD kernels so every tier of every function rounds the
+ * same way.  Only static functions and macros, since the kernel files
+ * include this with their own instruction set flags.
+ *
+ *	sin, cos	reduced to [-pi/4, pi/4] by multiples of pi/2, with pi/2
+ *				split in three (Cody and Waite) so the reduction stays
+ *				exact for |x| up to about 1e5.  MATH_PRECISE uses the
+ *				Cephes single precision polynomials, MATH_FAST minimax
+ *				fits of degree 3 and 4.
+ *	atan2		atan on [0, 1] after folding the octant; MATH_PRECISE
+ *				reduces once more around tan(pi/8), as Cephes does.
+ *	acos		Abramowitz and Stegun 4.4.46 (MATH_PRECISE) and 4.4.45
+ *				(MATH_FAST), both in terms of sqrt(1 - |x|).
+ *	rsqrt		an integer first guess (Moroz et al.) refined by a
+ *				tuned Newton step, plus a plain one for MATH_PRECISE.
+ *				The SIMD kernels start from the hardware estimate.
+ */
+
+/* System Headers */
+#include <math.h>
+#include <string.h>
+
+#define VAPPROX_PIO2_1			1.5703125f
+#define VAPPROX_PIO2_2			4.837512969970703125e-4f
+#define VAPPROX_PIO2_3			7.54978995489188216e-8f
+#define VAPPROX_2OPI			0.636619772367581343f
+#define VAPPROX_PIO2			1.57079632679489662f
+#define VAPPROX_PIO4			0.785398163397448310f
+#define VAPPROX_PI				3.14159265358979324f
+#define VAPPROX_TANPIO8			0.414213562373095049f
+
+/* MATH_PRECISE: sin r = r + r^3 * S(r^2), cos r = 1 - r^2 / 2 + r^4 * C(r^2) */
+#define VAPPROX_SIN_P0			-1.6666654611e-1f
+#define VAPPROX_SIN_P1			8.3321608736e-3f
+#define VAPPROX_SIN_P2			-1.9515295891e-4f
+#define VAPPROX_COS_P0			4.166664568298827e-2f
+#define VAPPROX_COS_P1			-1.388731625493765e-3f
+#define VAPPROX_COS_P2			2.443315711809948e-5f
+
+/* MATH_FAST: sin r = r * (F0 + F1 r^2), cos r = 1 + r^2 * (G0 + G1 r^2) */
+#define VAPPROX_SIN_F0			0.99903142f
+#define VAPPROX_SIN_F1			-0.16034402f
+#define VAPPROX_COS_F0			-0.49977631f
+#define VAPPROX_COS_F1			0.04048894f
+
+/* atan a = a + a^3 * A(a^2) for MATH_PRECISE, a * B(a^2) for MATH_FAST */
+#define VAPPROX_ATAN_P0			-3.33329491539e-1f
+#define VAPPROX_ATAN_P1			1.99777106478e-1f
+#define VAPPROX_ATAN_P2			-1.38776856032e-1f
+#define VAPPROX_ATAN_P3			8.05374449538e-2f
+#define VAPPROX_ATAN_F0			0.99535795f
+#define VAPPROX_ATAN_F1			-0.28869023f
+#define VAPPROX_ATAN_F2			0.07933904f
+
+/* acos x = sqrt(1 - x) * A(x) on [0, 1] */
+#define VAPPROX_ACOS_P0			1.5707963050f
+#define VAPPROX_ACOS_P1			-0.2145988016f
+#define VAPPROX_ACOS_P2			0.0889789874f
+#define VAPPROX_ACOS_P3			-0.0501743046f
+#define VAPPROX_ACOS_P4			0.0308918810f
+#define VAPPROX_ACOS_P5			-0.0170881256f
+#define VAPPROX_ACOS_P6			0.0066700901f
+#define VAPPROX_ACOS_P7			-0.0012624911f
+#define VAPPROX_ACOS_F0			1.5707288f
+#define VAPPROX_ACOS_F1			-0.2121144f
+#define VAPPROX_ACOS_F2			0.0742610f
+#define VAPPROX_ACOS_F3			-0.0187293f
+
+#define VAPPROX_RSQRT_MAGIC		0x5f1ffff9u
+#define VAPPROX_RSQRT_K0		0.703952253f
+#define VAPPROX_RSQRT_K1		2.38924456f
+
+namespace UDP
+{
+
+static inline void ApproxSinCos(float fValue, float *pSin, float *pCos,
+								VMathAccuracy eAccuracy)
+{
+	/* rounded through an int; floorf is a library call before SSE4.1 */
+	int		vQuad = (int)(fValue * VAPPROX_2OPI + (fValue < 0.0f ? -0.5f : 0.5f));
+	float	fJ = (float)vQuad;
+	float	fR = ((fValue - fJ * VAPPROX_PIO2_1) - fJ * VAPPROX_PIO2_2) - fJ * VAPPROX_PIO2_3;
+	float	fZ = fR * fR;
+	float	fS, fC;
+
+	if (eAccuracy == MATH_FAST)
+	{
+		fS = fR * (VAPPROX_SIN_F0 + VAPPROX_SIN_F1 * fZ);
+		fC = 1.0f + fZ * (VAPPROX_COS_F0 + VAPPROX_COS_F1 * fZ);
+	}
+	else
+	{
+		fS = fR + fR * fZ * (VAPPROX_SIN_P0 + fZ * (VAPPROX_SIN_P1 + fZ * VAPPROX_SIN_P2));
+		fC = 1.0f - 0.5f * fZ + fZ * fZ * (VAPPROX_COS_P0 + fZ * (VAPPROX_COS_P1 +
+				fZ * VAPPROX_COS_P2));
+	}
+
+	if (vQuad & 1)
+	{
+		float fT = fS;
+		fS = fC;
+		fC = fT;
+	}
+	if (pSin)
+		*pSin = (vQuad & 2) ? -fS : fS;
+	if (pCos)
+		*pCos = ((vQuad + 1) & 2) ? -fC : fC;
+}
+
+/*
+ * atan of a in [0, 1].
+ */
+static inline float ApproxATanUnit(float fA, VMathAccuracy eAccuracy)
+{
+	float fZ, fBase = 0.0f;
+
+	if (eAccuracy == MATH_FAST)
+	{
+		fZ = fA * fA;
+		return fA * (VAPPROX_ATAN_F0 + fZ * (VAPPROX_ATAN_F1 + fZ * VAPPROX_ATAN_F2));
+	}
+	if (fA > VAPPROX_TANPIO8)
+	{
+		fBase = VAPPROX_PIO4;
+		fA = (fA - 1.0f) / (fA + 1.0f);
+	}
+	fZ = fA * fA;
+	return fBase + fA + fA * fZ * (VAPPROX_ATAN_P0 + fZ * (VAPPROX_ATAN_P1 +
+			fZ * (VAPPROX_ATAN_P2 + fZ * VAPPROX_ATAN_P3)));
+}
+
+static inline float ApproxATan2(float fY, float fX, VMathAccuracy eAccuracy)
+{
+	float fAx = fabsf(fX), fAy = fabsf(fY);
+	float fMax = (fAx > fAy) ? fAx : fAy;
+	float fMin = (fAx > fAy) ? fAy : fAx;
+	float fR;
+
+	if (fMax == 0.0f)
+		return 0.0f;
+	fR = ApproxATanUnit(fMin / fMax, eAccuracy);
+	if (fAy > fAx)
+		fR = VAPPROX_PIO2 - fR;
+	if (fX < 0.0f)
+		fR = VAPPROX_PI - fR;
+	return (fY < 0.0f) ? -fR : fR;
+}
+
+static inline float ApproxACos(float fValue, VMathAccuracy eAccuracy)
+{
+	float fA = fabsf(fValue), fP;
+
+	if (fA > 1.0f)
+		fA = 1.0f;
+	if (eAccuracy == MATH_FAST)
+		fP = VAPPROX_ACOS_F0 + fA * (VAPPROX_ACOS_F1 + fA * (VAPPROX_ACOS_F2 +
+				fA * VAPPROX_ACOS_F3));
+	else
+		fP = VAPPROX_ACOS_P0 + fA * (VAPPROX_ACOS_P1 + fA * (VAPPROX_ACOS_P2 +
+				fA * (VAPPROX_ACOS_P3 + fA * (VAPPROX_ACOS_P4 + fA * (VAPPROX_ACOS_P5 +
+				fA * (VAPPROX_ACOS_P6 + fA * VAPPROX_ACOS_P7))))));
+	fP *= sqrtf(1.0f - fA);
+	return (fValue < 0.0f) ? VAPPROX_PI - fP : fP;
+}
+
+static inline float ApproxRSqrt(float fValue, VMathAccuracy eAccuracy)
+{
+	VUINT	vBits;
+	float	fY;
+
+	memcpy(&vBits, &fValue, sizeof(vBits));
+	vBits = VAPPROX_RSQRT_MAGIC - (vBits >> 1);
+	memcpy(&fY, &vBits, sizeof(fY));
+	fY = VAPPROX_RSQRT_K0 * fY * (VAPPROX_RSQRT_K1 - fValue * fY * fY);
+	if (eAccuracy != MATH_FAST)
+		fY = fY * (1.5f - 0.5f * fValue * fY * fY);
+	return fY;
+}
+
+} // End Namespace
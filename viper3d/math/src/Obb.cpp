@@ -15,6 +15,7 @@
 /* System Headers */
 
 /* Local Headers */
+#include <viper3d/math/SIMD.h>
 
 namespace UDP
 {
@@ -273,78 +274,82 @@ bool VObb::Intersects(const VObb &obb)
 	VVector vD = obb.vCenter - vCenter;
 
 	float	matM[3][3];	// B's axis in relation to A
+	float	matA[3][3];	// absolute values of matM
 	float	ra,			// radius A
 			rb,			// radius B
 			t;			// absolute values from T[]
+	int		i, j;
+
+	// the whole rotation up front; the epsilon keeps nearly parallel
+	// edges, whose cross product is close to zero, from turning into a
+	// separating axis through rounding alone
+	for (i = 0; i < 3; i++)
+	{
+		const VVector& vA = (i == 0 ? vA0 : (i == 1 ? vA1 : vA2));
+
+		matM[i][0] = vA * obb.vA0;
+		matM[i][1] = vA * obb.vA1;
+		matM[i][2] = vA * obb.vA2;
+		for (j = 0; j < 3; j++)
+			matA[i][j] = VMath::Abs(matM[i][j]) + VSIMD_SAT_EPSILON;
+	}
+	T[0] = vD * vA0;
+	T[1] = vD * vA1;
+	T[2] = vD * vA2;
 
 	// Obb A's axis as separation axis
 	// ===============================
 	// first axis vA0
-	matM[0][0] = vA0 * obb.vA0;
-	matM[0][1] = vA0 * obb.vA1;
-	matM[0][2] = vA0 * obb.vA2;
 	ra	= fA0;
-	rb	=	obb.fA0 * VMath::Abs(matM[0][0]) +
-			obb.fA1 * VMath::Abs(matM[0][1]) +
-			obb.fA2 * VMath::Abs(matM[0][2]);
-
-	T[0]	= vD * vA0;
-	t		= VMath::Abs(T[0]);
+	rb	=	obb.fA0 * matA[0][0] +
+			obb.fA1 * matA[0][1] +
+			obb.fA2 * matA[0][2];
+	t	= VMath::Abs(T[0]);
 	if (t > (ra + rb))
 		return false;
 
 	// second axis vA1
-	matM[1][0] = vA1 * obb.vA0;
-	matM[1][1] = vA1 * obb.vA1;
-	matM[1][2] = vA1 * obb.vA2;
 	ra	=	fA1;
-	rb	=	obb.fA0 * VMath::Abs(matM[1][0]) +
-			obb.fA1 * VMath::Abs(matM[1][1]) +
-			obb.fA2 * VMath::Abs(matM[1][2]);
-	T[1]	= vD * vA1;
-	t		= VMath::Abs(T[1]);
+	rb	=	obb.fA0 * matA[1][0] +
+			obb.fA1 * matA[1][1] +
+			obb.fA2 * matA[1][2];
+	t	= VMath::Abs(T[1]);
 	if (t > (ra + rb))
 		return false;
-	return true;
 
 	// third axis vA2
-	matM[2][0] = vA2 * obb.vA0;
-	matM[2][1] = vA2 * obb.vA1;
-	matM[2][2] = vA2 * obb.vA2;
 	ra	=	fA2;
-	rb	=	obb.fA0 * VMath::Abs(matM[2][0]) +
-			obb.fA1 * VMath::Abs(matM[2][1]) +
-			obb.fA2 * VMath::Abs(matM[2][2]);
-	T[2]	= vD * vA2;
-	t		= VMath::Abs(T[2]);
+	rb	=	obb.fA0 * matA[2][0] +
+			obb.fA1 * matA[2][1] +
+			obb.fA2 * matA[2][2];
+	t	= VMath::Abs(T[2]);
 	if (t > (ra + rb))
 		return false;
-	return true;
 
 	// Obb B's axis as separation axis
 	// ===============================
 	// first axis vA0
-	ra	= 	fA0 * VMath::Abs(matM[0][0]) +
-			fA1 * VMath::Abs(matM[1][0]) +
-			fA2 * VMath::Abs(matM[2][0]);
+	ra	= 	fA0 * matA[0][0] +
+			fA1 * matA[1][0] +
+			fA2 * matA[2][0];
 	rb	=	obb.fA0;
 	t	=	VMath::Abs(T[0]*matM[0][0] + T[1]*matM[1][0] + T[2]*matM[2][0]);
 	if (t > (ra + rb))
 		return false;
 
 	// second axis vA1
-	ra	= 	fA0 * VMath::Abs(matM[0][1]) +
-			fA1 * VMath::Abs(matM[1][1]) +
-			fA2 * VMath::Abs(matM[2][1]);
+	ra	= 	fA0 * matA[0][1] +
+			fA1 * matA[1][1] +
+			fA2 * matA[2][1];
 	rb	=	obb.fA1;
 	t	=	VMath::Abs(T[0]*matM[0][1] + T[1]*matM[1][1] + T[2]*matM[2][1]);
 	if (t > (ra + rb))
 		return false;
 
 	// third axis vA2
-	ra	= 	fA0 * VMath::Abs(matM[0][2]) +
-			fA1 * VMath::Abs(matM[1][2]) +
-			fA2 * VMath::Abs(matM[2][2]);
+	ra	= 	fA0 * matA[0][2] +
+			fA1 * matA[1][2] +
+			fA2 * matA[2][2];
 	rb	=	obb.fA2;
 	t	=	VMath::Abs(T[0]*matM[0][2] + T[1]*matM[1][2] + T[2]*matM[2][2]);
 	if (t > (ra + rb))
@@ -353,64 +358,64 @@ bool VObb::Intersects(const VObb &obb)
 	// other candidates: cross products of axis:
 	// =========================================
 	// axis A0xB0
-	ra = fA1*VMath::Abs(matM[2][0]) + fA2*VMath::Abs(matM[1][0]);
-	rb = obb.fA1*VMath::Abs(matM[0][2]) + obb.fA2*VMath::Abs(matM[0][1]);
+	ra = fA1*matA[2][0] + fA2*matA[1][0];
+	rb = obb.fA1*matA[0][2] + obb.fA2*matA[0][1];
 	t = VMath::Abs(T[2]*matM[1][0] - T[1]*matM[2][0]);
 	if (t > ra + rb)
 		return false;
 
 	// axis A0xB1
-	ra = fA1*VMath::Abs(matM[2][1]) + fA2*VMath::Abs(matM[1][1]);
-	rb = obb.fA0*VMath::Abs(matM[0][2]) + obb.fA2*VMath::Abs(matM[0][0]);
+	ra = fA1*matA[2][1] + fA2*matA[1][1];
+	rb = obb.fA2*matA[0][0] + obb.fA0*matA[0][2];
 	t = VMath::Abs(T[2]*matM[1][1] - T[1]*matM[2][1]);
 	if (t > ra + rb)
 		return false;
 
 	// axis A0xB2
-	ra = fA1*VMath::Abs(matM[2][2]) + fA2*VMath::Abs(matM[1][2]);
-	rb = obb.fA0*VMath::Abs(matM[0][1]) + obb.fA1*VMath::Abs(matM[0][0]);
+	ra = fA1*matA[2][2] + fA2*matA[1][2];
+	rb = obb.fA0*matA[0][1] + obb.fA1*matA[0][0];
 	t = VMath::Abs(T[2]*matM[1][2] - T[1]*matM[2][2]);
 	if (t > ra + rb)
 		return false;
 
 	// axis A1xB0
-	ra = fA0*VMath::Abs(matM[2][0]) + fA2*VMath::Abs(matM[0][0]);
-	rb = obb.fA1*VMath::Abs(matM[1][2]) + obb.fA2*VMath::Abs(matM[1][1]);
+	ra = fA2*matA[0][0] + fA0*matA[2][0];
+	rb = obb.fA1*matA[1][2] + obb.fA2*matA[1][1];
 	t = VMath::Abs(T[0]*matM[2][0] - T[2]*matM[0][0]);
 	if (t > ra + rb)
 		return false;
 
 	// axis A1xB1
-	ra = fA0*VMath::Abs(matM[2][1]) + fA2*VMath::Abs(matM[0][1]);
-	rb = obb.fA0*VMath::Abs(matM[1][2]) + obb.fA2*VMath::Abs(matM[1][0]);
+	ra = fA2*matA[0][1] + fA0*matA[2][1];
+	rb = obb.fA2*matA[1][0] + obb.fA0*matA[1][2];
 	t = VMath::Abs(T[0]*matM[2][1] - T[2]*matM[0][1]);
 	if (t > ra + rb)
 		return false;
 
 	// axis A1xB2
-	ra = fA0*VMath::Abs(matM[2][2]) + fA2*VMath::Abs(matM[0][2]);
-	rb = obb.fA0*VMath::Abs(matM[1][1]) + obb.fA1*VMath::Abs(matM[1][0]);
+	ra = fA2*matA[0][2] + fA0*matA[2][2];
+	rb = obb.fA0*matA[1][1] + obb.fA1*matA[1][0];
 	t = VMath::Abs(T[0]*matM[2][2] - T[2]*matM[0][2]);
 	if (t > ra + rb)
 		return false;
 
 	// axis A2xB0
-	ra = fA0*VMath::Abs(matM[1][0]) + fA1*VMath::Abs(matM[0][0]);
-	rb = obb.fA1*VMath::Abs(matM[2][2]) + obb.fA2*VMath::Abs(matM[2][0]);
+	ra = fA0*matA[1][0] + fA1*matA[0][0];
+	rb = obb.fA1*matA[2][2] + obb.fA2*matA[2][1];
 	t = VMath::Abs(T[1]*matM[0][0] - T[0]*matM[1][0]);
 	if (t > ra + rb)
 		return false;
 
 	// axis A2xB1
-	ra = fA0*VMath::Abs(matM[1][1]) + fA1*VMath::Abs(matM[0][1]);
-	rb = obb.fA0*VMath::Abs(matM[2][2]) + obb.fA2*VMath::Abs(matM[2][0]);
+	ra = fA0*matA[1][1] + fA1*matA[0][1];
+	rb = obb.fA2*matA[2][0] + obb.fA0*matA[2][2];
 	t = VMath::Abs(T[1]*matM[0][1] - T[0]*matM[1][1]);
 	if (t > ra + rb)
 		return false;
 
 	// axis A2xB2
-	ra = fA0*VMath::Abs(matM[1][2]) + fA1*VMath::Abs(matM[0][2]);
-	rb = obb.fA0*VMath::Abs(matM[2][1]) + obb.fA1*VMath::Abs(matM[2][0]);
+	ra = fA0*matA[1][2] + fA1*matA[0][2];
+	rb = obb.fA0*matA[2][1] + obb.fA1*matA[2][0];
 	t = VMath::Abs(T[1]*matM[0][2] - T[0]*matM[1][2]);
 	if (t > ra + rb)
 		return false;
@@ -440,9 +445,11 @@ bool VObb::Intersects(const VVector& v0, const VVector& v1,
 	fMin0 = vV * v0;
 	fMax0 = fMin0;
 
+	// axes too short to trust (a degenerate triangle, or an edge
+	// parallel to a box axis) can't separate anything
 	ObbProj((*this), vV, &fMin1 ,&fMax1);
-	if (fMax1 < fMin0 || fMax0 < fMin1)
-		return true;
+	if (vV * vV > VSIMD_SAT_EPSILON && (fMax1 < fMin0 || fMax0 < fMin1))
+		return false;
 
 	// direction of obb planes
 	// =======================
@@ -453,7 +460,7 @@ bool VObb::Intersects(const VVector& v0, const VVector& v1,
 	fMin1 = fD_C - fA0;
 	fMax1 = fD_C + fA0;
 	if (fMax1 < fMin0 || fMax0 < fMin1)
-		return true;
+		return false;
 
 	// axis 2:
 	vV = vA1;
@@ -462,7 +469,7 @@ bool VObb::Intersects(const VVector& v0, const VVector& v1,
 	fMin1 = fD_C - fA1;
 	fMax1 = fD_C + fA1;
 	if (fMax1 < fMin0 || fMax0 < fMin1)
-		return true;
+		return false;
 
 	// axis 3:
 	vV = vA2;
@@ -471,7 +478,7 @@ bool VObb::Intersects(const VVector& v0, const VVector& v1,
 	fMin1 = fD_C - fA2;
 	fMax1 = fD_C + fA2;
 	if (fMax1 < fMin0 || fMax0 < fMin1)
-		return true;
+		return false;
 
 	// direction of tri-obb edge crossproducts
 	vTriEdge[2] = vTriEdge[1] - vTriEdge[0];
@@ -480,11 +487,14 @@ bool VObb::Intersects(const VVector& v0, const VVector& v1,
 		for (int k = 0; k < 3; k++)
 		{
 			vV.Cross(vTriEdge[j], vA[k]);
+			if (vV * vV <= VSIMD_SAT_EPSILON)
+				continue;
+
 			TriProj(v0, v1, v2, vV, &fMin0, &fMax0);
 			ObbProj((*this), vV, &fMin1, &fMax1);
 
 			if ((fMax1 < fMin0) || (fMax0 < fMin1))
-				return true;
+				return false;
 		}
 	}
 
@@ -538,8 +548,8 @@ void VObb::ObbProj(const VObb& obb, const VVector& vV,
 {
 	float fDP = vV * obb.vCenter;
 	float fR =	obb.fA0 * VMath::Abs(vV * obb.vA0) +
-				obb.fA0 * VMath::Abs(vV * obb.vA1) +
-				obb.fA1 * VMath::Abs(vV * obb.vA2);
+				obb.fA1 * VMath::Abs(vV * obb.vA1) +
+				obb.fA2 * VMath::Abs(vV * obb.vA2);
 
 	*pfMin = fDP - fR;
 	*pfMax = fDP + fR;
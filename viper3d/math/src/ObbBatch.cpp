@@ -0,0 +1,292 @@
+/*============================================================================*
+ *                                                                            *
+ * 	This file is part of the Viper3D Game Engine.							  *
+ *                                                                            *
+ *	Copyright (C) 2004 UDP Games   All Rights Reserved.						  *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------	------------- *
+ *                                                                            *
+ *============================================================================*/
+#include <viper3d/math/ObbBatch.h>
+
+/* System Headers */
+
+/* Local Headers */
+
+/* Defines */
+#define VOBB_CHUNK		2048	/* pairs whose mask is kept on the stack at once */
+
+namespace UDP
+{
+
+/*
+ * Index of the lowest set bit of a non-zero word.
+ */
+static inline VUINT LowestBit(VUINT nWord)
+{
+#if defined(__GNUC__)
+	return (VUINT)__builtin_ctz(nWord);
+#else
+	VUINT vBit = 0;
+	while ((nWord & 1) == 0)
+	{
+		nWord >>= 1;
+		vBit++;
+	}
+	return vBit;
+#endif
+}
+
+/*
+ * Component pointers of a batch, nFirst entries in.
+ */
+static inline VSoA Offset(VSoA soa, VUINT nFirst)
+{
+	soa.x += nFirst;
+	soa.y += nFirst;
+	soa.z += nFirst;
+	return soa;
+}
+
+static inline VSoAObb Offset(VSoAObb soa, VUINT nFirst)
+{
+	soa.c = Offset(soa.c, nFirst);
+	soa.a0 = Offset(soa.a0, nFirst);
+	soa.a1 = Offset(soa.a1, nFirst);
+	soa.a2 = Offset(soa.a2, nFirst);
+	soa.e = Offset(soa.e, nFirst);
+	return soa;
+}
+
+/*
+ * Writes the index of every set bit of a mask over nCount pairs,
+ * starting from pair nFirst.
+ */
+static VUINT CompactMask(const VUINT *pMask, VUINT nCount, VUINT nFirst,
+						VUINT *pIndices)
+{
+	VUINT vNum = 0;
+	VUINT vWord;
+
+	for (VUINT w = 0; w < VObbBatch::MaskWords(nCount); w++)
+	{
+		vWord = pMask[w];
+		while (vWord)
+		{
+			pIndices[vNum++] = nFirst + (w << 5) + LowestBit(vWord);
+			vWord &= vWord - 1;
+		}
+	}
+	return vNum;
+}
+
+/********************************************************************
+ *          C O N S T R U C T I O N / D E S T R U C T I O N         *
+ ********************************************************************/
+VObbBatch::VObbBatch(VUINT nCount /*=0*/)
+: mCenter(nCount), mA0(nCount), mA1(nCount), mA2(nCount), mExtent(nCount)
+{
+
+}
+
+VObbBatch::VObbBatch(const VObb *pBoxes, VUINT nCount)
+{
+	FromObbs(pBoxes, nCount);
+}
+
+VObbBatch::~VObbBatch()
+{
+
+}
+
+/********************************************************************
+ *                        A T T R I B U T E S                       *
+ ********************************************************************/
+VObb VObbBatch::Get(VUINT nIndex) const
+{
+	VObb	vObb;
+	VVector	vExtent = mExtent.Get(nIndex);
+
+	vObb.vCenter = mCenter.Get(nIndex);
+	vObb.vA0 = mA0.Get(nIndex);
+	vObb.vA1 = mA1.Get(nIndex);
+	vObb.vA2 = mA2.Get(nIndex);
+	vObb.fA0 = vExtent.x;
+	vObb.fA1 = vExtent.y;
+	vObb.fA2 = vExtent.z;
+	return vObb;
+}
+
+void VObbBatch::Set(VUINT nIndex, const VObb &obb)
+{
+	mCenter.Set(nIndex, obb.vCenter);
+	mA0.Set(nIndex, obb.vA0);
+	mA1.Set(nIndex, obb.vA1);
+	mA2.Set(nIndex, obb.vA2);
+	mExtent.Set(nIndex, VVector(obb.fA0, obb.fA1, obb.fA2));
+}
+
+VSoAObb VObbBatch::SoA() const
+{
+	VSoAObb vSoA;
+
+	vSoA.c = mCenter.SoA();
+	vSoA.a0 = mA0.SoA();
+	vSoA.a1 = mA1.SoA();
+	vSoA.a2 = mA2.SoA();
+	vSoA.e = mExtent.SoA();
+	return vSoA;
+}
+
+/********************************************************************
+ *                        O P E R A T I O N S                       *
+ ********************************************************************/
+void VObbBatch::Resize(VUINT nCount)
+{
+	mCenter.Resize(nCount);
+	mA0.Resize(nCount);
+	mA1.Resize(nCount);
+	mA2.Resize(nCount);
+	mExtent.Resize(nCount);
+}
+
+void VObbBatch::FromObbs(const VObb *pBoxes, VUINT nCount)
+{
+	Resize(nCount);
+	for (VUINT i = 0; i < Count(); i++)
+		Set(i, pBoxes[i]);
+}
+
+/*------------------------------------------------------------------*
+ *							IntersectMask()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Tests each box against the box at the same index of
+ *				another batch, producing a bit mask.
+ *	@date		17-Oct-2026
+ *
+ *	@param		batch	Boxes to test against; only the first Count()
+ *						are used, so it must hold at least that many
+ *	@param		pHits	Receives a set bit for each pair that overlaps.
+ *						Must hold MaskWords(Count()) words.
+ *
+ *	@remarks	Pair i is bit (i & 31) of word (i >> 5).
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VObbBatch::IntersectMask(const VObbBatch &batch, VUINT *pHits) const
+{
+	VSimd::mKernels.BatchObbObb(SoA(), batch.SoA(), Count(), pHits);
+}
+
+/*------------------------------------------------------------------*
+ *							  Intersects()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Tests each box against the box at the same index of
+ *				another batch, producing a compacted list of the pairs
+ *				that overlap.
+ *	@date		17-Oct-2026
+ *
+ *	@param		batch		Boxes to test against, at least Count()
+ *	@param		pIndices	Receives the indices of overlapping pairs in
+ *							ascending order.  Must hold Count() entries.
+ *
+ *	@returns	(VUINT) Number of indices written
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+VUINT VObbBatch::Intersects(const VObbBatch &batch, VUINT *pIndices) const
+{
+	VUINT vHits[VOBB_CHUNK >> 5];
+	VUINT vNum = 0;
+	VUINT vCount;
+
+	for (VUINT c = 0; c < Count(); c += VOBB_CHUNK)
+	{
+		vCount = (Count() - c < VOBB_CHUNK ? Count() - c : VOBB_CHUNK);
+		VSimd::mKernels.BatchObbObb(Offset(SoA(), c), Offset(batch.SoA(), c), vCount,
+				vHits);
+		vNum += CompactMask(vHits, vCount, c, pIndices + vNum);
+	}
+	return vNum;
+}
+
+/*------------------------------------------------------------------*
+ *							IntersectMask()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Tests each box against the triangle at the same index,
+ *				producing a bit mask.
+ *	@date		17-Oct-2026
+ *
+ *	@param		v0		First corner of each triangle
+ *	@param		v1		Second corner of each triangle
+ *	@param		v2		Third corner of each triangle
+ *	@param		pHits	Receives a set bit for each pair that overlaps.
+ *						Must hold MaskWords(Count()) words.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VObbBatch::IntersectMask(const VVectorBatch &v0, const VVectorBatch &v1,
+							const VVectorBatch &v2, VUINT *pHits) const
+{
+	VSimd::mKernels.BatchObbTriangle(SoA(), v0.SoA(), v1.SoA(), v2.SoA(),
+			Count(), pHits);
+}
+
+/*------------------------------------------------------------------*
+ *							  Intersects()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Tests each box against the triangle at the same index,
+ *				producing a compacted list of the pairs that overlap.
+ *	@date		17-Oct-2026
+ *
+ *	@param		v0			First corner of each triangle
+ *	@param		v1			Second corner of each triangle
+ *	@param		v2			Third corner of each triangle
+ *	@param		pIndices	Receives the indices of overlapping pairs in
+ *							ascending order.  Must hold Count() entries.
+ *
+ *	@returns	(VUINT) Number of indices written
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+VUINT VObbBatch::Intersects(const VVectorBatch &v0, const VVectorBatch &v1,
+							const VVectorBatch &v2, VUINT *pIndices) const
+{
+	VUINT vHits[VOBB_CHUNK >> 5];
+	VUINT vNum = 0;
+	VUINT vCount;
+
+	for (VUINT c = 0; c < Count(); c += VOBB_CHUNK)
+	{
+		vCount = (Count() - c < VOBB_CHUNK ? Count() - c : VOBB_CHUNK);
+		VSimd::mKernels.BatchObbTriangle(Offset(SoA(), c), Offset(v0.SoA(), c),
+				Offset(v1.SoA(), c), Offset(v2.SoA(), c), vCount, vHits);
+		vNum += CompactMask(vHits, vCount, c, pIndices + vNum);
+	}
+	return vNum;
+}
+
+} // End Namespace
@@ -16,47 +16,107 @@
 #include <cstring>
 
 /* Local Headers */
+#include <viper3d/util/Arena.h>
 
 namespace UDP
 {
 
+/*
+ * Scratch points for the two halves in Clip().  Small polygons use the
+ * stack, bigger ones the polygon's arena or else the heap, which is
+ * counted in pHeapAllocs.
+ */
+class VClipScratch
+{
+public:
+	VClipScratch(VArena *pArena, VUINT nCount, VUINT *pHeapAllocs)
+	: m_pArena(pArena), m_bHeap(false)
+	{
+		m_pFront = m_vFront;
+		m_pBack = m_vBack;
+		if (nCount <= VPOLY_INLINE_POINTS * 3)
+			return;
+
+		if (m_pArena)
+		{
+			m_Mark = m_pArena->GetMark();
+			m_pFront = static_cast<VVector*>(m_pArena->Alloc(sizeof(VVector)*nCount));
+			m_pBack = static_cast<VVector*>(m_pArena->Alloc(sizeof(VVector)*nCount));
+			m_End = m_pArena->GetMark();
+		}
+		else
+		{
+			m_pFront = new VVector[nCount];
+			m_pBack = new VVector[nCount];
+			m_bHeap = true;
+			*pHeapAllocs += 2;
+		}
+	}
+
+	~VClipScratch()
+	{
+		if (m_bHeap)
+		{
+			delete[] m_pFront;
+			delete[] m_pBack;
+		}
+		else if (m_pFront != m_vFront)
+		{
+			// only if the halves did not allocate after us
+			VArenaMark vNow = m_pArena->GetMark();
+			if (vNow.mBlock == m_End.mBlock && vNow.mOffset == m_End.mOffset)
+				m_pArena->Rewind(m_Mark);
+		}
+	}
+
+	VVector		*m_pFront;
+	VVector		*m_pBack;
+
+private:
+	VArena		*m_pArena;
+	VArenaMark	m_Mark;		/**< before the scratch */
+	VArenaMark	m_End;		/**< after the scratch */
+	bool		m_bHeap;
+	VVector		m_vFront[VPOLY_INLINE_POINTS * 3];
+	VVector		m_vBack[VPOLY_INLINE_POINTS * 3];
+};
+
 /********************************************************************
  *          C O N S T R U C T I O N / D E S T R U C T I O N         *
  ********************************************************************/
 VPolygon::VPolygon()
 {
-	m_pPoints	= NULL;
-	m_pIndis	= NULL;
-	m_nNumP		= 0;
-	m_nNumI		= 0;
-	m_nFlag		= 0;
-	memset(&m_Aabb, 0, sizeof(VAabb));
+	Init(NULL);
+}
+
+VPolygon::VPolygon(VArena *pArena)
+{
+	Init(pArena);
 }
 
 VPolygon::VPolygon(const VPolygon& poly)
 {
+	Init(NULL);
 	Set(poly.GetPoints(), poly.GetNumPoints(),
 						poly.GetIndices(), poly.GetNumIndis());
 }	
 
 VPolygon::~VPolygon()
 {
-	if (m_pPoints)
-	{
-		delete[] m_pPoints;
-		m_pPoints = NULL;
-	}
-
-	if (m_pIndis)
-	{
-		delete[] m_pIndis;
-		m_pIndis = NULL;
-	}
+	Free();
 }		
 
 /********************************************************************
  *                        A T T R I B U T E S                       *
  ********************************************************************/
+void VPolygon::SetArena(VArena *pArena)
+{
+	// storage from the old arena or the heap is dropped with the points
+	Free();
+	m_pArena = pArena;
+	m_nNumP = 0;
+	m_nNumI = 0;
+}
 
 /********************************************************************
  *                        O P E R A T I O N S                       *
@@ -64,23 +124,15 @@ VPolygon::~VPolygon()
 void VPolygon::Set(const VVector *pPoints, int nNumP, const VUINT *pIndis,
 								int nNumI)
 {
-	VVector vEdge0, vEdge1;
-	bool bGotEm = false;
-
-	if (m_pPoints)
+	// an empty polygon has no plane
+	if (nNumP <= 0 || nNumI <= 0)
 	{
-		delete[] m_pPoints;
-		m_pPoints = NULL;
-	}
-
-	if (m_pIndis)
-	{
-		delete[] m_pIndis;
-		m_pIndis = NULL;
+		m_nNumP = 0;
+		m_nNumI = 0;
+		return;
 	}
 
-	m_pPoints = new VVector[nNumP];
-	m_pIndis  = new VUINT[nNumI];
+	Reserve(nNumP, nNumI);
 
 	m_nNumP = nNumP;
 	m_nNumI = nNumI;
@@ -88,35 +140,13 @@ void VPolygon::Set(const VVector *pPoints, int nNumP, const VUINT *pIndis,
 	memcpy(m_pPoints, pPoints, sizeof(VVector)*nNumP);
 	memcpy(m_pIndis,  pIndis,  sizeof(VUINT)*nNumI);
 
-	vEdge0 = m_pPoints[m_pIndis[1]] - m_pPoints[m_pIndis[0]];
-
-	// calculate its plane
-	for (int i = 2; bGotEm == false; i++)
-	{
-		if (static_cast<VUINT>(i + 1) > m_nNumI)
-			break;
-
-		vEdge1 = m_pPoints[m_pIndis[i]] - m_pPoints[m_pIndis[0]];
-
-		vEdge0.Normalize();
-		vEdge1.Normalize();
-
-		// edges must not be parallel
-		if (vEdge0.AngleWith(vEdge1) != 0.0)
-			bGotEm = true;
-	}
-
-	m_Plane.m_vN.Cross(vEdge0, vEdge1);
-	m_Plane.m_vN.Normalize();
-	m_Plane.m_fD = -(m_Plane.m_vN * m_pPoints[0]);
-	m_Plane.m_vPoint = m_pPoints[0];
-
+	CalcPlane();
 	CalcBoundingBox();
 }
 
 void VPolygon::Clip(const VPlane& plane, VPolygon *pFront, VPolygon *pBack)
 {
-	if (!pFront && !pBack)
+	if ((!pFront && !pBack) || m_nNumP == 0)
 		return;
 
 	VVector vHit, vA, vB;
@@ -130,8 +160,12 @@ void VPolygon::Clip(const VPlane& plane, VPolygon *pFront, VPolygon *pBack)
 			nLoop=0,
 			nCurrent=0;
 
-	VVector *pvFront = new VVector[m_nNumP*3];
-	VVector *pvBack  = new VVector[m_nNumP*3];
+	// pFront or pBack may be this polygon
+	VVector vNormal = m_Plane.m_vN;
+
+	VClipScratch Scratch(m_pArena, m_nNumP*3, &m_nHeapAllocs);
+	VVector *pvFront = Scratch.m_pFront;
+	VVector *pvBack  = Scratch.m_pBack;
 
 	// classify the first vertex and fill to appropriate list
 	switch (pPlane->Classify(m_pPoints[0]))
@@ -224,103 +258,32 @@ void VPolygon::Clip(const VPlane& plane, VPolygon *pFront, VPolygon *pBack)
 		}
 	} // for [NumP]
 
-	//	now we have the vertices for both new polys ready.
- 	//	lets take care of the index lists now
-
-	VUINT I0 = 0, I1 = 0, I2 = 0;
-
-	VUINT *pnFront = NULL;
-	VUINT *pnBack  = NULL;
-
-	if (nNumFront > 2)
-	{
-		pnFront = new VUINT[(nNumFront-2)*3];
-
-		for (nLoop = 0; nLoop < (nNumFront-2); nLoop++)
-		{
-			if (nLoop == 0)
-			{
-				I0=0;
-				I1=1;
-				I2=2;
-			}
-			else
-			{
-				I1=I2;
-				I2++;
-			}
-			pnFront[(nLoop*3)   ] = I0;
-			pnFront[(nLoop*3) +1] = I1;
-			pnFront[(nLoop*3) +2] = I2;
-		}
-	}
-
-	if (nNumBack > 2)
+	//	now we have the vertices for both new polys ready,
+	//	fan them out straight into the new poly objects
+	if (pFront && nNumFront > 2)
 	{
-		pnBack  = new VUINT[(nNumBack-2)*3];
-
-		for (nLoop = 0; nLoop < (nNumBack-2); nLoop++)
-		{
-			if (nLoop==0)
-			{
-				I0=0;
-				I1=1;
-				I2=2;
-			}
-			else
-			{
-				I1=I2;
-				I2++;
-			}
-			pnBack[(nLoop*3)   ] = I0;
-			pnBack[(nLoop*3) +1] = I1;
-			pnBack[(nLoop*3) +2] = I2;
-		}
-	}
-
-	// now fuel in the information to the new poly objects
-	if (pFront && pnFront)
-	{
-		pFront->Set(pvFront, nNumFront, pnFront, (nNumFront-2)*3);
+		pFront->SetFan(pvFront, nNumFront);
 
 		// make sure new one has same orientation as original
-		if (pFront->GetPlane().m_vN * m_Plane.m_vN < 0.0f)
+		if (pFront->GetPlane().m_vN * vNormal < 0.0f)
 			pFront->SwapFaces();
 	}
 
-	if (pBack && pnBack)
+	if (pBack && nNumBack > 2)
 	{
-		pBack->Set(pvBack, nNumBack, pnBack, (nNumBack-2)*3);
+		pBack->SetFan(pvBack, nNumBack);
 
 		// make sure new one has same orientation as original
-		if (pBack->GetPlane().m_vN * m_Plane.m_vN < 0.0f)
+		if (pBack->GetPlane().m_vN * vNormal < 0.0f)
 			pBack->SwapFaces();
 	}
-
-	// free temporary memory
-	if (pvFront)
-	{
-		delete[] pvFront;
-	}
-	if (pvBack)
-	{
-		delete [] pvBack;
-	}
-	if (pnFront)
-	{
-		delete [] pnFront;
-	}
-	if (pnBack)
-	{
-		delete [] pnBack;
-	}
 }
 
 void VPolygon::Clip(const VAabb& aabb)
 {
-	VPolygon	BackPoly, ClippedPoly;
+	VPolygon	PolyA(m_pArena), PolyB(m_pArena);
+	VPolygon	*pIn = this, *pOut = &PolyA;
 	VPlane		Planes[6];
-	bool		bClipped = false;
 
 	// cast away const
 	VAabb *pAabb = const_cast<VAabb*>(&aabb);
@@ -329,25 +292,27 @@ void VPolygon::Clip(const VAabb& aabb)
 	// the normals are pointing outwards
 	pAabb->GetPlanes(Planes);
 
-	// make a copy of this polygon
-	ClippedPoly = *this;
-
-	// now clip the poly against the planes
+	// now clip the poly against the planes, going back and
+	// forth between two scratch polys instead of copying
 	for (int i = 0; i < 6; i++)
 	{
-		if (Planes[i].Classify(ClippedPoly) == VCLIPPED)
+		if (Planes[i].Classify(*pIn) == VCLIPPED)
 		{
-			ClippedPoly.Clip(Planes[i], NULL, &BackPoly);
-			ClippedPoly = BackPoly;
-			bClipped = true;
+			// left empty if nothing is behind the plane
+			pOut->m_nNumP = 0;
+			pOut->m_nNumI = 0;
+			pIn->Clip(Planes[i], NULL, pOut);
+			pIn = pOut;
+			pOut = (pOut == &PolyA) ? &PolyB : &PolyA;
 		}
 	}
 
 	// set this poly to the final clip output
-	if (bClipped)
+	if (pIn != this)
 	{
-		*this = ClippedPoly;
+		*this = *pIn;
 	}
+	m_nHeapAllocs += PolyA.m_nHeapAllocs + PolyB.m_nHeapAllocs;
 }
 
 int VPolygon::Cull(const VAabb& aabb)
@@ -414,18 +379,19 @@ int VPolygon::Cull(const VAabb& aabb)
 
 void VPolygon::SwapFaces()
 {
-	VUINT *pIndis = new VUINT[m_nNumI];
+	VUINT nTemp;
 
-	// change index ordering
-	for (VUINT i = 0; i < m_nNumI; i++)
-		pIndis[m_nNumI - i - 1] = m_pIndis[i];
+	// change index ordering, in place
+	for (VUINT i = 0; i < m_nNumI / 2; i++)
+	{
+		nTemp = m_pIndis[i];
+		m_pIndis[i] = m_pIndis[m_nNumI - i - 1];
+		m_pIndis[m_nNumI - i - 1] = nTemp;
+	}
 
 	// change normal orientation
 	m_Plane.m_vN *= -1.0f;
 	m_Plane.m_fD *= -1.0f;
-
-	delete[] m_pIndis;
-	m_pIndis = pIndis;
 }
 
 bool VPolygon::Intersects(const VRay& ray, bool bCull, float *t)
@@ -492,8 +458,9 @@ bool VPolygon::Intersects(const VRay& ray, bool bCull, float fL, float *t)
  ********************************************************************/
 const VPolygon& VPolygon::operator=(const VPolygon &poly)
 {
-	Set(poly.GetPoints(), poly.GetNumPoints(),
-						poly.GetIndices(), poly.GetNumIndis());
+	if (&poly != this)
+		Set(poly.GetPoints(), poly.GetNumPoints(),
+							poly.GetIndices(), poly.GetNumIndis());
 	return *this;
 }
 
@@ -504,6 +471,142 @@ const VPolygon& VPolygon::operator=(const VPolygon &poly)
 /********************************************************************
  *                         I N T E R N A L S                        *
  ********************************************************************/
+void VPolygon::Init(VArena *pArena)
+{
+	m_pPoints	= m_vInlineP;
+	m_pIndis	= m_nInlineI;
+	m_nCapP		= VPOLY_INLINE_POINTS;
+	m_nCapI		= (VPOLY_INLINE_POINTS - 2) * 3;
+	m_bHeapP	= false;
+	m_bHeapI	= false;
+	m_nHeapAllocs	= 0;
+	m_pArena	= pArena;
+	m_nNumP		= 0;
+	m_nNumI		= 0;
+	m_nFlag		= 0;
+	m_Aabb.SetMin(VVector());
+	m_Aabb.SetMax(VVector());
+	m_Aabb.SetCenter(VVector());
+}
+
+/*
+ * Makes room for the given counts.  Whatever was stored is lost when the
+ * room has to grow, so only call it right before overwriting.
+ */
+void VPolygon::Reserve(VUINT nNumP, VUINT nNumI)
+{
+	if (nNumP > m_nCapP)
+	{
+		if (m_bHeapP)
+			delete[] m_pPoints;
+
+		if (m_pArena)
+		{
+			m_pPoints = static_cast<VVector*>(m_pArena->Alloc(sizeof(VVector)*nNumP));
+			m_bHeapP = false;
+		}
+		else
+		{
+			m_pPoints = new VVector[nNumP];
+			m_bHeapP = true;
+			m_nHeapAllocs++;
+		}
+		m_nCapP = nNumP;
+	}
+
+	if (nNumI > m_nCapI)
+	{
+		if (m_bHeapI)
+			delete[] m_pIndis;
+
+		if (m_pArena)
+		{
+			m_pIndis = static_cast<VUINT*>(m_pArena->Alloc(sizeof(VUINT)*nNumI,
+									sizeof(VUINT)));
+			m_bHeapI = false;
+		}
+		else
+		{
+			m_pIndis = new VUINT[nNumI];
+			m_bHeapI = true;
+			m_nHeapAllocs++;
+		}
+		m_nCapI = nNumI;
+	}
+}
+
+/*
+ * Gives back heap storage and goes back to the inline arrays.
+ */
+void VPolygon::Free()
+{
+	if (m_bHeapP)
+		delete[] m_pPoints;
+	if (m_bHeapI)
+		delete[] m_pIndis;
+
+	m_pPoints	= m_vInlineP;
+	m_pIndis	= m_nInlineI;
+	m_nCapP		= VPOLY_INLINE_POINTS;
+	m_nCapI		= (VPOLY_INLINE_POINTS - 2) * 3;
+	m_bHeapP	= false;
+	m_bHeapI	= false;
+}
+
+/*
+ * Set() for a convex outline, triangulated as a fan around the first
+ * point without building an index list first.
+ */
+void VPolygon::SetFan(const VVector *pPoints, VUINT nNumP)
+{
+	Reserve(nNumP, (nNumP - 2) * 3);
+
+	m_nNumP = nNumP;
+	m_nNumI = (nNumP - 2) * 3;
+
+	memcpy(m_pPoints, pPoints, sizeof(VVector)*nNumP);
+	for (VUINT i = 0; i < nNumP - 2; i++)
+	{
+		m_pIndis[(i*3)   ] = 0;
+		m_pIndis[(i*3) +1] = i + 1;
+		m_pIndis[(i*3) +2] = i + 2;
+	}
+
+	CalcPlane();
+	CalcBoundingBox();
+}
+
+void VPolygon::CalcPlane()
+{
+	VVector vEdge0, vEdge1;
+	bool bGotEm = false;
+
+	vEdge0 = m_pPoints[m_pIndis[1]] - m_pPoints[m_pIndis[0]];
+
+	// calculate its plane
+	for (int i = 2; bGotEm == false; i++)
+	{
+		if (static_cast<VUINT>(i + 1) > m_nNumI)
+			break;
+
+		vEdge1 = m_pPoints[m_pIndis[i]] - m_pPoints[m_pIndis[0]];
+
+		vEdge0.Normalize();
+		vEdge1.Normalize();
+
+		// edges must not be parallel
+		if (vEdge0.AngleWith(vEdge1) != 0.0)
+			bGotEm = true;
+	}
+
+	m_Plane.m_vN.Cross(vEdge0, vEdge1);
+	m_Plane.m_vN.Normalize();
+	m_Plane.m_fD = -(m_Plane.m_vN * m_pPoints[0]);
+	m_Plane.m_vPoint = m_pPoints[0];
+}
+
+
+
 void VPolygon::CalcBoundingBox()
 {
 	VVector vMax, vMin;
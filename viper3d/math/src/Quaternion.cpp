@@ -24,27 +24,6 @@ namespace UDP
 /********************************************************************
  *          C O N S T R U C T I O N / D E S T R U C T I O N         *
  ********************************************************************/
-VQuaternion::VQuaternion(float _w, float _x, float _y, float _z)
- : x(_x), y(_y), z(_z), w(_w)
-{
-
-}
-
-VQuaternion::VQuaternion(const VQuaternion& q)
-{
-	x = q.x;
-	y = q.y;
-	z = q.z;
-	w = q.w;
-}
-
-VQuaternion::VQuaternion(const VVector& v, const float& r)
-{
-	x = v.x;
-	y = v.y;
-	z = v.z;
-	w = r;
-}
 
 /********************************************************************
  *                        A T T R I B U T E S                       *
@@ -71,48 +50,6 @@ float VQuaternion::GetMagnitude() const
 	return (float) VMath::Sqrt(w*w + x*x + y*y + z*z);
 }
 
-/*------------------------------------------------------------------*
- *							  GetVector()							*
- *------------------------------------------------------------------*/
-/**
- *	@brief		Retuns the current vector for this quaternion.
- *	@author		Josh Williams
- *	@date		10-Sep-2003
- *
- *	@returns	(Vector) Current vector.
- */
-/*------------------------------------------------------------------*
- * MODIFICATIONS													*
- *	Date		Description							Author			*
- * ===========	==================================	===============	*
- *																	*
- *------------------------------------------------------------------*/
-VVector VQuaternion::GetVector() const
-{
-	return VVector(x, y, z);
-}
-
-/*------------------------------------------------------------------*
- *							  GetScalar()							*
- *------------------------------------------------------------------*/
-/**
- *	@brief		Returns the scalar part of this quaternion.
- *	@author		Josh Williams
- *	@date		10-Sep-2003
- *
- *	@returns	(float)
- */
-/*------------------------------------------------------------------*
- * MODIFICATIONS													*
- *	Date		Description							Author			*
- * ===========	==================================	===============	*
- *																	*
- *------------------------------------------------------------------*/
-float VQuaternion::GetScalar() const
-{
-	return w;
-}
-
 /*------------------------------------------------------------------*
  *							   GetAngle()							*
  *------------------------------------------------------------------*/
@@ -282,14 +219,15 @@ void VQuaternion::CreateMatrix(float *pMatrix) const
  * MODIFICATIONS													*
  *	Date		Description							Author			*
  * ===========	==================================	===============	*
+ *	17-Oct-2026	One SinCos call										*
  *																	*
  *------------------------------------------------------------------*/
 void VQuaternion::FromAngleAxis(const float& rAngle, const VVector& rAxis)
 {
 	float fHalfAngle = (float)0.5*rAngle;
-	float fSin		= VMath::Sin(fHalfAngle);
+	float fSin;
 
-	w = (float)VMath::Cos(fHalfAngle);
+	VMath::SinCos(fHalfAngle, &fSin, &w);
 
 	x = float(rAxis.x*fSin);
 	y = float(rAxis.y*fSin);
@@ -314,6 +252,7 @@ void VQuaternion::FromAngleAxis(const float& rAngle, const VVector& rAxis)
  * MODIFICATIONS													*
  *	Date		Description							Author			*
  * ===========	==================================	===============	*
+ *	17-Oct-2026	Three SinCos calls									*
  *																	*
  *------------------------------------------------------------------*/
 void VQuaternion::FromEulerAngles(const float& roll, const float& pitch,
@@ -321,13 +260,9 @@ void VQuaternion::FromEulerAngles(const float& roll, const float& pitch,
 {
 	float cr, cp, cy, sr, sp, sy, cpcy, spsy; // Temp vars in roll, pitch, yaw
 
-	cr = VMath::Cos(roll/2.0f);
-	cp = VMath::Cos(pitch/2.0f);
-	cy = VMath::Cos(yaw/2.0f);
-
-	sr = VMath::Sin(roll/2.0f);
-	sp = VMath::Sin(pitch/2.0f);
-	sy = VMath::Sin(yaw/2.0f);
+	VMath::SinCos(roll/2.0f, &sr, &cr);
+	VMath::SinCos(pitch/2.0f, &sp, &cp);
+	VMath::SinCos(yaw/2.0f, &sy, &cy);
 
 	cpcy = cp * cy;
 	spsy = sp * sy;
@@ -408,14 +343,6 @@ void VQuaternion::ToAxisAngle(VVector& vec, float& angle) const
 	}
 }
 
-void VQuaternion::Conjugate(const VQuaternion& q)
-{
-	x = -q.x;
-	y = -q.y;
-	z = -q.z;
-	w = q.w;
-}
-
 void VQuaternion::GetEulerAngles(float *fRoll, float *fPitch, float *fYaw) const
 {
 	double r11, r21, r31, r32, r33, r12, r13;
@@ -464,48 +391,22 @@ VVector VQuaternion::Rotate(const VVector& vec)
 	return VVector(r.x, r.y, r.z);
 }
 
-/********************************************************************
- *                          O P E R A T O R S                       *
- ********************************************************************/
-
 /*------------------------------------------------------------------*
- *							   operator=							*
+ *								Nlerp()								*
  *------------------------------------------------------------------*/
 /**
- *	@brief		VQuaternion assignment.
- *	@author		Josh Williams
- *	@date		11-Sep-2003
+ *	@brief		Sets this quaternion to a normalized linear blend of
+ *				two others.
+ *	@date		17-Oct-2026
  *
- *	@param		q	VQuaternion to copy
- *
- *	@returns	(VQuaternion&) Result of the assignment.
- */
-/*------------------------------------------------------------------*
- * MODIFICATIONS													*
- *	Date		Description							Author			*
- * ===========	==================================	===============	*
- *																	*
- *------------------------------------------------------------------*/
-VQuaternion& VQuaternion::operator=(const VQuaternion& q)
-{
-	w = q.w;
-	x = q.x;
-	y = q.y;
-	z = q.z;
-	return *this;
-}
-
-/*------------------------------------------------------------------*
- *							  operator*=							*
- *------------------------------------------------------------------*/
-/**
- *	@brief		Performs VQuaternion scaling.
- *	@author		Josh Williams
- *	@date		10-Sep-2003
+ *	@remarks	Takes the shorter arc.  Cheaper than Slerp(), but the
+ *				rotation speed is not constant across fT.
  *
- *	@param		s	scalar value to scale by
+ *	@param		q1		Rotation at fT = 0
+ *	@param		q2		Rotation at fT = 1
+ *	@param		fT		Blend factor
  *
- *	@returns	(VQuaternion&) Value of this object after scaling.
+ *	@returns	void
  */
 /*------------------------------------------------------------------*
  * MODIFICATIONS													*
@@ -513,78 +414,34 @@ VQuaternion& VQuaternion::operator=(const VQuaternion& q)
  * ===========	==================================	===============	*
  *																	*
  *------------------------------------------------------------------*/
-VQuaternion& VQuaternion::operator*=(const float& s)
+void VQuaternion::Nlerp(const VQuaternion& q1, const VQuaternion& q2, float fT)
 {
-	w *= s;
-	x *= s;
-	y *= s;
-	z *= s;
-	return *this;
-}
+	float fDot = q1.x*q2.x + q1.y*q2.y + q1.z*q2.z + q1.w*q2.w;
+	float fT2 = (fDot < 0.0f) ? -fT : fT;
 
-/*------------------------------------------------------------------*
- *							 operator* (float)						*
- *------------------------------------------------------------------*/
-/**
- *	@brief		Performs scalar multiplication without modifying this
- *				instance.
- *	@author		Josh Williams
- *	@date		11-Sep-2003
- *
- *	@param		s	Scalar value to multiply by
- *
- *	@returns	(VQuaternion) Result of the multiplication.
- */
-/*------------------------------------------------------------------*
- * MODIFICATIONS													*
- *	Date		Description							Author			*
- * ===========	==================================	===============	*
- *																	*
- *------------------------------------------------------------------*/
-VQuaternion VQuaternion::operator*(const float& s) const
-{
-	return VQuaternion(w*s, x*s, y*s, z*s);
+	x = q1.x * (1.0f - fT) + q2.x * fT2;
+	y = q1.y * (1.0f - fT) + q2.y * fT2;
+	z = q1.z * (1.0f - fT) + q2.z * fT2;
+	w = q1.w * (1.0f - fT) + q2.w * fT2;
+	Normalize();
 }
 
 /*------------------------------------------------------------------*
- *							  operator/=							*
+ *								Slerp()								*
  *------------------------------------------------------------------*/
 /**
- *	@brief		Performs quaternion division.
- *	@author		Josh Williams
- *	@date		10-Sep-2003
+ *	@brief		Sets this quaternion to the spherical linear blend of
+ *				two others.
+ *	@date		17-Oct-2026
  *
- *	@param		s	scalar value to divide by.
- *
- *	@returns	(VQuaternion&) Value of this object after division.
- */
-/*------------------------------------------------------------------*
- * MODIFICATIONS													*
- *	Date		Description							Author			*
- * ===========	==================================	===============	*
- *																	*
- *------------------------------------------------------------------*/
-VQuaternion& VQuaternion::operator/=(const float& s)
-{
-	w /= s;
-	x /= s;
-	y /= s;
-	z /= s;
-	return *this;
-}
-
-/*------------------------------------------------------------------*
- *							  operator/								*
- *------------------------------------------------------------------*/
-/**
- *	@brief		Performs vector multiplication without modifying this
- *				instance.
- *	@author		Josh Williams
- *	@date		11-Sep-2003
+ *	@remarks	Takes the shorter arc, at a constant angular speed.
+ *				Falls back to Nlerp() when the two are nearly equal.
  *
- *	@param		s	scalar to divide by
+ *	@param		q1		Rotation at fT = 0
+ *	@param		q2		Rotation at fT = 1
+ *	@param		fT		Blend factor
  *
- *	@returns	(VQuaternion) Product of scalar division.
+ *	@returns	void
  */
 /*------------------------------------------------------------------*
  * MODIFICATIONS													*
@@ -592,11 +449,34 @@ VQuaternion& VQuaternion::operator/=(const float& s)
  * ===========	==================================	===============	*
  *																	*
  *------------------------------------------------------------------*/
-VQuaternion VQuaternion::operator/(const float& s) const
+void VQuaternion::Slerp(const VQuaternion& q1, const VQuaternion& q2, float fT)
 {
-	return VQuaternion(w/s, x/s, y/s, z/s);
+	float fDot = q1.x*q2.x + q1.y*q2.y + q1.z*q2.z + q1.w*q2.w;
+	float fSign = (fDot < 0.0f) ? -1.0f : 1.0f;
+	float fTheta, fInvSin, f1, f2;
+
+	fDot *= fSign;
+	if (fDot > 0.9995f)
+	{
+		Nlerp(q1, q2, fT);
+		return;
+	}
+
+	fTheta = VMath::ACos(fDot);
+	fInvSin = 1.0f / VMath::Sin(fTheta);
+	f1 = VMath::Sin((1.0f - fT) * fTheta) * fInvSin;
+	f2 = VMath::Sin(fT * fTheta) * fInvSin * fSign;
+
+	x = q1.x * f1 + q2.x * f2;
+	y = q1.y * f1 + q2.y * f2;
+	z = q1.z * f1 + q2.z * f2;
+	w = q1.w * f1 + q2.w * f2;
 }
 
+/********************************************************************
+ *                          O P E R A T O R S                       *
+ ********************************************************************/
+
 /*------------------------------------------------------------------*
  *							  operator* (Vector)					*
  *------------------------------------------------------------------*/
@@ -626,208 +506,6 @@ VQuaternion VQuaternion::operator*(const VVector &vec) const
 }
 */
 
-VVector VQuaternion::operator*(const VVector &pVec) const
-{
-	VVector	vUv, vUUv;
-	VVector	vQVec(x, y, z, w);
-	vUv = vQVec.CrossProduct(pVec);
-	vUUv = vQVec.CrossProduct(vUv);
-	vUv *= (2.0f * w);
-	vUUv *= 2.0f;
-
-	return pVec+vUv+vUUv;
-}
-
-/*------------------------------------------------------------------*
- *							   operator+=							*
- *------------------------------------------------------------------*/
-/**
- *	@brief		Performs quaternion addition.
- *	@author		Josh Williams
- *	@date		10-Sep-2003
- *
- *	@remarks	Adds the two quaternions on a component by
- *				component basis.
- *
- *	@param		q	VQuaternion we should add to ourselves
- *
- *	@returns	(VQuaternion&) Value of this object after addition.
- */
-/*------------------------------------------------------------------*
- * MODIFICATIONS													*
- *	Date		Description							Author			*
- * ===========	==================================	===============	*
- *																	*
- *------------------------------------------------------------------*/
-VQuaternion& VQuaternion::operator+=(const VQuaternion& q)
-{
-	w	+= q.w;
-	x	+= q.x;
-	y	+= q.y;
-	z	+= q.z;
-	return *this;
-}
-
-/*------------------------------------------------------------------*
- *							  operator+								*
- *------------------------------------------------------------------*/
-/**
- *	@brief		Performs quaternion addition without modifying
- *				this instance.
- *	@author		Josh Williams
- *	@date		11-Sep-2003
- *
- *	@param		q	VQuaternion we should add to ourselves
- *
- *	@returns	(VQuaternion) Sum of this quaternion and q.
- */
-/*------------------------------------------------------------------*
- * MODIFICATIONS													*
- *	Date		Description							Author			*
- * ===========	==================================	===============	*
- *																	*
- *------------------------------------------------------------------*/
-VQuaternion VQuaternion::operator+(const VQuaternion& q) const
-{
-	return VQuaternion(w + q.w,
-						x + q.x,
-						y + q.y,
-						z + q.z);
-}
-
-/*------------------------------------------------------------------*
- *							   operator-=							*
- *------------------------------------------------------------------*/
-/**
- *	@brief		Performs quaternion subtraction.
- *	@author		Josh Williams
- *	@date		10-Sep-2003
- *
- *	@remarks	The exact inverse of addition.
- *
- *	@param		q	VQuaternion we should subtract from ourselves
- *
- *	@returns	(VQuaternion&) Value of this object after subtraction.
- */
-/*------------------------------------------------------------------*
- * MODIFICATIONS													*
- *	Date		Description							Author			*
- * ===========	==================================	===============	*
- *																	*
- *------------------------------------------------------------------*/
-VQuaternion& VQuaternion::operator-=(const VQuaternion& q)
-{
-	w -= q.w;
-	x -= q.x;
-	y -= q.y;
-	z -= q.z;
-	return *this;
-}
-
-/*------------------------------------------------------------------*
- *							  operator-								*
- *------------------------------------------------------------------*/
-/**
- *	@brief		Performs quaternion subtraction without modifying
- *				this instance.
- *	@author		Josh Williams
- *	@date		11-Sep-2003
- *
- *	@param		q	VQuaternion we should subtract from ourselves
- *
- *	@returns	(VQuaternion) Difference in the two quaternions.
- */
-/*------------------------------------------------------------------*
- * MODIFICATIONS													*
- *	Date		Description							Author			*
- * ===========	==================================	===============	*
- *																	*
- *------------------------------------------------------------------*/
-VQuaternion VQuaternion::operator-(const VQuaternion& q) const
-{
-	return VQuaternion(w - q.w,
-						x - q.x,
-						y - q.y,
-						z - q.z);
-}
-
-/*------------------------------------------------------------------*
- *							  operator*=							*
- *------------------------------------------------------------------*/
-/**
- *	@brief		Multiplies this quaternion by another.
- *	@author		Josh Williams
- *	@date		14-Sep-2003
- *
- *	@param		q	VQuaternion to multiply by.
- *
- *	@returns	(VQuaternion) Result of multiplication.
- */
-/*------------------------------------------------------------------*
- * MODIFICATIONS													*
- *	Date		Description							Author			*
- * ===========	==================================	===============	*
- *																	*
- *------------------------------------------------------------------*/
-VQuaternion& VQuaternion::operator*=(const VQuaternion& q)
-{
-	w = q.w*w - q.x*x - q.y*y - q.z*z;
-	x = q.w*x + q.x*w + q.y*z - q.z*y;
-	y = q.w*y - q.x*z + q.y*w + q.z*x;
-	z = q.w*z + q.x*y - q.y*x + q.z*w;
-
-	return *this;
-}
-
-/*------------------------------------------------------------------*
- *							 operator* (VQuaternion)				*
- *------------------------------------------------------------------*/
-/**
- *	@brief		Performs quaternion multiplication without modifying
- *				this instance.
- *	@author		Josh Williams
- *	@date		11-Sep-2003
- *
- *	@param		q	VQuaternion we should multiply by ourselves.
- *
- *	@returns	(VQuaternion) Product of the two quaternions.
- */
-/*------------------------------------------------------------------*
- * MODIFICATIONS													*
- *	Date		Description							Author			*
- * ===========	==================================	===============	*
- *																	*
- *------------------------------------------------------------------*/
-VQuaternion VQuaternion::operator*(const VQuaternion& q) const
-{
-	return VQuaternion(
-		w*q.w - x*q.x - y*q.y - z*q.z,
-		w*q.x + x*q.w + y*q.z - z*q.y,
-		w*q.y + y*q.w + z*q.x - x*q.z,
-		w*q.z + z*q.w + x*q.y - y*q.x);
-}
-
-/*------------------------------------------------------------------*
- *							  operator~								*
- *------------------------------------------------------------------*/
-/**
- *	@brief		Computes the conjugate of this VQuaternion.
- *	@author		Josh Williams
- *	@date		11-Sep-2003
- *
- *	@returns	(VQuaternion) This VQuaternion's conjugate.
- */
-/*------------------------------------------------------------------*
- * MODIFICATIONS													*
- *	Date		Description							Author			*
- * ===========	==================================	===============	*
- *																	*
- *------------------------------------------------------------------*/
-VQuaternion VQuaternion::operator~() const
-{
-	return VQuaternion(w, -x, -y, -z);
-}
-
 /********************************************************************
  *                         C A L L B A C K S                        *
  ********************************************************************/
@@ -0,0 +1,392 @@
+/*============================================================================*
+ *                                                                            *
+ * 	This file is part of the Viper3D Game Engine.							  *
+ *                                                                            *
+ *	Copyright (C) 2004 UDP Games   All Rights Reserved.						  *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------	------------- *
+ *                                                                            *
+ *============================================================================*/
+#include <viper3d/math/QuaternionBatch.h>
+
+/* System Headers */
+#include <cstdlib>
+#include <cstring>
+
+/* Local Headers */
+
+namespace UDP
+{
+
+/*
+ * Rounds a count up to the padding granularity of the component arrays.
+ */
+static inline VUINT PadCount(VUINT nCount)
+{
+	return (nCount + VBATCH_WIDTH - 1) & ~(VUINT)(VBATCH_WIDTH - 1);
+}
+
+/********************************************************************
+ *          C O N S T R U C T I O N / D E S T R U C T I O N         *
+ ********************************************************************/
+VQuaternionBatch::VQuaternionBatch(VUINT nCount /*=0*/)
+: mBlock(NULL), mX(NULL), mY(NULL), mZ(NULL), mW(NULL), mCount(0), mCapacity(0)
+{
+	Resize(nCount);
+}
+
+VQuaternionBatch::VQuaternionBatch(const VQuaternion *pQuats, VUINT nCount)
+: mBlock(NULL), mX(NULL), mY(NULL), mZ(NULL), mW(NULL), mCount(0), mCapacity(0)
+{
+	FromQuaternions(pQuats, nCount);
+}
+
+VQuaternionBatch::VQuaternionBatch(const VQuaternionBatch &batch)
+: mBlock(NULL), mX(NULL), mY(NULL), mZ(NULL), mW(NULL), mCount(0), mCapacity(0)
+{
+	*this = batch;
+}
+
+VQuaternionBatch::~VQuaternionBatch()
+{
+	free(mBlock);
+}
+
+/********************************************************************
+ *                        O P E R A T I O N S                       *
+ ********************************************************************/
+
+/*------------------------------------------------------------------*
+ *								Resize()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Changes the number of quaternions held by this batch.
+ *	@date		17-Oct-2026
+ *
+ *	@param		nCount	New number of quaternions
+ *
+ *	@remarks	Existing contents are preserved up to the new count and
+ *				new elements are set to the identity.  If the storage
+ *				cannot be grown the batch is left unchanged.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VQuaternionBatch::Resize(VUINT nCount)
+{
+	VUINT vOld = mCount;
+
+	Reserve(nCount);
+	if (nCount > mCapacity)
+		return;
+
+	if (nCount > vOld)
+	{
+		memset(mX + vOld, 0, (nCount - vOld) * sizeof(float));
+		memset(mY + vOld, 0, (nCount - vOld) * sizeof(float));
+		memset(mZ + vOld, 0, (nCount - vOld) * sizeof(float));
+		for (VUINT i = vOld; i < nCount; i++)
+			mW[i] = 1.0f;
+	}
+	mCount = nCount;
+}
+
+/*------------------------------------------------------------------*
+ *							FromQuaternions()						*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Fills this batch from an array of VQuaternion.
+ *	@date		17-Oct-2026
+ *
+ *	@param		pQuats	Source quaternions
+ *	@param		nCount	Number of quaternions in pQuats
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VQuaternionBatch::FromQuaternions(const VQuaternion *pQuats, VUINT nCount)
+{
+	Resize(nCount);
+	for (VUINT i = 0; i < mCount; i++)
+		Set(i, pQuats[i]);
+}
+
+void VQuaternionBatch::ToQuaternions(VQuaternion *pQuats) const
+{
+	for (VUINT i = 0; i < mCount; i++)
+	{
+		pQuats[i].x = mX[i];
+		pQuats[i].y = mY[i];
+		pQuats[i].z = mZ[i];
+		pQuats[i].w = mW[i];
+	}
+}
+
+void VQuaternionBatch::Multiply(const VQuaternionBatch &batch)
+{
+	Multiply(*this, batch);
+}
+
+/*------------------------------------------------------------------*
+ *							   Multiply()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Sets each quaternion to the product of the matching
+ *				pair from two batches.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	Same product as VQuaternion::operator*; b1[i] * b2[i]
+ *				rotates by b2[i] first.  Either batch may be this one.
+ *
+ *	@param		b1		Left hand quaternions
+ *	@param		b2		Right hand quaternions
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VQuaternionBatch::Multiply(const VQuaternionBatch &b1, const VQuaternionBatch &b2)
+{
+	Match(b1, b2);
+	VSimd::mKernels.BatchQuatMultiply(SoA(), b1.SoA(), b2.SoA(), mCount);
+}
+
+/*------------------------------------------------------------------*
+ *								Rotate()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Rotates each vector by the matching quaternion.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	The quaternions are assumed to be unit length.  Only
+ *				the first min(Count(), vecs.Count()) vectors change.
+ *
+ *	@param		vecs	Vectors to rotate in place
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VQuaternionBatch::Rotate(VVectorBatch &vecs) const
+{
+	VUINT vCount = (mCount < vecs.Count() ? mCount : vecs.Count());
+
+	VSimd::mKernels.BatchQuatRotate(vecs.SoA(), SoA(), vecs.SoA(), vCount);
+}
+
+void VQuaternionBatch::Normalize()
+{
+	VSimd::mKernels.BatchQuatNormalize(SoA(), mCount);
+}
+
+/*------------------------------------------------------------------*
+ *								Nlerp()								*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Blends two batches by linear interpolation, then
+ *				renormalizes.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	Takes the shorter arc.  The cheapest blend, but the
+ *				rotation speed is not constant across fT.
+ *
+ *	@param		b1		Quaternions at fT = 0
+ *	@param		b2		Quaternions at fT = 1
+ *	@param		fT		Blend factor, shared by every element
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VQuaternionBatch::Nlerp(const VQuaternionBatch &b1, const VQuaternionBatch &b2,
+							float fT)
+{
+	Match(b1, b2);
+	VSimd::mKernels.BatchQuatNlerp(SoA(), b1.SoA(), b2.SoA(), fT, mCount);
+}
+
+/*------------------------------------------------------------------*
+ *								Slerp()								*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Blends two batches by spherical linear interpolation.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	Takes the shorter arc and renormalizes the results.  With
+ *				bFast the blend is an nlerp with a corrected fT, which
+ *				stays within 2e-3 radians of a true slerp and costs
+ *				little more than Nlerp().
+ *
+ *	@param		b1		Quaternions at fT = 0
+ *	@param		b2		Quaternions at fT = 1
+ *	@param		fT		Blend factor, shared by every element
+ *	@param		bFast	Use the approximation
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VQuaternionBatch::Slerp(const VQuaternionBatch &b1, const VQuaternionBatch &b2,
+							float fT, bool bFast /*=false*/)
+{
+	Match(b1, b2);
+	VSimd::mKernels.BatchQuatSlerp(SoA(), b1.SoA(), b2.SoA(), fT, bFast, mCount);
+}
+
+/*------------------------------------------------------------------*
+ *							  ToAffines()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Converts each quaternion to a rotation transform.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	The rotations match VQuaternion::ToRotationMatrix(),
+ *				with no translation.
+ *
+ *	@param		pOut	Receives Count() transforms
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VQuaternionBatch::ToAffines(VAffine *pOut) const
+{
+	VSoA vNone;
+
+	vNone.x = vNone.y = vNone.z = NULL;
+	VSimd::mKernels.BatchQuatToAffine(pOut[0][0], SoA(), vNone, mCount);
+}
+
+/*------------------------------------------------------------------*
+ *							  ToAffines()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Converts each quaternion and position to a transform,
+ *				as VAffine::Set() does.
+ *	@date		17-Oct-2026
+ *
+ *	@param		pOut	Receives min(Count(), pos.Count()) transforms
+ *	@param		pos		Translation of each transform
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VQuaternionBatch::ToAffines(VAffine *pOut, const VVectorBatch &pos) const
+{
+	VUINT vCount = (mCount < pos.Count() ? mCount : pos.Count());
+
+	VSimd::mKernels.BatchQuatToAffine(pOut[0][0], SoA(), pos.SoA(), vCount);
+}
+
+/********************************************************************
+ *                         O P E R A T O R S                        *
+ ********************************************************************/
+const VQuaternionBatch& VQuaternionBatch::operator=(const VQuaternionBatch &batch)
+{
+	if (this == &batch)
+		return *this;
+
+	Resize(batch.mCount);
+	memcpy(mX, batch.mX, mCount * sizeof(float));
+	memcpy(mY, batch.mY, mCount * sizeof(float));
+	memcpy(mZ, batch.mZ, mCount * sizeof(float));
+	memcpy(mW, batch.mW, mCount * sizeof(float));
+	return *this;
+}
+
+/********************************************************************
+ *                         I N T E R N A L S                        *
+ ********************************************************************/
+
+/*------------------------------------------------------------------*
+ *								Reserve()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Makes sure the component arrays can hold nCount
+ *				elements, reallocating if necessary.
+ *	@date		17-Oct-2026
+ *
+ *	@param		nCount	Number of elements required
+ *
+ *	@remarks	All four arrays share one allocation, aligned as in
+ *				VVectorBatch::Reserve().
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VQuaternionBatch::Reserve(VUINT nCount)
+{
+	VUINT	vCapacity;
+	char	*vBlock;
+	float	*vX;
+	size_t	vOffset;
+
+	if (nCount <= mCapacity)
+		return;
+
+	vCapacity = PadCount(nCount);
+	vBlock = (char*)malloc(4 * vCapacity * sizeof(float) + VBATCH_ALIGN);
+	if (vBlock == NULL)
+		return;
+	memset(vBlock, 0, 4 * vCapacity * sizeof(float) + VBATCH_ALIGN);
+
+	vOffset = (VBATCH_ALIGN - ((size_t)vBlock & (VBATCH_ALIGN - 1))) & (VBATCH_ALIGN - 1);
+	vX = (float*)(vBlock + vOffset);
+
+	if (mCount > 0)
+	{
+		memcpy(vX, mX, mCount * sizeof(float));
+		memcpy(vX + vCapacity, mY, mCount * sizeof(float));
+		memcpy(vX + 2 * vCapacity, mZ, mCount * sizeof(float));
+		memcpy(vX + 3 * vCapacity, mW, mCount * sizeof(float));
+	}
+	free(mBlock);
+
+	mBlock = vBlock;
+	mX = vX;
+	mY = vX + vCapacity;
+	mZ = vX + 2 * vCapacity;
+	mW = vX + 3 * vCapacity;
+	mCapacity = vCapacity;
+}
+
+/*
+ * Sizes this batch for the result of a binary operation, without
+ * reallocating when it is one of the operands.
+ */
+void VQuaternionBatch::Match(const VQuaternionBatch &b1, const VQuaternionBatch &b2)
+{
+	VUINT vCount = (b1.mCount < b2.mCount ? b1.mCount : b2.mCount);
+
+	if (this != &b1 && this != &b2)
+		Resize(vCount);
+	else
+		mCount = vCount;
+}
+
+} // End Namespace
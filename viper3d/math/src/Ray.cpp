@@ -15,6 +15,7 @@
 /* System Headers */
 
 /* Local Headers */
+#include <viper3d/math/SlabRay.h>
 
 namespace UDP
 {
@@ -338,99 +339,12 @@ bool VRay::Intersects(const VPlane& plane, bool bCull, float fL,
  * MODIFICATIONS													*
  *	Date		Description							Author			*
  * ===========	==================================	===============	*
+ *	17-Oct-2026	Slab test through VSlabRay							*
  *																	*
  *------------------------------------------------------------------*/
 bool VRay::Intersects(const VAabb& aabb, float *t)
 {
-	float t0, t1, tmp;
-	float tNear = -999999.9f;
-	float tFar  =  999999.9f;
-	float epsilon = 0.00001f;
-	VVector MaxT;
-
-	/* first pair of planes */
-	if (VMath::Abs(m_vDir.x) < epsilon)
-	{
-		if ((m_vOrig.x < aabb.GetMin().x) ||
-			(m_vOrig.x > aabb.GetMax().x))
-			return false;
-	}
-	t0 = (aabb.GetMin().x - m_vOrig.x) / m_vDir.x;
-	t1 = (aabb.GetMax().x - m_vOrig.x) / m_vDir.x;
-	if (t0 > t1)
-	{
-		tmp=t0;
-		t0=t1;
-		t1=tmp;
-	}
-	if (t0 > tNear)
-		tNear = t0;
-	if (t1 < tFar)
-		tFar = t1;
-	if (tNear > tFar)
-		return false;
-	if (tFar < 0)
-		return false;
-
-	/* second pair of planes */
-	if (VMath::Abs(m_vDir.y) < epsilon)
-	{
-		if ((m_vOrig.y < aabb.GetMin().y) ||
-			(m_vOrig.y > aabb.GetMax().y))
-			return false;
-	}
-	t0 = (aabb.GetMin().y - m_vOrig.y) / m_vDir.y;
-	t1 = (aabb.GetMax().y - m_vOrig.y) / m_vDir.y;
-	if (t0 > t1)
-	{
-		tmp=t0;
-		t0=t1;
-		t1=tmp;
-	}
-	if (t0 > tNear)
-		tNear = t0;
-	if (t1 < tFar)
-		tFar = t1;
-	if (tNear > tFar)
-		return false;
-	if (tFar < 0)
-		return false;
-
-	/* third pair of planes */
-	if (VMath::Abs(m_vDir.z) < epsilon)
-	{
-		if ((m_vOrig.z < aabb.GetMin().z) ||
-			(m_vOrig.z > aabb.GetMax().z))
-			return false;
-	}
-	t0 = (aabb.GetMin().z - m_vOrig.z) / m_vDir.z;
-	t1 = (aabb.GetMax().z - m_vOrig.z) / m_vDir.z;
-	if (t0 > t1)
-	{
-		tmp=t0;
-		t0=t1;
-		t1=tmp;
-	}
-	if (t0 > tNear)
-		tNear = t0;
-	if (t1 < tFar)
-		tFar = t1;
-	if (tNear > tFar)
-		return false;
-	if (tFar < 0)
-		return false;
-
-	if (tNear > 0)
-	{
-		if (t)
-			*t = tNear;
-	}
-	else
-	{
-		if (t)
-			*t = tFar;
-	}
-	return true;
+	return VSlabRay(*this).Intersects(aabb, t);
 }
 
 /**
@@ -443,95 +357,7 @@ bool VRay::Intersects(const VAabb& aabb, float *t)
  */
 bool VRay::Intersects(const VAabb& aabb, float fL, float *t)
 {
-	float t0, t1, tmp, tFinal;
-	float tNear = -999999.9f;
-	float tFar  =  999999.9f;
-	float epsilon = 0.00001f;
-	VVector MaxT;
-
-	/* first pair of planes */
-	if (VMath::Abs(m_vDir.x) < epsilon)
-	{
-		if ((m_vOrig.x < aabb.GetMin().x) ||
-			(m_vOrig.x > aabb.GetMax().x))
-			return false;
-	}
-	t0 = (aabb.GetMin().x - m_vOrig.x) / m_vDir.x;
-	t1 = (aabb.GetMax().x - m_vOrig.x) / m_vDir.x;
-	if (t0 > t1)
-	{
-		tmp = t0;
-		t0 = t1;
-		t1 = tmp;
-	}
-	if (t0 > tNear)
-		tNear = t0;
-	if (t1 < tFar)
-		tFar = t1;
-	if (tNear > tFar)
-		return false;
-	if (tFar < 0)
-		return false;
-
-	/* second pair of planes */
-	if (VMath::Abs(m_vDir.y) < epsilon)
-	{
-		if ((m_vOrig.y < aabb.GetMin().y) ||
-			(m_vOrig.y > aabb.GetMax().y))
-			return false;
-	}
-	t0 = (aabb.GetMin().y - m_vOrig.y) / m_vDir.y;
-	t1 = (aabb.GetMax().y - m_vOrig.y) / m_vDir.y;
-	if (t0 > t1)
-	{
-		tmp = t0;
-		t0 = t1;
-		t1 = tmp;
-	}
-	if (t0 > tNear)
-		tNear = t0;
-	if (t1 < tFar)
-		tFar = t1;
-	if (tNear > tFar)
-		return false;
-	if (tFar < 0)
-		return false;
-
-	/* third pair of planes */
-	if (VMath::Abs(m_vDir.z) < epsilon)
-	{
-		if ((m_vOrig.z < aabb.GetMin().z) ||
-			(m_vOrig.z > aabb.GetMax().z))
-			return false;
-	}
-	t0 = (aabb.GetMin().z - m_vOrig.z) / m_vDir.z;
-	t1 = (aabb.GetMax().z - m_vOrig.z) / m_vDir.z;
-	if (t0 > t1)
-	{
-		tmp = t0;
-		t0 = t1;
-		t1 = tmp;
-	}
-	if (t0 > tNear)
-		tNear = t0;
-	if (t1 < tFar)
-		tFar = t1;
-	if (tNear > tFar)
-		return false;
-	if (tFar < 0)
-		return false;
-
-	if (tNear > 0)
-		tFinal = tNear;
-	else
-		tFinal = tFar;
-
-	if (tFinal > fL)
-		return false;
-	if (t)
-		*t = tFinal;
-
-	return true;
+	return VSlabRay(*this).Intersects(aabb, fL, t);
 }
 
 /*------------------------------------------------------------------*
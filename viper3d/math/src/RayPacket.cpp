@@ -0,0 +1,226 @@
+/*============================================================================*
+ *                                                                            *
+ * 	This file is part of the Viper3D Game Engine.							  *
+ *                                                                            *
+ *	Copyright (C) 2004 UDP Games   All Rights Reserved.						  *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------	------------- *
+ *                                                                            *
+ *============================================================================*/
+#include <viper3d/math/RayPacket.h>
+
+/* System Headers */
+
+/* Local Headers */
+
+namespace UDP
+{
+
+/********************************************************************
+ *          C O N S T R U C T I O N / D E S T R U C T I O N         *
+ ********************************************************************/
+VRayPacket::VRayPacket()
+{
+	Clear();
+}
+
+VRayPacket::~VRayPacket()
+{
+
+}
+
+/********************************************************************
+ *                        A T T R I B U T E S                       *
+ ********************************************************************/
+
+/*------------------------------------------------------------------*
+ *								GetRay()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Returns one of the rays in the packet.
+ *	@date		17-Oct-2026
+ *
+ *	@param		nRay	Index of the ray
+ *
+ *	@returns	(VRay)	The ray as it was added
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+VRay VRayPacket::GetRay(VUINT nRay) const
+{
+	return VRay(VVector(mOrig[0][nRay], mOrig[1][nRay], mOrig[2][nRay]),
+				VVector(mDir[0][nRay], mDir[1][nRay], mDir[2][nRay]));
+}
+
+/*------------------------------------------------------------------*
+ *								 SoA()								*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Component pointers for the ray packet kernels.
+ *	@date		17-Oct-2026
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+VSoARays VRayPacket::SoA()
+{
+	VSoARays vRays = {
+		mOrig[0], mOrig[1], mOrig[2],
+		mDir[0], mDir[1], mDir[2],
+		mInv[0], mInv[1], mInv[2],
+		mT, mU, mV, mHit
+	};
+
+	return vRays;
+}
+
+/********************************************************************
+ *                        O P E R A T I O N S                       *
+ ********************************************************************/
+
+/*------------------------------------------------------------------*
+ *								Clear()								*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Empties the packet.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	Unused lanes get a zero direction and a zero distance
+ *				limit, so the kernels can run over them without ever
+ *				reporting a hit.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VRayPacket::Clear()
+{
+	for (VUINT i = 0; i < VSIMD_PACKET; i++)
+	{
+		for (int a = 0; a < 3; a++)
+		{
+			mOrig[a][i] = 0.0f;
+			mDir[a][i] = 0.0f;
+			mInv[a][i] = VRAY_FAR;
+		}
+		mFar[i] = 0.0f;
+		mT[i] = 0.0f;
+		mU[i] = 0.0f;
+		mV[i] = 0.0f;
+		mHit[i] = VRAY_NO_HIT;
+	}
+	mCount = 0;
+}
+
+/*------------------------------------------------------------------*
+ *								 Add()								*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Appends a ray to the packet.
+ *	@date		17-Oct-2026
+ *
+ *	@param		ray		Ray to add
+ *	@param		fL		Farthest distance along the ray that counts
+ *
+ *	@returns	(VUINT) Index of the new ray, or VRAY_NO_HIT if the
+ *						packet is full
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+VUINT VRayPacket::Add(const VRay &ray, float fL /*=VRAY_FAR*/)
+{
+	if (mCount == VSIMD_PACKET)
+		return VRAY_NO_HIT;
+
+	Set(mCount, ray, fL);
+	return mCount++;
+}
+
+/*------------------------------------------------------------------*
+ *								 Set()								*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Replaces one ray of the packet and clears its hit.
+ *	@date		17-Oct-2026
+ *
+ *	@param		nRay	Index of the ray, below Count()
+ *	@param		ray		New ray
+ *	@param		fL		Farthest distance along the ray that counts
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VRayPacket::Set(VUINT nRay, const VRay &ray, float fL /*=VRAY_FAR*/)
+{
+	const VVector &vO = ray.GetOrigin();
+	const VVector &vD = ray.GetDirection();
+
+	mOrig[0][nRay] = vO.x;
+	mOrig[1][nRay] = vO.y;
+	mOrig[2][nRay] = vO.z;
+	mDir[0][nRay] = vD.x;
+	mDir[1][nRay] = vD.y;
+	mDir[2][nRay] = vD.z;
+	for (int a = 0; a < 3; a++)
+	{
+		if (VMath::Abs(mDir[a][nRay]) < 1e-20f)
+			mInv[a][nRay] = mDir[a][nRay] < 0.0f ? -VRAY_FAR : VRAY_FAR;
+		else
+			mInv[a][nRay] = 1.0f / mDir[a][nRay];
+	}
+	mFar[nRay] = fL;
+	mT[nRay] = fL;
+	mU[nRay] = 0.0f;
+	mV[nRay] = 0.0f;
+	mHit[nRay] = VRAY_NO_HIT;
+}
+
+/*------------------------------------------------------------------*
+ *								Reset()								*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Forgets the hits, so the same rays can be traced again.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	Tracing a packet against several meshes without calling
+ *				this in between keeps the nearest hit over all of them,
+ *				since every trace only accepts hits nearer than the ones
+ *				already found.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VRayPacket::Reset()
+{
+	for (VUINT i = 0; i < VSIMD_PACKET; i++)
+	{
+		mT[i] = mFar[i];
+		mU[i] = 0.0f;
+		mV[i] = 0.0f;
+		mHit[i] = VRAY_NO_HIT;
+	}
+}
+
+} // End Namespace
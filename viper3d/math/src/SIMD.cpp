@@ -0,0 +1,163 @@
+/*============================================================================*
+ *                                                                            *
+ * 	This file is part of the Viper3D Game Engine.							  *
+ *                                                                            *
+ *	Copyright (C) 2004 UDP Games   All Rights Reserved.						  *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------	------------- *
+ *                                                                            *
+ *============================================================================*/
+#include <viper3d/math/SIMD.h>
+
+/* System Headers */
+
+/* Local Headers */
+#include <viper3d/util/Log.h>
+
+/* the scalar kernels are always available, so they live here */
+#define VSIMD_LANES		0
+#define VSIMD_SSE41		0
+#define VSIMD_FMA		0
+#include "SIMDKernels.inl"
+
+namespace UDP
+{
+
+static char __CLASS__[] = "[    VSimd     ]";
+
+static const VSimdKernels sScalarKernels = VSIMD_TABLE("scalar");
+
+/*
+ * Starts out scalar so anything running before VCPU::Init() is safe.
+ * Plain function addresses, so this is initialized statically, ahead of
+ * any constructor that might use it.
+ */
+VSimdKernels	VSimd::mKernels = VSIMD_TABLE("scalar");
+VSimdTier		VSimd::mTier = SIMD_SCALAR;
+
+const VSimdKernels* SimdKernelsScalar()
+{
+	return &sScalarKernels;
+}
+
+/*
+ * Hooks VSimd::Select() into VCPU::Init() as soon as the library loads.
+ */
+static void OnCPUInit(VSimdTier eTier)
+{
+	VSimd::Select(eTier);
+}
+
+static struct VSimdRegistrar
+{
+	VSimdRegistrar() { VCPU::AddInitHook(OnCPUInit); }
+} sRegistrar;
+
+/********************************************************************
+ *                        A T T R I B U T E S                       *
+ ********************************************************************/
+
+/*------------------------------------------------------------------*
+ *								GetTier()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Returns the tier of the kernels currently in mKernels.
+ *	@date		17-Oct-2026
+ *
+ *	@returns	(VSimdTier) Active tier
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+VSimdTier VSimd::GetTier()
+{
+	return mTier;
+}
+
+/*------------------------------------------------------------------*
+ *							  GetKernels()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Returns the kernel set compiled for a given tier.
+ *	@date		17-Oct-2026
+ *
+ *	@param		eTier	Tier to look up
+ *
+ *	@returns	(const VSimdKernels*) Kernels, or NULL if that tier was
+ *				not compiled into this build.
+ *
+ *	@remarks	Does not check whether the CPU can actually run them.
+ *				Tests use this to compare tiers against each other.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+const VSimdKernels* VSimd::GetKernels(VSimdTier eTier)
+{
+	switch (eTier)
+	{
+	case SIMD_SCALAR:	return SimdKernelsScalar();
+	case SIMD_SSE2:		return SimdKernelsSSE2();
+	case SIMD_SSE41:	return SimdKernelsSSE41();
+	case SIMD_AVX2:		return SimdKernelsAVX2();
+	case SIMD_FMA:		return SimdKernelsFMA();
+	default:			return NULL;
+	}
+}
+
+/********************************************************************
+ *                        O P E R A T I O N S                       *
+ ********************************************************************/
+
+/*------------------------------------------------------------------*
+ *								 Select()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Fills mKernels with the best compiled kernel set at or
+ *				below the requested tier.
+ *	@date		17-Oct-2026
+ *
+ *	@param		eTier	Highest tier the CPU supports (or is allowed)
+ *
+ *	@remarks	Normally called through VCPU::Init()/VCPU::SetTier();
+ *				calling it with a tier the CPU cannot run will fault.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VSimd::Select(VSimdTier eTier)
+{
+	const VSimdKernels *vKernels = NULL;
+
+	if (eTier >= SIMD_TIER_COUNT)
+		eTier = (VSimdTier)(SIMD_TIER_COUNT - 1);
+
+	while (eTier > SIMD_SCALAR)
+	{
+		vKernels = GetKernels(eTier);
+		if (vKernels != NULL)
+			break;
+		eTier = (VSimdTier)(eTier - 1);
+	}
+	if (vKernels == NULL)
+		vKernels = SimdKernelsScalar();
+
+	mKernels = *vKernels;
+	mTier = eTier;
+
+	VTRACE(_CL("Using %s math kernels\n"), mKernels.mName);
+}
+
+} // End Namespace
@@ -0,0 +1,45 @@
+/*============================================================================*
+ *                                                                            *
+ * 	This file is part of the Viper3D Game Engine.							  *
+ *                                                                            *
+ *	Copyright (C) 2004 UDP Games   All Rights Reserved.						  *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------	------------- *
+ *                                                                            *
+ *============================================================================*/
+#include <viper3d/math/SIMD.h>
+
+/*
+ * AVX2+FMA kernels.  Built with -mavx2 -mfma by the makefile, plus
+ * -ffp-contract=off so only the kernels that ask for fused multiply-adds
+ * get them.  If the compiler was not told to target AVX2+FMA this file
+ * contributes nothing and the dispatcher falls back to a lower tier.
+ */
+#if (defined(__AVX2__) && defined(__FMA__)) || (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)))
+#define VSIMD_LANES		8
+#define VSIMD_SSE41		1
+#define VSIMD_FMA		1
+#include "SIMDKernels.inl"
+#define VSIMD_AVAILABLE
+#endif
+
+namespace UDP
+{
+
+#if defined(VSIMD_AVAILABLE)
+static const VSimdKernels sKernels = VSIMD_TABLE("fma");
+#endif
+
+const VSimdKernels* SimdKernelsFMA()
+{
+#if defined(VSIMD_AVAILABLE)
+	return &sKernels;
+#else
+	return NULL;
+#endif
+}
+
+} // End Namespace
@@ -0,0 +1,2478 @@
+/*============================================================================*
+ *                                                                            *
+ * 	This file is part of the Viper3D Game Engine.							  *
+ *                                                                            *
+ *	Copyright (C) 2004 UDP Games   All Rights Reserved.						  *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------	------------- *
+ *                                                                            *
+ *============================================================================*/
+/*
+ * Math kernels, written once and compiled for each instruction set tier.
+ * The including file defines:
+ *
+ *	VSIMD_LANES		0 (scalar), 4 (SSE) or 8 (AVX)
+ *	VSIMD_SSE41		1 to use SSE4.1 dot products and blends
+ *	VSIMD_FMA		1 to use fused multiply-add
+ *
+ * and then builds its table with VSIMD_TABLE(name).  Every kernel has
+ * internal linkage so the tiers never collide at link time.
+ */
+
+/* System Headers */
+#include <math.h>
+#if VSIMD_LANES == 8
+#include <immintrin.h>
+#elif VSIMD_LANES == 4 && VSIMD_SSE41
+#include <smmintrin.h>
+#elif VSIMD_LANES == 4
+#include <emmintrin.h>
+#endif
+
+#if VSIMD_LANES == 8
+typedef __m256 vreg;
+#define VLOAD(p)				_mm256_load_ps(p)
+#define VSTORE(p, a)			_mm256_store_ps(p, a)
+#define VSTOREU(p, a)			_mm256_storeu_ps(p, a)
+#define VSET1(f)				_mm256_set1_ps(f)
+#define VZERO()					_mm256_setzero_ps()
+#define VADD(a, b)				_mm256_add_ps(a, b)
+#define VSUB(a, b)				_mm256_sub_ps(a, b)
+#define VMUL(a, b)				_mm256_mul_ps(a, b)
+#define VDIV(a, b)				_mm256_div_ps(a, b)
+#define VSQRT(a)				_mm256_sqrt_ps(a)
+#define VCMPNEQ(a, b)			_mm256_cmp_ps(a, b, _CMP_NEQ_UQ)
+#define VSELECT(m, a, b)		_mm256_blendv_ps(b, a, m)
+#define VOR(a, b)				_mm256_or_ps(a, b)
+#define VAND(a, b)				_mm256_and_ps(a, b)
+#define VCMPGT(a, b)			_mm256_cmp_ps(a, b, _CMP_GT_OQ)
+#define VCMPGE(a, b)			_mm256_cmp_ps(a, b, _CMP_GE_OQ)
+#define VMOVEMASK(a)			((VUINT)_mm256_movemask_ps(a))
+#define VLOADU(p)				_mm256_loadu_ps(p)
+#define VMIN(a, b)				_mm256_min_ps(a, b)
+#define VMAX(a, b)				_mm256_max_ps(a, b)
+#define VABS(a)					_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a)
+#define VXOR(a, b)				_mm256_xor_ps(a, b)
+#define VRSQRT(a)				_mm256_rsqrt_ps(a)
+typedef __m256i vint;
+#define VCVTI(a)				_mm256_cvtps_epi32(a)
+#define VCVTF(i)				_mm256_cvtepi32_ps(i)
+#define VCASTF(i)				_mm256_castsi256_ps(i)
+#define VISET1(n)				_mm256_set1_epi32(n)
+#define VIADD(i, j)				_mm256_add_epi32(i, j)
+#define VIAND(i, j)				_mm256_and_si256(i, j)
+#define VIEQ(i, j)				_mm256_cmpeq_epi32(i, j)
+#define VISHL(i, n)				_mm256_slli_epi32(i, n)
+#if VSIMD_FMA
+#define VMADD(a, b, c)			_mm256_fmadd_ps(a, b, c)
+#define VMSUB(a, b, c)			_mm256_fmsub_ps(a, b, c)
+#define VNMADD(a, b, c)			_mm256_fnmadd_ps(a, b, c)
+#endif
+#elif VSIMD_LANES == 4
+typedef __m128 vreg;
+#define VLOAD(p)				_mm_load_ps(p)
+#define VSTORE(p, a)			_mm_store_ps(p, a)
+#define VSTOREU(p, a)			_mm_storeu_ps(p, a)
+#define VSET1(f)				_mm_set1_ps(f)
+#define VZERO()					_mm_setzero_ps()
+#define VADD(a, b)				_mm_add_ps(a, b)
+#define VSUB(a, b)				_mm_sub_ps(a, b)
+#define VMUL(a, b)				_mm_mul_ps(a, b)
+#define VDIV(a, b)				_mm_div_ps(a, b)
+#define VSQRT(a)				_mm_sqrt_ps(a)
+#define VCMPNEQ(a, b)			_mm_cmpneq_ps(a, b)
+#define VOR(a, b)				_mm_or_ps(a, b)
+#define VAND(a, b)				_mm_and_ps(a, b)
+#define VCMPGT(a, b)			_mm_cmpgt_ps(a, b)
+#define VCMPGE(a, b)			_mm_cmpge_ps(a, b)
+#define VMOVEMASK(a)			((VUINT)_mm_movemask_ps(a))
+#define VLOADU(p)				_mm_loadu_ps(p)
+#define VMIN(a, b)				_mm_min_ps(a, b)
+#define VMAX(a, b)				_mm_max_ps(a, b)
+#define VABS(a)					_mm_andnot_ps(_mm_set1_ps(-0.0f), a)
+#define VXOR(a, b)				_mm_xor_ps(a, b)
+#define VRSQRT(a)				_mm_rsqrt_ps(a)
+typedef __m128i vint;
+#define VCVTI(a)				_mm_cvtps_epi32(a)
+#define VCVTF(i)				_mm_cvtepi32_ps(i)
+#define VCASTF(i)				_mm_castsi128_ps(i)
+#define VISET1(n)				_mm_set1_epi32(n)
+#define VIADD(i, j)				_mm_add_epi32(i, j)
+#define VIAND(i, j)				_mm_and_si128(i, j)
+#define VIEQ(i, j)				_mm_cmpeq_epi32(i, j)
+#define VISHL(i, n)				_mm_slli_epi32(i, n)
+#if VSIMD_SSE41
+#define VSELECT(m, a, b)		_mm_blendv_ps(b, a, m)
+#else
+#define VSELECT(m, a, b)		_mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b))
+#endif
+#endif
+
+#if VSIMD_LANES > 0 && !VSIMD_FMA
+#define VMADD(a, b, c)			VADD(VMUL(a, b), c)
+#define VMSUB(a, b, c)			VSUB(VMUL(a, b), c)
+#define VNMADD(a, b, c)			VSUB(c, VMUL(a, b))
+#endif
+
+/* Local Headers */
+#include "MathApprox.inl"
+
+namespace UDP
+{
+
+/*
+ * Number of leading elements that can be handled by full SIMD registers.
+ */
+static inline VUINT SimdCount(VUINT nCount)
+{
+#if VSIMD_LANES > 0
+	return nCount & ~(VUINT)(VSIMD_LANES - 1);
+#else
+	(void)nCount;
+	return 0;
+#endif
+}
+
+/********************************************************************
+ *             S I N G L E   V E C T O R / M A T R I X              *
+ ********************************************************************/
+
+#if VSIMD_LANES > 0
+/*
+ * x*x + y*y + z*z in the low lane of the result.
+ */
+static inline __m128 SquaredLength3(__m128 vV)
+{
+#if VSIMD_SSE41
+	return _mm_dp_ps(vV, vV, 0x71);
+#else
+	__m128 vSq = _mm_mul_ps(vV, vV);
+	__m128 vY = _mm_shuffle_ps(vSq, vSq, _MM_SHUFFLE(1, 1, 1, 1));
+	__m128 vZ = _mm_shuffle_ps(vSq, vSq, _MM_SHUFFLE(2, 2, 2, 2));
+	return _mm_add_ss(_mm_add_ss(vSq, vY), vZ);
+#endif
+}
+#endif
+
+static float Length(const float *pV)
+{
+#if VSIMD_LANES > 0
+	return _mm_cvtss_f32(_mm_sqrt_ss(SquaredLength3(_mm_loadu_ps(pV))));
+#else
+	return sqrtf(pV[0] * pV[0] + pV[1] * pV[1] + pV[2] * pV[2]);
+#endif
+}
+
+static void Normalize(float *pV)
+{
+#if VSIMD_LANES > 0
+	__m128 vV = _mm_loadu_ps(pV);
+	__m128 vL = _mm_sqrt_ss(SquaredLength3(vV));
+
+	if (_mm_cvtss_f32(vL) == 0.0f)
+		return;
+
+	vL = _mm_shuffle_ps(vL, vL, _MM_SHUFFLE(0, 0, 0, 0));
+#if VSIMD_SSE41
+	/* keep w from the original vector */
+	_mm_storeu_ps(pV, _mm_blend_ps(_mm_div_ps(vV, vL), vV, 0x8));
+#else
+	const __m128 vXYZ = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+	_mm_storeu_ps(pV, _mm_or_ps(_mm_and_ps(vXYZ, _mm_div_ps(vV, vL)),
+			_mm_andnot_ps(vXYZ, vV)));
+#endif
+#else
+	float fLength = sqrtf(pV[0] * pV[0] + pV[1] * pV[1] + pV[2] * pV[2]);
+	if (fLength != 0.0f)
+	{
+		pV[0] /= fLength;
+		pV[1] /= fLength;
+		pV[2] /= fLength;
+	}
+#endif
+}
+
+/*
+ * pOut = pA x pB.  w of the result is zero.  pOut may alias either operand.
+ */
+static void Cross(float *pOut, const float *pA, const float *pB)
+{
+#if VSIMD_LANES > 0
+	__m128 vA = _mm_loadu_ps(pA);
+	__m128 vB = _mm_loadu_ps(pB);
+	__m128 vA1 = _mm_shuffle_ps(vA, vA, _MM_SHUFFLE(3, 0, 2, 1));
+	__m128 vB1 = _mm_shuffle_ps(vB, vB, _MM_SHUFFLE(3, 1, 0, 2));
+	__m128 vA2 = _mm_shuffle_ps(vA, vA, _MM_SHUFFLE(3, 1, 0, 2));
+	__m128 vB2 = _mm_shuffle_ps(vB, vB, _MM_SHUFFLE(3, 0, 2, 1));
+	_mm_storeu_ps(pOut, _mm_sub_ps(_mm_mul_ps(vA1, vB1), _mm_mul_ps(vA2, vB2)));
+#else
+	float fX = pA[1] * pB[2] - pA[2] * pB[1];
+	float fY = pA[2] * pB[0] - pA[0] * pB[2];
+	float fZ = pA[0] * pB[1] - pA[1] * pB[0];
+	pOut[0] = fX;
+	pOut[1] = fY;
+	pOut[2] = fZ;
+	pOut[3] = 0.0f;
+#endif
+}
+
+/*
+ * pOut = pA * pB, all 4x4 row-major.  pOut may alias either operand.
+ */
+static void MatrixMultiply(float *pOut, const float *pA, const float *pB)
+{
+#if VSIMD_LANES == 8
+	/* two rows of the result per register */
+	__m256 vB0 = _mm256_broadcast_ps((const __m128*)(pB + 0));
+	__m256 vB1 = _mm256_broadcast_ps((const __m128*)(pB + 4));
+	__m256 vB2 = _mm256_broadcast_ps((const __m128*)(pB + 8));
+	__m256 vB3 = _mm256_broadcast_ps((const __m128*)(pB + 12));
+	__m256 vA01 = _mm256_loadu_ps(pA);
+	__m256 vA23 = _mm256_loadu_ps(pA + 8);
+	__m256 vR01, vR23;
+
+	vR01 = VMUL(_mm256_permute_ps(vA01, 0x00), vB0);
+	vR23 = VMUL(_mm256_permute_ps(vA23, 0x00), vB0);
+	vR01 = VMADD(_mm256_permute_ps(vA01, 0x55), vB1, vR01);
+	vR23 = VMADD(_mm256_permute_ps(vA23, 0x55), vB1, vR23);
+	vR01 = VMADD(_mm256_permute_ps(vA01, 0xAA), vB2, vR01);
+	vR23 = VMADD(_mm256_permute_ps(vA23, 0xAA), vB2, vR23);
+	vR01 = VMADD(_mm256_permute_ps(vA01, 0xFF), vB3, vR01);
+	vR23 = VMADD(_mm256_permute_ps(vA23, 0xFF), vB3, vR23);
+	_mm256_storeu_ps(pOut, vR01);
+	_mm256_storeu_ps(pOut + 8, vR23);
+#elif VSIMD_LANES == 4
+	__m128 vB0 = _mm_loadu_ps(pB + 0);
+	__m128 vB1 = _mm_loadu_ps(pB + 4);
+	__m128 vB2 = _mm_loadu_ps(pB + 8);
+	__m128 vB3 = _mm_loadu_ps(pB + 12);
+	__m128 vA[4], vR;
+	int i;
+
+	for (i = 0; i < 4; i++)
+		vA[i] = _mm_loadu_ps(pA + i * 4);
+
+	for (i = 0; i < 4; i++)
+	{
+		vR = VMUL(_mm_shuffle_ps(vA[i], vA[i], 0x00), vB0);
+		vR = VMADD(_mm_shuffle_ps(vA[i], vA[i], 0x55), vB1, vR);
+		vR = VMADD(_mm_shuffle_ps(vA[i], vA[i], 0xAA), vB2, vR);
+		vR = VMADD(_mm_shuffle_ps(vA[i], vA[i], 0xFF), vB3, vR);
+		_mm_storeu_ps(pOut + i * 4, vR);
+	}
+#else
+	float vR[16];
+	int i, j;
+
+	for (i = 0; i < 4; i++)
+	{
+		for (j = 0; j < 4; j++)
+		{
+			vR[i * 4 + j] = pA[i * 4 + 0] * pB[0 * 4 + j] +
+							pA[i * 4 + 1] * pB[1 * 4 + j] +
+							pA[i * 4 + 2] * pB[2 * 4 + j] +
+							pA[i * 4 + 3] * pB[3 * 4 + j];
+		}
+	}
+	for (i = 0; i < 16; i++)
+		pOut[i] = vR[i];
+#endif
+}
+
+#if VSIMD_LANES > 0
+/*
+ * a*b + c on 4 lanes, whatever the width of the tier.
+ */
+static inline __m128 MAdd4(__m128 vA, __m128 vB, __m128 vC)
+{
+#if VSIMD_FMA
+	return _mm_fmadd_ps(vA, vB, vC);
+#else
+	return _mm_add_ps(_mm_mul_ps(vA, vB), vC);
+#endif
+}
+
+/*
+ * x, y, z cross product of two registers; the w lane comes out zero.
+ */
+static inline __m128 Cross3(__m128 vA, __m128 vB)
+{
+	__m128 vAyzx = _mm_shuffle_ps(vA, vA, _MM_SHUFFLE(3, 0, 2, 1));
+	__m128 vBzxy = _mm_shuffle_ps(vB, vB, _MM_SHUFFLE(3, 1, 0, 2));
+	__m128 vAzxy = _mm_shuffle_ps(vA, vA, _MM_SHUFFLE(3, 1, 0, 2));
+	__m128 vByzx = _mm_shuffle_ps(vB, vB, _MM_SHUFFLE(3, 0, 2, 1));
+
+	return _mm_sub_ps(_mm_mul_ps(vAyzx, vBzxy), _mm_mul_ps(vAzxy, vByzx));
+}
+
+/*
+ * 2x2 blocks of a 4x4 are held one per register as (m00, m01, m10, m11).
+ *
+ * pA * pB
+ */
+static inline __m128 Mat2Mul(__m128 vA, __m128 vB)
+{
+	return _mm_add_ps(_mm_mul_ps(vA, _mm_shuffle_ps(vB, vB, _MM_SHUFFLE(3, 0, 3, 0))),
+			_mm_mul_ps(_mm_shuffle_ps(vA, vA, _MM_SHUFFLE(2, 3, 0, 1)),
+				_mm_shuffle_ps(vB, vB, _MM_SHUFFLE(1, 2, 1, 2))));
+}
+
+/*
+ * adj(pA) * pB
+ */
+static inline __m128 Mat2AdjMul(__m128 vA, __m128 vB)
+{
+	return _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(vA, vA, _MM_SHUFFLE(0, 0, 3, 3)), vB),
+			_mm_mul_ps(_mm_shuffle_ps(vA, vA, _MM_SHUFFLE(2, 2, 1, 1)),
+				_mm_shuffle_ps(vB, vB, _MM_SHUFFLE(1, 0, 3, 2))));
+}
+
+/*
+ * pA * adj(pB)
+ */
+static inline __m128 Mat2MulAdj(__m128 vA, __m128 vB)
+{
+	return _mm_sub_ps(_mm_mul_ps(vA, _mm_shuffle_ps(vB, vB, _MM_SHUFFLE(0, 3, 0, 3))),
+			_mm_mul_ps(_mm_shuffle_ps(vA, vA, _MM_SHUFFLE(2, 3, 0, 1)),
+				_mm_shuffle_ps(vB, vB, _MM_SHUFFLE(1, 2, 1, 2))));
+}
+#endif
+
+/*
+ * pOut = inverse of pM, a general 4x4.  Returns false, leaving pOut
+ * alone, when pM is singular.  pOut may alias pM.
+ */
+static bool MatrixInverse(float *pOut, const float *pM)
+{
+#if VSIMD_LANES > 0
+	/* block-wise: M = |A B|, with the 2x2 inverses folded into adjugates */
+	/*                 |C D|                                            */
+	__m128 vR0 = _mm_loadu_ps(pM + 0);
+	__m128 vR1 = _mm_loadu_ps(pM + 4);
+	__m128 vR2 = _mm_loadu_ps(pM + 8);
+	__m128 vR3 = _mm_loadu_ps(pM + 12);
+	__m128 vA = _mm_movelh_ps(vR0, vR1);
+	__m128 vB = _mm_movehl_ps(vR1, vR0);
+	__m128 vC = _mm_movelh_ps(vR2, vR3);
+	__m128 vD = _mm_movehl_ps(vR3, vR2);
+	__m128 vDetSub, vDetA, vDetB, vDetC, vDetD, vDetM, vTr;
+	__m128 vDC, vAB, vX, vY, vZ, vW;
+	float fDet;
+
+	/* (|A|, |B|, |C|, |D|) */
+	vDetSub = _mm_sub_ps(
+		_mm_mul_ps(_mm_shuffle_ps(vR0, vR2, _MM_SHUFFLE(2, 0, 2, 0)),
+			_mm_shuffle_ps(vR1, vR3, _MM_SHUFFLE(3, 1, 3, 1))),
+		_mm_mul_ps(_mm_shuffle_ps(vR0, vR2, _MM_SHUFFLE(3, 1, 3, 1)),
+			_mm_shuffle_ps(vR1, vR3, _MM_SHUFFLE(2, 0, 2, 0))));
+	vDetA = _mm_shuffle_ps(vDetSub, vDetSub, 0x00);
+	vDetB = _mm_shuffle_ps(vDetSub, vDetSub, 0x55);
+	vDetC = _mm_shuffle_ps(vDetSub, vDetSub, 0xAA);
+	vDetD = _mm_shuffle_ps(vDetSub, vDetSub, 0xFF);
+
+	vDC = Mat2AdjMul(vD, vC);
+	vAB = Mat2AdjMul(vA, vB);
+	vX = _mm_sub_ps(_mm_mul_ps(vDetD, vA), Mat2Mul(vB, vDC));
+	vW = _mm_sub_ps(_mm_mul_ps(vDetA, vD), Mat2Mul(vC, vAB));
+	vY = _mm_sub_ps(_mm_mul_ps(vDetB, vC), Mat2MulAdj(vD, vAB));
+	vZ = _mm_sub_ps(_mm_mul_ps(vDetC, vB), Mat2MulAdj(vA, vDC));
+
+	/* |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C) */
+	vTr = _mm_mul_ps(vAB, _mm_shuffle_ps(vDC, vDC, _MM_SHUFFLE(3, 1, 2, 0)));
+	vTr = _mm_add_ps(vTr, _mm_movehl_ps(vTr, vTr));
+	vTr = _mm_add_ss(vTr, _mm_shuffle_ps(vTr, vTr, 0x55));
+	vDetM = _mm_sub_ss(_mm_add_ss(_mm_mul_ss(vDetA, vDetD), _mm_mul_ss(vDetB, vDetC)), vTr);
+	fDet = _mm_cvtss_f32(vDetM);
+	if (fDet == 0.0f)
+		return false;
+
+	vDetM = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f),
+			_mm_shuffle_ps(vDetM, vDetM, 0x00));
+	vX = _mm_mul_ps(vX, vDetM);
+	vY = _mm_mul_ps(vY, vDetM);
+	vZ = _mm_mul_ps(vZ, vDetM);
+	vW = _mm_mul_ps(vW, vDetM);
+
+	/* adjugate of each block, back into rows */
+	_mm_storeu_ps(pOut + 0, _mm_shuffle_ps(vX, vY, _MM_SHUFFLE(1, 3, 1, 3)));
+	_mm_storeu_ps(pOut + 4, _mm_shuffle_ps(vX, vY, _MM_SHUFFLE(0, 2, 0, 2)));
+	_mm_storeu_ps(pOut + 8, _mm_shuffle_ps(vZ, vW, _MM_SHUFFLE(1, 3, 1, 3)));
+	_mm_storeu_ps(pOut + 12, _mm_shuffle_ps(vZ, vW, _MM_SHUFFLE(0, 2, 0, 2)));
+	return true;
+#else
+	/* 2x2 minors of the top and bottom row pairs */
+	float s0 = pM[0] * pM[5] - pM[4] * pM[1];
+	float s1 = pM[0] * pM[6] - pM[4] * pM[2];
+	float s2 = pM[0] * pM[7] - pM[4] * pM[3];
+	float s3 = pM[1] * pM[6] - pM[5] * pM[2];
+	float s4 = pM[1] * pM[7] - pM[5] * pM[3];
+	float s5 = pM[2] * pM[7] - pM[6] * pM[3];
+	float c5 = pM[10] * pM[15] - pM[14] * pM[11];
+	float c4 = pM[9] * pM[15] - pM[13] * pM[11];
+	float c3 = pM[9] * pM[14] - pM[13] * pM[10];
+	float c2 = pM[8] * pM[15] - pM[12] * pM[11];
+	float c1 = pM[8] * pM[14] - pM[12] * pM[10];
+	float c0 = pM[8] * pM[13] - pM[12] * pM[9];
+	float fDet = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+	float fInv, vR[16];
+	int i;
+
+	if (fDet == 0.0f)
+		return false;
+	fInv = 1.0f / fDet;
+
+	vR[0]  = ( pM[5] * c5 - pM[6] * c4 + pM[7] * c3) * fInv;
+	vR[1]  = (-pM[1] * c5 + pM[2] * c4 - pM[3] * c3) * fInv;
+	vR[2]  = ( pM[13] * s5 - pM[14] * s4 + pM[15] * s3) * fInv;
+	vR[3]  = (-pM[9] * s5 + pM[10] * s4 - pM[11] * s3) * fInv;
+	vR[4]  = (-pM[4] * c5 + pM[6] * c2 - pM[7] * c1) * fInv;
+	vR[5]  = ( pM[0] * c5 - pM[2] * c2 + pM[3] * c1) * fInv;
+	vR[6]  = (-pM[12] * s5 + pM[14] * s2 - pM[15] * s1) * fInv;
+	vR[7]  = ( pM[8] * s5 - pM[10] * s2 + pM[11] * s1) * fInv;
+	vR[8]  = ( pM[4] * c4 - pM[5] * c2 + pM[7] * c0) * fInv;
+	vR[9]  = (-pM[0] * c4 + pM[1] * c2 - pM[3] * c0) * fInv;
+	vR[10] = ( pM[12] * s4 - pM[13] * s2 + pM[15] * s0) * fInv;
+	vR[11] = (-pM[8] * s4 + pM[9] * s2 - pM[11] * s0) * fInv;
+	vR[12] = (-pM[4] * c3 + pM[5] * c1 - pM[6] * c0) * fInv;
+	vR[13] = ( pM[0] * c3 - pM[1] * c1 + pM[2] * c0) * fInv;
+	vR[14] = (-pM[12] * s3 + pM[13] * s1 - pM[14] * s0) * fInv;
+	vR[15] = ( pM[8] * s3 - pM[9] * s1 + pM[10] * s0) * fInv;
+
+	for (i = 0; i < 16; i++)
+		pOut[i] = vR[i];
+	return true;
+#endif
+}
+
+/*
+ * Inverts the top three rows of an affine transform in place: the 3x3
+ * in x, y, z and the column 3 translation in w.  Returns false, leaving
+ * the rows alone, when the 3x3 is singular.
+ */
+#if VSIMD_LANES > 0
+static inline bool InvertAffineRows(__m128 &vR0, __m128 &vR1, __m128 &vR2)
+{
+	__m128 vX0 = Cross3(vR1, vR2);
+	__m128 vX1 = Cross3(vR2, vR0);
+	__m128 vX2 = Cross3(vR0, vR1);
+	__m128 vDot = _mm_mul_ps(vR0, vX0);
+	__m128 vInv, vT;
+	float fDet;
+
+	/* r0 . (r1 x r2); the w lane of vX0 is zero */
+	vDot = _mm_add_ps(vDot, _mm_movehl_ps(vDot, vDot));
+	fDet = _mm_cvtss_f32(_mm_add_ss(vDot, _mm_shuffle_ps(vDot, vDot, 0x55)));
+	if (fDet == 0.0f)
+		return false;
+
+	/* the cofactor rows over the determinant are the inverse's columns */
+	vInv = _mm_set1_ps(1.0f / fDet);
+	vX0 = _mm_mul_ps(vX0, vInv);
+	vX1 = _mm_mul_ps(vX1, vInv);
+	vX2 = _mm_mul_ps(vX2, vInv);
+
+	/* translation: -inv(A) * (m03, m13, m23) */
+	vT = _mm_mul_ps(_mm_shuffle_ps(vR0, vR0, 0xFF), vX0);
+	vT = MAdd4(_mm_shuffle_ps(vR1, vR1, 0xFF), vX1, vT);
+	vT = MAdd4(_mm_shuffle_ps(vR2, vR2, 0xFF), vX2, vT);
+	vT = _mm_sub_ps(_mm_setzero_ps(), vT);
+
+	_MM_TRANSPOSE4_PS(vX0, vX1, vX2, vT);
+	vR0 = vX0;
+	vR1 = vX1;
+	vR2 = vX2;
+	return true;
+}
+#else
+static inline bool InvertAffineRows(float *pOut, const float *pM)
+{
+	float vA[9], vR[12];
+	float fDet, fInv;
+	int i, j;
+
+	vA[0] = pM[5] * pM[10] - pM[6] * pM[9];
+	vA[1] = pM[2] * pM[9] - pM[1] * pM[10];
+	vA[2] = pM[1] * pM[6] - pM[2] * pM[5];
+	vA[3] = pM[6] * pM[8] - pM[4] * pM[10];
+	vA[4] = pM[0] * pM[10] - pM[2] * pM[8];
+	vA[5] = pM[2] * pM[4] - pM[0] * pM[6];
+	vA[6] = pM[4] * pM[9] - pM[5] * pM[8];
+	vA[7] = pM[1] * pM[8] - pM[0] * pM[9];
+	vA[8] = pM[0] * pM[5] - pM[1] * pM[4];
+
+	fDet = pM[0] * vA[0] + pM[1] * vA[3] + pM[2] * vA[6];
+	if (fDet == 0.0f)
+		return false;
+	fInv = 1.0f / fDet;
+
+	for (i = 0; i < 3; i++)
+	{
+		for (j = 0; j < 3; j++)
+			vR[i * 4 + j] = vA[i * 3 + j] * fInv;
+		vR[i * 4 + 3] = -(vR[i * 4 + 0] * pM[3] + vR[i * 4 + 1] * pM[7] +
+						vR[i * 4 + 2] * pM[11]);
+	}
+	for (i = 0; i < 12; i++)
+		pOut[i] = vR[i];
+	return true;
+}
+#endif
+
+/*
+ * pOut = inverse of pM, an affine transform: an invertible 3x3 in the
+ * upper left, m33 = 1, and a translation in either row 3 (row vectors)
+ * or column 3 (column vectors) with the other left zero.  The 3x3 may
+ * scale and shear.  Returns false, leaving pOut alone, when the 3x3 is
+ * singular.  pOut may alias pM.
+ */
+static bool MatrixAffineInverse(float *pOut, const float *pM)
+{
+#if VSIMD_LANES > 0
+	__m128 vR0 = _mm_loadu_ps(pM + 0);
+	__m128 vR1 = _mm_loadu_ps(pM + 4);
+	__m128 vR2 = _mm_loadu_ps(pM + 8);
+	__m128 vR3 = _mm_loadu_ps(pM + 12);
+
+	if (!InvertAffineRows(vR0, vR1, vR2))
+		return false;
+
+	/* row translation: -(m30, m31, m32) * inv(A) */
+	vR3 = _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(vR3, vR3, 0x00), vR0),
+		MAdd4(_mm_shuffle_ps(vR3, vR3, 0x55), vR1,
+			_mm_mul_ps(_mm_shuffle_ps(vR3, vR3, 0xAA), vR2)));
+	vR3 = _mm_sub_ps(_mm_setzero_ps(), vR3);
+	vR3 = _mm_or_ps(_mm_and_ps(vR3, _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0))),
+		_mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f));
+
+	_mm_storeu_ps(pOut + 0, vR0);
+	_mm_storeu_ps(pOut + 4, vR1);
+	_mm_storeu_ps(pOut + 8, vR2);
+	_mm_storeu_ps(pOut + 12, vR3);
+	return true;
+#else
+	float fX = pM[12], fY = pM[13], fZ = pM[14];
+	int j;
+
+	if (!InvertAffineRows(pOut, pM))
+		return false;
+
+	/* row translation: -(m30, m31, m32) * inv(A) */
+	for (j = 0; j < 3; j++)
+		pOut[12 + j] = -(fX * pOut[0 + j] + fY * pOut[4 + j] + fZ * pOut[8 + j]);
+	pOut[15] = 1.0f;
+	return true;
+#endif
+}
+
+/*
+ * pOut = transpose of pM.  pOut may alias pM.
+ */
+static void MatrixTranspose(float *pOut, const float *pM)
+{
+#if VSIMD_LANES > 0
+	__m128 vR0 = _mm_loadu_ps(pM + 0);
+	__m128 vR1 = _mm_loadu_ps(pM + 4);
+	__m128 vR2 = _mm_loadu_ps(pM + 8);
+	__m128 vR3 = _mm_loadu_ps(pM + 12);
+
+	_MM_TRANSPOSE4_PS(vR0, vR1, vR2, vR3);
+	_mm_storeu_ps(pOut + 0, vR0);
+	_mm_storeu_ps(pOut + 4, vR1);
+	_mm_storeu_ps(pOut + 8, vR2);
+	_mm_storeu_ps(pOut + 12, vR3);
+#else
+	float vR[16];
+	int i, j;
+
+	for (i = 0; i < 4; i++)
+	{
+		for (j = 0; j < 4; j++)
+			vR[j * 4 + i] = pM[i * 4 + j];
+	}
+	for (i = 0; i < 16; i++)
+		pOut[i] = vR[i];
+#endif
+}
+
+/*
+ * Row vectors (x, y, z, 1) * pM for an array of 4 float vectors, with
+ * the w of the result left as is (no perspective divide).  pOut may
+ * alias pIn.
+ */
+static void TransformPoints(float *pOut, const float *pIn, const float *pM, VUINT nCount)
+{
+	VUINT i = 0;
+
+#if VSIMD_LANES == 8
+	/* two vectors per register */
+	__m256 vM0 = _mm256_broadcast_ps((const __m128*)(pM + 0));
+	__m256 vM1 = _mm256_broadcast_ps((const __m128*)(pM + 4));
+	__m256 vM2 = _mm256_broadcast_ps((const __m128*)(pM + 8));
+	__m256 vM3 = _mm256_broadcast_ps((const __m128*)(pM + 12));
+
+	for (; i + 2 <= nCount; i += 2)
+	{
+		__m256 vV = _mm256_loadu_ps(pIn + i * 4);
+		__m256 vR = VMADD(_mm256_permute_ps(vV, 0x00), vM0, vM3);
+		vR = VMADD(_mm256_permute_ps(vV, 0x55), vM1, vR);
+		vR = VMADD(_mm256_permute_ps(vV, 0xAA), vM2, vR);
+		_mm256_storeu_ps(pOut + i * 4, vR);
+	}
+#endif
+#if VSIMD_LANES > 0
+	__m128 vR0 = _mm_loadu_ps(pM + 0);
+	__m128 vR1 = _mm_loadu_ps(pM + 4);
+	__m128 vR2 = _mm_loadu_ps(pM + 8);
+	__m128 vR3 = _mm_loadu_ps(pM + 12);
+
+	for (; i < nCount; i++)
+	{
+		__m128 vV = _mm_loadu_ps(pIn + i * 4);
+		__m128 vR = MAdd4(_mm_shuffle_ps(vV, vV, 0x00), vR0, vR3);
+		vR = MAdd4(_mm_shuffle_ps(vV, vV, 0x55), vR1, vR);
+		vR = MAdd4(_mm_shuffle_ps(vV, vV, 0xAA), vR2, vR);
+		_mm_storeu_ps(pOut + i * 4, vR);
+	}
+#else
+	for (; i < nCount; i++)
+	{
+		float fX = pIn[i * 4 + 0], fY = pIn[i * 4 + 1], fZ = pIn[i * 4 + 2];
+		int j;
+
+		for (j = 0; j < 4; j++)
+			pOut[i * 4 + j] = fX * pM[j] + fY * pM[4 + j] + fZ * pM[8 + j] + pM[12 + j];
+	}
+#endif
+}
+
+/*
+ * Row vectors (x, y, z, 0) * pM for an array of 4 float vectors; the
+ * translation row is ignored.  pOut may alias pIn.
+ */
+static void TransformDirections(float *pOut, const float *pIn, const float *pM, VUINT nCount)
+{
+	VUINT i = 0;
+
+#if VSIMD_LANES == 8
+	__m256 vM0 = _mm256_broadcast_ps((const __m128*)(pM + 0));
+	__m256 vM1 = _mm256_broadcast_ps((const __m128*)(pM + 4));
+	__m256 vM2 = _mm256_broadcast_ps((const __m128*)(pM + 8));
+
+	for (; i + 2 <= nCount; i += 2)
+	{
+		__m256 vV = _mm256_loadu_ps(pIn + i * 4);
+		__m256 vR = VMUL(_mm256_permute_ps(vV, 0x00), vM0);
+		vR = VMADD(_mm256_permute_ps(vV, 0x55), vM1, vR);
+		vR = VMADD(_mm256_permute_ps(vV, 0xAA), vM2, vR);
+		_mm256_storeu_ps(pOut + i * 4, vR);
+	}
+#endif
+#if VSIMD_LANES > 0
+	__m128 vR0 = _mm_loadu_ps(pM + 0);
+	__m128 vR1 = _mm_loadu_ps(pM + 4);
+	__m128 vR2 = _mm_loadu_ps(pM + 8);
+
+	for (; i < nCount; i++)
+	{
+		__m128 vV = _mm_loadu_ps(pIn + i * 4);
+		__m128 vR = _mm_mul_ps(_mm_shuffle_ps(vV, vV, 0x00), vR0);
+		vR = MAdd4(_mm_shuffle_ps(vV, vV, 0x55), vR1, vR);
+		vR = MAdd4(_mm_shuffle_ps(vV, vV, 0xAA), vR2, vR);
+		_mm_storeu_ps(pOut + i * 4, vR);
+	}
+#else
+	for (; i < nCount; i++)
+	{
+		float fX = pIn[i * 4 + 0], fY = pIn[i * 4 + 1], fZ = pIn[i * 4 + 2];
+		int j;
+
+		for (j = 0; j < 4; j++)
+			pOut[i * 4 + j] = fX * pM[j] + fY * pM[4 + j] + fZ * pM[8 + j];
+	}
+#endif
+}
+
+/*
+ * Affine transforms below are 12 floats: the top three rows of a 4x4
+ * for column vectors, with the translation in column 3 and an implied
+ * (0, 0, 0, 1) bottom row.
+ *
+ * pOut = pA * pB.  pOut may alias either operand.
+ */
+static void AffineMultiply(float *pOut, const float *pA, const float *pB)
+{
+#if VSIMD_LANES == 8
+	/* rows 0 and 1 share a register */
+	__m256 vB0 = _mm256_broadcast_ps((const __m128*)(pB + 0));
+	__m256 vB1 = _mm256_broadcast_ps((const __m128*)(pB + 4));
+	__m256 vB2 = _mm256_broadcast_ps((const __m128*)(pB + 8));
+	__m256 vA01 = _mm256_loadu_ps(pA);
+	__m128 vA2 = _mm_loadu_ps(pA + 8);
+	__m256 vR01;
+	__m128 vR2;
+
+	vR01 = _mm256_and_ps(vA01, _mm256_castsi256_ps(_mm256_setr_epi32(0, 0, 0, -1, 0, 0, 0, -1)));
+	vR01 = VMADD(_mm256_permute_ps(vA01, 0x00), vB0, vR01);
+	vR01 = VMADD(_mm256_permute_ps(vA01, 0x55), vB1, vR01);
+	vR01 = VMADD(_mm256_permute_ps(vA01, 0xAA), vB2, vR01);
+	vR2 = _mm_and_ps(vA2, _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1)));
+	vR2 = MAdd4(_mm_shuffle_ps(vA2, vA2, 0x00), _mm256_castps256_ps128(vB0), vR2);
+	vR2 = MAdd4(_mm_shuffle_ps(vA2, vA2, 0x55), _mm256_castps256_ps128(vB1), vR2);
+	vR2 = MAdd4(_mm_shuffle_ps(vA2, vA2, 0xAA), _mm256_castps256_ps128(vB2), vR2);
+	_mm256_storeu_ps(pOut, vR01);
+	_mm_storeu_ps(pOut + 8, vR2);
+#elif VSIMD_LANES == 4
+	__m128 vB0 = _mm_loadu_ps(pB + 0);
+	__m128 vB1 = _mm_loadu_ps(pB + 4);
+	__m128 vB2 = _mm_loadu_ps(pB + 8);
+	__m128 vW = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+	__m128 vA[3], vR;
+	int i;
+
+	for (i = 0; i < 3; i++)
+		vA[i] = _mm_loadu_ps(pA + i * 4);
+
+	/* the implied bottom row of pB only carries pA's translation over */
+	for (i = 0; i < 3; i++)
+	{
+		vR = _mm_and_ps(vA[i], vW);
+		vR = MAdd4(_mm_shuffle_ps(vA[i], vA[i], 0x00), vB0, vR);
+		vR = MAdd4(_mm_shuffle_ps(vA[i], vA[i], 0x55), vB1, vR);
+		vR = MAdd4(_mm_shuffle_ps(vA[i], vA[i], 0xAA), vB2, vR);
+		_mm_storeu_ps(pOut + i * 4, vR);
+	}
+#else
+	float vR[12];
+	int i, j;
+
+	for (i = 0; i < 3; i++)
+	{
+		for (j = 0; j < 4; j++)
+		{
+			vR[i * 4 + j] = pA[i * 4 + 0] * pB[0 * 4 + j] +
+							pA[i * 4 + 1] * pB[1 * 4 + j] +
+							pA[i * 4 + 2] * pB[2 * 4 + j];
+		}
+		vR[i * 4 + 3] += pA[i * 4 + 3];
+	}
+	for (i = 0; i < 12; i++)
+		pOut[i] = vR[i];
+#endif
+}
+
+/*
+ * pOut = inverse of pM, any invertible affine.  Returns false, leaving
+ * pOut alone, when pM is singular.  pOut may alias pM.
+ */
+static bool AffineInverse(float *pOut, const float *pM)
+{
+#if VSIMD_LANES > 0
+	__m128 vR0 = _mm_loadu_ps(pM + 0);
+	__m128 vR1 = _mm_loadu_ps(pM + 4);
+	__m128 vR2 = _mm_loadu_ps(pM + 8);
+
+	if (!InvertAffineRows(vR0, vR1, vR2))
+		return false;
+	_mm_storeu_ps(pOut + 0, vR0);
+	_mm_storeu_ps(pOut + 4, vR1);
+	_mm_storeu_ps(pOut + 8, vR2);
+	return true;
+#else
+	return InvertAffineRows(pOut, pM);
+#endif
+}
+
+/*
+ * pOut = inverse of pM, whose 3x3 is a rotation times a uniform scale s:
+ * the transpose over s squared, and the translation turned back through
+ * it.  Returns false, leaving pOut alone, when s is zero.  pOut may
+ * alias pM.
+ */
+static bool AffineOrthoInverse(float *pOut, const float *pM)
+{
+#if VSIMD_LANES > 0
+	__m128 vR0 = _mm_loadu_ps(pM + 0);
+	__m128 vR1 = _mm_loadu_ps(pM + 4);
+	__m128 vR2 = _mm_loadu_ps(pM + 8);
+	float fScale = _mm_cvtss_f32(SquaredLength3(vR0));
+	__m128 vT, vInv;
+
+	if (fScale == 0.0f)
+		return false;
+	vInv = _mm_set1_ps(1.0f / fScale);
+
+	/* -transpose(A) * t, in x, y and z */
+	vT = _mm_mul_ps(_mm_shuffle_ps(vR0, vR0, 0xFF), vR0);
+	vT = MAdd4(_mm_shuffle_ps(vR1, vR1, 0xFF), vR1, vT);
+	vT = MAdd4(_mm_shuffle_ps(vR2, vR2, 0xFF), vR2, vT);
+	vT = _mm_sub_ps(_mm_setzero_ps(), vT);
+
+	_MM_TRANSPOSE4_PS(vR0, vR1, vR2, vT);
+	_mm_storeu_ps(pOut + 0, _mm_mul_ps(vR0, vInv));
+	_mm_storeu_ps(pOut + 4, _mm_mul_ps(vR1, vInv));
+	_mm_storeu_ps(pOut + 8, _mm_mul_ps(vR2, vInv));
+	return true;
+#else
+	float fScale = pM[0] * pM[0] + pM[1] * pM[1] + pM[2] * pM[2];
+	float fInv, vR[12];
+	int i, j;
+
+	if (fScale == 0.0f)
+		return false;
+	fInv = 1.0f / fScale;
+
+	for (i = 0; i < 3; i++)
+	{
+		for (j = 0; j < 3; j++)
+			vR[i * 4 + j] = pM[j * 4 + i] * fInv;
+		vR[i * 4 + 3] = -(vR[i * 4 + 0] * pM[3] + vR[i * 4 + 1] * pM[7] +
+						vR[i * 4 + 2] * pM[11]);
+	}
+	for (i = 0; i < 12; i++)
+		pOut[i] = vR[i];
+	return true;
+#endif
+}
+
+/********************************************************************
+ *                S T R U C T U R E   O F   A R R A Y S             *
+ ********************************************************************/
+
+static void BatchAdd(VSoA vOut, VSoA vA, VSoA vB, VUINT nCount)
+{
+	VUINT i = 0;
+
+#if VSIMD_LANES > 0
+	for (; i < SimdCount(nCount); i += VSIMD_LANES)
+	{
+		VSTORE(vOut.x + i, VADD(VLOAD(vA.x + i), VLOAD(vB.x + i)));
+		VSTORE(vOut.y + i, VADD(VLOAD(vA.y + i), VLOAD(vB.y + i)));
+		VSTORE(vOut.z + i, VADD(VLOAD(vA.z + i), VLOAD(vB.z + i)));
+	}
+#endif
+	for (; i < nCount; i++)
+	{
+		vOut.x[i] = vA.x[i] + vB.x[i];
+		vOut.y[i] = vA.y[i] + vB.y[i];
+		vOut.z[i] = vA.z[i] + vB.z[i];
+	}
+}
+
+static void BatchScale(VSoA vOut, float fScale, VUINT nCount)
+{
+	VUINT i = 0;
+
+#if VSIMD_LANES > 0
+	vreg vS = VSET1(fScale);
+	for (; i < SimdCount(nCount); i += VSIMD_LANES)
+	{
+		VSTORE(vOut.x + i, VMUL(VLOAD(vOut.x + i), vS));
+		VSTORE(vOut.y + i, VMUL(VLOAD(vOut.y + i), vS));
+		VSTORE(vOut.z + i, VMUL(VLOAD(vOut.z + i), vS));
+	}
+#endif
+	for (; i < nCount; i++)
+	{
+		vOut.x[i] *= fScale;
+		vOut.y[i] *= fScale;
+		vOut.z[i] *= fScale;
+	}
+}
+
+static void BatchCross(VSoA vOut, VSoA vA, VSoA vB, VUINT nCount)
+{
+	VUINT i = 0;
+	float fX, fY, fZ;
+
+#if VSIMD_LANES > 0
+	for (; i < SimdCount(nCount); i += VSIMD_LANES)
+	{
+		vreg vX1 = VLOAD(vA.x + i), vY1 = VLOAD(vA.y + i), vZ1 = VLOAD(vA.z + i);
+		vreg vX2 = VLOAD(vB.x + i), vY2 = VLOAD(vB.y + i), vZ2 = VLOAD(vB.z + i);
+
+		VSTORE(vOut.x + i, VMSUB(vY1, vZ2, VMUL(vZ1, vY2)));
+		VSTORE(vOut.y + i, VMSUB(vZ1, vX2, VMUL(vX1, vZ2)));
+		VSTORE(vOut.z + i, VMSUB(vX1, vY2, VMUL(vY1, vX2)));
+	}
+#endif
+	for (; i < nCount; i++)
+	{
+		fX = vA.y[i] * vB.z[i] - vA.z[i] * vB.y[i];
+		fY = vA.z[i] * vB.x[i] - vA.x[i] * vB.z[i];
+		fZ = vA.x[i] * vB.y[i] - vA.y[i] * vB.x[i];
+		vOut.x[i] = fX;
+		vOut.y[i] = fY;
+		vOut.z[i] = fZ;
+	}
+}
+
+static void BatchDot(float *pOut, VSoA vA, VSoA vB, VUINT nCount)
+{
+	VUINT i = 0;
+
+#if VSIMD_LANES > 0
+	for (; i < SimdCount(nCount); i += VSIMD_LANES)
+	{
+		vreg vD = VMUL(VLOAD(vA.x + i), VLOAD(vB.x + i));
+		vD = VMADD(VLOAD(vA.y + i), VLOAD(vB.y + i), vD);
+		vD = VMADD(VLOAD(vA.z + i), VLOAD(vB.z + i), vD);
+		VSTOREU(pOut + i, vD);
+	}
+#endif
+	for (; i < nCount; i++)
+		pOut[i] = vA.x[i] * vB.x[i] + vA.y[i] * vB.y[i] + vA.z[i] * vB.z[i];
+}
+
+static void BatchLength(float *pOut, VSoA vA, VUINT nCount)
+{
+	VUINT i = 0;
+
+#if VSIMD_LANES > 0
+	for (; i < SimdCount(nCount); i += VSIMD_LANES)
+	{
+		vreg vX = VLOAD(vA.x + i), vY = VLOAD(vA.y + i), vZ = VLOAD(vA.z + i);
+		vreg vL = VMADD(vZ, vZ, VMADD(vY, vY, VMUL(vX, vX)));
+		VSTOREU(pOut + i, VSQRT(vL));
+	}
+#endif
+	for (; i < nCount; i++)
+		pOut[i] = sqrtf(vA.x[i] * vA.x[i] + vA.y[i] * vA.y[i] + vA.z[i] * vA.z[i]);
+}
+
+static void BatchNormalize(VSoA vOut, VUINT nCount)
+{
+	VUINT i = 0;
+	float fLength;
+
+#if VSIMD_LANES > 0
+	vreg vZero = VZERO();
+	for (; i < SimdCount(nCount); i += VSIMD_LANES)
+	{
+		vreg vX = VLOAD(vOut.x + i), vY = VLOAD(vOut.y + i), vZ = VLOAD(vOut.z + i);
+		vreg vL = VSQRT(VMADD(vZ, vZ, VMADD(vY, vY, VMUL(vX, vX))));
+		vreg vMask = VCMPNEQ(vL, vZero);
+
+		VSTORE(vOut.x + i, VSELECT(vMask, VDIV(vX, vL), vX));
+		VSTORE(vOut.y + i, VSELECT(vMask, VDIV(vY, vL), vY));
+		VSTORE(vOut.z + i, VSELECT(vMask, VDIV(vZ, vL), vZ));
+	}
+#endif
+	for (; i < nCount; i++)
+	{
+		fLength = sqrtf(vOut.x[i] * vOut.x[i] + vOut.y[i] * vOut.y[i] +
+						vOut.z[i] * vOut.z[i]);
+		if (fLength != 0.0f)
+		{
+			vOut.x[i] /= fLength;
+			vOut.y[i] /= fLength;
+			vOut.z[i] /= fLength;
+		}
+	}
+}
+
+/*
+ * Row-vector convention: p' = p * M, translation in row 3.
+ */
+static void BatchTransformPoints(VSoA vOut, const float *pM, VUINT nCount)
+{
+	VUINT i = 0;
+	float fX, fY, fZ;
+
+#if VSIMD_LANES > 0
+	vreg v00 = VSET1(pM[0]), v01 = VSET1(pM[1]), v02 = VSET1(pM[2]);
+	vreg v10 = VSET1(pM[4]), v11 = VSET1(pM[5]), v12 = VSET1(pM[6]);
+	vreg v20 = VSET1(pM[8]), v21 = VSET1(pM[9]), v22 = VSET1(pM[10]);
+	vreg v30 = VSET1(pM[12]), v31 = VSET1(pM[13]), v32 = VSET1(pM[14]);
+	for (; i < SimdCount(nCount); i += VSIMD_LANES)
+	{
+		vreg vX = VLOAD(vOut.x + i), vY = VLOAD(vOut.y + i), vZ = VLOAD(vOut.z + i);
+
+		VSTORE(vOut.x + i, VMADD(vX, v00, VMADD(vY, v10, VMADD(vZ, v20, v30))));
+		VSTORE(vOut.y + i, VMADD(vX, v01, VMADD(vY, v11, VMADD(vZ, v21, v31))));
+		VSTORE(vOut.z + i, VMADD(vX, v02, VMADD(vY, v12, VMADD(vZ, v22, v32))));
+	}
+#endif
+	for (; i < nCount; i++)
+	{
+		fX = vOut.x[i] * pM[0] + vOut.y[i] * pM[4] + vOut.z[i] * pM[8] + pM[12];
+		fY = vOut.x[i] * pM[1] + vOut.y[i] * pM[5] + vOut.z[i] * pM[9] + pM[13];
+		fZ = vOut.x[i] * pM[2] + vOut.y[i] * pM[6] + vOut.z[i] * pM[10] + pM[14];
+		vOut.x[i] = fX;
+		vOut.y[i] = fY;
+		vOut.z[i] = fZ;
+	}
+}
+
+static void BatchTransformDirections(VSoA vOut, const float *pM, VUINT nCount)
+{
+	VUINT i = 0;
+	float fX, fY, fZ;
+
+#if VSIMD_LANES > 0
+	vreg v00 = VSET1(pM[0]), v01 = VSET1(pM[1]), v02 = VSET1(pM[2]);
+	vreg v10 = VSET1(pM[4]), v11 = VSET1(pM[5]), v12 = VSET1(pM[6]);
+	vreg v20 = VSET1(pM[8]), v21 = VSET1(pM[9]), v22 = VSET1(pM[10]);
+	for (; i < SimdCount(nCount); i += VSIMD_LANES)
+	{
+		vreg vX = VLOAD(vOut.x + i), vY = VLOAD(vOut.y + i), vZ = VLOAD(vOut.z + i);
+
+		VSTORE(vOut.x + i, VMADD(vX, v00, VMADD(vY, v10, VMUL(vZ, v20))));
+		VSTORE(vOut.y + i, VMADD(vX, v01, VMADD(vY, v11, VMUL(vZ, v21))));
+		VSTORE(vOut.z + i, VMADD(vX, v02, VMADD(vY, v12, VMUL(vZ, v22))));
+	}
+#endif
+	for (; i < nCount; i++)
+	{
+		fX = vOut.x[i] * pM[0] + vOut.y[i] * pM[4] + vOut.z[i] * pM[8];
+		fY = vOut.x[i] * pM[1] + vOut.y[i] * pM[5] + vOut.z[i] * pM[9];
+		fZ = vOut.x[i] * pM[2] + vOut.y[i] * pM[6] + vOut.z[i] * pM[10];
+		vOut.x[i] = fX;
+		vOut.y[i] = fY;
+		vOut.z[i] = fZ;
+	}
+}
+
+/*
+ * Classifies boxes against planes exactly like VAabb::Cull(): a box is
+ * culled if its nearest corner is in front of any plane, clipped if its
+ * farthest corner is on or in front of one.  The near/far corner arrays
+ * are chosen once per plane from the sign of the normal, so the inner
+ * loop never branches per box.  Operations are done in the same order
+ * as the scalar code (and never fused) so results match it bit for bit.
+ *
+ * pVisible receives a 1 for every box not culled, pClipped (optional) a
+ * 1 for every visible box that straddles a plane.
+ */
+static void BatchCullAabb(VSoA vMin, VSoA vMax, const float *pPlanes,
+							int nNumPlanes, VUINT nCount, VUINT *pVisible,
+							VUINT *pClipped)
+{
+	const float	*vNear[VSIMD_MAX_PLANES][3];
+	const float	*vFar[VSIMD_MAX_PLANES][3];
+	VUINT		vWords = (nCount + 31) >> 5;
+	VUINT		vCull, vClip;
+	VUINT		i = 0;
+	int			p;
+	float		fNear, fFar;
+
+	if (nNumPlanes > VSIMD_MAX_PLANES)
+		nNumPlanes = VSIMD_MAX_PLANES;
+
+	for (p = 0; p < nNumPlanes; p++)
+	{
+		const float *vN = pPlanes + p * 4;
+		vNear[p][0] = (vN[0] >= 0.0f ? vMin.x : vMax.x);
+		vNear[p][1] = (vN[1] >= 0.0f ? vMin.y : vMax.y);
+		vNear[p][2] = (vN[2] >= 0.0f ? vMin.z : vMax.z);
+		vFar[p][0]	= (vN[0] >= 0.0f ? vMax.x : vMin.x);
+		vFar[p][1]	= (vN[1] >= 0.0f ? vMax.y : vMin.y);
+		vFar[p][2]	= (vN[2] >= 0.0f ? vMax.z : vMin.z);
+	}
+
+	for (i = 0; i < vWords; i++)
+	{
+		pVisible[i] = 0;
+		if (pClipped)
+			pClipped[i] = 0;
+	}
+	i = 0;
+
+#if VSIMD_LANES > 0
+	vreg vPlane[VSIMD_MAX_PLANES][4];
+	vreg vZero = VZERO();
+	const VUINT vAll = (1u << VSIMD_LANES) - 1;
+
+	for (p = 0; p < nNumPlanes; p++)
+	{
+		vPlane[p][0] = VSET1(pPlanes[p * 4 + 0]);
+		vPlane[p][1] = VSET1(pPlanes[p * 4 + 1]);
+		vPlane[p][2] = VSET1(pPlanes[p * 4 + 2]);
+		vPlane[p][3] = VSET1(pPlanes[p * 4 + 3]);
+	}
+
+	for (; i < SimdCount(nCount); i += VSIMD_LANES)
+	{
+		vreg vCullMask = vZero;
+		vreg vClipMask = vZero;
+		vreg vD;
+
+		for (p = 0; p < nNumPlanes; p++)
+		{
+			vD = VADD(VMUL(VLOAD(vNear[p][0] + i), vPlane[p][0]),
+					  VMUL(VLOAD(vNear[p][1] + i), vPlane[p][1]));
+			vD = VADD(vD, VMUL(VLOAD(vNear[p][2] + i), vPlane[p][2]));
+			vD = VADD(vD, vPlane[p][3]);
+			vCullMask = VOR(vCullMask, VCMPGT(vD, vZero));
+
+			vD = VADD(VMUL(VLOAD(vFar[p][0] + i), vPlane[p][0]),
+					  VMUL(VLOAD(vFar[p][1] + i), vPlane[p][1]));
+			vD = VADD(vD, VMUL(VLOAD(vFar[p][2] + i), vPlane[p][2]));
+			vD = VADD(vD, vPlane[p][3]);
+			vClipMask = VOR(vClipMask, VCMPGE(vD, vZero));
+
+			/* every box in this register is out, skip the other planes */
+			if (VMOVEMASK(vCullMask) == vAll)
+				break;
+		}
+
+		vCull = VMOVEMASK(vCullMask);
+		vClip = VMOVEMASK(vClipMask) & ~vCull;
+		pVisible[i >> 5] |= (~vCull & vAll) << (i & 31);
+		if (pClipped)
+			pClipped[i >> 5] |= vClip << (i & 31);
+	}
+#endif
+	for (; i < nCount; i++)
+	{
+		vCull = vClip = 0;
+		for (p = 0; p < nNumPlanes; p++)
+		{
+			const float *vN = pPlanes + p * 4;
+
+			fNear = vNear[p][0][i] * vN[0] + vNear[p][1][i] * vN[1] +
+					vNear[p][2][i] * vN[2];
+			if (fNear + vN[3] > 0.0f)
+			{
+				vCull = 1;
+				break;
+			}
+			fFar = vFar[p][0][i] * vN[0] + vFar[p][1][i] * vN[1] +
+					vFar[p][2][i] * vN[2];
+			if (fFar + vN[3] >= 0.0f)
+				vClip = 1;
+		}
+		if (!vCull)
+		{
+			pVisible[i >> 5] |= 1u << (i & 31);
+			if (pClipped && vClip)
+				pClipped[i >> 5] |= 1u << (i & 31);
+		}
+	}
+}
+
+/*
+ * One ray against a batch of boxes.  pInv holds 1/direction; its signs
+ * pick, once for the whole batch, which of min and max each slab is
+ * entered through, leaving a subtract, a multiply and a min or max per
+ * slab.  A box is hit if the ray enters it somewhere in [0, fL].
+ */
+static void BatchRayAabb(const float *pOrig, const float *pInv, VSoA vMin,
+							VSoA vMax, float fL, VUINT nCount, VUINT *pHits,
+							float *pEnter)
+{
+	const float	*vNear[3];
+	const float	*vFar[3];
+	VUINT		vWords = (nCount + 31) >> 5;
+	VUINT		i = 0;
+	int			a;
+	float		fNear, fFar, t0, t1;
+
+	vNear[0] = (pInv[0] >= 0.0f ? vMin.x : vMax.x);
+	vNear[1] = (pInv[1] >= 0.0f ? vMin.y : vMax.y);
+	vNear[2] = (pInv[2] >= 0.0f ? vMin.z : vMax.z);
+	vFar[0]	= (pInv[0] >= 0.0f ? vMax.x : vMin.x);
+	vFar[1]	= (pInv[1] >= 0.0f ? vMax.y : vMin.y);
+	vFar[2]	= (pInv[2] >= 0.0f ? vMax.z : vMin.z);
+
+	for (i = 0; i < vWords; i++)
+		pHits[i] = 0;
+	i = 0;
+
+#if VSIMD_LANES > 0
+	const vreg vOX = VSET1(pOrig[0]), vOY = VSET1(pOrig[1]), vOZ = VSET1(pOrig[2]);
+	const vreg vIX = VSET1(pInv[0]), vIY = VSET1(pInv[1]), vIZ = VSET1(pInv[2]);
+	const vreg vL = VSET1(fL);
+	vreg vN, vF;
+
+	for (; i < SimdCount(nCount); i += VSIMD_LANES)
+	{
+		vN = VMUL(VSUB(VLOAD(vNear[0] + i), vOX), vIX);
+		vF = VMUL(VSUB(VLOAD(vFar[0] + i), vOX), vIX);
+		vN = VMAX(vN, VMUL(VSUB(VLOAD(vNear[1] + i), vOY), vIY));
+		vF = VMIN(vF, VMUL(VSUB(VLOAD(vFar[1] + i), vOY), vIY));
+		vN = VMAX(vN, VMUL(VSUB(VLOAD(vNear[2] + i), vOZ), vIZ));
+		vF = VMIN(vF, VMUL(VSUB(VLOAD(vFar[2] + i), vOZ), vIZ));
+		vN = VMAX(vN, VZERO());
+		vF = VMIN(vF, vL);
+		pHits[i >> 5] |= VMOVEMASK(VCMPGE(vF, vN)) << (i & 31);
+		if (pEnter)
+			VSTOREU(pEnter + i, vN);
+	}
+#endif
+	for (; i < nCount; i++)
+	{
+		fNear = 0.0f;
+		fFar = fL;
+		for (a = 0; a < 3; a++)
+		{
+			t0 = (vNear[a][i] - pOrig[a]) * pInv[a];
+			t1 = (vFar[a][i] - pOrig[a]) * pInv[a];
+			fNear = t0 > fNear ? t0 : fNear;
+			fFar = t1 < fFar ? t1 : fFar;
+		}
+		if (fNear <= fFar)
+			pHits[i >> 5] |= 1u << (i & 31);
+		if (pEnter)
+			pEnter[i] = fNear;
+	}
+}
+
+/********************************************************************
+ *                  S E P A R A T I N G   A X E S                   *
+ ********************************************************************/
+
+/*
+ * The OBB kernels test box i of one batch against box (or triangle) i
+ * of the other, with the arithmetic of VObb::Intersects() step for
+ * step, so the batch and the single tests agree on every pair.  A box
+ * is 15 values: the centre, the three axes, then the half lengths.
+ */
+static inline float SatDot(const float *pA, const float *pB)
+{
+	return pA[0] * pB[0] + pA[1] * pB[1] + pA[2] * pB[2];
+}
+
+static inline void SatCross(float *pOut, const float *pA, const float *pB)
+{
+	pOut[0] = pA[1] * pB[2] - pA[2] * pB[1];
+	pOut[1] = pA[2] * pB[0] - pA[0] * pB[2];
+	pOut[2] = pA[0] * pB[1] - pA[1] * pB[0];
+}
+
+static inline void GatherObb(VSoAObb vObb, VUINT i, float *pOut)
+{
+	const VSoA vPart[5] = { vObb.c, vObb.a0, vObb.a1, vObb.a2, vObb.e };
+
+	for (int k = 0; k < 5; k++)
+	{
+		pOut[k * 3 + 0] = vPart[k].x[i];
+		pOut[k * 3 + 1] = vPart[k].y[i];
+		pOut[k * 3 + 2] = vPart[k].z[i];
+	}
+}
+
+/*
+ * 15 axis test of two boxes.  The rotation of B into A's frame and its
+ * absolute values are worked out once; the absolute values are padded
+ * by VSIMD_SAT_EPSILON so that the cross product of two nearly
+ * parallel edges can't become a separating axis through rounding.
+ */
+static bool SatObbObb(const float *pA, const float *pB)
+{
+	const float	*vEa = pA + 12;
+	const float	*vEb = pB + 12;
+	float		R[3][3], vAbs[3][3], T[3], vD[3];
+	float		ra, rb, t;
+	int			r, c, i1, i2, j1, j2;
+
+	for (r = 0; r < 3; r++)
+	{
+		for (c = 0; c < 3; c++)
+		{
+			R[r][c] = SatDot(pA + 3 + r * 3, pB + 3 + c * 3);
+			vAbs[r][c] = fabsf(R[r][c]) + VSIMD_SAT_EPSILON;
+		}
+		vD[r] = pB[r] - pA[r];
+	}
+	for (r = 0; r < 3; r++)
+		T[r] = SatDot(vD, pA + 3 + r * 3);
+
+	for (r = 0; r < 3; r++)
+	{
+		rb = vEb[0] * vAbs[r][0] + vEb[1] * vAbs[r][1] + vEb[2] * vAbs[r][2];
+		if (fabsf(T[r]) > vEa[r] + rb)
+			return false;
+	}
+	for (c = 0; c < 3; c++)
+	{
+		ra = vEa[0] * vAbs[0][c] + vEa[1] * vAbs[1][c] + vEa[2] * vAbs[2][c];
+		t = fabsf(T[0] * R[0][c] + T[1] * R[1][c] + T[2] * R[2][c]);
+		if (t > ra + vEb[c])
+			return false;
+	}
+	for (r = 0; r < 3; r++)
+	{
+		i1 = (r + 1) % 3;
+		i2 = (r + 2) % 3;
+		for (c = 0; c < 3; c++)
+		{
+			j1 = (c + 1) % 3;
+			j2 = (c + 2) % 3;
+			ra = vEa[i1] * vAbs[i2][c] + vEa[i2] * vAbs[i1][c];
+			rb = vEb[j1] * vAbs[r][j2] + vEb[j2] * vAbs[r][j1];
+			t = fabsf(T[i2] * R[i1][c] - T[i1] * R[i2][c]);
+			if (t > ra + rb)
+				return false;
+		}
+	}
+	return true;
+}
+
+/*
+ * Projection of a box onto an axis, as a centre and a radius.
+ */
+static inline void SatBoxRange(const float *pBox, const float *pV, float *pD,
+								float *pR)
+{
+	*pD = SatDot(pV, pBox);
+	*pR = pBox[12] * fabsf(SatDot(pV, pBox + 3)) +
+		  pBox[13] * fabsf(SatDot(pV, pBox + 6)) +
+		  pBox[14] * fabsf(SatDot(pV, pBox + 9));
+}
+
+static inline void SatTriRange(const float *pTri, const float *pV, float *pMin,
+								float *pMax)
+{
+	float fP1 = SatDot(pV, pTri + 3);
+	float fP2 = SatDot(pV, pTri + 6);
+
+	*pMin = *pMax = SatDot(pV, pTri);
+	*pMin = fP1 < *pMin ? fP1 : *pMin;
+	*pMax = fP1 > *pMax ? fP1 : *pMax;
+	*pMin = fP2 < *pMin ? fP2 : *pMin;
+	*pMax = fP2 > *pMax ? fP2 : *pMax;
+}
+
+/*
+ * 13 axis test of a box against a triangle (its three corners): the
+ * triangle's normal, the box's axes, and each triangle edge crossed
+ * with each box axis.  Axes too short to trust are skipped.
+ */
+static bool SatObbTriangle(const float *pBox, const float *pTri)
+{
+	float	vE[9], vV[3];
+	float	fMin0, fMax0, fD, fR;
+	int		j, k;
+
+	for (k = 0; k < 3; k++)
+	{
+		vE[k] = pTri[3 + k] - pTri[k];
+		vE[3 + k] = pTri[6 + k] - pTri[k];
+	}
+	for (k = 0; k < 3; k++)
+		vE[6 + k] = vE[3 + k] - vE[k];
+
+	SatCross(vV, vE, vE + 3);
+	fMin0 = SatDot(vV, pTri);
+	SatBoxRange(pBox, vV, &fD, &fR);
+	if (SatDot(vV, vV) > VSIMD_SAT_EPSILON && (fD + fR < fMin0 || fMin0 < fD - fR))
+		return false;
+
+	for (k = 0; k < 3; k++)
+	{
+		SatTriRange(pTri, pBox + 3 + k * 3, &fMin0, &fMax0);
+		fD = SatDot(pBox + 3 + k * 3, pBox);
+		if (fD + pBox[12 + k] < fMin0 || fMax0 < fD - pBox[12 + k])
+			return false;
+	}
+
+	for (j = 0; j < 3; j++)
+	{
+		for (k = 0; k < 3; k++)
+		{
+			SatCross(vV, vE + j * 3, pBox + 3 + k * 3);
+			if (SatDot(vV, vV) <= VSIMD_SAT_EPSILON)
+				continue;
+
+			SatTriRange(pTri, vV, &fMin0, &fMax0);
+			SatBoxRange(pBox, vV, &fD, &fR);
+			if (fD + fR < fMin0 || fMax0 < fD - fR)
+				return false;
+		}
+	}
+	return true;
+}
+
+#if VSIMD_LANES > 0
+static inline vreg SatDot(const vreg *pA, const vreg *pB)
+{
+	return VADD(VADD(VMUL(pA[0], pB[0]), VMUL(pA[1], pB[1])), VMUL(pA[2], pB[2]));
+}
+
+static inline void SatCross(vreg *pOut, const vreg *pA, const vreg *pB)
+{
+	pOut[0] = VSUB(VMUL(pA[1], pB[2]), VMUL(pA[2], pB[1]));
+	pOut[1] = VSUB(VMUL(pA[2], pB[0]), VMUL(pA[0], pB[2]));
+	pOut[2] = VSUB(VMUL(pA[0], pB[1]), VMUL(pA[1], pB[0]));
+}
+
+static inline void LoadObb(VSoAObb vObb, VUINT i, vreg *pOut)
+{
+	const VSoA vPart[5] = { vObb.c, vObb.a0, vObb.a1, vObb.a2, vObb.e };
+
+	for (int k = 0; k < 5; k++)
+	{
+		pOut[k * 3 + 0] = VLOAD(vPart[k].x + i);
+		pOut[k * 3 + 1] = VLOAD(vPart[k].y + i);
+		pOut[k * 3 + 2] = VLOAD(vPart[k].z + i);
+	}
+}
+
+/*
+ * Lanes where [fMin, fMax] misses the box's range [fD - fR, fD + fR].
+ */
+static inline vreg SatApart(vreg vMin, vreg vMax, vreg vD, vreg vR)
+{
+	return VOR(VCMPGT(vMin, VADD(vD, vR)), VCMPGT(VSUB(vD, vR), vMax));
+}
+
+static inline vreg SatBoxRadius(const vreg *pBox, const vreg *pV)
+{
+	return VADD(VADD(VMUL(pBox[12], VABS(SatDot(pV, pBox + 3))),
+					 VMUL(pBox[13], VABS(SatDot(pV, pBox + 6)))),
+				VMUL(pBox[14], VABS(SatDot(pV, pBox + 9))));
+}
+#endif
+
+/*
+ * Pairs of oriented boxes; pHits receives a set bit for each pair that
+ * overlaps.  A register of pairs stops testing axes as soon as every
+ * pair in it has been separated.
+ */
+static void BatchObbObb(VSoAObb vA, VSoAObb vB, VUINT nCount, VUINT *pHits)
+{
+	VUINT	vWords = (nCount + 31) >> 5;
+	VUINT	i = 0;
+	float	vBoxA[15], vBoxB[15];
+
+	for (i = 0; i < vWords; i++)
+		pHits[i] = 0;
+	i = 0;
+
+#if VSIMD_LANES > 0
+	const VUINT	vAll = (1u << VSIMD_LANES) - 1;
+	const vreg	vEps = VSET1(VSIMD_SAT_EPSILON);
+	vreg		a[15], b[15], R[3][3], vAbs[3][3], T[3], vD[3];
+	vreg		vRa, vRb, vDist, vSep;
+	int			r, c, i1, i2, j1, j2;
+
+	for (; i < SimdCount(nCount); i += VSIMD_LANES)
+	{
+		LoadObb(vA, i, a);
+		LoadObb(vB, i, b);
+		for (r = 0; r < 3; r++)
+		{
+			for (c = 0; c < 3; c++)
+			{
+				R[r][c] = SatDot(a + 3 + r * 3, b + 3 + c * 3);
+				vAbs[r][c] = VADD(VABS(R[r][c]), vEps);
+			}
+			vD[r] = VSUB(b[r], a[r]);
+		}
+		for (r = 0; r < 3; r++)
+			T[r] = SatDot(vD, a + 3 + r * 3);
+
+		/* A's axes */
+		vSep = VZERO();
+		for (r = 0; r < 3; r++)
+		{
+			vRb = VADD(VADD(VMUL(b[12], vAbs[r][0]), VMUL(b[13], vAbs[r][1])),
+					   VMUL(b[14], vAbs[r][2]));
+			vSep = VOR(vSep, VCMPGT(VABS(T[r]), VADD(a[12 + r], vRb)));
+		}
+
+		/* B's axes */
+		if (VMOVEMASK(vSep) != vAll)
+		{
+			for (c = 0; c < 3; c++)
+			{
+				vRa = VADD(VADD(VMUL(a[12], vAbs[0][c]), VMUL(a[13], vAbs[1][c])),
+						   VMUL(a[14], vAbs[2][c]));
+				vDist = VABS(VADD(VADD(VMUL(T[0], R[0][c]), VMUL(T[1], R[1][c])),
+								  VMUL(T[2], R[2][c])));
+				vSep = VOR(vSep, VCMPGT(vDist, VADD(vRa, b[12 + c])));
+			}
+		}
+
+		/* the nine edge pairs, a row at a time */
+		for (r = 0; r < 3 && VMOVEMASK(vSep) != vAll; r++)
+		{
+			i1 = (r + 1) % 3;
+			i2 = (r + 2) % 3;
+			for (c = 0; c < 3; c++)
+			{
+				j1 = (c + 1) % 3;
+				j2 = (c + 2) % 3;
+				vRa = VADD(VMUL(a[12 + i1], vAbs[i2][c]), VMUL(a[12 + i2], vAbs[i1][c]));
+				vRb = VADD(VMUL(b[12 + j1], vAbs[r][j2]), VMUL(b[12 + j2], vAbs[r][j1]));
+				vDist = VABS(VSUB(VMUL(T[i2], R[i1][c]), VMUL(T[i1], R[i2][c])));
+				vSep = VOR(vSep, VCMPGT(vDist, VADD(vRa, vRb)));
+			}
+		}
+
+		pHits[i >> 5] |= (~VMOVEMASK(vSep) & vAll) << (i & 31);
+	}
+#endif
+	for (; i < nCount; i++)
+	{
+		GatherObb(vA, i, vBoxA);
+		GatherObb(vB, i, vBoxB);
+		if (SatObbObb(vBoxA, vBoxB))
+			pHits[i >> 5] |= 1u << (i & 31);
+	}
+}
+
+/*
+ * Oriented boxes against triangles given by their corners; pHits
+ * receives a set bit for each pair that overlaps.
+ */
+static void BatchObbTriangle(VSoAObb vA, VSoA v0, VSoA v1, VSoA v2,
+								VUINT nCount, VUINT *pHits)
+{
+	VUINT	vWords = (nCount + 31) >> 5;
+	VUINT	i = 0;
+	float	vBox[15], vTri[9];
+
+	for (i = 0; i < vWords; i++)
+		pHits[i] = 0;
+	i = 0;
+
+#if VSIMD_LANES > 0
+	const VUINT	vAll = (1u << VSIMD_LANES) - 1;
+	const vreg	vEps = VSET1(VSIMD_SAT_EPSILON);
+	vreg		b[15], t[9], e[9], V[3];
+	vreg		vP0, vP1, vP2, vD, vLong, vSep;
+	int			j, k;
+
+	for (; i < SimdCount(nCount); i += VSIMD_LANES)
+	{
+		LoadObb(vA, i, b);
+		t[0] = VLOAD(v0.x + i); t[1] = VLOAD(v0.y + i); t[2] = VLOAD(v0.z + i);
+		t[3] = VLOAD(v1.x + i); t[4] = VLOAD(v1.y + i); t[5] = VLOAD(v1.z + i);
+		t[6] = VLOAD(v2.x + i); t[7] = VLOAD(v2.y + i); t[8] = VLOAD(v2.z + i);
+		for (k = 0; k < 3; k++)
+		{
+			e[k] = VSUB(t[3 + k], t[k]);
+			e[3 + k] = VSUB(t[6 + k], t[k]);
+		}
+		for (k = 0; k < 3; k++)
+			e[6 + k] = VSUB(e[3 + k], e[k]);
+
+		/* the triangle's normal */
+		SatCross(V, e, e + 3);
+		vP0 = SatDot(V, t);
+		vLong = VCMPGT(SatDot(V, V), vEps);
+		vSep = VAND(vLong, SatApart(vP0, vP0, SatDot(V, b), SatBoxRadius(b, V)));
+
+		/* the box's axes */
+		for (k = 0; k < 3; k++)
+		{
+			vP0 = SatDot(b + 3 + k * 3, t);
+			vP1 = SatDot(b + 3 + k * 3, t + 3);
+			vP2 = SatDot(b + 3 + k * 3, t + 6);
+			vD = SatDot(b + 3 + k * 3, b);
+			vSep = VOR(vSep, SatApart(VMIN(VMIN(vP0, vP1), vP2),
+					VMAX(VMAX(vP0, vP1), vP2), vD, b[12 + k]));
+		}
+
+		/* each edge crossed with each axis */
+		for (j = 0; j < 3 && VMOVEMASK(vSep) != vAll; j++)
+		{
+			for (k = 0; k < 3; k++)
+			{
+				SatCross(V, e + j * 3, b + 3 + k * 3);
+				vLong = VCMPGT(SatDot(V, V), vEps);
+				vP0 = SatDot(V, t);
+				vP1 = SatDot(V, t + 3);
+				vP2 = SatDot(V, t + 6);
+				vSep = VOR(vSep, VAND(vLong, SatApart(VMIN(VMIN(vP0, vP1), vP2),
+						VMAX(VMAX(vP0, vP1), vP2), SatDot(V, b), SatBoxRadius(b, V))));
+			}
+		}
+
+		pHits[i >> 5] |= (~VMOVEMASK(vSep) & vAll) << (i & 31);
+	}
+#endif
+	for (; i < nCount; i++)
+	{
+		GatherObb(vA, i, vBox);
+		vTri[0] = v0.x[i]; vTri[1] = v0.y[i]; vTri[2] = v0.z[i];
+		vTri[3] = v1.x[i]; vTri[4] = v1.y[i]; vTri[5] = v1.z[i];
+		vTri[6] = v2.x[i]; vTri[7] = v2.y[i]; vTri[8] = v2.z[i];
+		if (SatObbTriangle(vBox, vTri))
+			pHits[i >> 5] |= 1u << (i & 31);
+	}
+}
+
+/********************************************************************
+ *                     T R A N S C E N D E N T A L S                *
+ ********************************************************************/
+
+#if VSIMD_LANES > 0
+/*
+ * Lane by lane ApproxSinCos().
+ */
+static inline void SinCosLanes(vreg vX, vreg &vSin, vreg &vCos, VMathAccuracy eAccuracy)
+{
+	vint vJ = VCVTI(VMUL(vX, VSET1(VAPPROX_2OPI)));
+	vreg vJf = VCVTF(vJ);
+	vreg vR = VNMADD(vJf, VSET1(VAPPROX_PIO2_3), VNMADD(vJf, VSET1(VAPPROX_PIO2_2),
+				VNMADD(vJf, VSET1(VAPPROX_PIO2_1), vX)));
+	vreg vZ = VMUL(vR, vR);
+	vreg vS, vC, vSwap;
+
+	if (eAccuracy == MATH_FAST)
+	{
+		vS = VMUL(vR, VMADD(vZ, VSET1(VAPPROX_SIN_F1), VSET1(VAPPROX_SIN_F0)));
+		vC = VMADD(vZ, VMADD(vZ, VSET1(VAPPROX_COS_F1), VSET1(VAPPROX_COS_F0)), VSET1(1.0f));
+	}
+	else
+	{
+		vS = VMADD(vZ, VSET1(VAPPROX_SIN_P2), VSET1(VAPPROX_SIN_P1));
+		vS = VMADD(vZ, vS, VSET1(VAPPROX_SIN_P0));
+		vS = VMADD(VMUL(vR, vZ), vS, vR);
+		vC = VMADD(vZ, VSET1(VAPPROX_COS_P2), VSET1(VAPPROX_COS_P1));
+		vC = VMADD(vZ, vC, VSET1(VAPPROX_COS_P0));
+		vC = VMADD(VMUL(vZ, vZ), vC, VNMADD(vZ, VSET1(0.5f), VSET1(1.0f)));
+	}
+
+	vSwap = VCASTF(VIEQ(VIAND(vJ, VISET1(1)), VISET1(1)));
+	vSin = VXOR(VSELECT(vSwap, vC, vS), VCASTF(VISHL(VIAND(vJ, VISET1(2)), 30)));
+	vCos = VXOR(VSELECT(vSwap, vS, vC),
+				VCASTF(VISHL(VIAND(VIADD(vJ, VISET1(1)), VISET1(2)), 30)));
+}
+
+/*
+ * acos(x) for x in [0, 1].
+ */
+static inline vreg ACosUnit(vreg vX, VMathAccuracy eAccuracy)
+{
+	vreg vP;
+
+	if (eAccuracy == MATH_FAST)
+	{
+		vP = VMADD(vX, VSET1(VAPPROX_ACOS_F3), VSET1(VAPPROX_ACOS_F2));
+		vP = VMADD(vP, vX, VSET1(VAPPROX_ACOS_F1));
+		vP = VMADD(vP, vX, VSET1(VAPPROX_ACOS_F0));
+	}
+	else
+	{
+		vP = VMADD(vX, VSET1(VAPPROX_ACOS_P7), VSET1(VAPPROX_ACOS_P6));
+		vP = VMADD(vP, vX, VSET1(VAPPROX_ACOS_P5));
+		vP = VMADD(vP, vX, VSET1(VAPPROX_ACOS_P4));
+		vP = VMADD(vP, vX, VSET1(VAPPROX_ACOS_P3));
+		vP = VMADD(vP, vX, VSET1(VAPPROX_ACOS_P2));
+		vP = VMADD(vP, vX, VSET1(VAPPROX_ACOS_P1));
+		vP = VMADD(vP, vX, VSET1(VAPPROX_ACOS_P0));
+	}
+	return VMUL(vP, VSQRT(VSUB(VSET1(1.0f), vX)));
+}
+#endif
+
+static void BatchSinCos(float *pSin, float *pCos, const float *pIn, VUINT nCount,
+						VMathAccuracy eAccuracy)
+{
+	VUINT i = 0;
+
+	if (eAccuracy == MATH_EXACT)
+	{
+		for (; i < nCount; i++)
+		{
+			pSin[i] = sinf(pIn[i]);
+			pCos[i] = cosf(pIn[i]);
+		}
+		return;
+	}
+#if VSIMD_LANES > 0
+	for (; i < SimdCount(nCount); i += VSIMD_LANES)
+	{
+		vreg vS, vC;
+
+		SinCosLanes(VLOADU(pIn + i), vS, vC, eAccuracy);
+		VSTOREU(pSin + i, vS);
+		VSTOREU(pCos + i, vC);
+	}
+#endif
+	for (; i < nCount; i++)
+		ApproxSinCos(pIn[i], pSin + i, pCos + i, eAccuracy);
+}
+
+/*
+ * The SIMD lanes start from the hardware estimate (12 bits) rather than
+ * the integer guess the scalar code uses.
+ */
+static void BatchRSqrt(float *pOut, const float *pIn, VUINT nCount, VMathAccuracy eAccuracy)
+{
+	VUINT i = 0;
+
+	if (eAccuracy == MATH_EXACT)
+	{
+		for (; i < nCount; i++)
+			pOut[i] = 1.0f / sqrtf(pIn[i]);
+		return;
+	}
+#if VSIMD_LANES > 0
+	for (; i < SimdCount(nCount); i += VSIMD_LANES)
+	{
+		vreg vX = VLOADU(pIn + i);
+		vreg vY = VRSQRT(vX);
+
+		if (eAccuracy != MATH_FAST)
+		{
+			vreg vHalfX = VMUL(vX, VSET1(0.5f));
+			vY = VMUL(vY, VNMADD(VMUL(vHalfX, vY), vY, VSET1(1.5f)));
+		}
+		VSTOREU(pOut + i, vY);
+	}
+#endif
+	for (; i < nCount; i++)
+		pOut[i] = ApproxRSqrt(pIn[i], eAccuracy);
+}
+
+static void BatchATan2(float *pOut, const float *pY, const float *pX, VUINT nCount,
+						VMathAccuracy eAccuracy)
+{
+	VUINT i = 0;
+
+	if (eAccuracy == MATH_EXACT)
+	{
+		for (; i < nCount; i++)
+			pOut[i] = atan2f(pY[i], pX[i]);
+		return;
+	}
+#if VSIMD_LANES > 0
+	vreg vZero = VZERO();
+	for (; i < SimdCount(nCount); i += VSIMD_LANES)
+	{
+		vreg vY = VLOADU(pY + i), vX = VLOADU(pX + i);
+		vreg vAy = VABS(vY), vAx = VABS(vX);
+		vreg vMax = VMAX(vAx, vAy);
+		vreg vA = VDIV(VMIN(vAx, vAy), vMax);
+		vreg vZ, vR;
+
+		if (eAccuracy == MATH_FAST)
+		{
+			vZ = VMUL(vA, vA);
+			vR = VMADD(vZ, VSET1(VAPPROX_ATAN_F2), VSET1(VAPPROX_ATAN_F1));
+			vR = VMUL(vA, VMADD(vR, vZ, VSET1(VAPPROX_ATAN_F0)));
+		}
+		else
+		{
+			vreg vOne = VSET1(1.0f);
+			vreg vBig = VCMPGT(vA, VSET1(VAPPROX_TANPIO8));
+			vreg vBase = VSELECT(vBig, VSET1(VAPPROX_PIO4), vZero);
+
+			vA = VSELECT(vBig, VDIV(VSUB(vA, vOne), VADD(vA, vOne)), vA);
+			vZ = VMUL(vA, vA);
+			vR = VMADD(vZ, VSET1(VAPPROX_ATAN_P3), VSET1(VAPPROX_ATAN_P2));
+			vR = VMADD(vR, vZ, VSET1(VAPPROX_ATAN_P1));
+			vR = VMADD(vR, vZ, VSET1(VAPPROX_ATAN_P0));
+			vR = VADD(vBase, VMADD(VMUL(vA, vZ), vR, vA));
+		}
+
+		vR = VSELECT(VCMPGT(vAy, vAx), VSUB(VSET1(VAPPROX_PIO2), vR), vR);
+		vR = VSELECT(VCMPGT(vZero, vX), VSUB(VSET1(VAPPROX_PI), vR), vR);
+		vR = VSELECT(VCMPGT(vZero, vY), VSUB(vZero, vR), vR);
+		VSTOREU(pOut + i, VSELECT(VCMPNEQ(vMax, vZero), vR, vZero));
+	}
+#endif
+	for (; i < nCount; i++)
+		pOut[i] = ApproxATan2(pY[i], pX[i], eAccuracy);
+}
+
+static void BatchACos(float *pOut, const float *pIn, VUINT nCount, VMathAccuracy eAccuracy)
+{
+	VUINT i = 0;
+
+	if (eAccuracy == MATH_EXACT)
+	{
+		for (; i < nCount; i++)
+			pOut[i] = acosf(pIn[i]);
+		return;
+	}
+#if VSIMD_LANES > 0
+	for (; i < SimdCount(nCount); i += VSIMD_LANES)
+	{
+		vreg vX = VLOADU(pIn + i);
+		vreg vP = ACosUnit(VMIN(VABS(vX), VSET1(1.0f)), eAccuracy);
+
+		VSTOREU(pOut + i, VSELECT(VCMPGT(VZERO(), vX), VSUB(VSET1(VAPPROX_PI), vP), vP));
+	}
+#endif
+	for (; i < nCount; i++)
+		pOut[i] = ApproxACos(pIn[i], eAccuracy);
+}
+
+/********************************************************************
+ *                  Q U A T E R N I O N   B A T C H E S             *
+ ********************************************************************/
+
+static void BatchQuatMultiply(VSoAQuat vOut, VSoAQuat vA, VSoAQuat vB, VUINT nCount)
+{
+	VUINT i = 0;
+	float fX, fY, fZ, fW;
+
+#if VSIMD_LANES > 0
+	for (; i < SimdCount(nCount); i += VSIMD_LANES)
+	{
+		vreg vX1 = VLOAD(vA.x + i), vY1 = VLOAD(vA.y + i);
+		vreg vZ1 = VLOAD(vA.z + i), vW1 = VLOAD(vA.w + i);
+		vreg vX2 = VLOAD(vB.x + i), vY2 = VLOAD(vB.y + i);
+		vreg vZ2 = VLOAD(vB.z + i), vW2 = VLOAD(vB.w + i);
+
+		vreg vX = VMADD(vW1, vX2, VMADD(vX1, vW2, VMSUB(vY1, vZ2, VMUL(vZ1, vY2))));
+		vreg vY = VMADD(vW1, vY2, VMADD(vY1, vW2, VMSUB(vZ1, vX2, VMUL(vX1, vZ2))));
+		vreg vZ = VMADD(vW1, vZ2, VMADD(vZ1, vW2, VMSUB(vX1, vY2, VMUL(vY1, vX2))));
+		vreg vW = VMSUB(vW1, vW2, VMADD(vX1, vX2, VMADD(vY1, vY2, VMUL(vZ1, vZ2))));
+
+		VSTORE(vOut.x + i, vX);
+		VSTORE(vOut.y + i, vY);
+		VSTORE(vOut.z + i, vZ);
+		VSTORE(vOut.w + i, vW);
+	}
+#endif
+	for (; i < nCount; i++)
+	{
+		fW = vA.w[i] * vB.w[i] - vA.x[i] * vB.x[i] - vA.y[i] * vB.y[i] - vA.z[i] * vB.z[i];
+		fX = vA.w[i] * vB.x[i] + vA.x[i] * vB.w[i] + vA.y[i] * vB.z[i] - vA.z[i] * vB.y[i];
+		fY = vA.w[i] * vB.y[i] + vA.y[i] * vB.w[i] + vA.z[i] * vB.x[i] - vA.x[i] * vB.z[i];
+		fZ = vA.w[i] * vB.z[i] + vA.z[i] * vB.w[i] + vA.x[i] * vB.y[i] - vA.y[i] * vB.x[i];
+		vOut.x[i] = fX;
+		vOut.y[i] = fY;
+		vOut.z[i] = fZ;
+		vOut.w[i] = fW;
+	}
+}
+
+/*
+ * v' = v + w*t + q x t, where t = 2 * (q x v); the same rotation as
+ * VQuaternion::ToRotationMatrix() applied to a column vector.
+ */
+static void BatchQuatRotate(VSoA vOut, VSoAQuat vQ, VSoA vIn, VUINT nCount)
+{
+	VUINT i = 0;
+	float fTx, fTy, fTz, fX, fY, fZ;
+
+#if VSIMD_LANES > 0
+	vreg vTwo = VSET1(2.0f);
+	for (; i < SimdCount(nCount); i += VSIMD_LANES)
+	{
+		vreg vQx = VLOAD(vQ.x + i), vQy = VLOAD(vQ.y + i);
+		vreg vQz = VLOAD(vQ.z + i), vQw = VLOAD(vQ.w + i);
+		vreg vX = VLOAD(vIn.x + i), vY = VLOAD(vIn.y + i), vZ = VLOAD(vIn.z + i);
+
+		vreg vTx = VMUL(vTwo, VMSUB(vQy, vZ, VMUL(vQz, vY)));
+		vreg vTy = VMUL(vTwo, VMSUB(vQz, vX, VMUL(vQx, vZ)));
+		vreg vTz = VMUL(vTwo, VMSUB(vQx, vY, VMUL(vQy, vX)));
+
+		VSTORE(vOut.x + i, VADD(VMADD(vQw, vTx, vX), VMSUB(vQy, vTz, VMUL(vQz, vTy))));
+		VSTORE(vOut.y + i, VADD(VMADD(vQw, vTy, vY), VMSUB(vQz, vTx, VMUL(vQx, vTz))));
+		VSTORE(vOut.z + i, VADD(VMADD(vQw, vTz, vZ), VMSUB(vQx, vTy, VMUL(vQy, vTx))));
+	}
+#endif
+	for (; i < nCount; i++)
+	{
+		fTx = 2.0f * (vQ.y[i] * vIn.z[i] - vQ.z[i] * vIn.y[i]);
+		fTy = 2.0f * (vQ.z[i] * vIn.x[i] - vQ.x[i] * vIn.z[i]);
+		fTz = 2.0f * (vQ.x[i] * vIn.y[i] - vQ.y[i] * vIn.x[i]);
+		fX = vIn.x[i] + vQ.w[i] * fTx + vQ.y[i] * fTz - vQ.z[i] * fTy;
+		fY = vIn.y[i] + vQ.w[i] * fTy + vQ.z[i] * fTx - vQ.x[i] * fTz;
+		fZ = vIn.z[i] + vQ.w[i] * fTz + vQ.x[i] * fTy - vQ.y[i] * fTx;
+		vOut.x[i] = fX;
+		vOut.y[i] = fY;
+		vOut.z[i] = fZ;
+	}
+}
+
+/*
+ * Scales element i to unit length; zero quaternions are left alone.
+ */
+static inline void QuatNormalizeOne(VSoAQuat vOut, VUINT i)
+{
+	float fLength = sqrtf(vOut.x[i] * vOut.x[i] + vOut.y[i] * vOut.y[i] +
+						vOut.z[i] * vOut.z[i] + vOut.w[i] * vOut.w[i]);
+
+	if (fLength != 0.0f)
+	{
+		fLength = 1.0f / fLength;
+		vOut.x[i] *= fLength;
+		vOut.y[i] *= fLength;
+		vOut.z[i] *= fLength;
+		vOut.w[i] *= fLength;
+	}
+}
+
+#if VSIMD_LANES > 0
+/*
+ * Scales four lanes of components to unit length, as QuatNormalizeOne().
+ */
+static inline void QuatNormalize(vreg &vX, vreg &vY, vreg &vZ, vreg &vW)
+{
+	vreg vL = VSQRT(VMADD(vW, vW, VMADD(vZ, vZ, VMADD(vY, vY, VMUL(vX, vX)))));
+	vreg vMask = VCMPNEQ(vL, VZERO());
+	vreg vInv = VDIV(VSET1(1.0f), vL);
+
+	vX = VSELECT(vMask, VMUL(vX, vInv), vX);
+	vY = VSELECT(vMask, VMUL(vY, vInv), vY);
+	vZ = VSELECT(vMask, VMUL(vZ, vInv), vZ);
+	vW = VSELECT(vMask, VMUL(vW, vInv), vW);
+}
+#endif
+
+static void BatchQuatNormalize(VSoAQuat vOut, VUINT nCount)
+{
+	VUINT i = 0;
+
+#if VSIMD_LANES > 0
+	for (; i < SimdCount(nCount); i += VSIMD_LANES)
+	{
+		vreg vX = VLOAD(vOut.x + i), vY = VLOAD(vOut.y + i);
+		vreg vZ = VLOAD(vOut.z + i), vW = VLOAD(vOut.w + i);
+
+		QuatNormalize(vX, vY, vZ, vW);
+		VSTORE(vOut.x + i, vX);
+		VSTORE(vOut.y + i, vY);
+		VSTORE(vOut.z + i, vZ);
+		VSTORE(vOut.w + i, vW);
+	}
+#endif
+	for (; i < nCount; i++)
+		QuatNormalizeOne(vOut, i);
+}
+
+/*
+ * Weights of a and b for one element.  b is negated when the two are
+ * more than 90 degrees apart, so the blend takes the shorter arc.
+ * Without a slerp the weights are a plain lerp; the fast slerp is an
+ * nlerp with t corrected by a cubic fitted to the slerp angle.
+ */
+static inline void QuatBlendWeights(float fDot, float fT, int nMode,
+									float &fWa, float &fWb)
+{
+	float fSign = (fDot < 0.0f) ? -1.0f : 1.0f;
+	float fD = (fDot < 0.0f) ? -fDot : fDot;
+	float fTheta, fSin, fA, fB;
+
+	if (fD > 1.0f)
+		fD = 1.0f;
+	if (nMode == 2)
+	{
+		fA = 1.0904f + fD * (-3.2452f + fD * (3.55645f - fD * 1.43519f));
+		fB = 0.848013f + fD * (-1.06021f + fD * 0.215638f);
+		fA = fA * (fT - 0.5f) * (fT - 0.5f) + fB;
+		fT = fT + fT * (fT - 0.5f) * (fT - 1.0f) * fA;
+	}
+	if (nMode == 1 && fD <= 0.9995f)
+	{
+		fTheta = acosf(fD);
+		fSin = 1.0f / sinf(fTheta);
+		fWa = sinf((1.0f - fT) * fTheta) * fSin;
+		fWb = sinf(fT * fTheta) * fSin * fSign;
+	}
+	else
+	{
+		fWa = 1.0f - fT;
+		fWb = fT * fSign;
+	}
+}
+
+#if VSIMD_LANES > 0
+/*
+ * sin(x) for x in [0, pi/2], to float precision.
+ */
+static inline vreg SinQuadrant(vreg vX)
+{
+	vreg vX2 = VMUL(vX, vX);
+	vreg vP = VSET1(-2.5052108e-8f);
+
+	vP = VMADD(vP, vX2, VSET1(2.7557319e-6f));
+	vP = VMADD(vP, vX2, VSET1(-1.9841270e-4f));
+	vP = VMADD(vP, vX2, VSET1(8.3333333e-3f));
+	vP = VMADD(vP, vX2, VSET1(-1.6666667e-1f));
+	return VMADD(VMUL(vP, vX2), vX, vX);
+}
+
+/*
+ * Lane by lane QuatBlendWeights(), sharing one t.
+ */
+static inline void QuatBlendWeights(vreg vDot, float fT, int nMode,
+									vreg &vWa, vreg &vWb)
+{
+	vreg vZero = VZERO();
+	vreg vOne = VSET1(1.0f);
+	vreg vNeg = VCMPGT(vZero, vDot);
+	vreg vD = VSELECT(vNeg, VSUB(vZero, vDot), vDot);
+	vreg vT = VSET1(fT);
+
+	vD = VSELECT(VCMPGT(vD, vOne), vOne, vD);
+	if (nMode == 2)
+	{
+		vreg vHalf = VSET1(fT - 0.5f);
+		vreg vA = VMADD(vD, VSET1(-1.43519f), VSET1(3.55645f));
+		vreg vB = VMADD(vD, VSET1(0.215638f), VSET1(-1.06021f));
+
+		vA = VMADD(VMADD(vA, vD, VSET1(-3.2452f)), vD, VSET1(1.0904f));
+		vB = VMADD(vB, vD, VSET1(0.848013f));
+		vA = VMADD(VMUL(vA, vHalf), vHalf, vB);
+		vT = VMADD(VSET1(fT * (fT - 0.5f) * (fT - 1.0f)), vA, vT);
+	}
+	vWa = VSUB(vOne, vT);
+	vWb = vT;
+	if (nMode == 1)
+	{
+		vreg vTheta = ACosUnit(vD, MATH_PRECISE);
+		vreg vSin = VDIV(vOne, SinQuadrant(vTheta));
+		vreg vUse = VCMPGE(VSET1(0.9995f), vD);
+
+		vWa = VSELECT(vUse, VMUL(SinQuadrant(VMUL(vWa, vTheta)), vSin), vWa);
+		vWb = VSELECT(vUse, VMUL(SinQuadrant(VMUL(vT, vTheta)), vSin), vWb);
+	}
+	vWb = VSELECT(vNeg, VSUB(vZero, vWb), vWb);
+}
+#endif
+
+/*
+ * Blends a towards b by fT along the shorter arc and renormalizes.
+ * nMode is 0 for nlerp, 1 for slerp and 2 for the fast slerp.
+ */
+static void QuatBlend(VSoAQuat vOut, VSoAQuat vA, VSoAQuat vB, float fT,
+					int nMode, VUINT nCount)
+{
+	VUINT i = 0;
+	float fWa, fWb;
+
+#if VSIMD_LANES > 0
+	for (; i < SimdCount(nCount); i += VSIMD_LANES)
+	{
+		vreg vX1 = VLOAD(vA.x + i), vY1 = VLOAD(vA.y + i);
+		vreg vZ1 = VLOAD(vA.z + i), vW1 = VLOAD(vA.w + i);
+		vreg vX2 = VLOAD(vB.x + i), vY2 = VLOAD(vB.y + i);
+		vreg vZ2 = VLOAD(vB.z + i), vW2 = VLOAD(vB.w + i);
+		vreg vDot = VMADD(vW1, vW2, VMADD(vZ1, vZ2, VMADD(vY1, vY2, VMUL(vX1, vX2))));
+		vreg vWa, vWb;
+
+		QuatBlendWeights(vDot, fT, nMode, vWa, vWb);
+		vreg vX = VMADD(vX1, vWa, VMUL(vX2, vWb));
+		vreg vY = VMADD(vY1, vWa, VMUL(vY2, vWb));
+		vreg vZ = VMADD(vZ1, vWa, VMUL(vZ2, vWb));
+		vreg vW = VMADD(vW1, vWa, VMUL(vW2, vWb));
+
+		QuatNormalize(vX, vY, vZ, vW);
+		VSTORE(vOut.x + i, vX);
+		VSTORE(vOut.y + i, vY);
+		VSTORE(vOut.z + i, vZ);
+		VSTORE(vOut.w + i, vW);
+	}
+#endif
+	for (; i < nCount; i++)
+	{
+		QuatBlendWeights(vA.x[i] * vB.x[i] + vA.y[i] * vB.y[i] +
+						vA.z[i] * vB.z[i] + vA.w[i] * vB.w[i], fT, nMode, fWa, fWb);
+		vOut.x[i] = vA.x[i] * fWa + vB.x[i] * fWb;
+		vOut.y[i] = vA.y[i] * fWa + vB.y[i] * fWb;
+		vOut.z[i] = vA.z[i] * fWa + vB.z[i] * fWb;
+		vOut.w[i] = vA.w[i] * fWa + vB.w[i] * fWb;
+		QuatNormalizeOne(vOut, i);
+	}
+}
+
+static void BatchQuatNlerp(VSoAQuat vOut, VSoAQuat vA, VSoAQuat vB, float fT,
+						VUINT nCount)
+{
+	QuatBlend(vOut, vA, vB, fT, 0, nCount);
+}
+
+static void BatchQuatSlerp(VSoAQuat vOut, VSoAQuat vA, VSoAQuat vB, float fT,
+						bool bFast, VUINT nCount)
+{
+	QuatBlend(vOut, vA, vB, fT, bFast ? 2 : 1, nCount);
+}
+
+#if VSIMD_LANES > 0
+/*
+ * Writes four affine transforms from their twelve components, one
+ * register per component in row-major order.
+ */
+static inline void StoreAffine4(float *pOut, __m128 *pM)
+{
+	for (int r = 0; r < 3; r++)
+	{
+		__m128 v0 = pM[r * 4], v1 = pM[r * 4 + 1], v2 = pM[r * 4 + 2], v3 = pM[r * 4 + 3];
+
+		_MM_TRANSPOSE4_PS(v0, v1, v2, v3);
+		_mm_storeu_ps(pOut + r * 4, v0);
+		_mm_storeu_ps(pOut + 12 + r * 4, v1);
+		_mm_storeu_ps(pOut + 24 + r * 4, v2);
+		_mm_storeu_ps(pOut + 36 + r * 4, v3);
+	}
+}
+#endif
+
+/*
+ * Same layout as VAffine::Set() with a scale of 1.  vPos.x may be NULL
+ * for no translation.
+ */
+static void BatchQuatToAffine(float *pOut, VSoAQuat vQ, VSoA vPos, VUINT nCount)
+{
+	VUINT i = 0;
+	float fTx, fTy, fTz, fTwx, fTwy, fTwz, fTxx, fTxy, fTxz, fTyy, fTyz, fTzz;
+	float *vM;
+
+#if VSIMD_LANES > 0
+	vreg vOne = VSET1(1.0f), vZero = VZERO();
+	for (; i < SimdCount(nCount); i += VSIMD_LANES)
+	{
+		vreg vX = VLOAD(vQ.x + i), vY = VLOAD(vQ.y + i);
+		vreg vZ = VLOAD(vQ.z + i), vW = VLOAD(vQ.w + i);
+		vreg vTx = VADD(vX, vX), vTy = VADD(vY, vY), vTz = VADD(vZ, vZ);
+		vreg vTwx = VMUL(vTx, vW), vTwy = VMUL(vTy, vW), vTwz = VMUL(vTz, vW);
+		vreg vTxx = VMUL(vTx, vX), vTxy = VMUL(vTy, vX), vTxz = VMUL(vTz, vX);
+		vreg vTyy = VMUL(vTy, vY), vTyz = VMUL(vTz, vY), vTzz = VMUL(vTz, vZ);
+		vreg vRows[12];
+
+		vRows[0] = VSUB(VSUB(vOne, vTyy), vTzz);
+		vRows[1] = VSUB(vTxy, vTwz);
+		vRows[2] = VADD(vTxz, vTwy);
+		vRows[3] = vPos.x ? VLOAD(vPos.x + i) : vZero;
+		vRows[4] = VADD(vTxy, vTwz);
+		vRows[5] = VSUB(VSUB(vOne, vTxx), vTzz);
+		vRows[6] = VSUB(vTyz, vTwx);
+		vRows[7] = vPos.x ? VLOAD(vPos.y + i) : vZero;
+		vRows[8] = VSUB(vTxz, vTwy);
+		vRows[9] = VADD(vTyz, vTwx);
+		vRows[10] = VSUB(VSUB(vOne, vTxx), vTyy);
+		vRows[11] = vPos.x ? VLOAD(vPos.z + i) : vZero;
+#if VSIMD_LANES == 8
+		__m128 vLo[12], vHi[12];
+		for (int c = 0; c < 12; c++)
+		{
+			vLo[c] = _mm256_castps256_ps128(vRows[c]);
+			vHi[c] = _mm256_extractf128_ps(vRows[c], 1);
+		}
+		StoreAffine4(pOut + i * 12, vLo);
+		StoreAffine4(pOut + (i + 4) * 12, vHi);
+#else
+		StoreAffine4(pOut + i * 12, vRows);
+#endif
+	}
+#endif
+	for (; i < nCount; i++)
+	{
+		fTx = 2.0f * vQ.x[i];
+		fTy = 2.0f * vQ.y[i];
+		fTz = 2.0f * vQ.z[i];
+		fTwx = fTx * vQ.w[i];
+		fTwy = fTy * vQ.w[i];
+		fTwz = fTz * vQ.w[i];
+		fTxx = fTx * vQ.x[i];
+		fTxy = fTy * vQ.x[i];
+		fTxz = fTz * vQ.x[i];
+		fTyy = fTy * vQ.y[i];
+		fTyz = fTz * vQ.y[i];
+		fTzz = fTz * vQ.z[i];
+
+		vM = pOut + i * 12;
+		vM[0] = 1.0f - fTyy - fTzz;
+		vM[1] = fTxy - fTwz;
+		vM[2] = fTxz + fTwy;
+		vM[3] = vPos.x ? vPos.x[i] : 0.0f;
+		vM[4] = fTxy + fTwz;
+		vM[5] = 1.0f - fTxx - fTzz;
+		vM[6] = fTyz - fTwx;
+		vM[7] = vPos.x ? vPos.y[i] : 0.0f;
+		vM[8] = fTxz - fTwy;
+		vM[9] = fTyz + fTwx;
+		vM[10] = 1.0f - fTxx - fTyy;
+		vM[11] = vPos.x ? vPos.z[i] : 0.0f;
+	}
+}
+
+/********************************************************************
+ *                        R A Y   P A C K E T S                     *
+ ********************************************************************/
+
+/*
+ * Slab test of the active rays of a packet against one box.  Returns
+ * the rays that enter it somewhere between their origin and their t.
+ */
+static VUINT RayPacketBox(VSoARays vRays, const float *pMin, const float *pMax,
+							VUINT nActive)
+{
+	VUINT	vHits = 0;
+	VUINT	r = 0;
+
+#if VSIMD_LANES > 0
+	const VUINT vAll = (1u << VSIMD_LANES) - 1;
+	const vreg vMinX = VSET1(pMin[0]), vMinY = VSET1(pMin[1]), vMinZ = VSET1(pMin[2]);
+	const vreg vMaxX = VSET1(pMax[0]), vMaxY = VSET1(pMax[1]), vMaxZ = VSET1(pMax[2]);
+	vreg vT0, vT1, vNear, vFar;
+
+	for (; r < VSIMD_PACKET; r += VSIMD_LANES)
+	{
+		if (((nActive >> r) & vAll) == 0)
+			continue;
+
+		vT0 = VMUL(VSUB(vMinX, VLOADU(vRays.ox + r)), VLOADU(vRays.ix + r));
+		vT1 = VMUL(VSUB(vMaxX, VLOADU(vRays.ox + r)), VLOADU(vRays.ix + r));
+		vNear = VMAX(VMIN(vT0, vT1), VZERO());
+		vFar = VMIN(VMAX(vT0, vT1), VLOADU(vRays.t + r));
+		vT0 = VMUL(VSUB(vMinY, VLOADU(vRays.oy + r)), VLOADU(vRays.iy + r));
+		vT1 = VMUL(VSUB(vMaxY, VLOADU(vRays.oy + r)), VLOADU(vRays.iy + r));
+		vNear = VMAX(vNear, VMIN(vT0, vT1));
+		vFar = VMIN(vFar, VMAX(vT0, vT1));
+		vT0 = VMUL(VSUB(vMinZ, VLOADU(vRays.oz + r)), VLOADU(vRays.iz + r));
+		vT1 = VMUL(VSUB(vMaxZ, VLOADU(vRays.oz + r)), VLOADU(vRays.iz + r));
+		vNear = VMAX(vNear, VMIN(vT0, vT1));
+		vFar = VMIN(vFar, VMAX(vT0, vT1));
+		vHits |= VMOVEMASK(VCMPGE(vFar, vNear)) << r;
+	}
+#else
+	const float	*vO[3] = { vRays.ox, vRays.oy, vRays.oz };
+	const float	*vI[3] = { vRays.ix, vRays.iy, vRays.iz };
+	float		t0, t1, fNear, fFar;
+	int			a;
+
+	for (; r < VSIMD_PACKET; r++)
+	{
+		if ((nActive & (1u << r)) == 0)
+			continue;
+
+		fNear = 0.0f;
+		fFar = vRays.t[r];
+		for (a = 0; a < 3 && fNear <= fFar; a++)
+		{
+			t0 = (pMin[a] - vO[a][r]) * vI[a][r];
+			t1 = (pMax[a] - vO[a][r]) * vI[a][r];
+			if (t0 > t1)
+			{
+				float tmp = t0;
+				t0 = t1;
+				t1 = tmp;
+			}
+			if (t0 > fNear)
+				fNear = t0;
+			if (t1 < fFar)
+				fFar = t1;
+		}
+		if (fNear <= fFar)
+			vHits |= 1u << r;
+	}
+#endif
+	return vHits & nActive;
+}
+
+/*
+ * Moller-Trumbore test of the active rays of a packet against nCount
+ * triangles, numbered from nFirst.  Every ray that hits one of them
+ * between its origin and its t gets t, u, v and hit updated.  Hits are
+ * compared against det instead of dividing by it, and only a triangle
+ * that some ray actually hits pays for the division.  A triangle is
+ * dropped as soon as no ray is left that can hit it, and with bAny set
+ * a ray stops testing after its first hit.  With bCull set, triangles
+ * wound clockwise as seen along the ray are skipped, as in
+ * VRay::Intersects().
+ *
+ * Returns the rays whose hit was updated.  That is usually a subset of
+ * nActive, but a ray left out of it that does hit one of the triangles
+ * nearer than its t may be updated as well.
+ */
+static VUINT RayPacketTriangles(VSoARays vRays, const float *pTris, VUINT nFirst,
+								VUINT nCount, VUINT nActive, bool bCull, bool bAny)
+{
+	VUINT	vGot = 0;
+	VUINT	r = 0, i;
+
+#if VSIMD_LANES > 0
+	const VUINT vAll = (1u << VSIMD_LANES) - 1;
+	const vreg	vZero = VZERO();
+	const vreg	vEpsilon = VSET1(0.0001f);
+	VUINT		vLanes, vHit;
+
+	for (; r < VSIMD_PACKET; r += VSIMD_LANES)
+	{
+		vLanes = (nActive >> r) & vAll;
+		if (vLanes == 0)
+			continue;
+
+		vreg vOx = VLOADU(vRays.ox + r), vOy = VLOADU(vRays.oy + r), vOz = VLOADU(vRays.oz + r);
+		vreg vDx = VLOADU(vRays.dx + r), vDy = VLOADU(vRays.dy + r), vDz = VLOADU(vRays.dz + r);
+		vreg vT = VLOADU(vRays.t + r), vU = VLOADU(vRays.u + r), vV = VLOADU(vRays.v + r);
+		const float *vTri = pTris;
+
+		for (i = 0; i < nCount; i++, vTri += 9)
+		{
+			vreg vE1x = VSET1(vTri[3]), vE1y = VSET1(vTri[4]), vE1z = VSET1(vTri[5]);
+			vreg vE2x = VSET1(vTri[6]), vE2y = VSET1(vTri[7]), vE2z = VSET1(vTri[8]);
+			vreg vMask, vSign, vDet;
+
+			/* p = d x e2, det = e1 . p; near zero the ray is parallel */
+			vreg vPx = VSUB(VMUL(vDy, vE2z), VMUL(vDz, vE2y));
+			vreg vPy = VSUB(VMUL(vDz, vE2x), VMUL(vDx, vE2z));
+			vreg vPz = VSUB(VMUL(vDx, vE2y), VMUL(vDy, vE2x));
+			vDet = VADD(VADD(VMUL(vE1x, vPx), VMUL(vE1y, vPy)), VMUL(vE1z, vPz));
+			if (bCull)
+			{
+				vSign = vZero;
+				vMask = VCMPGT(vDet, vEpsilon);
+			}
+			else
+			{
+				/* fold the sign of det into u, v and t */
+				vSign = VXOR(vDet, VABS(vDet));
+				vDet = VABS(vDet);
+				vMask = VCMPGT(vDet, vEpsilon);
+			}
+			if ((VMOVEMASK(vMask) & vLanes) == 0)
+				continue;
+
+			/* s = o - v0, u = s . p */
+			vreg vSx = VSUB(vOx, VSET1(vTri[0]));
+			vreg vSy = VSUB(vOy, VSET1(vTri[1]));
+			vreg vSz = VSUB(vOz, VSET1(vTri[2]));
+			vreg vUu = VADD(VADD(VMUL(vSx, vPx), VMUL(vSy, vPy)), VMUL(vSz, vPz));
+			vUu = VXOR(vUu, vSign);
+			vMask = VAND(vMask, VAND(VCMPGE(vUu, vZero), VCMPGE(vDet, vUu)));
+			if ((VMOVEMASK(vMask) & vLanes) == 0)
+				continue;
+
+			/* q = s x e1, v = d . q, t = e2 . q */
+			vreg vQx = VSUB(VMUL(vSy, vE1z), VMUL(vSz, vE1y));
+			vreg vQy = VSUB(VMUL(vSz, vE1x), VMUL(vSx, vE1z));
+			vreg vQz = VSUB(VMUL(vSx, vE1y), VMUL(vSy, vE1x));
+			vreg vVv = VADD(VADD(VMUL(vDx, vQx), VMUL(vDy, vQy)), VMUL(vDz, vQz));
+			vreg vTt = VADD(VADD(VMUL(vE2x, vQx), VMUL(vE2y, vQy)), VMUL(vE2z, vQz));
+			vVv = VXOR(vVv, vSign);
+			vTt = VXOR(vTt, vSign);
+			vMask = VAND(vMask, VAND(VCMPGE(vVv, vZero), VCMPGE(vDet, VADD(vUu, vVv))));
+			vMask = VAND(vMask, VAND(VCMPGE(vTt, vZero), VCMPGT(VMUL(vT, vDet), vTt)));
+			vHit = VMOVEMASK(vMask) & vLanes;
+			if (vHit == 0)
+				continue;
+
+			/*
+			 * inactive lanes that pass are real hits nearer than their t as
+			 * well, so they keep them too
+			 */
+			vreg vInv = VDIV(VSET1(1.0f), vDet);
+			vT = VSELECT(vMask, VMUL(vTt, vInv), vT);
+			vU = VSELECT(vMask, VMUL(vUu, vInv), vU);
+			vV = VSELECT(vMask, VMUL(vVv, vInv), vV);
+			vHit = VMOVEMASK(vMask);
+			for (VUINT l = 0; l < VSIMD_LANES; l++)
+				if (vHit & (1u << l))
+					vRays.hit[r + l] = nFirst + i;
+
+			vGot |= vHit << r;
+			if (bAny)
+			{
+				vLanes &= ~vHit;
+				if (vLanes == 0)
+					break;
+			}
+		}
+
+		VSTOREU(vRays.t + r, vT);
+		VSTOREU(vRays.u + r, vU);
+		VSTOREU(vRays.v + r, vV);
+	}
+#else
+	float	fE1[3], fE2[3], fP[3], fS[3], fQ[3];
+	float	fDet, fU, fV, fT, fInv;
+	bool	bBack;
+
+	for (; r < VSIMD_PACKET; r++)
+	{
+		if ((nActive & (1u << r)) == 0)
+			continue;
+
+		const float *vTri = pTris;
+		for (i = 0; i < nCount; i++, vTri += 9)
+		{
+			fE1[0] = vTri[3]; fE1[1] = vTri[4]; fE1[2] = vTri[5];
+			fE2[0] = vTri[6]; fE2[1] = vTri[7]; fE2[2] = vTri[8];
+
+			fP[0] = vRays.dy[r] * fE2[2] - vRays.dz[r] * fE2[1];
+			fP[1] = vRays.dz[r] * fE2[0] - vRays.dx[r] * fE2[2];
+			fP[2] = vRays.dx[r] * fE2[1] - vRays.dy[r] * fE2[0];
+			fDet = fE1[0] * fP[0] + fE1[1] * fP[1] + fE1[2] * fP[2];
+			bBack = fDet < 0.0f;
+			if (bCull && bBack)
+				continue;
+			if (bBack)
+				fDet = -fDet;
+			if (!(fDet > 0.0001f))
+				continue;
+
+			fS[0] = vRays.ox[r] - vTri[0];
+			fS[1] = vRays.oy[r] - vTri[1];
+			fS[2] = vRays.oz[r] - vTri[2];
+			fU = fS[0] * fP[0] + fS[1] * fP[1] + fS[2] * fP[2];
+			if (bBack)
+				fU = -fU;
+			if (fU < 0.0f || fU > fDet)
+				continue;
+
+			fQ[0] = fS[1] * fE1[2] - fS[2] * fE1[1];
+			fQ[1] = fS[2] * fE1[0] - fS[0] * fE1[2];
+			fQ[2] = fS[0] * fE1[1] - fS[1] * fE1[0];
+			fV = vRays.dx[r] * fQ[0] + vRays.dy[r] * fQ[1] + vRays.dz[r] * fQ[2];
+			fT = fE2[0] * fQ[0] + fE2[1] * fQ[1] + fE2[2] * fQ[2];
+			if (bBack)
+			{
+				fV = -fV;
+				fT = -fT;
+			}
+			if (fV < 0.0f || fU + fV > fDet)
+				continue;
+			if (fT < 0.0f || !(vRays.t[r] * fDet > fT))
+				continue;
+
+			fInv = 1.0f / fDet;
+			vRays.t[r] = fT * fInv;
+			vRays.u[r] = fU * fInv;
+			vRays.v[r] = fV * fInv;
+			vRays.hit[r] = nFirst + i;
+			vGot |= 1u << r;
+			if (bAny)
+				break;
+		}
+	}
+#endif
+	return vGot;
+}
+
+} // End Namespace
+
+#define VSIMD_TABLE(name)			\
+	{								\
+		name,						\
+		Length,						\
+		Normalize,					\
+		Cross,						\
+		MatrixMultiply,				\
+		MatrixInverse,				\
+		MatrixAffineInverse,		\
+		MatrixTranspose,			\
+		TransformPoints,			\
+		TransformDirections,		\
+		AffineMultiply,				\
+		AffineInverse,				\
+		AffineOrthoInverse,			\
+		BatchAdd,					\
+		BatchScale,					\
+		BatchCross,					\
+		BatchDot,					\
+		BatchLength,				\
+		BatchNormalize,				\
+		BatchTransformPoints,		\
+		BatchTransformDirections,	\
+		BatchCullAabb,				\
+		BatchRayAabb,				\
+		BatchObbObb,				\
+		BatchObbTriangle,			\
+		BatchQuatMultiply,			\
+		BatchQuatRotate,			\
+		BatchQuatNormalize,			\
+		BatchQuatNlerp,				\
+		BatchQuatSlerp,				\
+		BatchQuatToAffine,			\
+		BatchSinCos,				\
+		BatchRSqrt,					\
+		BatchATan2,					\
+		BatchACos,					\
+		RayPacketBox,				\
+		RayPacketTriangles			\
+	}
@@ -0,0 +1,44 @@
+/*============================================================================*
+ *                                                                            *
+ * 	This file is part of the Viper3D Game Engine.							  *
+ *                                                                            *
+ *	Copyright (C) 2004 UDP Games   All Rights Reserved.						  *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------	------------- *
+ *                                                                            *
+ *============================================================================*/
+#include <viper3d/math/SIMD.h>
+
+/*
+ * SSE4.1 kernels.  Built with -msse4.1 by the makefile; if the compiler
+ * was not told to target SSE4.1 this file contributes nothing and the
+ * dispatcher falls back to a lower tier.
+ */
+#if defined(__SSE4_1__) || (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)))
+#define VSIMD_LANES		4
+#define VSIMD_SSE41		1
+#define VSIMD_FMA		0
+#include "SIMDKernels.inl"
+#define VSIMD_AVAILABLE
+#endif
+
+namespace UDP
+{
+
+#if defined(VSIMD_AVAILABLE)
+static const VSimdKernels sKernels = VSIMD_TABLE("sse41");
+#endif
+
+const VSimdKernels* SimdKernelsSSE41()
+{
+#if defined(VSIMD_AVAILABLE)
+	return &sKernels;
+#else
+	return NULL;
+#endif
+}
+
+} // End Namespace
@@ -0,0 +1,136 @@
+/*============================================================================*
+ *                                                                            *
+ * 	This file is part of the Viper3D Game Engine.							  *
+ *                                                                            *
+ *	Copyright (C) 2004 UDP Games   All Rights Reserved.						  *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------	------------- *
+ *                                                                            *
+ *============================================================================*/
+#include <viper3d/math/SlabRay.h>
+
+/* System Headers */
+
+/* Local Headers */
+
+namespace UDP
+{
+
+/********************************************************************
+ *          C O N S T R U C T I O N / D E S T R U C T I O N         *
+ ********************************************************************/
+VSlabRay::VSlabRay()
+{
+	Set(VRay(VVector(0.0f, 0.0f, 0.0f), VVector(0.0f, 0.0f, 1.0f)));
+}
+
+VSlabRay::VSlabRay(const VRay &ray)
+{
+	Set(ray);
+}
+
+VSlabRay::~VSlabRay()
+{
+
+}
+
+/********************************************************************
+ *                        A T T R I B U T E S                       *
+ ********************************************************************/
+
+/********************************************************************
+ *                        O P E R A T I O N S                       *
+ ********************************************************************/
+
+/*------------------------------------------------------------------*
+ *								 Set()								*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Sets up the ray for box tests.
+ *	@date		17-Oct-2026
+ *
+ *	@param		ray		Ray to test with
+ *
+ *	@remarks	The only divisions of the ray's box tests happen here.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VSlabRay::Set(const VRay &ray)
+{
+	const float *vO = &ray.GetOrigin().x;
+	const float *vD = &ray.GetDirection().x;
+
+	for (int a = 0; a < 3; a++)
+	{
+		mOrig[a] = vO[a];
+		if (VMath::Abs(vD[a]) < 1e-20f)
+			mInv[a] = vD[a] < 0.0f ? -VSLAB_HUGE : VSLAB_HUGE;
+		else
+			mInv[a] = 1.0f / vD[a];
+		mSign[a] = mInv[a] < 0.0f ? 1 : 0;
+	}
+	mOrig[3] = 0.0f;
+	mInv[3] = 0.0f;
+}
+
+/*------------------------------------------------------------------*
+ *							  Intersects()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Tests for intersection with a VAabb.
+ *	@date		17-Oct-2026
+ *
+ *	@param		aabb	Target of testing.
+ *	@param		t		Optional pointer to receive the point on the
+ *						ray where intersection occurs.
+ *
+ *	@remarks	Answers as VRay::Intersects() does: the entry point,
+ *				or the exit point when the ray starts inside the box.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+bool VSlabRay::Intersects(const VAabb &aabb, float *t) const
+{
+	float fNear, fFar;
+
+	Slab(&aabb.GetMin().x, &aabb.GetMax().x, &fNear, &fFar);
+	if (fNear > fFar || fFar < 0.0f)
+		return false;
+	if (t)
+		*t = fNear > 0.0f ? fNear : fFar;
+	return true;
+}
+
+/**
+ *	@overload
+ *
+ *	@param		aabb	Target of testing.
+ *	@param		fL		Line segment end-point.
+ *	@param		t		Optional pointer to receive the point on the
+ *						ray where intersection occurs.
+ */
+bool VSlabRay::Intersects(const VAabb &aabb, float fL, float *t) const
+{
+	float fNear, fFar, tFinal;
+
+	Slab(&aabb.GetMin().x, &aabb.GetMax().x, &fNear, &fFar);
+	tFinal = fNear > 0.0f ? fNear : fFar;
+	if (fNear > fFar || fFar < 0.0f || tFinal > fL)
+		return false;
+	if (t)
+		*t = tFinal;
+	return true;
+}
+
+} // End Namespace
@@ -0,0 +1,347 @@
+/*============================================================================*
+ *                                                                            *
+ * 	This file is part of the Viper3D Game Engine.							  *
+ *                                                                            *
+ *	Copyright (C) 2004 UDP Games   All Rights Reserved.						  *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------	------------- *
+ *                                                                            *
+ *============================================================================*/
+#include <viper3d/math/Broadphase.h>
+
+/* System Headers */
+#include <algorithm>
+
+/* Local Headers */
+
+namespace UDP
+{
+
+#define VSAP_REBUILD_ADDS	32		/* more new proxies than this: sort afresh */
+#define VSAP_MIN_TABLE		64
+
+/*
+ * Order of the ends along an axis.  A min sorts before a max of the same
+ * value, so boxes that only touch still overlap.
+ */
+static inline bool EndLess(float fA, VUINT nA, float fB, VUINT nB)
+{
+	return fA < fB || (fA == fB && (nA & 1) < (nB & 1));
+}
+
+static inline VUINT PairHash(VUINT nA, VUINT nB)
+{
+	VUINT vHash = nA * 0x9E3779B1u ^ (nB + 0x7F4A7C15u) * 0x85EBCA77u;
+	return vHash ^ (vHash >> 15);
+}
+
+/********************************************************************
+ *          C O N S T R U C T I O N / D E S T R U C T I O N         *
+ ********************************************************************/
+VSweepPrune::VSweepPrune()
+{
+
+}
+
+VSweepPrune::~VSweepPrune()
+{
+
+}
+
+/********************************************************************
+ *                         C A L L B A C K S                        *
+ ********************************************************************/
+
+/*------------------------------------------------------------------*
+ *							 UpdatePairs()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Re-sorts the three axes and applies the pair changes.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	The insertion sort swaps exactly the ends whose order
+ *				changed.  A min passing a max on its way down is the
+ *				only way two boxes can start to overlap, so the pair is
+ *				added if the boxes now overlap on every axis; a max
+ *				passing a min means they are now apart on this axis,
+ *				so the pair goes.  New proxies start past the end of
+ *				each axis, which is the same as having been apart.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VSweepPrune::UpdatePairs()
+{
+	if (!mRemoved.empty())
+	{
+		for (VUINT i = (VUINT)mPairs.size(); i-- > 0; )
+		{
+			/* the pair swapped in from the back has been seen already */
+			if (mLive[mPairs[i].mA] == 0 || mLive[mPairs[i].mB] == 0)
+				RemovePair(mPairs[i].mA, mPairs[i].mB);
+		}
+	}
+
+	if (mAdded.size() > VSAP_REBUILD_ADDS ||
+		(mEnds[0].empty() && !mAdded.empty()))
+	{
+		Rebuild();
+		return;
+	}
+
+	for (int a = 0; a < 3; a++)
+	{
+		Refresh(a);
+		Sort(a);
+	}
+}
+
+void VSweepPrune::OnClear()
+{
+	for (int a = 0; a < 3; a++)
+		mEnds[a].clear();
+	mTable.clear();
+	mActive.clear();
+	mSlot.clear();
+}
+
+/********************************************************************
+ *                         I N T E R N A L S                        *
+ ********************************************************************/
+
+bool VSweepPrune::Less(const VEnd &a, const VEnd &b)
+{
+	return EndLess(a.mValue, a.mData, b.mValue, b.mData);
+}
+
+/*
+ * Sorts every axis from scratch and finds the pairs with one sweep
+ * along x.
+ */
+void VSweepPrune::Rebuild()
+{
+	VEnd	vEnd;
+	VUINT	vProxy, vLast;
+
+	mPairs.clear();
+	mTable.assign(VSAP_MIN_TABLE, VBROAD_INVALID);
+
+	for (int a = 0; a < 3; a++)
+	{
+		std::vector<VEnd> &vEnds = mEnds[a];
+
+		vEnds.clear();
+		vEnds.reserve(mCount * 2);
+		for (VUINT p = 0; p < (VUINT)mBoxes.size(); p++)
+		{
+			if (mLive[p] == 0)
+				continue;
+			vEnd.mValue = mBoxes[p].mMin[a];
+			vEnd.mData = p << 1;
+			vEnds.push_back(vEnd);
+			vEnd.mValue = mBoxes[p].mMax[a];
+			vEnd.mData = (p << 1) | 1;
+			vEnds.push_back(vEnd);
+		}
+		std::sort(vEnds.begin(), vEnds.end(), Less);
+	}
+
+	mActive.clear();
+	mSlot.resize(mBoxes.size());
+	for (VUINT i = 0; i < (VUINT)mEnds[0].size(); i++)
+	{
+		vProxy = mEnds[0][i].mData >> 1;
+		if ((mEnds[0][i].mData & 1) == 0)
+		{
+			for (VUINT j = 0; j < (VUINT)mActive.size(); j++)
+				if (Overlaps(vProxy, mActive[j]))
+					AddPair(vProxy, mActive[j]);
+			mSlot[vProxy] = (VUINT)mActive.size();
+			mActive.push_back(vProxy);
+		}
+		else
+		{
+			vLast = mActive.back();
+			mActive[mSlot[vProxy]] = vLast;
+			mSlot[vLast] = mSlot[vProxy];
+			mActive.pop_back();
+		}
+	}
+}
+
+/*
+ * Drops the ends of removed proxies, reloads the values of the rest and
+ * appends the ends of new ones.
+ */
+void VSweepPrune::Refresh(int nAxis)
+{
+	std::vector<VEnd>	&vEnds = mEnds[nAxis];
+	VUINT				vCount = 0;
+	VUINT				vProxy;
+	VEnd				vEnd;
+
+	for (VUINT i = 0; i < (VUINT)vEnds.size(); i++)
+	{
+		vProxy = vEnds[i].mData >> 1;
+		if (mLive[vProxy] == 0)
+			continue;
+		vEnds[vCount].mData = vEnds[i].mData;
+		vEnds[vCount].mValue = (vEnds[i].mData & 1) ? mBoxes[vProxy].mMax[nAxis] :
+							mBoxes[vProxy].mMin[nAxis];
+		vCount++;
+	}
+	vEnds.resize(vCount);
+
+	for (VUINT i = 0; i < (VUINT)mAdded.size(); i++)
+	{
+		vProxy = mAdded[i];
+		if (mLive[vProxy] == 0)
+			continue;
+		vEnd.mValue = mBoxes[vProxy].mMin[nAxis];
+		vEnd.mData = vProxy << 1;
+		vEnds.push_back(vEnd);
+		vEnd.mValue = mBoxes[vProxy].mMax[nAxis];
+		vEnd.mData = (vProxy << 1) | 1;
+		vEnds.push_back(vEnd);
+	}
+}
+
+/*
+ * Insertion sort of one axis, turning each swap of a min and a max into
+ * a pair change.
+ */
+void VSweepPrune::Sort(int nAxis)
+{
+	std::vector<VEnd>	&vEnds = mEnds[nAxis];
+	VEnd				vEnd;
+	VUINT				j;
+
+	for (VUINT i = 1; i < (VUINT)vEnds.size(); i++)
+	{
+		vEnd = vEnds[i];
+		for (j = i; j > 0 && EndLess(vEnd.mValue, vEnd.mData,
+				vEnds[j - 1].mValue, vEnds[j - 1].mData); j--)
+		{
+			const VEnd &vOther = vEnds[j - 1];
+
+			if ((vEnd.mData & 1) == 0 && (vOther.mData & 1) != 0)
+			{
+				if (Overlaps(vEnd.mData >> 1, vOther.mData >> 1))
+					AddPair(vEnd.mData >> 1, vOther.mData >> 1);
+			}
+			else if ((vEnd.mData & 1) != 0 && (vOther.mData & 1) == 0)
+				RemovePair(vEnd.mData >> 1, vOther.mData >> 1);
+
+			vEnds[j] = vOther;
+		}
+		vEnds[j] = vEnd;
+	}
+}
+
+void VSweepPrune::AddPair(VUINT nA, VUINT nB)
+{
+	VBroadPair	vPair;
+	VUINT		vSlot;
+
+	if (nA == nB)
+		return;
+	if (nA > nB)
+		std::swap(nA, nB);
+
+	if ((mPairs.size() + 1) * 2 > mTable.size())
+		GrowTable();
+
+	vSlot = FindSlot(nA, nB);
+	if (mTable[vSlot] != VBROAD_INVALID)
+		return;
+
+	vPair.mA = nA;
+	vPair.mB = nB;
+	mTable[vSlot] = (VUINT)mPairs.size();
+	mPairs.push_back(vPair);
+}
+
+/*
+ * Linear probing, so a removed slot is filled by shifting back the
+ * entries after it that would otherwise become unreachable.
+ */
+void VSweepPrune::RemovePair(VUINT nA, VUINT nB)
+{
+	VUINT	vMask = (VUINT)mTable.size() - 1;
+	VUINT	vSlot, vIndex, vNext, vHome, vLast;
+
+	if (mTable.empty())
+		return;
+	if (nA > nB)
+		std::swap(nA, nB);
+
+	vSlot = FindSlot(nA, nB);
+	vIndex = mTable[vSlot];
+	if (vIndex == VBROAD_INVALID)
+		return;
+
+	for (;;)
+	{
+		mTable[vSlot] = VBROAD_INVALID;
+		vNext = vSlot;
+		for (;;)
+		{
+			vNext = (vNext + 1) & vMask;
+			if (mTable[vNext] == VBROAD_INVALID)
+				break;
+			vHome = PairHash(mPairs[mTable[vNext]].mA, mPairs[mTable[vNext]].mB) & vMask;
+			/* stays put if its home lies in (vSlot, vNext] */
+			if (vSlot <= vNext ? (vSlot < vHome && vHome <= vNext) :
+								(vSlot < vHome || vHome <= vNext))
+				continue;
+			break;
+		}
+		if (mTable[vNext] == VBROAD_INVALID)
+			break;
+		mTable[vSlot] = mTable[vNext];
+		vSlot = vNext;
+	}
+
+	vLast = (VUINT)mPairs.size() - 1;
+	if (vIndex != vLast)
+	{
+		mPairs[vIndex] = mPairs[vLast];
+		mTable[FindSlot(mPairs[vIndex].mA, mPairs[vIndex].mB)] = vIndex;
+	}
+	mPairs.pop_back();
+}
+
+/*
+ * Slot holding the pair, or the empty slot where it would go.
+ */
+VUINT VSweepPrune::FindSlot(VUINT nA, VUINT nB) const
+{
+	VUINT	vMask = (VUINT)mTable.size() - 1;
+	VUINT	vSlot = PairHash(nA, nB) & vMask;
+
+	while (mTable[vSlot] != VBROAD_INVALID)
+	{
+		const VBroadPair &vPair = mPairs[mTable[vSlot]];
+		if (vPair.mA == nA && vPair.mB == nB)
+			break;
+		vSlot = (vSlot + 1) & vMask;
+	}
+	return vSlot;
+}
+
+void VSweepPrune::GrowTable()
+{
+	VUINT vSize = mTable.empty() ? VSAP_MIN_TABLE : (VUINT)mTable.size() * 2;
+
+	mTable.assign(vSize, VBROAD_INVALID);
+	for (VUINT i = 0; i < (VUINT)mPairs.size(); i++)
+		mTable[FindSlot(mPairs[i].mA, mPairs[i].mB)] = i;
+}
+
+} // End Namespace
@@ -0,0 +1,445 @@
+/*============================================================================*
+ *                                                                            *
+ * 	This file is part of the Viper3D Game Engine.							  *
+ *                                                                            *
+ *	Copyright (C) 2004 UDP Games   All Rights Reserved.						  *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------	------------- *
+ *                                                                            *
+ *============================================================================*/
+#include <viper3d/math/TriangleBvh.h>
+
+/* System Headers */
+#include <algorithm>
+
+/* Local Headers */
+
+namespace UDP
+{
+
+#define VTRIBVH_STACK		128		/* traversal stack entries */
+
+/*
+ * Index of the lowest set bit of a non-zero word.
+ */
+static inline VUINT LowestBit(VUINT nWord)
+{
+#if defined(__GNUC__)
+	return (VUINT)__builtin_ctz(nWord);
+#else
+	VUINT vBit = 0;
+	while ((nWord & 1) == 0)
+	{
+		nWord >>= 1;
+		vBit++;
+	}
+	return vBit;
+#endif
+}
+
+/********************************************************************
+ *          C O N S T R U C T I O N / D E S T R U C T I O N         *
+ ********************************************************************/
+VTriangleBvh::VTriangleBvh()
+{
+
+}
+
+VTriangleBvh::~VTriangleBvh()
+{
+
+}
+
+/********************************************************************
+ *                        A T T R I B U T E S                       *
+ ********************************************************************/
+
+/*------------------------------------------------------------------*
+ *							 GetTriangle()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Returns the corners of one triangle.
+ *	@date		17-Oct-2026
+ *
+ *	@param		nTri	Triangle number
+ *	@param		pV0
+ *	@param		pV1
+ *	@param		pV2		Receive the corners, in the order given to Build()
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VTriangleBvh::GetTriangle(VUINT nTri, VVector *pV0, VVector *pV1,
+								VVector *pV2) const
+{
+	const float *vC = &mCorners[nTri * 9];
+
+	pV0->SetValues(vC[0], vC[1], vC[2], 1.0f);
+	pV1->SetValues(vC[3], vC[4], vC[5], 1.0f);
+	pV2->SetValues(vC[6], vC[7], vC[8], 1.0f);
+}
+
+/*------------------------------------------------------------------*
+ *							  GetPolygon()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Finds the polygon a triangle was taken from.
+ *	@date		17-Oct-2026
+ *
+ *	@param		nTri	Triangle number
+ *
+ *	@returns	(VUINT) Index of the polygon, or VRAY_NO_HIT if the
+ *						tree was not built from polygons
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+VUINT VTriangleBvh::GetPolygon(VUINT nTri) const
+{
+	if (mPolyFirst.empty() || nTri >= Count())
+		return VRAY_NO_HIT;
+
+	/* last polygon starting at or before the triangle */
+	return (VUINT)(std::upper_bound(mPolyFirst.begin(), mPolyFirst.end(), nTri) -
+					mPolyFirst.begin()) - 1;
+}
+
+/********************************************************************
+ *                        O P E R A T I O N S                       *
+ ********************************************************************/
+
+/*------------------------------------------------------------------*
+ *								Build()								*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Builds the tree over an indexed triangle list.
+ *	@date		17-Oct-2026
+ *
+ *	@param		pPoints	Vertices
+ *	@param		pIndis	Three vertex indices per triangle
+ *	@param		nNumI	Number of indices
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VTriangleBvh::Build(const VVector *pPoints, const VUINT *pIndis, VUINT nNumI)
+{
+	mCorners.clear();
+	mPolyFirst.clear();
+	mCorners.reserve(nNumI * 3);
+
+	for (VUINT i = 0; i + 2 < nNumI; i += 3)
+		AddTriangle(pPoints[pIndis[i]], pPoints[pIndis[i + 1]],
+					pPoints[pIndis[i + 2]]);
+	Finish();
+}
+
+/**
+ *	@overload
+ *
+ *	@remarks	Takes the triangles of each polygon's index list, the
+ *				same ones VPolygon::Intersects() tests.
+ *
+ *	@param		pPolys		Polygons
+ *	@param		nNumPolys	Number of polygons
+ */
+void VTriangleBvh::Build(const VPolygon *pPolys, VUINT nNumPolys)
+{
+	VUINT vNumI = 0;
+
+	for (VUINT p = 0; p < nNumPolys; p++)
+		vNumI += pPolys[p].GetNumIndis();
+
+	mCorners.clear();
+	mPolyFirst.resize(nNumPolys);
+	mCorners.reserve(vNumI * 3);
+
+	for (VUINT p = 0; p < nNumPolys; p++)
+	{
+		const VVector	*vPoints = pPolys[p].GetPoints();
+		const VUINT		*vIndis = pPolys[p].GetIndices();
+		VUINT			vCount = pPolys[p].GetNumIndis();
+
+		mPolyFirst[p] = Count();
+		for (VUINT i = 0; i + 2 < vCount; i += 3)
+			AddTriangle(vPoints[vIndis[i]], vPoints[vIndis[i + 1]],
+						vPoints[vIndis[i + 2]]);
+	}
+	Finish();
+}
+
+/*------------------------------------------------------------------*
+ *								 Pick()								*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Finds the nearest triangle hit by each ray of a packet.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	Only hits nearer than the one a ray already holds count,
+ *				so picking the same packet against several trees without
+ *				a VRayPacket::Reset() in between leaves the nearest over
+ *				all of them; the triangle number is then only meaningful
+ *				for the tree that last changed it.
+ *
+ *	@param		packet	Rays to trace; receives the hits
+ *	@param		bCull	Skip triangles wound clockwise as seen along the
+ *						ray?
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VTriangleBvh::Pick(VRayPacket &packet, bool bCull /*=false*/) const
+{
+	Trace(packet, bCull, false);
+}
+
+/**
+ *	@overload
+ *
+ *	@param		ray		Ray to trace
+ *	@param		bCull	Skip triangles wound clockwise as seen along the
+ *						ray?
+ *	@param		pTri	Optional; receives the triangle number
+ *	@param		t		Optional; receives the distance along the ray
+ *	@param		fL		Farthest distance that counts
+ *
+ *	@returns	(bool) True if anything was hit
+ */
+bool VTriangleBvh::Pick(const VRay &ray, bool bCull, VUINT *pTri, float *t,
+						float fL /*=VRAY_FAR*/) const
+{
+	VRayPacket vPacket;
+
+	vPacket.Add(ray, fL);
+	Trace(vPacket, bCull, false);
+	if (!vPacket.IsHit(0))
+		return false;
+
+	if (pTri)
+		*pTri = vPacket.GetTriangle(0);
+	if (t)
+		*t = vPacket.GetT(0);
+	return true;
+}
+
+/*------------------------------------------------------------------*
+ *							   Occluded()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Checks which rays of a packet hit anything at all.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	A ray drops out of the traversal at its first hit, and the
+ *				whole query stops once every ray has one.  The hit each
+ *				ray reports is whichever was found first, not the nearest.
+ *
+ *	@param		packet	Rays to trace, each up to its own distance limit
+ *	@param		bCull	Skip triangles wound clockwise as seen along the
+ *						ray?
+ *
+ *	@returns	(VUINT) One bit per ray that hit something
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+VUINT VTriangleBvh::Occluded(VRayPacket &packet, bool bCull /*=false*/) const
+{
+	return Trace(packet, bCull, true) & packet.Mask();
+}
+
+/**
+ *	@overload
+ *
+ *	@param		ray		Ray to trace
+ *	@param		fL		Farthest distance that counts, e.g. the distance
+ *						to a light or another unit
+ *	@param		bCull	Skip triangles wound clockwise as seen along the
+ *						ray?
+ *
+ *	@returns	(bool) True if anything lies in the way
+ */
+bool VTriangleBvh::Occluded(const VRay &ray, float fL, bool bCull /*=false*/) const
+{
+	VRayPacket vPacket;
+
+	vPacket.Add(ray, fL);
+	return Trace(vPacket, bCull, true) != 0;
+}
+
+/********************************************************************
+ *                         I N T E R N A L S                        *
+ ********************************************************************/
+
+void VTriangleBvh::AddTriangle(const VVector &v0, const VVector &v1,
+								const VVector &v2)
+{
+	const float vC[9] = { v0.x, v0.y, v0.z, v1.x, v1.y, v1.z, v2.x, v2.y, v2.z };
+
+	mCorners.insert(mCorners.end(), vC, vC + 9);
+}
+
+/*------------------------------------------------------------------*
+ *								Finish()							*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Bound every triangle and build the VBvh over the boxes		*
+ *		Copy the triangles into the VBvh's leaf order, as the		*
+ *			first corner and the two edges leaving it, so the		*
+ *			packet kernel reads a leaf in one sweep					*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VTriangleBvh::Finish()
+{
+	VUINT				vCount = Count();
+	std::vector<VAabb>	vBoxes(vCount);
+	VVector				vMin, vMax;
+	const float			*vC;
+
+	for (VUINT i = 0; i < vCount; i++)
+	{
+		vC = &mCorners[i * 9];
+		vMin.SetValues(std::min(vC[0], std::min(vC[3], vC[6])),
+					std::min(vC[1], std::min(vC[4], vC[7])),
+					std::min(vC[2], std::min(vC[5], vC[8])), 1.0f);
+		vMax.SetValues(std::max(vC[0], std::max(vC[3], vC[6])),
+					std::max(vC[1], std::max(vC[4], vC[7])),
+					std::max(vC[2], std::max(vC[5], vC[8])), 1.0f);
+		vBoxes[i] = VAabb(vMin, vMax);
+	}
+	mBvh.Build(vCount ? &vBoxes[0] : NULL, vCount);
+
+	const VUINT *vItems = mBvh.GetItems();
+
+	mTris.resize(vCount * 9);
+	mIds.resize(vCount);
+	for (VUINT i = 0; i < vCount; i++)
+	{
+		float *vTri = &mTris[i * 9];
+
+		mIds[i] = vItems[i];
+		vC = &mCorners[vItems[i] * 9];
+		for (int a = 0; a < 3; a++)
+		{
+			vTri[a] = vC[a];
+			vTri[3 + a] = vC[3 + a] - vC[a];
+			vTri[6 + a] = vC[6 + a] - vC[a];
+		}
+	}
+}
+
+/*------------------------------------------------------------------*
+ *								Trace()								*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Push the root with every ray of the packet					*
+ *		Pop a node, keep the rays that hit its box (against their	*
+ *			current nearest hit, so rays shrink as they find hits)	*
+ *		At a leaf, test those rays against its triangles; with		*
+ *			bAny, rays that hit leave the packet for good and the	*
+ *			trace ends once none are left							*
+ *		Otherwise push both children with the surviving rays, the	*
+ *			one nearer along the first ray's direction on top		*
+ *		Map the leaf order positions the kernel recorded back to	*
+ *			triangle numbers										*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+VUINT VTriangleBvh::Trace(VRayPacket &packet, bool bCull, bool bAny) const
+{
+	const VBvhNode	*vNodes = mBvh.GetNodes();
+	VSoARays		vRays = packet.SoA();
+	VUINT			vStack[VTRIBVH_STACK][2];
+	int				vTop;
+	VUINT			vActive = packet.Mask();
+	VUINT			vTouched = 0;
+	VUINT			vMask, vHits, vRay, vLeft;
+	float			fSide;
+
+	if (vNodes == NULL || vActive == 0)
+		return 0;
+
+	vStack[0][0] = 0;
+	vStack[0][1] = vActive;
+	vTop = 1;
+
+	while (vTop > 0)
+	{
+		vTop--;
+		const VBvhNode &vNode = vNodes[vStack[vTop][0]];
+
+		vMask = VSimd::mKernels.RayPacketBox(vRays, vNode.mMin, vNode.mMax,
+											vStack[vTop][1] & vActive);
+		if (vMask == 0)
+			continue;
+
+		if (vNode.mCount > 0)
+		{
+			vHits = VSimd::mKernels.RayPacketTriangles(vRays, &mTris[vNode.mFirst * 9],
+											vNode.mFirst, vNode.mCount, vMask,
+											bCull, bAny);
+			vTouched |= vHits;
+			if (bAny)
+			{
+				vActive &= ~vHits;
+				if (vActive == 0)
+					break;
+			}
+			continue;
+		}
+
+		vLeft = vNode.mFirst;
+		vRay = LowestBit(vMask);
+		const VBvhNode &vL = vNodes[vLeft];
+		const VBvhNode &vR = vNodes[vLeft + 1];
+		fSide = 0.0f;
+		for (int a = 0; a < 3; a++)
+			fSide += (vR.mMin[a] + vR.mMax[a] - vL.mMin[a] - vL.mMax[a]) *
+					packet.mDir[a][vRay];
+
+		if (fSide >= 0.0f)
+		{
+			vStack[vTop][0] = vLeft + 1;
+			vStack[vTop + 1][0] = vLeft;
+		}
+		else
+		{
+			vStack[vTop][0] = vLeft;
+			vStack[vTop + 1][0] = vLeft + 1;
+		}
+		vStack[vTop][1] = vMask;
+		vStack[vTop + 1][1] = vMask;
+		vTop += 2;
+	}
+
+	for (VUINT i = 0; i < VSIMD_PACKET; i++)
+		if (vTouched & (1u << i))
+			packet.mHit[i] = mIds[packet.mHit[i]];
+	return vTouched;
+}
+
+} // End Namespace
@@ -0,0 +1,450 @@
+/*============================================================================*
+ *                                                                            *
+ * 	This file is part of the Viper3D Game Engine.							  *
+ *                                                                            *
+ *	Copyright (C) 2004 UDP Games   All Rights Reserved.						  *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------	------------- *
+ *                                                                            *
+ *============================================================================*/
+#include <viper3d/math/VectorBatch.h>
+
+/* System Headers */
+#include <cstdlib>
+#include <cstring>
+
+/* Local Headers */
+
+namespace UDP
+{
+
+/*
+ * Rounds a count up to the padding granularity of the component arrays.
+ */
+static inline VUINT PadCount(VUINT nCount)
+{
+	return (nCount + VBATCH_WIDTH - 1) & ~(VUINT)(VBATCH_WIDTH - 1);
+}
+
+/********************************************************************
+ *          C O N S T R U C T I O N / D E S T R U C T I O N         *
+ ********************************************************************/
+VVectorBatch::VVectorBatch(VUINT nCount /*=0*/)
+: mBlock(NULL), mX(NULL), mY(NULL), mZ(NULL), mCount(0), mCapacity(0)
+{
+	Resize(nCount);
+}
+
+VVectorBatch::VVectorBatch(const VVector *pVecs, VUINT nCount)
+: mBlock(NULL), mX(NULL), mY(NULL), mZ(NULL), mCount(0), mCapacity(0)
+{
+	FromVectors(pVecs, nCount);
+}
+
+VVectorBatch::VVectorBatch(const VVectorBatch &batch)
+: mBlock(NULL), mX(NULL), mY(NULL), mZ(NULL), mCount(0), mCapacity(0)
+{
+	*this = batch;
+}
+
+VVectorBatch::~VVectorBatch()
+{
+	free(mBlock);
+}
+
+/********************************************************************
+ *                        O P E R A T I O N S                       *
+ ********************************************************************/
+
+/*------------------------------------------------------------------*
+ *								Resize()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Changes the number of vectors held by this batch.
+ *	@date		17-Oct-2026
+ *
+ *	@param		nCount	New number of vectors
+ *
+ *	@remarks	Existing contents are preserved up to the new count and
+ *				new elements are zeroed.  If the storage cannot be grown
+ *				the batch is left unchanged.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VVectorBatch::Resize(VUINT nCount)
+{
+	VUINT vOld = mCount;
+
+	Reserve(nCount);
+	if (nCount > mCapacity)
+		return;
+
+	if (nCount > vOld)
+	{
+		memset(mX + vOld, 0, (nCount - vOld) * sizeof(float));
+		memset(mY + vOld, 0, (nCount - vOld) * sizeof(float));
+		memset(mZ + vOld, 0, (nCount - vOld) * sizeof(float));
+	}
+	mCount = nCount;
+}
+
+/*------------------------------------------------------------------*
+ *							  FromVectors()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Fills this batch from an array of VVector.
+ *	@date		17-Oct-2026
+ *
+ *	@param		pVecs	Source vectors
+ *	@param		nCount	Number of vectors in pVecs
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VVectorBatch::FromVectors(const VVector *pVecs, VUINT nCount)
+{
+	Resize(nCount);
+	for (VUINT i = 0; i < mCount; i++)
+	{
+		mX[i] = pVecs[i].x;
+		mY[i] = pVecs[i].y;
+		mZ[i] = pVecs[i].z;
+	}
+}
+
+/*------------------------------------------------------------------*
+ *							   ToVectors()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Copies this batch out to an array of VVector.
+ *	@date		17-Oct-2026
+ *
+ *	@param		pVecs	Destination, must hold at least Count() vectors
+ *
+ *	@remarks	Only x, y and z are written.  The w component of each
+ *				destination vector is left untouched.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VVectorBatch::ToVectors(VVector *pVecs) const
+{
+	for (VUINT i = 0; i < mCount; i++)
+	{
+		pVecs[i].x = mX[i];
+		pVecs[i].y = mY[i];
+		pVecs[i].z = mZ[i];
+	}
+}
+
+/*------------------------------------------------------------------*
+ *								 Add()								*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Adds another batch to this one, element by element.
+ *	@date		17-Oct-2026
+ *
+ *	@param		batch	Batch to add
+ *
+ *	@remarks	Only the elements both batches have are added to; if
+ *				batch is shorter, the rest of this one is left as it is
+ *				and Count() does not change.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VVectorBatch::Add(const VVectorBatch &batch)
+{
+	VUINT vCount = (mCount < batch.mCount ? mCount : batch.mCount);
+
+	VSimd::mKernels.BatchAdd(SoA(), SoA(), batch.SoA(), vCount);
+}
+
+/*------------------------------------------------------------------*
+ *								 Add()								*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Stores the element-wise sum of two batches in this one.
+ *	@date		17-Oct-2026
+ *
+ *	@param		b1	First operand
+ *	@param		b2	Second operand
+ *
+ *	@remarks	The result holds as many elements as the smaller of the
+ *				two operands.  Either operand may be this batch.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VVectorBatch::Add(const VVectorBatch &b1, const VVectorBatch &b2)
+{
+	VUINT vCount = (b1.mCount < b2.mCount ? b1.mCount : b2.mCount);
+
+	if (this != &b1 && this != &b2)
+		Resize(vCount);
+	else
+		mCount = vCount;
+
+	VSimd::mKernels.BatchAdd(SoA(), b1.SoA(),
+			b2.SoA(), mCount);
+}
+
+/*------------------------------------------------------------------*
+ *								 Scale()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Multiplies every vector in the batch by a scalar.
+ *	@date		17-Oct-2026
+ *
+ *	@param		fScale	Scale factor
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VVectorBatch::Scale(float fScale)
+{
+	VSimd::mKernels.BatchScale(SoA(), fScale, mCount);
+}
+
+/*------------------------------------------------------------------*
+ *								 Cross()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Stores the element-wise cross product b1 x b2 in this
+ *				batch.
+ *	@date		17-Oct-2026
+ *
+ *	@param		b1	Left operand
+ *	@param		b2	Right operand
+ *
+ *	@remarks	Same semantics as VVector::Cross().  Either operand may
+ *				be this batch.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VVectorBatch::Cross(const VVectorBatch &b1, const VVectorBatch &b2)
+{
+	VUINT vCount = (b1.mCount < b2.mCount ? b1.mCount : b2.mCount);
+
+	if (this != &b1 && this != &b2)
+		Resize(vCount);
+	else
+		mCount = vCount;
+
+	VSimd::mKernels.BatchCross(SoA(), b1.SoA(),
+			b2.SoA(), mCount);
+}
+
+/*------------------------------------------------------------------*
+ *								  Dot()								*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Computes the dot product of each vector in this batch
+ *				with the corresponding vector in another.
+ *	@date		17-Oct-2026
+ *
+ *	@param		batch	Other operand
+ *	@param		pOut	Receives one float per element; must hold the
+ *						smaller of the two counts.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VVectorBatch::Dot(const VVectorBatch &batch, float *pOut) const
+{
+	VUINT vCount = (mCount < batch.mCount ? mCount : batch.mCount);
+
+	VSimd::mKernels.BatchDot(pOut, SoA(),
+			batch.SoA(), vCount);
+}
+
+/*------------------------------------------------------------------*
+ *								 Length()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Computes the length of every vector in the batch.
+ *	@date		17-Oct-2026
+ *
+ *	@param		pOut	Receives Count() lengths
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VVectorBatch::Length(float *pOut) const
+{
+	VSimd::mKernels.BatchLength(pOut, SoA(), mCount);
+}
+
+/*------------------------------------------------------------------*
+ *							   Normalize()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Normalizes every vector in the batch.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	Zero-length vectors are left untouched, matching
+ *				VVector::Normalize().  Uses a full-precision square root
+ *				rather than rsqrtps so every SIMD tier agrees.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VVectorBatch::Normalize()
+{
+	VSimd::mKernels.BatchNormalize(SoA(), mCount);
+}
+
+/*------------------------------------------------------------------*
+ *							TransformPoints()						*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Transforms every vector in the batch as a point.
+ *	@date		17-Oct-2026
+ *
+ *	@param		mat		Affine transformation
+ *
+ *	@remarks	Uses the same row-vector convention as
+ *				VVector::operator*(const VMatrix&), with the translation
+ *				in row 3.  The matrix is assumed to be affine, so no
+ *				perspective divide is performed.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VVectorBatch::TransformPoints(const VMatrix &mat)
+{
+	VSimd::mKernels.BatchTransformPoints(SoA(), mat[0], mCount);
+}
+
+/*------------------------------------------------------------------*
+ *						  TransformDirections()						*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Transforms every vector in the batch as a direction.
+ *	@date		17-Oct-2026
+ *
+ *	@param		mat		Transformation; only the upper 3x3 is used
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VVectorBatch::TransformDirections(const VMatrix &mat)
+{
+	VSimd::mKernels.BatchTransformDirections(SoA(), mat[0], mCount);
+}
+
+/********************************************************************
+ *                         O P E R A T O R S                        *
+ ********************************************************************/
+const VVectorBatch& VVectorBatch::operator=(const VVectorBatch &batch)
+{
+	if (this == &batch)
+		return *this;
+
+	Resize(batch.mCount);
+	memcpy(mX, batch.mX, mCount * sizeof(float));
+	memcpy(mY, batch.mY, mCount * sizeof(float));
+	memcpy(mZ, batch.mZ, mCount * sizeof(float));
+	return *this;
+}
+
+/********************************************************************
+ *                         I N T E R N A L S                        *
+ ********************************************************************/
+
+/*------------------------------------------------------------------*
+ *								Reserve()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Makes sure the component arrays can hold nCount
+ *				elements, reallocating if necessary.
+ *	@date		17-Oct-2026
+ *
+ *	@param		nCount	Number of elements required
+ *
+ *	@remarks	All three arrays share one allocation.  Each array is
+ *				aligned to VBATCH_ALIGN and the capacity is a multiple of
+ *				VBATCH_WIDTH, so every array start is aligned as well.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VVectorBatch::Reserve(VUINT nCount)
+{
+	VUINT	vCapacity;
+	char	*vBlock;
+	float	*vX;
+	size_t	vOffset;
+
+	if (nCount <= mCapacity)
+		return;
+
+	vCapacity = PadCount(nCount);
+	vBlock = (char*)malloc(3 * vCapacity * sizeof(float) + VBATCH_ALIGN);
+	if (vBlock == NULL)
+		return;
+	memset(vBlock, 0, 3 * vCapacity * sizeof(float) + VBATCH_ALIGN);
+
+	vOffset = (VBATCH_ALIGN - ((size_t)vBlock & (VBATCH_ALIGN - 1))) & (VBATCH_ALIGN - 1);
+	vX = (float*)(vBlock + vOffset);
+
+	if (mCount > 0)
+	{
+		memcpy(vX, mX, mCount * sizeof(float));
+		memcpy(vX + vCapacity, mY, mCount * sizeof(float));
+		memcpy(vX + 2 * vCapacity, mZ, mCount * sizeof(float));
+	}
+	free(mBlock);
+
+	mBlock = vBlock;
+	mX = vX;
+	mY = vX + vCapacity;
+	mZ = vX + 2 * vCapacity;
+	mCapacity = vCapacity;
+}
+
+} // End Namespace
@@ -0,0 +1,48 @@
+/*============================================================================*
+ *                                                                            *
+ *  This file is part of the Viper3D Game Engine.                             *
+ *                                                                            *
+ *  Copyright (C) 2004 UDP Games   All Rights Reserved.                       *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------  ------------- *
+ *                                                                            *
+ *============================================================================*/
+#include "NullRenderSystem.h"
+
+namespace UDP
+{
+
+/*
+ * Named for this plugin, so its vtables never clash with another
+ * plugin's when both are in one process.
+ */
+class VNullRenderCreate : public DLL_RENDERCREATE
+{
+public:
+	void operator()(VRenderSystem **pRender)
+	{
+		*pRender = dynamic_cast<VRenderSystem*>(new VNullRenderSystem());
+	}
+};
+
+class VNullRenderDestroy : public DLL_RENDERDESTROY
+{
+public:
+	void operator()(VRenderSystem *pRender)
+	{
+		delete dynamic_cast<VRenderSystem*>(pRender);
+	}
+};
+
+/* creation functions */
+extern "C" {
+_ViperExport
+VNullRenderCreate Construct;
+_ViperExport
+VNullRenderDestroy Destruct;
+} // extern "C"
+
+} // End Namespace
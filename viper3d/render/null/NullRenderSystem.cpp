@@ -0,0 +1,408 @@
+/*============================================================================*
+ *                                                                            *
+ *  This file is part of the Viper3D Game Engine.                             *
+ *                                                                            *
+ *  Copyright (C) 2004 UDP Games   All Rights Reserved.                       *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------  ------------- *
+ *                                                                            *
+ *============================================================================*/
+#include "NullRenderSystem.h"
+
+/* System Headers */
+#include <viper3d/util/Log.h>
+#include <cstring>
+
+/* Local Headers */
+#include "NullWindow.h"
+#include <viper3d/Profiler.h>
+#include <viper3d/RenderQueue.h>
+
+namespace UDP
+{
+
+/* Static Variables */
+static char __CLASS__[] = "[ NullRender   ]";
+
+/********************************************************************
+ *																	*
+ *          C O N S T R U C T I O N / D E S T R U C T I O N         *
+ *																	*
+ ********************************************************************/
+VNullRenderSystem::VNullRenderSystem()
+	: mRecording(true), mView(VMatrix::MATRIX_IDENTITY),
+	  mWorldView(VMatrix::MATRIX_IDENTITY)
+{
+	mDblBuffered = true;
+	ClearRecord();
+}
+
+VNullRenderSystem::~VNullRenderSystem()
+{
+	Shutdown();
+}
+
+/********************************************************************
+ *																	*
+ *                        A T T R I B U T E S                       *
+ *																	*
+ ********************************************************************/
+bool VNullRenderSystem::GetMeshDesc(VMeshHandle hMesh, VMeshDesc *pDesc) const
+{
+	const VNullMesh *vMesh = GetMesh(hMesh);
+
+	if (vMesh == NULL)
+		return false;
+	*pDesc = vMesh->mDesc;
+	return true;
+}
+
+/**
+ *	The vertices last uploaded to a mesh, or NULL if it has none.
+ */
+const void* VNullRenderSystem::GetMeshVerts(VMeshHandle hMesh) const
+{
+	const VNullMesh *vMesh = GetMesh(hMesh);
+
+	if (vMesh == NULL || vMesh->mVerts.empty())
+		return NULL;
+	return &vMesh->mVerts[0];
+}
+
+const VUINT* VNullRenderSystem::GetMeshIndis(VMeshHandle hMesh) const
+{
+	const VNullMesh *vMesh = GetMesh(hMesh);
+
+	if (vMesh == NULL || vMesh->mIndis.empty())
+		return NULL;
+	return &vMesh->mIndis[0];
+}
+
+/********************************************************************
+ *																	*
+ *                        O P E R A T I O N S                       *
+ *																	*
+ ********************************************************************/
+bool VNullRenderSystem::Init(void)
+{
+	VTRACE(_CL("NULL renderer, nothing will be displayed.\n"));
+	return true;
+}
+
+void VNullRenderSystem::Shutdown(void)
+{
+	DestroyMeshes();
+}
+
+VWindow* VNullRenderSystem::CreateWin(VWindowOpts *pOpts)
+{
+	VNullWindow *vWindow = new VNullWindow();
+
+	if (vWindow->Create(pOpts))
+		return vWindow;
+
+	delete vWindow;
+	return NULL;
+}
+
+void VNullRenderSystem::DestroyWin(VWindow *pWin)
+{
+	/* meshes live as long as the window, as they do with GL */
+	DestroyMeshes();
+	pWin->Destroy();
+	delete pWin;
+}
+
+/*------------------------------------------------------------------*
+ *								Render()							*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Take the camera's view-projection, without the GL calls		*
+ *			VCamera::Render() would make							*
+ *		Draw the queue												*
+ *		Swap, record the present and close the frame				*
+ *																	*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+bool VNullRenderSystem::Render(VWindow *pWin, VCamera *pCamera,
+							VRenderQueue *pQueue /*=NULL*/)
+{
+	VUINT64 vNow;
+
+	mView = pCamera->GetViewProjection();
+	SetWorldMatrix(VMatrix::MATRIX_IDENTITY);
+
+	if (pQueue != NULL)
+		DrawQueue(pQueue);
+
+	if (mDblBuffered)
+		pWin->SwapBuffers();
+
+	Record(NULLOP_PRESENT, 0, (VUINT)mFrames.size(), 0);
+	vNow = VProfiler::GetTicks();
+	mFrame.mTicks = vNow - mFrameStart;
+	mFrames.push_back(mFrame);
+	memset(&mFrame, 0, sizeof(mFrame));
+	mFrameStart = vNow;
+	return true;
+}
+
+/*------------------------------------------------------------------*
+ *							  CreateMesh()							*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Reuse a destroyed handle if there is one					*
+ *		Copy the contents, as a driver copies them into its own		*
+ *			storage													*
+ *																	*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+VMeshHandle VNullRenderSystem::CreateMesh(const VMeshDesc& desc, const void *pVerts,
+										const VUINT *pIndis)
+{
+	VMeshHandle	vHandle;
+	VNullMesh	*vMesh;
+	VUINT		vBytes;
+
+	if (!mFree.empty())
+	{
+		vHandle = mFree.back();
+		mFree.pop_back();
+	}
+	else
+	{
+		mMeshes.push_back(VNullMesh());
+		vHandle = (VMeshHandle)mMeshes.size();
+	}
+
+	vMesh = &mMeshes[vHandle - 1];
+	vMesh->mDesc = desc;
+	vMesh->mLive = true;
+	vBytes = Upload(vMesh, pVerts, desc.mNumVerts, pIndis, desc.mNumIndis);
+	if (pIndis == NULL)
+		vMesh->mIndis.resize(desc.mNumIndis);
+	Record(NULLOP_CREATE_MESH, vHandle, vBytes, desc.mNumVerts);
+	return vHandle;
+}
+
+bool VNullRenderSystem::UpdateMesh(VMeshHandle hMesh, const void *pVerts,
+								VUINT nNumVerts, const VUINT *pIndis /*=NULL*/,
+								VUINT nNumIndis /*=0*/)
+{
+	VNullMesh	*vMesh = GetMesh(hMesh);
+	VUINT		vBytes;
+
+	if (vMesh == NULL)
+		return false;
+
+	vBytes = Upload(vMesh, pVerts, nNumVerts, pIndis, nNumIndis);
+	Record(NULLOP_UPDATE_MESH, hMesh, vBytes, nNumVerts);
+	return true;
+}
+
+void VNullRenderSystem::DestroyMesh(VMeshHandle hMesh)
+{
+	VNullMesh *vMesh = GetMesh(hMesh);
+
+	if (vMesh == NULL)
+		return;
+
+	/* swap, so the storage really goes as a driver's would */
+	std::vector<VBYTE>().swap(vMesh->mVerts);
+	std::vector<VUINT>().swap(vMesh->mIndis);
+	vMesh->mLive = false;
+	mFree.push_back(hMesh);
+	Record(NULLOP_DESTROY_MESH, hMesh, 0, 0);
+}
+
+/**
+ *	Concatenates the transform with the camera's, as the GL backend
+ *	does, so the CPU cost is comparable.
+ */
+void VNullRenderSystem::SetWorldMatrix(const VMatrix& mat)
+{
+	mWorldView = mView * mat;
+	mFrame.mWorlds++;
+	Record(NULLOP_SET_WORLD, 0, 0, 0);
+}
+
+bool VNullRenderSystem::DrawMesh(VMeshHandle hMesh)
+{
+	VUINT vFirst = 0, vCount = 0;
+
+	return DrawMeshRanges(hMesh, &vFirst, &vCount, 1);
+}
+
+/*------------------------------------------------------------------*
+ *							DrawMeshRanges()						*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Count the elements drawn, a count of 0 meaning the whole	*
+ *			mesh, clipping ranges that run off its end				*
+ *		Record one draw												*
+ *																	*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+bool VNullRenderSystem::DrawMeshRanges(VMeshHandle hMesh, const VUINT *pFirsts,
+									const VUINT *pCounts, VUINT nRanges)
+{
+	const VNullMesh	*vMesh = GetMesh(hMesh);
+	VUINT			vAll, vElements = 0;
+
+	if (vMesh == NULL)
+		return false;
+
+	vAll = vMesh->mDesc.mNumIndis > 0 ? vMesh->mDesc.mNumIndis : vMesh->mDesc.mNumVerts;
+	for (VUINT r = 0; r < nRanges; r++)
+	{
+		if (pCounts[r] == 0)
+			vElements += vAll;
+		else if (pFirsts[r] < vAll)
+			vElements += pCounts[r] < vAll - pFirsts[r] ? pCounts[r] : vAll - pFirsts[r];
+	}
+
+	mFrame.mDraws++;
+	mFrame.mRanges += nRanges;
+	mFrame.mElements += vElements;
+	Record(NULLOP_DRAW, hMesh, nRanges, vElements);
+	return true;
+}
+
+void VNullRenderSystem::SetState(VUINT nMaterial, VUINT nTexture)
+{
+	mFrame.mStateChanges++;
+	Record(NULLOP_SET_STATE, 0, nMaterial, nTexture);
+}
+
+/*------------------------------------------------------------------*
+ *							 ClearRecord()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Forgets the recorded commands and frames, keeping the
+ *				storage, and starts a new frame.
+ *	@date		17-Oct-2026
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VNullRenderSystem::ClearRecord()
+{
+	mCommands.clear();
+	mFrames.clear();
+	memset(&mFrame, 0, sizeof(mFrame));
+	mFrameStart = VProfiler::GetTicks();
+}
+
+/********************************************************************
+ *																	*
+ *                          O P E R A T O R S                       *
+ *																	*
+ ********************************************************************/
+
+/********************************************************************
+ *																	*
+ *                          C A L L B A C K S                       *
+ *																	*
+ ********************************************************************/
+
+/********************************************************************
+ *																	*
+ *                          I N T E R N A L S                       *
+ *																	*
+ ********************************************************************/
+const VNullRenderSystem::VNullMesh* VNullRenderSystem::GetMesh(VMeshHandle hMesh) const
+{
+	if (hMesh == 0 || hMesh > mMeshes.size() || !mMeshes[hMesh - 1].mLive)
+		return NULL;
+	return &mMeshes[hMesh - 1];
+}
+
+VNullRenderSystem::VNullMesh* VNullRenderSystem::GetMesh(VMeshHandle hMesh)
+{
+	if (hMesh == 0 || hMesh > mMeshes.size() || !mMeshes[hMesh - 1].mLive)
+		return NULL;
+	return &mMeshes[hMesh - 1];
+}
+
+/*------------------------------------------------------------------*
+ *								Upload()							*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Copy the vertices, and the indices if given, over the		*
+ *			mesh's storage, growing it if needed					*
+ *		Update the mesh's counts and the frame's totals				*
+ *																	*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+VUINT VNullRenderSystem::Upload(VNullMesh *pMesh, const void *pVerts, VUINT nNumVerts,
+								const VUINT *pIndis, VUINT nNumIndis)
+{
+	VUINT vVertBytes = nNumVerts * GetVertexSize(pMesh->mDesc.mFormat);
+	VUINT vBytes = 0;
+
+	pMesh->mVerts.resize(vVertBytes);
+	pMesh->mDesc.mNumVerts = nNumVerts;
+	if (pVerts != NULL && vVertBytes > 0)
+	{
+		memcpy(&pMesh->mVerts[0], pVerts, vVertBytes);
+		vBytes += vVertBytes;
+	}
+	if (pIndis != NULL)
+	{
+		pMesh->mIndis.assign(pIndis, pIndis + nNumIndis);
+		pMesh->mDesc.mNumIndis = nNumIndis;
+		vBytes += nNumIndis * sizeof(VUINT);
+	}
+
+	mFrame.mUploads++;
+	mFrame.mUploadBytes += vBytes;
+	return vBytes;
+}
+
+void VNullRenderSystem::Record(VNullOp nOp, VMeshHandle hMesh, VUINT nArg0, VUINT nArg1)
+{
+	VNullCommand vCommand;
+
+	mFrame.mCommands++;
+	if (!mRecording)
+		return;
+
+	vCommand.mOp = nOp;
+	vCommand.mMesh = hMesh;
+	vCommand.mArg0 = nArg0;
+	vCommand.mArg1 = nArg1;
+	vCommand.mTicks = VProfiler::GetTicks();
+	mCommands.push_back(vCommand);
+}
+
+void VNullRenderSystem::DestroyMeshes()
+{
+	mMeshes.clear();
+	mFree.clear();
+}
+
+} // End Namespace
+
+/* vi: set ts=4: */
@@ -0,0 +1,223 @@
+/*============================================================================*
+ *                                                                            *
+ *  This file is part of the Viper3D Game Engine.                             *
+ *                                                                            *
+ *  Copyright (C) 2004 UDP Games   All Rights Reserved.                       *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------  ------------- *
+ *                                                                            *
+ *============================================================================*/
+#if !defined(__NULLRENDERSYSTEM_H_INCLUDED__)
+#define __NULLRENDERSYSTEM_H_INCLUDED__
+
+/* System Headers */
+#include <vector>
+
+/* Local Headers */
+#include <viper3d/RenderSystem.h>
+
+namespace UDP
+{
+
+/**
+ *	What a recorded command did.
+ */
+enum VNullOp
+{
+	NULLOP_CREATE_MESH,		/**< mArg0 bytes uploaded, mArg1 vertices */
+	NULLOP_UPDATE_MESH,		/**< mArg0 bytes uploaded, mArg1 vertices */
+	NULLOP_DESTROY_MESH,
+	NULLOP_SET_WORLD,
+	NULLOP_SET_STATE,		/**< mArg0 material, mArg1 texture */
+	NULLOP_DRAW,			/**< mArg0 ranges, mArg1 elements */
+	NULLOP_PRESENT			/**< mArg0 frame number */
+};
+
+/**
+ *	One call into a VNullRenderSystem, in the order it was made.
+ */
+struct VNullCommand
+{
+	VNullOp		mOp;
+	VMeshHandle	mMesh;		/**< 0 when no mesh is involved */
+	VUINT		mArg0;
+	VUINT		mArg1;
+	VUINT64		mTicks;		/**< VProfiler::GetTicks() when it was made */
+};
+
+/**
+ *	Totals of one frame, from the end of the last Render() to the end
+ *	of this one.
+ */
+struct VNullFrame
+{
+	VUINT		mCommands;
+	VUINT		mDraws;
+	VUINT		mRanges;
+	VUINT		mElements;		/**< indices, or vertices, drawn */
+	VUINT		mStateChanges;
+	VUINT		mWorlds;		/**< SetWorldMatrix() calls */
+	VUINT		mUploads;
+	VUINT		mUploadBytes;
+	VUINT64		mTicks;			/**< CPU time the frame took to submit */
+};
+
+/**
+ *	@class		VNullRenderSystem
+ *
+ *	@brief		Render system that draws nothing and records everything.
+ *	@version	0.1.0
+ *	@date		17-Oct-2026
+ *	@remarks	Needs neither a display nor a GPU.  Meshes are copied into
+ *				system memory, as a driver would copy them, and every
+ *				upload, state change, transform and draw is appended to
+ *				a time stamped command stream, so the CPU cost of
+ *				submitting a frame can be measured and the submitted
+ *				work checked, the same on every machine.  Each Render()
+ *				closes a VNullFrame with the frame's totals.  Recording
+ *				the command stream can be turned off with SetRecording()
+ *				for long runs; the frame totals are always kept.
+ */
+class VNullRenderSystem : public VRenderSystem
+{
+public:
+	/*==================================*
+	 *	   CONSTRUCTION/DESTRUCTION		*
+	 *==================================*/
+	VNullRenderSystem(void);
+	virtual ~VNullRenderSystem(void);
+
+	/*==================================*
+	 *	        INITIALIZATION			*
+	 *==================================*/
+	bool			Init(void);
+
+	/*==================================*
+	 *	           CLEANUP    			*
+	 *==================================*/
+	void			Shutdown(void);
+
+	/*==================================*
+	 *			  ATTRIBUTES			*
+	 *==================================*/
+	void			SetRecording(bool bRecording);
+	bool			IsRecording() const;
+	const std::vector<VNullCommand>&	GetCommands() const;
+	const std::vector<VNullFrame>&		GetFrames() const;
+	const VNullFrame&					GetCurrentFrame() const;
+	const VMatrix&	GetWorldView() const;
+	bool			GetMeshDesc(VMeshHandle hMesh, VMeshDesc *pDesc) const;
+	const void*		GetMeshVerts(VMeshHandle hMesh) const;
+	const VUINT*	GetMeshIndis(VMeshHandle hMesh) const;
+
+	/*==================================*
+	 *			  OPERATIONS			*
+	 *==================================*/
+	VWindow*		CreateWin(VWindowOpts *pOpts);
+	void			DestroyWin(VWindow *pWin);
+	bool			Render(VWindow *pWin, VCamera *pCamera,
+							VRenderQueue *pQueue = NULL);
+	VMeshHandle		CreateMesh(const VMeshDesc& desc, const void *pVerts,
+							const VUINT *pIndis);
+	bool			UpdateMesh(VMeshHandle hMesh, const void *pVerts,
+							VUINT nNumVerts, const VUINT *pIndis = NULL,
+							VUINT nNumIndis = 0);
+	void			DestroyMesh(VMeshHandle hMesh);
+	void			SetWorldMatrix(const VMatrix& mat);
+	bool			DrawMesh(VMeshHandle hMesh);
+	bool			DrawMeshRanges(VMeshHandle hMesh, const VUINT *pFirsts,
+							const VUINT *pCounts, VUINT nRanges);
+	void			SetState(VUINT nMaterial, VUINT nTexture);
+	void			ClearRecord();
+
+protected:
+	/*==================================*
+	 *             CALLBACKS			*
+	 *==================================*/
+
+private:
+	/*==================================*
+	 *             INTERNALS            *
+	 *==================================*/
+	/**
+	 *	A mesh's contents, kept where a driver would keep its copy.
+	 */
+	struct VNullMesh
+	{
+		VMeshDesc			mDesc;
+		std::vector<VBYTE>	mVerts;
+		std::vector<VUINT>	mIndis;
+		bool				mLive;
+	};
+
+	const VNullMesh*	GetMesh(VMeshHandle hMesh) const;
+	VNullMesh*			GetMesh(VMeshHandle hMesh);
+	VUINT			Upload(VNullMesh *pMesh, const void *pVerts, VUINT nNumVerts,
+							const VUINT *pIndis, VUINT nNumIndis);
+	void			Record(VNullOp nOp, VMeshHandle hMesh, VUINT nArg0, VUINT nArg1);
+	void			DestroyMeshes();
+
+private:
+	/*==================================*
+	 *             VARIABLES            *
+	 *==================================*/
+	std::vector<VNullMesh>		mMeshes;	/**< handle - 1 indexes this */
+	std::vector<VMeshHandle>	mFree;		/**< destroyed handles to reuse */
+	std::vector<VNullCommand>	mCommands;
+	std::vector<VNullFrame>		mFrames;
+	VNullFrame					mFrame;		/**< the frame being submitted */
+	VUINT64						mFrameStart;
+	bool						mRecording;
+	VMatrix						mView;		/**< camera view-projection */
+	VMatrix						mWorldView;	/**< what a device would load */
+};
+
+inline
+void VNullRenderSystem::SetRecording(bool bRecording)
+{
+	mRecording = bRecording;
+}
+
+inline
+bool VNullRenderSystem::IsRecording() const
+{
+	return mRecording;
+}
+
+inline
+const std::vector<VNullCommand>& VNullRenderSystem::GetCommands() const
+{
+	return mCommands;
+}
+
+/**
+ *	Frames closed by Render() since the last ClearRecord().
+ */
+inline
+const std::vector<VNullFrame>& VNullRenderSystem::GetFrames() const
+{
+	return mFrames;
+}
+
+inline
+const VNullFrame& VNullRenderSystem::GetCurrentFrame() const
+{
+	return mFrame;
+}
+
+/**
+ *	The last SetWorldMatrix() transform concatenated with the camera's
+ *	view-projection, as the GL backend would load it.
+ */
+inline
+const VMatrix& VNullRenderSystem::GetWorldView() const
+{
+	return mWorldView;
+}
+
+} // End Namespace
+
+#endif // __NULLRENDERSYSTEM_H_INCLUDED__
@@ -0,0 +1,82 @@
+/*============================================================================*
+ *                                                                            *
+ *  This file is part of the Viper3D Game Engine.                             *
+ *                                                                            *
+ *  Copyright (C) 2004 UDP Games   All Rights Reserved.                       *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------  ------------- *
+ *                                                                            *
+ *============================================================================*/
+#include "NullWindow.h"
+
+/* System Headers */
+
+/* Local Headers */
+
+
+namespace UDP
+{
+
+/********************************************************************
+ *          C O N S T R U C T I O N / D E S T R U C T I O N         *
+ ********************************************************************/
+VNullWindow::VNullWindow()
+	: mSwaps(0)
+{
+}
+
+VNullWindow::~VNullWindow(void)
+{
+}
+
+/********************************************************************
+ *                        A T T R I B U T E S                       *
+ ********************************************************************/
+
+/********************************************************************
+ *                        O P E R A T I O N S                       *
+ ********************************************************************/
+bool VNullWindow::Create(VWindowOpts *pOpts)
+{
+	mOpts.mFullScreen = pOpts->mFullScreen;
+	mOpts.mOffscreen = pOpts->mOffscreen;
+	mOpts.mWidth = pOpts->mWidth;
+	mOpts.mHeight = pOpts->mHeight;
+	mSwaps = 0;
+	return true;
+}
+
+void VNullWindow::Destroy(void)
+{
+}
+
+bool VNullWindow::Resize(VWindowOpts *pOpts)
+{
+	mOpts.mWidth = pOpts->mWidth;
+	mOpts.mHeight = pOpts->mHeight;
+	return true;
+}
+
+void VNullWindow::SetCaption(const char *pCaption)
+{
+	mCaption = pCaption;
+}
+
+bool VNullWindow::SwapBuffers(void) const
+{
+	mSwaps++;
+	return true;
+}
+
+/********************************************************************
+ *                         C A L L B A C K S                        *
+ ********************************************************************/
+
+/********************************************************************
+ *                         I N T E R N A L S                        *
+ ********************************************************************/
+
+} // End Namespace
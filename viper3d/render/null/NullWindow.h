@@ -0,0 +1,94 @@
+/*============================================================================*
+ *                                                                            *
+ *  This file is part of the Viper3D Game Engine.                             *
+ *                                                                            *
+ *  Copyright (C) 2004 UDP Games   All Rights Reserved.                       *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------  ------------- *
+ *                                                                            *
+ *============================================================================*/
+#if !defined(__NULLWINDOW_H_INCLUDED__)
+#define __NULLWINDOW_H_INCLUDED__
+
+/* System Headers */
+
+/* Local Headers */
+#include <viper3d/Window.h>
+#include <viper3d/util/String.h>
+
+namespace UDP
+{
+
+/**
+ *	@class		VNullWindow
+ *
+ *	@brief		Window of the NULL render system.
+ *	@version	0.1.0
+ *	@date		17-Oct-2026
+ *	@remarks	Remembers its options and caption; nothing is shown and no
+ *				display is needed.
+ */
+class VNullWindow : public VWindow
+{
+public:
+	/*==================================*
+	 *	   CONSTRUCTION/DESTRUCTION		*
+	 *==================================*/
+	VNullWindow();
+	virtual ~VNullWindow();
+
+	/*==================================*
+	 *			  ATTRIBUTES			*
+	 *==================================*/
+	const char*			GetCaption() const;
+	VUINT				GetSwaps() const;
+
+	/*==================================*
+	 *			  OPERATIONS			*
+	 *==================================*/
+	bool				Create(VWindowOpts *pOpts);
+	void				Destroy(void);
+	bool				Resize(VWindowOpts *pOpts);
+	void				SetCaption(const char *pCaption);
+	bool				SwapBuffers(void) const;
+
+protected:
+	/*==================================*
+	 *             CALLBACKS			*
+	 *==================================*/
+
+private:
+	/*==================================*
+	 *             INTERNALS            *
+	 *==================================*/
+
+
+private:
+	/*==================================*
+	 *             VARIABLES            *
+	 *==================================*/
+	VString				mCaption;
+	mutable VUINT		mSwaps;
+};
+
+inline
+const char* VNullWindow::GetCaption() const
+{
+	return mCaption.C_Str();
+}
+
+/**
+ *	Number of SwapBuffers() calls, i.e. frames presented.
+ */
+inline
+VUINT VNullWindow::GetSwaps() const
+{
+	return mSwaps;
+}
+
+} // End Namespace
+
+#endif // __NULLWINDOW_H_INCLUDED__
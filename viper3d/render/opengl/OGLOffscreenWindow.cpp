@@ -0,0 +1,550 @@
+/*============================================================================*
+ *                                                                            *
+ *  This file is part of the Viper3D Game Engine.                             *
+ *                                                                            *
+ *  Copyright (C) 2004 UDP Games   All Rights Reserved.                       *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------  ------------- *
+ *                                                                            *
+ *============================================================================*/
+#include "OGLOffscreenWindow.h"
+
+#if defined(HAVE_LIBEGL)
+
+/* System Headers */
+#include <EGL/eglext.h>
+#include <viper3d/util/Log.h>
+#include <cstdio>
+#include <cstring>
+
+/* Local Headers */
+#include "OGLRenderSystem.h"
+
+namespace UDP
+{
+
+static char __CLASS__[] = "[ VOGLOffscreen]";
+
+/* windows using the EGL display; the last one out terminates it */
+static VUINT						sUsers = 0;
+
+/* framebuffer, pixel buffer and sync entry points */
+static PFNGLGENFRAMEBUFFERSPROC			sGenFramebuffers = NULL;
+static PFNGLDELETEFRAMEBUFFERSPROC		sDeleteFramebuffers = NULL;
+static PFNGLBINDFRAMEBUFFERPROC			sBindFramebuffer = NULL;
+static PFNGLCHECKFRAMEBUFFERSTATUSPROC	sCheckFramebufferStatus = NULL;
+static PFNGLGENRENDERBUFFERSPROC		sGenRenderbuffers = NULL;
+static PFNGLDELETERENDERBUFFERSPROC		sDeleteRenderbuffers = NULL;
+static PFNGLBINDRENDERBUFFERPROC		sBindRenderbuffer = NULL;
+static PFNGLRENDERBUFFERSTORAGEPROC		sRenderbufferStorage = NULL;
+static PFNGLFRAMEBUFFERRENDERBUFFERPROC	sFramebufferRenderbuffer = NULL;
+static PFNGLGENBUFFERSPROC				sGenBuffers = NULL;
+static PFNGLDELETEBUFFERSPROC			sDeleteBuffers = NULL;
+static PFNGLBINDBUFFERPROC				sBindBuffer = NULL;
+static PFNGLBUFFERDATAPROC				sBufferData = NULL;
+static PFNGLMAPBUFFERPROC				sMapBuffer = NULL;
+static PFNGLUNMAPBUFFERPROC				sUnmapBuffer = NULL;
+static PFNGLFENCESYNCPROC				sFenceSync = NULL;
+static PFNGLCLIENTWAITSYNCPROC			sClientWaitSync = NULL;
+static PFNGLDELETESYNCPROC				sDeleteSync = NULL;
+
+/*
+ * Mesa's surfaceless platform needs no window system at all; anything
+ * else gets the default display.
+ */
+static EGLDisplay GetDisplay()
+{
+	const char							*vClientExts;
+	PFNEGLGETPLATFORMDISPLAYEXTPROC		vGetPlatformDisplay;
+
+	vClientExts = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+	if (vClientExts != NULL &&
+		VOGLRenderSystem::HasExtension("EGL_MESA_platform_surfaceless", vClientExts))
+	{
+		vGetPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)
+								eglGetProcAddress("eglGetPlatformDisplayEXT");
+		if (vGetPlatformDisplay != NULL)
+			return vGetPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+	}
+	return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+/********************************************************************
+ *          C O N S T R U C T I O N / D E S T R U C T I O N         *
+ ********************************************************************/
+VOGLOffscreenWindow::VOGLOffscreenWindow()
+	: mEglDpy(EGL_NO_DISPLAY), mSurface(EGL_NO_SURFACE), mCtx(EGL_NO_CONTEXT),
+	  mFbo(0), mColor(0), mDepth(0), mCapture(false), mHavePbo(false),
+	  mHaveSync(false), mHead(0), mPending(0), mSwaps(0), mFrame(0)
+{
+	memset(mPbos, 0, sizeof(mPbos));
+	memset(mFences, 0, sizeof(mFences));
+	memset(mReadFrame, 0, sizeof(mReadFrame));
+}
+
+VOGLOffscreenWindow::~VOGLOffscreenWindow(void)
+{
+	if (mCtx != EGL_NO_CONTEXT)
+		Destroy();
+}
+
+/********************************************************************
+ *                        A T T R I B U T E S                       *
+ ********************************************************************/
+
+/*------------------------------------------------------------------*
+ *								GetFrame()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Returns the newest captured frame that has been read
+ *				back.
+ *	@date		17-Oct-2026
+ *
+ *	@param		pFrame	Set to the swap (counting from 1) the pixels
+ *						were presented at, 0 if none yet
+ *
+ *	@returns	(const VBYTE*) Width * height RGBA pixels, bottom row
+ *				first; NULL before the first capture arrives
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+const VBYTE* VOGLOffscreenWindow::GetFrame(VUINT *pFrame /*=NULL*/) const
+{
+	if (pFrame != NULL)
+		*pFrame = mFrame;
+	if (mFrame == 0 || mPixels.empty())
+		return NULL;
+	return &mPixels[0];
+}
+
+/********************************************************************
+ *                        O P E R A T I O N S                       *
+ ********************************************************************/
+
+/*------------------------------------------------------------------*
+ *								Create()							*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Initialise the display and bind the desktop GL API			*
+ *		Create a context, with a config if one can have pbuffers	*
+ *			and with none (EGL_KHR_no_config_context) otherwise		*
+ *		Make it current with no surface, or a 1x1 pbuffer when		*
+ *			EGL_KHR_surfaceless_context is missing					*
+ *		Create the framebuffer and the readback buffers				*
+ *																	*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+bool VOGLOffscreenWindow::Create(VWindowOpts *pOpts)
+{
+	EGLint		vConfigAttr[] = { EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+								EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+								EGL_NONE };
+	EGLint		vPbufferAttr[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+	EGLConfig	vConfig = EGL_NO_CONFIG_KHR;
+	EGLint		vMajor, vMinor, vCount = 0;
+	const char	*vExts;
+
+	mOpts.mFullScreen = false;
+	mOpts.mOffscreen = true;
+	mOpts.mWidth = pOpts->mWidth;
+	mOpts.mHeight = pOpts->mHeight;
+
+	mEglDpy = GetDisplay();
+	if (mEglDpy == EGL_NO_DISPLAY || !eglInitialize(mEglDpy, &vMajor, &vMinor))
+	{
+		VTRACE(_CL("Unable to initialize EGL\n"));
+		mEglDpy = EGL_NO_DISPLAY;
+		return false;
+	}
+	sUsers++;
+	VTRACE(_CL("EGL Version: %d.%d\n"), vMajor, vMinor);
+
+	vExts = eglQueryString(mEglDpy, EGL_EXTENSIONS);
+	if (!eglBindAPI(EGL_OPENGL_API) ||
+		((!eglChooseConfig(mEglDpy, vConfigAttr, &vConfig, 1, &vCount) || vCount == 0) &&
+		 !VOGLRenderSystem::HasExtension("EGL_KHR_no_config_context", vExts)))
+	{
+		VTRACE(_CL("No OpenGL config\n"));
+		Destroy();
+		return false;
+	}
+	if (vCount == 0)
+		vConfig = EGL_NO_CONFIG_KHR;
+
+	mCtx = eglCreateContext(mEglDpy, vConfig, EGL_NO_CONTEXT, NULL);
+	if (mCtx == EGL_NO_CONTEXT)
+	{
+		VTRACE(_CL("Unable to create context\n"));
+		Destroy();
+		return false;
+	}
+	if (!VOGLRenderSystem::HasExtension("EGL_KHR_surfaceless_context", vExts))
+	{
+		if (vCount > 0)
+			mSurface = eglCreatePbufferSurface(mEglDpy, vConfig, vPbufferAttr);
+		if (mSurface == EGL_NO_SURFACE)
+		{
+			VTRACE(_CL("Unable to create a surface\n"));
+			Destroy();
+			return false;
+		}
+	}
+
+	if (!MakeCurrent() || !LoadEntryPoints() || !CreateTargets())
+	{
+		Destroy();
+		return false;
+	}
+
+	VTRACE(_CL("Offscreen %dx%d, %s, readback: %s\n"), mOpts.mWidth, mOpts.mHeight,
+			glGetString(GL_RENDERER), mHavePbo ? "async" : "sync");
+	return true;
+}
+
+void VOGLOffscreenWindow::Destroy(void)
+{
+	if (mCtx != EGL_NO_CONTEXT)
+	{
+		if (MakeCurrent())
+			DestroyTargets();
+		eglMakeCurrent(mEglDpy, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+		eglDestroyContext(mEglDpy, mCtx);
+		mCtx = EGL_NO_CONTEXT;
+	}
+	if (mSurface != EGL_NO_SURFACE)
+	{
+		eglDestroySurface(mEglDpy, mSurface);
+		mSurface = EGL_NO_SURFACE;
+	}
+	if (mEglDpy != EGL_NO_DISPLAY)
+	{
+		if (--sUsers == 0)
+			eglTerminate(mEglDpy);
+		mEglDpy = EGL_NO_DISPLAY;
+	}
+}
+
+/**
+ *	Recreates the framebuffer at the new size.  Captures still in
+ *	flight are dropped.
+ */
+bool VOGLOffscreenWindow::Resize(VWindowOpts *pOpts)
+{
+	if (!MakeCurrent())
+		return false;
+
+	DestroyTargets();
+	mOpts.mWidth = pOpts->mWidth;
+	mOpts.mHeight = pOpts->mHeight;
+	if (!CreateTargets())
+		return false;
+	glViewport(0, 0, mOpts.mWidth, mOpts.mHeight);
+	return true;
+}
+
+void VOGLOffscreenWindow::SetCaption(const char *pCaption)
+{
+	mCaption = pCaption;
+}
+
+/*------------------------------------------------------------------*
+ *							  SwapBuffers()							*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		When capturing:												*
+ *			without pixel buffer objects, read the frame now		*
+ *			otherwise start reading it into the next buffer, with	*
+ *				a fence after it, and collect any earlier reads		*
+ *				that have finished									*
+ *		Flush, so the frame is under way before the next one		*
+ *																	*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+bool VOGLOffscreenWindow::SwapBuffers(void) const
+{
+	mSwaps++;
+	if (mCapture && !mHavePbo)
+	{
+		glReadPixels(0, 0, mOpts.mWidth, mOpts.mHeight, GL_RGBA, GL_UNSIGNED_BYTE,
+					&mPixels[0]);
+		mFrame = mSwaps;
+	}
+	else if (mCapture)
+	{
+		/* at most VOGL_READBACK_BUFFERS - 1 are left pending, so one is free */
+		sBindBuffer(GL_PIXEL_PACK_BUFFER, mPbos[mHead]);
+		glReadPixels(0, 0, mOpts.mWidth, mOpts.mHeight, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+		sBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		if (mHaveSync)
+			mFences[mHead] = sFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		mReadFrame[mHead] = mSwaps;
+		mHead = (mHead + 1) % VOGL_READBACK_BUFFERS;
+		mPending++;
+		glFlush();
+		Collect(false);
+		return true;
+	}
+	glFlush();
+	return true;
+}
+
+bool VOGLOffscreenWindow::MakeCurrent(void)
+{
+	return eglMakeCurrent(mEglDpy, mSurface, mSurface, mCtx) == EGL_TRUE;
+}
+
+/*------------------------------------------------------------------*
+ *							  ReadPixels()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Reads what has been drawn so far, waiting for it.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	The blocking read SwapBuffers() avoids; for one-off
+ *				grabs and for checking captures against.
+ *
+ *	@param		pPixels	Width * height * 4 bytes for RGBA pixels,
+ *						bottom row first
+ *
+ *	@returns	(bool) false if the read failed
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+bool VOGLOffscreenWindow::ReadPixels(void *pPixels) const
+{
+	glReadPixels(0, 0, mOpts.mWidth, mOpts.mHeight, GL_RGBA, GL_UNSIGNED_BYTE, pPixels);
+	return glGetError() == GL_NO_ERROR;
+}
+
+/**
+ *	Waits for every capture in flight, so GetFrame() has the last one.
+ */
+void VOGLOffscreenWindow::Finish(void) const
+{
+	Collect(true);
+}
+
+/********************************************************************
+ *                         C A L L B A C K S                        *
+ ********************************************************************/
+
+/********************************************************************
+ *                         I N T E R N A L S                        *
+ ********************************************************************/
+
+/*------------------------------------------------------------------*
+ *							LoadEntryPoints()						*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Framebuffer objects are required: GL 3.0 or					*
+ *			ARB_framebuffer_object									*
+ *		Pixel buffer objects (GL 2.1 or ARB_pixel_buffer_object)	*
+ *			make readback asynchronous								*
+ *		Fences (GL 3.2 or ARB_sync) let finished reads be			*
+ *			collected early											*
+ *																	*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+bool VOGLOffscreenWindow::LoadEntryPoints()
+{
+	const char	*vVersion = (const char*)glGetString(GL_VERSION);
+	int			vMajor = 1, vMinor = 0;
+
+	if (vVersion != NULL)
+		sscanf(vVersion, "%d.%d", &vMajor, &vMinor);
+
+	if (vMajor < 3 && !VOGLRenderSystem::HasExtension("GL_ARB_framebuffer_object"))
+	{
+		VTRACE(_CL("No framebuffer objects, unable to render offscreen\n"));
+		return false;
+	}
+	sGenFramebuffers = (PFNGLGENFRAMEBUFFERSPROC)eglGetProcAddress("glGenFramebuffers");
+	sDeleteFramebuffers = (PFNGLDELETEFRAMEBUFFERSPROC)eglGetProcAddress("glDeleteFramebuffers");
+	sBindFramebuffer = (PFNGLBINDFRAMEBUFFERPROC)eglGetProcAddress("glBindFramebuffer");
+	sCheckFramebufferStatus = (PFNGLCHECKFRAMEBUFFERSTATUSPROC)
+								eglGetProcAddress("glCheckFramebufferStatus");
+	sGenRenderbuffers = (PFNGLGENRENDERBUFFERSPROC)eglGetProcAddress("glGenRenderbuffers");
+	sDeleteRenderbuffers = (PFNGLDELETERENDERBUFFERSPROC)eglGetProcAddress("glDeleteRenderbuffers");
+	sBindRenderbuffer = (PFNGLBINDRENDERBUFFERPROC)eglGetProcAddress("glBindRenderbuffer");
+	sRenderbufferStorage = (PFNGLRENDERBUFFERSTORAGEPROC)eglGetProcAddress("glRenderbufferStorage");
+	sFramebufferRenderbuffer = (PFNGLFRAMEBUFFERRENDERBUFFERPROC)
+								eglGetProcAddress("glFramebufferRenderbuffer");
+	if (sGenFramebuffers == NULL || sDeleteFramebuffers == NULL || sBindFramebuffer == NULL ||
+		sCheckFramebufferStatus == NULL || sGenRenderbuffers == NULL ||
+		sDeleteRenderbuffers == NULL || sBindRenderbuffer == NULL ||
+		sRenderbufferStorage == NULL || sFramebufferRenderbuffer == NULL)
+		return false;
+
+	mHavePbo = false;
+	if (vMajor > 2 || (vMajor == 2 && vMinor >= 1) ||
+		VOGLRenderSystem::HasExtension("GL_ARB_pixel_buffer_object"))
+	{
+		sGenBuffers = (PFNGLGENBUFFERSPROC)eglGetProcAddress("glGenBuffers");
+		sDeleteBuffers = (PFNGLDELETEBUFFERSPROC)eglGetProcAddress("glDeleteBuffers");
+		sBindBuffer = (PFNGLBINDBUFFERPROC)eglGetProcAddress("glBindBuffer");
+		sBufferData = (PFNGLBUFFERDATAPROC)eglGetProcAddress("glBufferData");
+		sMapBuffer = (PFNGLMAPBUFFERPROC)eglGetProcAddress("glMapBuffer");
+		sUnmapBuffer = (PFNGLUNMAPBUFFERPROC)eglGetProcAddress("glUnmapBuffer");
+		mHavePbo = sGenBuffers != NULL && sDeleteBuffers != NULL && sBindBuffer != NULL &&
+					sBufferData != NULL && sMapBuffer != NULL && sUnmapBuffer != NULL;
+	}
+
+	mHaveSync = false;
+	if (mHavePbo && (vMajor > 3 || (vMajor == 3 && vMinor >= 2) ||
+		VOGLRenderSystem::HasExtension("GL_ARB_sync")))
+	{
+		sFenceSync = (PFNGLFENCESYNCPROC)eglGetProcAddress("glFenceSync");
+		sClientWaitSync = (PFNGLCLIENTWAITSYNCPROC)eglGetProcAddress("glClientWaitSync");
+		sDeleteSync = (PFNGLDELETESYNCPROC)eglGetProcAddress("glDeleteSync");
+		mHaveSync = sFenceSync != NULL && sClientWaitSync != NULL && sDeleteSync != NULL;
+	}
+	return true;
+}
+
+/*------------------------------------------------------------------*
+ *							CreateTargets()							*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Colour and depth renderbuffers the size of the window,		*
+ *			attached to a framebuffer that stays bound				*
+ *		A pixel buffer object per readback slot, sized for a frame	*
+ *																	*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+bool VOGLOffscreenWindow::CreateTargets()
+{
+	GLsizeiptr vSize = (GLsizeiptr)mOpts.mWidth * mOpts.mHeight * 4;
+
+	sGenFramebuffers(1, &mFbo);
+	sBindFramebuffer(GL_FRAMEBUFFER, mFbo);
+	sGenRenderbuffers(1, &mColor);
+	sBindRenderbuffer(GL_RENDERBUFFER, mColor);
+	sRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, mOpts.mWidth, mOpts.mHeight);
+	sFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, mColor);
+	sGenRenderbuffers(1, &mDepth);
+	sBindRenderbuffer(GL_RENDERBUFFER, mDepth);
+	sRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, mOpts.mWidth, mOpts.mHeight);
+	sFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, mDepth);
+	sBindRenderbuffer(GL_RENDERBUFFER, 0);
+	if (sCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+	{
+		VTRACE(_CL("Framebuffer incomplete at %dx%d\n"), mOpts.mWidth, mOpts.mHeight);
+		return false;
+	}
+	glDrawBuffer(GL_COLOR_ATTACHMENT0);
+	glReadBuffer(GL_COLOR_ATTACHMENT0);
+
+	if (mHavePbo)
+	{
+		sGenBuffers(VOGL_READBACK_BUFFERS, mPbos);
+		for (int i = 0; i < VOGL_READBACK_BUFFERS; i++)
+		{
+			sBindBuffer(GL_PIXEL_PACK_BUFFER, mPbos[i]);
+			sBufferData(GL_PIXEL_PACK_BUFFER, vSize, NULL, GL_STREAM_READ);
+		}
+		sBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	}
+	mPixels.resize(vSize);
+	mHead = mPending = 0;
+	mFrame = 0;
+	return true;
+}
+
+void VOGLOffscreenWindow::DestroyTargets()
+{
+	for (int i = 0; i < VOGL_READBACK_BUFFERS; i++)
+	{
+		if (mFences[i] != NULL)
+			sDeleteSync(mFences[i]);
+		mFences[i] = NULL;
+	}
+	if (mPbos[0] != 0)
+		sDeleteBuffers(VOGL_READBACK_BUFFERS, mPbos);
+	memset(mPbos, 0, sizeof(mPbos));
+	mPending = 0;
+
+	if (mFbo != 0)
+	{
+		sBindFramebuffer(GL_FRAMEBUFFER, 0);
+		sDeleteFramebuffers(1, &mFbo);
+		sDeleteRenderbuffers(1, &mColor);
+		sDeleteRenderbuffers(1, &mDepth);
+	}
+	mFbo = mColor = mDepth = 0;
+}
+
+/*------------------------------------------------------------------*
+ *								Collect()							*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Oldest pending read first:									*
+ *			stop at one still running, unless bAll or every buffer	*
+ *				is in use (without fences, only the latter)			*
+ *			map its buffer and copy the frame out					*
+ *																	*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VOGLOffscreenWindow::Collect(bool bAll) const
+{
+	VUINT		vSlot;
+	const void	*vData;
+
+	while (mPending > 0)
+	{
+		vSlot = (mHead + VOGL_READBACK_BUFFERS - mPending) % VOGL_READBACK_BUFFERS;
+		if (!bAll && mPending < VOGL_READBACK_BUFFERS &&
+			(!mHaveSync || sClientWaitSync(mFences[vSlot], 0, 0) == GL_TIMEOUT_EXPIRED))
+			break;
+
+		sBindBuffer(GL_PIXEL_PACK_BUFFER, mPbos[vSlot]);
+		vData = sMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+		if (vData != NULL)
+		{
+			memcpy(&mPixels[0], vData, mPixels.size());
+			mFrame = mReadFrame[vSlot];
+			sUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+		}
+		sBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		if (mFences[vSlot] != NULL)
+		{
+			sDeleteSync(mFences[vSlot]);
+			mFences[vSlot] = NULL;
+		}
+		mPending--;
+	}
+}
+
+} // End Namespace
+
+#endif // HAVE_LIBEGL
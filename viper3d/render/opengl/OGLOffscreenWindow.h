@@ -0,0 +1,167 @@
+/*============================================================================*
+ *                                                                            *
+ *  This file is part of the Viper3D Game Engine.                             *
+ *                                                                            *
+ *  Copyright (C) 2004 UDP Games   All Rights Reserved.                       *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------  ------------- *
+ *                                                                            *
+ *============================================================================*/
+#if !defined(__OGLOFFSCREENWINDOW_H_INCLUDED__)
+#define __OGLOFFSCREENWINDOW_H_INCLUDED__
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#if defined(HAVE_LIBEGL)
+
+/* System Headers */
+#include <EGL/egl.h>
+#include <GL/gl.h>
+#include <GL/glext.h>
+#include <vector>
+
+/* Local Headers */
+#include <viper3d/Window.h>
+#include <viper3d/util/String.h>
+
+/* Defines */
+#define VOGL_READBACK_BUFFERS	3
+
+namespace UDP
+{
+
+/**
+ *	@class		VOGLOffscreenWindow
+ *
+ *	@brief		OpenGL window that renders to memory instead of a display.
+ *	@version	0.1.0
+ *	@date		17-Oct-2026
+ *	@remarks	Uses an EGL context with no surface (the surfaceless
+ *				platform when Mesa has it, so llvmpipe works with no X
+ *				server) and draws into a framebuffer object the size of
+ *				the window.
+ *
+ *				With SetCapture() on, SwapBuffers() starts reading the
+ *				frame into the next of VOGL_READBACK_BUFFERS pixel buffer
+ *				objects and returns without waiting.  Reads are
+ *				collected once their fence has signalled, or once every
+ *				buffer is busy, so GetFrame() trails the frame being
+ *				drawn by up to GetLatency() frames but capture does not
+ *				stall the pipeline.  Without pixel buffer objects the
+ *				read is made straight away.
+ */
+class VOGLOffscreenWindow : public VWindow
+{
+public:
+	/*==================================*
+	 *	   CONSTRUCTION/DESTRUCTION		*
+	 *==================================*/
+	VOGLOffscreenWindow();
+	virtual ~VOGLOffscreenWindow();
+
+	/*==================================*
+	 *			  ATTRIBUTES			*
+	 *==================================*/
+	void				SetCapture(bool bCapture);
+	bool				IsCapturing() const;
+	bool				IsAsync() const;
+	VUINT				GetLatency() const;
+	const VBYTE*		GetFrame(VUINT *pFrame = NULL) const;
+	VUINT				GetSwaps() const;
+
+	/*==================================*
+	 *			  OPERATIONS			*
+	 *==================================*/
+	bool				Create(VWindowOpts *pOpts);
+	void				Destroy(void);
+	bool				Resize(VWindowOpts *pOpts);
+	void				SetCaption(const char *pCaption);
+	bool				SwapBuffers(void) const;
+	bool				MakeCurrent(void);
+	bool				ReadPixels(void *pPixels) const;
+	void				Finish(void) const;
+
+protected:
+	/*==================================*
+	 *             CALLBACKS			*
+	 *==================================*/
+
+private:
+	/*==================================*
+	 *             INTERNALS            *
+	 *==================================*/
+	bool				LoadEntryPoints();
+	bool				CreateTargets();
+	void				DestroyTargets();
+	void				Collect(bool bAll) const;
+
+public:
+	/*==================================*
+	 *             VARIABLES            *
+	 *==================================*/
+	EGLDisplay			mEglDpy;
+	EGLSurface			mSurface;	/**< EGL_NO_SURFACE when surfaceless */
+	EGLContext			mCtx;
+	VString				mCaption;
+	VUINT				mFbo;
+	VUINT				mColor;
+	VUINT				mDepth;
+	bool				mCapture;
+	bool				mHavePbo;
+	bool				mHaveSync;
+	VUINT				mPbos[VOGL_READBACK_BUFFERS];
+	mutable GLsync		mFences[VOGL_READBACK_BUFFERS];
+	mutable VUINT		mReadFrame[VOGL_READBACK_BUFFERS];	/**< swap each holds */
+	mutable VUINT		mHead;		/**< buffer the next read goes to */
+	mutable VUINT		mPending;	/**< reads not collected yet */
+	mutable VUINT		mSwaps;
+	mutable VUINT		mFrame;		/**< swap mPixels came from */
+	mutable std::vector<VBYTE>	mPixels;
+};
+
+inline
+void VOGLOffscreenWindow::SetCapture(bool bCapture)
+{
+	mCapture = bCapture;
+}
+
+inline
+bool VOGLOffscreenWindow::IsCapturing() const
+{
+	return mCapture;
+}
+
+/**
+ *	Whether captures go through pixel buffer objects without waiting.
+ */
+inline
+bool VOGLOffscreenWindow::IsAsync() const
+{
+	return mHavePbo;
+}
+
+/**
+ *	Most swaps a captured frame can take to reach GetFrame().
+ */
+inline
+VUINT VOGLOffscreenWindow::GetLatency() const
+{
+	return mHavePbo ? VOGL_READBACK_BUFFERS - 1 : 0;
+}
+
+inline
+VUINT VOGLOffscreenWindow::GetSwaps() const
+{
+	return mSwaps;
+}
+
+} // End Namespace
+
+#endif // HAVE_LIBEGL
+
+#endif // __OGLOFFSCREENWINDOW_H_INCLUDED__
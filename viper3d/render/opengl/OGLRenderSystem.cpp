@@ -14,14 +14,30 @@
 
 /* System Headers */
 #include <GL/gl.h>
+#include <GL/glext.h>
 #include <GL/glx.h>
 #include <GL/glu.h>
 #include <viper3d/util/Log.h>
+#include <cstdio>
+#include <cstring>
 
 /* Local Headers */
 #include "OGLWindow.h"
+#include "OGLOffscreenWindow.h"
+#include <viper3d/RenderQueue.h>
 
 /* Macros */
+#if VIPER_PLATFORM == PLATFORM_WINDOWS
+#define GETPROC(name)	wglGetProcAddress(name)
+#elif VIPER_PLATFORM == PLATFORM_MAC
+#define GETPROC(name)	NULL
+#elif VIPER_PLATFORM == PLATFORM_LINUX && defined(HAVE_LIBEGL)
+#define GETPROC(name)	(eglGetCurrentContext() != EGL_NO_CONTEXT ? \
+							(void (*)())eglGetProcAddress(name) : \
+							(void (*)())glXGetProcAddressARB((const GLubyte*)(name)))
+#elif VIPER_PLATFORM == PLATFORM_LINUX
+#define GETPROC(name)	glXGetProcAddressARB((const GLubyte*)(name))
+#endif
 
 namespace UDP
 {
@@ -56,12 +72,35 @@ DLL_RENDERDESTROY_IMPL Destruct;
 /* Static Variables */
 static char __CLASS__[] = "[   Viper3D    ]";
 
+/* buffer object entry points, loaded once a context exists */
+static PFNGLGENBUFFERSPROC			sGenBuffers = NULL;
+static PFNGLDELETEBUFFERSPROC		sDeleteBuffers = NULL;
+static PFNGLBINDBUFFERPROC			sBindBuffer = NULL;
+static PFNGLBUFFERDATAPROC			sBufferData = NULL;
+static PFNGLBUFFERSUBDATAPROC		sBufferSubData = NULL;
+static PFNGLGENVERTEXARRAYSPROC		sGenVertexArrays = NULL;
+static PFNGLDELETEVERTEXARRAYSPROC	sDeleteVertexArrays = NULL;
+static PFNGLBINDVERTEXARRAYPROC		sBindVertexArray = NULL;
+static PFNGLMULTIDRAWARRAYSPROC		sMultiDrawArrays = NULL;
+static PFNGLMULTIDRAWELEMENTSPROC	sMultiDrawElements = NULL;
+
+/* GL primitive for each VPrimitive */
+static const GLenum	sModes[] = { GL_POINTS, GL_LINES, GL_TRIANGLES };
+
+/* vertex of the built in scene, VERTEX_POSITION | VERTEX_COLOR */
+struct VColorVertex
+{
+	float	mPos[3];
+	VBYTE	mColor[4];
+};
+
 /********************************************************************
  *																	*
  *          C O N S T R U C T I O N / D E S T R U C T I O N         *
  *																	*
  ********************************************************************/
 VOGLRenderSystem::VOGLRenderSystem()
+	: mHaveVbo(false), mHaveVao(false), mGrid(0), mCube(0)
 {
 }
 
@@ -76,6 +115,23 @@ VOGLRenderSystem::~VOGLRenderSystem()
  *																	*
  ********************************************************************/
 
+/**
+ *	Whole word match in an extension string, so a name is not found
+ *	inside a longer one.  pExts defaults to the current GL context's.
+ */
+bool VOGLRenderSystem::HasExtension(const char *pName, const char *pExts /*=NULL*/)
+{
+	const char	*vExts = pExts != NULL ? pExts : (const char*)glGetString(GL_EXTENSIONS);
+	size_t		vLen = strlen(pName);
+
+	for (const char *vAt = vExts; vAt != NULL && (vAt = strstr(vAt, pName)) != NULL; vAt += vLen)
+	{
+		if ((vAt == vExts || vAt[-1] == ' ') && (vAt[vLen] == ' ' || vAt[vLen] == '\0'))
+			return true;
+	}
+	return false;
+}
+
 /********************************************************************
  *																	*
  *                        O P E R A T I O N S                       *
@@ -104,8 +160,16 @@ bool VOGLRenderSystem::Init(void)
 	vDisplay = getenv("DISPLAY");
 	if ((mDpy = XOpenDisplay(vDisplay)) == NULL)
 	{
+#if defined(HAVE_LIBEGL)
+		VTRACE(_CL("Unable to connect to X server, offscreen windows only.\n"));
+		mModes = NULL;
+		mNumModes = 0;
+		mDblBuffered = false;
+		return true;
+#else
 		VTRACE(_CL("Unable to connect to X server.\n"));
 		return false;
+#endif
 	}
 
 	/* query X information */
@@ -137,13 +201,6 @@ bool VOGLRenderSystem::Init(void)
 		VTRACE(_CL("Mode: DoubleBuffered\n"));
 	}
 #endif
-	glShadeModel(GL_SMOOTH);
-	glClearColor(0.0, 0.0, 0.0, 0.0);
-	glClearDepth(1.0f);
-	glEnable(GL_DEPTH_TEST);
-	glDepthFunc(GL_LEQUAL);
-	glHint(GL_PERSPECTIVE_CORRECTION_HINT, GL_NICEST);
-	glFlush();
 
 	return true;
 }
@@ -159,10 +216,10 @@ void VOGLRenderSystem::Shutdown(void)
 		XFree(mModes);
 		mModes = NULL;
 	}
-	glXMakeCurrent(mDpy, None, NULL);
 	VTRACE(_CL("Destroying display\n"));
 	if (mDpy != NULL)
 	{
+		glXMakeCurrent(mDpy, None, NULL);
 		XCloseDisplay(mDpy);
 		mDpy = NULL;
 	}
@@ -176,6 +233,9 @@ VWindow* VOGLRenderSystem::CreateWin(VWindowOpts *pOpts)
 #elif VIPER_PLATFORM == PLATFORM_LINUX
 	XF86VidModeModeInfo	*vBestMode = NULL;
 
+	if (pOpts->mOffscreen || mDpy == NULL)
+		return CreateOffscreen(pOpts);
+
 	if (pOpts->mFullScreen)
 	{
 		for (int i = 0; i < mNumModes; i++)
@@ -200,11 +260,9 @@ VWindow* VOGLRenderSystem::CreateWin(VWindowOpts *pOpts)
 
 	if (vWindow->Create(pOpts))
 	{
-		glViewport(0, 0,vWindow->mOpts.mWidth, vWindow->mOpts.mHeight);
-		glMatrixMode(GL_PROJECTION);
-		glLoadIdentity();
-		glMatrixMode(GL_MODELVIEW);
-		glLoadIdentity();
+		if (!LoadEntryPoints())
+			VTRACE(_CL("Buffer objects not supported, meshes unavailable.\n"));
+		InitContext(vWindow->mOpts);
 		return vWindow;
 	}
 	else
@@ -216,108 +274,291 @@ VWindow* VOGLRenderSystem::CreateWin(VWindowOpts *pOpts)
 
 void VOGLRenderSystem::DestroyWin(VWindow *pWin)
 {
+	/* the meshes go with the window's context */
+	DestroyMeshes();
 	pWin->Destroy();
 	delete pWin;
 	return;
 }
 
-bool VOGLRenderSystem::Render(VWindow *pWin, VCamera *pCamera)
+bool VOGLRenderSystem::Render(VWindow *pWin, VCamera *pCamera,
+							VRenderQueue *pQueue /*=NULL*/)
 {
-	int count = 2000;
-
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
 	glLoadIdentity();
 
 	pCamera->Render();
 	{ GLint err = glGetError(); if (err != GL_NO_ERROR) VTRACE(_CL("OpenGL Error: %d\n"), err); }
+	glGetFloatv(GL_MODELVIEW_MATRIX, mView);
+
+	if (mGrid == 0 && !CreateScene())
+		return false;
 
-	//glLoadIdentity();
-	
-	for (int i = -count; i <= count; i+=50)
-	{
-		glBegin(GL_LINES);
-			// Front
-			glColor3f(1.0, 0.0, 0.0);
-			glVertex3f(i, count, count);
-			glVertex3f(i, -count, count);
-			glVertex3f(count, i, count);
-			glVertex3f(-count, i, count);
-			// Back
-			glColor3f(0.0, 1.0, 0.0);
-			glVertex3f(i, count, -count);
-			glVertex3f(i, -count, -count);
-			glVertex3f(count, i, -count);
-			glVertex3f(-count, i, -count);
-			// Left
-			glColor3f(0.0, 0.0, 1.0);
-			glVertex3f(-count, i, count);
-			glVertex3f(-count, i, -count);
-			glVertex3f(-count, count, i);
-			glVertex3f(-count, -count, i);
-			// Right
-			glColor3f(1.0, 1.0, 0.0);
-			glVertex3f(count, i, count);
-			glVertex3f(count, i, -count);
-			glVertex3f(count, count, i);
-			glVertex3f(count, -count, i);
-			// Floor
-			glColor3f(0.0, 1.0, 1.0);
-			glVertex3f(count, -count, i);
-			glVertex3f(-count, -count, i);
-			glVertex3f(i, -count, count);
-			glVertex3f(i, -count, -count);
-			// Ceiling
-			glColor3f(1.0, 0.0, 1.0);
-			glVertex3f(count, count, i);
-			glVertex3f(-count, count, i);
-			glVertex3f(i, count, count);
-			glVertex3f(i, count, -count);
-		glEnd();
-
-	}
-
-	glTranslatef(0.0f, 0.0f, -20.0f);
-	glBegin(GL_QUADS);
-		glColor3f(0.0f, 1.0f, 0.0f);
-		glVertex3f(10.0f, 10.0f, -10.0f);
-		glVertex3f(-10.0f, 10.0f, -10.0f);
-		glVertex3f(-10.0f, 10.0f, 10.0f);
-		glVertex3f(10.0f, 10.0f, 10.0f);
-
-		glColor3f(1.0f, 0.5f, 0.0f);
-		glVertex3f(10.0f, -10.0f, -10.0f);
-		glVertex3f(-10.0f, -10.0f, -10.0f);
-		glVertex3f(-10.0f, -10.0f, 10.0f);
-		glVertex3f(10.0f, -10.0f, 10.0f);
-
-		glColor3f(1.0f, 0.0f, 0.0f);
-		glVertex3f(10.0f, 10.0f, 10.0f);
-		glVertex3f(-10.0f, 10.0f, 10.0f);
-		glVertex3f(-10.0f, -10.0f, 10.0f);
-		glVertex3f(10.0f, -10.0f, 10.0f);
-
-		glColor3f(1.0f, 1.0f, 0.0f);
-		glVertex3f(10.0f, -10.0f, -10.0f);
-		glVertex3f(-10.0f, -10.0f, -10.0f);
-		glVertex3f(-10.0f, 10.0f, -10.0f);
-		glVertex3f(10.0f, 10.0f, -10.0f);
-
-		glColor3f(0.0f, 0.0f, 1.0f);
-		glVertex3f(-10.0f, 10.0f, 10.0f);
-		glVertex3f(-10.0f, 10.0f, -10.0f);
-		glVertex3f(-10.0f, -10.0f, -10.0f);
-		glVertex3f(-10.0f, -10.0f, 10.0f);
-
-		glColor3f(1.0f, 0.0f, 1.0f);
-		glVertex3f(10.0f, 10.0f, -10.0f);
-		glVertex3f(10.0f, 10.0f, 10.0f);
-		glVertex3f(10.0f, -10.0f, 10.0f);
-		glVertex3f(10.0f, -10.0f, -10.0f);
-	glEnd();
-
-	if (mDblBuffered)
+	VMatrix vWorld = VMatrix::MATRIX_IDENTITY;
+	SetWorldMatrix(vWorld);
+	DrawMesh(mGrid);
+
+	vWorld.SetTranslation(VVector(0.0f, 0.0f, -20.0f));
+	SetWorldMatrix(vWorld);
+	DrawMesh(mCube);
+
+	if (pQueue != NULL)
+		DrawQueue(pQueue);
+
+	if (mDblBuffered || pWin->IsOffscreen())
 		pWin->SwapBuffers();
+	return true;
+}
+
+/*------------------------------------------------------------------*
+ *							  CreateMesh()							*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Reuse a destroyed handle if there is one					*
+ *		Create the buffers, and a vertex array object if possible	*
+ *		Upload the contents with the layout recorded in the VAO		*
+ *																	*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+VMeshHandle VOGLRenderSystem::CreateMesh(const VMeshDesc& desc, const void *pVerts,
+										const VUINT *pIndis)
+{
+	VMeshHandle	vHandle;
+	VOGLMesh	vMesh;
+
+	if (!mHaveVbo)
+	{
+		VTRACE(_CL("No vertex buffer objects, unable to create mesh.\n"));
+		return 0;
+	}
+
+	vMesh.mDesc = desc;
+	vMesh.mVbo = vMesh.mIbo = vMesh.mVao = 0;
+	vMesh.mVertCap = vMesh.mIndiCap = 0;
+	vMesh.mLive = true;
+	sGenBuffers(1, &vMesh.mVbo);
+	if (desc.mNumIndis > 0)
+		sGenBuffers(1, &vMesh.mIbo);
+	if (mHaveVao)
+	{
+		sGenVertexArrays(1, &vMesh.mVao);
+		sBindVertexArray(vMesh.mVao);
+	}
+
+	Upload(GL_ARRAY_BUFFER, vMesh.mVbo, &vMesh.mVertCap,
+			desc.mNumVerts * GetVertexSize(desc.mFormat), pVerts, desc.mUsage);
+	if (vMesh.mIbo != 0)
+		Upload(GL_ELEMENT_ARRAY_BUFFER, vMesh.mIbo, &vMesh.mIndiCap,
+				desc.mNumIndis * sizeof(VUINT), pIndis, desc.mUsage);
+	if (mHaveVao)
+	{
+		BindLayout(vMesh);
+		sBindVertexArray(0);
+	}
+	sBindBuffer(GL_ARRAY_BUFFER, 0);
+	sBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+	if (!mFree.empty())
+	{
+		vHandle = mFree.back();
+		mFree.pop_back();
+		mMeshes[vHandle - 1] = vMesh;
+	}
+	else
+	{
+		mMeshes.push_back(vMesh);
+		vHandle = (VMeshHandle)mMeshes.size();
+	}
+	return vHandle;
+}
+
+/*------------------------------------------------------------------*
+ *							  UpdateMesh()							*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Bind the mesh's VAO so a new index buffer lands in it		*
+ *		Upload each buffer, orphaning the old storage				*
+ *																	*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+bool VOGLRenderSystem::UpdateMesh(VMeshHandle hMesh, const void *pVerts,
+								VUINT nNumVerts, const VUINT *pIndis /*=NULL*/,
+								VUINT nNumIndis /*=0*/)
+{
+	VOGLMesh *vMesh = GetMesh(hMesh);
+
+	if (vMesh == NULL)
+		return false;
+
+	if (mHaveVao)
+		sBindVertexArray(vMesh->mVao);
+	Upload(GL_ARRAY_BUFFER, vMesh->mVbo, &vMesh->mVertCap,
+			nNumVerts * GetVertexSize(vMesh->mDesc.mFormat), pVerts,
+			vMesh->mDesc.mUsage);
+	vMesh->mDesc.mNumVerts = nNumVerts;
+	if (pIndis != NULL)
+	{
+		if (vMesh->mIbo == 0)
+			sGenBuffers(1, &vMesh->mIbo);
+		Upload(GL_ELEMENT_ARRAY_BUFFER, vMesh->mIbo, &vMesh->mIndiCap,
+				nNumIndis * sizeof(VUINT), pIndis, vMesh->mDesc.mUsage);
+		vMesh->mDesc.mNumIndis = nNumIndis;
+	}
+	if (mHaveVao)
+		sBindVertexArray(0);
+	sBindBuffer(GL_ARRAY_BUFFER, 0);
+	sBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	return true;
+}
+
+void VOGLRenderSystem::DestroyMesh(VMeshHandle hMesh)
+{
+	VOGLMesh *vMesh = GetMesh(hMesh);
+
+	if (vMesh == NULL)
+		return;
+
+	sDeleteBuffers(1, &vMesh->mVbo);
+	if (vMesh->mIbo != 0)
+		sDeleteBuffers(1, &vMesh->mIbo);
+	if (vMesh->mVao != 0)
+		sDeleteVertexArrays(1, &vMesh->mVao);
+	vMesh->mLive = false;
+	mFree.push_back(hMesh);
+}
+
+void VOGLRenderSystem::SetWorldMatrix(const VMatrix& mat)
+{
+	GLfloat	vGLMatrix[16];
+	VMatrix	vView(mView[0], mView[4], mView[8], mView[12],
+				  mView[1], mView[5], mView[9], mView[13],
+				  mView[2], mView[6], mView[10], mView[14],
+				  mView[3], mView[7], mView[11], mView[15]);
+	VMatrix	vModelView = vView * mat;
+
+	vModelView.MakeGLMatrix(vGLMatrix);
+	glLoadMatrixf(vGLMatrix);
+}
+
+/*------------------------------------------------------------------*
+ *							   DrawMesh()							*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Bind the VAO, or the buffers and layout without one			*
+ *		One glDrawElements() or glDrawArrays() for the whole mesh	*
+ *																	*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+bool VOGLRenderSystem::DrawMesh(VMeshHandle hMesh)
+{
+	VOGLMesh *vMesh = GetMesh(hMesh);
+
+	if (vMesh == NULL)
+		return false;
+
+	BindMesh(*vMesh);
+	if (vMesh->mIbo != 0)
+		glDrawElements(sModes[vMesh->mDesc.mPrimitive], vMesh->mDesc.mNumIndis,
+						GL_UNSIGNED_INT, NULL);
+	else
+		glDrawArrays(sModes[vMesh->mDesc.mPrimitive], 0, vMesh->mDesc.mNumVerts);
+	UnbindMesh();
+	return true;
+}
+
+/*------------------------------------------------------------------*
+ *							DrawMeshRanges()						*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Turn the ranges into the offsets and counts GL wants,		*
+ *			a count of 0 meaning the whole mesh						*
+ *		One glMultiDrawElements() or glMultiDrawArrays(), or a		*
+ *			draw per range before GL 1.4							*
+ *																	*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+bool VOGLRenderSystem::DrawMeshRanges(VMeshHandle hMesh, const VUINT *pFirsts,
+									const VUINT *pCounts, VUINT nRanges)
+{
+	VOGLMesh	*vMesh = GetMesh(hMesh);
+	GLenum		vMode;
+	VUINT		vAll;
+
+	if (vMesh == NULL)
+		return false;
+
+	vMode = sModes[vMesh->mDesc.mPrimitive];
+	vAll = vMesh->mIbo != 0 ? vMesh->mDesc.mNumIndis : vMesh->mDesc.mNumVerts;
+	mFirsts.resize(nRanges);
+	mCounts.resize(nRanges);
+	mOffsets.resize(nRanges);
+	for (VUINT r = 0; r < nRanges; r++)
+	{
+		mFirsts[r] = pCounts[r] == 0 ? 0 : pFirsts[r];
+		mCounts[r] = pCounts[r] == 0 ? vAll : pCounts[r];
+		mOffsets[r] = (const char*)NULL + mFirsts[r] * sizeof(VUINT);
+	}
+
+	BindMesh(*vMesh);
+	if (vMesh->mIbo != 0)
+	{
+		if (sMultiDrawElements != NULL)
+			sMultiDrawElements(vMode, &mCounts[0], GL_UNSIGNED_INT, &mOffsets[0], nRanges);
+		else
+			for (VUINT r = 0; r < nRanges; r++)
+				glDrawElements(vMode, mCounts[r], GL_UNSIGNED_INT, mOffsets[r]);
+	}
+	else
+	{
+		if (sMultiDrawArrays != NULL)
+			sMultiDrawArrays(vMode, &mFirsts[0], &mCounts[0], nRanges);
+		else
+			for (VUINT r = 0; r < nRanges; r++)
+				glDrawArrays(vMode, mFirsts[r], mCounts[r]);
+	}
+	UnbindMesh();
+	return true;
+}
+
+/*------------------------------------------------------------------*
+ *							   SetState()							*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Texture ids are GL texture names; 0 turns texturing off		*
+ *		Materials have nothing to bind in the fixed pipeline yet	*
+ *																	*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VOGLRenderSystem::SetState(VUINT /*nMaterial*/, VUINT nTexture)
+{
+	if (nTexture != 0)
+	{
+		glEnable(GL_TEXTURE_2D);
+		glBindTexture(GL_TEXTURE_2D, nTexture);
+	}
+	else
+		glDisable(GL_TEXTURE_2D);
 }
 
 /********************************************************************
@@ -337,6 +578,363 @@ bool VOGLRenderSystem::Render(VWindow *pWin, VCamera *pCamera)
  *                          I N T E R N A L S                       *
  *																	*
  ********************************************************************/
+/*------------------------------------------------------------------*
+ *							CreateOffscreen()						*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Create an EGL window rendering into a framebuffer object	*
+ *		Load the entry points and set up the context as for an X	*
+ *			window													*
+ *																	*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+VWindow* VOGLRenderSystem::CreateOffscreen(VWindowOpts *pOpts)
+{
+#if defined(HAVE_LIBEGL)
+	VOGLOffscreenWindow *vWindow = new VOGLOffscreenWindow();
+
+	if (vWindow->Create(pOpts))
+	{
+		if (!LoadEntryPoints())
+			VTRACE(_CL("Buffer objects not supported, meshes unavailable.\n"));
+		InitContext(vWindow->mOpts);
+		return vWindow;
+	}
+	delete vWindow;
+#else
+	VTRACE(_CL("Built without EGL, no offscreen windows.\n"));
+#endif
+	return NULL;
+}
+
+/**
+ *	Default state for a window's freshly created context.
+ */
+void VOGLRenderSystem::InitContext(const VWindowOpts& opts)
+{
+	glShadeModel(GL_SMOOTH);
+	glClearColor(0.0, 0.0, 0.0, 0.0);
+	glClearDepth(1.0f);
+	glEnable(GL_DEPTH_TEST);
+	glDepthFunc(GL_LEQUAL);
+	glHint(GL_PERSPECTIVE_CORRECTION_HINT, GL_NICEST);
+	glViewport(0, 0, opts.mWidth, opts.mHeight);
+	glMatrixMode(GL_PROJECTION);
+	glLoadIdentity();
+	glMatrixMode(GL_MODELVIEW);
+	glLoadIdentity();
+}
+
+/*------------------------------------------------------------------*
+ *							LoadEntryPoints()						*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Needs a current context, so is called from CreateWin()		*
+ *		Buffer objects: GL 1.5, or the ARB extension before it		*
+ *		Vertex array objects: GL 3.0 or ARB_vertex_array_object		*
+ *																	*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+bool VOGLRenderSystem::LoadEntryPoints()
+{
+	const char	*vVersion = (const char*)glGetString(GL_VERSION);
+	int			vMajor = 1, vMinor = 0;
+
+	if (vVersion != NULL)
+		sscanf(vVersion, "%d.%d", &vMajor, &vMinor);
+
+	mHaveVbo = false;
+	mHaveVao = false;
+	if (vMajor > 1 || vMinor >= 4)
+	{
+		sMultiDrawArrays = (PFNGLMULTIDRAWARRAYSPROC)GETPROC("glMultiDrawArrays");
+		sMultiDrawElements = (PFNGLMULTIDRAWELEMENTSPROC)GETPROC("glMultiDrawElements");
+	}
+	if (vMajor > 1 || vMinor >= 5)
+	{
+		sGenBuffers = (PFNGLGENBUFFERSPROC)GETPROC("glGenBuffers");
+		sDeleteBuffers = (PFNGLDELETEBUFFERSPROC)GETPROC("glDeleteBuffers");
+		sBindBuffer = (PFNGLBINDBUFFERPROC)GETPROC("glBindBuffer");
+		sBufferData = (PFNGLBUFFERDATAPROC)GETPROC("glBufferData");
+		sBufferSubData = (PFNGLBUFFERSUBDATAPROC)GETPROC("glBufferSubData");
+	}
+	else if (HasExtension("GL_ARB_vertex_buffer_object"))
+	{
+		sGenBuffers = (PFNGLGENBUFFERSPROC)GETPROC("glGenBuffersARB");
+		sDeleteBuffers = (PFNGLDELETEBUFFERSPROC)GETPROC("glDeleteBuffersARB");
+		sBindBuffer = (PFNGLBINDBUFFERPROC)GETPROC("glBindBufferARB");
+		sBufferData = (PFNGLBUFFERDATAPROC)GETPROC("glBufferDataARB");
+		sBufferSubData = (PFNGLBUFFERSUBDATAPROC)GETPROC("glBufferSubDataARB");
+	}
+	mHaveVbo = sGenBuffers != NULL && sDeleteBuffers != NULL &&
+				sBindBuffer != NULL && sBufferData != NULL &&
+				sBufferSubData != NULL;
+
+	if (mHaveVbo && (vMajor >= 3 || HasExtension("GL_ARB_vertex_array_object")))
+	{
+		sGenVertexArrays = (PFNGLGENVERTEXARRAYSPROC)GETPROC("glGenVertexArrays");
+		sDeleteVertexArrays = (PFNGLDELETEVERTEXARRAYSPROC)GETPROC("glDeleteVertexArrays");
+		sBindVertexArray = (PFNGLBINDVERTEXARRAYPROC)GETPROC("glBindVertexArray");
+		mHaveVao = sGenVertexArrays != NULL && sDeleteVertexArrays != NULL &&
+					sBindVertexArray != NULL;
+	}
+
+	VTRACE(_CL("GL %d.%d, buffer objects: %s, vertex array objects: %s\n"),
+			vMajor, vMinor, mHaveVbo ? "yes" : "no", mHaveVao ? "yes" : "no");
+	return mHaveVbo;
+}
+
+VOGLRenderSystem::VOGLMesh* VOGLRenderSystem::GetMesh(VMeshHandle hMesh)
+{
+	if (hMesh == 0 || hMesh > mMeshes.size() || !mMeshes[hMesh - 1].mLive)
+		return NULL;
+	return &mMeshes[hMesh - 1];
+}
+
+/*------------------------------------------------------------------*
+ *								Upload()							*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		If the data outgrows the buffer, reallocate it with the		*
+ *			data in one go											*
+ *		Otherwise orphan the old storage with a NULL glBufferData()	*
+ *			and write into the fresh storage, so the driver never	*
+ *			waits for draws still reading the old contents			*
+ *																	*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VOGLRenderSystem::Upload(VUINT nTarget, VUINT nBuffer, VUINT *pCap,
+							VUINT nSize, const void *pData, VBufferUsage nUsage)
+{
+	static const GLenum	vUsages[] = { GL_STATIC_DRAW, GL_DYNAMIC_DRAW, GL_STREAM_DRAW };
+
+	sBindBuffer(nTarget, nBuffer);
+	if (nSize > *pCap)
+	{
+		*pCap = nSize;
+		sBufferData(nTarget, nSize, pData, vUsages[nUsage]);
+	}
+	else
+	{
+		sBufferData(nTarget, *pCap, NULL, vUsages[nUsage]);
+		if (pData != NULL)
+			sBufferSubData(nTarget, 0, nSize, pData);
+	}
+}
+
+/*------------------------------------------------------------------*
+ *							  BindLayout()							*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Point each array present in the format at its offset in		*
+ *		the bound vertex buffer, and turn the others off			*
+ *																	*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VOGLRenderSystem::BindLayout(const VOGLMesh& mesh)
+{
+	VUINT	vFormat = mesh.mDesc.mFormat;
+	GLsizei	vStride = GetVertexSize(vFormat);
+	char	*vOffset = NULL;
+
+	sBindBuffer(GL_ARRAY_BUFFER, mesh.mVbo);
+	sBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.mIbo);
+
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glVertexPointer(3, GL_FLOAT, vStride, vOffset);
+	vOffset += 3 * sizeof(float);
+
+	if (vFormat & VERTEX_NORMAL)
+	{
+		glEnableClientState(GL_NORMAL_ARRAY);
+		glNormalPointer(GL_FLOAT, vStride, vOffset);
+		vOffset += 3 * sizeof(float);
+	}
+	else
+		glDisableClientState(GL_NORMAL_ARRAY);
+
+	if (vFormat & VERTEX_COLOR)
+	{
+		glEnableClientState(GL_COLOR_ARRAY);
+		glColorPointer(4, GL_UNSIGNED_BYTE, vStride, vOffset);
+		vOffset += 4;
+	}
+	else
+		glDisableClientState(GL_COLOR_ARRAY);
+
+	if (vFormat & VERTEX_TEXCOORD)
+	{
+		glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+		glTexCoordPointer(2, GL_FLOAT, vStride, vOffset);
+	}
+	else
+		glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+}
+
+/*------------------------------------------------------------------*
+ *							   BindMesh()							*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Bind the VAO, or the buffers and layout without one			*
+ *																	*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VOGLRenderSystem::BindMesh(const VOGLMesh& mesh)
+{
+	if (mHaveVao)
+		sBindVertexArray(mesh.mVao);
+	else
+		BindLayout(mesh);
+	if (!(mesh.mDesc.mFormat & VERTEX_COLOR))
+		glColor4ub(255, 255, 255, 255);
+}
+
+void VOGLRenderSystem::UnbindMesh()
+{
+	if (mHaveVao)
+		sBindVertexArray(0);
+	else
+	{
+		sBindBuffer(GL_ARRAY_BUFFER, 0);
+		sBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	}
+}
+
+/*------------------------------------------------------------------*
+ *							DestroyMeshes()							*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Meshes live in the window's context, so this has to run		*
+ *		while it is still current									*
+ *																	*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VOGLRenderSystem::DestroyMeshes()
+{
+	for (VUINT i = 0; i < mMeshes.size(); i++)
+		DestroyMesh(i + 1);
+	mMeshes.clear();
+	mFree.clear();
+	mGrid = mCube = 0;
+}
+
+/*------------------------------------------------------------------*
+ *							 CreateScene()							*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		The grid lining the inside of a 4000 unit box, one line		*
+ *		mesh coloured by face										*
+ *		A 20 unit cube, one indexed triangle mesh					*
+ *																	*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+bool VOGLRenderSystem::CreateScene()
+{
+	/* 'i' is the line's position along the face, '+' and '-' the box walls */
+	static const char	vGridEnds[6][4][4] = {
+		{ "i++", "i-+", "+i+", "-i+" },		/* front */
+		{ "i+-", "i--", "+i-", "-i-" },		/* back */
+		{ "-i+", "-i-", "-+i", "--i" },		/* left */
+		{ "+i+", "+i-", "++i", "+-i" },		/* right */
+		{ "+-i", "--i", "i-+", "i--" },		/* floor */
+		{ "++i", "-+i", "i++", "i+-" }		/* ceiling */
+	};
+	static const VBYTE	vGridColors[6][3] = {
+		{ 255, 0, 0 }, { 0, 255, 0 }, { 0, 0, 255 },
+		{ 255, 255, 0 }, { 0, 255, 255 }, { 255, 0, 255 }
+	};
+	static const signed char vCubeCorners[6][4][3] = {
+		{ { 1, 1,-1 }, {-1, 1,-1 }, {-1, 1, 1 }, { 1, 1, 1 } },
+		{ { 1,-1,-1 }, {-1,-1,-1 }, {-1,-1, 1 }, { 1,-1, 1 } },
+		{ { 1, 1, 1 }, {-1, 1, 1 }, {-1,-1, 1 }, { 1,-1, 1 } },
+		{ { 1,-1,-1 }, {-1,-1,-1 }, {-1, 1,-1 }, { 1, 1,-1 } },
+		{ {-1, 1, 1 }, {-1, 1,-1 }, {-1,-1,-1 }, {-1,-1, 1 } },
+		{ { 1, 1,-1 }, { 1, 1, 1 }, { 1,-1, 1 }, { 1,-1,-1 } }
+	};
+	static const VBYTE	vCubeColors[6][3] = {
+		{ 0, 255, 0 }, { 255, 128, 0 }, { 255, 0, 0 },
+		{ 255, 255, 0 }, { 0, 0, 255 }, { 255, 0, 255 }
+	};
+	const int					vCount = 2000;
+	std::vector<VColorVertex>	vVerts;
+	std::vector<VUINT>			vIndis;
+	VColorVertex				vVert;
+	VMeshDesc					vDesc;
+
+	vVert.mColor[3] = 255;
+	for (int i = -vCount; i <= vCount; i += 50)
+	{
+		for (int f = 0; f < 6; f++)
+		{
+			for (int e = 0; e < 4; e++)
+			{
+				for (int c = 0; c < 3; c++)
+				{
+					char vAxis = vGridEnds[f][e][c];
+					vVert.mPos[c] = (float)(vAxis == 'i' ? i : (vAxis == '+' ? vCount : -vCount));
+					vVert.mColor[c] = vGridColors[f][c];
+				}
+				vVerts.push_back(vVert);
+			}
+		}
+	}
+	vDesc.mFormat = VERTEX_POSITION | VERTEX_COLOR;
+	vDesc.mPrimitive = PRIM_LINES;
+	vDesc.mNumVerts = (VUINT)vVerts.size();
+	mGrid = CreateMesh(vDesc, &vVerts[0], NULL);
+
+	vVerts.clear();
+	for (int f = 0; f < 6; f++)
+	{
+		for (int e = 0; e < 4; e++)
+		{
+			for (int c = 0; c < 3; c++)
+			{
+				vVert.mPos[c] = 10.0f * vCubeCorners[f][e][c];
+				vVert.mColor[c] = vCubeColors[f][c];
+			}
+			vVerts.push_back(vVert);
+		}
+		VUINT vBase = f * 4;
+		VUINT vQuad[6] = { vBase, vBase + 1, vBase + 2, vBase, vBase + 2, vBase + 3 };
+		vIndis.insert(vIndis.end(), vQuad, vQuad + 6);
+	}
+	vDesc.mPrimitive = PRIM_TRIANGLES;
+	vDesc.mNumVerts = (VUINT)vVerts.size();
+	vDesc.mNumIndis = (VUINT)vIndis.size();
+	mCube = CreateMesh(vDesc, &vVerts[0], &vIndis[0]);
+
+	return mGrid != 0 && mCube != 0;
+}
+
 
 } // End Namespace
 
@@ -14,6 +14,7 @@
 #define __OGLRENDERSYSTEM_H_INCLUDED__
 
 /* System Headers */
+#include <vector>
 
 /* Local Headers */
 #include <viper3d/RenderSystem.h>
@@ -53,13 +54,26 @@ public:
 	/*==================================*
 	 *			  ATTRIBUTES			*
 	 *==================================*/
+	static bool		HasExtension(const char *pName, const char *pExts = NULL);
 
 	/*==================================*
 	 *			  OPERATIONS			*
 	 *==================================*/
 	VWindow*		CreateWin(VWindowOpts *pOpts);
 	void			DestroyWin(VWindow *pWin);
-	bool			Render(VWindow *pWin, VCamera *pCamera);
+	bool			Render(VWindow *pWin, VCamera *pCamera,
+							VRenderQueue *pQueue = NULL);
+	VMeshHandle		CreateMesh(const VMeshDesc& desc, const void *pVerts,
+							const VUINT *pIndis);
+	bool			UpdateMesh(VMeshHandle hMesh, const void *pVerts,
+							VUINT nNumVerts, const VUINT *pIndis = NULL,
+							VUINT nNumIndis = 0);
+	void			DestroyMesh(VMeshHandle hMesh);
+	void			SetWorldMatrix(const VMatrix& mat);
+	bool			DrawMesh(VMeshHandle hMesh);
+	bool			DrawMeshRanges(VMeshHandle hMesh, const VUINT *pFirsts,
+							const VUINT *pCounts, VUINT nRanges);
+	void			SetState(VUINT nMaterial, VUINT nTexture);
 
 protected:
 	/*==================================*
@@ -70,13 +84,48 @@ private:
 	/*==================================*
 	 *             INTERNALS            *
 	 *==================================*/
+	/**
+	 *	A mesh as the GL sees it: a vertex buffer, an optional index
+	 *	buffer, and a vertex array object recording the layout when the
+	 *	driver has them.  Capacities are in bytes.
+	 */
+	struct VOGLMesh
+	{
+		VMeshDesc	mDesc;
+		VUINT		mVbo;
+		VUINT		mIbo;
+		VUINT		mVao;
+		VUINT		mVertCap;
+		VUINT		mIndiCap;
+		bool		mLive;
+	};
 
+	VWindow*		CreateOffscreen(VWindowOpts *pOpts);
+	void			InitContext(const VWindowOpts& opts);
+	bool			LoadEntryPoints();
+	VOGLMesh*		GetMesh(VMeshHandle hMesh);
+	void			Upload(VUINT nTarget, VUINT nBuffer, VUINT *pCap,
+							VUINT nSize, const void *pData, VBufferUsage nUsage);
+	void			BindLayout(const VOGLMesh& mesh);
+	void			BindMesh(const VOGLMesh& mesh);
+	void			UnbindMesh();
+	void			DestroyMeshes();
+	bool			CreateScene();
 
 private:
 	/*==================================*
 	 *             VARIABLES            *
 	 *==================================*/
-	
+	std::vector<VOGLMesh>		mMeshes;	/**< handle - 1 indexes this */
+	std::vector<VMeshHandle>	mFree;		/**< destroyed handles to reuse */
+	bool						mHaveVbo;
+	bool						mHaveVao;
+	float						mView[16];	/**< camera transform, as GL wants */
+	VMeshHandle					mGrid;
+	VMeshHandle					mCube;
+	std::vector<int>			mFirsts;	/**< DrawMeshRanges() scratch */
+	std::vector<int>			mCounts;
+	std::vector<const void*>	mOffsets;
 };
 
 } // End Namespace
@@ -36,6 +36,8 @@ VCamera::VCamera()
 	: VMovable()
 {
 	mUpdateFrustum = true;
+	mUpdateView = true;
+	mUpdatePlanes = true;
 	mViewMatrix = VMatrix::MATRIX_ZERO;
 	mFOV = 45.0f;
 	mNear = 0.1f;
@@ -54,6 +56,44 @@ VCamera::~VCamera()
  *                        A T T R I B U T E S                       *
  ********************************************************************/
 
+/*------------------------------------------------------------------*
+ *						GetViewProjection()							*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *																	*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+const VMatrix& VCamera::GetViewProjection()
+{
+	UpdateView();
+	UpdateFrustum();
+	UpdatePlanes();
+	return mViewProjMatrix;
+}
+
+/*------------------------------------------------------------------*
+ *						GetFrustumPlanes()							*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *																	*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+const VPlane* VCamera::GetFrustumPlanes()
+{
+	UpdateView();
+	UpdateFrustum();
+	UpdatePlanes();
+	return mFrustumPlanes;
+}
+
 /********************************************************************
  *                        O P E R A T I O N S                       *
  ********************************************************************/
@@ -67,25 +107,21 @@ VCamera::~VCamera()
  * MODIFICATIONS													*
  *	Date		Description							Author			*
  * ===========	==================================	===============	*
- *																	*
+ *	17-Oct-2026	Invert the camera's VAffine instead					*
+ *				of transposing a VMatrix and						*
+ *				rotating the position through it					*
  *------------------------------------------------------------------*/
 void VCamera::UpdateView()
 {
 	if (mUpdateView)
 	{
-		VMatrix vRot;
-		mOrientation.ToRotationMatrix(vRot);
-
-		// Make the translation relative to the new axes;
-		VMatrix vRotT = vRot.Transpose();
-		VVector vTrans = -vRotT * mPosition;
-
-		// Make the final matrix
-		mViewMatrix = vRotT;
-		mViewMatrix[0][3] = vTrans.x;
-		mViewMatrix[1][3] = vTrans.y;
-		mViewMatrix[2][3] = vTrans.z;
-		mViewMatrix[3][3] = 1.0f;
+		VAffine vCamera;
+
+		/* the view undoes the camera's own rotation and position */
+		GetLocalTransform(vCamera);
+		mView.OrthoInverseOf(vCamera);
+		mView.ToMatrix(mViewMatrix);
+		mUpdatePlanes = true;
 	}
 	mUpdateView = false;
 }
@@ -94,12 +130,13 @@ void VCamera::UpdateView()
  *							UpdateFrustum()							*
  *------------------------------------------------------------------*
  *	ALGORITHM:														*
- *																	*
+ *		Builds the same matrix glFrustum() would for the symmetric	*
+ *		volume, so culling sees exactly what is rendered.			*
  *------------------------------------------------------------------*
  * MODIFICATIONS													*
  *	Date		Description							Author			*
  * ===========	==================================	===============	*
- *																	*
+ *	17-Oct-2026	Cache the projection matrix							*
  *------------------------------------------------------------------*/
 void VCamera::UpdateFrustum()
 {
@@ -107,6 +144,14 @@ void VCamera::UpdateFrustum()
 	{
 		mFrustrumH = VMath::Tan(mFOV / 180 * VMath::PI) * mNear / 2;
 		mFrustrumW = mFrustrumH * mAspect;
+
+		mProjMatrix = VMatrix::MATRIX_ZERO;
+		mProjMatrix[0][0] = mNear / mFrustrumW;
+		mProjMatrix[1][1] = mNear / mFrustrumH;
+		mProjMatrix[2][2] = -(mFar + mNear) / (mFar - mNear);
+		mProjMatrix[2][3] = -2.0f * mFar * mNear / (mFar - mNear);
+		mProjMatrix[3][2] = -1.0f;
+		mUpdatePlanes = true;
 	}
 	mUpdateFrustum = false;
 }
@@ -150,10 +195,10 @@ void VCamera::OnRender()
 	UpdateFrustum();
 
 	GLfloat	 vGLMatrix[16];
-	mViewMatrix.MakeGLMatrix(vGLMatrix);
+	mProjMatrix.MakeGLMatrix(vGLMatrix);
 	glMatrixMode(GL_PROJECTION);
-	glLoadIdentity();
-	glFrustum(-mFrustrumW, mFrustrumW, -mFrustrumH, mFrustrumH, mNear, mFar);
+	glLoadMatrixf(vGLMatrix);
+	mViewMatrix.MakeGLMatrix(vGLMatrix);
 	glMatrixMode(GL_MODELVIEW);
 	glLoadMatrixf(vGLMatrix);
 }
@@ -162,4 +207,51 @@ void VCamera::OnRender()
  *                         I N T E R N A L S                        *
  ********************************************************************/
 
+/*------------------------------------------------------------------*
+ *							UpdatePlanes()							*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Clip space bounds are -w <= x,y,z <= w, so each plane is	*
+ *		row 3 of the view-projection plus or minus row 0, 1 or 2.	*
+ *		Those normals point in; they are negated to match the		*
+ *		outward convention Cull() expects, then normalized.			*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VCamera::UpdatePlanes()
+{
+	if (mUpdatePlanes)
+	{
+		mViewProjMatrix = mProjMatrix * mView;
+
+		const VMatrix& vM = mViewProjMatrix;
+		VVector	vN;
+		float	fD, fLen, fSign;
+		int		nRow;
+
+		for (int i = 0; i < VFRUSTUM_PLANES; i++)
+		{
+			nRow = i / 2;
+			fSign = (i & 1) ? -1.0f : 1.0f;
+
+			vN.SetValues(-(vM[3][0] + fSign * vM[nRow][0]),
+						 -(vM[3][1] + fSign * vM[nRow][1]),
+						 -(vM[3][2] + fSign * vM[nRow][2]), 0.0f);
+			fD = -(vM[3][3] + fSign * vM[nRow][3]);
+
+			fLen = vN.Length();
+			if (fLen > 0.0f)
+			{
+				vN /= fLen;
+				fD /= fLen;
+			}
+			mFrustumPlanes[i].Set(vN, vN * -fD, fD);
+		}
+	}
+	mUpdatePlanes = false;
+}
+
 } // End Namespace
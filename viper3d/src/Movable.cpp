@@ -72,6 +72,54 @@ VVector VMovable::GetDirection() const
 	return mOrientation * -VVector::VECTOR_UNIT_Z;
 }
 
+/*------------------------------------------------------------------*
+ *							 GetBounds()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Returns a cube of edge GetSize() around our position in
+ *				the world.
+ *	@date		17-Oct-2026
+ *
+ *	@param		box		Receives the bounds
+ *
+ *	@returns	(bool) False if no size has been set
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+bool VMovable::GetBounds(VAabb &box)
+{
+	if (mSize <= 0.0f)
+		return false;
+
+	const VAffine& vWorld = GetWorldTransform();
+	VVector vCenter(vWorld[0][3], vWorld[1][3], vWorld[2][3]);
+	VVector vHalf(mSize * 0.5f, mSize * 0.5f, mSize * 0.5f);
+	box = VAabb(vCenter - vHalf, vCenter + vHalf);
+	return true;
+}
+
+/*------------------------------------------------------------------*
+ *						 GetLocalTransform()						*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Rotation from mOrientation, translation from mPosition		*
+ *																	*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *	17-Oct-2026	Build a VAffine rather than a full					*
+ *				VMatrix												*
+ *------------------------------------------------------------------*/
+void VMovable::GetLocalTransform(VAffine &xf)
+{
+	xf.Set(mOrientation, mPosition);
+}
+
 /********************************************************************
  *                        O P E R A T I O N S                       *
  ********************************************************************/
@@ -90,13 +138,16 @@ VVector VMovable::GetDirection() const
  * MODIFICATIONS													*
  *	Date		Description							Author			*
  * ===========	==================================	===============	*
- *																	*
+ *	17-Oct-2026	Refit any VSceneBvh we are in						*
+ *	17-Oct-2026	Flag the world transform instead;					*
+ *				the refit follows its update						*
  *------------------------------------------------------------------*/
 VVector VMovable::SetPosition(const VVector& pNewPosition)
 {
 	VVector vOld = mPosition;
 	mPosition = pNewPosition;
 	OnMove();
+	TransformChanged();
 	return vOld;
 }
 
@@ -165,7 +216,7 @@ void VMovable::LookAt(scalar_t pX, scalar_t pY, scalar_t pZ)
  * MODIFICATIONS													*
  *	Date		Description							Author			*
  * ===========	==================================	===============	*
- *																	*
+ *	17-Oct-2026	Flag the world transform							*
  *------------------------------------------------------------------*/
 void VMovable::SetDirection(const VVector& pVec)
 {
@@ -199,6 +250,7 @@ void VMovable::SetDirection(const VVector& pVec)
 	mOrientation = vRotQuat * mOrientation;
 
 	OnRotate();
+	TransformChanged();
 }
 
 /*------------------------------------------------------------------*
@@ -363,12 +415,13 @@ void VMovable::Rotate(const VVector& pAxis, scalar_t pDegrees)
  * MODIFICATIONS													*
  *	Date		Description							Author			*
  * ===========	==================================	===============	*
- *																	*
+ *	17-Oct-2026	Flag the world transform							*
  *------------------------------------------------------------------*/
 void VMovable::Rotate(const VQuaternion& pQ)
 {
 	mOrientation = pQ * mOrientation;
 	OnRotate();
+	TransformChanged();
 }
 
 
@@ -17,6 +17,8 @@
 #include <GL/gl.h>
 
 /* Local Headers */
+#include <viper3d/SceneBvh.h>
+#include <viper3d/RenderSystem.h>
 
 namespace UDP
 {
@@ -28,18 +30,32 @@ VNode::VNode()
 {
 	mParentNode = mChildNode = NULL;
 
-	mPrevNode = mNextNode = NULL;
+	mPrevNode = mNextNode = this;
+	mList = NULL;
+	mListIndex = 0;
+	mSceneBvh = NULL;
+	mSceneItem = 0;
 }
 
 VNode::VNode(VNode *pNode)
 {
 	mParentNode = mChildNode = NULL;
 	mPrevNode = mNextNode = this;
+	mList = NULL;
+	mListIndex = 0;
+	mSceneBvh = NULL;
+	mSceneItem = 0;
 	AttachTo(pNode);
 }
 
 VNode::~VNode()
 {
+	/*
+	 * Drop out of any hierarchy we are indexed in.
+	 */
+	if (mSceneBvh)
+		mSceneBvh->Remove(this);
+
 	/*
 	 * Take us out of our parent's linked list.
 	 */
@@ -52,6 +68,8 @@ VNode::~VNode()
 	{
 		delete mChildNode;
 	}
+
+	delete mList;
 }
 
 /********************************************************************
@@ -115,6 +133,49 @@ bool VNode::IsLastChild()
 		return false;
 }
 
+/*------------------------------------------------------------------*
+ *							GetNodeList()							*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *																	*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+const VNodeList* VNode::GetNodeList()
+{
+	VNode *vRoot = FindRoot();
+
+	if (vRoot->mList == NULL)
+	{
+		vRoot->mList = new VNodeList;
+		vRoot->mList->mDirty = true;
+	}
+	if (vRoot->mList->mDirty)
+		vRoot->BuildList();
+
+	return vRoot->mList;
+}
+
+/*------------------------------------------------------------------*
+ *						 GetWorldTransform()						*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *																	*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+const VAffine& VNode::GetWorldTransform()
+{
+	UpdateTransforms();
+	return FindRoot()->mList->mWorld[mListIndex];
+}
+
 
 /********************************************************************
  *                        O P E R A T I O N S                       *
@@ -124,31 +185,226 @@ bool VNode::IsLastChild()
  *								Render()							*
  *------------------------------------------------------------------*
  *	ALGORITHM:														*
- *		Render this object											*
- *		If this object has children									*
- *			render them												*
- *		If this object has siblings									*
- *			render them												*
+ *		Bring the world transforms of the tree up to date			*
+ *		Read the view transform the camera left in GL				*
+ *		For each node in our range of the node list					*
+ *			load view * world and render it							*
+ *		Put the view transform back									*
  *																	*
  *------------------------------------------------------------------*
  * MODIFICATIONS													*
  *	Date		Description							Author			*
  * ===========	==================================	===============	*
- *																	*
+ *	17-Oct-2026	Walk the node list instead of						*
+ *				recursing, and load each node's						*
+ *				transform instead of using the GL					*
+ *				matrix stack										*
  *------------------------------------------------------------------*/
 void VNode::Render()
 {
-	glPushMatrix();
-		OnRender();
-		if (HasChild())
-			((VNode*)mChildNode)->Render();
-	glPopMatrix();
+	GLfloat	vGLMatrix[16];
+	VMatrix	vModelView;
 
-	/*
-	 * Draw siblings
-	 */
-	if (HasParent() && !IsLastChild())
-		((VNode*)mNextNode)->Render();
+	UpdateTransforms();
+
+	VNodeList *vList = FindRoot()->mList;
+	VUINT vEnd = vList->mEnd[mListIndex];
+
+	glGetFloatv(GL_MODELVIEW_MATRIX, vGLMatrix);
+	VMatrix vView(vGLMatrix[0], vGLMatrix[4], vGLMatrix[8], vGLMatrix[12],
+				  vGLMatrix[1], vGLMatrix[5], vGLMatrix[9], vGLMatrix[13],
+				  vGLMatrix[2], vGLMatrix[6], vGLMatrix[10], vGLMatrix[14],
+				  vGLMatrix[3], vGLMatrix[7], vGLMatrix[11], vGLMatrix[15]);
+
+	for (VUINT i = mListIndex; i < vEnd; i++)
+	{
+		vModelView = vView * vList->mWorld[i];
+		vModelView.MakeGLMatrix(vGLMatrix);
+		glLoadMatrixf(vGLMatrix);
+		vList->mNodes[i]->OnRender();
+	}
+
+	vView.MakeGLMatrix(vGLMatrix);
+	glLoadMatrixf(vGLMatrix);
+}
+
+/*------------------------------------------------------------------*
+ *								Render()							*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Bring the world transforms of the tree up to date			*
+ *		For each node in our range of the node list					*
+ *			hand its world transform to the render system			*
+ *			and render it											*
+ *		Leave the render system with the identity					*
+ *																	*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VNode::Render(VRenderSystem *pRender)
+{
+	VMatrix	vWorld;
+
+	UpdateTransforms();
+
+	VNodeList *vList = FindRoot()->mList;
+	VUINT vEnd = vList->mEnd[mListIndex];
+
+	for (VUINT i = mListIndex; i < vEnd; i++)
+	{
+		vList->mWorld[i].ToMatrix(vWorld);
+		pRender->SetWorldMatrix(vWorld);
+		vList->mNodes[i]->OnRender();
+	}
+
+	pRender->SetWorldMatrix(VMatrix::MATRIX_IDENTITY);
+}
+
+/*------------------------------------------------------------------*
+ *								Queue()								*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Bring the world transforms of the tree up to date			*
+ *		For this node, or each node in its range of the node list	*
+ *			hand it the queue and its world transform				*
+ *																	*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VNode::Queue(VRenderQueue *pQueue, bool bChildren /*=true*/)
+{
+	VMatrix	vWorld;
+
+	UpdateTransforms();
+
+	VNodeList *vList = FindRoot()->mList;
+	VUINT vEnd = bChildren ? vList->mEnd[mListIndex] : mListIndex + 1;
+
+	for (VUINT i = mListIndex; i < vEnd; i++)
+	{
+		vList->mWorld[i].ToMatrix(vWorld);
+		vList->mNodes[i]->OnQueue(pQueue, vWorld);
+	}
+}
+
+/*------------------------------------------------------------------*
+ *						   UpdateTransforms()						*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Bail if no node in the tree has moved						*
+ *		Update the whole node list with UpdateRange()				*
+ *																	*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *	17-Oct-2026	Only recompute moved subtrees						*
+ *------------------------------------------------------------------*/
+void VNode::UpdateTransforms()
+{
+	VNodeList *vList = const_cast<VNodeList*>(GetNodeList());
+
+	if (vList->mNumMoved == 0)
+		return;
+
+	vList->mNumMoved -= UpdateRange(vList, 0, (VUINT)vList->mNodes.size(),
+			0, vList->mNumMoved, NULL);
+}
+
+/*------------------------------------------------------------------*
+ *						   UpdateTransforms()						*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Bail if no node in the tree has moved						*
+ *		Walk down from the root.  For each node					*
+ *			If its subtree is no bigger than a grain, queue it as	*
+ *				a range, joining it to the previous range if they	*
+ *				touch, start in the same dirty state and still fit	*
+ *			Otherwise update it here and step into its children		*
+ *		Update the queued ranges in parallel, each job collecting	*
+ *			the nodes whose bounds moved							*
+ *		In range order, count off the cleared flags and report the	*
+ *			moved bounds											*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VNode::UpdateTransforms(VJobSystem &jobs)
+{
+	VNodeList						*vList = const_cast<VNodeList*>(GetNodeList());
+	std::vector<VTransformRange>	vRanges;
+	VTransformRange					vRange;
+	VUINT							vCount = (VUINT)vList->mNodes.size();
+	VUINT							vGrain, vDirtyEnd = 0, vStart, i = 0;
+
+	if (vList->mNumMoved == 0)
+		return;
+	if (jobs.GetNumThreads() <= 1)
+	{
+		UpdateTransforms();
+		return;
+	}
+
+	vGrain = vCount / (VUINT)(jobs.GetNumThreads() * 4);
+	if (vGrain < VNODE_JOB_GRAIN)
+		vGrain = VNODE_JOB_GRAIN;
+
+	vRange.mList = vList;
+	vRange.mCleared = 0;
+	while (i < vCount)
+	{
+		if (vList->mEnd[i] - i <= vGrain)
+		{
+			vStart = (i < vDirtyEnd ? vDirtyEnd : 0);
+			if (!vRanges.empty() && vRanges.back().mEnd == i &&
+				vRanges.back().mDirtyEnd == vStart &&
+				vList->mEnd[i] - vRanges.back().mFirst <= vGrain)
+			{
+				vRanges.back().mEnd = vList->mEnd[i];
+			}
+			else
+			{
+				vRange.mFirst = i;
+				vRange.mEnd = vList->mEnd[i];
+				vRange.mDirtyEnd = vStart;
+				vRanges.push_back(vRange);
+			}
+			i = vList->mEnd[i];
+			continue;
+		}
+
+		if (vList->mMoved[i])
+		{
+			vList->mMoved[i] = 0;
+			vList->mNumMoved--;
+			if (vList->mEnd[i] > vDirtyEnd)
+				vDirtyEnd = vList->mEnd[i];
+		}
+		if (i < vDirtyEnd)
+		{
+			UpdateNode(vList, i);
+			vList->mNodes[i]->BoundsChanged();
+		}
+		i++;
+	}
+
+	if (!vRanges.empty())
+		jobs.ParallelFor(UpdateJob, &vRanges[0], (VUINT)vRanges.size(), 1);
+
+	for (VUINT r = 0; r < vRanges.size(); r++)
+	{
+		vList->mNumMoved -= vRanges[r].mCleared;
+		for (VUINT n = 0; n < vRanges[r].mBounds.size(); n++)
+			vRanges[r].mBounds[n]->BoundsChanged();
+	}
 }
 
 /*------------------------------------------------------------------*
@@ -167,7 +423,8 @@ void VNode::Render()
  * MODIFICATIONS													*
  *	Date		Description							Author			*
  * ===========	==================================	===============	*
- *																	*
+ *	17-Oct-2026	Only child links to itself							*
+ *	17-Oct-2026	Invalidate the root's node list						*
  *------------------------------------------------------------------*/
 void VNode::AttachTo(VNode *pNewParent)
 {
@@ -192,9 +449,16 @@ void VNode::AttachTo(VNode *pNewParent)
 	else
 	{
 		mParentNode->SetChild(this);
-		mPrevNode = NULL;
-		mNextNode = NULL;
+		mPrevNode = this;
+		mNextNode = this;
 	}
+
+	/*
+	 * We are no longer a root, and the tree we joined has changed.
+	 */
+	delete mList;
+	mList = NULL;
+	InvalidateList();
 }
 
 /*------------------------------------------------------------------*
@@ -211,7 +475,8 @@ void VNode::AttachTo(VNode *pNewParent)
  * MODIFICATIONS													*
  *	Date		Description							Author			*
  * ===========	==================================	===============	*
- *																	*
+ *	17-Oct-2026	Only child links to itself							*
+ *	17-Oct-2026	Invalidate the root's node list						*
  *------------------------------------------------------------------*/
 void VNode::Attach(VNode *pNewChild)
 {
@@ -236,52 +501,60 @@ void VNode::Attach(VNode *pNewChild)
 	else
 	{
 		mChildNode = pNewChild;
-		mChildNode->SetPrev(NULL);
-		mChildNode->SetNext(NULL);
+		mChildNode->SetPrev(pNewChild);
+		mChildNode->SetNext(pNewChild);
 	}
+
+	delete pNewChild->mList;
+	pNewChild->mList = NULL;
+	InvalidateList();
 }
 
 /*------------------------------------------------------------------*
  *								Detach()							*
  *------------------------------------------------------------------*
  *	ALGORITHM:														*
- *		If we have a parent node and we're the first child			*
- *			If we're not an only child								*
- *				move our first sibling to the parent's first child	*
- *			Else													*
+ *		If we have a parent node									*
+ *			If we're an only child									*
  *				parent's first child is null						*
- *		Set our previous sibling's next node to our next node		*
- *		Set our next sibling's prev node to our prev node			*
+ *			Else													*
+ *				If we're the first child, move the parent's first	*
+ *					child to our next sibling						*
+ *				Set our previous sibling's next node to our next	*
+ *				Set our next sibling's prev node to our prev node	*
+ *		We are now a lone top-level node							*
  *																	*
  *------------------------------------------------------------------*
  * MODIFICATIONS													*
  *	Date		Description							Author			*
  * ===========	==================================	===============	*
- *																	*
+ *	17-Oct-2026	Keep sibling rings circular, clear					*
+ *				the parent pointer									*
+ *	17-Oct-2026	Invalidate the root's node list						*
  *------------------------------------------------------------------*/
 void VNode::Detach()
 {
-	if (mParentNode && mParentNode->mChildNode == this)
+	if (mParentNode)
 	{
-		mParentNode->SetChild(mNextNode);
-	}
+		InvalidateList();
 
-	if (mPrevNode == mNextNode)
-	{
-		if (mPrevNode != NULL)
+		if (mNextNode == this)
 		{
-			mPrevNode->SetNext(NULL);
-			mNextNode->SetPrev(NULL);
+			mParentNode->SetChild(NULL);
+		}
+		else
+		{
+			if (mParentNode->mChildNode == this)
+				mParentNode->SetChild(mNextNode);
+
+			mPrevNode->SetNext(mNextNode);
+			mNextNode->SetPrev(mPrevNode);
 		}
-	}
-	else
-	{
-		mPrevNode->SetNext(mNextNode);
-		mNextNode->SetPrev(mPrevNode);
 	}
 
-	mPrevNode = NULL;
-	mNextNode = NULL;
+	mParentNode = NULL;
+	mPrevNode = this;
+	mNextNode = this;
 }
 
 
@@ -294,22 +567,229 @@ void VNode::Detach()
  * MODIFICATIONS													*
  *	Date		Description							Author			*
  * ===========	==================================	===============	*
- *																	*
+ *	17-Oct-2026	Count every child, not just the						*
+ *				first one											*
  *------------------------------------------------------------------*/
 int VNode::CountNodes()
 {
-	if (mChildNode)
-		return mChildNode->CountNodes() + 1;
-	else
-		return 1;
+	int		vCount = 1;
+	VNode	*vChild = mChildNode;
+
+	if (vChild)
+	{
+		do
+		{
+			vCount += vChild->CountNodes();
+			vChild = vChild->GetNext();
+		} while (vChild != mChildNode);
+	}
+	return vCount;
 }
 
 /********************************************************************
  *                         C A L L B A C K S                        *
  ********************************************************************/
 
+/*------------------------------------------------------------------*
+ *							BoundsChanged()							*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *																	*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VNode::BoundsChanged()
+{
+	if (mSceneBvh)
+		mSceneBvh->Invalidate(this);
+}
+
+/*------------------------------------------------------------------*
+ *						  TransformChanged()						*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Flag our entry in the root's list.  A list waiting to be	*
+ *		rebuilt will flag every node anyway.						*
+ *																	*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VNode::TransformChanged()
+{
+	VNodeList *vList = FindRoot()->mList;
+
+	if (vList == NULL || vList->mDirty || vList->mMoved[mListIndex])
+		return;
+
+	vList->mMoved[mListIndex] = 1;
+	vList->mNumMoved++;
+}
+
 /********************************************************************
  *                         I N T E R N A L S                        *
  ********************************************************************/
 
+/*------------------------------------------------------------------*
+ *							InvalidateList()						*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *																	*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VNode::InvalidateList()
+{
+	VNode *vRoot = FindRoot();
+
+	if (vRoot->mList)
+		vRoot->mList->mDirty = true;
+}
+
+/*------------------------------------------------------------------*
+ *							  BuildList()							*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Walk the tree depth first with an explicit stack, pushing	*
+ *			children last to first so they come out in order		*
+ *		Give each node the next index, recording its parent's		*
+ *		Sweep backwards, widening each parent's subtree end to		*
+ *			cover its children's									*
+ *		Flag every node as moved, since indices have changed		*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VNode::BuildList()
+{
+	std::vector<VNode*>	vStack;
+	std::vector<int>	vParents;
+	VNode				*vNode, *vChild;
+	int					vParent;
+	VUINT				vIndex;
+
+	mList->mNodes.clear();
+	mList->mParent.clear();
+
+	vStack.push_back(this);
+	vParents.push_back(-1);
+	while (!vStack.empty())
+	{
+		vNode = vStack.back();
+		vParent = vParents.back();
+		vStack.pop_back();
+		vParents.pop_back();
+
+		vIndex = (VUINT)mList->mNodes.size();
+		vNode->mListIndex = vIndex;
+		mList->mNodes.push_back(vNode);
+		mList->mParent.push_back(vParent);
+
+		if (vNode->mChildNode)
+		{
+			vChild = vNode->mChildNode->mPrevNode;
+			for (;;)
+			{
+				vStack.push_back(vChild);
+				vParents.push_back((int)vIndex);
+				if (vChild == vNode->mChildNode)
+					break;
+				vChild = vChild->mPrevNode;
+			}
+		}
+	}
+
+	vIndex = (VUINT)mList->mNodes.size();
+	mList->mEnd.resize(vIndex);
+	for (VUINT i = 0; i < vIndex; i++)
+		mList->mEnd[i] = i + 1;
+	for (VUINT i = vIndex; i-- > 1; )
+	{
+		vParent = mList->mParent[i];
+		if (mList->mEnd[i] > mList->mEnd[vParent])
+			mList->mEnd[vParent] = mList->mEnd[i];
+	}
+
+	mList->mWorld.resize(vIndex, VAffine::AFFINE_IDENTITY);
+	mList->mMoved.assign(vIndex, 1);
+	mList->mNumMoved = vIndex;
+	mList->mDirty = false;
+}
+
+/*------------------------------------------------------------------*
+ *							 UpdateRange()							*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		For each node in [nFirst, nEnd); parents always come first	*
+ *			If it has moved, widen the dirty range to the end of	*
+ *				its subtree											*
+ *			Inside the dirty range,									*
+ *				world[i] = world[parent[i]] * local[i]				*
+ *			Stop once nMoved flags have been seen and we are past	*
+ *				the dirty range										*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+VUINT VNode::UpdateRange(VNodeList *pList, VUINT nFirst, VUINT nEnd,
+							VUINT nDirtyEnd, VUINT nMoved,
+							std::vector<VNode*> *pBounds)
+{
+	VUINT	vCleared = 0;
+	VNode	*vNode;
+
+	for (VUINT i = nFirst; i < nEnd && (vCleared < nMoved || i < nDirtyEnd); i++)
+	{
+		if (pList->mMoved[i])
+		{
+			pList->mMoved[i] = 0;
+			vCleared++;
+			if (pList->mEnd[i] > nDirtyEnd)
+				nDirtyEnd = pList->mEnd[i];
+		}
+		if (i >= nDirtyEnd)
+			continue;
+
+		UpdateNode(pList, i);
+		vNode = pList->mNodes[i];
+		if (pBounds == NULL)
+			vNode->BoundsChanged();
+		else if (vNode->mSceneBvh)
+			pBounds->push_back(vNode);
+	}
+	return vCleared;
+}
+
+void VNode::UpdateNode(VNodeList *pList, VUINT nIndex)
+{
+	VAffine	vLocal;
+	int		vParent = pList->mParent[nIndex];
+
+	pList->mNodes[nIndex]->GetLocalTransform(vLocal);
+	if (vParent < 0)
+		pList->mWorld[nIndex] = vLocal;
+	else
+		pList->mWorld[nIndex] = pList->mWorld[vParent] * vLocal;
+}
+
+void VNode::UpdateJob(VJob *pJob)
+{
+	VTransformRange *vRange = (VTransformRange*)pJob->mData + pJob->mFirst;
+
+	vRange->mCleared = UpdateRange(vRange->mList, vRange->mFirst, vRange->mEnd,
+			vRange->mDirtyEnd, vRange->mEnd - vRange->mFirst, &vRange->mBounds);
+}
+
 } // End Namespace
@@ -1,249 +1,969 @@
-/*============================================================================*
- *                                                                            *
- * 	This file is part of the Viper3D Game Engine.							  *
- *                                                                            *
- *	Copyright (C) 2004 UDP Games   All Rights Reserved.						  *
- *                                                                            *
- *============================================================================*
- *                                  CHANGELOG                                 *
- *    Date      Description                                     Author        *
- * -----------  ----------------------------------------------	------------- *
- *                                                                            *
- *============================================================================*/
-#ifdef PROFILER
-#include <cstdio>
-#include <cassert>
-#include <iostream>
-#include <viper3d/VProfiler.h>
-
-using std::cout;
-using std::endl;
-
-int VProfileSample::mLastOpenedSample = -1;
-int VProfileSample::mOpenSampleCount = 0;
-VProfileSample::VSample VProfileSample::mSamples[MAX_PROFILER_SAMPLES];
-double VProfileSample::mRootBegin=0.0f;
-double VProfileSample::mRootEnd=0.0f;
-bool VProfileSample::mProfilerIsRunning=true;
-struct timeval VProfileSample::mStartTime;
-bool VProfileSample::mTimeSet = false;
-
-VProfileSample::VProfileSample(std::string pSampleName)
-{
-	if(!mProfilerIsRunning)
-		return;
-	//find the sample
-	int i = 0;
-	int vStoreIndex = -1;
-	for (i = 0; i < MAX_PROFILER_SAMPLES; ++i)
-	{
-		if (!mSamples[i].mIsValid)
-		{
-			//cout << "Invalid sample" << endl;
-			if (vStoreIndex < 0)
-				vStoreIndex = i;
-		}
-		else
-		{
-			if (mSamples[i].mName == pSampleName)
-			{
-				//cout << "Found matching sample" << endl;
-				//this is the sample we want
-				//check that it's not already open
-				assert(!mSamples[i].mIsOpen && "Tried to profile a sample which was already being profiled");
-				//first, store it's index
-				mSampleIndex = i;
-				//the parent sample is the last opened sample
-				mParentIndex = mLastOpenedSample;
-				mLastOpenedSample = i;
-				mSamples[i].mParentCount = mOpenSampleCount;
-				++mOpenSampleCount;
-				mSamples[i].mIsOpen=true;
-				++mSamples[i].mCallCount;
-				mSamples[i].mStartTime = GetTime();
-				//if this has no parent, it must be the 'main loop' sample, so do the global timer
-				if (mParentIndex < 0)
-					mRootBegin = mSamples[i].mStartTime;
-				return;
-			}
-		}
-	}
-	//we've not found it, so it must be a new sample
-	//use the storeIndex value to store the new sample
-	assert(vStoreIndex >= 0 && "Profiler has run out of sample slots!");
-	mSamples[vStoreIndex].mIsValid = true;
-	mSamples[vStoreIndex].mName = pSampleName;
-	mSampleIndex = vStoreIndex;
-	mParentIndex = mLastOpenedSample;
-	mLastOpenedSample = vStoreIndex;
-	mSamples[i].mParentCount = mOpenSampleCount;
-	mOpenSampleCount++;
-	mSamples[vStoreIndex].mIsOpen = true;
-	mSamples[vStoreIndex].mCallCount = 1;
-
-	mSamples[vStoreIndex].mTotalTime = 0.0f;
-	mSamples[vStoreIndex].mChildTime = 0.0f;
-	mSamples[vStoreIndex].mStartTime = GetTime();
-	if (mParentIndex < 0)
-		mRootBegin = mSamples[vStoreIndex].mStartTime;
-}
-
-VProfileSample::~VProfileSample()
-{
-	if (!mProfilerIsRunning)
-		return;
-
-	double vEndTime = GetTime();
-
-	//phew... ok, we're done timing
-	mSamples[mSampleIndex].mIsOpen = false;
-
-	//calculate the time taken this profile, for ease of use later on
-	double vTimeTaken = vEndTime - mSamples[mSampleIndex].mStartTime;
-
-	if (mParentIndex >= 0)
-	{
-		mSamples[mParentIndex].mChildTime += vTimeTaken;
-	}
-	else
-	{
-		//no parent, so this is the end of the main loop sample
-		mRootEnd = vEndTime;
-	}
-
-	mSamples[mSampleIndex].mTotalTime += vTimeTaken;
-	mLastOpenedSample = mParentIndex;
-	--mOpenSampleCount;
-}
-
-void VProfileSample::Output()
-{
-	char vNamebuf[256], vIndentedName[256];
-	char vAvg[16], vMin[16], vMax[16], vNum[16], vTime[16];
-
-	if(!mProfilerIsRunning)
-		return;
-
-	cout << endl;
-	cout << "          New Profile Set" << endl;
-	cout << "  Min :   Avg :   Max :   # : Total : Profile Name" << endl;
-	cout << "--------------------------------------------" << endl;
-	/*cout << "rootBegin => [" << mRootBegin << "]" << endl;
-	cout << "rootEnd   => [" << mRootEnd << "]" << endl << endl;*/
-
-	for (int i=0; i < MAX_PROFILER_SAMPLES; ++i)
-	{
-		if(mSamples[i].mIsValid)
-		{
-			/*cout << "  ** " << mSamples[i].mName.c_str() << " **" << endl;
-			cout << "parentCount: " << mSamples[i].mParentCount << endl;
-			cout << "averagePc: " << mSamples[i].mAveragePc << endl;
-			cout << "minPc:     " << mSamples[i].mMinPc << endl;
-			cout << "maxPc:     " << mSamples[i].mMaxPc << endl;
-			cout << "totalTime: " << mSamples[i].mTotalTime << endl;
-			cout << "childTime: " << mSamples[i].mChildTime << endl;
-			cout << "dataCount: " << mSamples[i].mDataCount << endl;
-			cout << "callCount: " << mSamples[i].mCallCount << endl;*/
-			float vSampleTime, vPercentage;
-			//calculate the time spend on the sample itself (excluding children)
-			vSampleTime = mSamples[i].mTotalTime - mSamples[i].mChildTime;
-			vPercentage = ( vSampleTime / ( mRootEnd - mRootBegin ) ) * 100.0f;
-
-			//add it to the sample's values
-			float vTotalPc;
-			vTotalPc = mSamples[i].mAveragePc * mSamples[i].mDataCount;
-			vTotalPc += vPercentage;
-			mSamples[i].mDataCount++;
-			mSamples[i].mAveragePc = vTotalPc / mSamples[i].mDataCount;
-			if ((mSamples[i].mMinPc == -1) || (vPercentage < mSamples[i].mMinPc))
-				mSamples[i].mMinPc = vPercentage;
-			if ((mSamples[i].mMaxPc == -1) || (vPercentage > mSamples[i].mMaxPc))
-				mSamples[i].mMaxPc = vPercentage;
-
-			sprintf(vAvg, "%3.1f", mSamples[i].mAveragePc);
-			sprintf(vMin, "%3.1f", mSamples[i].mMinPc);
-			sprintf(vMax, "%3.1f", mSamples[i].mMaxPc);
-			sprintf(vTime,"%3.1f", vSampleTime);
-			sprintf(vNum, "%3d",   mSamples[i].mCallCount);
-			sprintf(vIndentedName, "%*.*s%s", mSamples[i].mParentCount, mSamples[i].mParentCount, " ", mSamples[i].mName.c_str());
-
-			sprintf(vNamebuf, "%5.5s : %5.5s : %5.5s : %5.5s : %5.5f : %s", vMin, vAvg, vMax, vNum, vSampleTime, vIndentedName);
-			cout << vNamebuf << endl;
-
-			//output these values
-/*			outputHandler->Sample(samples[i].minPc,
-					      samples[i].averagePc,
-					      samples[i].maxPc,
-					      sampleTime,
-					      samples[i].callCount,
-					      samples[i].name,
-					      samples[i].parentCount);*/
-
-			//reset the sample for next time
-			mSamples[i].mCallCount = 0;
-			mSamples[i].mTotalTime = 0;
-			mSamples[i].mChildTime = 0;
-		}
-	}
-
-	//outputHandler->EndOutput();
-}
-
-void VProfileSample::ResetSample(std::string pName)
-{
-	for (int i=0; i < MAX_PROFILER_SAMPLES; ++i)
-	{
-		if((mSamples[i].mIsValid) && (mSamples[i].mName == pName))
-		{
-			//found it
-			//reset avg/min/max ONLY
-			//because the sample may be running
-			mSamples[i].mMaxPc = mSamples[i].mMinPc = -1;
-			mSamples[i].mDataCount = 0;
-			return;
-		}
-	}
-}	
-
-void VProfileSample::ResetAll()
-{
-	for (int i=0; i < MAX_PROFILER_SAMPLES; ++i)
-	{
-		if(mSamples[i].mIsValid)
-		{
-			mSamples[i].mMaxPc = mSamples[i].mMinPc=-1;
-			mSamples[i].mDataCount=0;
-			if(!mSamples[i].mIsOpen)
-				mSamples[i].mIsValid=false;
-		}
-	}
-}
-
-double VProfileSample::GetTime()
-	{
-		struct timeval tv;
-		struct timezone tz;
-		double oldTime = 0.0f;
-		double newTime = 0.0f;
-		double timeDiff = 0.0f;
-		struct timespec req;
-		gettimeofday(&tv, &tz);
-		if (mTimeSet == false)
-		{
-			mTimeSet = true;
-			req.tv_sec = 0;
-			req.tv_nsec = 1;
-			//nanosleep(&req, NULL);
-			mStartTime.tv_sec = tv.tv_sec;
-			mStartTime.tv_usec = tv.tv_usec;
-			gettimeofday(&tv, &tz);
-		}
-
-		oldTime = (double)mStartTime.tv_sec + (double)mStartTime.tv_usec/(1000*1000);
-		newTime = (double)tv.tv_sec + (double)tv.tv_usec/(1000*1000);
-		//cout << "oldTime: " << oldTime << ", newTime: " << newTime << endl;
-		timeDiff = newTime - oldTime;
-
-		return timeDiff;
-	}
-#endif
+/*============================================================================*
+ *                                                                            *
+ * 	This file is part of the Viper3D Game Engine.							  *
+ *                                                                            *
+ *	Copyright (C) 2004 UDP Games   All Rights Reserved.						  *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------	------------- *
+ *	17-Oct-2026	Replaced VProfileSample with VProfiler			              *
+ *	17-Oct-2026	Added trace capture								              *
+ *                                                                            *
+ *============================================================================*/
+#include <viper3d/Profiler.h>
+
+#if !defined(PROFILER_DISABLE)
+
+/* System Headers */
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#if VIPER_PLATFORM == PLATFORM_WINDOWS
+#include <windows.h>
+#else
+#include <sched.h>
+#endif
+
+/* Local Headers */
+#include <viper3d/util/Clock.h>
+
+/* Macros */
+#if VIPER_PLATFORM == PLATFORM_WINDOWS
+#define VPROFILE_TRYLOCK( a )	(InterlockedExchange( &(a), 1 ) == 0)
+#define VPROFILE_UNLOCK( a )	InterlockedExchange( &(a), 0 )
+#define VPROFILE_YIELD( )		SwitchToThread( )
+#else
+#define VPROFILE_TRYLOCK( a )	(__sync_lock_test_and_set( &(a), 1 ) == 0)
+#define VPROFILE_UNLOCK( a )	__sync_lock_release( &(a) )
+#define VPROFILE_YIELD( )		sched_yield( )
+#endif
+
+#define VPROFILE_SAMPLES		1024	/* distinct sample names */
+#define VPROFILE_THREADS		64		/* threads that get their own tree */
+#define VPROFILE_CALIBRATE		10000000ull	/* ns to measure the tick rate over */
+
+#define CAPTURE_OFF				0
+#define CAPTURE_PENDING			1	/* starts at the next frame boundary */
+#define CAPTURE_ON				2
+
+namespace UDP
+{
+
+/*
+ * Registration state.  Only written under sLock; the hot path never
+ * touches any of it once its site and thread are set up.
+ */
+static volatile long	sLock = 0;
+static const char		*sNames[VPROFILE_SAMPLES] = { "<frame>" };
+static VUINT			sNumNames = 1;
+static VProfileThread	*sThreads[VPROFILE_THREADS];
+static volatile VUINT	sNumThreads = 0;
+
+/*
+ * Threads past VPROFILE_THREADS share this one.  It is left permanently
+ * full so that Record() drops their events without writing anything.
+ */
+static VProfileThread	*sOverflow = NULL;
+
+/* wall clock and tick counter at the first call, for GetTickRate() */
+static VUINT64			sCalNanos = 0;
+static VUINT64			sCalTicks = 0;
+static double			sTickRate = 0.0;
+
+/*
+ * Trace capture.  Only touched by the thread calling EndFrame(), so it
+ * needs no locking.
+ */
+static int				sCapture = CAPTURE_OFF;
+static VUINT			sCaptureLeft = 0;	/* frames still to capture, 0 for no limit */
+static VUINT			sCaptureDropped = 0;
+static std::vector<VUINT64>	sFrameMarks;	/* frame boundaries captured */
+
+VTHREAD_LOCAL VProfileThread *VProfiler::mThread = NULL;
+bool VProfiler::mEnabled = true;
+VUINT64 VProfiler::mFrameStart = 0;
+
+static void Lock()
+{
+	while (!VPROFILE_TRYLOCK(sLock))
+		VPROFILE_YIELD();
+}
+
+static void Unlock()
+{
+	VPROFILE_UNLOCK(sLock);
+}
+
+/*
+ * Writes one trace event.  Names are escaped as JSON strings; a
+ * negative fDur leaves it out.
+ */
+static void WriteEvent(std::ostream &out, bool &bFirst, const char *pName,
+						char cPhase, VUINT nTid, double fTs, double fDur = -1.0)
+{
+	char	vNum[64];
+
+	out << (bFirst ? "\n" : ",\n") << "{\"name\":\"";
+	for (const char *c = pName; *c != '\0'; c++)
+	{
+		if (*c == '"' || *c == '\\')
+			out << '\\' << *c;
+		else if ((unsigned char)*c < 0x20)
+		{
+			sprintf(vNum, "\\u%04x", (unsigned char)*c);
+			out << vNum;
+		}
+		else
+			out << *c;
+	}
+	sprintf(vNum, "%.3f", fTs);
+	out << "\",\"ph\":\"" << cPhase << "\",\"pid\":1,\"tid\":" << nTid
+		<< ",\"ts\":" << vNum;
+	if (fDur >= 0.0)
+	{
+		sprintf(vNum, "%.3f", fDur);
+		out << ",\"dur\":" << vNum;
+	}
+	out << "}";
+	bFirst = false;
+}
+
+/*
+ * Names a track in the trace viewer.
+ */
+static void WriteThreadName(std::ostream &out, bool &bFirst, VUINT nTid,
+						const char *pName)
+{
+	out << (bFirst ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\","
+		<< "\"pid\":1,\"tid\":" << nTid << ",\"args\":{\"name\":\"" << pName
+		<< "\"}}";
+	bFirst = false;
+}
+
+static void Calibrate()
+{
+	if (sCalNanos == 0)
+	{
+		sCalNanos = VClock::GetNanos();
+		sCalTicks = VProfiler::GetTicks();
+	}
+}
+
+static void ClearStats(VProfileNode &vNode)
+{
+	vNode.mMinPc = -1.0f;
+	vNode.mAvgPc = 0.0f;
+	vNode.mMaxPc = -1.0f;
+	vNode.mFrames = 0;
+}
+
+static VProfileNode NewNode(VUINT nId, int nParent, int nDepth)
+{
+	VProfileNode	vNode;
+
+	memset(&vNode, 0, sizeof(vNode));
+	vNode.mId = nId;
+	vNode.mParent = nParent;
+	vNode.mChild = -1;
+	vNode.mNext = -1;
+	vNode.mDepth = nDepth;
+	ClearStats(vNode);
+	return vNode;
+}
+
+/********************************************************************
+ *                        A T T R I B U T E S                       *
+ ********************************************************************/
+
+/*------------------------------------------------------------------*
+ *							GetTickRate()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Ticks per second returned by GetTicks().
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	Measured against the wall clock since the profiler was
+ *				first used, which is long enough to be accurate by the time
+ *				anything gets printed.  If it is asked for sooner than
+ *				that, it waits out the difference.
+ *
+ *	@returns	(double)
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+double VProfiler::GetTickRate()
+{
+#if defined(VPROFILE_RDTSC)
+	VUINT64	vNanos, vTicks;
+
+	if (sTickRate > 0.0)
+		return sTickRate;
+
+	Lock();
+	Calibrate();
+	Unlock();
+	do
+	{
+		vTicks = GetTicks();
+		vNanos = VClock::GetNanos();
+	} while (vNanos - sCalNanos < VPROFILE_CALIBRATE);
+
+	sTickRate = (double)(vTicks - sCalTicks) * 1e9 / (double)(vNanos - sCalNanos);
+	return sTickRate;
+#else
+	return 1e9;
+#endif
+}
+
+/*------------------------------------------------------------------*
+ *								GetName()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Name a sample id was registered under.
+ *	@date		17-Oct-2026
+ *
+ *	@param		nId		Id from Register(); 0 is the frame itself.
+ *
+ *	@returns	(const char*) Name, or NULL for an unknown id.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+const char* VProfiler::GetName(VUINT nId)
+{
+	if (nId >= sNumNames)
+		return NULL;
+	return sNames[nId];
+}
+
+/*------------------------------------------------------------------*
+ *							GetNumThreads()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Number of threads that have recorded a sample.
+ *	@date		17-Oct-2026
+ *
+ *	@returns	(VUINT)
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+VUINT VProfiler::GetNumThreads()
+{
+	return sNumThreads;
+}
+
+/*------------------------------------------------------------------*
+ *								GetTree()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Call tree of one thread, as of the last EndFrame().
+ *	@date		17-Oct-2026
+ *
+ *	@param		nThread	Index, in the order threads first recorded.
+ *
+ *	@returns	(const std::vector<VProfileNode>&) Node 0 is the frame.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+const std::vector<VProfileNode>& VProfiler::GetTree(VUINT nThread)
+{
+	return sThreads[nThread]->mNodes;
+}
+
+/*------------------------------------------------------------------*
+ *								GetDropped()						*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Events a thread lost because its buffer was full.
+ *	@date		17-Oct-2026
+ *
+ *	@param		nThread	Index, in the order threads first recorded.
+ *
+ *	@returns	(VUINT)
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+VUINT VProfiler::GetDropped(VUINT nThread)
+{
+	return sThreads[nThread]->mDropped;
+}
+
+/*------------------------------------------------------------------*
+ *								IsCapturing()						*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Whether a capture is running or about to start.
+ *	@date		17-Oct-2026
+ *
+ *	@returns	(bool)
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+bool VProfiler::IsCapturing()
+{
+	return sCapture != CAPTURE_OFF;
+}
+
+/********************************************************************
+ *                        O P E R A T I O N S                       *
+ ********************************************************************/
+
+/*------------------------------------------------------------------*
+ *								SetEnabled()						*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Turns recording on or off.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	Should only be changed between frames, or scopes that are
+ *				open at the time lose their other half.  Unmatched ends are
+ *				ignored; unmatched begins are closed by the frame boundary.
+ *
+ *	@param		bEnabled	Whether PROFILE() records anything.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VProfiler::SetEnabled(bool bEnabled)
+{
+	mEnabled = bEnabled;
+}
+
+/*------------------------------------------------------------------*
+ *								Register()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Interns a call site's name into a sample id.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	Sites with the same name share an id.  Safe to call from
+ *				any thread; two threads racing on one site get the same
+ *				answer.
+ *
+ *	@param		pSite	Site to register.
+ *
+ *	@returns	(VUINT) Sample id, never 0.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+VUINT VProfiler::Register(VProfileSite *pSite)
+{
+	VUINT	vId;
+
+	Lock();
+	if (pSite->mId == 0)
+	{
+		for (vId = 1; vId < sNumNames; vId++)
+		{
+			if (strcmp(sNames[vId], pSite->mName) == 0)
+				break;
+		}
+
+		if (vId == sNumNames)
+		{
+			/* out of names; the last one collects everything else */
+			if (sNumNames == VPROFILE_SAMPLES)
+				vId = VPROFILE_SAMPLES - 1;
+			else
+				sNames[sNumNames++] = pSite->mName;
+		}
+
+		VPROFILE_BARRIER();
+		pSite->mId = vId;
+	}
+	vId = pSite->mId;
+	Unlock();
+
+	return vId;
+}
+
+/*------------------------------------------------------------------*
+ *								EndFrame()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Closes the current frame.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	Must be called by one thread only, normally at the bottom
+ *				of the main loop.  The first call just starts the clock.
+ *
+ *	ALGORITHM:
+ *			For each thread, pull everything written since the last
+ *			frame into the call tree, then fold the frame's totals into
+ *			each node's statistics.  Scopes still open on another thread
+ *			carry over and count toward the frame they close in.
+ *			A pending capture starts once this frame has been drained.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *	17-Oct-2026	Added trace capture									*
+ *------------------------------------------------------------------*/
+void VProfiler::EndFrame()
+{
+	VUINT64	vNow = GetTicks();
+	VUINT64	vFrameTicks = mFrameStart == 0 ? 0 : vNow - mFrameStart;
+	VUINT	vNumThreads = sNumThreads;
+
+	VPROFILE_BARRIER();
+	mFrameStart = vNow;
+
+	for (VUINT i = 0; i < vNumThreads; i++)
+	{
+		Drain(sThreads[i]);
+		Accumulate(sThreads[i], vFrameTicks);
+	}
+
+	if (sCapture == CAPTURE_PENDING)
+	{
+		sFrameMarks.push_back(vNow);
+		sCapture = CAPTURE_ON;
+	}
+	else if (sCapture == CAPTURE_ON)
+	{
+		sFrameMarks.push_back(vNow);
+		if (sCaptureLeft > 0 && --sCaptureLeft == 0)
+			sCapture = CAPTURE_OFF;
+	}
+}
+
+/*------------------------------------------------------------------*
+ *								Output()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Prints every thread's call tree.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	Percentages are self time, children excluded, as a share of
+ *				the frame.  Calls and milliseconds are for the last frame.
+ *
+ *	@param		out		Stream to print to.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VProfiler::Output(std::ostream &out)
+{
+	char	vLine[256];
+	double	vMsPerTick = 1000.0 / GetTickRate();
+	VUINT	vNumThreads = sNumThreads;
+
+	for (VUINT i = 0; i < vNumThreads; i++)
+	{
+		const std::vector<VProfileNode> &vNodes = sThreads[i]->mNodes;
+
+		out << std::endl;
+		sprintf(vLine, "          Thread %u (%.3f ms, %u dropped)", i,
+				vNodes[0].mTicks * vMsPerTick, sThreads[i]->mDropped);
+		out << vLine << std::endl;
+		out << "  Min :   Avg :   Max :     # :      ms : Profile Name" << std::endl;
+		out << "--------------------------------------------------------" << std::endl;
+
+		/* depth first, without recursion: child, else sibling, else up */
+		int vNode = vNodes[0].mChild;
+		while (vNode > 0)
+		{
+			const VProfileNode &vCur = vNodes[vNode];
+
+			sprintf(vLine, "%5.1f : %5.1f : %5.1f : %5u : %7.3f : %*s%s",
+					vCur.mMinPc < 0.0f ? 0.0f : vCur.mMinPc, vCur.mAvgPc,
+					vCur.mMaxPc < 0.0f ? 0.0f : vCur.mMaxPc, vCur.mCalls,
+					vCur.mTicks * vMsPerTick, (vCur.mDepth - 1) * 2, "",
+					sNames[vCur.mId]);
+			out << vLine << std::endl;
+
+			if (vCur.mChild >= 0)
+				vNode = vCur.mChild;
+			else
+			{
+				while (vNode > 0 && vNodes[vNode].mNext < 0)
+					vNode = vNodes[vNode].mParent;
+				if (vNode > 0)
+					vNode = vNodes[vNode].mNext;
+			}
+		}
+	}
+}
+
+/*------------------------------------------------------------------*
+ *								ResetAll()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Clears the min/avg/max of every sample.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	The call trees are kept, since scopes may be open.  Call
+ *				from the thread that calls EndFrame().
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VProfiler::ResetAll()
+{
+	VUINT	vNumThreads = sNumThreads;
+
+	for (VUINT i = 0; i < vNumThreads; i++)
+	{
+		std::vector<VProfileNode> &vNodes = sThreads[i]->mNodes;
+		for (size_t n = 0; n < vNodes.size(); n++)
+			ClearStats(vNodes[n]);
+	}
+}
+
+/*------------------------------------------------------------------*
+ *							StartCapture()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Starts keeping events for WriteTrace().
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	Throws away any earlier capture.  Recording starts at the
+ *				next EndFrame(), so the capture always begins on a frame
+ *				boundary.  Each thread keeps at most VPROFILE_CAPTURE
+ *				events.  Call from the thread that calls EndFrame().
+ *
+ *	@param		nFrames	Frames to capture; 0 runs until StopCapture().
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VProfiler::StartCapture(VUINT nFrames)
+{
+	VUINT	vNumThreads = sNumThreads;
+
+	for (VUINT i = 0; i < vNumThreads; i++)
+		sThreads[i]->mCapture.clear();
+	sFrameMarks.clear();
+	sCaptureDropped = 0;
+	sCaptureLeft = nFrames;
+	sCapture = CAPTURE_PENDING;
+}
+
+/*------------------------------------------------------------------*
+ *							StopCapture()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Ends a capture early, keeping what it has so far.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	Events still sitting in the threads' buffers belong to an
+ *				unfinished frame and are not captured.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VProfiler::StopCapture()
+{
+	sCapture = CAPTURE_OFF;
+}
+
+/*------------------------------------------------------------------*
+ *								WriteTrace()						*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Saves the captured frames as a Chrome trace.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	JSON trace event format, which both chrome://tracing and
+ *				ui.perfetto.dev open.  Track 0 shows the frames, and each
+ *				profiled thread gets its own track below it.  Times are
+ *				microseconds from the start of the capture.
+ *
+ *	ALGORITHM:
+ *			Scopes are replayed with the same matching rules as Drain(),
+ *			so the timeline agrees with Output().  Ends for scopes that
+ *			opened before the capture are dropped; scopes still open when
+ *			it stopped are closed at the last frame boundary.
+ *
+ *	@param		out		Stream to write to.
+ *
+ *	@returns	(bool) False if nothing was captured or the write failed.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+bool VProfiler::WriteTrace(std::ostream &out)
+{
+	std::vector<VUINT>	vOpen;
+	VUINT				vNumThreads = sNumThreads;
+	VUINT64				vBase;
+	double				vUsPerTick, vLast;
+	bool				vFirst = true;
+	char				vName[64];
+
+	if (sFrameMarks.size() < 2)
+		return false;
+
+	/* anything drained in the first frame may predate its start */
+	vBase = sFrameMarks[0];
+	for (VUINT i = 0; i < vNumThreads; i++)
+	{
+		if (!sThreads[i]->mCapture.empty() && sThreads[i]->mCapture[0].mTicks < vBase)
+			vBase = sThreads[i]->mCapture[0].mTicks;
+	}
+	vUsPerTick = 1000000.0 / GetTickRate();
+	vLast = (sFrameMarks.back() - vBase) * vUsPerTick;
+
+	out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	WriteThreadName(out, vFirst, 0, "Frames");
+	for (size_t f = 1; f < sFrameMarks.size(); f++)
+	{
+		sprintf(vName, "Frame %u", (VUINT)f);
+		WriteEvent(out, vFirst, vName, 'X', 0,
+				(sFrameMarks[f - 1] - vBase) * vUsPerTick,
+				(sFrameMarks[f] - sFrameMarks[f - 1]) * vUsPerTick);
+	}
+
+	for (VUINT i = 0; i < vNumThreads; i++)
+	{
+		const std::vector<VProfileEvent> &vEvents = sThreads[i]->mCapture;
+
+		sprintf(vName, "Thread %u", i);
+		WriteThreadName(out, vFirst, i + 1, vName);
+
+		vOpen.clear();
+		for (size_t e = 0; e < vEvents.size(); e++)
+		{
+			double	vTs = (vEvents[e].mTicks - vBase) * vUsPerTick;
+			VUINT	vId = vEvents[e].mId & ~VPROFILE_END;
+			int		d;
+
+			if ((vEvents[e].mId & VPROFILE_END) == 0)
+			{
+				vOpen.push_back(vId);
+				WriteEvent(out, vFirst, sNames[vId], 'B', i + 1, vTs);
+				continue;
+			}
+
+			for (d = (int)vOpen.size() - 1; d >= 0; d--)
+			{
+				if (vOpen[d] == vId)
+					break;
+			}
+			while (d >= 0 && (int)vOpen.size() > d)
+			{
+				WriteEvent(out, vFirst, sNames[vOpen.back()], 'E', i + 1, vTs);
+				vOpen.pop_back();
+			}
+		}
+		while (!vOpen.empty())
+		{
+			WriteEvent(out, vFirst, sNames[vOpen.back()], 'E', i + 1, vLast);
+			vOpen.pop_back();
+		}
+	}
+	out << "\n],\"otherData\":{\"dropped\":" << sCaptureDropped << "}}\n";
+
+	return out.good();
+}
+
+/*------------------------------------------------------------------*
+ *								WriteTrace()						*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Saves the captured frames as a Chrome trace file.
+ *	@date		17-Oct-2026
+ *
+ *	@param		pFile	Path to write, conventionally ending in .json.
+ *
+ *	@returns	(bool) False if nothing was captured or the file could
+ *				not be written.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+bool VProfiler::WriteTrace(const char *pFile)
+{
+	std::ofstream	vOut(pFile);
+
+	if (!vOut.is_open())
+		return false;
+	return WriteTrace(vOut);
+}
+
+/********************************************************************
+ *                         I N T E R N A L S                        *
+ ********************************************************************/
+
+/*------------------------------------------------------------------*
+ *								AddThread()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Gives the calling thread its event buffer.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	Called the first time a thread records anything.  Buffers
+ *				are kept for the life of the program so their trees can
+ *				still be printed after the thread exits.
+ *
+ *	@returns	(VProfileThread*) The calling thread's buffer.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+VProfileThread* VProfiler::AddThread()
+{
+	VProfileThread	*vThread;
+
+	Lock();
+	Calibrate();
+	if (sNumThreads < VPROFILE_THREADS)
+	{
+		vThread = new VProfileThread;
+		vThread->mHead = 0;
+		vThread->mTail = 0;
+		vThread->mDropped = 0;
+		vThread->mIndex = sNumThreads;
+		vThread->mDepth = 0;
+		vThread->mNodes.push_back(NewNode(0, -1, 0));
+
+		sThreads[sNumThreads] = vThread;
+		VPROFILE_BARRIER();
+		sNumThreads = sNumThreads + 1;
+	}
+	else
+	{
+		if (sOverflow == NULL)
+		{
+			sOverflow = new VProfileThread;
+			sOverflow->mHead = VPROFILE_EVENTS;
+			sOverflow->mTail = 0;
+			sOverflow->mDropped = 0;
+			sOverflow->mIndex = VPROFILE_THREADS;
+			sOverflow->mDepth = 0;
+		}
+		vThread = sOverflow;
+	}
+	Unlock();
+
+	mThread = vThread;
+	return vThread;
+}
+
+/*------------------------------------------------------------------*
+ *								Drain()								*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Moves a thread's buffered events into its call tree.
+ *	@date		17-Oct-2026
+ *
+ *	ALGORITHM:
+ *			A begin opens the matching child of whatever node is open.
+ *			An end closes the innermost open node with its id, along
+ *			with anything opened inside it that never ended, and charges
+ *			the elapsed ticks to that node and to its parent's children.
+ *			Ends with nothing to match are dropped.  While capturing,
+ *			every event is also copied, as is, for WriteTrace().
+ *
+ *	@param		pThread	Thread to drain.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *	17-Oct-2026	Added trace capture									*
+ *------------------------------------------------------------------*/
+void VProfiler::Drain(VProfileThread *pThread)
+{
+	VUINT	vHead = pThread->mHead;
+	VUINT	vTail = pThread->mTail;
+	VUINT	vId;
+	int		vParent, vNode, d;
+
+	VPROFILE_BARRIER();
+	for (; vTail != vHead; vTail++)
+	{
+		const VProfileEvent &vEvent = pThread->mEvents[vTail & (VPROFILE_EVENTS - 1)];
+
+		if (sCapture == CAPTURE_ON)
+		{
+			if (pThread->mCapture.size() < VPROFILE_CAPTURE)
+				pThread->mCapture.push_back(vEvent);
+			else
+				sCaptureDropped++;
+		}
+
+		if ((vEvent.mId & VPROFILE_END) == 0)
+		{
+			if (pThread->mDepth == VPROFILE_DEPTH)
+				continue;
+			vParent = pThread->mDepth == 0 ? 0 : pThread->mStack[pThread->mDepth - 1];
+			vNode = FindChild(pThread, vParent, vEvent.mId);
+			pThread->mStack[pThread->mDepth] = vNode;
+			pThread->mStart[pThread->mDepth] = vEvent.mTicks;
+			pThread->mDepth++;
+		}
+		else
+		{
+			vId = vEvent.mId & ~VPROFILE_END;
+			for (d = pThread->mDepth - 1; d >= 0; d--)
+			{
+				if (pThread->mNodes[pThread->mStack[d]].mId == vId)
+					break;
+			}
+			if (d < 0)
+				continue;
+
+			VUINT64 vTicks = vEvent.mTicks - pThread->mStart[d];
+			VProfileNode &vCur = pThread->mNodes[pThread->mStack[d]];
+			vCur.mFrameCalls++;
+			vCur.mFrameTicks += vTicks;
+			pThread->mNodes[vCur.mParent].mFrameChildTicks += vTicks;
+			pThread->mDepth = d;
+		}
+	}
+	VPROFILE_BARRIER();
+	pThread->mTail = vHead;
+}
+
+/*------------------------------------------------------------------*
+ *								FindChild()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Finds, or adds, the child of a node for a sample.
+ *	@date		17-Oct-2026
+ *
+ *	@param		pThread	Thread whose tree to search.
+ *	@param		nParent	Node to look under.
+ *	@param		nId		Sample id.
+ *
+ *	@returns	(int) Index of the child node.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+int VProfiler::FindChild(VProfileThread *pThread, int nParent, VUINT nId)
+{
+	std::vector<VProfileNode>	&vNodes = pThread->mNodes;
+	int							vLast = -1;
+
+	for (int n = vNodes[nParent].mChild; n >= 0; n = vNodes[n].mNext)
+	{
+		if (vNodes[n].mId == nId)
+			return n;
+		vLast = n;
+	}
+
+	/* appended last, so siblings print in the order first seen */
+	int vNew = (int)vNodes.size();
+	vNodes.push_back(NewNode(nId, nParent, vNodes[nParent].mDepth + 1));
+	if (vLast < 0)
+		vNodes[nParent].mChild = vNew;
+	else
+		vNodes[vLast].mNext = vNew;
+	return vNew;
+}
+
+/*------------------------------------------------------------------*
+ *								Accumulate()						*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Folds one frame's totals into a thread's statistics.
+ *	@date		17-Oct-2026
+ *
+ *	@param		pThread		Thread to update.
+ *	@param		nFrameTicks	Length of the frame; 0 for the first one,
+ *							which only has its totals kept.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VProfiler::Accumulate(VProfileThread *pThread, VUINT64 nFrameTicks)
+{
+	std::vector<VProfileNode>	&vNodes = pThread->mNodes;
+	VUINT64						vSelf;
+	float						vPc;
+
+	vNodes[0].mFrameTicks = nFrameTicks;
+	vNodes[0].mFrameCalls = nFrameTicks > 0 ? 1 : 0;
+
+	for (size_t n = 0; n < vNodes.size(); n++)
+	{
+		VProfileNode &vCur = vNodes[n];
+
+		if (nFrameTicks > 0)
+		{
+			/* a child carried over from the last frame can outlast its parent */
+			vSelf = vCur.mFrameTicks > vCur.mFrameChildTicks ?
+						vCur.mFrameTicks - vCur.mFrameChildTicks : 0;
+			vPc = (float)((double)vSelf * 100.0 / (double)nFrameTicks);
+			vCur.mAvgPc = (vCur.mAvgPc * vCur.mFrames + vPc) / (vCur.mFrames + 1);
+			vCur.mFrames++;
+			if (vCur.mMinPc < 0.0f || vPc < vCur.mMinPc)
+				vCur.mMinPc = vPc;
+			if (vCur.mMaxPc < 0.0f || vPc > vCur.mMaxPc)
+				vCur.mMaxPc = vPc;
+		}
+
+		vCur.mCalls = vCur.mFrameCalls;
+		vCur.mTicks = vCur.mFrameTicks;
+		vCur.mChildTicks = vCur.mFrameChildTicks;
+		vCur.mFrameCalls = 0;
+		vCur.mFrameTicks = 0;
+		vCur.mFrameChildTicks = 0;
+	}
+}
+
+} // End Namespace
+
+#endif // PROFILER_DISABLE
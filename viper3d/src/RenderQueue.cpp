@@ -0,0 +1,290 @@
+/*============================================================================*
+ *                                                                            *
+ *  This file is part of the Viper3D Game Engine.                             *
+ *                                                                            *
+ *  Copyright (C) 2004 UDP Games   All Rights Reserved.                       *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------  ------------- *
+ *                                                                            *
+ *============================================================================*/
+#include <viper3d/RenderQueue.h>
+
+/* System Headers */
+#include <math.h>
+#include <string.h>
+
+/* Local Headers */
+
+namespace UDP
+{
+
+/* where each field of a key starts, for the two layouts */
+static const int	LAYER_SHIFT = 64 - VQUEUE_LAYER_BITS;
+static const int	MATERIAL_SHIFT = LAYER_SHIFT - VQUEUE_MATERIAL_BITS;
+static const int	TEXTURE_SHIFT = MATERIAL_SHIFT - VQUEUE_TEXTURE_BITS;
+static const int	MESH_SHIFT = TEXTURE_SHIFT - VQUEUE_MESH_BITS;
+static const int	BTF_DEPTH_SHIFT = LAYER_SHIFT - VQUEUE_DEPTH_BITS;
+static const int	BTF_MATERIAL_SHIFT = BTF_DEPTH_SHIFT - VQUEUE_MATERIAL_BITS;
+static const int	BTF_TEXTURE_SHIFT = BTF_MATERIAL_SHIFT - VQUEUE_TEXTURE_BITS;
+static const VUINT	DEPTH_MAX = (1 << VQUEUE_DEPTH_BITS) - 1;
+
+/********************************************************************
+ *          C O N S T R U C T I O N / D E S T R U C T I O N         *
+ ********************************************************************/
+VRenderQueue::VRenderQueue()
+: mSorted(false), mBackToFront(0), mEye(0.0f, 0.0f, 0.0f), mInvFar(0.0f)
+{
+	Clear();
+}
+
+VRenderQueue::~VRenderQueue()
+{
+
+}
+
+/********************************************************************
+ *                        A T T R I B U T E S                       *
+ ********************************************************************/
+void VRenderQueue::SetBackToFront(VUINT nLayer, bool bBackToFront)
+{
+	nLayer &= VQUEUE_LAYERS - 1;
+	if (bBackToFront)
+		mBackToFront |= 1 << nLayer;
+	else
+		mBackToFront &= ~(1 << nLayer);
+}
+
+/*------------------------------------------------------------------*
+ *								SetEye()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Sets what GetDepth() measures from.
+ *	@date		17-Oct-2026
+ *
+ *	@param		vEye	Camera position
+ *	@param		fFar	Distance that maps to a depth of 1
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VRenderQueue::SetEye(const VVector& vEye, float fFar)
+{
+	mEye = vEye;
+	mInvFar = fFar > 0.0f ? 1.0f / fFar : 0.0f;
+}
+
+/**
+ *	Distance from the eye as a fraction of the far distance, for
+ *	MakeKey().
+ */
+float VRenderQueue::GetDepth(const VVector& vPos) const
+{
+	VVector vD = vPos - mEye;
+
+	return sqrtf(vD.SquaredLength()) * mInvFar;
+}
+
+/*------------------------------------------------------------------*
+ *								MakeKey()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Packs the state and depth of a draw into a sort key.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	Ids are cut to the width of their field, so only their
+ *				low bits decide the order.  Push() is given the full
+ *				ids as well.  Depth is clamped to [0, 1].
+ *
+ *	@param		nLayer		Layer, drawn in increasing order
+ *	@param		nMaterial	Material id
+ *	@param		nTexture	Texture id, 0 for none
+ *	@param		hMesh		Mesh drawn, keeping its draws together
+ *	@param		fDepth		From GetDepth(), or 0
+ *
+ *	@returns	(VUINT64) Key for Push()
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+VUINT64 VRenderQueue::MakeKey(VUINT nLayer, VUINT nMaterial, VUINT nTexture,
+								VMeshHandle hMesh, float fDepth) const
+{
+	VUINT64	vLayer = nLayer & ((1 << VQUEUE_LAYER_BITS) - 1);
+	VUINT64	vMaterial = nMaterial & ((1 << VQUEUE_MATERIAL_BITS) - 1);
+	VUINT64	vTexture = nTexture & ((1 << VQUEUE_TEXTURE_BITS) - 1);
+	VUINT64	vMesh = hMesh & ((1 << VQUEUE_MESH_BITS) - 1);
+	VUINT64	vDepth;
+
+	if (!(fDepth > 0.0f))
+		fDepth = 0.0f;
+	else if (fDepth > 1.0f)
+		fDepth = 1.0f;
+	vDepth = (VUINT64)(fDepth * DEPTH_MAX);
+
+	if (IsBackToFront((VUINT)vLayer))
+		return (vLayer << LAYER_SHIFT) | ((DEPTH_MAX - vDepth) << BTF_DEPTH_SHIFT) |
+			(vMaterial << BTF_MATERIAL_SHIFT) | (vTexture << BTF_TEXTURE_SHIFT) | vMesh;
+	return (vLayer << LAYER_SHIFT) | (vMaterial << MATERIAL_SHIFT) |
+		(vTexture << TEXTURE_SHIFT) | (vMesh << MESH_SHIFT) | vDepth;
+}
+
+VUINT VRenderQueue::GetMaterial(VUINT64 nKey) const
+{
+	int vShift = IsBackToFront(GetLayer(nKey)) ? BTF_MATERIAL_SHIFT : MATERIAL_SHIFT;
+
+	return (VUINT)(nKey >> vShift) & ((1 << VQUEUE_MATERIAL_BITS) - 1);
+}
+
+VUINT VRenderQueue::GetTexture(VUINT64 nKey) const
+{
+	int vShift = IsBackToFront(GetLayer(nKey)) ? BTF_TEXTURE_SHIFT : TEXTURE_SHIFT;
+
+	return (VUINT)(nKey >> vShift) & ((1 << VQUEUE_TEXTURE_BITS) - 1);
+}
+
+/********************************************************************
+ *                        O P E R A T I O N S                       *
+ ********************************************************************/
+
+/*------------------------------------------------------------------*
+ *								Push()								*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Adds a draw to the queue.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	The transform is copied.  One equal to the last one
+ *				pushed is shared with it, so only items pushed one after
+ *				another with the same transform can be merged.
+ *
+ *	@param		nKey	From MakeKey()
+ *	@param		nMaterial	Material id handed to SetState()
+ *	@param		nTexture	Texture id handed to SetState()
+ *	@param		hMesh	Mesh to draw
+ *	@param		pWorld	Object to world transform, NULL for identity
+ *	@param		nFirst	First index (or vertex, if the mesh has no
+ *						indices) to draw
+ *	@param		nCount	How many, 0 for the whole mesh
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VRenderQueue::Push(VUINT64 nKey, VUINT nMaterial, VUINT nTexture, VMeshHandle hMesh,
+						const VMatrix *pWorld /*=NULL*/, VUINT nFirst /*=0*/,
+						VUINT nCount /*=0*/)
+{
+	VRenderItem vItem;
+
+	vItem.mKey = nKey;
+	vItem.mMaterial = nMaterial;
+	vItem.mTexture = nTexture;
+	vItem.mMesh = hMesh;
+	vItem.mFirst = nFirst;
+	vItem.mCount = nCount;
+	vItem.mWorld = 0;
+	if (pWorld != NULL)
+	{
+		if (memcmp(&mWorlds.back(), pWorld, sizeof(VMatrix)) != 0)
+			mWorlds.push_back(*pWorld);
+		vItem.mWorld = (VUINT)mWorlds.size() - 1;
+	}
+	mItems.push_back(vItem);
+	mSorted = false;
+}
+
+/*------------------------------------------------------------------*
+ *								Sort()								*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		One pass over the keys counts all eight bytes				*
+ *		For each byte, least significant first:						*
+ *			skip it if every key has the same value there			*
+ *			otherwise scatter the entries by it, stably, into the	*
+ *				other buffer and swap								*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VRenderQueue::Sort()
+{
+	VUINT	vCounts[8][256];
+	VUINT	vCount = (VUINT)mItems.size();
+	VUINT	vSum, vTmp;
+
+	if (mSorted)
+		return;
+
+	mOrder.resize(vCount);
+	mScratch.resize(vCount);
+	memset(vCounts, 0, sizeof(vCounts));
+	for (VUINT i = 0; i < vCount; i++)
+	{
+		VUINT64 vKey = mItems[i].mKey;
+
+		mOrder[i].mKey = vKey;
+		mOrder[i].mItem = i;
+		for (int b = 0; b < 8; b++)
+			vCounts[b][(vKey >> (b * 8)) & 0xFF]++;
+	}
+
+	for (int b = 0; b < 8 && vCount > 1; b++)
+	{
+		int vShift = b * 8;
+
+		if (vCounts[b][(mOrder[0].mKey >> vShift) & 0xFF] == vCount)
+			continue;
+
+		vSum = 0;
+		for (int d = 0; d < 256; d++)
+		{
+			vTmp = vCounts[b][d];
+			vCounts[b][d] = vSum;
+			vSum += vTmp;
+		}
+		for (VUINT i = 0; i < vCount; i++)
+			mScratch[vCounts[b][(mOrder[i].mKey >> vShift) & 0xFF]++] = mOrder[i];
+		mOrder.swap(mScratch);
+	}
+
+	mStats.mItems = vCount;
+	mSorted = true;
+}
+
+/*------------------------------------------------------------------*
+ *								Clear()								*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Empties the queue and its stats for the next frame.
+ *	@date		17-Oct-2026
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VRenderQueue::Clear()
+{
+	mItems.clear();
+	mOrder.clear();
+	mWorlds.resize(1);
+	mWorlds[0] = VMatrix::MATRIX_IDENTITY;
+	mSorted = false;
+	memset(&mStats, 0, sizeof(mStats));
+}
+
+} // End Namespace
@@ -16,6 +16,7 @@
 #include <viper3d/util/Log.h>
 
 /* Local Headers */
+#include <viper3d/RenderQueue.h>
 
 namespace UDP
 {
@@ -46,12 +47,106 @@ VRenderSystem::~VRenderSystem()
  *																	*
  ********************************************************************/
 
+/*------------------------------------------------------------------*
+ *							GetVertexSize()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Size of one vertex of a format.
+ *	@date		17-Oct-2026
+ *
+ *	@param		nFormat	VVertexFormat flags
+ *
+ *	@returns	(VUINT) Bytes per vertex
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+VUINT VRenderSystem::GetVertexSize(VUINT nFormat)
+{
+	VUINT vSize = 3 * sizeof(float);
+
+	if (nFormat & VERTEX_NORMAL)
+		vSize += 3 * sizeof(float);
+	if (nFormat & VERTEX_COLOR)
+		vSize += 4;
+	if (nFormat & VERTEX_TEXCOORD)
+		vSize += 2 * sizeof(float);
+	return vSize;
+}
+
 /********************************************************************
  *																	*
  *                        O P E R A T I O N S                       *
  *																	*
  ********************************************************************/
 
+/*------------------------------------------------------------------*
+ *							  DrawQueue()							*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Sort the queue												*
+ *		Walk it in order:											*
+ *			SetState() when material or texture differ from the		*
+ *				last item											*
+ *			SetWorldMatrix() when the transform differs				*
+ *			Collect the ranges of the following items with the		*
+ *				same state, mesh and transform, and draw them all	*
+ *				with one DrawMeshRanges()							*
+ *		Count sorted items, draws, state changes and merges			*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VRenderSystem::DrawQueue(VRenderQueue *pQueue)
+{
+	VRenderStats	&vStats = pQueue->mStats;
+	VUINT			vCount = pQueue->GetCount();
+	VUINT			vMaterial = 0, vTexture = 0, vWorld = 0;
+	VUINT			i = 0, j;
+
+	pQueue->Sort();
+	while (i < vCount)
+	{
+		const VRenderItem &vItem = pQueue->GetItem(i);
+
+		if (i == 0 || vItem.mMaterial != vMaterial || vItem.mTexture != vTexture)
+		{
+			vMaterial = vItem.mMaterial;
+			vTexture = vItem.mTexture;
+			SetState(vMaterial, vTexture);
+			vStats.mStateChanges++;
+		}
+		if (i == 0 || vItem.mWorld != vWorld)
+		{
+			vWorld = vItem.mWorld;
+			SetWorldMatrix(pQueue->GetWorld(vWorld));
+		}
+
+		pQueue->mFirsts.clear();
+		pQueue->mCounts.clear();
+		for (j = i; j < vCount; j++)
+		{
+			const VRenderItem &vNext = pQueue->GetItem(j);
+
+			if (vNext.mMesh != vItem.mMesh || vNext.mWorld != vWorld ||
+				vNext.mMaterial != vMaterial || vNext.mTexture != vTexture)
+				break;
+			pQueue->mFirsts.push_back(vNext.mFirst);
+			pQueue->mCounts.push_back(vNext.mCount);
+		}
+
+		DrawMeshRanges(vItem.mMesh, &pQueue->mFirsts[0], &pQueue->mCounts[0], j - i);
+		vStats.mDraws++;
+		vStats.mMerged += j - i - 1;
+		i = j;
+	}
+}
+
 /********************************************************************
  *																	*
  *                          O P E R A T O R S                       *
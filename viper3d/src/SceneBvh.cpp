@@ -0,0 +1,314 @@
+/*============================================================================*
+ *                                                                            *
+ *  This file is part of the Viper3D Game Engine.                             *
+ *                                                                            *
+ *  Copyright (C) 2004 UDP Games   All Rights Reserved.                       *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------  ------------- *
+ *                                                                            *
+ *============================================================================*/
+#include <viper3d/SceneBvh.h>
+
+/* System Headers */
+
+/* Local Headers */
+
+namespace UDP
+{
+
+/********************************************************************
+ *          C O N S T R U C T I O N / D E S T R U C T I O N         *
+ ********************************************************************/
+VSceneBvh::VSceneBvh()
+{
+	mRoot = NULL;
+}
+
+VSceneBvh::~VSceneBvh()
+{
+	Clear();
+}
+
+/********************************************************************
+ *                        A T T R I B U T E S                       *
+ ********************************************************************/
+
+/********************************************************************
+ *                        O P E R A T I O N S                       *
+ ********************************************************************/
+
+/*------------------------------------------------------------------*
+ *								Build()								*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Walk the tree depth first, children before siblings			*
+ *		Give each node with bounds the next item number				*
+ *		Build the box hierarchy over their bounds					*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VSceneBvh::Build(VNode *pRoot)
+{
+	std::vector<VNode*>	vStack;
+	std::vector<VAabb>	vBoxes;
+	VNode				*vNode, *vChild;
+	VAabb				vBox;
+
+	Clear();
+	mRoot = pRoot;
+	if (pRoot == NULL)
+		return;
+
+	vStack.push_back(pRoot);
+	while (!vStack.empty())
+	{
+		vNode = vStack.back();
+		vStack.pop_back();
+
+		if (vNode->GetBounds(vBox))
+		{
+			vNode->mSceneBvh = this;
+			vNode->mSceneItem = (VUINT)mNodes.size();
+			mNodes.push_back(vNode);
+			vBoxes.push_back(vBox);
+		}
+
+		vChild = vNode->GetChild();
+		if (vChild)
+		{
+			do
+			{
+				vStack.push_back(vChild);
+				vChild = vChild->GetNext();
+			} while (vChild != vNode->GetChild());
+		}
+	}
+
+	mDirty.assign(mNodes.size(), 0);
+	mBvh.Build(vBoxes.empty() ? NULL : &vBoxes[0], (VUINT)vBoxes.size());
+}
+
+/*------------------------------------------------------------------*
+ *								Clear()								*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Detach every node still indexed from this hierarchy			*
+ *		Empty the item tables and the box hierarchy					*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VSceneBvh::Clear()
+{
+	for (VUINT i = 0; i < mNodes.size(); i++)
+		if (mNodes[i])
+			mNodes[i]->mSceneBvh = NULL;
+
+	mNodes.clear();
+	mDirty.clear();
+	mMoved.clear();
+	mBvh.Build(NULL, 0);
+	mRoot = NULL;
+}
+
+/*------------------------------------------------------------------*
+ *								Update()							*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Refit the paths of the nodes moved since the last call		*
+ *		Rebuild if the refitted cost has grown past fRatio			*
+ *			times the cost right after the last build				*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+bool VSceneBvh::Update(float fRatio /*=1.5f*/)
+{
+	Refit();
+
+	if (!mBvh.IsDegraded(fRatio))
+		return false;
+
+	mBvh.Rebuild();
+	return true;
+}
+
+/*------------------------------------------------------------------*
+ *								Cull()								*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Refit moved nodes, cull the box hierarchy and keep the		*
+ *			items whose nodes still exist							*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VSceneBvh::Cull(const VPlane *pPlanes, int nNumPlanes,
+						std::vector<VNode*> &vNodes)
+{
+	Refit();
+	mItems.clear();
+	mBvh.Cull(pPlanes, nNumPlanes, mItems);
+	Gather(vNodes);
+}
+
+/*------------------------------------------------------------------*
+ *								Pick()								*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Refit moved nodes and pick the nearest box on the ray		*
+ *		If it belongs to a deleted node, test every box the ray		*
+ *			hits and keep the nearest one with a live node			*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+VNode* VSceneBvh::Pick(const VRay &ray, float *t /*=NULL*/)
+{
+	VRay	vRay(ray);
+	VUINT	vItem;
+	VNode	*vBest = NULL;
+	float	fHit, fBest = 0.0f;
+
+	Refit();
+	if (!mBvh.Pick(ray, &vItem, &fBest))
+		return NULL;
+	vBest = mNodes[vItem];
+
+	/*
+	 * The nearest box belongs to a deleted node; fall back to checking
+	 * everything along the ray.
+	 */
+	if (vBest == NULL)
+	{
+		mItems.clear();
+		mBvh.Intersects(ray, mItems);
+		for (VUINT i = 0; i < mItems.size(); i++)
+		{
+			if (mNodes[mItems[i]] == NULL ||
+				!vRay.Intersects(mBvh.GetBox(mItems[i]), &fHit))
+				continue;
+			if (vBest == NULL || fHit < fBest)
+			{
+				vBest = mNodes[mItems[i]];
+				fBest = fHit;
+			}
+		}
+	}
+
+	if (vBest && t)
+		*t = fBest;
+	return vBest;
+}
+
+/*------------------------------------------------------------------*
+ *								Overlap()							*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Refit moved nodes, collect the overlapping items and keep	*
+ *			those whose nodes still exist							*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VSceneBvh::Overlap(const VAabb &box, std::vector<VNode*> &vNodes)
+{
+	Refit();
+	mItems.clear();
+	mBvh.Overlap(box, mItems);
+	Gather(vNodes);
+}
+
+/********************************************************************
+ *                         I N T E R N A L S                        *
+ ********************************************************************/
+
+/*------------------------------------------------------------------*
+ *							 Invalidate()							*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Queue the node once; its path is refitted lazily, so a		*
+ *		node moved several times in a frame only costs one walk		*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VSceneBvh::Invalidate(VNode *pNode)
+{
+	VUINT vItem = pNode->mSceneItem;
+
+	if (!mDirty[vItem])
+	{
+		mDirty[vItem] = 1;
+		mMoved.push_back(vItem);
+	}
+}
+
+/*------------------------------------------------------------------*
+ *								Remove()							*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		The item keeps its slot (and last box) until the next		*
+ *		Build(), but is never reported by a query					*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VSceneBvh::Remove(VNode *pNode)
+{
+	mNodes[pNode->mSceneItem] = NULL;
+	pNode->mSceneBvh = NULL;
+	if (pNode == mRoot)
+		mRoot = NULL;
+}
+
+void VSceneBvh::Refit()
+{
+	VAabb vBox;
+	VUINT vItem;
+
+	/*
+	 * Moving a node only flags its transform; updating the transforms
+	 * is what queues the moved nodes and their children here.
+	 */
+	if (mRoot)
+		mRoot->UpdateTransforms();
+
+	for (VUINT i = 0; i < mMoved.size(); i++)
+	{
+		vItem = mMoved[i];
+		mDirty[vItem] = 0;
+		if (mNodes[vItem] && mNodes[vItem]->GetBounds(vBox))
+			mBvh.Update(vItem, vBox);
+	}
+	mMoved.clear();
+}
+
+void VSceneBvh::Gather(std::vector<VNode*> &vNodes)
+{
+	for (VUINT i = 0; i < mItems.size(); i++)
+		if (mNodes[mItems[i]])
+			vNodes.push_back(mNodes[mItems[i]]);
+}
+
+} // End Namespace
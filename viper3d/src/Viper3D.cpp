@@ -13,6 +13,8 @@
 #include <viper3d/Viper3D.h>
 
 /* System Headers */
+#include <cstdlib>
+#include <cstring>
 
 /* Local Headers */
 #include <viper3d/util/Log.h>
@@ -27,6 +29,18 @@ namespace UDP
 /* Static Variables */
 static char __CLASS__[] = "[   Viper3D    ]";
 
+/* render system plugins, and where the build puts them */
+static const struct
+{
+	const char	*mAPI;
+	const char	*mPath;
+	const char	*mLib;
+} sPlugins[] = {
+	{ "GL",		"./viper3d/render/opengl/.libs",	"viper3dogl" },
+	{ "NULL",	"./viper3d/render/null/.libs",		"viper3dnull" },
+	{ NULL,		NULL,								NULL }
+};
+
 /********************************************************************
  *																	*
  *          C O N S T R U C T I O N / D E S T R U C T I O N         *
@@ -68,39 +82,75 @@ Viper3D::~Viper3D()
  *                        O P E R A T I O N S                       *
  *																	*
  ********************************************************************/
-VRenderSystem* Viper3D::CreateRenderer(char *pAPI)
+/*------------------------------------------------------------------*
+ *							CreateRenderer()						*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Loads a render system plugin and creates the renderer.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	Plugins are looked for under ./viper3d/render, where the
+ *				build leaves them, unless VIPER_RENDER_PATH names the
+ *				directory holding them.
+ *
+ *	@param		pAPI	"GL", or "NULL" for the recording renderer that
+ *						needs no display
+ *
+ *	@returns	(VRenderSystem*) The renderer, or NULL
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+VRenderSystem* Viper3D::CreateRenderer(const char *pAPI)
 {
-	DLL_RENDERCREATE *vCreate;
-	if (strcmp(pAPI, "GL") == 0)
+	DLL_RENDERCREATE	*vCreate;
+	const char			*vOverride = getenv("VIPER_RENDER_PATH");
+	int					vPlugin;
+	VString				vPath;
+
+	for (vPlugin = 0; sPlugins[vPlugin].mAPI != NULL; vPlugin++)
 	{
-		VTRACE(_CL("Loading GL renderer"));
-		if (!mRenderLib.Load("./viper3d/render/opengl/.libs", "viper3dogl"))
-		{
-			VTRACE(_CL("Unable to load window library\n"));
-			return NULL;
-		}
-		VTRACE(_CL("Library loaded successfully\n"));
+		if (strcmp(pAPI, sPlugins[vPlugin].mAPI) == 0)
+			break;
+	}
+	if (sPlugins[vPlugin].mAPI == NULL)
+	{
+		VTRACE(_CL("Unknown renderer %s\n"), pAPI);
+		return NULL;
+	}
 
-		/* obtain pointer to the creation function */
-		vCreate = static_cast<DLL_RENDERCREATE*>(mRenderLib.GetSymbol("Construct"));
-		if (vCreate == NULL)
-		{
-			VTRACE(_CL("Unable to locate constructor.\n"));
-			return NULL;
-		}
+	VTRACE(_CL("Loading %s renderer\n"), pAPI);
+	if (vOverride != NULL && vOverride[0] != '\0')
+		vPath = vOverride;
+	else
+		vPath = sPlugins[vPlugin].mPath;
+	if (!mRenderLib.Load(vPath, sPlugins[vPlugin].mLib))
+	{
+		VTRACE(_CL("Unable to load window library\n"));
+		return NULL;
+	}
+	VTRACE(_CL("Library loaded successfully\n"));
 
-		/* try and create the WindowSystem */
-		(*vCreate)(&mRenderer);
-		if (mRenderer == NULL)
-		{
-			VTRACE(_CL("Unable to create the render device.\n"));
-			return NULL;
-		}
+	/* obtain pointer to the creation function */
+	vCreate = static_cast<DLL_RENDERCREATE*>(mRenderLib.GetSymbol("Construct"));
+	if (vCreate == NULL)
+	{
+		VTRACE(_CL("Unable to locate constructor.\n"));
+		return NULL;
+	}
 
-		return mRenderer;
+	/* try and create the WindowSystem */
+	(*vCreate)(&mRenderer);
+	if (mRenderer == NULL)
+	{
+		VTRACE(_CL("Unable to create the render device.\n"));
+		return NULL;
 	}
 
-	return NULL;
+	return mRenderer;
 }
 
 void Viper3D::DestroyRenderer(void)
@@ -177,9 +227,11 @@ void Viper3D::MainLoop()
 
 	if (1 == 1)
 	{
-		PROFILE("Main engine loop");
 		for (;;)
 		{
+			/* the previous pass's scopes have all closed by now */
+			PROFILE_FRAME();
+			PROFILE("Main engine loop");
 			gettimeofday(&vCurTime, NULL);
 			++vFramesPerSecond;
 			vTimeDiff.tv_sec = vCurTime.tv_sec - vLastTime.tv_sec;
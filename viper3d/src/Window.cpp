@@ -34,6 +34,7 @@ VWindow::VWindow()
 #endif
 {
 	mOpts.mFullScreen	= false;
+	mOpts.mOffscreen	= false;
 	mOpts.mWidth		= 0;
 	mOpts.mHeight		= 0;
 }
@@ -0,0 +1,135 @@
+/*============================================================================*
+ *                                                                            *
+ *  This file is part of the Viper3D Game Engine.                             *
+ *                                                                            *
+ *  Copyright (C) 2004 UDP Games   All Rights Reserved.                       *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------  ------------- *
+ *                                                                            *
+ *============================================================================*/
+#if !defined(__VARENA_H_INCLUDED__)
+#define __VARENA_H_INCLUDED__
+
+/* System Headers */
+#include <stddef.h>
+#include <vector>
+
+/* Local Headers */
+#include <viper3d/Globals.h>
+
+/* Defines */
+#define VARENA_BLOCK_SIZE	65536	/* default bytes per block */
+
+namespace UDP
+{
+
+/**
+ *	A position in a VArena to rewind to.
+ */
+struct VArenaMark
+{
+	VUINT	mBlock;
+	size_t	mOffset;
+};
+
+/**
+ *	@class		VArena
+ *
+ *	@brief		Bump allocator for memory that dies all at once.
+ *	@version	0.1.0
+ *	@date		17-Oct-2026
+ *	@remarks	Hands out memory from large blocks by moving a pointer;
+ *				nothing is freed on its own.  Reset() makes the whole
+ *				arena free again, typically once a frame or once a BSP
+ *				has been built, and Rewind() frees everything allocated
+ *				since a GetMark(), for scratch space.  Blocks are kept
+ *				for reuse, so once an arena has grown to its working
+ *				size it never goes to the heap again.  No constructors
+ *				or destructors are run, and it is not thread safe.
+ */
+class VArena
+{
+public:
+	/*==================================*
+	 *	   CONSTRUCTION/DESTRUCTION		*
+	 *==================================*/
+	VArena(size_t nBlockSize = VARENA_BLOCK_SIZE);
+	~VArena();
+
+	/*==================================*
+	 *			  ATTRIBUTES			*
+	 *==================================*/
+	size_t			GetUsed() const;
+	size_t			GetCapacity() const;
+	VUINT			GetHeapAllocs() const;
+	VArenaMark		GetMark() const;
+
+	/*==================================*
+	 *			  OPERATIONS			*
+	 *==================================*/
+	void*			Alloc(size_t nSize, size_t nAlign = 16);
+	void			Rewind(const VArenaMark &mark);
+	void			Reset();
+	void			Release();
+
+protected:
+	/*==================================*
+	 *             CALLBACKS			*
+	 *==================================*/
+
+private:
+	/*==================================*
+	 *             INTERNALS            *
+	 *==================================*/
+	struct VBlock
+	{
+		char	*mData;
+		size_t	mSize;
+	};
+
+	VArena(const VArena&);
+	const VArena&	operator=(const VArena&);
+
+private:
+	/*==================================*
+	 *             VARIABLES            *
+	 *==================================*/
+	std::vector<VBlock>	mBlocks;
+	size_t				mBlockSize;
+	VUINT				mCurrent;	/**< block being allocated from */
+	size_t				mOffset;	/**< next free byte in that block */
+	size_t				mUsed;		/**< bytes in blocks before mCurrent */
+	VUINT				mHeapAllocs;
+};
+
+inline
+size_t VArena::GetUsed() const
+{
+	return mUsed + mOffset;
+}
+
+/**
+ *	Number of blocks taken from the heap over the arena's life.
+ */
+inline
+VUINT VArena::GetHeapAllocs() const
+{
+	return mHeapAllocs;
+}
+
+inline
+VArenaMark VArena::GetMark() const
+{
+	VArenaMark vMark;
+
+	vMark.mBlock = mCurrent;
+	vMark.mOffset = mOffset;
+	return vMark;
+}
+
+} // End Namespace
+
+#endif // __VARENA_H_INCLUDED__
@@ -20,6 +20,22 @@
 namespace UDP
 {
 
+/**
+ *	SIMD instruction set tiers, in increasing order of capability.  Each
+ *	tier implies every tier below it.
+ */
+enum VSimdTier
+{
+	SIMD_SCALAR = 0,
+	SIMD_SSE2,
+	SIMD_SSE41,
+	SIMD_AVX2,
+	SIMD_FMA,
+	SIMD_TIER_COUNT
+};
+
+typedef void (*VCPUInitHook)(VSimdTier eTier);
+
 /**
  *	@class		VCPU
  *
@@ -27,6 +43,11 @@ namespace UDP
  *	@author		Josh Williams
  *	@version	0.1.0
  *	@date		2004-Sep-09
+ *	@remarks	Init() selects the highest SIMD tier supported by both the
+ *				processor and the OS, then calls every registered init hook
+ *				so libraries can fill their dispatch tables.  Setting the
+ *				VIPER_SIMD environment variable to scalar, sse2, sse41, avx2
+ *				or fma caps the tier, for A/B comparisons.
  */
 class VCPU
 {
@@ -42,11 +63,16 @@ public:
 	 *			  ATTRIBUTES			*
 	 *==================================*/
 	static bool		HaveSSE();
+	static VSimdTier	GetTier();
+	static VSimdTier	GetDetectedTier();
+	static const char*	GetTierName(VSimdTier eTier);
 
 	/*==================================*
 	 *			  OPERATIONS			*
 	 *==================================*/
 	static void		Init();
+	static void		SetTier(VSimdTier eTier);
+	static void		AddInitHook(VCPUInitHook pHook);
 
 protected:
 	/*==================================*
@@ -60,8 +86,8 @@ private:
 	static void		GetCPUVendor();
 	static void		GetBaseFeatures();
 	static void		GetExtFeatures();
-	static void		GetIntelInfo(int *Pn);
-	static void		GetAMDInfo(int *Pn);
+	static VSimdTier	ParseTier(const char *pName);
+	static void		RunHooks();
 
 private:
 	/*==================================*
@@ -69,13 +95,23 @@ private:
 	 *==================================*/
 	static bool		mSSE;
 	static bool		mSSE2;
+	static bool		mSSE41;
+	static bool		mAVX;
+	static bool		mAVX2;
+	static bool		mFMA;
+	static bool		mOSAVX;
 	static bool		m3DNOW;
 	static bool		mMMX;
 	static bool		mEXT;
 	static bool		mMMXEX;
 	static bool		m3DNOWEX;
 	static char		mVendor[13];
-	static char		mName[48];
+	static char		mName[49];
+	static VSimdTier	mDetectedTier;
+	static VSimdTier	mTier;
+	static bool		mInitialized;
+	static VCPUInitHook	mHooks[8];
+	static int		mHookCount;
 public:
 	static bool		mOSSSE;
 };
@@ -0,0 +1,47 @@
+/*============================================================================*
+ *                                                                            *
+ *  This file is part of the Viper3D Game Engine.                             *
+ *                                                                            *
+ *  Copyright (C) 2004 UDP Games   All Rights Reserved.                       *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------  ------------- *
+ *                                                                            *
+ *============================================================================*/
+#if !defined(__VCLOCK_H_INCLUDED__)
+#define __VCLOCK_H_INCLUDED__
+
+/* System Headers */
+
+/* Local Headers */
+#include <viper3d/Globals.h>
+
+namespace UDP
+{
+
+/**
+ *	@class		VClock
+ *
+ *	@brief		Monotonic wall clock.
+ *	@version	0.1.0
+ *	@date		17-Oct-2026
+ *	@remarks	Reads the high resolution performance counter, so it is
+ *				fine for timing anything down to a few microseconds but
+ *				costs a system call on some platforms.  For timing inside
+ *				a frame, use VProfiler.
+ */
+class VClock
+{
+public:
+	/*==================================*
+	 *			  ATTRIBUTES			*
+	 *==================================*/
+	static VUINT64	GetNanos();
+	static double	ElapsedMs(VUINT64 nStart);
+};
+
+} // End Namespace
+
+#endif // __VCLOCK_H_INCLUDED__
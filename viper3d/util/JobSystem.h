@@ -0,0 +1,136 @@
+/*============================================================================*
+ *                                                                            *
+ *  This file is part of the Viper3D Game Engine.                             *
+ *                                                                            *
+ *  Copyright (C) 2004 UDP Games   All Rights Reserved.                       *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------  ------------- *
+ *                                                                            *
+ *============================================================================*/
+#if !defined(__VJOBSYSTEM_H_INCLUDED__)
+#define __VJOBSYSTEM_H_INCLUDED__
+
+/* System Headers */
+#include <stdlib.h>
+
+/* Local Headers */
+#include <viper3d/Globals.h>
+
+/* Defines */
+#define VJOB_MAX_THREADS	64		/* most threads, the caller included */
+#define VJOB_POOL_SIZE		4096	/* jobs each thread may have unfinished */
+#define VJOB_QUEUE_SIZE		4096	/* jobs each worker's deque can hold */
+
+namespace UDP
+{
+
+class VJobSystem;
+struct VJobWorker;
+struct VJobSignal;
+
+struct VJob;
+typedef void (*VJobFunc)(VJob *pJob);
+
+/**
+ *	One unit of work.  A job is finished once its function has returned
+ *	and every child created under it has finished.
+ */
+struct VJob
+{
+	VJobFunc		mFunc;
+	VJobSystem		*mSystem;	/**< system that created the job */
+	VJob			*mParent;	/**< job waiting on this one, or NULL */
+	void			*mData;		/**< caller's data */
+	VUINT			mFirst;		/**< start of the range to work on */
+	VUINT			mCount;		/**< length of the range to work on */
+	volatile long	mUnfinished;	/**< this job plus unfinished children */
+};
+
+/**
+ *	@class		VJobSystem
+ *
+ *	@brief		Runs jobs on a pool of worker threads.
+ *	@version	0.1.0
+ *	@date		17-Oct-2026
+ *	@remarks	Each thread keeps its own deque of jobs: it pushes and pops
+ *				at the back, so related work stays on one core, and idle
+ *				threads steal from the front of the others.  The thread
+ *				that calls Init() counts as worker 0 and only runs jobs
+ *				while it is inside Wait().
+ *
+ *				Jobs come from a per-thread pool of VJOB_POOL_SIZE, and
+ *				Create() only hands out one that has finished.  Once a
+ *				thread has that many unfinished it returns NULL, and
+ *				ParallelFor() stops splitting and runs the rest of its
+ *				range itself.  A job that is created must be run, or
+ *				its slot is never freed.  Jobs may only be created, run
+ *				and waited on by the thread that called Init() or by
+ *				other jobs.
+ */
+class VJobSystem
+{
+public:
+	/*==================================*
+	 *	   CONSTRUCTION/DESTRUCTION		*
+	 *==================================*/
+	VJobSystem();
+	~VJobSystem();
+
+	/*==================================*
+	 *			  ATTRIBUTES			*
+	 *==================================*/
+	int				GetNumThreads() const;
+	static int		GetNumCores();
+
+	/*==================================*
+	 *			  OPERATIONS			*
+	 *==================================*/
+	bool			Init(int nThreads = 0);
+	void			Shutdown();
+	VJob*			Create(VJobFunc pFunc, void *pData, VUINT nFirst = 0,
+							VUINT nCount = 0, VJob *pParent = NULL);
+	void			Run(VJob *pJob);
+	void			Wait(VJob *pJob);
+	void			ParallelFor(VJobFunc pFunc, void *pData, VUINT nCount,
+							VUINT nGrain);
+
+protected:
+	/*==================================*
+	 *             CALLBACKS			*
+	 *==================================*/
+
+private:
+	/*==================================*
+	 *             INTERNALS            *
+	 *==================================*/
+	friend struct VJobWorker;
+	void			WorkerLoop(int nWorker);
+	int				CurrentWorker() const;
+	VJob*			GetJob(int nWorker);
+	bool			HasWork() const;
+	void			Execute(VJob *pJob);
+	void			Finish(VJob *pJob);
+
+private:
+	/*==================================*
+	 *             VARIABLES            *
+	 *==================================*/
+	VJobWorker		*mWorkers;
+	VJobSignal		*mSignal;		/**< wakes idle workers */
+	int				mNumThreads;
+	volatile long	mSleeping;		/**< workers waiting on mSignal */
+	volatile long	mQuit;
+};
+
+inline
+int VJobSystem::GetNumThreads() const
+{
+	return mNumThreads;
+}
+
+} // End Namespace
+
+#endif // __VJOBSYSTEM_H_INCLUDED__
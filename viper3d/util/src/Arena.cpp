@@ -0,0 +1,181 @@
+/*============================================================================*
+ *                                                                            *
+ *  This file is part of the Viper3D Game Engine.                             *
+ *                                                                            *
+ *  Copyright (C) 2004 UDP Games   All Rights Reserved.                       *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------  ------------- *
+ *                                                                            *
+ *============================================================================*/
+#include <viper3d/util/Arena.h>
+
+/* System Headers */
+
+/* Local Headers */
+
+namespace UDP
+{
+
+/********************************************************************
+ *          C O N S T R U C T I O N / D E S T R U C T I O N         *
+ ********************************************************************/
+VArena::VArena(size_t nBlockSize /*=VARENA_BLOCK_SIZE*/)
+: mBlockSize(nBlockSize), mCurrent(0), mOffset(0), mUsed(0), mHeapAllocs(0)
+{
+
+}
+
+VArena::~VArena()
+{
+	Release();
+}
+
+/********************************************************************
+ *                        A T T R I B U T E S                       *
+ ********************************************************************/
+size_t VArena::GetCapacity() const
+{
+	size_t vSize = 0;
+
+	for (VUINT i = 0; i < (VUINT)mBlocks.size(); i++)
+		vSize += mBlocks[i].mSize;
+	return vSize;
+}
+
+/********************************************************************
+ *                        O P E R A T I O N S                       *
+ ********************************************************************/
+
+/*------------------------------------------------------------------*
+ *								Alloc()								*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Allocates uninitialised memory from the arena.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	Moves on to the next block, or takes a new one from the
+ *				heap, when the current block is full.  The tail of a
+ *				full block stays unused until Reset().
+ *
+ *	@param		nSize	Bytes wanted
+ *	@param		nAlign	Alignment, a power of two
+ *
+ *	@returns	(void*) The memory; valid until Reset(), Release() or a
+ *				Rewind() to a mark taken before it.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void* VArena::Alloc(size_t nSize, size_t nAlign /*=16*/)
+{
+	VBlock	vBlock;
+	size_t	vPad;
+
+	for (;;)
+	{
+		if (mCurrent < mBlocks.size())
+		{
+			const VBlock &vCur = mBlocks[mCurrent];
+
+			vPad = (nAlign - (size_t)(vCur.mData + mOffset) % nAlign) % nAlign;
+			if (mOffset + vPad + nSize <= vCur.mSize)
+			{
+				mOffset += vPad;
+				void *vMem = vCur.mData + mOffset;
+				mOffset += nSize;
+				return vMem;
+			}
+			if (mCurrent + 1 < mBlocks.size())
+			{
+				mUsed += vCur.mSize;
+				mCurrent++;
+				mOffset = 0;
+				continue;
+			}
+		}
+
+		vBlock.mSize = nSize + nAlign > mBlockSize ? nSize + nAlign : mBlockSize;
+		vBlock.mData = new char[vBlock.mSize];
+		mHeapAllocs++;
+		if (!mBlocks.empty())
+		{
+			mUsed += mBlocks[mCurrent].mSize;
+			mCurrent++;
+		}
+		mBlocks.push_back(vBlock);
+		mOffset = 0;
+	}
+}
+
+/*------------------------------------------------------------------*
+ *								Rewind()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Frees everything allocated since a mark was taken.
+ *	@date		17-Oct-2026
+ *
+ *	@param		mark	From GetMark(), with no Reset() in between
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VArena::Rewind(const VArenaMark &mark)
+{
+	mCurrent = mark.mBlock;
+	mOffset = mark.mOffset;
+	mUsed = 0;
+	for (VUINT i = 0; i < mCurrent && i < (VUINT)mBlocks.size(); i++)
+		mUsed += mBlocks[i].mSize;
+}
+
+/*------------------------------------------------------------------*
+ *								Reset()								*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Frees everything, keeping the blocks for reuse.
+ *	@date		17-Oct-2026
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VArena::Reset()
+{
+	mCurrent = 0;
+	mOffset = 0;
+	mUsed = 0;
+}
+
+/*------------------------------------------------------------------*
+ *							   Release()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Frees everything and gives the blocks back to the heap.
+ *	@date		17-Oct-2026
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VArena::Release()
+{
+	for (VUINT i = 0; i < (VUINT)mBlocks.size(); i++)
+		delete[] mBlocks[i].mData;
+	mBlocks.clear();
+	Reset();
+}
+
+} // End Namespace
@@ -14,37 +14,95 @@
 
 /* System Headers */
 #include <cstring>
+#include <cstdlib>
 
 /* Local Headers */
 #include <viper3d/Globals.h>
 #include <viper3d/util/Log.h>
 
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+#define VIPER_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
 namespace UDP
 {
-bool	VCPU::mSSE = false;
-bool	VCPU::mOSSSE = false;
-bool	VCPU::mSSE2 = false;
-bool	VCPU::m3DNOW = false;
-bool	VCPU::mMMX = false;
-bool	VCPU::mEXT = false;
-bool	VCPU::mMMXEX = false;
-bool	VCPU::m3DNOWEX = false;
-char	VCPU::mVendor[13];
-char	VCPU::mName[48];
+bool			VCPU::mSSE = false;
+bool			VCPU::mOSSSE = false;
+bool			VCPU::mSSE2 = false;
+bool			VCPU::mSSE41 = false;
+bool			VCPU::mAVX = false;
+bool			VCPU::mAVX2 = false;
+bool			VCPU::mFMA = false;
+bool			VCPU::mOSAVX = false;
+bool			VCPU::m3DNOW = false;
+bool			VCPU::mMMX = false;
+bool			VCPU::mEXT = false;
+bool			VCPU::mMMXEX = false;
+bool			VCPU::m3DNOWEX = false;
+char			VCPU::mVendor[13];
+char			VCPU::mName[49];
+VSimdTier		VCPU::mDetectedTier = SIMD_SCALAR;
+VSimdTier		VCPU::mTier = SIMD_SCALAR;
+bool			VCPU::mInitialized = false;
+VCPUInitHook	VCPU::mHooks[8];
+int				VCPU::mHookCount = 0;
 
 static char __CLASS__[] = "[     VCPU     ]";
 
-#if VIPER_PLATFORM == PLATFORM_LINUX
-#include <signal.h>
-static void sigill_handler(int signal, struct sigcontext sc)
+static const char *sTierNames[SIMD_TIER_COUNT] = {
+	"scalar",
+	"sse2",
+	"sse41",
+	"avx2",
+	"fma"
+};
+
+/*
+ * Executes cpuid for the given leaf/subleaf.  Registers come back in
+ * eax, ebx, ecx, edx order.  On non-x86 builds every register is zero,
+ * so no feature is ever reported.
+ */
+static void CPUID(VUINT nLeaf, VUINT nSub, VUINT *pRegs)
 {
-	cout << "sigill_handler" << endl;
-	/*
-	sc.eip += 3;
-	*/
-	UDP::VCPU::mOSSSE = false;
+#if defined(VIPER_X86) && defined(_MSC_VER)
+	int vRegs[4];
+	__cpuidex(vRegs, (int)nLeaf, (int)nSub);
+	pRegs[0] = vRegs[0];
+	pRegs[1] = vRegs[1];
+	pRegs[2] = vRegs[2];
+	pRegs[3] = vRegs[3];
+#elif defined(VIPER_X86)
+	__cpuid_count(nLeaf, nSub, pRegs[0], pRegs[1], pRegs[2], pRegs[3]);
+#else
+	pRegs[0] = pRegs[1] = pRegs[2] = pRegs[3] = 0;
+#endif
 }
+
+/*
+ * Reads an extended control register.  Only valid once cpuid has
+ * reported OSXSAVE.
+ */
+static VUINT XGetBV(VUINT nReg)
+{
+#if defined(VIPER_X86) && defined(_MSC_VER)
+	return (VUINT)_xgetbv(nReg);
+#elif defined(VIPER_X86)
+	VUINT vLow, vHigh;
+	/* xgetbv, spelled out for assemblers that predate it */
+	__asm__ __volatile__ (".byte 0x0f, 0x01, 0xd0"
+			: "=a" (vLow), "=d" (vHigh)
+			: "c" (nReg)
+	);
+	return vLow;
+#else
+	return 0;
 #endif
+}
 
 /********************************************************************
  *          C O N S T R U C T I O N / D E S T R U C T I O N         *
@@ -84,6 +142,72 @@ bool VCPU::HaveSSE(void)
 	return (mSSE && mOSSSE);
 }
 
+/*------------------------------------------------------------------*
+ *								GetTier()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Returns the SIMD tier currently in use.
+ *	@date		17-Oct-2026
+ *
+ *	@returns	(VSimdTier) Active tier; SIMD_SCALAR before Init().
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+VSimdTier VCPU::GetTier(void)
+{
+	return mTier;
+}
+
+/*------------------------------------------------------------------*
+ *							GetDetectedTier()						*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Returns the highest SIMD tier the CPU/OS supports,
+ *				ignoring any override.
+ *	@date		17-Oct-2026
+ *
+ *	@returns	(VSimdTier) Detected tier
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+VSimdTier VCPU::GetDetectedTier(void)
+{
+	return mDetectedTier;
+}
+
+/*------------------------------------------------------------------*
+ *							  GetTierName()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Returns the printable name of a SIMD tier, as accepted
+ *				by the VIPER_SIMD environment variable.
+ *	@date		17-Oct-2026
+ *
+ *	@param		eTier	Tier to name
+ *
+ *	@returns	(const char*) Tier name
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+const char* VCPU::GetTierName(VSimdTier eTier)
+{
+	if (eTier < SIMD_SCALAR || eTier >= SIMD_TIER_COUNT)
+		return "unknown";
+	return sTierNames[eTier];
+}
+
 /********************************************************************
  *                        O P E R A T I O N S                       *
  ********************************************************************/
@@ -92,7 +216,8 @@ bool VCPU::HaveSSE(void)
  *								 Init()								*
  *------------------------------------------------------------------*/
 /**
- *	@brief		Extracts the CPU information from the processor.
+ *	@brief		Extracts the CPU information from the processor and
+ *				selects the SIMD tier used by the dispatch tables.
  *	@author		Josh Williams
  *	@date		09-Sep-2004
  *
@@ -102,11 +227,13 @@ bool VCPU::HaveSSE(void)
  * MODIFICATIONS													*
  *	Date		Description							Author			*
  * ===========	==================================	===============	*
- *																	*
+ *	17-Oct-2026	Replaced inline asm with cpuid/xgetbv					*
+ *				and added SIMD tier selection						*
  *------------------------------------------------------------------*/
 void VCPU::Init(void)
 {
-	int		vN = 0;
+	const char	*vOverride;
+	VSimdTier	vTier;
 
 	memset(mName, '\0', sizeof(mName));
 
@@ -119,36 +246,53 @@ void VCPU::Init(void)
 	/* Get the extended feature list */
 	GetExtFeatures();
 
-	/* vendor specific stuff */
-	if ((strncmp(mVendor, "GenuineIntel", 12) == 0) && mEXT)
+	/*
+	 * Every OS we run on saves the XMM registers, so SSE support is
+	 * purely a CPU question.  AVX state is only saved if the OS has
+	 * enabled it in XCR0, which we checked in GetBaseFeatures().
+	 */
+	mOSSSE = mSSE;
+
+	/* Pick the best tier the hardware can run */
+	vTier = SIMD_SCALAR;
+	if (mSSE2 && mOSSSE)
 	{
-		/* Intel family */
-		GetIntelInfo(&vN);
+		vTier = SIMD_SSE2;
+		if (mSSE41)
+			vTier = SIMD_SSE41;
+		if (vTier == SIMD_SSE41 && mAVX2 && mOSAVX)
+			vTier = SIMD_AVX2;
+		if (vTier == SIMD_AVX2 && mFMA)
+			vTier = SIMD_FMA;
 	}
-	else if ((strncmp(mVendor, "AuthenticAMD", 12) == 0) && mEXT)
+	mDetectedTier = vTier;
+
+	/* Allow the environment to force a lower tier */
+	vOverride = getenv("VIPER_SIMD");
+	if (vOverride != NULL && *vOverride != '\0')
 	{
-		/* AMD family */
-		GetAMDInfo(&vN);
+		vTier = ParseTier(vOverride);
+		if (vTier > mDetectedTier)
+		{
+			VTRACE(_CL("VIPER_SIMD=%s not supported, using %s\n"),
+					vOverride, GetTierName(mDetectedTier));
+			vTier = mDetectedTier;
+		}
 	}
-
-	/* Test for OS SSE support */
-	mOSSSE = true;
-#if VIPER_PLATFORM == PLATFORM_WINDOWS
-#elif VIPER_PLATFORM == PLATFORM_MAC
-#elif VIPER_PLATFORM == PLATFORM_LINUX
-	struct	sigaction vSavedSigill;
-	sigaction(SIGILL, NULL, &vSavedSigill);
-	signal(SIGILL, (void (*)(int))sigill_handler);
-	__asm__ __volatile__ ("xorps %xmm0, %xmm0");
-#endif
+	mTier = vTier;
+	mInitialized = true;
 
 	/* Output CPU information to trace file */
 	VTRACE(_CL("============ CPU Info =============\n"));
-	//VTRACE(_CL("Vendor:         %s\n"), mVendor);
-	VTRACE(_CL("\n"));
+	VTRACE(_CL("Vendor:         %s\n"), mVendor);
+	VTRACE(_CL("Name:           %s\n"), mName);
 	VTRACE(_CL("Base features: "));
 	if (mSSE)	VTRACE(" SSE");
 	if (mSSE2)	VTRACE(" SSE2");
+	if (mSSE41)	VTRACE(" SSE4.1");
+	if (mAVX)	VTRACE(" AVX");
+	if (mAVX2)	VTRACE(" AVX2");
+	if (mFMA)	VTRACE(" FMA");
 	if (mMMX)	VTRACE(" MMX");
 	VTRACE("\n");
 
@@ -162,9 +306,81 @@ void VCPU::Init(void)
 	}
 
 	VTRACE(_CL("OS SSE Support: %s\n"), (mOSSSE ? "Yes" : "No"));
+	VTRACE(_CL("OS AVX Support: %s\n"), (mOSAVX ? "Yes" : "No"));
+	VTRACE(_CL("SIMD tier:      %s (detected %s)\n"), GetTierName(mTier),
+			GetTierName(mDetectedTier));
 	
 	VTRACE(_CL("===================================\n"));
 
+	RunHooks();
+}
+
+/*------------------------------------------------------------------*
+ *								SetTier()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Changes the active SIMD tier at runtime and refills the
+ *				dispatch tables.
+ *	@date		17-Oct-2026
+ *
+ *	@param		eTier	Requested tier.  Clamped to the detected tier,
+ *						since anything higher would fault.
+ *
+ *	@remarks	Intended for tests and benchmarks.  Not thread-safe with
+ *				respect to code currently calling through the tables.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VCPU::SetTier(VSimdTier eTier)
+{
+	if (eTier < SIMD_SCALAR)
+		eTier = SIMD_SCALAR;
+	if (eTier > mDetectedTier)
+		eTier = mDetectedTier;
+	mTier = eTier;
+	RunHooks();
+}
+
+/*------------------------------------------------------------------*
+ *							  AddInitHook()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Registers a function to be called whenever the SIMD
+ *				tier is chosen or changed.
+ *	@date		17-Oct-2026
+ *
+ *	@param		pHook	Function to call with the active tier
+ *
+ *	@remarks	If Init() has already run, the hook is called right away
+ *				so late-loaded libraries still pick up the right tier.
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VCPU::AddInitHook(VCPUInitHook pHook)
+{
+	if (pHook == NULL)
+		return;
+
+	for (int i = 0; i < mHookCount; i++)
+	{
+		if (mHooks[i] == pHook)
+			return;
+	}
+
+	if (mHookCount >= (int)(sizeof(mHooks) / sizeof(mHooks[0])))
+		return;
+
+	mHooks[mHookCount++] = pHook;
+	if (mInitialized)
+		pHook(mTier);
 }
 
 /********************************************************************
@@ -179,7 +395,7 @@ void VCPU::Init(void)
  *							  GetCPUVendor()						*
  *------------------------------------------------------------------*/
 /**
- *	@brief		Determines the manufacturer of the CPU.
+ *	@brief		Determines the manufacturer and brand name of the CPU.
  *	@author		Josh Williams
  *	@date		10-Sep-2004
  *
@@ -193,34 +409,28 @@ void VCPU::Init(void)
  *------------------------------------------------------------------*/
 void VCPU::GetCPUVendor()
 {
-	char *vVendor = mVendor;
+	VUINT vRegs[4];
 
 	memset(mVendor, '\0', sizeof(mVendor));
-	/* Get the vendor name */
-#if VIPER_PLATFORM == PLATFORM_WINDOWS
-	_asm {
-		mov		eax, 0
-		CPUID
-
-		mov		esi,		vVendor
-		mov		[esi],		ebx
-		mov		[esi+4],	edx
-		mov		[esi+8],	ecx
+
+	/* vendor string is returned in ebx, edx, ecx order */
+	CPUID(0, 0, vRegs);
+	memcpy(&mVendor[0], &vRegs[1], 4);
+	memcpy(&mVendor[4], &vRegs[3], 4);
+	memcpy(&mVendor[8], &vRegs[2], 4);
+	mVendor[12] = '\0';
+
+	/* brand string lives in extended leaves 0x80000002-0x80000004 */
+	CPUID(0x80000000, 0, vRegs);
+	if (vRegs[0] >= 0x80000004)
+	{
+		for (VUINT i = 0; i < 3; i++)
+		{
+			CPUID(0x80000002 + i, 0, vRegs);
+			memcpy(&mName[i * 16], vRegs, 16);
+		}
 	}
-#elif VIPER_PLATFORM == PLATFORM_APPLE
-#elif VIPER_PLATFORM == PLATFORM_LINUX
-	__asm__ __volatile__("\n\t"
-			"pushq %%rbx\n\t"
-			"cpuid\n\t"
-			"movl %%ebx, %0\n\t"
-			"popq %%rbx\n\t"
-			: "=r" (*(int*)&vVendor[0]),
-			  "=d" (*(int*)&vVendor[4]),
-			  "=c" (*(int*)&vVendor[8])
-			: "a" (0)
-	);
-#endif
-	vVendor[12] = '\0';
+	mName[48] = '\0';
 }
 
 /*------------------------------------------------------------------*
@@ -241,94 +451,31 @@ void VCPU::GetCPUVendor()
  *------------------------------------------------------------------*/
 void VCPU::GetBaseFeatures()
 {
-#if VIPER_PLATFORM == PLATFORM_WINDOWS
-	_asm {
-		mov		eax,		1
-		CPUID
-
-		test	edx,		04000000h
-		jz		NOSSE2
-		mov		[mSSE2],	1
-NOSSE2:	test	edx,		02000000h
-		jz		NOSSE
-		mov		[mSSE],	1
-NOSSE:	test	edx,		00800000h
-		jz		EXIT
-		mov		[mMMX],	1
-EXIT:
-	}		
-#elif VIPER_PLATFORM == PLATFORM_APPLE
-#elif VIPER_PLATFORM == PLATFORM_LINUX
-
-	__asm__ __volatile__ ("\n\t"
-		"pushq	%%rbx\n\t"
-		"cpuid\n\t"
-		"movb	$0, %0\n\t"
-		"test	$0x04000000, %%edx\n\t"
-		"jz		NOSSE2\n\t"
-		"movb	$1, %0\n\t"
-		"NOSSE2:\n\t"
-		"popq	%%rbx\n\t"
-		: "=m" (mSSE2)
-		: "a" (1)
-		: "cx", "dx", "memory"
-	);
-
-	__asm__ __volatile__ ("\n\t"
-		"pushq	%%rbx\n\t"
-		"cpuid\n\t"
-		"movb	$0, %0\n\t"
-		"test	$0x02000000, %%edx\n\t"
-		"jz		NOSSE\n\t"
-		"movb	$1, %0\n\t"
-		"NOSSE:\n\t"
-		"popq	%%rbx\n\t"
-		: "=m" (mSSE)
-		: "a" (1)
-		: "cx", "dx", "memory"
-	);
-
-	__asm__ __volatile__ ("\n\t"
-		"pushq	%%rbx\n\t"
-		"cpuid\n\t"
-		"movb	$0, %0\n\t"
-		"test	$0x00800000, %%edx\n\t"
-		"jz		EXIT\n\t"
-		"movb	$1, %0\n\t"
-		"EXIT:\n\t"
-		"popq	%%rbx\n\t"
-		: "=m" (mMMX)
-		: "a" (1)
-		: "cx", "dx", "memory"
-	);
-/*
-	__asm__ __volatile__ ("\n\t"
-		"pushl	%%ebx\n\t"
-		"cpuid\n\t"
-		"movb	$0,	%0\n\t"
-		"movb	$0,	%1\n\t"
-		"movb	$0,	%2\n\t"
-		"test	$0x04000000, %%edx\n\t"
-		"jz		NOSSE2\n\t"
-		"movb	$1, %0\n\t"
-		"NOSSE2:\n\t"
-		"test	$0x02000000, %%edx\n\t"
-		"jz		NOSSE\n\t"
-		"movb	$1, %1\n\t"
-		"NOSSE:\n\t"
-		"test	$0x00800000, %%edx\n\t"
-		"jz		EXIT\n\t"
-		"movb	$1, %2\n\t"
-		"EXIT:\n\t"
-		"popl %%ebx\n\t"
-		: "=m" (mSSE2),
-		  "=m" (mSSE),
-		  "=m" (mMMX)
-		: "a" (1)
-		: "cx", "dx", "memory"
-	);
-*/
-#endif
+	VUINT vRegs[4];
+	VUINT vMaxLeaf;
+
+	CPUID(0, 0, vRegs);
+	vMaxLeaf = vRegs[0];
+	if (vMaxLeaf < 1)
+		return;
+
+	CPUID(1, 0, vRegs);
+	mMMX	= (vRegs[3] & 0x00800000) != 0;
+	mSSE	= (vRegs[3] & 0x02000000) != 0;
+	mSSE2	= (vRegs[3] & 0x04000000) != 0;
+	mSSE41	= (vRegs[2] & 0x00080000) != 0;
+	mFMA	= (vRegs[2] & 0x00001000) != 0;
+	mAVX	= (vRegs[2] & 0x10000000) != 0;
+
+	/* OSXSAVE set and both XMM and YMM state enabled in XCR0 */
+	if ((vRegs[2] & 0x08000000) != 0)
+		mOSAVX = (XGetBV(0) & 0x6) == 0x6;
+
+	if (vMaxLeaf >= 7)
+	{
+		CPUID(7, 0, vRegs);
+		mAVX2 = (vRegs[1] & 0x00000020) != 0;
+	}
 }
 
 /*------------------------------------------------------------------*
@@ -349,42 +496,35 @@ EXIT:
  *------------------------------------------------------------------*/
 void VCPU::GetExtFeatures()
 {
-#if VIPER_PLATFORM == PLATFORM_WINDOWS
-#elif VIPER_PLATFORM == PLATFORM_APPLE
-#elif VIPER_PLATFORM == PLATFORM_LINUX
-
-	/* extended info */
-	__asm__ __volatile__ ("\n\t"
-			"pushq %%rbx\n\t"
-			"movl	$0x80000000, %%eax\n\t"
-			"cpuid\n\t"
-			"cmp	$0x80000000, %%eax\n\t"
-			"jbe	EXIT2\n\t"
-			"movb	$1, %0\n\t"
-			"movl	$0x80000001, %%eax\n\t"
-			"cpuid\n\t"
-			"test	$0x80000000, %%edx\n\t"
-			"jz		EXIT2\n\t"
-			"movb	$1, %1\n\t"
-			"EXIT2:\n\t"
-			"popq %%rbx\n\t"
-			: "=r" (mEXT),
-			  "=r" (m3DNOW)
-			:
-			: "ax"
-	);
-#endif
+	VUINT vRegs[4];
+
+	CPUID(0x80000000, 0, vRegs);
+	if (vRegs[0] <= 0x80000000)
+		return;
+
+	mEXT = true;
+	CPUID(0x80000001, 0, vRegs);
+	m3DNOW = (vRegs[3] & 0x80000000) != 0;
+
+	/* these bits are only meaningful on AMD parts */
+	if (strncmp(mVendor, "AuthenticAMD", 12) == 0)
+	{
+		m3DNOWEX	= (vRegs[3] & 0x40000000) != 0;
+		mMMXEX		= (vRegs[3] & 0x00400000) != 0;
+	}
 }
 
 /*------------------------------------------------------------------*
- *							  GetIntelInfo()						*
+ *							   ParseTier()							*
  *------------------------------------------------------------------*/
 /**
- *	@brief		Gets the model number of an Intel processor.
- *	@author		Josh Williams
- *	@date		10-Sep-2004
+ *	@brief		Converts a tier name (as returned by GetTierName()) back
+ *				into a VSimdTier.
+ *	@date		17-Oct-2026
  *
- *	@returns	void
+ *	@param		pName	Tier name; "sse4.1" is accepted for "sse41"
+ *
+ *	@returns	(VSimdTier) Matching tier, or SIMD_SCALAR if unknown
  */
 /*------------------------------------------------------------------*
  * MODIFICATIONS													*
@@ -392,33 +532,27 @@ void VCPU::GetExtFeatures()
  * ===========	==================================	===============	*
  *																	*
  *------------------------------------------------------------------*/
-void VCPU::GetIntelInfo(int *pN)
+VSimdTier VCPU::ParseTier(const char *pName)
 {
-#if VIPER_PLATFORM == PLATFORM_WINDOWS
-#elif VIPER_PLATFORM == PLATFORM_APPLE
-#elif VIPER_PLATFORM == PLATFORM_LINUX
-	__asm__ __volatile__ ("\n\t"
-			"mov	$1, %%eax\n\t"
-			"cpuid\n\t"
-			: "=c" (*pN)
-			:
-			: "eax"
-	);
-	int vM=0;
-	memcpy(&vM, pN, sizeof(char));
-	*pN = vM;
-#endif
+	if (strcmp(pName, "sse4.1") == 0)
+		return SIMD_SSE41;
+
+	for (int i = 0; i < SIMD_TIER_COUNT; i++)
+	{
+		if (strcmp(pName, sTierNames[i]) == 0)
+			return (VSimdTier)i;
+	}
+
+	VTRACE(_CL("Unknown VIPER_SIMD value '%s', using scalar\n"), pName);
+	return SIMD_SCALAR;
 }
 
 /*------------------------------------------------------------------*
- *							   GetAMDInfo()							*
+ *								RunHooks()							*
  *------------------------------------------------------------------*/
 /**
- *	@brief		Gets the model number of an AMD processor.  Also
- *				determines if the processor supports 3DNow! extended
- *				or MMX Extended.
- *	@author		Josh Williams
- *	@date		10-Sep-2004
+ *	@brief		Notifies every registered hook of the active tier.
+ *	@date		17-Oct-2026
  *
  *	@returns	void
  */
@@ -428,40 +562,10 @@ void VCPU::GetIntelInfo(int *pN)
  * ===========	==================================	===============	*
  *																	*
  *------------------------------------------------------------------*/
-void VCPU::GetAMDInfo(int *pN)
+void VCPU::RunHooks()
 {
-#if VIPER_PLATFORM == PLATFORM_WINDOWS
-#elif VIPER_PLATFORM == PLATFORM_APPLE
-#elif VIPER_PLATFORM == PLATFORM_LINUX
-	__asm__ __volatile__ (
-			"movl	$1, %%eax\n"
-			"cpuid\n"
-			: "=c" (*pN)
-			:
-			: "eax"
-	);
-	int vM = 0;
-	memcpy(&vM, pN, sizeof(char));
-	*pN = vM;
-
-	__asm__ __volatile__ ("\n\t"
-			"movl	$0x80000001, %%eax\n"
-			"cpuid\n"
-			"test	$0x40000000, %%edx\n"
-			"jz		AMD1\n"
-			"movb	$1, %0\n"
-			"AMD1:\n"
-			"test	$0x00400000, %%edx\n"
-			"jz		AMD2\n"
-			"movb	$1, %1\n"
-			"AMD2:\n"
-			: "=m" (m3DNOWEX),
-			  "=m" (mMMXEX)
-			:
-			: "ax", "dx", "memory"
-	);
-#endif
+	for (int i = 0; i < mHookCount; i++)
+		mHooks[i](mTier);
 }
 
 } // End Namespace
-
@@ -0,0 +1,84 @@
+/*============================================================================*
+ *                                                                            *
+ *  This file is part of the Viper3D Game Engine.                             *
+ *                                                                            *
+ *  Copyright (C) 2004 UDP Games   All Rights Reserved.                       *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------  ------------- *
+ *                                                                            *
+ *============================================================================*/
+#include <viper3d/util/Clock.h>
+
+/* System Headers */
+#if VIPER_PLATFORM == PLATFORM_WINDOWS
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+/* Local Headers */
+
+namespace UDP
+{
+
+/********************************************************************
+ *                        A T T R I B U T E S                       *
+ ********************************************************************/
+
+/*------------------------------------------------------------------*
+ *							  GetNanos()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Nanoseconds since some fixed point in the past.
+ *	@date		17-Oct-2026
+ *
+ *	@returns	(VUINT64) Current time; only differences are meaningful
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+VUINT64 VClock::GetNanos()
+{
+#if VIPER_PLATFORM == PLATFORM_WINDOWS
+	LARGE_INTEGER	vFreq, vNow;
+
+	QueryPerformanceFrequency(&vFreq);
+	QueryPerformanceCounter(&vNow);
+	return (VUINT64)((double)vNow.QuadPart * 1e9 / (double)vFreq.QuadPart);
+#else
+	struct timespec	vNow;
+
+	clock_gettime(CLOCK_MONOTONIC, &vNow);
+	return (VUINT64)vNow.tv_sec * 1000000000ull + (VUINT64)vNow.tv_nsec;
+#endif
+}
+
+/*------------------------------------------------------------------*
+ *							  ElapsedMs()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Milliseconds since an earlier GetNanos().
+ *	@date		17-Oct-2026
+ *
+ *	@param		nStart	Value returned by GetNanos()
+ *
+ *	@returns	(double) Elapsed time, to the nanosecond
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+double VClock::ElapsedMs(VUINT64 nStart)
+{
+	return (double)(GetNanos() - nStart) * 1e-6;
+}
+
+} // End Namespace
@@ -0,0 +1,733 @@
+/*============================================================================*
+ *                                                                            *
+ *  This file is part of the Viper3D Game Engine.                             *
+ *                                                                            *
+ *  Copyright (C) 2004 UDP Games   All Rights Reserved.                       *
+ *                                                                            *
+ *============================================================================*
+ *                                  CHANGELOG                                 *
+ *    Date      Description                                     Author        *
+ * -----------  ----------------------------------------------  ------------- *
+ *                                                                            *
+ *============================================================================*/
+#include <viper3d/util/JobSystem.h>
+
+/* System Headers */
+#if VIPER_PLATFORM != PLATFORM_WINDOWS
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+/* Local Headers */
+#include <viper3d/util/Log.h>
+
+#if VIPER_PLATFORM == PLATFORM_WINDOWS
+#define VJOB_THREAD				HANDLE
+#define VJOB_MUTEX				CRITICAL_SECTION
+#define VJOB_COND				CONDITION_VARIABLE
+#define VJOB_INC( a )			InterlockedIncrement( &(a) )
+#define VJOB_DEC( a )			InterlockedDecrement( &(a) )
+#define VJOB_LOAD( a )			(*(volatile long*)&(a))
+#define VJOB_FENCE( )			MemoryBarrier( )
+#define VJOB_TRYLOCK( a )		(InterlockedExchange( &(a), 1 ) == 0)
+#define VJOB_UNLOCK( a )		InterlockedExchange( &(a), 0 )
+#define VJOB_YIELD( )			SwitchToThread( )
+#else
+#define VJOB_THREAD				pthread_t
+#define VJOB_MUTEX				pthread_mutex_t
+#define VJOB_COND				pthread_cond_t
+#define VJOB_INC( a )			__sync_add_and_fetch( &(a), 1 )
+#define VJOB_DEC( a )			__sync_sub_and_fetch( &(a), 1 )
+#define VJOB_LOAD( a )			__atomic_load_n( &(a), __ATOMIC_ACQUIRE )
+#define VJOB_FENCE( )			__sync_synchronize( )
+#define VJOB_TRYLOCK( a )		(__sync_lock_test_and_set( &(a), 1 ) == 0)
+#define VJOB_UNLOCK( a )		__sync_lock_release( &(a) )
+#define VJOB_YIELD( )			sched_yield( )
+#endif
+
+#define VJOB_SPINS				64	/* empty polls before a worker sleeps */
+
+namespace UDP
+{
+
+static char __CLASS__[] = "[  VJobSystem  ]";
+
+/*
+ * Which system and worker slot the current thread belongs to.
+ */
+static VTHREAD_LOCAL VJobSystem	*sCurrentSystem = NULL;
+static VTHREAD_LOCAL int			sCurrentWorker = 0;
+
+/**
+ *	A worker thread's job pool and deque.  The deque is guarded by a
+ *	spin lock, as it is only ever held for a few instructions.  mHead
+ *	and mTail are also read without it, to skip empty deques.
+ */
+struct VJobWorker
+{
+	VJob			*mPool;
+	VUINT			mNext;		/**< next pool entry to try */
+	VJob			*mQueue[VJOB_QUEUE_SIZE];
+	volatile long	mHead;		/**< oldest job, stolen first */
+	volatile long	mTail;		/**< one past the newest job */
+	volatile long	mLock;
+	VJobSystem		*mSystem;
+	int				mIndex;
+	VJOB_THREAD		mThread;
+	char			mPad[64];	/**< keeps mLock off the next worker's line */
+
+	bool			IsEmpty() const;
+	bool			Push(VJob *pJob);
+	VJob*			Pop();
+	VJob*			Steal();
+	void			Lock();
+#if VIPER_PLATFORM == PLATFORM_WINDOWS
+	static DWORD WINAPI	Entry(LPVOID pWorker);
+#else
+	static void*	Entry(void *pWorker);
+#endif
+};
+
+/**
+ *	Mutex and condition variable idle workers sleep on.
+ */
+struct VJobSignal
+{
+	VJOB_MUTEX		mMutex;
+	VJOB_COND		mCond;
+};
+
+/*
+ * Bookkeeping for ParallelFor(), shared by every job it splits into.
+ */
+struct VJobRange
+{
+	VJobFunc		mFunc;
+	void			*mData;
+	VUINT			mGrain;
+};
+
+/********************************************************************
+ *                       V J O B W O R K E R                        *
+ ********************************************************************/
+void VJobWorker::Lock()
+{
+	while (!VJOB_TRYLOCK(mLock))
+		while (VJOB_LOAD(mLock))
+			VJOB_YIELD();
+}
+
+/*
+ * Unlocked, so only a hint unless a fence came first.
+ */
+bool VJobWorker::IsEmpty() const
+{
+	return VJOB_LOAD(mTail) <= VJOB_LOAD(mHead);
+}
+
+bool VJobWorker::Push(VJob *pJob)
+{
+	bool vPushed = false;
+
+	Lock();
+	if (mTail - mHead < VJOB_QUEUE_SIZE)
+	{
+		mQueue[mTail & (VJOB_QUEUE_SIZE - 1)] = pJob;
+		mTail++;
+		vPushed = true;
+	}
+	VJOB_UNLOCK(mLock);
+	return vPushed;
+}
+
+VJob* VJobWorker::Pop()
+{
+	VJob *vJob = NULL;
+
+	if (IsEmpty())
+		return NULL;
+	Lock();
+	if (mTail > mHead)
+	{
+		mTail--;
+		vJob = mQueue[mTail & (VJOB_QUEUE_SIZE - 1)];
+	}
+	VJOB_UNLOCK(mLock);
+	return vJob;
+}
+
+VJob* VJobWorker::Steal()
+{
+	VJob *vJob = NULL;
+
+	if (IsEmpty())
+		return NULL;
+	Lock();
+	if (mTail > mHead)
+	{
+		vJob = mQueue[mHead & (VJOB_QUEUE_SIZE - 1)];
+		mHead++;
+	}
+	VJOB_UNLOCK(mLock);
+	return vJob;
+}
+
+#if VIPER_PLATFORM == PLATFORM_WINDOWS
+DWORD WINAPI VJobWorker::Entry(LPVOID pWorker)
+{
+	VJobWorker *vWorker = (VJobWorker*)pWorker;
+	vWorker->mSystem->WorkerLoop(vWorker->mIndex);
+	return 0;
+}
+#else
+void* VJobWorker::Entry(void *pWorker)
+{
+	VJobWorker *vWorker = (VJobWorker*)pWorker;
+	vWorker->mSystem->WorkerLoop(vWorker->mIndex);
+	return NULL;
+}
+#endif
+
+/*
+ * Job function ParallelFor() starts with.  Hands the upper half of its
+ * range to a child until at most one grain is left, then runs the
+ * caller's function on what remains.  If the pool runs out of jobs,
+ * it keeps the rest and works through it a grain at a time.
+ */
+static void SplitJob(VJob *pJob)
+{
+	VJobRange	*vRange = (VJobRange*)pJob->mData;
+	VUINT		vFirst = pJob->mFirst;
+	VUINT		vCount = pJob->mCount;
+	VUINT		vLeft;
+	VJob		*vChild;
+
+	while (vCount > vRange->mGrain)
+	{
+		/* split on a multiple of the grain, so ranges stay aligned */
+		vLeft = ((vCount + vRange->mGrain - 1) / vRange->mGrain / 2) *
+				vRange->mGrain;
+		vChild = pJob->mSystem->Create(SplitJob, vRange, vFirst + vLeft,
+				vCount - vLeft, pJob);
+		if (vChild == NULL)
+			break;
+		pJob->mSystem->Run(vChild);
+		vCount = vLeft;
+	}
+
+	pJob->mFunc = vRange->mFunc;
+	pJob->mData = vRange->mData;
+	while (vCount > 0)
+	{
+		vLeft = (vCount < vRange->mGrain ? vCount : vRange->mGrain);
+		pJob->mFirst = vFirst;
+		pJob->mCount = vLeft;
+		vRange->mFunc(pJob);
+		vFirst += vLeft;
+		vCount -= vLeft;
+	}
+}
+
+/********************************************************************
+ *          C O N S T R U C T I O N / D E S T R U C T I O N         *
+ ********************************************************************/
+VJobSystem::VJobSystem()
+{
+	mWorkers = NULL;
+	mSignal = NULL;
+	mNumThreads = 0;
+	mSleeping = 0;
+	mQuit = 0;
+}
+
+VJobSystem::~VJobSystem()
+{
+	Shutdown();
+}
+
+/********************************************************************
+ *                        A T T R I B U T E S                       *
+ ********************************************************************/
+
+/*------------------------------------------------------------------*
+ *							 GetNumCores()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Returns the number of processors available to us.
+ *	@date		17-Oct-2026
+ *
+ *	@returns	(int) Online processors, at least 1
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+int VJobSystem::GetNumCores()
+{
+	long vCores;
+
+#if VIPER_PLATFORM == PLATFORM_WINDOWS
+	SYSTEM_INFO vInfo;
+	GetSystemInfo(&vInfo);
+	vCores = (long)vInfo.dwNumberOfProcessors;
+#else
+	vCores = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+	return (vCores < 1 ? 1 : (int)vCores);
+}
+
+/********************************************************************
+ *                        O P E R A T I O N S                       *
+ ********************************************************************/
+
+/*------------------------------------------------------------------*
+ *								 Init()								*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Starts the worker threads.
+ *	@date		17-Oct-2026
+ *
+ *	@param		nThreads	Threads to run jobs on, counting the caller.
+ *							0 uses one per core.  1 starts no threads,
+ *							and jobs run inside Wait().
+ *
+ *	@returns	(bool) False if the threads could not be started
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+bool VJobSystem::Init(int nThreads /*=0*/)
+{
+	int vStarted;
+
+	Shutdown();
+
+	if (nThreads <= 0)
+		nThreads = GetNumCores();
+	if (nThreads > VJOB_MAX_THREADS)
+		nThreads = VJOB_MAX_THREADS;
+
+	mSleeping = 0;
+	mQuit = 0;
+	mSignal = new VJobSignal;
+	mWorkers = new VJobWorker[nThreads];
+	for (int i = 0; i < nThreads; i++)
+	{
+		mWorkers[i].mPool = new VJob[VJOB_POOL_SIZE];
+		for (int j = 0; j < VJOB_POOL_SIZE; j++)
+			mWorkers[i].mPool[j].mUnfinished = 0;
+		mWorkers[i].mNext = 0;
+		mWorkers[i].mHead = 0;
+		mWorkers[i].mTail = 0;
+		mWorkers[i].mLock = 0;
+		mWorkers[i].mSystem = this;
+		mWorkers[i].mIndex = i;
+	}
+
+#if VIPER_PLATFORM == PLATFORM_WINDOWS
+	InitializeCriticalSection(&mSignal->mMutex);
+	InitializeConditionVariable(&mSignal->mCond);
+#else
+	pthread_mutex_init(&mSignal->mMutex, NULL);
+	pthread_cond_init(&mSignal->mCond, NULL);
+#endif
+
+	/* the caller is worker 0 */
+	sCurrentSystem = this;
+	sCurrentWorker = 0;
+
+	for (vStarted = 1; vStarted < nThreads; vStarted++)
+	{
+#if VIPER_PLATFORM == PLATFORM_WINDOWS
+		mWorkers[vStarted].mThread = CreateThread(NULL, 0, VJobWorker::Entry,
+				&mWorkers[vStarted], 0, NULL);
+		if (mWorkers[vStarted].mThread == NULL)
+			break;
+#else
+		if (pthread_create(&mWorkers[vStarted].mThread, NULL,
+				VJobWorker::Entry, &mWorkers[vStarted]) != 0)
+			break;
+#endif
+	}
+
+	mNumThreads = vStarted;
+	if (vStarted < nThreads)
+	{
+		VTRACE(_CL("Started only %d of %d threads\n"), vStarted, nThreads);
+		Shutdown();
+		return false;
+	}
+
+	VTRACE(_CL("Running jobs on %d threads\n"), mNumThreads);
+	return true;
+}
+
+/*------------------------------------------------------------------*
+ *							   Shutdown()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Stops and joins the worker threads.
+ *	@date		17-Oct-2026
+ *
+ *	@remarks	Jobs still queued are dropped; Wait() on everything
+ *				first.
+ *
+ *	@returns	void
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VJobSystem::Shutdown()
+{
+	if (mWorkers == NULL)
+		return;
+
+#if VIPER_PLATFORM == PLATFORM_WINDOWS
+	EnterCriticalSection(&mSignal->mMutex);
+	VJOB_INC(mQuit);
+	WakeAllConditionVariable(&mSignal->mCond);
+	LeaveCriticalSection(&mSignal->mMutex);
+	for (int i = 1; i < mNumThreads; i++)
+	{
+		WaitForSingleObject(mWorkers[i].mThread, INFINITE);
+		CloseHandle(mWorkers[i].mThread);
+	}
+	DeleteCriticalSection(&mSignal->mMutex);
+#else
+	pthread_mutex_lock(&mSignal->mMutex);
+	VJOB_INC(mQuit);
+	pthread_cond_broadcast(&mSignal->mCond);
+	pthread_mutex_unlock(&mSignal->mMutex);
+	for (int i = 1; i < mNumThreads; i++)
+		pthread_join(mWorkers[i].mThread, NULL);
+	pthread_cond_destroy(&mSignal->mCond);
+	pthread_mutex_destroy(&mSignal->mMutex);
+#endif
+
+	for (int i = 0; i < mNumThreads; i++)
+		delete[] mWorkers[i].mPool;
+	delete[] mWorkers;
+	delete mSignal;
+	mWorkers = NULL;
+	mSignal = NULL;
+	mNumThreads = 0;
+
+	if (sCurrentSystem == this)
+		sCurrentSystem = NULL;
+}
+
+/*------------------------------------------------------------------*
+ *								Create()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Sets up a job without running it.
+ *	@date		17-Oct-2026
+ *
+ *	@param		pFunc		Function to call
+ *	@param		pData		Passed through in VJob::mData
+ *	@param		nFirst		Passed through in VJob::mFirst
+ *	@param		nCount		Passed through in VJob::mCount
+ *	@param		pParent		Optional; job that should not finish until
+ *							this one has.  Must not have finished yet,
+ *							so children are normally created by the
+ *							parent's own function.
+ *
+ *	@remarks	Only jobs that have finished are handed out again.
+ *
+ *	@returns	(VJob*) Job to hand to Run(), or NULL if all of this
+ *				thread's VJOB_POOL_SIZE jobs are still unfinished
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+VJob* VJobSystem::Create(VJobFunc pFunc, void *pData, VUINT nFirst /*=0*/,
+							VUINT nCount /*=0*/, VJob *pParent /*=NULL*/)
+{
+	VJobWorker	*vWorker = &mWorkers[CurrentWorker()];
+	VJob		*vJob = NULL;
+
+	for (int i = 0; i < VJOB_POOL_SIZE && vJob == NULL; i++)
+	{
+		vJob = &vWorker->mPool[vWorker->mNext++ & (VJOB_POOL_SIZE - 1)];
+		if (VJOB_LOAD(vJob->mUnfinished) != 0)
+			vJob = NULL;
+	}
+	if (vJob == NULL)
+	{
+		VTRACE(_CL("Worker %d has no finished jobs to reuse\n"), vWorker->mIndex);
+		return NULL;
+	}
+
+	if (pParent)
+		VJOB_INC(pParent->mUnfinished);
+
+	vJob->mFunc = pFunc;
+	vJob->mSystem = this;
+	vJob->mParent = pParent;
+	vJob->mData = pData;
+	vJob->mFirst = nFirst;
+	vJob->mCount = nCount;
+	vJob->mUnfinished = 1;
+	return vJob;
+}
+
+/*------------------------------------------------------------------*
+ *								 Run()								*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Push the job on our own deque, running it now if full		*
+ *		Wake a worker if any are asleep.  The push is fenced before	*
+ *			mSleeping is read, and a worker raises mSleeping before	*
+ *			looking at the deques, so one of us always sees the		*
+ *			other													*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VJobSystem::Run(VJob *pJob)
+{
+	if (!mWorkers[CurrentWorker()].Push(pJob))
+	{
+		Execute(pJob);
+		return;
+	}
+
+	VJOB_FENCE();
+	if (VJOB_LOAD(mSleeping) > 0)
+	{
+#if VIPER_PLATFORM == PLATFORM_WINDOWS
+		EnterCriticalSection(&mSignal->mMutex);
+		WakeConditionVariable(&mSignal->mCond);
+		LeaveCriticalSection(&mSignal->mMutex);
+#else
+		pthread_mutex_lock(&mSignal->mMutex);
+		pthread_cond_signal(&mSignal->mCond);
+		pthread_mutex_unlock(&mSignal->mMutex);
+#endif
+	}
+}
+
+/*------------------------------------------------------------------*
+ *								 Wait()								*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Until the job and all its children have finished,			*
+ *			run whatever job we can find, our own first				*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VJobSystem::Wait(VJob *pJob)
+{
+	int		vWorker = CurrentWorker();
+	VJob	*vJob;
+
+	while (VJOB_LOAD(pJob->mUnfinished) > 0)
+	{
+		vJob = GetJob(vWorker);
+		if (vJob)
+			Execute(vJob);
+		else
+			VJOB_YIELD();
+	}
+}
+
+/*------------------------------------------------------------------*
+ *							 ParallelFor()							*
+ *------------------------------------------------------------------*/
+/**
+ *	@brief		Calls a function over [0, nCount) in pieces, spread
+ *				over every thread, and waits for them all.
+ *	@date		17-Oct-2026
+ *
+ *	@param		pFunc	Called with mFirst/mCount set to each piece
+ *	@param		pData	Passed through in VJob::mData
+ *	@param		nCount	Length of the range
+ *	@param		nGrain	Largest piece handed to pFunc.  Every piece
+ *						but the last starts and ends on a multiple of
+ *						it.
+ *
+ *	@remarks	The root piece runs on the caller's stack, so this works
+ *				even when the caller's pool has no jobs to spare.
+ *
+ *	@returns	void
+ */
+/*------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VJobSystem::ParallelFor(VJobFunc pFunc, void *pData, VUINT nCount,
+								VUINT nGrain)
+{
+	VJobRange	vRange;
+	VJob		vRoot;
+
+	if (nCount == 0)
+		return;
+
+	vRange.mFunc = pFunc;
+	vRange.mData = pData;
+	vRange.mGrain = (nGrain > 0 ? nGrain : 1);
+
+	vRoot.mFunc = SplitJob;
+	vRoot.mSystem = this;
+	vRoot.mParent = NULL;
+	vRoot.mData = &vRange;
+	vRoot.mFirst = 0;
+	vRoot.mCount = nCount;
+	vRoot.mUnfinished = 1;
+	Execute(&vRoot);
+	Wait(&vRoot);
+}
+
+/********************************************************************
+ *                         I N T E R N A L S                        *
+ ********************************************************************/
+
+/*------------------------------------------------------------------*
+ *							  WorkerLoop()							*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Until told to quit											*
+ *			Run a job if we can find one							*
+ *			After VJOB_SPINS empty polls, sleep until a deque has	*
+ *				one													*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VJobSystem::WorkerLoop(int nWorker)
+{
+	VJob	*vJob;
+	int		vSpins = 0;
+
+	sCurrentSystem = this;
+	sCurrentWorker = nWorker;
+
+	while (!VJOB_LOAD(mQuit))
+	{
+		vJob = GetJob(nWorker);
+		if (vJob)
+		{
+			Execute(vJob);
+			vSpins = 0;
+			continue;
+		}
+		if (++vSpins < VJOB_SPINS)
+		{
+			VJOB_YIELD();
+			continue;
+		}
+		vSpins = 0;
+
+#if VIPER_PLATFORM == PLATFORM_WINDOWS
+		EnterCriticalSection(&mSignal->mMutex);
+		VJOB_INC(mSleeping);
+		while (!HasWork() && !VJOB_LOAD(mQuit))
+			SleepConditionVariableCS(&mSignal->mCond, &mSignal->mMutex, INFINITE);
+		VJOB_DEC(mSleeping);
+		LeaveCriticalSection(&mSignal->mMutex);
+#else
+		pthread_mutex_lock(&mSignal->mMutex);
+		VJOB_INC(mSleeping);
+		while (!HasWork() && !VJOB_LOAD(mQuit))
+			pthread_cond_wait(&mSignal->mCond, &mSignal->mMutex);
+		VJOB_DEC(mSleeping);
+		pthread_mutex_unlock(&mSignal->mMutex);
+#endif
+	}
+}
+
+int VJobSystem::CurrentWorker() const
+{
+	return (sCurrentSystem == this ? sCurrentWorker : 0);
+}
+
+/*------------------------------------------------------------------*
+ *								GetJob()							*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Take the newest job from our own deque						*
+ *		Otherwise steal the oldest from the next worker that has	*
+ *			one, starting with our neighbour						*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+VJob* VJobSystem::GetJob(int nWorker)
+{
+	VJob *vJob;
+
+	vJob = mWorkers[nWorker].Pop();
+	for (int i = 1; vJob == NULL && i < mNumThreads; i++)
+		vJob = mWorkers[(nWorker + i) % mNumThreads].Steal();
+	return vJob;
+}
+
+/*
+ * Whether any deque has a job.  Only exact after a fence, which
+ * raising mSleeping provides.
+ */
+bool VJobSystem::HasWork() const
+{
+	for (int i = 0; i < mNumThreads; i++)
+		if (!mWorkers[i].IsEmpty())
+			return true;
+	return false;
+}
+
+void VJobSystem::Execute(VJob *pJob)
+{
+	pJob->mFunc(pJob);
+	Finish(pJob);
+}
+
+/*------------------------------------------------------------------*
+ *								Finish()							*
+ *------------------------------------------------------------------*
+ *	ALGORITHM:														*
+ *		Drop the job's count; if that finished it, drop its			*
+ *		parent's, and so on up										*
+ *------------------------------------------------------------------*
+ * MODIFICATIONS													*
+ *	Date		Description							Author			*
+ * ===========	==================================	===============	*
+ *																	*
+ *------------------------------------------------------------------*/
+void VJobSystem::Finish(VJob *pJob)
+{
+	VJob *vParent;
+
+	/* read the parent first; a finished job may be handed out again */
+	while (pJob)
+	{
+		vParent = pJob->mParent;
+		if (VJOB_DEC(pJob->mUnfinished) != 0)
+			break;
+		pJob = vParent;
+	}
+}
+
+} // End Namespace